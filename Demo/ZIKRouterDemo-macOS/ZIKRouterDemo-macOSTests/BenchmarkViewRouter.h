@@ -0,0 +1,29 @@
+//
+//  BenchmarkViewRouter.h
+//  ZIKRouterDemo-macOSTests
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <Cocoa/Cocoa.h>
+@import ZIKRouter;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@protocol BenchmarkViewInput <ZIKViewRoutable>
+@property (nonatomic, copy, nullable) NSString *message;
+@end
+
+/// Plain view controller without nib, so benchmarks measure routing instead of view loading.
+@interface BenchmarkViewController : NSViewController <BenchmarkViewInput>
+@end
+
+@interface BenchmarkViewRouter : ZIKDestinationViewRouter(BenchmarkViewController *)
+@end
+
+/// Present and dismiss synchronously by adding destination's view to source's view, for measuring `-presentViewController:animator:` without waiting for animations.
+@interface BenchmarkPresentationAnimator : NSObject <NSViewControllerPresentationAnimator>
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,46 @@
+//
+//  BenchmarkViewRouter.m
+//  ZIKRouterDemo-macOSTests
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import "BenchmarkViewRouter.h"
+@import ZIKRouter.Internal;
+
+@implementation BenchmarkViewController
+@synthesize message;
+
+- (void)loadView {
+    self.view = [[NSView alloc] initWithFrame:NSMakeRect(0, 0, 200, 100)];
+}
+
+@end
+
+DeclareRoutableView(BenchmarkViewController, BenchmarkViewRouter)
+
+@implementation BenchmarkViewRouter
+
++ (void)registerRoutableDestination {
+    [self registerView:[BenchmarkViewController class]];
+    [self registerViewProtocol:ZIKRoutable(BenchmarkViewInput)];
+}
+
+- (id)destinationWithConfiguration:(ZIKViewRouteConfiguration *)configuration {
+    return [[BenchmarkViewController alloc] init];
+}
+
+@end
+
+@implementation BenchmarkPresentationAnimator
+
+- (void)animatePresentationOfViewController:(NSViewController *)viewController fromViewController:(NSViewController *)fromViewController {
+    [fromViewController.view addSubview:viewController.view];
+}
+
+- (void)animateDismissalOfViewController:(NSViewController *)viewController fromViewController:(NSViewController *)fromViewController {
+    [viewController.view removeFromSuperview];
+}
+
+@end
@@ -0,0 +1,167 @@
+//
+//  ZIKAppKitRouterBenchmarkTests.m
+//  ZIKRouterDemo-macOSTests
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+@import ZIKRouter;
+@import ZIKRouter.Internal;
+#import "BenchmarkViewRouter.h"
+
+static const NSUInteger kLookupCount = 10000;
+static const NSUInteger kPerformCount = 100;
+/// AppKit finishes sheets and windows in later run loops, so they are performed less.
+static const NSUInteger kWindowPerformCount = 10;
+static const NSUInteger kHookIterationCount = 1000;
+static const NSTimeInterval kTransitionTimeout = 5;
+
+/**
+ Benchmark of registration lookup, performing and removing view routes, and overhead of hooked AppKit methods in the macOS host app. Baselines are recorded per machine in Xcode, set them from a release build's run.
+
+ Routes wait for their transitions in the run loop, so latency of sheets and windows includes AppKit's own work.
+ */
+@interface ZIKAppKitRouterBenchmarkTests : XCTestCase
+@property (nonatomic, strong) NSWindow *window;
+@property (nonatomic, strong) NSViewController *source;
+@end
+
+@implementation ZIKAppKitRouterBenchmarkTests
+
+- (void)setUp {
+    [super setUp];
+    self.source = [[NSViewController alloc] init];
+    self.source.view = [[NSView alloc] initWithFrame:NSMakeRect(0, 0, 400, 300)];
+    self.window = [[NSWindow alloc] initWithContentRect:NSMakeRect(0, 0, 400, 300) styleMask:NSWindowStyleMaskTitled backing:NSBackingStoreBuffered defer:NO];
+    self.window.releasedWhenClosed = NO;
+    self.window.contentViewController = self.source;
+    [self.window orderFront:nil];
+}
+
+- (void)tearDown {
+    [self.window close];
+    self.window = nil;
+    self.source = nil;
+    [super tearDown];
+}
+
+- (void)measureHotPath:(void(NS_NOESCAPE ^)(void))block {
+    if (@available(macOS 10.15, *)) {
+        [self measureWithMetrics:@[[XCTClockMetric new], [XCTCPUMetric new], [XCTMemoryMetric new]] block:block];
+    } else {
+        [self measureBlock:block];
+    }
+}
+
+/// Run main run loop until condition is YES or timeout.
+- (BOOL)waitUntil:(BOOL(NS_NOESCAPE ^)(void))condition {
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:kTransitionTimeout];
+    while (!condition() && [deadline timeIntervalSinceNow] > 0) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.001]];
+    }
+    return condition();
+}
+
+- (void)performAndRemoveWithPath:(ZIKViewRoutePath *)path count:(NSUInteger)count {
+    for (NSUInteger i = 0; i < count; i++) {
+        @autoreleasepool {
+            ZIKAnyViewRouter *router = [ZIKRouterToView(BenchmarkViewInput) performPath:path configuring:^(ZIKViewRouteConfiguration * _Nonnull config) {
+                config.animated = NO;
+            }];
+            XCTAssertTrue([self waitUntil:^BOOL{
+                return router.state != ZIKRouterStateRouting;
+            }]);
+            XCTAssertEqual(router.state, ZIKRouterStateRouted);
+            [router removeRouteWithConfiguring:^(ZIKViewRemoveConfiguration * _Nonnull config) {
+                config.animated = NO;
+            }];
+            XCTAssertTrue([self waitUntil:^BOOL{
+                return router.state != ZIKRouterStateRemoving;
+            }]);
+            XCTAssertEqual(router.state, ZIKRouterStateRemoved);
+        }
+    }
+}
+
+- (void)testRouterLookupPerformance {
+    XCTAssertTrue(ZIKRouteRegistry.registrationFinished);
+    [self measureHotPath:^{
+        for (NSUInteger i = 0; i < kLookupCount; i++) {
+            XCTAssertNotNil(ZIKRouterToView(BenchmarkViewInput));
+        }
+    }];
+}
+
+- (void)testAddAsChildPerformAndRemovePerformance {
+    NSViewController *source = self.source;
+    ZIKViewRoutePath *path = ZIKViewRoutePath.addAsChildViewControllerFrom(source, ^(NSViewController * _Nonnull destination, void (^ _Nonnull completion)(void)) {
+        [source.view addSubview:destination.view];
+        completion();
+    });
+    [self measureHotPath:^{
+        [self performAndRemoveWithPath:path count:kPerformCount];
+    }];
+}
+
+- (void)testPresentWithAnimatorPerformAndRemovePerformance {
+    ZIKViewRoutePath *path = ZIKViewRoutePath.presentWithAnimatorFrom(self.source, [BenchmarkPresentationAnimator new]);
+    [self measureHotPath:^{
+        [self performAndRemoveWithPath:path count:kPerformCount];
+    }];
+}
+
+- (void)testPresentAsSheetPerformAndRemovePerformance {
+    ZIKViewRoutePath *path = ZIKViewRoutePath.presentAsSheetFrom(self.source);
+    [self measureHotPath:^{
+        [self performAndRemoveWithPath:path count:kWindowPerformCount];
+    }];
+}
+
+- (void)testShowWindowPerformAndRemovePerformance {
+    // Removing closes the window, so it also measures handling of NSWindowWillCloseNotification
+    ZIKViewRoutePath *path = ZIKViewRoutePath.show;
+    [self measureHotPath:^{
+        [self performAndRemoveWithPath:path count:kWindowPerformCount];
+    }];
+}
+
+/// Add and remove child view controllers not created by routers, the hooked appearance and window methods return early for them.
+- (void)addAndRemoveUnroutedChildren {
+    NSViewController *source = self.source;
+    for (NSUInteger i = 0; i < kHookIterationCount; i++) {
+        @autoreleasepool {
+            NSViewController *child = [[NSViewController alloc] init];
+            child.view = [[NSView alloc] initWithFrame:NSMakeRect(0, 0, 10, 10)];
+            [source addChildViewController:child];
+            [source.view addSubview:child.view];
+            [child.view removeFromSuperview];
+            [child removeFromParentViewController];
+        }
+    }
+}
+
+- (void)testHookOverheadOfUnroutedViews {
+    [self measureHotPath:^{
+        [self addAndRemoveUnroutedChildren];
+    }];
+
+    // Profile once more, timing every invocation
+    ZIKRouter.hookProfilingSampleInterval = 1;
+    [ZIKRouter resetHookProfiles];
+    [self addAndRemoveUnroutedChildren];
+    NSArray<ZIKRouteHookProfile *> *profiles = [ZIKRouter hookProfiles];
+    ZIKRouter.hookProfilingSampleInterval = 0;
+    XCTAssertGreaterThan(profiles.count, 0);
+    for (ZIKRouteHookProfile *profile in profiles) {
+        NSLog(@"Hook %@: calls %@, early exits %@, processed %@, overhead %.3f ms",
+              profile.name,
+              @(profile.callCount),
+              @(profile.earlyExitCount),
+              @(profile.processedCount),
+              profile.estimatedDuration * 1000);
+    }
+}
+
+@end
@@ -9,6 +9,7 @@
 #import "AppDelegate.h"
 #import "DetailViewController.h"
 #import "AppRouteRegistry.h"
+#import "StressRouteBenchmark.h"
 @import ZIKRouter;
 
 @interface AppDelegate () <UISplitViewControllerDelegate>
@@ -52,6 +53,9 @@
     
     [ZIKRouter enableDefaultURLRouteRule];
     
+#if ZIKROUTER_STRESS
+    [StressRouteBenchmark run];
+#endif
     
     UISplitViewController *splitViewController = (UISplitViewController *)self.window.rootViewController;
     splitViewController.delegate = self;
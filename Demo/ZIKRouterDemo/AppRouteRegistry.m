@@ -47,6 +47,7 @@
 
 #import "DemoRouteAdapter.h"
 #import "ZIKRouterDemo-Swift.h"
+#import "StressRouteBenchmark.h"
 
 
 @implementation AppRouteRegistry
@@ -114,6 +115,11 @@
     // Objc adapters
     [DemoRouteAdapter registerRoutableDestination];
     
+#if ZIKROUTER_STRESS
+    // Generated routers, see generate_stress_routers.sh
+    [StressRouteBenchmark registerStressRouters];
+#endif
+    
     // Finish
     [ZIKRouteRegistry notifyRegistrationFinished];
 }
@@ -0,0 +1,32 @@
+//
+//  StressRouteBenchmark.h
+//  ZIKRouterDemo
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+#if ZIKROUTER_STRESS
+
+/**
+ Measure the demo with a generated large registry. Generate routers with generate_stress_routers.sh, add them into the target, and define ZIKROUTER_STRESS=1.
+ 
+ Results are logged with NSLog, so the same build can be compared between runs and devices.
+ */
+@interface StressRouteBenchmark : NSObject
+
+/// Register all generated routers and record the duration and memory growth. Call it before +[ZIKRouteRegistry notifyRegistrationFinished] when manually registering. With auto registration, generated routers are registered by +registerAll, and this method is a no-op.
++ (void)registerStressRouters;
+
+/// Measure lookup throughput of view protocols, service protocols, adapters and URLs, then log all results. Call it after registration is finished.
++ (void)run;
+
+@end
+
+#endif
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,111 @@
+//
+//  StressRouteBenchmark.m
+//  ZIKRouterDemo
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import "StressRouteBenchmark.h"
+
+#if ZIKROUTER_STRESS
+
+#import "StressRoutes.h"
+#import <mach/mach.h>
+#import <mach/mach_time.h>
+@import ZIKRouter;
+
+static const NSUInteger kLookupRounds = 10;
+
+static NSTimeInterval _registrationDuration;
+static int64_t _registrationFootprint;
+
+static int64_t currentFootprint(void) {
+    task_vm_info_data_t info;
+    mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+    if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return (int64_t)info.phys_footprint;
+}
+
+static double secondsFromMachTime(uint64_t time) {
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0) {
+        mach_timebase_info(&timebase);
+    }
+    return (double)time * timebase.numer / timebase.denom / NSEC_PER_SEC;
+}
+
+/// Run the block kLookupRounds times over count items, and return lookups per second.
+static double measureLookups(NSUInteger count, NSUInteger *missCount, BOOL(^lookup)(NSUInteger index)) {
+    NSUInteger misses = 0;
+    uint64_t start = mach_absolute_time();
+    for (NSUInteger round = 0; round < kLookupRounds; round++) {
+        @autoreleasepool {
+            for (NSUInteger i = 0; i < count; i++) {
+                if (!lookup(i)) {
+                    misses++;
+                }
+            }
+        }
+    }
+    double duration = secondsFromMachTime(mach_absolute_time() - start);
+    *missCount = misses / kLookupRounds;
+    return duration > 0 ? count * kLookupRounds / duration : 0;
+}
+
+@implementation StressRouteBenchmark
+
++ (void)registerStressRouters {
+#if !AUTO_REGISTER_ROUTERS
+    int64_t footprint = currentFootprint();
+    uint64_t start = mach_absolute_time();
+    StressRegisterAllModules();
+    _registrationDuration = secondsFromMachTime(mach_absolute_time() - start);
+    _registrationFootprint = currentFootprint() - footprint;
+#endif
+}
+
++ (void)run {
+    NSUInteger viewMisses = 0;
+    double viewRate = measureLookups(STRESS_VIEW_ROUTER_COUNT, &viewMisses, ^BOOL(NSUInteger index) {
+        Protocol *protocol = NSProtocolFromString([NSString stringWithFormat:@"StressView%luInput", (unsigned long)index]);
+        return ZIKViewRouter.toView((Protocol<ZIKViewRoutable> *)protocol) != nil;
+    });
+    NSUInteger serviceMisses = 0;
+    double serviceRate = measureLookups(STRESS_SERVICE_ROUTER_COUNT, &serviceMisses, ^BOOL(NSUInteger index) {
+        Protocol *protocol = NSProtocolFromString([NSString stringWithFormat:@"StressService%luInput", (unsigned long)index]);
+        return ZIKServiceRouter.toService((Protocol<ZIKServiceRoutable> *)protocol) != nil;
+    });
+    NSUInteger adapterCount = (STRESS_SERVICE_ROUTER_COUNT + STRESS_ADAPTER_STRIDE - 1) / STRESS_ADAPTER_STRIDE;
+    NSUInteger adapterMisses = 0;
+    double adapterRate = measureLookups(adapterCount, &adapterMisses, ^BOOL(NSUInteger index) {
+        Protocol *protocol = NSProtocolFromString([NSString stringWithFormat:@"StressService%luRequiredInput", (unsigned long)(index * STRESS_ADAPTER_STRIDE)]);
+        return ZIKServiceRouter.toService((Protocol<ZIKServiceRoutable> *)protocol) != nil;
+    });
+    NSUInteger urlMisses = 0;
+    double urlRate = measureLookups(STRESS_VIEW_ROUTER_COUNT, &urlMisses, ^BOOL(NSUInteger index) {
+        NSString *url = [NSString stringWithFormat:@"stress://view/%lu/%lu", (unsigned long)index, (unsigned long)index];
+        return [ZIKAnyViewRouter routerForURL:url] != nil;
+    });
+    
+    NSLog(@"\n---Stress registry: %d view routers, %d service routers, %d modules---\n"
+          "registration: %.1f ms, footprint growth: %.2f MB%@\n"
+          "view protocol lookups: %.0f/s, misses: %lu\n"
+          "service protocol lookups: %.0f/s, misses: %lu\n"
+          "adapter lookups: %.0f/s, misses: %lu\n"
+          "URL lookups: %.0f/s, misses: %lu\n"
+          "current footprint: %.2f MB\n",
+          STRESS_VIEW_ROUTER_COUNT, STRESS_SERVICE_ROUTER_COUNT, STRESS_MODULE_COUNT,
+          _registrationDuration * 1000, _registrationFootprint / 1024.0 / 1024.0, _registrationDuration > 0 ? @"" : @" (auto registration, not measured)",
+          viewRate, (unsigned long)viewMisses,
+          serviceRate, (unsigned long)serviceMisses,
+          adapterRate, (unsigned long)adapterMisses,
+          urlRate, (unsigned long)urlMisses,
+          currentFootprint() / 1024.0 / 1024.0);
+}
+
+@end
+
+#endif
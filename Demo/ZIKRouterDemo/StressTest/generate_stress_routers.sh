@@ -0,0 +1,212 @@
+#!/bin/sh
+#
+#  generate_stress_routers.sh
+#  ZIKRouterDemo
+#
+#  Generate a synthetic large registry for measuring launch time, lookup throughput and memory at production scale.
+#  Each module gets its own directory with view routers, service routers, an adapter and URL patterns. Put each directory
+#  in its own framework target to reproduce a multi-framework app, or add all of them into ZIKRouterDemo.
+#
+#  Usage:
+#    generate_stress_routers.sh <output directory> [view router count] [service router count] [module count]
+#
+#  Example:
+#    sh Demo/ZIKRouterDemo/StressTest/generate_stress_routers.sh Demo/ZIKRouterDemo/StressTest/Generated 2000 2000 20
+#
+#  Then add the generated files into ZIKRouterDemo, and add ZIKROUTER_STRESS=1 in
+#  Debug.xcconfig. StressRouteBenchmark registers all generated routers at launch and logs the results.
+#  Names are derived from the global index: StressView<i>, StressService<i>, and the module is <i> % <module count>.
+
+set -e
+
+if [ $# -lt 1 ]; then
+    echo "usage: $0 <output directory> [view router count] [service router count] [module count]" >&2
+    exit 1
+fi
+
+OUTPUT_DIR="$1"
+VIEW_COUNT="${2:-1000}"
+SERVICE_COUNT="${3:-1000}"
+MODULE_COUNT="${4:-10}"
+# Every ADAPTER_STRIDE-th service also gets an adapter protocol
+ADAPTER_STRIDE=10
+
+if [ "$MODULE_COUNT" -lt 1 ]; then
+    echo "error: module count must be at least 1" >&2
+    exit 1
+fi
+
+rm -rf "$OUTPUT_DIR"
+mkdir -p "$OUTPUT_DIR"
+
+write_header() {
+    # $1: file name
+    printf '//\n//  %s\n//  ZIKRouterDemo\n//\n//  Generated by generate_stress_routers.sh, do not edit.\n//\n\n' "$1"
+}
+
+m=0
+while [ $m -lt $MODULE_COUNT ]; do
+    MODULE="StressModule$m"
+    DIR="$OUTPUT_DIR/$MODULE"
+    mkdir -p "$DIR"
+    H="$DIR/$MODULE.h"
+    M="$DIR/$MODULE.m"
+    
+    {
+        write_header "$MODULE.h"
+        echo '#import <Foundation/Foundation.h>'
+        echo '@import ZIKRouter;'
+        echo ''
+        echo 'NS_ASSUME_NONNULL_BEGIN'
+        echo ''
+        i=$m
+        while [ $i -lt $VIEW_COUNT ]; do
+            echo "@protocol StressView${i}Input <ZIKViewRoutable>"
+            echo '@property (nonatomic, copy, nullable) NSString *identifier;'
+            echo '@end'
+            i=$((i + MODULE_COUNT))
+        done
+        i=$m
+        while [ $i -lt $SERVICE_COUNT ]; do
+            echo "@protocol StressService${i}Input <ZIKServiceRoutable>"
+            echo '- (NSUInteger)index;'
+            echo '@end'
+            if [ $((i % ADAPTER_STRIDE)) -eq 0 ]; then
+                echo "@protocol StressService${i}RequiredInput <ZIKServiceRoutable>"
+                echo '- (NSUInteger)index;'
+                echo '@end'
+            fi
+            i=$((i + MODULE_COUNT))
+        done
+        echo ''
+        echo "/// Register all routers, adapters and URL patterns in this module."
+        echo "FOUNDATION_EXTERN void ${MODULE}RegisterRouters(void);"
+        echo ''
+        echo 'NS_ASSUME_NONNULL_END'
+    } > "$H"
+    
+    {
+        write_header "$MODULE.m"
+        echo "#import \"$MODULE.h\""
+        echo '@import ZIKRouter.Internal;'
+        echo ''
+        i=$m
+        while [ $i -lt $VIEW_COUNT ]; do
+            cat <<OBJC
+@interface StressView${i}ViewController : UIViewController <ZIKRoutableView, StressView${i}Input>
+@property (nonatomic, copy, nullable) NSString *identifier;
+@end
+@implementation StressView${i}ViewController
+@end
+
+@interface StressView${i}Router : ZIKViewRouter
+@end
+@implementation StressView${i}Router
++ (void)registerRoutableDestination {
+    [self registerView:[StressView${i}ViewController class]];
+    [self registerViewProtocol:ZIKRoutable(StressView${i}Input)];
+    [self registerURLPattern:@"stress://view/${i}/:id"];
+}
+- (nullable UIViewController *)destinationWithConfiguration:(ZIKViewRouteConfiguration *)configuration {
+    return [StressView${i}ViewController new];
+}
+@end
+
+OBJC
+            i=$((i + MODULE_COUNT))
+        done
+        i=$m
+        while [ $i -lt $SERVICE_COUNT ]; do
+            if [ $((i % ADAPTER_STRIDE)) -eq 0 ]; then
+                PROTOCOLS="ZIKRoutableService, StressService${i}Input, StressService${i}RequiredInput"
+            else
+                PROTOCOLS="ZIKRoutableService, StressService${i}Input"
+            fi
+            cat <<OBJC
+@interface StressService${i} : NSObject <${PROTOCOLS}>
+@end
+@implementation StressService${i}
+- (NSUInteger)index {
+    return ${i};
+}
+@end
+
+@interface StressService${i}Router : ZIKServiceRouter
+@end
+@implementation StressService${i}Router
++ (void)registerRoutableDestination {
+    [self registerService:[StressService${i} class]];
+    [self registerServiceProtocol:ZIKRoutable(StressService${i}Input)];
+    [self registerURLPattern:@"stress://service/${i}"];
+}
+- (nullable id)destinationWithConfiguration:(ZIKPerformRouteConfiguration *)configuration {
+    return [StressService${i} new];
+}
+@end
+
+OBJC
+            i=$((i + MODULE_COUNT))
+        done
+        echo "@interface ${MODULE}Adapter : ZIKServiceRouteAdapter"
+        echo '@end'
+        echo "@implementation ${MODULE}Adapter"
+        echo '+ (void)registerRoutableDestination {'
+        i=$m
+        while [ $i -lt $SERVICE_COUNT ]; do
+            if [ $((i % ADAPTER_STRIDE)) -eq 0 ]; then
+                echo "    [self registerDestinationAdapter:ZIKRoutable(StressService${i}RequiredInput) forAdaptee:ZIKRoutable(StressService${i}Input)];"
+            fi
+            i=$((i + MODULE_COUNT))
+        done
+        echo '}'
+        echo '@end'
+        echo ''
+        echo "void ${MODULE}RegisterRouters(void) {"
+        i=$m
+        while [ $i -lt $VIEW_COUNT ]; do
+            echo "    [StressView${i}Router registerRoutableDestination];"
+            i=$((i + MODULE_COUNT))
+        done
+        i=$m
+        while [ $i -lt $SERVICE_COUNT ]; do
+            echo "    [StressService${i}Router registerRoutableDestination];"
+            i=$((i + MODULE_COUNT))
+        done
+        echo "    [${MODULE}Adapter registerRoutableDestination];"
+        echo '}'
+    } > "$M"
+    m=$((m + 1))
+done
+
+{
+    write_header "StressRoutes.h"
+    echo '#import <Foundation/Foundation.h>'
+    echo ''
+    echo "#define STRESS_VIEW_ROUTER_COUNT $VIEW_COUNT"
+    echo "#define STRESS_SERVICE_ROUTER_COUNT $SERVICE_COUNT"
+    echo "#define STRESS_MODULE_COUNT $MODULE_COUNT"
+    echo "#define STRESS_ADAPTER_STRIDE $ADAPTER_STRIDE"
+    echo ''
+    echo '/// Register routers of all generated modules, in module order.'
+    echo 'FOUNDATION_EXTERN void StressRegisterAllModules(void);'
+} > "$OUTPUT_DIR/StressRoutes.h"
+
+{
+    write_header "StressRoutes.m"
+    echo '#import "StressRoutes.h"'
+    m=0
+    while [ $m -lt $MODULE_COUNT ]; do
+        echo "#import \"StressModule$m/StressModule$m.h\""
+        m=$((m + 1))
+    done
+    echo ''
+    echo 'void StressRegisterAllModules(void) {'
+    m=0
+    while [ $m -lt $MODULE_COUNT ]; do
+        echo "    StressModule${m}RegisterRouters();"
+        m=$((m + 1))
+    done
+    echo '}'
+} > "$OUTPUT_DIR/StressRoutes.m"
+
+echo "Generated $VIEW_COUNT view routers and $SERVICE_COUNT service routers in $MODULE_COUNT modules at $OUTPUT_DIR"
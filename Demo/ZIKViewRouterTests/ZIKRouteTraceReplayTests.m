@@ -0,0 +1,249 @@
+//
+//  ZIKRouteTraceReplayTests.m
+//  ZIKViewRouterTests
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <pthread.h>
+@import ZIKRouter;
+
+/// Hook of libmalloc for Instruments, same as ZIKRouterAllocationTests.
+typedef void (ZIKMallocLogger)(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t numHotFramesToSkip);
+extern ZIKMallocLogger *malloc_logger;
+static const uint32_t ZIKMallocLogTypeAllocate = 2;
+
+static const NSTimeInterval kOperationTimeout = 5;
+
+static ZIKMallocLogger *_previousLogger;
+static pthread_t _countingThread;
+static uint64_t _allocationCount;
+
+static void _countAllocation(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t numHotFramesToSkip) {
+    if ((type & ZIKMallocLogTypeAllocate) && pthread_equal(pthread_self(), _countingThread)) {
+        _allocationCount++;
+    }
+    if (_previousLogger) {
+        _previousLogger(type, arg1, arg2, arg3, result, numHotFramesToSkip + 1);
+    }
+}
+
+/// Used when ZIKROUTER_REPLAY_TRACE is not set.
+static NSString *const kSampleTrace =
+@"# ZIKRouteTrace 1: start(us) action router-class route-type duration(us) succeeded\n"
+@"0 perform AViewRouter 11 0 1\n"
+@"0 perform AViewRouter 0 0 1\n"
+@"0 perform AViewRouter 8 0 1\n"
+@"0 remove AViewRouter 8 0 1\n"
+@"0 perform AViewRouter 1 0 1\n"
+@"0 remove AViewRouter 1 0 1\n"
+@"0 remove AViewRouter 0 0 1\n";
+
+/// Latency and allocations of replayed operations with the same action, router and route type.
+@interface ZIKRouteReplayStatistics : NSObject
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *latencies;
+@property (nonatomic) uint64_t allocations;
+@end
+@implementation ZIKRouteReplayStatistics
+- (instancetype)init {
+    if (self = [super init]) {
+        _latencies = [NSMutableArray array];
+    }
+    return self;
+}
+@end
+
+/**
+ Replay a trace recorded by `+[ZIKRouter startRecordingRouteOperationsToFile:]`, and log latency and allocations of each route. Set environment variable ZIKROUTER_REPLAY_TRACE to the trace file's path in the test scheme to replay navigation sequences from real usage.
+
+ Operations are replayed back to back on main thread without the recorded delay. Push, present modally, add as child and make destination are replayed without animation, other route types are skipped because they depend on the source. Remove removes the latest performed router of the same class. Allocations include everything on main thread until the operation completes.
+ */
+@interface ZIKRouteTraceReplayTests : XCTestCase
+@property (nonatomic, strong) UINavigationController *source;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<ZIKRouter *> *> *performedRouters;
+@end
+
+@implementation ZIKRouteTraceReplayTests
+
+- (void)setUp {
+    [super setUp];
+    // Use an offscreen container in key window, so routes don't disturb other tests
+    UIViewController *root = [UIApplication sharedApplication].keyWindow.rootViewController;
+    XCTAssertNotNil(root);
+    self.source = [[UINavigationController alloc] initWithRootViewController:[UIViewController new]];
+    [root addChildViewController:self.source];
+    [root.view addSubview:self.source.view];
+    [self.source didMoveToParentViewController:root];
+    self.performedRouters = [NSMutableDictionary dictionary];
+}
+
+- (void)tearDown {
+    [self.source dismissViewControllerAnimated:NO completion:nil];
+    [self.source willMoveToParentViewController:nil];
+    [self.source.view removeFromSuperview];
+    [self.source removeFromParentViewController];
+    self.source = nil;
+    self.performedRouters = nil;
+    [super tearDown];
+}
+
+- (nullable ZIKViewRoutePath *)pathForRouteType:(ZIKViewRouteType)routeType {
+    UIViewController *source = self.source.topViewController;
+    switch (routeType) {
+        case ZIKViewRouteTypePush:
+            return ZIKViewRoutePath.pushFrom(source);
+        case ZIKViewRouteTypePresentModally:
+            return ZIKViewRoutePath.presentModallyFrom(source);
+        case ZIKViewRouteTypeAddAsChildViewController:
+            return ZIKViewRoutePath.addAsChildViewControllerFrom(source, ^(UIViewController * _Nonnull destination, void (^ _Nonnull completion)(void)) {
+                [source.view addSubview:destination.view];
+                completion();
+            });
+        case ZIKViewRouteTypeMakeDestination:
+            return ZIKViewRoutePath.makeDestination;
+        default:
+            return nil;
+    }
+}
+
+/// Start the operation, and call finish when it completes. Return NO when the operation can't be replayed.
+- (BOOL)startPerformWithRouterClass:(Class)routerClass routeType:(NSInteger)routeType finish:(void(^)(BOOL success))finish {
+    ZIKRouter *router;
+    if ([routerClass isSubclassOfClass:[ZIKViewRouter class]]) {
+        ZIKViewRoutePath *path = [self pathForRouteType:routeType];
+        if (path == nil) {
+            return NO;
+        }
+        router = [routerClass performPath:path configuring:^(ZIKViewRouteConfiguration * _Nonnull config) {
+            config.animated = NO;
+            config.completionHandler = ^(BOOL success, id  _Nullable destination, ZIKRouteAction  _Nonnull routeAction, NSError * _Nullable error) {
+                finish(success);
+            };
+        }];
+    } else if ([routerClass isSubclassOfClass:[ZIKServiceRouter class]]) {
+        router = [routerClass performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.completionHandler = ^(BOOL success, id  _Nullable destination, ZIKRouteAction  _Nonnull routeAction, NSError * _Nullable error) {
+                finish(success);
+            };
+        }];
+    } else {
+        return NO;
+    }
+    if (router == nil) {
+        finish(NO);
+        return YES;
+    }
+    NSString *key = NSStringFromClass(routerClass);
+    NSMutableArray<ZIKRouter *> *routers = self.performedRouters[key];
+    if (routers == nil) {
+        routers = [NSMutableArray array];
+        self.performedRouters[key] = routers;
+    }
+    [routers addObject:router];
+    return YES;
+}
+
+- (BOOL)startRemoveWithRouterClass:(Class)routerClass finish:(void(^)(BOOL success))finish {
+    NSMutableArray<ZIKRouter *> *routers = self.performedRouters[NSStringFromClass(routerClass)];
+    ZIKRouter *router = routers.lastObject;
+    if (router == nil) {
+        return NO;
+    }
+    [routers removeLastObject];
+    if ([router canRemove] == NO) {
+        return NO;
+    }
+    [router removeRouteWithConfiguring:^(ZIKRemoveRouteConfiguration * _Nonnull config) {
+        if ([config isKindOfClass:[ZIKViewRemoveConfiguration class]]) {
+            ((ZIKViewRemoveConfiguration *)config).animated = NO;
+        }
+        config.completionHandler = ^(BOOL success, ZIKRouteAction  _Nonnull routeAction, NSError * _Nullable error) {
+            finish(success);
+        };
+    }];
+    return YES;
+}
+
+- (void)testReplayRecordedTrace {
+    NSString *path = [NSProcessInfo processInfo].environment[@"ZIKROUTER_REPLAY_TRACE"];
+    NSString *trace = kSampleTrace;
+    if (path.length > 0) {
+        NSError *error;
+        trace = [NSString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:&error];
+        XCTAssertNotNil(trace, @"Failed to read trace: %@", error);
+    }
+
+    NSMutableDictionary<NSString *, ZIKRouteReplayStatistics *> *statistics = [NSMutableDictionary dictionary];
+    NSUInteger skippedCount = 0;
+    for (NSString *line in [trace componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]]) {
+        NSArray<NSString *> *fields = [line componentsSeparatedByString:@" "];
+        if (line.length == 0 || [line hasPrefix:@"#"] || fields.count < 6) {
+            continue;
+        }
+        NSString *action = fields[1];
+        Class routerClass = NSClassFromString(fields[2]);
+        NSInteger routeType = fields[3].integerValue;
+        if (routerClass == nil || [fields[5] isEqualToString:@"1"] == NO) {
+            skippedCount++;
+            continue;
+        }
+
+        __block BOOL finished = NO;
+        __block BOOL succeeded = NO;
+        __block CFTimeInterval endTime = 0;
+        void(^finish)(BOOL) = ^(BOOL success) {
+            endTime = CACurrentMediaTime();
+            succeeded = success;
+            finished = YES;
+        };
+        _countingThread = pthread_self();
+        _allocationCount = 0;
+        _previousLogger = malloc_logger;
+        malloc_logger = _countAllocation;
+        CFTimeInterval startTime = CACurrentMediaTime();
+        BOOL started;
+        if ([action isEqualToString:@"remove"]) {
+            started = [self startRemoveWithRouterClass:routerClass finish:finish];
+        } else {
+            started = [self startPerformWithRouterClass:routerClass routeType:routeType finish:finish];
+        }
+        NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:kOperationTimeout];
+        while (started && !finished && [deadline timeIntervalSinceNow] > 0) {
+            [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.001]];
+        }
+        malloc_logger = _previousLogger;
+        _previousLogger = NULL;
+        if (!started) {
+            skippedCount++;
+            continue;
+        }
+        XCTAssertTrue(finished, @"%@ timed out", line);
+        XCTAssertTrue(succeeded, @"%@ failed", line);
+
+        NSString *key = [NSString stringWithFormat:@"%@ %@ %@", action, fields[2], fields[3]];
+        ZIKRouteReplayStatistics *routeStatistics = statistics[key];
+        if (routeStatistics == nil) {
+            routeStatistics = [ZIKRouteReplayStatistics new];
+            statistics[key] = routeStatistics;
+        }
+        [routeStatistics.latencies addObject:@((endTime - startTime) * USEC_PER_SEC)];
+        routeStatistics.allocations += _allocationCount;
+    }
+
+    for (NSString *key in [statistics.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        ZIKRouteReplayStatistics *routeStatistics = statistics[key];
+        NSArray<NSNumber *> *latencies = [routeStatistics.latencies sortedArrayUsingSelector:@selector(compare:)];
+        NSLog(@"Replayed %@: count %@, median %.0fus, max %.0fus, allocations %@",
+              key,
+              @(latencies.count),
+              latencies[latencies.count / 2].doubleValue,
+              latencies.lastObject.doubleValue,
+              @(routeStatistics.allocations / latencies.count));
+    }
+    NSLog(@"Skipped %@ operations", @(skippedCount));
+    XCTAssertGreaterThan(statistics.count, 0);
+}
+
+@end
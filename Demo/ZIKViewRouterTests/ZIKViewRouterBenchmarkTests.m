@@ -0,0 +1,71 @@
+//
+//  ZIKViewRouterBenchmarkTests.m
+//  ZIKViewRouterTests
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+@import ZIKRouter;
+#import "AViewInput.h"
+
+static const NSUInteger kPerformCount = 100;
+
+/// Benchmark of performing and removing view routes in the host app. Baselines are recorded per device in Xcode, set them from a release build's run.
+@interface ZIKViewRouterBenchmarkTests : XCTestCase
+@property (nonatomic, strong) UIViewController *source;
+@end
+
+@implementation ZIKViewRouterBenchmarkTests
+
+- (void)setUp {
+    [super setUp];
+    // Use an offscreen container in key window, so routes don't disturb other tests
+    UIViewController *root = [UIApplication sharedApplication].keyWindow.rootViewController;
+    XCTAssertNotNil(root);
+    self.source = [UIViewController new];
+    [root addChildViewController:self.source];
+    [root.view addSubview:self.source.view];
+    [self.source didMoveToParentViewController:root];
+}
+
+- (void)tearDown {
+    [self.source willMoveToParentViewController:nil];
+    [self.source.view removeFromSuperview];
+    [self.source removeFromParentViewController];
+    self.source = nil;
+    [super tearDown];
+}
+
+- (void)measureHotPath:(void(NS_NOESCAPE ^)(void))block {
+    if (@available(iOS 13.0, *)) {
+        [self measureWithMetrics:@[[XCTClockMetric new], [XCTCPUMetric new], [XCTMemoryMetric new]] block:block];
+    } else {
+        [self measureBlock:block];
+    }
+}
+
+- (void)testPerformAndRemovePerformance {
+    UIViewController *source = self.source;
+    ZIKViewRoutePath *path = ZIKViewRoutePath.addAsChildViewControllerFrom(source, ^(UIViewController * _Nonnull destination, void (^ _Nonnull completion)(void)) {
+        [source.view addSubview:destination.view];
+        completion();
+    });
+    [self measureHotPath:^{
+        for (NSUInteger i = 0; i < kPerformCount; i++) {
+            @autoreleasepool {
+                ZIKAnyViewRouter *router = [ZIKRouterToView(AViewInput) performPath:path configuring:^(ZIKViewRouteConfiguration * _Nonnull config) {
+                    config.animated = NO;
+                }];
+                XCTAssertEqual(router.state, ZIKRouterStateRouted);
+                [router removeRouteWithConfiguring:^(ZIKViewRemoveConfiguration * _Nonnull config) {
+                    config.animated = NO;
+                }];
+                XCTAssertEqual(router.state, ZIKRouterStateRemoved);
+            }
+        }
+    }];
+}
+
+@end
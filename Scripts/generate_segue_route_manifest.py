@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+#
+#  generate_segue_route_manifest.py
+#  ZIKRouter
+#
+#  Created by agent on 2026/10/15.
+#  Copyright © 2026 agent. All rights reserved.
+#
+#  This source code is licensed under the MIT-style license found in the
+#  LICENSE file in the root directory of this source tree.
+#
+
+"""
+Generate ZIKSegueRoutes.plist from storyboards, so ZIKViewRouter can skip searching routable views for segues whose destinations never contain any.
+
+The manifest maps each segue identifier to all view controller classes its destination may contain: the destination itself, and view controllers connected with relationship segues and embed segues, recursively. Segues to storyboard references or page view controllers are left out, their contents are only known at runtime.
+
+Add a Run Script phase after "Copy Bundle Resources":
+
+    python3 "${PODS_ROOT}/ZIKRouter/Scripts/generate_segue_route_manifest.py" "${SRCROOT}" \
+        --output "${TARGET_BUILD_DIR}/${UNLOCALIZED_RESOURCES_FOLDER_PATH}/ZIKSegueRoutes.plist" \
+        --module "${PRODUCT_MODULE_NAME}"
+"""
+
+import argparse
+import os
+import plistlib
+import sys
+import xml.etree.ElementTree as ElementTree
+
+# Storyboard element tag of system view controllers, and their class names.
+UIKIT_CLASSES = {
+    'viewController': 'UIViewController',
+    'navigationController': 'UINavigationController',
+    'tabBarController': 'UITabBarController',
+    'tableViewController': 'UITableViewController',
+    'collectionViewController': 'UICollectionViewController',
+    'splitViewController': 'UISplitViewController',
+    'pageViewController': 'UIPageViewController',
+    'glkViewController': 'GLKViewController',
+    'avPlayerViewController': 'AVPlayerViewController',
+    'hostingController': 'UIHostingController',
+}
+
+APPKIT_CLASSES = {
+    'viewController': 'NSViewController',
+    'windowController': 'NSWindowController',
+    'tabViewController': 'NSTabViewController',
+    'splitViewController': 'NSSplitViewController',
+    'pagecontroller': 'NSPageController',
+    'hostingController': 'NSHostingController',
+}
+
+# Containers whose children are set in code.
+UNRESOLVABLE_TAGS = {'pageViewController', 'pagecontroller', 'viewControllerPlaceholder'}
+
+
+def storyboard_paths(paths):
+    for path in paths:
+        if os.path.isfile(path):
+            yield path
+            continue
+        for root, dirs, files in os.walk(path):
+            # Skip build products and dependencies checked into the source root
+            dirs[:] = [d for d in dirs if not d.startswith('.') and d not in ('build', 'DerivedData', 'Carthage')]
+            for name in files:
+                if name.endswith('.storyboard'):
+                    yield os.path.join(root, name)
+
+
+def class_name(element, system_classes, module):
+    custom_class = element.get('customClass')
+    if custom_class is None:
+        return system_classes.get(element.tag)
+    custom_module = element.get('customModule')
+    if custom_module is None and element.get('customModuleProvider') == 'target':
+        custom_module = module
+    # Objc classes have no module
+    if custom_module:
+        return custom_module + '.' + custom_class
+    return custom_class
+
+
+class Storyboard(object):
+
+    def __init__(self, path, module):
+        root = ElementTree.parse(path).getroot()
+        runtime = root.get('targetRuntime', '')
+        system_classes = APPKIT_CLASSES if runtime.startswith('MacOSX') else UIKIT_CLASSES
+        self.controllers = {}
+        # (identifier, source controller id, destination id) of segues, and controller id -> ids of contained controllers
+        self.segues = []
+        self.children = {}
+        for scene in root.iter('scene'):
+            objects = scene.find('objects')
+            if objects is None:
+                continue
+            for controller in objects:
+                if controller.get('sceneMemberID') != 'viewController':
+                    continue
+                controller_id = controller.get('id')
+                unresolvable = controller.tag in UNRESOLVABLE_TAGS
+                self.controllers[controller_id] = (class_name(controller, system_classes, module), unresolvable)
+                children = self.children.setdefault(controller_id, [])
+                for segue in controller.iter('segue'):
+                    kind = segue.get('kind')
+                    destination = segue.get('destination')
+                    if kind == 'unwind' or destination is None:
+                        continue
+                    if kind in ('relationship', 'embed'):
+                        children.append(destination)
+                    identifier = segue.get('identifier')
+                    if identifier:
+                        self.segues.append((identifier, destination))
+
+    def contained_classes(self, controller_id):
+        """Classes of the controller and all controllers it contains, or None when any of them is unresolvable."""
+        classes = set()
+        visited = set()
+        pending = [controller_id]
+        while pending:
+            current = pending.pop()
+            if current in visited:
+                continue
+            visited.add(current)
+            controller = self.controllers.get(current)
+            if controller is None or controller[1]:
+                return None
+            if controller[0]:
+                classes.add(controller[0])
+            pending.extend(self.children.get(current, []))
+        return classes
+
+
+def generate_manifest(paths, module):
+    manifest = {}
+    unresolvable = set()
+    for path in storyboard_paths(paths):
+        try:
+            storyboard = Storyboard(path, module)
+        except ElementTree.ParseError as error:
+            sys.stderr.write('warning: skip invalid storyboard %s: %s\n' % (path, error))
+            continue
+        for identifier, destination in storyboard.segues:
+            classes = storyboard.contained_classes(destination)
+            if classes is None:
+                unresolvable.add(identifier)
+                continue
+            # Same identifier in different storyboards, the manifest keeps all possible destinations
+            manifest.setdefault(identifier, set()).update(classes)
+    return {identifier: sorted(classes) for identifier, classes in manifest.items() if identifier not in unresolvable}
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate segue route manifest for ZIKViewRouter.')
+    parser.add_argument('paths', nargs='+', help='Storyboard files, or directories to search for storyboards.')
+    parser.add_argument('--output', required=True, help='Path of the generated plist.')
+    parser.add_argument('--module', default=os.environ.get('PRODUCT_MODULE_NAME'), help='Module of Swift classes using "Inherit Module From Target".')
+    arguments = parser.parse_args()
+
+    manifest = generate_manifest(arguments.paths, arguments.module)
+    output_directory = os.path.dirname(arguments.output)
+    if output_directory and not os.path.isdir(output_directory):
+        os.makedirs(output_directory)
+    with open(arguments.output, 'wb') as output:
+        plistlib.dump(manifest, output)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,67 @@
+#
+#  zikrouter_lldb.py
+#  ZIKRouter
+#
+#  Created by agent on 2026/10/15.
+#  Copyright © 2026 agent. All rights reserved.
+#
+#  This source code is licensed under the MIT-style license found in the
+#  LICENSE file in the root directory of this source tree.
+#
+
+"""
+LLDB commands for inspecting ZIKRouter in a running app.
+
+    zikregistry [path]
+
+Export all registries of the paused process as JSON with `+[ZIKRouteRegistry exportRegistryToFile:error:]`. The file is written by the debugged process, so when debugging on device, the path is in the app's sandbox. Default path is `zikrouter_registry.json` in the process's temporary directory.
+
+Load it in ~/.lldbinit:
+
+    command script import "${PODS_ROOT}/ZIKRouter/Scripts/zikrouter_lldb.py"
+"""
+
+import shlex
+
+import lldb
+
+
+def _evaluate(debugger, expression, result):
+    frame = debugger.GetSelectedTarget().GetProcess().GetSelectedThread().GetSelectedFrame()
+    if not frame.IsValid():
+        result.SetError('process is not paused')
+        return None
+    options = lldb.SBExpressionOptions()
+    options.SetLanguage(lldb.eLanguageTypeObjC_plus_plus)
+    options.SetTrapExceptions(False)
+    value = frame.EvaluateExpression(expression, options)
+    if value.GetError().Fail():
+        result.SetError(str(value.GetError()))
+        return None
+    return value
+
+
+def zikregistry(debugger, command, result, internal_dict):
+    """Export all registries of ZIKRouter as JSON. Usage: zikregistry [path]"""
+    arguments = shlex.split(command)
+    if len(arguments) > 1:
+        result.SetError('usage: zikregistry [path]')
+        return
+    if arguments:
+        path = '@"%s"' % arguments[0].replace('\\', '\\\\').replace('"', '\\"')
+    else:
+        path = '[NSTemporaryDirectory() stringByAppendingPathComponent:@"zikrouter_registry.json"]'
+    expression = ('NSString *$path = %s; '
+                  '(BOOL)[(Class)NSClassFromString(@"ZIKRouteRegistry") exportRegistryToFile:$path error:nil] ? $path : nil' % path)
+    value = _evaluate(debugger, expression, result)
+    if value is None:
+        return
+    summary = value.GetObjectDescription()
+    if value.GetValueAsUnsigned() == 0 or summary is None:
+        result.SetError('failed to export registry, see console for error')
+        return
+    result.AppendMessage('Registry is exported to %s' % summary)
+
+
+def __lldb_init_module(debugger, internal_dict):
+    debugger.HandleCommand('command script add -f %s.zikregistry zikregistry' % __name__)
@@ -0,0 +1,40 @@
+#!/bin/sh
+#
+#  generate_registration_code.sh
+#  ZIKRouter
+#
+#  Generate registration code of all routers by running unit tests in DEBUG mode.
+#  +registerAll writes registration files for each module when ZIKROUTER_REGISTRATION_CODE_OUTPUT is set, see zix_writeRegistrationCode() in ZIKRouterRuntimeDebug.h.
+#
+#  Usage:
+#    generate_registration_code.sh <output directory> <xcodebuild options...>
+#
+#  Example, as a step in CI or a scheme's build pre-action:
+#    sh Templates/generate_registration_code.sh "$SRCROOT/Generated/Registration" \
+#        -workspace App.xcworkspace -scheme AppTests -destination 'platform=iOS Simulator,name=iPhone 8'
+#
+#  Add generated files into your targets once, then call ZIKRouterRegisterAllModules() and the generated Swift functions
+#  after setting ZIKRouteRegistry.autoRegister to NO in release builds. Files are only rewritten when routers change.
+
+set -e
+
+if [ $# -lt 2 ]; then
+    echo "usage: $0 <output directory> <xcodebuild options...>" >&2
+    exit 1
+fi
+
+OUTPUT_DIR="$1"
+shift
+
+mkdir -p "$OUTPUT_DIR"
+
+# xcodebuild passes variables prefixed with TEST_RUNNER_ into the test process without the prefix
+TEST_RUNNER_ZIKROUTER_REGISTRATION_CODE_OUTPUT="$OUTPUT_DIR" \
+xcodebuild test -configuration Debug "$@"
+
+if [ ! -f "$OUTPUT_DIR/ZIKRouterRegistration.h" ]; then
+    echo "error: registration code is not generated, make sure the test host calls +[ZIKRouteRegistry registerAll] in DEBUG mode." >&2
+    exit 1
+fi
+
+echo "Registration code is generated in $OUTPUT_DIR"
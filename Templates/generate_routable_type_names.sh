@@ -0,0 +1,65 @@
+#!/bin/sh
+#
+#  generate_routable_type_names.sh
+#  ZIKRouter
+#
+#  Replace `self.init(declaredProtocol: Protocol.self)` in routable declarations with `self.init(declaredTypeName: "<Protocol>")`,
+#  so the type name is a string literal generated before compiling, and declarations don't call `String(describing:)` at runtime.
+#  Names are written in the same form as `String(describing:)`: module prefixes are removed, and composed types are joined with " & ".
+#  In DEBUG mode, `init(declaredTypeName:)` still asserts that the name is correct.
+#
+#  Usage:
+#    generate_routable_type_names.sh [--check] <source directory or file...>
+#
+#  Example, as a build phase running before `Compile Sources`:
+#    sh Templates/generate_routable_type_names.sh "$SRCROOT/Modules"
+#
+#  With --check, files are not modified, and the script fails when any declaration still uses `declaredProtocol`. Use it in CI.
+
+set -e
+
+CHECK=0
+if [ "$1" = "--check" ]; then
+    CHECK=1
+    shift
+fi
+
+if [ $# -lt 1 ]; then
+    echo "usage: $0 [--check] <source directory or file...>" >&2
+    exit 1
+fi
+
+FILES=$(find "$@" -name "*.swift" -type f -exec grep -l "declaredProtocol: *Protocol.self" {} + || true)
+if [ -z "$FILES" ]; then
+    exit 0
+fi
+
+# Files are only written when declarations are replaced, so unchanged files won't be recompiled
+CHECK=$CHECK perl -e '
+    # Same form as String(describing:)
+    sub type_name {
+        my ($type) = @_;
+        return join(" & ", map { my $t = $_; $t =~ s/^\s+|\s+$//g; $t =~ s/^.*\.//; $t } split(/&/, $type));
+    }
+    my $status = 0;
+    for my $file (@ARGV) {
+        open(my $in, "<", $file) or die "error: can not read $file\n";
+        local $/;
+        my $source = <$in>;
+        close($in);
+        my $count = ($source =~ s!
+            (extension\s+Routable(?:Service|ServiceModule|View|ViewModule)\s+where\s+Protocol\s*==\s*([^{]+?)\s*\{\s*init\(\)\s*\{\s*self\.init\()declaredProtocol:\s*Protocol\.self\)
+        !$1 . "declaredTypeName: \"" . type_name($2) . "\")"!gex);
+        next unless $count;
+        if ($ENV{CHECK}) {
+            print STDERR "error: $file has $count routable declaration(s) using declaredProtocol, run generate_routable_type_names.sh to generate type names.\n";
+            $status = 1;
+            next;
+        }
+        open(my $out, ">", $file) or die "error: can not write $file\n";
+        print $out $source;
+        close($out);
+        print "Generated $count routable type name(s) in $file\n";
+    }
+    exit $status;
+' $FILES
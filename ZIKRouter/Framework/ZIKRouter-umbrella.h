@@ -13,13 +13,19 @@
 #import "ZIKPlatformCapabilities.h"
 #import "ZIKRouter.h"
 #import "ZIKRouteConfiguration.h"
+#import "ZIKRouteCancellationToken.h"
 #import "ZIKRouterType.h"
+#import "ZIKRouteHandle.h"
+#import "ZIKRouteMetrics.h"
+#import "ZIKRouteTrace.h"
+#import "ZIKRouteEventLog.h"
 
 #import "ZIKRouterRuntime.h"
 #import "ZIKServiceRouter.h"
 #import "ZIKServiceRouter+Discover.h"
 #import "ZIKServiceRouterType.h"
 #import "ZIKServiceRouteAdapter.h"
+#import "ZIKLazyServiceProxy.h"
 #import "ZIKServiceRoutable.h"
 #import "ZIKServiceModuleRoutable.h"
 #import "ZIKServiceRoute.h"
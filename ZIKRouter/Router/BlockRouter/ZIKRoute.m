@@ -11,11 +11,15 @@
 
 #import "ZIKRoute.h"
 #import "ZIKRouterInternal.h"
+#import "ZIKRouterPrivate.h"
 #import "ZIKRouteConfiguration.h"
 #import "ZIKRouteRegistryInternal.h"
 #import "ZIKRouteConfigurationPrivate.h"
+#import "ZIKRouteCallbacks.h"
 
-@interface ZIKRoute()
+@interface ZIKRoute() {
+    ZIKRouteCallbacks _callbacks;
+}
 @property (nonatomic, strong) ZIKRoute *retainedSelf;
 @property (nonatomic, strong) Class destinationClass;
 @property (nonatomic, copy) _Nullable id(^makeDestinationBlock)(ZIKPerformRouteConfiguration *config, ZIKRouter *router);
@@ -23,6 +27,7 @@
 @property (nonatomic, copy, nullable) ZIKRemoveRouteConfiguration *(^makeDefaultRemoveConfigurationBlock)(void);
 @property (nonatomic, copy, nullable) void(^prepareDestinationBlock)(id destination, ZIKPerformRouteConfiguration *config, ZIKRouter *router);
 @property (nonatomic, copy, nullable) void(^didFinishPrepareDestinationBlock)(id destination, ZIKPerformRouteConfiguration *config, ZIKRouter *router);
+@property (nonatomic, assign) BOOL makesDestinationWithoutRouter;
 @end
 
 @implementation ZIKRoute
@@ -71,6 +76,30 @@
     return nil;
 }
 
+- (const ZIKRouteCallbacks *)callbacks {
+    return &_callbacks;
+}
+
+- (void)setMakeDestinationBlock:(id _Nullable (^)(ZIKPerformRouteConfiguration *, ZIKRouter *))makeDestinationBlock {
+    _makeDestinationBlock = [makeDestinationBlock copy];
+    _callbacks.makeDestination = _makeDestinationBlock;
+}
+
+- (void)setMakeDefaultRemoveConfigurationBlock:(ZIKRemoveRouteConfiguration *(^)(void))makeDefaultRemoveConfigurationBlock {
+    _makeDefaultRemoveConfigurationBlock = [makeDefaultRemoveConfigurationBlock copy];
+    _callbacks.makeDefaultRemoveConfiguration = _makeDefaultRemoveConfigurationBlock;
+}
+
+- (void)setPrepareDestinationBlock:(void (^)(id, ZIKPerformRouteConfiguration *, ZIKRouter *))prepareDestinationBlock {
+    _prepareDestinationBlock = [prepareDestinationBlock copy];
+    _callbacks.prepareDestination = _prepareDestinationBlock;
+}
+
+- (void)setDidFinishPrepareDestinationBlock:(void (^)(id, ZIKPerformRouteConfiguration *, ZIKRouter *))didFinishPrepareDestinationBlock {
+    _didFinishPrepareDestinationBlock = [didFinishPrepareDestinationBlock copy];
+    _callbacks.didFinishPrepareDestination = _didFinishPrepareDestinationBlock;
+}
+
 - (ZIKRoute<id, ZIKPerformRouteConfiguration *, ZIKRemoveRouteConfiguration *> *(^)(NSString *))nameAs {
     return ^(NSString *name) {
         self.name = name;
@@ -186,12 +215,15 @@
     return [[[self routerClass] alloc] init];
 }
 
-#define INJECT_CONFIG_BUILDER configBuilder = ^(ZIKPerformRouteConfiguration *configuration) {\
-    configuration.route = self;\
-    ZIKPerformRouteConfiguration *injected = [self defaultRouteConfigurationFromBlock];\
-    if (injected) {\
-        configuration.injected = injected;\
-        configuration = injected;\
+#define INJECT_CONFIG_BUILDER ZIX_INJECTING_ROUTE_SCOPE(self);\
+configBuilder = ^(ZIKPerformRouteConfiguration *configuration) {\
+    if (configuration.route != self) {\
+        configuration.route = self;\
+        ZIKPerformRouteConfiguration *injected = [self defaultRouteConfigurationFromBlock];\
+        if (injected) {\
+            configuration.injected = injected;\
+            configuration = injected;\
+        }\
     }\
     if (configBuilder) {\
         configBuilder(configuration);\
@@ -213,17 +245,6 @@
     };
 }
 
-#define INJECT_REMOVE_BUILDER removeConfigBuilder = ^(ZIKRemoveRouteConfiguration *configuration) {\
-    ZIKRemoveRouteConfiguration *injected = [self defaultRemoveRouteConfigurationFromBlock];\
-    if (injected) {\
-        configuration.injected = injected;\
-        configuration = injected;\
-    }\
-    if (removeConfigBuilder) {\
-        removeConfigBuilder(configuration);\
-    }\
-};\
-
 - (void(^)(ZIKRemoveRouteConfiguration *config))_injectedRemoveConfigBuilder:(void(^)(ZIKRemoveRouteConfiguration *config))builder {
     return ^(ZIKRemoveRouteConfiguration *configuration) {
         ZIKRemoveRouteConfiguration *injected = [self defaultRemoveRouteConfigurationFromBlock];
@@ -237,13 +258,16 @@
     };
 }
 
-#define INJECT_STRICT_CONFIG_BUILDER configBuilder = ^(ZIKPerformRouteStrictConfiguration<id> *strictConfig, ZIKPerformRouteConfiguration *configuration) {\
-    configuration.route = self;\
-    ZIKPerformRouteConfiguration *injected = [self defaultRouteConfigurationFromBlock];\
-    if (injected) {\
-        configuration.injected = injected;\
-        configuration = injected;\
-        strictConfig.configuration = injected;\
+#define INJECT_STRICT_CONFIG_BUILDER ZIX_INJECTING_ROUTE_SCOPE(self);\
+configBuilder = ^(ZIKPerformRouteStrictConfiguration<id> *strictConfig, ZIKPerformRouteConfiguration *configuration) {\
+    if (configuration.route != self) {\
+        configuration.route = self;\
+        ZIKPerformRouteConfiguration *injected = [self defaultRouteConfigurationFromBlock];\
+        if (injected) {\
+            configuration.injected = injected;\
+            configuration = injected;\
+            strictConfig.configuration = injected;\
+        }\
     }\
     if (configBuilder) {\
         configBuilder(strictConfig, configuration);\
@@ -268,18 +292,6 @@ _injectedStrictConfigBuilder:
     };
 }
 
-#define INJECT_STRICT_REMOVE_BUILDER removeConfigBuilder = ^(ZIKRemoveRouteStrictConfiguration<id> *strictConfig) {\
-    ZIKRemoveRouteConfiguration *injected = [self defaultRemoveRouteConfigurationFromBlock];\
-    if (injected) {\
-        ZIKRemoveRouteConfiguration *configuration = strictConfig.configuration;\
-        configuration.injected = injected;\
-        strictConfig.configuration = injected;\
-    }\
-    if (removeConfigBuilder) {\
-        removeConfigBuilder(strictConfig);\
-    }\
-};\
-
 - (void (^)(ZIKRemoveRouteStrictConfiguration<id> * _Nonnull))
 _injectedStrictRemoveConfigBuilder:
 (void (^)(ZIKRemoveRouteStrictConfiguration<id> * _Nonnull)
@@ -309,14 +321,12 @@ _injectedStrictRemoveConfigBuilder:
 
 - (id)initWithConfiguring:(void(^)(ZIKPerformRouteConfiguration *configuration))configBuilder removing:(void(^ _Nullable)(ZIKRemoveRouteConfiguration *configuration))removeConfigBuilder {
     INJECT_CONFIG_BUILDER;
-    INJECT_REMOVE_BUILDER;
     return [[[self routerClass] alloc] initWithConfiguring:configBuilder removing:removeConfigBuilder];
 }
 
 - (id)initWithStrictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, ZIKPerformRouteConfiguration * _Nonnull))configBuilder
                  strictRemoving:(void (^ _Nullable)(ZIKRemoveRouteStrictConfiguration<id> * _Nonnull))removeConfigBuilder {
     INJECT_STRICT_CONFIG_BUILDER;
-    INJECT_STRICT_REMOVE_BUILDER;
     return [[[self routerClass] alloc] initWithStrictConfiguring:configBuilder strictRemoving:removeConfigBuilder];
 }
 
@@ -385,7 +395,6 @@ _injectedStrictRemoveConfigBuilder:
 
 - (id)performWithConfiguring:(void(^)(ZIKPerformRouteConfiguration *configuration))configBuilder removing:(void(^)(ZIKRemoveRouteConfiguration *configuration))removeConfigBuilder {
     INJECT_CONFIG_BUILDER;
-    INJECT_REMOVE_BUILDER;
     return [[self routerClass] performWithConfiguring:configBuilder removing:removeConfigBuilder];
 }
 
@@ -396,7 +405,6 @@ _injectedStrictRemoveConfigBuilder:
 - (id)performWithStrictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, ZIKPerformRouteConfiguration * _Nonnull))configBuilder
                     strictRemoving:(void (^)(ZIKRemoveRouteStrictConfiguration<id> * _Nonnull))removeConfigBuilder {
     INJECT_STRICT_CONFIG_BUILDER;
-    INJECT_STRICT_REMOVE_BUILDER;
     return [[self routerClass] performWithStrictConfiguring:configBuilder strictRemoving:removeConfigBuilder];
 }
 
@@ -451,6 +459,10 @@ _injectedStrictRemoveConfigBuilder:
     return nil;
 }
 
+- (void)didUnregister {
+    self.retainedSelf = nil;
+}
+
 - (nullable ZIKRemoveRouteConfiguration *)defaultRemoveRouteConfigurationFromBlock {
     if (self.makeDefaultRemoveConfigurationBlock) {
         return self.makeDefaultRemoveConfigurationBlock();
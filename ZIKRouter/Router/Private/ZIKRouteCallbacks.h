@@ -0,0 +1,35 @@
+//
+//  ZIKRouteCallbacks.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ZIKRouter, ZIKPerformRouteConfiguration, ZIKRemoveRouteConfiguration, ZIKViewRouter, ZIKViewRouteConfiguration, ZIKViewRemoveConfiguration;
+
+/// Callbacks of a route, updated when blocks are set, so block routers call them without reading block properties. Blocks are retained by the route's properties.
+typedef struct ZIKRouteCallbacks {
+    __unsafe_unretained id _Nullable(^_Nullable makeDestination)(ZIKPerformRouteConfiguration *config, ZIKRouter *router);
+    __unsafe_unretained ZIKRemoveRouteConfiguration *_Nullable(^_Nullable makeDefaultRemoveConfiguration)(void);
+    __unsafe_unretained void(^_Nullable prepareDestination)(id destination, ZIKPerformRouteConfiguration *config, ZIKRouter *router);
+    __unsafe_unretained void(^_Nullable didFinishPrepareDestination)(id destination, ZIKPerformRouteConfiguration *config, ZIKRouter *router);
+} ZIKRouteCallbacks;
+
+/// View callbacks of a view route, see `ZIKRouteCallbacks`.
+typedef struct ZIKViewRouteCallbacks {
+    __unsafe_unretained BOOL(^_Nullable destinationFromExternalPrepared)(id destination, ZIKViewRouter *router);
+    __unsafe_unretained BOOL(^_Nullable canPerformCustomRoute)(ZIKViewRouter *router);
+    __unsafe_unretained BOOL(^_Nullable canRemoveCustomRoute)(ZIKViewRouter *router);
+    __unsafe_unretained void(^_Nullable performCustomRoute)(id destination, _Nullable id source, ZIKViewRouteConfiguration *config, ZIKViewRouter *router);
+    __unsafe_unretained void(^_Nullable removeCustomRoute)(id destination, _Nullable id source, ZIKViewRemoveConfiguration *removeConfig, ZIKViewRouteConfiguration *config, ZIKViewRouter *router);
+} ZIKViewRouteCallbacks;
+
+NS_ASSUME_NONNULL_END
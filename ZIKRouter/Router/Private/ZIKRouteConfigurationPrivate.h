@@ -13,21 +13,40 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@interface ZIKRouteConfiguration()
+/// Append error handler for current performing. Handlers are invoked after `performerErrorHandler` in adding order.
+- (void)addPerformerErrorHandler:(ZIKRouteErrorHandler)handler;
+/// Return appended error handlers and clear them.
+- (nullable NSArray<ZIKRouteErrorHandler> *)takePerformerErrorHandlers;
+@end
+
 @class ZIKRoute;
 @interface ZIKPerformRouteConfiguration()
 @property (nonatomic, strong, nullable) ZIKRoute *route;
 /// Let ZIKRoute inject the defaultRouteConfiguration to the router.
 @property (nonatomic, strong, nullable) ZIKPerformRouteConfiguration *injected;
 - (void)removeUserInfo;
+/// Append success handler for current performing. Handlers are invoked after `performerSuccessHandler` in adding order.
+- (void)addPerformerSuccessHandler:(void(^)(id destination))handler;
+/// Return appended success handlers and clear them.
+- (nullable NSArray<void(^)(id destination)> *)takePerformerSuccessHandlers;
+/// Copy for performing with a configuration template. User info is shared with the template until the copy changes it, so performing never changes the template.
+- (instancetype)templateCopy;
 @end
 
 @interface ZIKRemoveRouteConfiguration()
 /// Let ZIKRoute inject the defaultRemoveConfiguration to the router.
 @property (nonatomic, strong, nullable) ZIKRemoveRouteConfiguration *injected;
+/// Append success handler for current removing. Handlers are invoked after `performerSuccessHandler` in adding order.
+- (void)addPerformerSuccessHandler:(void(^)(void))handler;
+/// Return appended success handlers and clear them.
+- (nullable NSArray<void(^)(void)> *)takePerformerSuccessHandlers;
 @end
 
 @interface ZIKRouteStrictConfiguration()
 @property (nonatomic, strong) ZIKRouteConfiguration *configuration;
+/// Release the wrapped configuration, so a strict configuration kept for reusing doesn't keep blocks in the configuration. Rebind it with `configuration` before using it again.
+- (void)unbindConfiguration;
 @end
 
 @interface ZIKPerformRouteStrictConfiguration()
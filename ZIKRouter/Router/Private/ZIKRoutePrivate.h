@@ -10,6 +10,7 @@
 //
 
 #import "ZIKRoute.h"
+#import "ZIKRouteCallbacks.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -19,9 +20,19 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, copy, readonly, nullable) RemoveConfig(^makeDefaultRemoveConfigurationBlock)(void);
 @property (nonatomic, copy, readonly, nullable) void(^prepareDestinationBlock)(Destination destination, RouteConfig config, ZIKRouter *router);
 @property (nonatomic, copy, readonly, nullable) void(^didFinishPrepareDestinationBlock)(Destination destination, RouteConfig config, ZIKRouter *router);
+/// makeDestinationBlock only uses the configuration, and the router passed to it can be nil. Registry sets it for easy routes of registered factories, so destination can be made without creating router.
+@property (nonatomic, assign) BOOL makesDestinationWithoutRouter;
+/// Callbacks resolved from blocks. The pointer is valid while the route is alive.
+@property (nonatomic, readonly) const ZIKRouteCallbacks *callbacks;
 
 + (Class)registryClass;
 
+/// Configuration made by `makeDefaultConfiguration` block, nil when the block is not set.
+- (nullable RouteConfig)defaultRouteConfigurationFromBlock;
+
+/// Registered route retains itself, registry calls this after the route is removed from all maps, then it's released when no one holds it.
+- (void)didUnregister;
+
 @end
 
 NS_ASSUME_NONNULL_END
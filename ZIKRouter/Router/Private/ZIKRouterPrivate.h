@@ -10,11 +10,16 @@
 //
 
 #import "ZIKRouter.h"
+#import "ZIKRouteMetrics.h"
+#import "ZIKRouteTrace.h"
+#import "ZIKRouteEventLog.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
 @interface ZIKRouter () {
     @protected ZIKRemoveRouteConfiguration *_removeConfiguration;
+    /// The router is created or reused by `+makeDestination` and is discarded after making, so the destination is not bound to it.
+    @protected BOOL _makingDestinationOnly;
 }
 
 + (ZIKPerformRouteStrictConfiguration *)defaultRouteStrictConfigurationFor:(ZIKPerformRouteConfiguration *)configuration;
@@ -23,6 +28,12 @@ NS_ASSUME_NONNULL_BEGIN
 
 #pragma mark Internal Methods
 
+/// Get destination for performing. Default calls -destinationWithConfiguration:. Router for shared destinations overrides it to return cached destination.
+- (nullable id)makeDestinationWithConfiguration:(ZIKPerformRouteConfiguration *)configuration;
+
+/// Replace configuration of a routed router, when its destination is reused and prepared again without performing.
+- (void)rebindConfiguration:(ZIKPerformRouteConfiguration *)configuration;
+
 /// Change state.
 - (void)notifyRouteState:(ZIKRouterState)state;
 
@@ -38,6 +49,233 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)notifyError_overRouteWithAction:(ZIKRouteAction)action errorDescription:(NSString *)format ,...;
 - (void)notifyError_infiniteRecursionWithAction:(ZIKRouteAction)action errorDescription:(NSString *)format ,...;
 
+/// Route type as metadata of signposts. Default is nil.
+- (nullable NSString *)signpostRouteType;
+
+/// Route type recorded in route event log when routing or removing starts. Default is -1, for routers without route type.
+- (NSInteger)eventLogRouteType;
+
+/// Release blocks of configuration only used for performing, when `releasesPerformHandlersWhenRouted` is YES. Subclass can override to release more or keep them, and must call super to release.
+- (void)releasePerformHandlers;
+
 @end
 
+/// Start time for metrics, 0 when +[ZIKRouter recordsMetrics] is NO.
+FOUNDATION_EXTERN uint64_t zix_routeMetricsTime(void);
+
+/// Record latency from startTime into histogram of current thread. Do nothing when startTime is 0.
+FOUNDATION_EXTERN void zix_recordRouteMetric(Class routerClass, ZIKRouteMetric metric, uint64_t startTime);
+
+/// Time for router stages, 0 when +[ZIKRouter recordsStageTimestamps] is NO.
+FOUNDATION_EXTERN uint64_t zix_routerStageTime(void);
+
+/// Timestamp of the stage recorded in router, 0 when not recorded.
+FOUNDATION_EXTERN uint64_t zix_routerStageTimestamp(ZIKRouter *router, ZIKRouterStage stage);
+
+/// Storage of ZIKRouterCounter, read by +[ZIKRouterMetrics currentMetrics].
+FOUNDATION_EXTERN uint64_t zix_routerCounters[];
+
+/// Increase counter of ZIKRouterMetrics with relaxed atomic, it's cheap enough for hot paths.
+static inline void zix_addRouterCounter(ZIKRouterCounter counter, uint64_t value) {
+    __atomic_fetch_add(&zix_routerCounters[counter], value, __ATOMIC_RELAXED);
+}
+
+static inline void zix_incrementRouterCounter(ZIKRouterCounter counter) {
+    zix_addRouterCounter(counter, 1);
+}
+
+/// Record duration from startTime into timing of ZIKRouterMetrics. Get startTime with `zix_routeMetricsTime`, do nothing when it's 0.
+FOUNDATION_EXTERN void zix_recordRouterTiming(ZIKRouterTiming timing, uint64_t startTime);
+
+/// Whether +[ZIKRouter startTracingToFile:] is recording, written atomically.
+FOUNDATION_EXTERN bool zix_routeTracing;
+
+static inline bool zix_isTracing(void) {
+    return __atomic_load_n(&zix_routeTracing, __ATOMIC_RELAXED);
+}
+
+/// Start time for trace events, 0 when it's not tracing.
+FOUNDATION_EXTERN uint64_t zix_traceTime(void);
+
+/// Record a complete event from startTime until now. Name and detail are copied and may be truncated, category must be a string literal. Do nothing when startTime is 0.
+FOUNDATION_EXTERN void zix_traceComplete(const char *name, const char *category, uint64_t startTime, const char *_Nullable detail);
+
+/// Start tracing if `ZIKRouteTraceOutputEnvironmentKey` is set. Only checked once.
+FOUNDATION_EXTERN void zix_startTracingFromEnvironment(void);
+
+typedef struct ZIKTraceScope {
+    const char *name;
+    const char *category;
+    const char *_Nullable detail;
+    uint64_t startTime;
+} ZIKTraceScope;
+
+static inline void zix_endTraceScope(ZIKTraceScope *scope) {
+    zix_traceComplete(scope->name, scope->category, scope->startTime, scope->detail);
+}
+
+/// Trace from here to the end of current scope, including all return paths. Detail is only evaluated when tracing.
+#define ZIX_TRACE_SCOPE(name, category, detail) \
+    __attribute__((cleanup(zix_endTraceScope), unused)) ZIKTraceScope _zix_traceScope = { (name), (category), zix_isTracing() ? (detail) : NULL, zix_traceTime() }
+
+/// Threshold of +[ZIKRouter slowCallbackThreshold] in nanoseconds, 0 when the watchdog is disabled. Written atomically.
+FOUNDATION_EXTERN uint64_t zix_slowCallbackThreshold;
+
+/// Start watching a callback on current thread. Return NULL when the watchdog is disabled.
+FOUNDATION_EXTERN void *_Nullable zix_beginWatchingCallback(void);
+
+/// Stop watching and report the callback if it's slow.
+FOUNDATION_EXTERN void zix_finishWatchingCallback(void *record, Class routerClass, ZIKRouteCallbackStage stage);
+
+typedef struct ZIKRouteCallbackWatch {
+    __unsafe_unretained ZIKRouter *router;
+    ZIKRouteCallbackStage stage;
+    void *_Nullable record;
+} ZIKRouteCallbackWatch;
+
+static inline void zix_endCallbackWatch(ZIKRouteCallbackWatch *watch) {
+    if (watch->record) {
+        zix_finishWatchingCallback(watch->record, [watch->router class], watch->stage);
+    }
+}
+
+/// Watch route callback from here to the end of current scope. Only one watch in a scope.
+#define ZIX_WATCH_CALLBACK_SCOPE(router, stage) \
+    __attribute__((cleanup(zix_endCallbackWatch), unused)) ZIKRouteCallbackWatch _zix_callbackWatch = { (router), (stage), __atomic_load_n(&zix_slowCallbackThreshold, __ATOMIC_RELAXED) ? zix_beginWatchingCallback() : NULL }
+
+/// Interval of +[ZIKRouter hookProfilingSampleInterval], 0 when the hook profiler is disabled. Written atomically.
+FOUNDATION_EXTERN uint64_t zix_hookProfilingSampleInterval;
+
+typedef struct ZIKHookProfile {
+    ZIKRouterCounter hook;
+    bool profiling;
+    /// Hook did routing work instead of returning early.
+    bool processed;
+    /// Start time of a sampled invocation, 0 when it's not sampled.
+    uint64_t startTime;
+    uint64_t originalStartTime;
+    /// Time in the original implementation, excluded from the hook's duration.
+    uint64_t originalDuration;
+} ZIKHookProfile;
+
+/// Count an invocation of the hook, and start timing it when it's sampled.
+FOUNDATION_EXTERN ZIKHookProfile zix_startHookProfile(ZIKRouterCounter hook);
+
+/// Record duration and early exit of the hook.
+FOUNDATION_EXTERN void zix_finishHookProfile(ZIKHookProfile *profile);
+
+/// Current time of sampled hooks.
+FOUNDATION_EXTERN uint64_t zix_hookProfileTime(void);
+
+static inline ZIKHookProfile zix_beginHookProfile(ZIKRouterCounter hook) {
+    if (__atomic_load_n(&zix_hookProfilingSampleInterval, __ATOMIC_RELAXED) == 0) {
+        return (ZIKHookProfile){ hook };
+    }
+    return zix_startHookProfile(hook);
+}
+
+static inline void zix_endHookProfile(ZIKHookProfile *profile) {
+    if (profile->profiling) {
+        zix_finishHookProfile(profile);
+    }
+}
+
+static inline void zix_pauseHookProfile(ZIKHookProfile *profile) {
+    if (profile->startTime) {
+        profile->originalStartTime = zix_hookProfileTime();
+    }
+}
+
+static inline void zix_resumeHookProfile(ZIKHookProfile *profile) {
+    if (profile->startTime) {
+        profile->originalDuration += zix_hookProfileTime() - profile->originalStartTime;
+    }
+}
+
+/// Profile hooked method from here to the end of current scope. Call the original implementation with ZIX_HOOK_CALL_ORIGINAL, and mark routing work with ZIX_HOOK_PROCESSED.
+#define ZIX_HOOK_PROFILE_SCOPE(hook) \
+    __attribute__((cleanup(zix_endHookProfile), unused)) ZIKHookProfile _zix_hookProfile = zix_beginHookProfile(hook)
+
+/// Call the original implementation without counting its time in the hook.
+#define ZIX_HOOK_CALL_ORIGINAL(call) \
+    zix_pauseHookProfile(&_zix_hookProfile); \
+    call; \
+    zix_resumeHookProfile(&_zix_hookProfile)
+
+/// The hook doesn't return early, it does routing work for the view.
+#define ZIX_HOOK_PROCESSED() \
+    _zix_hookProfile.processed = true
+
+/// Append a state change into route event log without lock. router is only used as identity for pairing events of the same router. routeType is -1 when it's unknown.
+FOUNDATION_EXTERN void zix_logRouteStateEvent(Class routerClass, const void *router, ZIKRouterState oldState, ZIKRouterState state, NSInteger routeType);
+
+/// Append an error into route event log without lock. routerClass is nil when there is no router.
+FOUNDATION_EXTERN void zix_logRouteErrorEvent(Class _Nullable routerClass, ZIKRouteAction action, ZIKRouterState state, NSInteger errorCode);
+
+/// Enter before loading a snapshot published for reading without lock, and leave after the last access to it. Can be nested. Shares reader count with registry lookups.
+FOUNDATION_EXTERN void zix_beginSnapshotReading(void);
+
+FOUNDATION_EXTERN void zix_endSnapshotReading(void);
+
+/// Free a replaced snapshot with freeSnapshot once no thread is between `zix_beginSnapshotReading` and `zix_endSnapshotReading`. The snapshot must already be unreachable for new readers.
+FOUNDATION_EXTERN void zix_retireSnapshot(void *snapshot, void (*freeSnapshot)(void *snapshot));
+
+/// Publish global error handler into slot atomically. Replaced handler is retired with `zix_retireSnapshot`, and released after threads loading it have retained it.
+FOUNDATION_EXTERN void zix_publishGlobalErrorHandler(const void *_Nullable *_Nonnull slot, id _Nullable handler);
+
+/// Read and retain global error handler published by `zix_publishGlobalErrorHandler`, without lock.
+static inline id _Nullable zix_loadGlobalErrorHandler(const void *_Nullable *_Nonnull slot) {
+    zix_beginSnapshotReading();
+    id handler = (__bridge id)__atomic_load_n(slot, __ATOMIC_ACQUIRE);
+    zix_endSnapshotReading();
+    return handler;
+}
+
+/// Called after a router enters routing state when `ZIKRouter.warmsServiceDependencies` is YES, NULL otherwise. Set it atomically.
+FOUNDATION_EXTERN void (*_Nullable zix_serviceDependencyWarmer)(ZIKRouter *router);
+
+/// Discard prewarmed destinations whose router class or destination class is in the image. Called when routes in the image are unregistered.
+FOUNDATION_EXTERN void zix_discardPrewarmedDestinationsInImage(const void *header);
+
+/// Discard singleton and weak shared services whose class or route is in the image. Called when routes in the image are unregistered.
+FOUNDATION_EXTERN void zix_discardSharedServicesInImage(const void *header);
+
+/// Description of router for lazy errors. Use router's class and address when the weak router is already released.
+FOUNDATION_EXTERN NSString *zix_routerDescription(ZIKRouter *_Nullable router, Class routerClass, const void *address);
+
+/// Symbolicate addresses from `+[NSThread callStackReturnAddresses]`. Capture the addresses on the failure path, and symbolicate them when the description is read.
+FOUNDATION_EXTERN NSString *zix_symbolicateCallStack(NSArray<NSNumber *> *returnAddresses);
+
+/// Whether anything observes routers, such as interceptors, global state observers, dependency warmer, callback watchdog, tracing and metrics. Making destination without router is only allowed when it's NO, so nothing misses the route.
+FOUNDATION_EXTERN BOOL zix_routerHooksInstalled(void);
+
+/// Make destination with make block and prepare it with configuration's prepareDestination, without creating router. Errors are sent to global error handler of routerClass. Check `zix_routerHooksInstalled` before using it.
+FOUNDATION_EXTERN id _Nullable zix_makeDestinationWithoutRouter(Class routerClass, ZIKPerformRouteConfiguration *configuration, id _Nullable(NS_NOESCAPE ^make)(ZIKPerformRouteConfiguration *configuration));
+
+@class ZIKRoute;
+
+/// Route calling its router class on current thread. The next router of the route's router class initialized on this thread takes it, and makes its configuration with the route's `makeDefaultConfiguration` block, instead of making a default configuration to be replaced by `injected`.
+FOUNDATION_EXTERN __thread __unsafe_unretained ZIKRoute *_Nullable zix_injectingRoute;
+
+static inline void zix_restoreInjectingRoute(ZIKRoute *__unsafe_unretained _Nullable *_Nonnull previousRoute) {
+    zix_injectingRoute = *previousRoute;
+}
+
+/// Inject route into routers initialized from here to the end of current scope.
+#define ZIX_INJECTING_ROUTE_SCOPE(route) \
+    __attribute__((cleanup(zix_restoreInjectingRoute), unused)) ZIKRoute *__unsafe_unretained _zix_previousInjectingRoute = zix_injectingRoute; \
+    zix_injectingRoute = (route)
+
+/// YES when current thread is inside -canRemove, checking methods can return a constant message instead of formatting the reason.
+FOUNDATION_EXTERN BOOL zix_isProbingCanRemove(void);
+
+/// Message returned by -checkCanRemove when `zix_isProbingCanRemove()` is YES.
+FOUNDATION_EXTERN NSString *const ZIKRouterCanNotRemoveMessage;
+
+/// Intern the identifier and return its handle. Thread safe. Implemented in ZIKRouteRegistry.
+FOUNDATION_EXTERN ZIKRouteIdentifierHandle zix_internRouteIdentifier(NSString *identifier);
+
+/// Identifier of an interned handle, nil for invalid handle.
+FOUNDATION_EXTERN NSString *_Nullable zix_routeIdentifierOfHandle(ZIKRouteIdentifierHandle handle);
+
 NS_ASSUME_NONNULL_END
@@ -0,0 +1,39 @@
+//
+//  ZIKRouteEdgeList.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Compact list of route -> target edges for ZIKROUTER_CHECK, such as router -> destination class and router -> destination protocol.
+ 
+ Adding is only appending to an array, without allocation for each route. Edges are sorted by route when registration is finished, then targets of a route are found with binary search. Edges added after sorting are sorted again in next query. Pointers are not retained.
+ 
+ All functions are thread safe.
+ */
+typedef struct ZIKRouteEdgeList ZIKRouteEdgeList;
+
+FOUNDATION_EXTERN ZIKRouteEdgeList *zix_createRouteEdgeList(void);
+
+/// Append edge. Duplicated edges are removed when sorting.
+FOUNDATION_EXTERN void zix_routeEdgeListAddEdge(ZIKRouteEdgeList *list, const void *route, const void *target);
+
+/// Sort edges by route and remove duplicated edges.
+FOUNDATION_EXTERN void zix_routeEdgeListSort(ZIKRouteEdgeList *list);
+
+/// Whether the route has any target.
+FOUNDATION_EXTERN bool zix_routeEdgeListContainsRoute(ZIKRouteEdgeList *list, const void *route);
+
+/// Enumerate targets of the route. Targets are copied before enumerating, so the handler can add edges.
+FOUNDATION_EXTERN void zix_routeEdgeListEnumerateTargets(ZIKRouteEdgeList *list, const void *route, void(NS_NOESCAPE ^handler)(const void *target, BOOL *stop));
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,128 @@
+//
+//  ZIKRouteEdgeList.m
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKRouteEdgeList.h"
+#import <pthread.h>
+
+typedef struct ZIKRouteEdge {
+    const void *route;
+    const void *target;
+} ZIKRouteEdge;
+
+struct ZIKRouteEdgeList {
+    pthread_mutex_t lock;
+    ZIKRouteEdge *edges;
+    size_t count;
+    size_t capacity;
+    /// Edges before this are sorted.
+    size_t sortedCount;
+};
+
+ZIKRouteEdgeList *zix_createRouteEdgeList(void) {
+    ZIKRouteEdgeList *list = calloc(1, sizeof(ZIKRouteEdgeList));
+    pthread_mutex_init(&list->lock, NULL);
+    return list;
+}
+
+void zix_routeEdgeListAddEdge(ZIKRouteEdgeList *list, const void *route, const void *target) {
+    NSCParameterAssert(route);
+    NSCParameterAssert(target);
+    pthread_mutex_lock(&list->lock);
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 256;
+        list->edges = realloc(list->edges, list->capacity * sizeof(ZIKRouteEdge));
+    }
+    list->edges[list->count++] = (ZIKRouteEdge){route, target};
+    pthread_mutex_unlock(&list->lock);
+}
+
+static int _compareEdges(const void *lhs, const void *rhs) {
+    const ZIKRouteEdge *edge1 = lhs;
+    const ZIKRouteEdge *edge2 = rhs;
+    if (edge1->route != edge2->route) {
+        return (uintptr_t)edge1->route < (uintptr_t)edge2->route ? -1 : 1;
+    }
+    if (edge1->target != edge2->target) {
+        return (uintptr_t)edge1->target < (uintptr_t)edge2->target ? -1 : 1;
+    }
+    return 0;
+}
+
+/// Must be called with lock.
+static void _sortEdges(ZIKRouteEdgeList *list) {
+    if (list->sortedCount == list->count) {
+        return;
+    }
+    qsort(list->edges, list->count, sizeof(ZIKRouteEdge), _compareEdges);
+    size_t count = 0;
+    for (size_t i = 0; i < list->count; i++) {
+        if (count == 0 || _compareEdges(&list->edges[count - 1], &list->edges[i]) != 0) {
+            list->edges[count++] = list->edges[i];
+        }
+    }
+    list->count = count;
+    list->sortedCount = count;
+}
+
+/// Index of first edge of the route. Must be called with lock after sorting.
+static size_t _lowerBoundOfRoute(const ZIKRouteEdgeList *list, const void *route) {
+    size_t low = 0;
+    size_t high = list->count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if ((uintptr_t)list->edges[middle].route < (uintptr_t)route) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+void zix_routeEdgeListSort(ZIKRouteEdgeList *list) {
+    pthread_mutex_lock(&list->lock);
+    _sortEdges(list);
+    pthread_mutex_unlock(&list->lock);
+}
+
+bool zix_routeEdgeListContainsRoute(ZIKRouteEdgeList *list, const void *route) {
+    pthread_mutex_lock(&list->lock);
+    _sortEdges(list);
+    size_t index = _lowerBoundOfRoute(list, route);
+    bool contains = index < list->count && list->edges[index].route == route;
+    pthread_mutex_unlock(&list->lock);
+    return contains;
+}
+
+void zix_routeEdgeListEnumerateTargets(ZIKRouteEdgeList *list, const void *route, void(NS_NOESCAPE ^handler)(const void *target, BOOL *stop)) {
+    NSCParameterAssert(handler);
+    pthread_mutex_lock(&list->lock);
+    _sortEdges(list);
+    size_t start = _lowerBoundOfRoute(list, route);
+    size_t end = start;
+    while (end < list->count && list->edges[end].route == route) {
+        end++;
+    }
+    size_t count = end - start;
+    const void **targets = NULL;
+    if (count > 0) {
+        targets = malloc(count * sizeof(void *));
+        for (size_t i = 0; i < count; i++) {
+            targets[i] = list->edges[start + i].target;
+        }
+    }
+    pthread_mutex_unlock(&list->lock);
+    BOOL stop = NO;
+    for (size_t i = 0; i < count && !stop; i++) {
+        handler(targets[i], &stop);
+    }
+    free(targets);
+}
@@ -0,0 +1,67 @@
+//
+//  ZIKRouteIndex.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Kind of the key of a route index entry. Same protocol can be used as a destination protocol and a module protocol, so kind is part of the key.
+typedef NS_ENUM(uint32_t, ZIKRouteIndexKind) {
+    ZIKRouteIndexKindDestinationClass = 1,
+    ZIKRouteIndexKindDestinationProtocol,
+    ZIKRouteIndexKindModuleProtocol
+};
+
+typedef NS_OPTIONS(uint32_t, ZIKRouteIndexFlags) {
+    /// Route is from destinationToExclusiveRouterMap.
+    ZIKRouteIndexFlagExclusive = 1 << 0,
+    /// Route is an easy route made from factory, not a registered router.
+    ZIKRouteIndexFlagEasyRoute = 1 << 1,
+    /// Key is an adapter, route is resolved from its adapter -> adaptee chain. Route is NULL when the chain has a cycle.
+    ZIKRouteIndexFlagAdapter = 1 << 2
+};
+
+/// Compact record of everything registered for a key.
+typedef struct ZIKRouteIndexEntry {
+    const void *_Nullable key;
+    ZIKRouteIndexKind kind;
+    ZIKRouteIndexFlags flags;
+    /// Router class or ZIKRoute, retained by the index.
+    const void *_Nullable route;
+    /// Router type of the route, retained by the index.
+    const void *_Nullable routerType;
+    /// Destination class of factory registration.
+    __unsafe_unretained Class _Nullable destinationClass;
+    /// Factory function or block of factory registration.
+    const void *_Nullable factory;
+    /// Config factory function or block of factory registration.
+    const void *_Nullable configFactory;
+} ZIKRouteIndexEntry;
+
+/// Open-addressing hash table keyed by pointer and kind. It's immutable after building, so it can be read from any thread without lock.
+typedef struct ZIKRouteIndex ZIKRouteIndex;
+
+/// Create an index with capacity for at least `count` entries.
+FOUNDATION_EXTERN ZIKRouteIndex *zix_createRouteIndex(size_t count);
+
+/// Add entry if the key of the kind is not in the index yet. Return false when the key already exists.
+FOUNDATION_EXTERN bool zix_routeIndexAddEntry(ZIKRouteIndex *index, const ZIKRouteIndexEntry *entry);
+
+/// Find entry with one probe sequence. Return NULL when not found.
+FOUNDATION_EXTERN const ZIKRouteIndexEntry *_Nullable zix_routeIndexGetEntry(const ZIKRouteIndex *index, const void *key, ZIKRouteIndexKind kind);
+
+/// Number of entries in the index.
+FOUNDATION_EXTERN size_t zix_routeIndexGetCount(const ZIKRouteIndex *index);
+
+/// Release retained routes and free the index.
+FOUNDATION_EXTERN void zix_freeRouteIndex(ZIKRouteIndex *_Nullable index);
+
+NS_ASSUME_NONNULL_END
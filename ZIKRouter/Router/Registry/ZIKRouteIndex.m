@@ -0,0 +1,99 @@
+//
+//  ZIKRouteIndex.m
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKRouteIndex.h"
+
+struct ZIKRouteIndex {
+    size_t count;
+    /// log2 of capacity.
+    uint32_t shift;
+    /// capacity - 1.
+    size_t mask;
+    /// Slot is empty when key is NULL.
+    ZIKRouteIndexEntry entries[];
+};
+
+/// Fibonacci hashing, pointers are aligned so their low bits are mostly zero, multiplying spreads them into the high bits.
+static inline size_t _slotForKey(const ZIKRouteIndex *index, const void *key, ZIKRouteIndexKind kind) {
+    uint64_t hash = ((uint64_t)(uintptr_t)key ^ ((uint64_t)kind << 60)) * 0x9E3779B97F4A7C15ULL;
+    return (size_t)(hash >> (64 - index->shift));
+}
+
+ZIKRouteIndex *zix_createRouteIndex(size_t count) {
+    // Keep load factor under 0.5, so probe sequence is short
+    uint32_t shift = 3;
+    while (((size_t)1 << shift) < count * 2) {
+        shift++;
+    }
+    size_t capacity = (size_t)1 << shift;
+    ZIKRouteIndex *index = calloc(1, sizeof(ZIKRouteIndex) + capacity * sizeof(ZIKRouteIndexEntry));
+    index->shift = shift;
+    index->mask = capacity - 1;
+    return index;
+}
+
+bool zix_routeIndexAddEntry(ZIKRouteIndex *index, const ZIKRouteIndexEntry *entry) {
+    NSCParameterAssert(entry->key);
+    NSCAssert(index->count * 2 < index->mask + 1, @"Route index is full, create it with a larger count.");
+    size_t slot = _slotForKey(index, entry->key, entry->kind);
+    while (index->entries[slot].key) {
+        if (index->entries[slot].key == entry->key && index->entries[slot].kind == entry->kind) {
+            return false;
+        }
+        slot = (slot + 1) & index->mask;
+    }
+    ZIKRouteIndexEntry *newEntry = &index->entries[slot];
+    *newEntry = *entry;
+    if (newEntry->route) {
+        CFRetain(newEntry->route);
+    }
+    if (newEntry->routerType) {
+        CFRetain(newEntry->routerType);
+    }
+    index->count++;
+    return true;
+}
+
+const ZIKRouteIndexEntry *zix_routeIndexGetEntry(const ZIKRouteIndex *index, const void *key, ZIKRouteIndexKind kind) {
+    if (key == NULL) {
+        return NULL;
+    }
+    size_t slot = _slotForKey(index, key, kind);
+    const ZIKRouteIndexEntry *entry = &index->entries[slot];
+    while (entry->key) {
+        if (entry->key == key && entry->kind == kind) {
+            return entry;
+        }
+        slot = (slot + 1) & index->mask;
+        entry = &index->entries[slot];
+    }
+    return NULL;
+}
+
+size_t zix_routeIndexGetCount(const ZIKRouteIndex *index) {
+    return index->count;
+}
+
+void zix_freeRouteIndex(ZIKRouteIndex *index) {
+    if (index == NULL) {
+        return;
+    }
+    for (size_t slot = 0; slot <= index->mask; slot++) {
+        ZIKRouteIndexEntry *entry = &index->entries[slot];
+        if (entry->route) {
+            CFRelease(entry->route);
+        }
+        if (entry->routerType) {
+            CFRelease(entry->routerType);
+        }
+    }
+    free(index);
+}
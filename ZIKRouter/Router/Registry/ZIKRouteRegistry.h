@@ -13,12 +13,129 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class ZIKRoute;
+
+/// Section in `__DATA` segment storing router class names written by `ZIKROUTER_REGISTER_ROUTER`.
+#define ZIKROUTER_ROUTES_SECTION "__zik_routes"
+
+/**
+ Write the router class name into section `__DATA,__zik_routes`. Use it at file scope in router's implementation file, then set `ZIKRouteRegistry.usesSectionRegistration` to YES for faster registration.
+ @code
+ @implementation LoginViewRouter
+ ...
+ @end
+ 
+ ZIKROUTER_REGISTER_ROUTER(LoginViewRouter)
+ @endcode
+ */
+#define ZIKROUTER_REGISTER_ROUTER(RouterClass) \
+__attribute__((used, section("__DATA," ZIKROUTER_ROUTES_SECTION))) static const char *const _zix_registered_router_##RouterClass = #RouterClass;
+
+/// Section in `__DATA` segment storing class names of launch routers written by `ZIKROUTER_REGISTER_LAUNCH_ROUTER`.
+#define ZIKROUTER_LAUNCH_ROUTES_SECTION "__zik_launch"
+/// Section in `__DATA` segment marking an image whose routers are all launch routers, written by `ZIKROUTER_LAUNCH_IMAGE`.
+#define ZIKROUTER_LAUNCH_IMAGE_SECTION "__zik_launch_img"
+
+/**
+ Same as `ZIKROUTER_REGISTER_ROUTER`, and also declare the router as a launch router, such as routers of the first screen and cold-start deep links. Launch routers are registered before other routers when `ZIKRouteRegistry.registersByPriority` is YES.
+ @code
+ ZIKROUTER_REGISTER_LAUNCH_ROUTER(HomeViewRouter)
+ @endcode
+ */
+#define ZIKROUTER_REGISTER_LAUNCH_ROUTER(RouterClass) \
+ZIKROUTER_REGISTER_ROUTER(RouterClass) \
+__attribute__((used, section("__DATA," ZIKROUTER_LAUNCH_ROUTES_SECTION))) static const char *const _zix_launch_router_##RouterClass = #RouterClass;
+
+/// Declare all routers in current image as launch routers. Use it once at file scope in any file of the framework or app.
+#define ZIKROUTER_LAUNCH_IMAGE \
+__attribute__((used, section("__DATA," ZIKROUTER_LAUNCH_IMAGE_SECTION))) static const char _zix_launch_image = 1;
+
 /// Abstract registry for router classes and protocols. In consideration of performance, methods in registry are not thread safe.
 @interface ZIKRouteRegistry : NSObject
 /// Whether auto register all routers when app launches. Default is YES. You can set this to NO before UIApplicationMain, and manually register your routers with +registerAll or call +registerRoutableDestination for each router.
 @property (nonatomic, class) BOOL autoRegister;
 /// Whether registration is finished.
 @property (nonatomic, class, readonly) BOOL registrationFinished;
+/// Generation of routes, increased when registration is finished and when routes are changed after that, such as late registrations and +invalidateResolvedRoutes. Router types resolved in an older generation may be stale, cache them with `ZIKRouteHandle` instead of looking up every time.
+@property (nonatomic, class, readonly) uint64_t routesGeneration;
+/**
+ Whether +registerAll only registers routers declared with `ZIKROUTER_REGISTER_ROUTER`. Default is NO, and registry enumerates all subclasses of ZIKRouter. Set it before UIApplicationMain.
+ 
+ @discussion
+ When it's YES, registry reads the `__DATA,__zik_routes` section of each image instead of walking all classes, so startup only does work for routers. Routers not declared with the macro won't be registered. Swift routers can't use the macro, call their +registerRoutableDestination before +registerAll, or keep this NO.
+ */
+@property (nonatomic, class) BOOL usesSectionRegistration;
+/// Whether +registerAll scans images concurrently when enumerating router classes. Routers are still registered on the calling thread in the same order. It's useful when app has many embedded frameworks. Default is NO.
+@property (nonatomic, class) BOOL enumeratesClassesConcurrently;
+/**
+ Whether +registerAll registers routers of different registries concurrently, such as view routers and service routers. Default is NO. Set it before UIApplicationMain.
+ 
+ @discussion
+ Enumerated classes are always classified by registries in one superclass walk, then each registry registers its own routers. When it's YES, registries register their routers in parallel, and routers in one registry are still registered in the same order. +registerRoutableDestination of your routers must only register into their own registry, and must not fetch any router. It has no effect when profiling registration, tracing, exporting route table or registering in background.
+ */
+@property (nonatomic, class) BOOL registersRegistriesConcurrently;
+/**
+ Whether registry freezes its maps into an immutable snapshot when registration is finished. Default is NO. Set it before UIApplicationMain.
+ 
+ @discussion
+ Registration methods in registry are not thread safe. Lookups after registration is finished always read the published route index without lock, but fall back to registry's maps for adapters and keys not in the index, so when routers may be registered after finishing, only lookups with YES are thread safe. When it's YES, lookups after registration is finished read the snapshot, so routers can be fetched from any thread without lock. Registrations after finishing, such as lazy registrations from route table, update the maps and publish a new snapshot atomically at the next lookup. Previous snapshots are freed when no lookup is reading them.
+ */
+@property (nonatomic, class) BOOL freezesRegistration;
+/**
+ Whether +registerAll measures time spent in registration. Default is NO. Set it before UIApplicationMain.
+ 
+ @discussion
+ When it's YES, registry records wall time of class enumeration, each registry's +handleEnumerateRouterClass:, +didFinishRegistration and validation, and each router's +registerRoutableDestination. Class enumeration, +didFinishRegistration and router registrations are also emitted as os_signpost intervals with subsystem `ZIKRouter` and category `Registration` on iOS 12, tvOS 12 and macOS 10.14 and later, so you can find the slow router in Instruments.
+ */
+@property (nonatomic, class) BOOL profilesRegistration;
+/**
+ Whether auto registration runs on a background queue. Default is NO. Setting it to YES starts +registerAll on a background queue immediately, so set it as early as possible, such as in +load of your app or in main() before UIApplicationMain, and set other options before it.
+ 
+ @discussion
+ Class enumeration and building maps don't block launch any more. Hooks of `-[UIApplication setDelegate:]` and `+[UIStoryboard storyboardWithName:bundle:]`, +registerAll and fetching any router wait until the background registration is finished. Routers are registered on the background queue, so +registerRoutableDestination of your routers must not use UI APIs or main-thread-only states. It does nothing when `autoRegister` is NO.
+ */
+@property (nonatomic, class) BOOL registersInBackground;
+/**
+ Whether +registerAll registers launch routers first and other routers in background. Default is NO. Set it before UIApplicationMain.
+ 
+ @discussion
+ Launch routers are declared with `ZIKROUTER_REGISTER_LAUNCH_ROUTER`, or with `ZIKROUTER_LAUNCH_IMAGE` in their image. When it's YES, +registerAll registers launch routers on the calling thread, then registers other routers on a background queue like `registersInBackground`. Before background registration is finished, fetching routes registered by launch routers returns at once, only fetching other routes waits for background registration. A route registered by a launch router should not be registered again by other routers.
+ 
+ +registerRoutableDestination of other routers runs on the background queue, so it must not use UI APIs or main-thread-only states. It has no effect when `registersInBackground` is YES, or routers are registered from route tables, such as with `routeTablePath`, `ZIKRouteTable.plist`, `sharedRouteTableGroupIdentifier` or `cachesRegistration`.
+ */
+@property (nonatomic, class) BOOL registersByPriority;
+/**
+ Whether +registerAll also registers routers in images loaded after registration is finished, such as frameworks loaded with `dlopen`. Default is NO. Set it before UIApplicationMain.
+ 
+ @discussion
+ When it's YES, registry observes added images with `_dyld_register_func_for_add_image`, and only reads `__objc_classlist` (or `__DATA,__zik_routes` when `usesSectionRegistration` is YES) of the new image, then routers in it are registered on the thread loading the image before `dlopen` returns. Only the first +registerAll observes images, manual registration with +notifyRegistrationFinished doesn't.
+ */
+@property (nonatomic, class) BOOL registersAddedImages;
+/**
+ Whether router validation in debug mode runs on a background queue when registration is finished. Default is NO. It only has effect when ZIKROUTER_CHECK is enabled. Set it before UIApplicationMain.
+ 
+ @discussion
+ Validation enumerates all classes, protocols and Swift symbols, it may take seconds in a big app. When it's YES, registries are validated concurrently on a background queue, and each router's validation runs in parallel, so launching is not blocked. Errors are still reported with assertion when the check finishes, but the assertion will be on a background thread and after your app already started.
+ */
+@property (nonatomic, class) BOOL validatesInBackground;
+/**
+ Whether registries rebuild their maps at the exact capacity they need when registration is finished. Default is NO. Set it before UIApplicationMain.
+ 
+ @discussion
+ Maps grow while routers are registered and keep spare capacity after that. Compacting copies each map once when registration is finished, so it costs a little launch time for less memory. It's for memory constrained targets, such as watchOS apps and app extensions. Check the effect with `memoryFootprint`.
+ */
+@property (nonatomic, class) BOOL compactsRegistration;
+/**
+ Memory used by this registry. Key is the container name, such as `destinationProtocolToRouterMap`, and `routeObjects` for ZIKRoute objects. Value has `count` of entries and `bytes` of the container. Read it after registration is finished.
+ 
+ @discussion
+ Sending it to ZIKRouteRegistry reports all registries, with the registry class name as prefix of the key, such as `ZIKViewRouteRegistry.destinationToRoutersMap`, and `factoryBlocks` for factory blocks retained by registries. Storage of hash maps is estimated from the count, because CoreFoundation doesn't expose their capacity.
+ */
+@property (nonatomic, class, readonly) NSDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *memoryFootprint;
+/// Time in seconds of each registration stage recorded when `profilesRegistration` is YES. Key is the stage name, such as `enumerateClasses`, `registerWithRouteTable`, `ZIKViewRouteRegistry +handleEnumerateRouterClass:` and `ZIKViewRouteRegistry +didFinishRegistration`. Time of a registry's +handleEnumerateRouterClass: includes its routers' registration.
+@property (nonatomic, class, readonly, nullable) NSDictionary<NSString *, NSNumber *> *registrationStageDurations;
+/// Time in seconds of each router's +registerRoutableDestination recorded when `profilesRegistration` is YES. Key is the router class name.
+@property (nonatomic, class, readonly, nullable) NSDictionary<NSString *, NSNumber *> *routerRegistrationDurations;
 
 #pragma mark Manually Register
 
@@ -28,6 +145,96 @@ NS_ASSUME_NONNULL_BEGIN
 /// Notify that registration is finished, when you register routers by calling each router's +registerRoutableDestination. It's for rejecting any registration later and let routers call +_didFinishRegistration.
 + (void)notifyRegistrationFinished;
 
+/**
+ Clear routes resolved from superclasses and adapter -> adaptee chains. After registration is finished, registry caches the final route (or no route) of each requested destination class and adapter protocol. Registrations in registry clear the cache automatically, call this when a route is added in other places after registration is finished.
+ */
++ (void)invalidateResolvedRoutes;
+
+#pragma mark Unregister
+
+/**
+ Remove the router class from all maps of the registry, including registrations in ZRouter, so its memory can be reclaimed when a feature module is no longer needed. Sending it to ZIKRouteRegistry unregisters in all registries. Only call it after registration is finished.
+ 
+ @discussion
+ Lookups on other threads still running with the previous snapshot see the old router until they return, and removed route objects are released when no lookup is reading that snapshot. Resolved routes are invalidated and `routesGeneration` is increased, so `ZIKRouteHandle` resolves again. Pending lazy registrations of the registry are registered first, so an unregistered router won't come back when it's requested. When `freezesRegistration` is YES, removed objects are never released, because frozen snapshots are never freed.
+ */
++ (void)unregisterRouterClass:(Class)routerClass;
+
+/// Remove the route from all maps of the registry, same as +unregisterRouterClass:. The route is released after it's unregistered if no one else holds it.
++ (void)unregisterRoute:(ZIKRoute *)route;
+
+/**
+ Unregister all router classes and routes implemented in the image, and registrations for making destination classes in the image with their factories, same as +unregisterRouterClass:. Caches of classes in the image are also removed, such as shared services, prewarmed and preloaded destinations. Call it on main thread before unloading a bundle with `dlclose` or `-[NSBundle unload]`, preloaded destinations are discarded asynchronously on main thread when it's called on other threads.
+ 
+ @param header Mach header of the image, such as `dli_fbase` from `dladdr` with a symbol in the image.
+ */
++ (void)unregisterRoutesInImage:(const void *)header;
+
+#pragma mark Route Table
+
+/**
+ Path of the route table file. When the table is valid, +registerAll registers routers from the table directly instead of enumerating all classes. Default is nil, and `ZIKRouteTable.plist` in main bundle is used if it exists. Set it before UIApplicationMain.
+ 
+ @discussion
+ Generate the route table at build time by running the app or its unit test bundle with environment variable `ZIKROUTER_ROUTE_TABLE_OUTPUT` set to an output path, then add the file into app's resources as `ZIKRouteTable.plist`.
+ 
+ The table records the UUID in `LC_UUID` of each image of the app. The table is stale when its version is not equal to `routeTableVersion`, any loaded image of the app is rebuilt after recording, or any class or protocol in the table can't be found. Registry ignores a stale table and falls back to enumerating classes.
+ 
+ Routers are registered in the same order as recorded, so a destination gets the same default router as enumerating classes.
+ 
+ Routers registering with ZIKRoute, factory, URL pattern or routers written in Swift are recorded as dynamic, their +registerRoutableDestination will still be called when loading the table. Other routers are registered with the recorded destinations, protocols, identifiers and adapters, so don't do other works in their +registerRoutableDestination.
+ */
+@property (nonatomic, class, copy, nullable) NSString *routeTablePath;
+
+/// Version of the route table. Default is CFBundleVersion of main bundle. Rebuilt images already invalidate the table, use your own version (such as commit hash) to also invalidate it when only routers' resources change.
+@property (nonatomic, class, copy) NSString *routeTableVersion;
+
+/**
+ Identifier of the app group for sharing route tables between app and its extensions. Default is nil. Set the same identifier in app and extensions before UIApplicationMain or at the beginning of the extension.
+ 
+ @discussion
+ When it's set and `routeTablePath` or `ZIKRouteTable.plist` is not valid, +registerAll stores a route table for each image of the app in the app group container, the file is named with the image's UUID in `LC_UUID`. Frameworks shared by app and extensions have the same UUID, so a table written by one process is used by the others. In later launches, tables are memory-mapped read-only, and only images without table are enumerated. A rebuilt image has a new UUID, so its old table is ignored automatically.
+ 
+ Dynamic routers in tables are still registered with their +registerRoutableDestination, same as `routeTablePath`. Tables of replaced images are not deleted.
+ */
+@property (nonatomic, class, copy, nullable) NSString *sharedRouteTableGroupIdentifier;
+
+/**
+ Whether to cache registration in caches directory of the app. Default is NO. Set it before UIApplicationMain.
+ 
+ @discussion
+ It works like `sharedRouteTableGroupIdentifier` without app group: the first launch after installing or updating enumerates classes and records each image's routers and registrations in a table named with the image's `LC_UUID`, later launches replay registration from the tables without scanning `__objc_classlist`. A rebuilt image has a new UUID, so its cache is invalidated automatically. It's ignored when `sharedRouteTableGroupIdentifier` is set, or the route table in `routeTablePath` is valid.
+ */
+@property (nonatomic, class) BOOL cachesRegistration;
+
+/**
+ Whether routers in route table are registered lazily. Default is NO. Set it before UIApplicationMain.
+ 
+ @discussion
+ When it's YES, a router in route table is registered only when its destination class, protocol or identifier is requested for the first time, so routers for unvisited features cost nothing at launch. Dynamic routers and adapters are still registered at launch. It only works when route table is valid. When ZIKROUTER_CHECK is enabled, all routers are registered at launch for validation.
+ */
+@property (nonatomic, class) BOOL registersLazily;
+
+#pragma mark Export
+
+/**
+ All resolved registrations of all registries in JSON, for tools analyzing the route graph offline, such as checking unreachable routes or dependencies between modules at build time. Lazy routers are registered first. Call it after registration is finished.
+ 
+ @discussion
+ The root object contains `version` (format version, currently 1), `routeTableVersion`, `images` (image name -> UUID in `LC_UUID`) and `registries` (registry class name -> registry). A registry contains `routes` and `adapters` (adapter protocol -> adaptee protocol). Each route contains:
+ 
+ - `name`: router class name, ZIKRoute's name, or the destination class name for factories
+ - `kind`: `router`, `route` (ZIKRoute) or `factory` (destination registered with factory or for making destination)
+ - `image`: name of the image implementing the router class, the ZIKRoute's block, or the factory's destination class
+ - `destinations`, `exclusiveDestinations`, `destinationProtocols`, `moduleProtocols`, `identifiers`, `urlPatterns`
+ 
+ URL patterns are registered as identifiers, they're only listed in `urlPatterns`. Routes and arrays are sorted, so exports of different builds can be diffed. Run the app or its unit test bundle with environment variable `ZIKROUTER_REGISTRY_EXPORT` set to an output path to write it when registration is finished, or use `zikregistry` command in `Scripts/zikrouter_lldb.py` when debugging.
+ */
++ (NSData *)exportedRegistryJSONData;
+
+/// Write `exportedRegistryJSONData` to the file atomically.
++ (BOOL)exportRegistryToFile:(NSString *)path error:(NSError **)error;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -12,6 +12,7 @@
 #import "ZIKRouteRegistry.h"
 #import "ZIKRouteRegistryInternal.h"
 #import "ZIKRouterInternal.h"
+#import "ZIKRouterPrivate.h"
 #import "ZIKClassCapabilities.h"
 #if ZIK_HAS_UIKIT
 #import <UIKit/UIKit.h>
@@ -19,17 +20,213 @@
 #import <AppKit/AppKit.h>
 #endif
 #import <objc/runtime.h>
+#import <pthread.h>
+#import <malloc/malloc.h>
+#import <objc/message.h>
+#import <dlfcn.h>
+#if __has_include(<os/signpost.h>)
+#import <os/signpost.h>
+#endif
 #import "ZIKRouterRuntime.h"
+#import "ZIKRouteIndex.h"
+#import "ZIKRouteEdgeList.h"
+#import "ZIKRouteSignpost.h"
 #import "ZIKRouter.h"
 #import "ZIKRoute.h"
+#import "ZIKRoutePrivate.h"
 #import "ZIKRouterType.h"
 #import "ZIKImageSymbol.h"
 #import "NSString+Demangle.h"
+#import "ZIKRouterRuntimeDebug.h"
+#import "ZIKRouterLog.h"
 
 static NSMutableSet<Class> *_registries;
 static BOOL _autoRegister = YES;
 static BOOL _registrationFinished = NO;
+static BOOL _usesSectionRegistration = NO;
+static BOOL _enumeratesClassesConcurrently = NO;
+static BOOL _registersRegistriesConcurrently = NO;
+static BOOL _freezesRegistration = NO;
+static BOOL _profilesRegistration = NO;
+static BOOL _registersInBackground = NO;
+/// Group of registration running on background queue, nil when registering on the calling thread.
+static dispatch_group_t _backgroundRegistrationGroup;
+static BOOL _backgroundRegistrationCompleted = NO;
+static const void *const ZIKBackgroundRegistrationQueueKey = &ZIKBackgroundRegistrationQueueKey;
+static BOOL _registersByPriority = NO;
+/// Launch routers registered before background registration, they are skipped when enumerating other routers.
+static ZIKClassSet *_launchRouterClasses;
+/// key: registry, value: ZIKRouteRegistrySnapshot * with routes of launch routers. Created before background registration starts and never changed, so it's read without lock.
+static CFMutableDictionaryRef _launchSnapshots;
+static BOOL _registersAddedImages = NO;
+static BOOL _validatesInBackground = NO;
+static BOOL _compactsRegistration = NO;
+/// Whether current thread is registering routers in an image loaded after registration is finished.
+static __thread BOOL _registeringAddedImage = NO;
+/// key: stage name, value: seconds. Only available when profiling registration.
+static NSMutableDictionary<NSString *, NSNumber *> *_registrationStageDurations;
+/// key: router class name, value: seconds. Only available when profiling registration.
+static NSMutableDictionary<NSString *, NSNumber *> *_routerRegistrationDurations;
 static CFMutableSetRef _factoryBlocks;
+/// Lock for _factoryBlocks, registries may register factories concurrently.
+static pthread_mutex_t _factoryBlocksLock = PTHREAD_MUTEX_INITIALIZER;
+/// Lock for destinationToResolvedRouteMap, destinationAdapterToRouteMap and moduleAdapterToRouteMap, they are updated in lookup.
+static dispatch_semaphore_t _resolvedRoutesSema;
+/// Lock for registrations after registration is finished, such as lazy registrations from route table.
+static pthread_mutex_t _lateRegistrationLock;
+/// Whether publishing snapshot is delayed to the end of a batch of late registrations.
+static NSInteger _snapshotPublishingSuspended;
+/// Increased when registration is finished and when resolved routes are invalidated.
+static uint64_t _routesGeneration = 1;
+/// Number of lookups reading snapshots without lock. Replaced snapshots are only freed when it's 0.
+static uint64_t _snapshotReaders;
+/// Linked list of replaced snapshots waiting to be freed.
+static struct ZIKRouteRegistrySnapshot *_retiredSnapshots;
+/// Linked list of objects retired with `zix_retireSnapshot` waiting to be freed, guarded by _retiredSnapshotsLock.
+static struct ZIKRetiredObject *_retiredObjects;
+static pthread_mutex_t _retiredSnapshotsLock = PTHREAD_MUTEX_INITIALIZER;
+/// key: registry, value: CFMutableArrayRef of objects removed by unregistration and still referenced by the registry's current snapshot. Guarded by _lateRegistrationLock.
+static CFMutableDictionaryRef _unregisteredObjects;
+
+static NSString *_routeTablePath;
+static NSString *_routeTableVersion;
+static NSString *_sharedRouteTableGroupIdentifier;
+static BOOL _cachesRegistration = NO;
+/// key: registry class name, value: {router class name: route table entry}. Only available when exporting route table.
+static NSMutableDictionary<NSString *, NSMutableDictionary<NSString *, NSMutableDictionary *> *> *_routeTableRecorder;
+/// key: registry class name, value: router class names in the order they are registered. Only available when exporting route table.
+static NSMutableDictionary<NSString *, NSMutableArray<NSString *> *> *_routeTableOrderRecorder;
+/// The router class calling +registerRoutableDestination when exporting route table.
+static Class _recordingRouterClass;
+
+static NSString *const ZIKRouteTableOutputEnvironmentKey = @"ZIKROUTER_ROUTE_TABLE_OUTPUT";
+static NSString *const ZIKRegistryExportEnvironmentKey = @"ZIKROUTER_REGISTRY_EXPORT";
+static NSString *const ZIKRouteTableVersionKey = @"version";
+static NSString *const ZIKRouteTableRegistriesKey = @"registries";
+static NSString *const ZIKRouteTableOrderKey = @"order";
+static NSString *const ZIKRouteTableImagesKey = @"images";
+static NSString *const ZIKRouteTableDynamicKey = @"dynamic";
+static NSString *const ZIKRouteTableDestinationsKey = @"destinations";
+static NSString *const ZIKRouteTableExclusiveDestinationsKey = @"exclusiveDestinations";
+static NSString *const ZIKRouteTableDestinationProtocolsKey = @"destinationProtocols";
+static NSString *const ZIKRouteTableModuleProtocolsKey = @"moduleProtocols";
+static NSString *const ZIKRouteTableIdentifiersKey = @"identifiers";
+static NSString *const ZIKRouteTableDestinationAdaptersKey = @"destinationAdapters";
+static NSString *const ZIKRouteTableModuleAdaptersKey = @"moduleAdapters";
+static BOOL _registersLazily = NO;
+/// key: registry class name, value: {route table key: {destination / protocol / identifier name: registrations}}. Registrations from route table that are not executed yet.
+static NSMutableDictionary<NSString *, NSDictionary<NSString *, NSMutableDictionary<NSString *, NSArray *> *> *> *_lazyRegistrations;
+
+/// Route registered with an identifier, in snapshot's array indexed by identifier handle.
+typedef struct ZIKIdentifierRoute {
+    const void *route;
+    /// NULL when router type is not created in registration.
+    const void *routerType;
+} ZIKIdentifierRoute;
+
+/// Immutable lookup structures published when registration is finished. Maps are only copied when `freezesRegistration` is YES, then any thread can read them without lock, otherwise they are NULL and lookup reads the registry's maps.
+typedef struct ZIKRouteRegistrySnapshot {
+    /// Registered route or easy route of destination classes and protocols, answering a lookup with one probe.
+    ZIKRouteIndex *routeIndex;
+    /// Registered route or easy route of each interned identifier, indexed by handle. Slots of identifiers not registered in this registry are empty.
+    ZIKIdentifierRoute *identifierRoutes;
+    ZIKRouteIdentifierHandle identifierRouteCount;
+    CFDictionaryRef destinationProtocolToRouterMap;
+    CFDictionaryRef moduleConfigProtocolToRouterMap;
+    CFDictionaryRef destinationToRoutersMap;
+    CFDictionaryRef destinationToDefaultRouterMap;
+    CFDictionaryRef destinationToExclusiveRouterMap;
+    CFDictionaryRef identifierToRouterMap;
+    CFDictionaryRef routeToRouterTypeMap;
+    CFDictionaryRef adapterToAdapteeMap;
+    CFDictionaryRef destinationToEasyRouteMap;
+    CFDictionaryRef destinationProtocolToEasyRouteMap;
+    CFDictionaryRef moduleConfigProtocolToEasyRouteMap;
+    CFDictionaryRef identifierToEasyRouteMap;
+    /// Routes, router types and factory blocks unregistered after this snapshot was published. Route index still points to them, so they're released with the snapshot.
+    CFArrayRef unregisteredObjects;
+    /// Next replaced snapshot waiting to be freed.
+    struct ZIKRouteRegistrySnapshot *nextRetired;
+    /// Registry is changed after registration is finished. A new snapshot is published at the next lookup, so a burst of late registrations only rebuilds index once. Guarded by _lateRegistrationLock, read atomically.
+    bool outdated;
+} ZIKRouteRegistrySnapshot;
+
+/// Object replaced outside registry, such as snapshots of url patterns. It's freed with registry snapshots.
+typedef struct ZIKRetiredObject {
+    void *object;
+    void (*free)(void *object);
+    struct ZIKRetiredObject *next;
+} ZIKRetiredObject;
+
+/// Read value of key in map from published snapshot if exists, otherwise from registry. Only frozen snapshots have maps. Value is retained before leaving snapshot reading, so it outlives a replaced snapshot. After registration is finished, lazy registrations and registrations from added images change registry's maps with _lateRegistrationLock, so reading registry's maps also takes the lock.
+#define _ZIKRegistryLookupValue(registry, mapName, key) ({ \
+    _beginSnapshotReading(); \
+    ZIKRouteRegistrySnapshot *_lookupSnapshot = _freezesRegistration ? _snapshotOfRegistry(registry) : NULL; \
+    id _lookupValue; \
+    if (_lookupSnapshot && _lookupSnapshot->mapName) { \
+        _lookupValue = (__bridge id)CFDictionaryGetValue(_lookupSnapshot->mapName, (key)); \
+    } else if (_registrationFinished) { \
+        pthread_mutex_lock(&_lateRegistrationLock); \
+        _lookupValue = (__bridge id)CFDictionaryGetValue((CFDictionaryRef)[registry mapName], (key)); \
+        pthread_mutex_unlock(&_lateRegistrationLock); \
+    } else { \
+        _lookupValue = (__bridge id)CFDictionaryGetValue((CFDictionaryRef)[registry mapName], (key)); \
+    } \
+    _endSnapshotReading(); \
+    _lookupValue; \
+})
+
+/// Time, signpost and trace of a profiled or traced registration stage.
+typedef struct ZIKRegistrationInterval {
+    CFAbsoluteTime startTime;
+    uint64_t signpostID;
+    uint64_t traceStartTime;
+} ZIKRegistrationInterval;
+
+/// Registration stages are recorded when profiling or tracing.
+static inline BOOL _recordsRegistrationIntervals(void);
+
+static ZIKRegistrationInterval _beginRegistrationInterval(NSString *name);
+static void _endRegistrationInterval(ZIKRegistrationInterval interval, NSString *name, NSMutableDictionary<NSString *, NSNumber *> *durations);
+/// Enumerated router classes classified by registries' router base classes.
+typedef struct ZIKRouterClassPartitions {
+    CFIndex count;
+    /// Registries with router base class.
+    const void **registries;
+    const void **baseClasses;
+    /// Router classes of each registry, in enumeration order.
+    CFMutableArrayRef *routerClasses;
+    /// Registries without router base class, they handle each enumerated class directly.
+    CFArrayRef unclassifiedRegistries;
+} ZIKRouterClassPartitions;
+
+static ZIKRouterClassPartitions _makeRouterClassPartitions(NSSet *registries);
+static void _partitionRouterClass(ZIKRouterClassPartitions *partitions, Class aClass);
+static void _registerRouterClassPartitions(ZIKRouterClassPartitions *partitions);
+static void _didFinishRegistrationForRegistries(NSSet *registries);
+static void _waitForBackgroundRegistration(void);
+static ZIKRouterType *_Nullable _launchRouterType(Class registry, const void *key, ZIKRouteIndexKind kind);
+static ZIKRouterType *_Nullable _launchRouterTypeForIdentifierHandle(Class registry, ZIKRouteIdentifierHandle handle);
+static ZIKRouteIdentifierHandle _internedHandleOfIdentifier(NSString *identifier);
+static ZIKRouteRegistrySnapshot *_Nullable _snapshotOfRegistry(Class registry);
+static inline void _beginSnapshotReading(void);
+static inline void _endSnapshotReading(void);
+static bool _lookupRouteIndex(Class registry, const void *key, ZIKRouteIndexKind kind, const ZIKRouteIndexEntry *_Nullable *_Nonnull entry);
+static ZIKRouterType *_Nullable _routerTypeOfIndexEntry(Class registry, const ZIKRouteIndexEntry *entry);
+static void _didChangeRegistryAfterFinished(Class registry);
+static void _beginRecordingRouteTable(void);
+static void _endRecordingRouteTable(void);
+static BOOL _routeTableMatchesImages(NSDictionary *table, NSString *version);
+static NSMutableDictionary *_routeTableEntry(Class registry, Class routerClass);
+static void _recordRouteTableRegistration(Class registry, NSString *_Nullable key, id _Nullable value, id _Nullable routeObject);
+static void _registerRouterTypeForRoute(id routeObject, Class registry);
+static void _recordLookup(Class registry, ZIKRouterType *_Nullable routerType, uint64_t startTime);
+static NSString *_Nullable _imageRouteTableDirectory(void);
+static ZIKRouteIdentifierHandle _internedIdentifierCount(void);
+static CFArrayRef _Nullable _takeUnregisteredObjects(Class registry);
+static NSArray *_routesInImage(Class registry, const void *header);
+static void _unregisterRouteInRegistry(Class registry, id routeObject);
+static void _unregisterFactoriesInImage(Class registry, const void *header);
 
 @interface ZIKRouteRegistry()
 @property (nonatomic, class, readonly) NSMutableSet *registries;
@@ -40,6 +237,30 @@ static CFMutableSetRef _factoryBlocks;
 @interface ZIKRouteRegistry(SwiftAdapter)
 + (id)_swiftRouteForDestinationAdapter:(Protocol *)destinationProtocol;
 + (id)_swiftRouteForModuleAdapter:(Protocol *)moduleProtocol;
++ (void)_swiftUnregisterRoute:(id)route;
+@end
+
+/// Registration of a router from route table, only executed once.
+@interface ZIKRouteTableRegistration : NSObject
+@property (nonatomic, copy, nullable) dispatch_block_t registration;
+- (void)perform;
+@end
+
+@implementation ZIKRouteTableRegistration
+
+- (void)perform {
+    dispatch_block_t registration = self.registration;
+    self.registration = nil;
+    if (registration) {
+        registration();
+    }
+}
+
+@end
+
+/// Implemented by ZIKViewRouter and ZIKServiceRouter.
+@interface ZIKRouter (RouteTable)
++ (void)registerRoutableDestination;
 @end
 
 @implementation ZIKRouteRegistry
@@ -50,6 +271,12 @@ static CFMutableSetRef _factoryBlocks;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
         _factoryBlocks = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+        _resolvedRoutesSema = dispatch_semaphore_create(1);
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+        pthread_mutex_init(&_lateRegistrationLock, &attr);
+        pthread_mutexattr_destroy(&attr);
         zix_replaceMethodWithMethod([XXApplication class], @selector(setDelegate:),
                                     self, @selector(ZIKRouteRegistry_hook_setDelegate:));
         zix_replaceMethodWithMethodType([XXStoryboard class], @selector(storyboardWithName:bundle:), true,
@@ -93,7 +320,7 @@ static CFMutableSetRef _factoryBlocks;
 }
 
 + (void)setAutoRegister:(BOOL)autoRegister {
-    if (_registrationFinished) {
+    if (_registrationFinished || _backgroundRegistrationGroup) {
         NSAssert(NO, @"Set auto register after registration is already finished.");
         return;
     }
@@ -101,258 +328,1866 @@ static CFMutableSetRef _factoryBlocks;
 }
 
 + (BOOL)registrationFinished {
-    return _registrationFinished;
+    // Let routers in added image pass the checks in their registration
+    return _registrationFinished && !_registeringAddedImage;
 }
 
-+ (void)setRegistrationFinished:(BOOL)registrationFinished {
-    _registrationFinished = registrationFinished;
++ (BOOL)usesSectionRegistration {
+    return _usesSectionRegistration;
 }
 
-+ (void)registerAll {
-    if (self.registrationFinished) {
++ (void)setUsesSectionRegistration:(BOOL)usesSectionRegistration {
+    if (_registrationFinished) {
+        NSAssert(NO, @"Set section registration after registration is already finished.");
         return;
     }
-    NSSet *registries = [[self registries] copy];
-    if (zix_canEnumerateClassesInImage()) {
-        // Fast enumeration
-        zix_enumerateClassesInMainBundleForParentClass([ZIKRouter class], ^(__unsafe_unretained Class  _Nonnull aClass) {
-            for (Class registry in registries) {
-                [registry handleEnumerateRouterClass:aClass];
-            }
-        });
-    } else {
-        // Slow enumeration
-        zix_enumerateClassList(^(__unsafe_unretained Class class) {
-            for (Class registry in registries) {
-                [registry handleEnumerateRouterClass:class];
-            }
-        });
+    _usesSectionRegistration = usesSectionRegistration;
+}
+
++ (BOOL)enumeratesClassesConcurrently {
+    return _enumeratesClassesConcurrently;
+}
+
++ (void)setEnumeratesClassesConcurrently:(BOOL)enumeratesClassesConcurrently {
+    _enumeratesClassesConcurrently = enumeratesClassesConcurrently;
+}
+
++ (BOOL)registersRegistriesConcurrently {
+    return _registersRegistriesConcurrently;
+}
+
++ (void)setRegistersRegistriesConcurrently:(BOOL)registersRegistriesConcurrently {
+    if (_registrationFinished) {
+        NSAssert(NO, @"Set concurrent registration after registration is already finished.");
+        return;
     }
-    
-    self.registrationFinished = YES;
-    for (Class registry in registries) {
-        [registry didFinishRegistration];
+    _registersRegistriesConcurrently = registersRegistriesConcurrently;
+}
+
++ (BOOL)freezesRegistration {
+    return _freezesRegistration;
+}
+
++ (void)setFreezesRegistration:(BOOL)freezesRegistration {
+    if (_registrationFinished) {
+        NSAssert(NO, @"Set freezing registration after registration is already finished.");
+        return;
     }
+    _freezesRegistration = freezesRegistration;
 }
 
-#pragma mark Discover
++ (BOOL)profilesRegistration {
+    return _profilesRegistration;
+}
 
-+ (ZIKRoute *)easyRouteForDestinationClass:(Class)destinationClass factory:(id(^)(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router))factory {
-    return [[ZIKRoute alloc] initWithMakeDestination:^id _Nullable(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
-        if (!factory) {
-            return nil;
-        }
-        return factory(config, router);
-    }];
++ (void)setProfilesRegistration:(BOOL)profilesRegistration {
+    if (_registrationFinished) {
+        NSAssert(NO, @"Set profiling registration after registration is already finished.");
+        return;
+    }
+    _profilesRegistration = profilesRegistration;
+    if (profilesRegistration) {
+        _registrationStageDurations = [NSMutableDictionary dictionary];
+        _routerRegistrationDurations = [NSMutableDictionary dictionary];
+    } else {
+        _registrationStageDurations = nil;
+        _routerRegistrationDurations = nil;
+    }
 }
 
-+ (ZIKRoute *)easyRouteForDestinationClass:(Class)destinationClass configFactory:(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(^)(void))factory {
-    return [[ZIKRoute alloc] initWithMakeDestination:^id _Nullable(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
-        if ([config conformsToProtocol:@protocol(ZIKConfigurationMakeable)]) {
-            if ([config respondsToSelector:@selector(makeDestination)] && config.makeDestination) {
-                id destination = config.makeDestination();
-                return destination;
-            }
-        }
-        return nil;
-    }].makeDefaultConfiguration(^ZIKPerformRouteConfiguration * _Nonnull{
-        return factory();
-    });
++ (BOOL)registersInBackground {
+    return _registersInBackground;
 }
 
-+ (ZIKRoute *)easyRouteForDestinationClass:(Class)destinationClass {
-    const void *f = CFDictionaryGetValue(self.destinationToDefaultConfigFactoryMap, (__bridge const void *)(destinationClass));
-    if (f) {
-        ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(*factory)(void) = f;
-        if (CFSetContainsValue(_factoryBlocks, factory)) {
-            ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(^block)(void) = CFDictionaryGetValue(self.destinationToDefaultConfigFactoryMap, (__bridge const void *)(destinationClass));
-            return [self easyRouteForDestinationClass:destinationClass configFactory:block];
-        }
-        return [self easyRouteForDestinationClass:destinationClass configFactory:^ZIKPerformRouteConfiguration *{
-            return factory();
-        }];
++ (void)setRegistersInBackground:(BOOL)registersInBackground {
+    if (_registrationFinished || _backgroundRegistrationGroup) {
+        NSAssert(NO, @"Set background registration after registration is already started.");
+        return;
     }
-    
-    f = CFDictionaryGetValue(self.destinationToDefaultFactoryMap, (__bridge const void *)(destinationClass));
-    if (f) {
-        id _Nullable(*factory)(ZIKPerformRouteConfiguration * _Nonnull) = f;
-        if (CFSetContainsValue(_factoryBlocks, factory)) {
-            id _Nullable(^block)(ZIKPerformRouteConfiguration * _Nonnull) = CFDictionaryGetValue(self.destinationToDefaultFactoryMap, (__bridge const void *)(destinationClass));
-            return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
-                return block(config);
-            }];
-        }
-        return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
-            return factory(config);
-        }];
+    _registersInBackground = registersInBackground;
+    if (registersInBackground && _autoRegister) {
+        [self _startBackgroundRegistration];
     }
-    if (CFSetContainsValue(self.runtimeFactoryDestinationClasses, (__bridge const void *)(destinationClass))) {
-        return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
-            return [[destinationClass alloc] init];
-        }];
+}
+
++ (BOOL)registersByPriority {
+    return _registersByPriority;
+}
+
++ (void)setRegistersByPriority:(BOOL)registersByPriority {
+    if (_registrationFinished || _backgroundRegistrationGroup) {
+        NSAssert(NO, @"Set registration by priority after registration is already started.");
+        return;
     }
-    return nil;
+    _registersByPriority = registersByPriority;
 }
 
-+ (ZIKRoute *)easyRouteForDestinationProtocol:(Protocol *)destinationProtocol {
-    Class destinationClass = CFDictionaryGetValue(self.destinationProtocolToDestinationMap, (__bridge const void *)(destinationProtocol));
-    if (!destinationClass) {
-        return nil;
++ (BOOL)registersAddedImages {
+    return _registersAddedImages;
+}
+
++ (void)setRegistersAddedImages:(BOOL)registersAddedImages {
+    if (_registrationFinished) {
+        NSAssert(NO, @"Set registering added images after registration is already finished.");
+        return;
     }
-    
-    id _Nullable(*factory)(ZIKPerformRouteConfiguration * _Nonnull) = CFDictionaryGetValue(self.destinationProtocolToFactoryMap, (__bridge const void *)(destinationProtocol));
-    if (factory) {
-        if (CFSetContainsValue(_factoryBlocks, factory)) {
-            id _Nullable(^block)(ZIKPerformRouteConfiguration * _Nonnull) = CFDictionaryGetValue(self.destinationProtocolToFactoryMap, (__bridge const void *)(destinationProtocol));
-            return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
-                return block(config);
-            }];
-        }
-        return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
-            return factory(config);
-        }];
+    _registersAddedImages = registersAddedImages;
+}
+
++ (BOOL)validatesInBackground {
+    return _validatesInBackground;
+}
+
++ (void)setValidatesInBackground:(BOOL)validatesInBackground {
+    if (_registrationFinished) {
+        NSAssert(NO, @"Set validating in background after registration is already finished.");
+        return;
     }
-    if (CFSetContainsValue(self.runtimeFactoryDestinationClasses, (__bridge const void *)(destinationClass))) {
-        return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
-            return [[destinationClass alloc] init];
-        }];
+    _validatesInBackground = validatesInBackground;
+}
+
++ (BOOL)compactsRegistration {
+    return _compactsRegistration;
+}
+
++ (void)setCompactsRegistration:(BOOL)compactsRegistration {
+    if (_registrationFinished) {
+        NSAssert(NO, @"Set compacting registration after registration is already finished.");
+        return;
     }
-    return nil;
+    _compactsRegistration = compactsRegistration;
 }
 
-+ (ZIKRoute *)easyRouteForModuleProtocol:(Protocol *)configProtocol {
-    Class destinationClass = CFDictionaryGetValue(self.moduleConfigProtocolToDestinationMap, (__bridge const void *)(configProtocol));
-    if (!destinationClass) {
++ (NSDictionary<NSString *, NSNumber *> *)registrationStageDurations {
+    if (_registrationStageDurations == nil) {
         return nil;
     }
-    ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(*factory)(void) = CFDictionaryGetValue(self.moduleConfigProtocolToFactoryMap, (__bridge const void *)(configProtocol));
-    if (factory) {
-        if (CFSetContainsValue(_factoryBlocks, factory)) {
-            ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(^block)(void) = CFDictionaryGetValue(self.moduleConfigProtocolToFactoryMap, (__bridge const void *)(configProtocol));
-            return [self easyRouteForDestinationClass:destinationClass configFactory:block];
-        }
-        return [self easyRouteForDestinationClass:destinationClass configFactory:^ZIKPerformRouteConfiguration *{
-            return factory();
-        }];
+    @synchronized (_registrationStageDurations) {
+        return [_registrationStageDurations copy];
     }
-    return nil;
 }
 
-+ (ZIKRoute *)easyRouteForIdentifier:(NSString *)identifier {
-    Class destinationClass = CFDictionaryGetValue(self.identifierToDestinationMap, (__bridge CFStringRef)(identifier));
-    if (!destinationClass) {
-        return nil;
++ (NSDictionary<NSString *, NSNumber *> *)routerRegistrationDurations {
+    return [_routerRegistrationDurations copy];
+}
+
++ (void)setRegistrationFinished:(BOOL)registrationFinished {
+    _registrationFinished = registrationFinished;
+    __atomic_fetch_add(&_routesGeneration, 1, __ATOMIC_RELEASE);
+}
+
++ (uint64_t)routesGeneration {
+    return __atomic_load_n(&_routesGeneration, __ATOMIC_ACQUIRE);
+}
+
++ (void)registerAll {
+    if (_backgroundRegistrationGroup && dispatch_get_specific(ZIKBackgroundRegistrationQueueKey) == NULL) {
+        // Launch routers are ready, other routers are waited when they are fetched
+        if (_launchSnapshots == NULL) {
+            _waitForBackgroundRegistration();
+        }
+        return;
     }
-    const void *f = CFDictionaryGetValue(self.identifierToConfigFactoryMap, (__bridge CFStringRef)(identifier));
-    if (f) {
-        ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(*factory)(void) = f;
-        if (CFSetContainsValue(_factoryBlocks, factory)) {
-            ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(^block)(void) = CFDictionaryGetValue(self.identifierToConfigFactoryMap, (__bridge CFStringRef)(identifier));
-            return [self easyRouteForDestinationClass:destinationClass configFactory:block];
+    if (self.registrationFinished) {
+        return;
+    }
+    if (_registersByPriority && _backgroundRegistrationGroup == nil && [self _canRegisterByPriority]) {
+        [self _registerLaunchRoutersForRegistries:[[self registries] copy]];
+        [self _startBackgroundRegistration];
+        return;
+    }
+    zix_startTracingFromEnvironment();
+    ZIX_TRACE_SCOPE("registerAll", "registration", NULL);
+    NSSet *registries = [[self registries] copy];
+#if DEBUG
+    NSString *registrationCodeOutputPath = [NSProcessInfo processInfo].environment[@"ZIKROUTER_REGISTRATION_CODE_OUTPUT"];
+    if (registrationCodeOutputPath.length > 0) {
+        zix_writeRegistrationCode(registrationCodeOutputPath);
+    }
+#endif
+    NSString *routeTableOutputPath = [NSProcessInfo processInfo].environment[ZIKRouteTableOutputEnvironmentKey];
+    if (routeTableOutputPath.length > 0) {
+        _beginRecordingRouteTable();
+    } else {
+        ZIKRegistrationInterval interval = _recordsRegistrationIntervals() ? _beginRegistrationInterval(@"registerWithRouteTable") : (ZIKRegistrationInterval){0};
+        BOOL registered = [self _registerWithRouteTable];
+        if (_recordsRegistrationIntervals()) {
+            _endRegistrationInterval(interval, @"registerWithRouteTable", _registrationStageDurations);
+        }
+        if (registered) {
+            [self _finishRegistrationForRegistries:registries];
+            return;
+        }
+        NSString *imageRouteTableDirectory = _imageRouteTableDirectory();
+        if (imageRouteTableDirectory) {
+            [self _registerWithImageRouteTablesInDirectory:imageRouteTableDirectory registries:registries];
+            [self _finishRegistrationForRegistries:registries];
+            return;
         }
-        return [self easyRouteForDestinationClass:destinationClass configFactory:^ZIKPerformRouteConfiguration *{
-            return factory();
-        }];
     }
     
-    f = CFDictionaryGetValue(self.identifierToFactoryMap, (__bridge CFStringRef)(identifier));
-    if (f) {
-        id _Nullable(*factory)(ZIKPerformRouteConfiguration * _Nonnull) = f;
-        if (CFSetContainsValue(_factoryBlocks, factory)) {
-            id _Nullable(^block)(ZIKPerformRouteConfiguration * _Nonnull) = CFDictionaryGetValue(self.identifierToFactoryMap, (__bridge CFStringRef)(identifier));
-            return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
-                return block(config);
-            }];
+    ZIKRegistrationInterval interval = _recordsRegistrationIntervals() ? _beginRegistrationInterval(@"enumerateClasses") : (ZIKRegistrationInterval){0};
+    ZIKRouterClassPartitions partitions = _makeRouterClassPartitions(registries);
+    ZIKRouterClassPartitions *partitionsRef = &partitions;
+    ZIKClassSet *launchRouterClasses = _launchRouterClasses;
+    void(^handler)(__unsafe_unretained Class) = ^(__unsafe_unretained Class  _Nonnull aClass) {
+        if (launchRouterClasses && zix_classSetContainsClass(launchRouterClasses, aClass)) {
+            // Already registered before background registration
+            return;
         }
-        return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
-            return factory(config);
-        }];
+        _partitionRouterClass(partitionsRef, aClass);
+    };
+    if (_usesSectionRegistration) {
+        // Only routers declared with ZIKROUTER_REGISTER_ROUTER
+        zix_enumerateClassesInSection(ZIKROUTER_ROUTES_SECTION, handler);
+    } else if (zix_canEnumerateClassesInImage()) {
+        // Fast enumeration
+        if (_enumeratesClassesConcurrently) {
+            zix_enumerateClassesInMainBundleForParentClassConcurrently([ZIKRouter class], handler);
+        } else {
+            zix_enumerateClassesInMainBundleForParentClass([ZIKRouter class], handler);
+        }
+    } else if (!zix_enumerateClassesInCustomImagesForParentClass([ZIKRouter class], handler)) {
+        // Enumeration with class names of app's images failed, use slow enumeration
+        zix_enumerateClassList(handler);
     }
-    if (CFSetContainsValue(self.runtimeFactoryDestinationClasses, (__bridge const void *)(destinationClass))) {
-        return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
-            return [[destinationClass alloc] init];
-        }];
+    _registerRouterClassPartitions(partitionsRef);
+    if (_recordsRegistrationIntervals()) {
+        _endRegistrationInterval(interval, @"enumerateClasses", _registrationStageDurations);
     }
-    return nil;
+    
+    if (_routeTableRecorder) {
+        [self _writeRouteTableToFile:routeTableOutputPath];
+        _endRecordingRouteTable();
+    }
+    [self _finishRegistrationForRegistries:registries];
 }
 
-+ (Class)routerTypeClass {
-    return [ZIKRouterType class];
++ (void)_startBackgroundRegistration {
+    dispatch_queue_t queue = zix_createSerialQueueWithQOS("com.zuik.router.registration", QOS_CLASS_USER_INITIATED);
+    dispatch_queue_set_specific(queue, ZIKBackgroundRegistrationQueueKey, (void *)ZIKBackgroundRegistrationQueueKey, NULL);
+    _backgroundRegistrationGroup = dispatch_group_create();
+    dispatch_group_async(_backgroundRegistrationGroup, queue, ^{
+        [ZIKRouteRegistry registerAll];
+        __atomic_store_n(&_backgroundRegistrationCompleted, YES, __ATOMIC_RELEASE);
+    });
 }
 
-+ (id)routeKeyForRouter:(ZIKRouter *)router {
-    return [router class];
++ (void)waitForBackgroundRegistration {
+    _waitForBackgroundRegistration();
 }
 
-+ (nullable ZIKRouterType *)_routerTypeForObject:(id)object {
-    if (object == nil) {
-        return nil;
+/// Routers in route tables are registered at once without enumerating classes, so they can't be registered by priority.
++ (BOOL)_canRegisterByPriority {
+    if ([NSProcessInfo processInfo].environment[ZIKRouteTableOutputEnvironmentKey].length > 0) {
+        return NO;
     }
-    if ([object isKindOfClass:[ZIKRoute class]]) {
-        return [[[self routerTypeClass] alloc] initWithRoute:object];
-    } else if ([object class] == object) {
-        if ([(Class)object isSubclassOfClass:[ZIKRouter class]]) {
-            return [[[self routerTypeClass] alloc] initWithRouterClass:object];
+    if (self.routeTablePath || [[NSBundle mainBundle] pathForResource:@"ZIKRouteTable" ofType:@"plist"]) {
+        return NO;
+    }
+    return _imageRouteTableDirectory() == nil;
+}
+
+/// Register routers declared with ZIKROUTER_REGISTER_LAUNCH_ROUTER and routers in images with ZIKROUTER_LAUNCH_IMAGE, then keep snapshots of their routes for lookups before background registration is finished.
++ (void)_registerLaunchRoutersForRegistries:(NSSet *)registries {
+    ZIX_TRACE_SCOPE("registerLaunchRouters", "registration", NULL);
+    CFMutableArrayRef routerClasses = CFArrayCreateMutable(kCFAllocatorDefault, 0, NULL);
+    CFMutableSetRef routerClassSet = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+    void(^handler)(__unsafe_unretained Class) = ^(__unsafe_unretained Class  _Nonnull aClass) {
+        // Router may be declared in section and in launch image
+        if (!CFSetContainsValue(routerClassSet, (__bridge const void *)aClass)) {
+            CFSetAddValue(routerClassSet, (__bridge const void *)aClass);
+            CFArrayAppendValue(routerClasses, (__bridge const void *)aClass);
         }
+    };
+    zix_enumerateClassesInSection(ZIKROUTER_LAUNCH_ROUTES_SECTION, handler);
+    zix_enumerateCustomImages(^(const void * _Nonnull header) {
+        if (zix_imageHasSection(header, ZIKROUTER_LAUNCH_IMAGE_SECTION)) {
+            zix_enumerateClassesInImageForParentClass(header, [ZIKRouter class], handler);
+        }
+    });
+    CFIndex count = CFArrayGetCount(routerClasses);
+    ZIKClassSet *launchRouterClasses = zix_createClassSet(count * 2);
+    ZIKRouterClassPartitions partitions = _makeRouterClassPartitions(registries);
+    for (CFIndex i = 0; i < count; i++) {
+        Class routerClass = (__bridge Class)CFArrayGetValueAtIndex(routerClasses, i);
+        zix_classSetAddClass(launchRouterClasses, routerClass);
+        _partitionRouterClass(&partitions, routerClass);
     }
-    return nil;
+    _registerRouterClassPartitions(&partitions);
+    CFRelease(routerClassSet);
+    CFRelease(routerClasses);
+    
+    CFMutableDictionaryRef launchSnapshots = CFDictionaryCreateMutable(kCFAllocatorDefault, registries.count, NULL, NULL);
+    for (Class registry in registries) {
+        // Maps are changed by background registration, snapshot only keeps the index
+        CFDictionarySetValue(launchSnapshots, (__bridge const void *)registry, [registry _createSnapshotCopyingMaps:NO]);
+    }
+    _launchRouterClasses = launchRouterClasses;
+    _launchSnapshots = launchSnapshots;
 }
 
-+ (nullable ZIKRouterType *)routerToRegisteredDestinationClass:(Class)destinationClass {
-    NSAssert([self isDestinationClassRoutable:destinationClass], @"destination class (%@) should conforms to ZIKRoutableView or ZIKRoutableService.", NSStringFromClass(destinationClass));
-    CFMutableDictionaryRef destinationToDefaultRouterMap = self.destinationToDefaultRouterMap;
-    CFDictionaryRef destinationToExclusiveRouterMap = self.destinationToExclusiveRouterMap;
-    while (destinationClass) {
-        if (![self isDestinationClassRoutable:destinationClass]) {
-            break;
-        }
-        id route = CFDictionaryGetValue(destinationToDefaultRouterMap, (__bridge const void *)(destinationClass));
-        if (route == nil) {
-            route = CFDictionaryGetValue(destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass));
-            if (route) {
-                CFDictionarySetValue(destinationToDefaultRouterMap, (__bridge const void *)(destinationClass), (__bridge const void *)(route));
-            }
-        }
-        if (route == nil) {
-            route = [self easyRouteForDestinationClass:destinationClass];
-        }
-        if (route) {
-            return [self _routerTypeForObject:route];
-        } else {
-            destinationClass = class_getSuperclass(destinationClass);
-        }
+/// Block current thread until background registration is completed. Routers registering on the background queue may fetch other routers, so it doesn't wait there.
+static void _waitForBackgroundRegistration(void) {
+    if (_backgroundRegistrationGroup == nil || __atomic_load_n(&_backgroundRegistrationCompleted, __ATOMIC_ACQUIRE)) {
+        return;
     }
-    return nil;
+    if (dispatch_get_specific(ZIKBackgroundRegistrationQueueKey)) {
+        return;
+    }
+    dispatch_group_wait(_backgroundRegistrationGroup, DISPATCH_TIME_FOREVER);
 }
 
-+ (nullable ZIKRouterType *)routerToDestination:(Protocol *)destinationProtocol {
-    NSParameterAssert(destinationProtocol);
-    NSAssert(self.destinationProtocolToRouterMap != nil, @"Didn't register any protocol yet.");
-    if (!destinationProtocol) {
-        NSAssert1(NO, @"+routerToDestination: destinationProtocol is nil. callStackSymbols: %@",[NSThread callStackSymbols]);
-        return nil;
+/// Launch snapshot of the registry when other routers are still registering in background and current thread should wait for them.
+static ZIKRouteRegistrySnapshot *_Nullable _pendingLaunchSnapshot(Class registry) {
+    if (_launchSnapshots == NULL || __atomic_load_n(&_backgroundRegistrationCompleted, __ATOMIC_ACQUIRE)) {
+        return NULL;
     }
-    id route = CFDictionaryGetValue(self.destinationProtocolToRouterMap, (__bridge const void *)(destinationProtocol));
-    if (route == nil) {
-        route = [self easyRouteForDestinationProtocol:destinationProtocol];
+    if (dispatch_get_specific(ZIKBackgroundRegistrationQueueKey)) {
+        return NULL;
     }
-    if (route == nil && [self respondsToSelector:@selector(_swiftRouteForDestinationAdapter:)]) {
-        route = [self _swiftRouteForDestinationAdapter:destinationProtocol];
+    return (ZIKRouteRegistrySnapshot *)CFDictionaryGetValue(_launchSnapshots, (__bridge const void *)registry);
+}
+
+/// Router type registered by launch routers before background registration is finished. Return nil when caller should wait and look up in registry.
+static ZIKRouterType *_Nullable _launchRouterType(Class registry, const void *key, ZIKRouteIndexKind kind) {
+    ZIKRouteRegistrySnapshot *snapshot = _pendingLaunchSnapshot(registry);
+    if (snapshot == NULL) {
+        return nil;
+    }
+    const ZIKRouteIndexEntry *entry = zix_routeIndexGetEntry(snapshot->routeIndex, key, kind);
+    if (entry == NULL || entry->routerType == NULL) {
+        return nil;
+    }
+    return (__bridge ZIKRouterType *)(entry->routerType);
+}
+
+static ZIKRouterType *_Nullable _launchRouterTypeForIdentifierHandle(Class registry, ZIKRouteIdentifierHandle handle) {
+    ZIKRouteRegistrySnapshot *snapshot = _pendingLaunchSnapshot(registry);
+    if (snapshot == NULL || handle == 0 || handle >= snapshot->identifierRouteCount) {
+        return nil;
+    }
+    return (__bridge ZIKRouterType *)snapshot->identifierRoutes[handle].routerType;
+}
+
+/// Let the registry handle the enumerated class. Time of each registry is accumulated when profiling, and traced with the router class when tracing.
+static void _handleEnumerateRouterClassInRegistry(Class registry, Class aClass, BOOL classified) {
+    if (!_recordsRegistrationIntervals()) {
+        if (classified) {
+            [registry registerRouterClass:aClass];
+        } else {
+            [registry handleEnumerateRouterClass:aClass];
+        }
+        return;
+    }
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    uint64_t traceStartTime = zix_traceTime();
+    if (classified) {
+        [registry registerRouterClass:aClass];
+    } else {
+        [registry handleEnumerateRouterClass:aClass];
+    }
+    CFAbsoluteTime duration = CFAbsoluteTimeGetCurrent() - startTime;
+    NSString *stage = [NSStringFromClass(registry) stringByAppendingString:@" +handleEnumerateRouterClass:"];
+    zix_traceComplete(stage.UTF8String, "registration", traceStartTime, class_getName(aClass));
+    if (_profilesRegistration) {
+        _registrationStageDurations[stage] = @(_registrationStageDurations[stage].doubleValue + duration);
+    }
+}
+
+static ZIKRouterClassPartitions _makeRouterClassPartitions(NSSet *registries) {
+    ZIKRouterClassPartitions partitions = {0};
+    NSUInteger registryCount = registries.count;
+    partitions.registries = calloc(registryCount, sizeof(void *));
+    partitions.baseClasses = calloc(registryCount, sizeof(void *));
+    partitions.routerClasses = calloc(registryCount, sizeof(CFMutableArrayRef));
+    CFMutableArrayRef unclassifiedRegistries = CFArrayCreateMutable(kCFAllocatorDefault, 0, NULL);
+    for (Class registry in registries) {
+        Class baseClass = [registry routerBaseClass];
+        if (baseClass == nil || partitions.registries == NULL || partitions.baseClasses == NULL || partitions.routerClasses == NULL) {
+            CFArrayAppendValue(unclassifiedRegistries, (__bridge const void *)registry);
+            continue;
+        }
+        partitions.registries[partitions.count] = (__bridge const void *)registry;
+        partitions.baseClasses[partitions.count] = (__bridge const void *)baseClass;
+        partitions.routerClasses[partitions.count] = CFArrayCreateMutable(kCFAllocatorDefault, 0, NULL);
+        partitions.count++;
+    }
+    partitions.unclassifiedRegistries = unclassifiedRegistries;
+    return partitions;
+}
+
+/// Walk superclasses of the class once, and add it to every registry whose router base class is in the chain. It's the same as checking `zix_classIsSubclassOfClass` in each registry.
+static void _partitionRouterClass(ZIKRouterClassPartitions *partitions, Class aClass) {
+    if (partitions->count > 0) {
+        for (Class superClass = class_getSuperclass(aClass); superClass; superClass = class_getSuperclass(superClass)) {
+            for (CFIndex i = 0; i < partitions->count; i++) {
+                if (partitions->baseClasses[i] == (__bridge const void *)superClass) {
+                    CFArrayAppendValue(partitions->routerClasses[i], (__bridge const void *)aClass);
+                }
+            }
+        }
+    }
+    for (CFIndex i = 0, count = CFArrayGetCount(partitions->unclassifiedRegistries); i < count; i++) {
+        _handleEnumerateRouterClassInRegistry((__bridge Class)CFArrayGetValueAtIndex(partitions->unclassifiedRegistries, i), aClass, NO);
+    }
+}
+
+static void _registerRouterClassesInPartition(ZIKRouterClassPartitions *partitions, CFIndex idx) {
+    Class registry = (__bridge Class)partitions->registries[idx];
+    CFArrayRef routerClasses = partitions->routerClasses[idx];
+    for (CFIndex i = 0, count = CFArrayGetCount(routerClasses); i < count; i++) {
+        _handleEnumerateRouterClassInRegistry(registry, (__bridge Class)CFArrayGetValueAtIndex(routerClasses, i), YES);
+    }
+}
+
+/// Register classified routers of each registry, then release the partitions. Registries are independent, so they can register concurrently when nothing global is recorded in registration.
+static void _registerRouterClassPartitions(ZIKRouterClassPartitions *partitions) {
+    BOOL concurrent = _registersRegistriesConcurrently && partitions->count > 1 && !_recordsRegistrationIntervals() && _routeTableRecorder == nil && _backgroundRegistrationGroup == nil && !_registeringAddedImage;
+    if (concurrent) {
+        dispatch_apply(partitions->count, zix_globalQueueWithQOS(QOS_CLASS_USER_INTERACTIVE), ^(size_t idx) {
+            _registerRouterClassesInPartition(partitions, idx);
+        });
+    } else {
+        for (CFIndex i = 0; i < partitions->count; i++) {
+            _registerRouterClassesInPartition(partitions, i);
+        }
+    }
+    for (CFIndex i = 0; i < partitions->count; i++) {
+        CFRelease(partitions->routerClasses[i]);
+    }
+    free(partitions->registries);
+    free(partitions->baseClasses);
+    free(partitions->routerClasses);
+    CFRelease(partitions->unclassifiedRegistries);
+    *partitions = (ZIKRouterClassPartitions){0};
+}
+
++ (void)_finishRegistrationForRegistries:(NSSet *)registries {
+#if ZIKROUTER_CHECK
+    // Validation needs all routers
+    for (Class registry in registries) {
+        [registry registerLazyRouters];
+    }
+#endif
+    if (_compactsRegistration) {
+        // Nothing reads containers before registration is finished
+        for (Class registry in registries) {
+            [registry compactContainers];
+        }
+        pthread_mutex_lock(&_factoryBlocksLock);
+        zix_compactRegistryContainer((CFTypeRef *)&_factoryBlocks);
+        pthread_mutex_unlock(&_factoryBlocksLock);
+    }
+    self.registrationFinished = YES;
+    for (Class registry in registries) {
+        [registry publishSnapshot];
+#if ZIKROUTER_CHECK
+        // Sort once before validation reads them concurrently
+        zix_routeEdgeListSort([registry _check_routerToDestinationEdges]);
+        zix_routeEdgeListSort([registry _check_routerToDestinationProtocolEdges]);
+#endif
+    }
+    _didFinishRegistrationForRegistries(registries);
+    NSString *registryExportPath = [NSProcessInfo processInfo].environment[ZIKRegistryExportEnvironmentKey];
+    if (registryExportPath.length > 0) {
+        [ZIKRouteRegistry exportRegistryToFile:registryExportPath error:NULL];
+    }
+    if (_registersAddedImages) {
+        zix_observeAddedImages(^(const void * _Nonnull header) {
+            [ZIKRouteRegistry _registerRoutersInImage:header];
+        });
+    }
+}
+
+/// Register routers in image loaded after registration is finished, then publish new snapshots at once.
++ (void)_registerRoutersInImage:(const void *)header {
+    [self _registerLateRouters:^(NSSet *registries) {
+        ZIKRouterClassPartitions partitions = _makeRouterClassPartitions(registries);
+        ZIKRouterClassPartitions *partitionsRef = &partitions;
+        void(^handler)(__unsafe_unretained Class) = ^(__unsafe_unretained Class  _Nonnull aClass) {
+            _partitionRouterClass(partitionsRef, aClass);
+        };
+        if (_usesSectionRegistration) {
+            zix_enumerateClassesInImageSection(header, ZIKROUTER_ROUTES_SECTION, handler);
+        } else {
+            zix_enumerateClassesInImageForParentClass(header, [ZIKRouter class], handler);
+        }
+        _registerRouterClassPartitions(partitionsRef);
+    }];
+}
+
++ (NSDictionary *)reregisterRoutersInImageRecordingRouteTable:(const void *)header {
+    [ZIKRouteRegistry unregisterRoutesInImage:header];
+    pthread_mutex_lock(&_lateRegistrationLock);
+    _beginRecordingRouteTable();
+    [self _registerRoutersInImage:header];
+    NSDictionary *table = [self _recordedRouteTable];
+    _endRecordingRouteTable();
+    pthread_mutex_unlock(&_lateRegistrationLock);
+    return table;
+}
+
++ (BOOL)reregisterRoutersInImage:(const void *)header withRouteTable:(NSDictionary *)table {
+    if (!_routeTableMatchesImages(table, self.routeTableVersion)) {
+        return NO;
+    }
+    NSArray<dispatch_block_t> *registrations = [self _registrationsFromRouteTable:table lazyRegistrations:nil];
+    if (registrations == nil) {
+        return NO;
+    }
+    [ZIKRouteRegistry unregisterRoutesInImage:header];
+    [self _registerLateRouters:^(NSSet *registries) {
+        for (dispatch_block_t registration in registrations) {
+            registration();
+        }
+    }];
+    return YES;
+}
+
+/// Register routers after registration is finished, then publish new snapshots at once.
++ (void)_registerLateRouters:(void(NS_NOESCAPE ^)(NSSet *registries))registration {
+    pthread_mutex_lock(&_lateRegistrationLock);
+    NSSet *registries = [[self registries] copy];
+    BOOL registeringAddedImage = _registeringAddedImage;
+    _registeringAddedImage = YES;
+    _snapshotPublishingSuspended++;
+    registration(registries);
+    _snapshotPublishingSuspended--;
+    _registeringAddedImage = registeringAddedImage;
+    if (_snapshotPublishingSuspended == 0) {
+        for (Class registry in registries) {
+            [registry publishSnapshot];
+        }
+    }
+    pthread_mutex_unlock(&_lateRegistrationLock);
+    for (Class registry in registries) {
+        [registry invalidateResolvedRoutes];
+    }
+}
+
+static void _callRegistryStage(Class registry, SEL selector, NSString *stageName) {
+    if (!_recordsRegistrationIntervals()) {
+        ((void(*)(id, SEL))objc_msgSend)(registry, selector);
+        return;
+    }
+    NSString *stage = [NSStringFromClass(registry) stringByAppendingString:stageName];
+    ZIKRegistrationInterval interval = _beginRegistrationInterval(stage);
+    ((void(*)(id, SEL))objc_msgSend)(registry, selector);
+    _endRegistrationInterval(interval, stage, _registrationStageDurations);
+}
+
+static void _didFinishRegistrationForRegistries(NSSet *registries) {
+    // Hooks and states are ready on the registering thread before any route is performed
+    for (Class registry in registries) {
+        _callRegistryStage(registry, @selector(didFinishRegistration), @" +didFinishRegistration");
+    }
+#if ZIKROUTER_CHECK
+    if (_validatesInBackground) {
+        // Validation only reads registries, so registries are checked concurrently
+        NSArray<Class> *registryList = registries.allObjects;
+        dispatch_async(zix_globalQueueWithQOS(QOS_CLASS_UTILITY), ^{
+            dispatch_apply(registryList.count, zix_globalQueueWithQOS(QOS_CLASS_UTILITY), ^(size_t idx) {
+                _callRegistryStage(registryList[idx], @selector(validateRegistration), @" +validateRegistration");
+            });
+        });
+        return;
+    }
+    for (Class registry in registries) {
+        _callRegistryStage(registry, @selector(validateRegistration), @" +validateRegistration");
+    }
+#endif
+}
+
++ (void)registerRouterClass:(Class)routerClass {
+    if (_profilesRegistration) {
+        NSString *routerName = NSStringFromClass(routerClass);
+        ZIKRegistrationInterval interval = _beginRegistrationInterval(routerName);
+        [self _registerRouterClass:routerClass];
+        _endRegistrationInterval(interval, routerName, _routerRegistrationDurations);
+        return;
+    }
+    [self _registerRouterClass:routerClass];
+}
+
++ (void)_registerRouterClass:(Class)routerClass {
+    if (_routeTableRecorder == nil) {
+        [routerClass registerRoutableDestination];
+        return;
+    }
+    Class previousRouterClass = _recordingRouterClass;
+    _recordingRouterClass = routerClass;
+    NSMutableDictionary *entry = _routeTableEntry(self, routerClass);
+    if (zix_classIsSwiftClass(routerClass)) {
+        // Swift router may register pure Swift type in ZRouter
+        entry[ZIKRouteTableDynamicKey] = @YES;
+    }
+    [routerClass registerRoutableDestination];
+    _recordingRouterClass = previousRouterClass;
+}
+
+#pragma mark Profile
+
+static inline BOOL _recordsRegistrationIntervals(void) {
+    return _profilesRegistration || zix_isTracing();
+}
+
+#if __has_include(<os/signpost.h>)
+static os_log_t _registrationLog(void) API_AVAILABLE(ios(12.0), tvos(12.0), macos(10.14)) {
+    static os_log_t log;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        log = os_log_create("ZIKRouter", "Registration");
+    });
+    return log;
+}
+#endif
+
+static ZIKRegistrationInterval _beginRegistrationInterval(NSString *name) {
+    ZIKRegistrationInterval interval = {0};
+#if __has_include(<os/signpost.h>)
+    if (@available(iOS 12.0, tvOS 12.0, macOS 10.14, *)) {
+        os_log_t log = _registrationLog();
+        interval.signpostID = os_signpost_id_generate(log);
+        os_signpost_interval_begin(log, interval.signpostID, "Registration", "%{public}@", name);
+    }
+#endif
+    interval.traceStartTime = zix_traceTime();
+    interval.startTime = CFAbsoluteTimeGetCurrent();
+    return interval;
+}
+
+static void _endRegistrationInterval(ZIKRegistrationInterval interval, NSString *name, NSMutableDictionary<NSString *, NSNumber *> *durations) {
+    CFAbsoluteTime duration = CFAbsoluteTimeGetCurrent() - interval.startTime;
+#if __has_include(<os/signpost.h>)
+    if (@available(iOS 12.0, tvOS 12.0, macOS 10.14, *)) {
+        os_signpost_interval_end(_registrationLog(), interval.signpostID, "Registration", "%{public}@", name);
+    }
+#endif
+    zix_traceComplete(name.UTF8String, "registration", interval.traceStartTime, NULL);
+    if (!_profilesRegistration) {
+        return;
+    }
+    // Same router may be registered by several registries, time is accumulated. Registries may finish concurrently when validating in background.
+    @synchronized (durations) {
+        durations[name] = @(durations[name].doubleValue + duration);
+    }
+}
+
++ (void)markDynamicRegistration {
+    _recordRouteTableRegistration(self, nil, nil, nil);
+}
+
+#pragma mark Route Table
+
++ (NSString *)routeTablePath {
+    return _routeTablePath;
+}
+
++ (void)setRouteTablePath:(NSString *)routeTablePath {
+    NSAssert(_registrationFinished == NO, @"Set route table after registration is already finished.");
+    _routeTablePath = [routeTablePath copy];
+}
+
++ (NSString *)routeTableVersion {
+    if (_routeTableVersion == nil) {
+        NSString *version = [[NSBundle mainBundle] objectForInfoDictionaryKey:(__bridge NSString *)kCFBundleVersionKey];
+        return version ?: @"";
+    }
+    return _routeTableVersion;
+}
+
++ (void)setRouteTableVersion:(NSString *)routeTableVersion {
+    NSAssert(_registrationFinished == NO, @"Set route table version after registration is already finished.");
+    _routeTableVersion = [routeTableVersion copy];
+}
+
++ (NSString *)sharedRouteTableGroupIdentifier {
+    return _sharedRouteTableGroupIdentifier;
+}
+
++ (void)setSharedRouteTableGroupIdentifier:(NSString *)sharedRouteTableGroupIdentifier {
+    NSAssert(_registrationFinished == NO, @"Set shared route table after registration is already finished.");
+    _sharedRouteTableGroupIdentifier = [sharedRouteTableGroupIdentifier copy];
+}
+
++ (BOOL)cachesRegistration {
+    return _cachesRegistration;
+}
+
++ (void)setCachesRegistration:(BOOL)cachesRegistration {
+    NSAssert(_registrationFinished == NO, @"Set registration cache after registration is already finished.");
+    _cachesRegistration = cachesRegistration;
+}
+
++ (BOOL)registersLazily {
+    return _registersLazily;
+}
+
++ (void)setRegistersLazily:(BOOL)registersLazily {
+    NSAssert(_registrationFinished == NO, @"Set lazy registration after registration is already finished.");
+    _registersLazily = registersLazily;
+}
+
++ (BOOL)registerLazyRoutersForName:(NSString *)name kind:(NSString *)kind {
+    if (_lazyRegistrations == nil || name == nil) {
+        return NO;
+    }
+    pthread_mutex_lock(&_lateRegistrationLock);
+    NSMutableDictionary<NSString *, NSArray *> *registrationsForNames = _lazyRegistrations[NSStringFromClass(self)][kind];
+    NSArray<ZIKRouteTableRegistration *> *registrations = registrationsForNames[name];
+    if (registrations == nil) {
+        pthread_mutex_unlock(&_lateRegistrationLock);
+        return NO;
+    }
+    [registrationsForNames removeObjectForKey:name];
+    _snapshotPublishingSuspended++;
+    for (ZIKRouteTableRegistration *registration in registrations) {
+        [registration perform];
+    }
+    _snapshotPublishingSuspended--;
+    if (_registrationFinished && _snapshotPublishingSuspended == 0) {
+        [self publishSnapshot];
+        [self invalidateResolvedRoutes];
+    }
+    pthread_mutex_unlock(&_lateRegistrationLock);
+    return YES;
+}
+
++ (void)registerLazyRoutersForDestinationClass:(Class)destinationClass {
+    if (_lazyRegistrations) {
+        [self registerLazyRoutersForName:NSStringFromClass(destinationClass) kind:ZIKRouteTableDestinationsKey];
+    }
+}
+
++ (BOOL)hasLazyRegistrations {
+    if (_lazyRegistrations == nil) {
+        return NO;
+    }
+    pthread_mutex_lock(&_lateRegistrationLock);
+    BOOL hasLazyRegistrations = _lazyRegistrations[NSStringFromClass(self)] != nil;
+    pthread_mutex_unlock(&_lateRegistrationLock);
+    return hasLazyRegistrations;
+}
+
++ (void)registerLazyRouters {
+    if (_lazyRegistrations == nil) {
+        return;
+    }
+    pthread_mutex_lock(&_lateRegistrationLock);
+    NSString *registryName = NSStringFromClass(self);
+    NSDictionary<NSString *, NSMutableDictionary<NSString *, NSArray *> *> *registrationsForKinds = _lazyRegistrations[registryName];
+    if (registrationsForKinds == nil) {
+        pthread_mutex_unlock(&_lateRegistrationLock);
+        return;
+    }
+    [_lazyRegistrations removeObjectForKey:registryName];
+    _snapshotPublishingSuspended++;
+    for (NSString *kind in registrationsForKinds) {
+        NSDictionary<NSString *, NSArray *> *registrationsForNames = registrationsForKinds[kind];
+        for (NSString *name in registrationsForNames) {
+            for (ZIKRouteTableRegistration *registration in registrationsForNames[name]) {
+                [registration perform];
+            }
+        }
+    }
+    _snapshotPublishingSuspended--;
+    if (_registrationFinished && _snapshotPublishingSuspended == 0) {
+        [self publishSnapshot];
+        [self invalidateResolvedRoutes];
+    }
+    pthread_mutex_unlock(&_lateRegistrationLock);
+}
+
+/// Index the registration with names in the route table entry.
+static void _indexLazyRegistration(NSMutableDictionary *lazyRegistrations, NSString *registryName, NSDictionary *entry, ZIKRouteTableRegistration *registration) {
+    NSMutableDictionary<NSString *, NSMutableDictionary<NSString *, NSArray *> *> *registrationsForKinds = lazyRegistrations[registryName];
+    if (registrationsForKinds == nil) {
+        registrationsForKinds = [NSMutableDictionary dictionary];
+        lazyRegistrations[registryName] = registrationsForKinds;
+    }
+    NSDictionary<NSString *, NSString *> *kinds = @{
+                                                    ZIKRouteTableDestinationsKey: ZIKRouteTableDestinationsKey,
+                                                    ZIKRouteTableExclusiveDestinationsKey: ZIKRouteTableDestinationsKey,
+                                                    ZIKRouteTableDestinationProtocolsKey: ZIKRouteTableDestinationProtocolsKey,
+                                                    ZIKRouteTableModuleProtocolsKey: ZIKRouteTableModuleProtocolsKey,
+                                                    ZIKRouteTableIdentifiersKey: ZIKRouteTableIdentifiersKey
+                                                    };
+    [kinds enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull entryKey, NSString * _Nonnull kind, BOOL * _Nonnull stop) {
+        NSArray<NSString *> *names = entry[entryKey];
+        if (names.count == 0) {
+            return;
+        }
+        NSMutableDictionary<NSString *, NSArray *> *registrationsForNames = registrationsForKinds[kind];
+        if (registrationsForNames == nil) {
+            registrationsForNames = [NSMutableDictionary dictionary];
+            registrationsForKinds[kind] = registrationsForNames;
+        }
+        for (NSString *name in names) {
+            NSArray *registrations = registrationsForNames[name];
+            registrationsForNames[name] = registrations ? [registrations arrayByAddingObject:registration] : @[registration];
+        }
+    }];
+}
+
+static void _beginRecordingRouteTable(void) {
+    _routeTableRecorder = [NSMutableDictionary dictionary];
+    _routeTableOrderRecorder = [NSMutableDictionary dictionary];
+}
+
+static void _endRecordingRouteTable(void) {
+    _routeTableRecorder = nil;
+    _routeTableOrderRecorder = nil;
+}
+
+static NSMutableDictionary *_routeTableEntry(Class registry, Class routerClass) {
+    NSString *registryName = NSStringFromClass(registry);
+    NSMutableDictionary<NSString *, NSMutableDictionary *> *routers = _routeTableRecorder[registryName];
+    if (routers == nil) {
+        routers = [NSMutableDictionary dictionary];
+        _routeTableRecorder[registryName] = routers;
+        _routeTableOrderRecorder[registryName] = [NSMutableArray array];
+    }
+    NSString *routerName = NSStringFromClass(routerClass);
+    NSMutableDictionary *entry = routers[routerName];
+    if (entry == nil) {
+        entry = [NSMutableDictionary dictionary];
+        routers[routerName] = entry;
+        // Routers are replayed in this order, so the first registered router is still the default router
+        [_routeTableOrderRecorder[registryName] addObject:routerName];
+    }
+    return entry;
+}
+
+/// UUIDs of app's images. A route table recorded from other builds of these images is stale.
+static NSArray<NSString *> *_customImageUUIDs(void) {
+    NSMutableArray<NSString *> *uuids = [NSMutableArray array];
+    zix_enumerateCustomImages(^(const void * _Nonnull header) {
+        NSString *uuid = zix_imageUUIDString(header);
+        if (uuid) {
+            [uuids addObject:uuid];
+        }
+    });
+    return uuids;
+}
+
+/// The route table is stale when routeTableVersion changed, or any loaded image of the app is not the build it was recorded from.
+static BOOL _routeTableMatchesImages(NSDictionary *table, NSString *version) {
+    if (![table[ZIKRouteTableVersionKey] isEqual:version]) {
+        return NO;
+    }
+    NSArray<NSString *> *recordedImages = table[ZIKRouteTableImagesKey];
+    if (![recordedImages isKindOfClass:[NSArray class]]) {
+        return NO;
+    }
+    NSSet<NSString *> *recordedUUIDs = [NSSet setWithArray:recordedImages];
+    for (NSString *uuid in _customImageUUIDs()) {
+        if (![recordedUUIDs containsObject:uuid]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+/// Record a registration for current registering router. When the key is nil or the route object is not the router class, the router is marked as dynamic.
+static void _recordRouteTableRegistration(Class registry, NSString *_Nullable key, id _Nullable value, id _Nullable routeObject) {
+    if (_routeTableRecorder == nil || _recordingRouterClass == nil) {
+        // Registration out of +registerRoutableDestination will be executed again in next launch
+        return;
+    }
+    NSMutableDictionary *entry = _routeTableEntry(registry, _recordingRouterClass);
+    if (key == nil || value == nil || routeObject != _recordingRouterClass) {
+        entry[ZIKRouteTableDynamicKey] = @YES;
+        return;
+    }
+    NSMutableArray *values = entry[key];
+    if (values == nil) {
+        values = [NSMutableArray array];
+        entry[key] = values;
+    }
+    [values addObject:value];
+}
+
++ (NSDictionary *)_recordedRouteTable {
+    return @{
+             ZIKRouteTableVersionKey: self.routeTableVersion,
+             ZIKRouteTableImagesKey: _customImageUUIDs(),
+             ZIKRouteTableRegistriesKey: _routeTableRecorder,
+             ZIKRouteTableOrderKey: _routeTableOrderRecorder
+             };
+}
+
++ (void)_writeRouteTableToFile:(NSString *)path {
+    NSDictionary *table = [self _recordedRouteTable];
+    NSError *error;
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:table format:NSPropertyListBinaryFormat_v1_0 options:0 error:&error];
+    if (data == nil || [data writeToFile:path options:NSDataWritingAtomic error:&error] == NO) {
+        ZIX_LOG(Registry, Error, @"❌ZIKRouter: failed to write route table to %@, error: %@", path, error);
+        return;
+    }
+    ZIX_LOG(Registry, Info, @"ZIKRouter: route table is written to %@", path);
+}
+
++ (BOOL)_registerWithRouteTable {
+    NSString *path = self.routeTablePath;
+    if (path == nil) {
+        path = [[NSBundle mainBundle] pathForResource:@"ZIKRouteTable" ofType:@"plist"];
+    }
+    if (path == nil) {
+        return NO;
+    }
+    NSData *data = [NSData dataWithContentsOfFile:path];
+    NSDictionary *table = data ? [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:NULL] : nil;
+    // Resolve all classes and protocols before registering, so a stale table won't register anything
+    NSMutableDictionary *lazyRegistrations = _registersLazily ? [NSMutableDictionary dictionary] : nil;
+    NSArray<dispatch_block_t> *registrations = nil;
+    if ([table isKindOfClass:[NSDictionary class]] && _routeTableMatchesImages(table, self.routeTableVersion)) {
+        registrations = [self _registrationsFromRouteTable:table lazyRegistrations:lazyRegistrations];
+    }
+    if (registrations == nil) {
+#if DEBUG
+        ZIX_LOG(Registry, Warning, @"⚠️ZIKRouter: route table (%@) is stale, fallback to enumerating classes.", path);
+#endif
+        return NO;
+    }
+    if (lazyRegistrations.count > 0) {
+        _lazyRegistrations = lazyRegistrations;
+    }
+    for (dispatch_block_t registration in registrations) {
+        registration();
+    }
+    return YES;
+}
+
+/// Resolve registrations in route table. Routers of each registry are replayed in recorded order. When lazyRegistrations is not nil, registrations of static routers after the last dynamic router are indexed into it instead of being returned, only their adapters are registered immediately.
++ (nullable NSArray<dispatch_block_t> *)_registrationsFromRouteTable:(nullable NSDictionary *)table lazyRegistrations:(nullable NSMutableDictionary *)lazyRegistrations {
+    if (![table isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+    NSDictionary<NSString *, NSDictionary *> *registries = table[ZIKRouteTableRegistriesKey];
+    NSDictionary<NSString *, NSArray<NSString *> *> *orders = table[ZIKRouteTableOrderKey];
+    if (![registries isKindOfClass:[NSDictionary class]] || ![orders isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+    // Dynamic router registers all its routes in +registerRoutableDestination, skip its entries in every registry
+    NSMutableSet<Class> *dynamicRouters = [NSMutableSet set];
+    for (NSString *registryName in registries) {
+        Class registry = NSClassFromString(registryName);
+        NSDictionary<NSString *, NSDictionary *> *routers = registries[registryName];
+        NSArray<NSString *> *order = orders[registryName];
+        if (registry == nil || ![_registries containsObject:registry] || ![routers isKindOfClass:[NSDictionary class]] ||
+            ![order isKindOfClass:[NSArray class]] || order.count != routers.count || [NSSet setWithArray:order].count != routers.count) {
+            return nil;
+        }
+        for (NSString *routerName in order) {
+            Class routerClass = [routerName isKindOfClass:[NSString class]] ? NSClassFromString(routerName) : nil;
+            NSDictionary *entry = routerClass ? routers[routerName] : nil;
+            if (routerClass == nil || ![entry isKindOfClass:[NSDictionary class]] || !zix_classIsSubclassOfClass(routerClass, [ZIKRouter class])) {
+                return nil;
+            }
+            if ([entry[ZIKRouteTableDynamicKey] boolValue]) {
+                [dynamicRouters addObject:routerClass];
+            }
+        }
+    }
+    
+    NSMutableArray<dispatch_block_t> *registrations = [NSMutableArray array];
+    for (NSString *registryName in registries) {
+        Class registry = NSClassFromString(registryName);
+        NSDictionary<NSString *, NSDictionary *> *routers = registries[registryName];
+        NSArray<NSString *> *order = orders[registryName];
+        // The first registered router is the default router of a destination, and lazy registrations only run when nothing is found. Static routers before a dynamic router must be registered before it.
+        NSUInteger lazyStartIndex = 0;
+        for (NSUInteger i = 0; i < order.count; i++) {
+            if ([dynamicRouters containsObject:NSClassFromString(order[i])]) {
+                lazyStartIndex = i + 1;
+            }
+        }
+        for (NSUInteger i = 0; i < order.count; i++) {
+            NSString *routerName = order[i];
+            Class routerClass = NSClassFromString(routerName);
+            if ([dynamicRouters containsObject:routerClass]) {
+                [registrations addObject:^{
+                    _handleEnumerateRouterClassInRegistry(registry, routerClass, NO);
+                }];
+                continue;
+            }
+            NSDictionary *entry = routers[routerName];
+            NSArray<dispatch_block_t> *entryRegistrations = [registry _registrationsFromRouteTableEntry:entry router:routerClass];
+            if (entryRegistrations == nil) {
+                return nil;
+            }
+            if (lazyRegistrations && i >= lazyStartIndex) {
+                ZIKRouteTableRegistration *registration = [ZIKRouteTableRegistration new];
+                registration.registration = entryRegistrations.firstObject;
+                _indexLazyRegistration(lazyRegistrations, registryName, entry, registration);
+                [registrations addObject:entryRegistrations.lastObject];
+            } else {
+                [registrations addObjectsFromArray:entryRegistrations];
+            }
+        }
+    }
+    return registrations;
+}
+
+static NSArray<Class> *_Nullable _routeTableClasses(id names) {
+    if (names == nil) {
+        return @[];
+    }
+    if (![names isKindOfClass:[NSArray class]]) {
+        return nil;
+    }
+    NSMutableArray<Class> *classes = [NSMutableArray arrayWithCapacity:[names count]];
+    for (NSString *name in names) {
+        Class aClass = [name isKindOfClass:[NSString class]] ? NSClassFromString(name) : nil;
+        if (aClass == nil) {
+            return nil;
+        }
+        [classes addObject:aClass];
+    }
+    return classes;
+}
+
+static NSArray<Protocol *> *_Nullable _routeTableProtocols(id names) {
+    if (names == nil) {
+        return @[];
+    }
+    if (![names isKindOfClass:[NSArray class]]) {
+        return nil;
+    }
+    NSMutableArray<Protocol *> *protocols = [NSMutableArray arrayWithCapacity:[names count]];
+    for (NSString *name in names) {
+        Protocol *protocol = [name isKindOfClass:[NSString class]] ? NSProtocolFromString(name) : nil;
+        if (protocol == nil) {
+            return nil;
+        }
+        [protocols addObject:protocol];
+    }
+    return protocols;
+}
+
+/// Adapters are stored as [adapter, adaptee] pairs.
+static NSArray<NSArray<Protocol *> *> *_Nullable _routeTableAdapters(id pairs) {
+    if (pairs == nil) {
+        return @[];
+    }
+    if (![pairs isKindOfClass:[NSArray class]]) {
+        return nil;
+    }
+    NSMutableArray<NSArray<Protocol *> *> *adapters = [NSMutableArray arrayWithCapacity:[pairs count]];
+    for (NSArray *pair in pairs) {
+        if (![pair isKindOfClass:[NSArray class]] || pair.count != 2) {
+            return nil;
+        }
+        NSArray<Protocol *> *protocols = _routeTableProtocols(pair);
+        if (protocols == nil) {
+            return nil;
+        }
+        [adapters addObject:protocols];
+    }
+    return adapters;
+}
+
+/// Return registration for routes and registration for adapters of the router.
++ (nullable NSArray<dispatch_block_t> *)_registrationsFromRouteTableEntry:(NSDictionary *)entry router:(Class)routerClass {
+    NSArray<Class> *destinations = _routeTableClasses(entry[ZIKRouteTableDestinationsKey]);
+    NSArray<Class> *exclusiveDestinations = _routeTableClasses(entry[ZIKRouteTableExclusiveDestinationsKey]);
+    NSArray<Protocol *> *destinationProtocols = _routeTableProtocols(entry[ZIKRouteTableDestinationProtocolsKey]);
+    NSArray<Protocol *> *moduleProtocols = _routeTableProtocols(entry[ZIKRouteTableModuleProtocolsKey]);
+    NSArray<NSString *> *identifiers = entry[ZIKRouteTableIdentifiersKey] ?: @[];
+    NSArray<NSArray<Protocol *> *> *destinationAdapters = _routeTableAdapters(entry[ZIKRouteTableDestinationAdaptersKey]);
+    NSArray<NSArray<Protocol *> *> *moduleAdapters = _routeTableAdapters(entry[ZIKRouteTableModuleAdaptersKey]);
+    if (!destinations || !exclusiveDestinations || !destinationProtocols || !moduleProtocols ||
+        ![identifiers isKindOfClass:[NSArray class]] || !destinationAdapters || !moduleAdapters) {
+        return nil;
+    }
+    for (Class destinationClass in destinations) {
+        if (![self isDestinationClassRoutable:destinationClass]) {
+            return nil;
+        }
+    }
+    for (Class destinationClass in exclusiveDestinations) {
+        if (![self isDestinationClassRoutable:destinationClass]) {
+            return nil;
+        }
+    }
+    return @[^{
+        for (Class destinationClass in destinations) {
+            [self registerDestination:destinationClass router:routerClass];
+        }
+        for (Class destinationClass in exclusiveDestinations) {
+            [self registerExclusiveDestination:destinationClass router:routerClass];
+        }
+        for (Protocol *destinationProtocol in destinationProtocols) {
+            [self registerDestinationProtocol:destinationProtocol router:routerClass];
+        }
+        for (Protocol *configProtocol in moduleProtocols) {
+            [self registerModuleProtocol:configProtocol router:routerClass];
+        }
+        for (NSString *identifier in identifiers) {
+            [self registerIdentifier:identifier router:routerClass];
+        }
+    }, ^{
+        for (NSArray<Protocol *> *pair in destinationAdapters) {
+            [self registerDestinationAdapter:pair[0] forAdaptee:pair[1]];
+        }
+        for (NSArray<Protocol *> *pair in moduleAdapters) {
+            [self registerModuleAdapter:pair[0] forAdaptee:pair[1]];
+        }
+    }];
+}
+
+#pragma mark Image Route Table
+
+/// Directory of route tables for each image, nil when image route tables are not used. Shared container is preferred over local caches.
+static NSString *_Nullable _imageRouteTableDirectory(void) {
+    if (_sharedRouteTableGroupIdentifier.length == 0) {
+        if (!_cachesRegistration) {
+            return nil;
+        }
+        NSString *cachesDirectory = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+        if (cachesDirectory == nil) {
+            return nil;
+        }
+#if !ZIK_HAS_UIKIT
+        // Caches directory of macOS app out of sandbox is shared by all apps
+        cachesDirectory = [cachesDirectory stringByAppendingPathComponent:[NSBundle mainBundle].bundleIdentifier ?: [NSProcessInfo processInfo].processName];
+#endif
+        return [cachesDirectory stringByAppendingPathComponent:@"ZIKRouter/RouteTables"];
+    }
+    NSURL *containerURL = [[NSFileManager defaultManager] containerURLForSecurityApplicationGroupIdentifier:_sharedRouteTableGroupIdentifier];
+    if (containerURL == nil) {
+        ZIX_LOG(Registry, Error, @"❌ZIKRouter: can't access container of app group (%@), shared route table is not used.", _sharedRouteTableGroupIdentifier);
+        return nil;
+    }
+    return [containerURL.path stringByAppendingPathComponent:@"ZIKRouter/RouteTables"];
+}
+
+/// Read the route table of an image. The file is mapped read-only instead of being copied into memory.
+static NSDictionary *_Nullable _imageRouteTable(NSString *path, NSString *uuid) {
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedAlways error:NULL];
+    NSDictionary *table = data ? [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:NULL] : nil;
+    if (![table isKindOfClass:[NSDictionary class]] || ![table[ZIKRouteTableVersionKey] isEqual:uuid]) {
+        return nil;
+    }
+    NSDictionary<NSString *, NSDictionary *> *registries = table[ZIKRouteTableRegistriesKey];
+    NSDictionary<NSString *, NSArray *> *orders = table[ZIKRouteTableOrderKey];
+    // Tables written before routers' order was recorded are rebuilt
+    if (![registries isKindOfClass:[NSDictionary class]] || ![orders isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+    for (NSString *registryName in registries) {
+        if (![registries[registryName] isKindOfClass:[NSDictionary class]] || ![orders[registryName] isKindOfClass:[NSArray class]]) {
+            return nil;
+        }
+    }
+    return table;
+}
+
+/// Register routers of each app image with the table named with the image's UUID. Images without valid table are enumerated, then their tables are written for next launch.
++ (void)_registerWithImageRouteTablesInDirectory:(NSString *)directory registries:(NSSet *)registries {
+    ZIKRegistrationInterval interval = _recordsRegistrationIntervals() ? _beginRegistrationInterval(@"registerWithImageRouteTables") : (ZIKRegistrationInterval){0};
+    NSMutableArray<NSValue *> *images = [NSMutableArray array];
+    NSMutableArray<NSValue *> *uncoveredImages = [NSMutableArray array];
+    NSMutableDictionary<NSString *, NSMutableDictionary *> *tableRegistries = [NSMutableDictionary dictionary];
+    NSMutableDictionary<NSString *, NSMutableArray *> *tableOrders = [NSMutableDictionary dictionary];
+    zix_enumerateCustomImages(^(const void * _Nonnull header) {
+        NSValue *image = [NSValue valueWithPointer:header];
+        [images addObject:image];
+        NSString *uuid = zix_imageUUIDString(header);
+        NSString *path = [directory stringByAppendingPathComponent:[uuid stringByAppendingPathExtension:@"plist"]];
+        NSDictionary *imageTable = uuid ? _imageRouteTable(path, uuid) : nil;
+        if (imageTable == nil) {
+            [uncoveredImages addObject:image];
+            return;
+        }
+        NSDictionary<NSString *, NSDictionary *> *imageRegistries = imageTable[ZIKRouteTableRegistriesKey];
+        NSDictionary<NSString *, NSArray *> *imageOrders = imageTable[ZIKRouteTableOrderKey];
+        for (NSString *registryName in imageRegistries) {
+            NSMutableDictionary *routers = tableRegistries[registryName];
+            if (routers == nil) {
+                routers = [NSMutableDictionary dictionary];
+                tableRegistries[registryName] = routers;
+                tableOrders[registryName] = [NSMutableArray array];
+            }
+            [routers addEntriesFromDictionary:imageRegistries[registryName]];
+            // Routers of images are replayed in the order of images
+            [tableOrders[registryName] addObjectsFromArray:imageOrders[registryName]];
+        }
+    });
+    NSMutableDictionary *lazyRegistrations = _registersLazily ? [NSMutableDictionary dictionary] : nil;
+    NSArray<dispatch_block_t> *registrations = @[];
+    if (tableRegistries.count > 0) {
+        NSDictionary *table = @{
+                                ZIKRouteTableRegistriesKey: tableRegistries,
+                                ZIKRouteTableOrderKey: tableOrders
+                                };
+        registrations = [self _registrationsFromRouteTable:table lazyRegistrations:lazyRegistrations];
+        if (registrations == nil) {
+            // A table refers to a class or protocol removed from another image, rebuild all tables
+            registrations = @[];
+            lazyRegistrations = nil;
+            uncoveredImages = images;
+        }
+    }
+    if (lazyRegistrations.count > 0) {
+        _lazyRegistrations = lazyRegistrations;
+    }
+    for (dispatch_block_t registration in registrations) {
+        registration();
+    }
+    if (_recordsRegistrationIntervals()) {
+        _endRegistrationInterval(interval, @"registerWithImageRouteTables", _registrationStageDurations);
+    }
+    if (uncoveredImages.count == 0) {
+        return;
+    }
+    
+    interval = _recordsRegistrationIntervals() ? _beginRegistrationInterval(@"enumerateClasses") : (ZIKRegistrationInterval){0};
+    _beginRecordingRouteTable();
+    ZIKRouterClassPartitions partitions = _makeRouterClassPartitions(registries);
+    ZIKRouterClassPartitions *partitionsRef = &partitions;
+    void(^handler)(__unsafe_unretained Class) = ^(__unsafe_unretained Class  _Nonnull aClass) {
+        _partitionRouterClass(partitionsRef, aClass);
+    };
+    for (NSValue *image in uncoveredImages) {
+        if (_usesSectionRegistration) {
+            zix_enumerateClassesInImageSection(image.pointerValue, ZIKROUTER_ROUTES_SECTION, handler);
+        } else {
+            zix_enumerateClassesInImageForParentClass(image.pointerValue, [ZIKRouter class], handler);
+        }
+    }
+    _registerRouterClassPartitions(partitionsRef);
+    if (_recordsRegistrationIntervals()) {
+        _endRegistrationInterval(interval, @"enumerateClasses", _registrationStageDurations);
+    }
+    [self _writeImageRouteTablesForImages:uncoveredImages toDirectory:directory];
+    _endRecordingRouteTable();
+}
+
+/// Split recorded routers by their images, and write a table for each image. Images without router also get an empty table, so they won't be enumerated in next launch.
++ (void)_writeImageRouteTablesForImages:(NSArray<NSValue *> *)images toDirectory:(NSString *)directory {
+    NSMutableDictionary<NSValue *, NSMutableDictionary *> *registriesOfImages = [NSMutableDictionary dictionaryWithCapacity:images.count];
+    NSMutableDictionary<NSValue *, NSMutableDictionary *> *ordersOfImages = [NSMutableDictionary dictionaryWithCapacity:images.count];
+    for (NSValue *image in images) {
+        registriesOfImages[image] = [NSMutableDictionary dictionary];
+        ordersOfImages[image] = [NSMutableDictionary dictionary];
+    }
+    [_routeTableRecorder enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull registryName, NSMutableDictionary<NSString *, NSMutableDictionary *> * _Nonnull routers, BOOL * _Nonnull stop) {
+        // Keep recorded order of routers in each image's table
+        for (NSString *routerName in _routeTableOrderRecorder[registryName]) {
+            // Recorded routers are always enumerated from these images
+            const void *header = zix_imageHeaderOfClass(NSClassFromString(routerName));
+            NSValue *image = header ? [NSValue valueWithPointer:header] : nil;
+            NSMutableDictionary *imageRegistries = image ? registriesOfImages[image] : nil;
+            if (imageRegistries == nil) {
+                continue;
+            }
+            NSMutableDictionary *imageRouters = imageRegistries[registryName];
+            NSMutableArray *imageOrder = ordersOfImages[image][registryName];
+            if (imageRouters == nil) {
+                imageRouters = [NSMutableDictionary dictionary];
+                imageRegistries[registryName] = imageRouters;
+                imageOrder = [NSMutableArray array];
+                ordersOfImages[image][registryName] = imageOrder;
+            }
+            imageRouters[routerName] = routers[routerName];
+            [imageOrder addObject:routerName];
+        }
+    }];
+    NSError *error;
+    if (![[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:&error]) {
+        ZIX_LOG(Registry, Error, @"❌ZIKRouter: failed to create directory for route tables at %@, error: %@", directory, error);
+        return;
+    }
+    [registriesOfImages enumerateKeysAndObjectsUsingBlock:^(NSValue * _Nonnull image, NSMutableDictionary * _Nonnull imageRegistries, BOOL * _Nonnull stop) {
+        NSString *uuid = zix_imageUUIDString(image.pointerValue);
+        if (uuid == nil) {
+            return;
+        }
+        NSDictionary *table = @{
+                                ZIKRouteTableVersionKey: uuid,
+                                ZIKRouteTableRegistriesKey: imageRegistries,
+                                ZIKRouteTableOrderKey: ordersOfImages[image]
+                                };
+        NSString *path = [directory stringByAppendingPathComponent:[uuid stringByAppendingPathExtension:@"plist"]];
+        NSError *writingError;
+        NSData *data = [NSPropertyListSerialization dataWithPropertyList:table format:NSPropertyListBinaryFormat_v1_0 options:0 error:&writingError];
+        // Atomic writing, so other processes never map a partial file
+        if (data == nil || [data writeToFile:path options:NSDataWritingAtomic error:&writingError] == NO) {
+            ZIX_LOG(Registry, Error, @"❌ZIKRouter: failed to write route table to %@, error: %@", path, writingError);
+        }
+    }];
+}
+
+#pragma mark Export
+
+static NSString *const ZIKRegistryExportRoutesKey = @"routes";
+static NSString *const ZIKRegistryExportAdaptersKey = @"adapters";
+static NSString *const ZIKRegistryExportURLPatternsKey = @"urlPatterns";
+
+/// Name of the image, and record its UUID in images.
+static NSString *_Nullable _exportedImageName(const void *_Nullable header, NSMutableDictionary<NSString *, NSString *> *images) {
+    Dl_info info;
+    if (header == NULL || dladdr(header, &info) == 0 || info.dli_fname == NULL) {
+        return nil;
+    }
+    NSString *name = [NSString stringWithUTF8String:info.dli_fname].lastPathComponent;
+    if (name && images[name] == nil) {
+        images[name] = zix_imageUUIDString(header) ?: @"";
+    }
+    return name;
+}
+
+/// Entry of the route object, or the destination class for factory. Key is the route object or the destination class.
+static NSMutableDictionary *_exportEntry(CFMutableDictionaryRef entries, id routeObject, BOOL factory, NSMutableDictionary<NSString *, NSString *> *images) {
+    NSMutableDictionary *entry = (__bridge NSMutableDictionary *)CFDictionaryGetValue(entries, (__bridge const void *)routeObject);
+    if (entry) {
+        return entry;
+    }
+    NSString *name;
+    NSString *kind;
+    const void *header = NULL;
+    if (factory) {
+        name = NSStringFromClass(routeObject);
+        kind = @"factory";
+        header = zix_imageHeaderOfClass(routeObject);
+    } else if (class_isMetaClass(object_getClass(routeObject))) {
+        name = NSStringFromClass(routeObject);
+        kind = @"router";
+        header = zix_imageHeaderOfClass(routeObject);
+    } else {
+        kind = @"route";
+        if ([routeObject isKindOfClass:[ZIKRoute class]]) {
+            ZIKRoute *route = routeObject;
+            name = route.name;
+            if (route.makeDestinationBlock) {
+                header = zix_imageHeaderOfBlock(route.makeDestinationBlock);
+            }
+        }
+        if (name == nil) {
+            name = NSStringFromClass([routeObject class]);
+        }
+    }
+    entry = [NSMutableDictionary dictionary];
+    entry[@"name"] = name;
+    entry[@"kind"] = kind;
+    entry[@"image"] = _exportedImageName(header, images) ?: [NSNull null];
+    for (NSString *key in @[ZIKRouteTableDestinationsKey, ZIKRouteTableExclusiveDestinationsKey, ZIKRouteTableDestinationProtocolsKey, ZIKRouteTableModuleProtocolsKey, ZIKRouteTableIdentifiersKey, ZIKRegistryExportURLPatternsKey]) {
+        entry[key] = [NSMutableSet set];
+    }
+    CFDictionarySetValue(entries, (__bridge const void *)routeObject, (__bridge const void *)entry);
+    return entry;
+}
+
+typedef struct {
+    CFMutableDictionaryRef entries;
+    __unsafe_unretained NSMutableDictionary<NSString *, NSString *> *images;
+    __unsafe_unretained NSString *key;
+    __unsafe_unretained NSSet<NSString *> *urlPatterns;
+    BOOL factory;
+    BOOL keyIsProtocol;
+} ZIKRegistryExportContext;
+
+static void _exportRegistration(const void *key, const void *value, void *context) {
+    ZIKRegistryExportContext *exportContext = context;
+    NSString *exportKey = exportContext->key;
+    NSString *name;
+    if (exportContext->keyIsProtocol) {
+        name = NSStringFromProtocol((__bridge Protocol *)key);
+    } else if ([exportKey isEqualToString:ZIKRouteTableIdentifiersKey]) {
+        name = (__bridge NSString *)key;
+        if ([exportContext->urlPatterns containsObject:name]) {
+            exportKey = ZIKRegistryExportURLPatternsKey;
+        }
+    } else {
+        name = NSStringFromClass((__bridge Class)key);
+    }
+    NSMutableDictionary *entry = _exportEntry(exportContext->entries, (__bridge id)value, exportContext->factory, exportContext->images);
+    [entry[exportKey] addObject:name];
+}
+
++ (NSDictionary *)_exportedRegistryWithImages:(NSMutableDictionary<NSString *, NSString *> *)images {
+    CFMutableDictionaryRef entries = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    ZIKRegistryExportContext context = {entries, images, nil, [self registeredURLPatterns], NO, NO};
+    CFDictionaryRef destinationToRoutersMap = self.destinationToRoutersMap;
+    CFIndex count = CFDictionaryGetCount(destinationToRoutersMap);
+    if (count > 0) {
+        const void **keys = malloc(sizeof(void *) * count);
+        const void **values = malloc(sizeof(void *) * count);
+        CFDictionaryGetKeysAndValues(destinationToRoutersMap, keys, values);
+        context.key = ZIKRouteTableDestinationsKey;
+        for (CFIndex i = 0; i < count; i++) {
+            CFSetRef routes = values[i];
+            CFIndex routeCount = CFSetGetCount(routes);
+            const void **routeObjects = malloc(sizeof(void *) * routeCount);
+            CFSetGetValues(routes, routeObjects);
+            for (CFIndex j = 0; j < routeCount; j++) {
+                _exportRegistration(keys[i], routeObjects[j], &context);
+            }
+            free(routeObjects);
+        }
+        free(keys);
+        free(values);
+    }
+    context.key = ZIKRouteTableExclusiveDestinationsKey;
+    CFDictionaryApplyFunction(self.destinationToExclusiveRouterMap, _exportRegistration, &context);
+    context.key = ZIKRouteTableIdentifiersKey;
+    CFDictionaryApplyFunction(self.identifierToRouterMap, _exportRegistration, &context);
+    context.keyIsProtocol = YES;
+    context.key = ZIKRouteTableDestinationProtocolsKey;
+    CFDictionaryApplyFunction(self.destinationProtocolToRouterMap, _exportRegistration, &context);
+    context.key = ZIKRouteTableModuleProtocolsKey;
+    CFDictionaryApplyFunction(self.moduleConfigProtocolToRouterMap, _exportRegistration, &context);
+    
+    // Factories are grouped by their destination classes
+    context.factory = YES;
+    context.key = ZIKRouteTableDestinationProtocolsKey;
+    CFDictionaryApplyFunction(self.destinationProtocolToDestinationMap, _exportRegistration, &context);
+    context.key = ZIKRouteTableModuleProtocolsKey;
+    CFDictionaryApplyFunction(self.moduleConfigProtocolToDestinationMap, _exportRegistration, &context);
+    context.keyIsProtocol = NO;
+    context.key = ZIKRouteTableIdentifiersKey;
+    CFDictionaryApplyFunction(self.identifierToDestinationMap, _exportRegistration, &context);
+    context.key = ZIKRouteTableDestinationsKey;
+    NSMutableSet *factoryDestinations = [(__bridge NSSet *)self.runtimeFactoryDestinationClasses mutableCopy];
+    [factoryDestinations addObjectsFromArray:[(__bridge NSDictionary *)self.destinationToDefaultFactoryMap allKeys]];
+    [factoryDestinations addObjectsFromArray:[(__bridge NSDictionary *)self.destinationToDefaultConfigFactoryMap allKeys]];
+    for (Class destinationClass in factoryDestinations) {
+        _exportRegistration((__bridge const void *)destinationClass, (__bridge const void *)destinationClass, &context);
+    }
+    
+    NSMutableArray<NSDictionary *> *routes = [NSMutableArray arrayWithCapacity:CFDictionaryGetCount(entries)];
+    for (NSMutableDictionary *entry in [(__bridge NSDictionary *)entries allValues]) {
+        NSMutableDictionary *exportedEntry = [entry mutableCopy];
+        [entry enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull key, id  _Nonnull value, BOOL * _Nonnull stop) {
+            if ([value isKindOfClass:[NSSet class]]) {
+                exportedEntry[key] = [[value allObjects] sortedArrayUsingSelector:@selector(compare:)];
+            }
+        }];
+        [routes addObject:exportedEntry];
+    }
+    CFRelease(entries);
+    // Unnamed ZIKRoutes have the same name, compare what they registered
+    NSArray<NSString *> *sortKeys = @[@"name", @"kind", ZIKRouteTableDestinationsKey, ZIKRouteTableExclusiveDestinationsKey, ZIKRouteTableDestinationProtocolsKey, ZIKRouteTableModuleProtocolsKey, ZIKRouteTableIdentifiersKey, ZIKRegistryExportURLPatternsKey];
+    [routes sortUsingComparator:^NSComparisonResult(NSDictionary * _Nonnull route1, NSDictionary * _Nonnull route2) {
+        for (NSString *key in sortKeys) {
+            id value1 = route1[key];
+            id value2 = route2[key];
+            if ([value1 isKindOfClass:[NSArray class]]) {
+                value1 = [value1 componentsJoinedByString:@","];
+                value2 = [value2 componentsJoinedByString:@","];
+            }
+            NSComparisonResult result = [value1 compare:value2];
+            if (result != NSOrderedSame) {
+                return result;
+            }
+        }
+        return NSOrderedSame;
+    }];
+    
+    NSMutableDictionary<NSString *, NSString *> *adapters = [NSMutableDictionary dictionary];
+    [(__bridge NSDictionary *)self.adapterToAdapteeMap enumerateKeysAndObjectsUsingBlock:^(Protocol *adapter, Protocol *adaptee, BOOL * _Nonnull stop) {
+        adapters[NSStringFromProtocol(adapter)] = NSStringFromProtocol(adaptee);
+    }];
+    return @{ZIKRegistryExportRoutesKey: routes, ZIKRegistryExportAdaptersKey: adapters};
+}
+
++ (NSData *)exportedRegistryJSONData {
+    NSAssert(self == [ZIKRouteRegistry class], @"Export from ZIKRouteRegistry, it contains all registries.");
+    _waitForBackgroundRegistration();
+    NSMutableDictionary<NSString *, NSString *> *images = [NSMutableDictionary dictionary];
+    NSMutableDictionary<NSString *, NSDictionary *> *registries = [NSMutableDictionary dictionary];
+    // Routers are not changed by images loaded meanwhile
+    pthread_mutex_lock(&_lateRegistrationLock);
+    for (Class registry in [[self registries] copy]) {
+        [registry registerLazyRouters];
+        registries[NSStringFromClass(registry)] = [registry _exportedRegistryWithImages:images];
+    }
+    pthread_mutex_unlock(&_lateRegistrationLock);
+    NSDictionary *exported = @{
+                               ZIKRouteTableVersionKey: @1,
+                               @"routeTableVersion": self.routeTableVersion,
+                               @"images": images,
+                               ZIKRouteTableRegistriesKey: registries
+                               };
+    NSJSONWritingOptions options = NSJSONWritingPrettyPrinted;
+    if (@available(iOS 11.0, tvOS 11.0, macOS 10.13, *)) {
+        options |= NSJSONWritingSortedKeys;
+    }
+    return [NSJSONSerialization dataWithJSONObject:exported options:options error:NULL];
+}
+
++ (BOOL)exportRegistryToFile:(NSString *)path error:(NSError **)error {
+    NSData *data = [self exportedRegistryJSONData];
+    if ([data writeToFile:path options:NSDataWritingAtomic error:error] == NO) {
+        ZIX_LOG(Registry, Error, @"❌ZIKRouter: failed to export registry to %@, error: %@", path, error ? *error : nil);
+        return NO;
+    }
+    ZIX_LOG(Registry, Info, @"ZIKRouter: registry is exported to %@", path);
+    return YES;
+}
+
++ (nullable NSSet<NSString *> *)registeredURLPatterns {
+    return nil;
+}
+
+#pragma mark Discover
+
++ (ZIKRoute *)easyRouteForDestinationClass:(Class)destinationClass factory:(id(^)(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router))factory {
+    return [[ZIKRoute alloc] initWithMakeDestination:^id _Nullable(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
+        if (!factory) {
+            return nil;
+        }
+        return factory(config, router);
+    }];
+}
+
++ (ZIKRoute *)easyRouteForDestinationClass:(Class)destinationClass configFactory:(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(^)(void))factory {
+    return [[ZIKRoute alloc] initWithMakeDestination:^id _Nullable(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
+        if ([config conformsToProtocol:@protocol(ZIKConfigurationMakeable)]) {
+            if ([config respondsToSelector:@selector(makeDestination)] && config.makeDestination) {
+                id destination = config.makeDestination();
+                return destination;
+            }
+        }
+        return nil;
+    }].makeDefaultConfiguration(^ZIKPerformRouteConfiguration * _Nonnull{
+        return factory();
+    });
+}
+
+/// Whether the factory is a block. Factories may be registered on other threads while easy routes are made, so read _factoryBlocks with the lock.
+static BOOL _isFactoryBlock(const void *factory) {
+    pthread_mutex_lock(&_factoryBlocksLock);
+    BOOL isBlock = CFSetContainsValue(_factoryBlocks, factory);
+    pthread_mutex_unlock(&_factoryBlocksLock);
+    return isBlock;
+}
+
++ (nullable ZIKRoute *)_makeEasyRouteForDestinationClass:(Class)destinationClass {
+    const void *f = CFDictionaryGetValue(self.destinationToDefaultConfigFactoryMap, (__bridge const void *)(destinationClass));
+    if (f) {
+        ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(*factory)(void) = f;
+        if (_isFactoryBlock(factory)) {
+            ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(^block)(void) = CFDictionaryGetValue(self.destinationToDefaultConfigFactoryMap, (__bridge const void *)(destinationClass));
+            return [self easyRouteForDestinationClass:destinationClass configFactory:block];
+        }
+        return [self easyRouteForDestinationClass:destinationClass configFactory:^ZIKPerformRouteConfiguration *{
+            return factory();
+        }];
+    }
+    
+    f = CFDictionaryGetValue(self.destinationToDefaultFactoryMap, (__bridge const void *)(destinationClass));
+    if (f) {
+        id _Nullable(*factory)(ZIKPerformRouteConfiguration * _Nonnull) = f;
+        if (_isFactoryBlock(factory)) {
+            id _Nullable(^block)(ZIKPerformRouteConfiguration * _Nonnull) = CFDictionaryGetValue(self.destinationToDefaultFactoryMap, (__bridge const void *)(destinationClass));
+            return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
+                return block(config);
+            }];
+        }
+        return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
+            return factory(config);
+        }];
+    }
+    if (CFSetContainsValue(self.runtimeFactoryDestinationClasses, (__bridge const void *)(destinationClass))) {
+        return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
+            return [[destinationClass alloc] init];
+        }];
+    }
+    return nil;
+}
+
++ (nullable ZIKRoute *)_makeEasyRouteForDestinationProtocol:(Protocol *)destinationProtocol {
+    Class destinationClass = CFDictionaryGetValue(self.destinationProtocolToDestinationMap, (__bridge const void *)(destinationProtocol));
+    if (!destinationClass) {
+        return nil;
+    }
+    
+    id _Nullable(*factory)(ZIKPerformRouteConfiguration * _Nonnull) = CFDictionaryGetValue(self.destinationProtocolToFactoryMap, (__bridge const void *)(destinationProtocol));
+    if (factory) {
+        if (_isFactoryBlock(factory)) {
+            id _Nullable(^block)(ZIKPerformRouteConfiguration * _Nonnull) = CFDictionaryGetValue(self.destinationProtocolToFactoryMap, (__bridge const void *)(destinationProtocol));
+            return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
+                return block(config);
+            }];
+        }
+        return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
+            return factory(config);
+        }];
+    }
+    if (CFSetContainsValue(self.runtimeFactoryDestinationClasses, (__bridge const void *)(destinationClass))) {
+        return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
+            return [[destinationClass alloc] init];
+        }];
+    }
+    return nil;
+}
+
++ (nullable ZIKRoute *)_makeEasyRouteForModuleProtocol:(Protocol *)configProtocol {
+    Class destinationClass = CFDictionaryGetValue(self.moduleConfigProtocolToDestinationMap, (__bridge const void *)(configProtocol));
+    if (!destinationClass) {
+        return nil;
+    }
+    ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(*factory)(void) = CFDictionaryGetValue(self.moduleConfigProtocolToFactoryMap, (__bridge const void *)(configProtocol));
+    if (factory) {
+        if (_isFactoryBlock(factory)) {
+            ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(^block)(void) = CFDictionaryGetValue(self.moduleConfigProtocolToFactoryMap, (__bridge const void *)(configProtocol));
+            return [self easyRouteForDestinationClass:destinationClass configFactory:block];
+        }
+        return [self easyRouteForDestinationClass:destinationClass configFactory:^ZIKPerformRouteConfiguration *{
+            return factory();
+        }];
+    }
+    return nil;
+}
+
++ (nullable ZIKRoute *)_makeEasyRouteForIdentifier:(NSString *)identifier {
+    Class destinationClass = CFDictionaryGetValue(self.identifierToDestinationMap, (__bridge CFStringRef)(identifier));
+    if (!destinationClass) {
+        return nil;
+    }
+    const void *f = CFDictionaryGetValue(self.identifierToConfigFactoryMap, (__bridge CFStringRef)(identifier));
+    if (f) {
+        ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(*factory)(void) = f;
+        if (_isFactoryBlock(factory)) {
+            ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(^block)(void) = CFDictionaryGetValue(self.identifierToConfigFactoryMap, (__bridge CFStringRef)(identifier));
+            return [self easyRouteForDestinationClass:destinationClass configFactory:block];
+        }
+        return [self easyRouteForDestinationClass:destinationClass configFactory:^ZIKPerformRouteConfiguration *{
+            return factory();
+        }];
+    }
+    
+    f = CFDictionaryGetValue(self.identifierToFactoryMap, (__bridge CFStringRef)(identifier));
+    if (f) {
+        id _Nullable(*factory)(ZIKPerformRouteConfiguration * _Nonnull) = f;
+        if (_isFactoryBlock(factory)) {
+            id _Nullable(^block)(ZIKPerformRouteConfiguration * _Nonnull) = CFDictionaryGetValue(self.identifierToFactoryMap, (__bridge CFStringRef)(identifier));
+            return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
+                return block(config);
+            }];
+        }
+        return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
+            return factory(config);
+        }];
+    }
+    if (CFSetContainsValue(self.runtimeFactoryDestinationClasses, (__bridge const void *)(destinationClass))) {
+        return [self easyRouteForDestinationClass:destinationClass factory:^id(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
+            return [[destinationClass alloc] init];
+        }];
+    }
+    return nil;
+}
+
++ (nullable ZIKRoute *)easyRouteForDestinationClass:(Class)destinationClass {
+    return _ZIKRegistryLookupValue(self, destinationToEasyRouteMap, (__bridge const void *)(destinationClass));
+}
+
++ (nullable ZIKRoute *)easyRouteForDestinationProtocol:(Protocol *)destinationProtocol {
+    return _ZIKRegistryLookupValue(self, destinationProtocolToEasyRouteMap, (__bridge const void *)(destinationProtocol));
+}
+
++ (nullable ZIKRoute *)easyRouteForModuleProtocol:(Protocol *)configProtocol {
+    return _ZIKRegistryLookupValue(self, moduleConfigProtocolToEasyRouteMap, (__bridge const void *)(configProtocol));
+}
+
++ (nullable ZIKRoute *)easyRouteForIdentifier:(NSString *)identifier {
+    return _ZIKRegistryLookupValue(self, identifierToEasyRouteMap, (__bridge CFStringRef)(identifier));
+}
+
+/// Easy routes only depend on registered factories, so make them once when registering, rather than copying blocks in every lookup.
++ (void)_updateEasyRouteForDestinationClass:(Class)destinationClass destinationProtocol:(nullable Protocol *)destinationProtocol moduleProtocol:(nullable Protocol *)configProtocol identifier:(nullable NSString *)identifier {
+    ZIKRoute *route = [self _makeEasyRouteForDestinationClass:destinationClass];
+    if (route) {
+        zix_incrementRouterCounter(ZIKRouterCounterEasyRouteConstruction);
+        CFDictionarySetValue(self.destinationToEasyRouteMap, (__bridge const void *)(destinationClass), (__bridge const void *)(route));
+        _registerRouterTypeForRoute(route, self);
+    }
+    if (destinationProtocol) {
+        route = [self _makeEasyRouteForDestinationProtocol:destinationProtocol];
+        if (route) {
+            zix_incrementRouterCounter(ZIKRouterCounterEasyRouteConstruction);
+            CFDictionarySetValue(self.destinationProtocolToEasyRouteMap, (__bridge const void *)(destinationProtocol), (__bridge const void *)(route));
+            _registerRouterTypeForRoute(route, self);
+        }
+    }
+    if (configProtocol) {
+        route = [self _makeEasyRouteForModuleProtocol:configProtocol];
+        if (route) {
+            zix_incrementRouterCounter(ZIKRouterCounterEasyRouteConstruction);
+            CFDictionarySetValue(self.moduleConfigProtocolToEasyRouteMap, (__bridge const void *)(configProtocol), (__bridge const void *)(route));
+            _registerRouterTypeForRoute(route, self);
+        }
+    }
+    if (identifier) {
+        route = [self _makeEasyRouteForIdentifier:identifier];
+        if (route) {
+            zix_incrementRouterCounter(ZIKRouterCounterEasyRouteConstruction);
+            CFDictionarySetValue(self.identifierToEasyRouteMap, (__bridge CFStringRef)(identifier), (__bridge const void *)(route));
+            _registerRouterTypeForRoute(route, self);
+        }
+    }
+}
+
++ (Class)routerTypeClass {
+    return [ZIKRouterType class];
+}
+
++ (id)routeKeyForRouter:(ZIKRouter *)router {
+    return [router class];
+}
+
++ (ZIKRouterCounter)lookupCounter {
+    NSAssert(NO, @"%@ must override +lookupCounter", self);
+    return ZIKRouterCounterServiceLookup;
+}
+
++ (ZIKRouterCounter)lookupMissCounter {
+    NSAssert(NO, @"%@ must override +lookupMissCounter", self);
+    return ZIKRouterCounterServiceLookupMiss;
+}
+
++ (nullable ZIKRouterType *)_routerTypeForObject:(id)object {
+    if (object == nil) {
+        return nil;
+    }
+    ZIKRouterType *routerType = _ZIKRegistryLookupValue(self, routeToRouterTypeMap, (__bridge const void *)(object));
+    if (routerType) {
+        return routerType;
+    }
+    if ([object isKindOfClass:[ZIKRoute class]]) {
+        zix_incrementRouterCounter(ZIKRouterCounterRouterTypeCreation);
+        return [[[self routerTypeClass] alloc] initWithRoute:object];
+    } else if ([object class] == object) {
+        if ([(Class)object isSubclassOfClass:[ZIKRouter class]]) {
+            zix_incrementRouterCounter(ZIKRouterCounterRouterTypeCreation);
+            return [[[self routerTypeClass] alloc] initWithRouterClass:object];
+        }
+    }
+    return nil;
+}
+
++ (nullable ZIKRouterType *)routerToRegisteredDestinationClass:(Class)destinationClass {
+    uint64_t startTime = zix_routeMetricsTime();
+    _beginSnapshotReading();
+    ZIKRouterType *routerType = [self _routerToRegisteredDestinationClass:destinationClass];
+    _endSnapshotReading();
+    _recordLookup(self, routerType, startTime);
+    return routerType;
+}
+
++ (nullable ZIKRouterType *)_routerToRegisteredDestinationClass:(Class)destinationClass {
+    NSAssert([self isDestinationClassRoutable:destinationClass], @"destination class (%@) should conforms to ZIKRoutableView or ZIKRoutableService.", NSStringFromClass(destinationClass));
+    ZIKRouterType *launchRouterType = _launchRouterType(self, (__bridge const void *)(destinationClass), ZIKRouteIndexKindDestinationClass);
+    if (launchRouterType) {
+        return launchRouterType;
+    }
+    _waitForBackgroundRegistration();
+    if (!_registrationFinished) {
+        return [self _routerTypeForObject:[self _resolveRouteForDestinationClass:destinationClass]];
+    }
+    CFMutableDictionaryRef destinationToResolvedRouteMap = self.destinationToResolvedRouteMap;
+    dispatch_semaphore_wait(_resolvedRoutesSema, DISPATCH_TIME_FOREVER);
+    id route = CFDictionaryGetValue(destinationToResolvedRouteMap, (__bridge const void *)(destinationClass));
+    dispatch_semaphore_signal(_resolvedRoutesSema);
+    if (route) {
+        zix_incrementRouterCounter(ZIKRouterCounterResolvedRouteCacheHit);
+        return route == (id)kCFNull ? nil : [self _routerTypeForObject:route];
+    }
+    zix_incrementRouterCounter(ZIKRouterCounterResolvedRouteCacheMiss);
+    route = [self _resolveRouteForDestinationClass:destinationClass];
+    dispatch_semaphore_wait(_resolvedRoutesSema, DISPATCH_TIME_FOREVER);
+    CFDictionarySetValue(destinationToResolvedRouteMap, (__bridge const void *)(destinationClass), route ? (__bridge const void *)(route) : kCFNull);
+    dispatch_semaphore_signal(_resolvedRoutesSema);
+    return [self _routerTypeForObject:route];
+}
+
++ (nullable id)_resolveRouteForDestinationClass:(Class)destinationClass {
+    Class rootClass = [self routableRootClassOfDestinationClass:destinationClass];
+    if (rootClass == nil) {
+        return nil;
+    }
+    while (destinationClass) {
+        const ZIKRouteIndexEntry *entry = NULL;
+        if (_lookupRouteIndex(self, (__bridge const void *)(destinationClass), ZIKRouteIndexKindDestinationClass, &entry)) {
+            if (entry) {
+                return (__bridge id)(entry->route);
+            }
+            if (destinationClass == rootClass) {
+                break;
+            }
+            destinationClass = class_getSuperclass(destinationClass);
+            continue;
+        }
+        id route = _ZIKRegistryLookupValue(self, destinationToDefaultRouterMap, (__bridge const void *)(destinationClass));
+        if (route == nil && _lazyRegistrations && [self registerLazyRoutersForName:NSStringFromClass(destinationClass) kind:ZIKRouteTableDestinationsKey]) {
+            route = _ZIKRegistryLookupValue(self, destinationToDefaultRouterMap, (__bridge const void *)(destinationClass));
+        }
+        if (route == nil) {
+            route = _ZIKRegistryLookupValue(self, destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass));
+            // After registration is finished, other threads may be reading the map, resolved route is cached in destinationToResolvedRouteMap instead
+            if (route && !_registrationFinished) {
+                CFDictionarySetValue(self.destinationToDefaultRouterMap, (__bridge const void *)(destinationClass), (__bridge const void *)(route));
+            }
+        }
+        if (route == nil) {
+            route = [self easyRouteForDestinationClass:destinationClass];
+        }
+        if (route) {
+            return route;
+        }
+        if (destinationClass == rootClass) {
+            break;
+        }
+        destinationClass = class_getSuperclass(destinationClass);
+    }
+    return nil;
+}
+
++ (nullable id)_routeForDestinationAdapter:(Protocol *)destinationProtocol {
+    if (!_registrationFinished) {
+        return [self _resolveRouteForDestinationAdapter:destinationProtocol];
+    }
+    CFMutableDictionaryRef adapterToRouteMap = self.destinationAdapterToRouteMap;
+    dispatch_semaphore_wait(_resolvedRoutesSema, DISPATCH_TIME_FOREVER);
+    id route = CFDictionaryGetValue(adapterToRouteMap, (__bridge const void *)(destinationProtocol));
+    dispatch_semaphore_signal(_resolvedRoutesSema);
+    if (route) {
+        zix_incrementRouterCounter(ZIKRouterCounterResolvedRouteCacheHit);
+        return route == (id)kCFNull ? nil : route;
+    }
+    zix_incrementRouterCounter(ZIKRouterCounterResolvedRouteCacheMiss);
+    route = [self _resolveRouteForDestinationAdapter:destinationProtocol];
+    dispatch_semaphore_wait(_resolvedRoutesSema, DISPATCH_TIME_FOREVER);
+    CFDictionarySetValue(adapterToRouteMap, (__bridge const void *)(destinationProtocol), route ? (__bridge const void *)(route) : kCFNull);
+    dispatch_semaphore_signal(_resolvedRoutesSema);
+    return route;
+}
+
++ (nullable id)_resolveRouteForDestinationAdapter:(Protocol *)destinationProtocol {
+    id route = nil;
+    if ([self respondsToSelector:@selector(_swiftRouteForDestinationAdapter:)]) {
+        route = [self _swiftRouteForDestinationAdapter:destinationProtocol];
     }
     if (route == nil) {
         Protocol *adapter = destinationProtocol;
         Protocol *adaptee = nil;
 #if ZIKROUTER_CHECK
         NSMutableArray<Protocol *> *traversedProtocols = [NSMutableArray array];
+        NSMutableSet<Protocol *> *traversedProtocolSet = [NSMutableSet set];
 #endif
         do {
-            adaptee = CFDictionaryGetValue(self.adapterToAdapteeMap, (__bridge const void *)(adapter));
+            adaptee = _ZIKRegistryLookupValue(self, adapterToAdapteeMap, (__bridge const void *)(adapter));
             if (adaptee == nil) {
                 break;
             }
+            zix_incrementRouterCounter(ZIKRouterCounterAdapterHop);
 #if ZIKROUTER_CHECK
             [traversedProtocols addObject:adapter];
-            if ([traversedProtocols containsObject:adaptee]) {
+            [traversedProtocolSet addObject:adapter];
+            if ([traversedProtocolSet containsObject:adaptee]) {
                 NSMutableString *adapterChain = [NSMutableString string];
                 [traversedProtocols enumerateObjectsUsingBlock:^(Protocol * _Nonnull obj, NSUInteger idx, BOOL * _Nonnull stop) {
                     [adapterChain appendFormat:@"%@ -> ", NSStringFromProtocol(obj)];
@@ -362,9 +2197,17 @@ static CFMutableSetRef _factoryBlocks;
                 break;
             }
 #endif
-            route = CFDictionaryGetValue(self.destinationProtocolToRouterMap, (__bridge const void *)(adaptee));
-            if (route == nil) {
-                route = [self easyRouteForDestinationProtocol:adaptee];
+            const ZIKRouteIndexEntry *entry = NULL;
+            if (_lookupRouteIndex(self, (__bridge const void *)(adaptee), ZIKRouteIndexKindDestinationProtocol, &entry)) {
+                route = entry ? (__bridge id)(entry->route) : nil;
+            } else {
+                route = _ZIKRegistryLookupValue(self, destinationProtocolToRouterMap, (__bridge const void *)(adaptee));
+                if (route == nil && _lazyRegistrations && [self registerLazyRoutersForName:NSStringFromProtocol(adaptee) kind:ZIKRouteTableDestinationProtocolsKey]) {
+                    route = _ZIKRegistryLookupValue(self, destinationProtocolToRouterMap, (__bridge const void *)(adaptee));
+                }
+                if (route == nil) {
+                    route = [self easyRouteForDestinationProtocol:adaptee];
+                }
             }
             if (route == nil && [self respondsToSelector:@selector(_swiftRouteForDestinationAdapter:)]) {
                 route = [self _swiftRouteForDestinationAdapter:adaptee];
@@ -372,21 +2215,32 @@ static CFMutableSetRef _factoryBlocks;
             adapter = adaptee;
         } while (route == nil);
     }
-    return [self _routerTypeForObject:route];
+    return route;
 }
 
-+ (nullable ZIKRouterType *)routerToModule:(Protocol *)configProtocol {
-    NSParameterAssert(configProtocol);
-    NSAssert(self.moduleConfigProtocolToRouterMap != nil, @"Didn't register any protocol yet.");
-    if (!configProtocol) {
-        NSAssert1(NO, @"+routerToModule: module configProtocol is nil. callStackSymbols: %@",[NSThread callStackSymbols]);
-        return nil;
++ (nullable id)_routeForModuleAdapter:(Protocol *)configProtocol {
+    if (!_registrationFinished) {
+        return [self _resolveRouteForModuleAdapter:configProtocol];
     }
-    id route = CFDictionaryGetValue(self.moduleConfigProtocolToRouterMap, (__bridge const void *)(configProtocol));
-    if (route == nil) {
-        route = [self easyRouteForModuleProtocol:configProtocol];
+    CFMutableDictionaryRef adapterToRouteMap = self.moduleAdapterToRouteMap;
+    dispatch_semaphore_wait(_resolvedRoutesSema, DISPATCH_TIME_FOREVER);
+    id route = CFDictionaryGetValue(adapterToRouteMap, (__bridge const void *)(configProtocol));
+    dispatch_semaphore_signal(_resolvedRoutesSema);
+    if (route) {
+        zix_incrementRouterCounter(ZIKRouterCounterResolvedRouteCacheHit);
+        return route == (id)kCFNull ? nil : route;
     }
-    if (route == nil && [self respondsToSelector:@selector(_swiftRouteForDestinationAdapter:)]) {
+    zix_incrementRouterCounter(ZIKRouterCounterResolvedRouteCacheMiss);
+    route = [self _resolveRouteForModuleAdapter:configProtocol];
+    dispatch_semaphore_wait(_resolvedRoutesSema, DISPATCH_TIME_FOREVER);
+    CFDictionarySetValue(adapterToRouteMap, (__bridge const void *)(configProtocol), route ? (__bridge const void *)(route) : kCFNull);
+    dispatch_semaphore_signal(_resolvedRoutesSema);
+    return route;
+}
+
++ (nullable id)_resolveRouteForModuleAdapter:(Protocol *)configProtocol {
+    id route = nil;
+    if ([self respondsToSelector:@selector(_swiftRouteForDestinationAdapter:)]) {
         route = [self _swiftRouteForModuleAdapter:configProtocol];
     }
     if (route == nil) {
@@ -394,15 +2248,18 @@ static CFMutableSetRef _factoryBlocks;
         Protocol *adaptee = nil;
 #if ZIKROUTER_CHECK
         NSMutableArray<Protocol *> *traversedProtocols = [NSMutableArray array];
+        NSMutableSet<Protocol *> *traversedProtocolSet = [NSMutableSet set];
 #endif
         do {
-            adaptee = CFDictionaryGetValue(self.adapterToAdapteeMap, (__bridge const void *)(adapter));
+            adaptee = _ZIKRegistryLookupValue(self, adapterToAdapteeMap, (__bridge const void *)(adapter));
             if (adaptee == nil) {
                 break;
             }
+            zix_incrementRouterCounter(ZIKRouterCounterAdapterHop);
 #if ZIKROUTER_CHECK
             [traversedProtocols addObject:adapter];
-            if ([traversedProtocols containsObject:adaptee]) {
+            [traversedProtocolSet addObject:adapter];
+            if ([traversedProtocolSet containsObject:adaptee]) {
                 NSMutableString *adapterChain = [NSMutableString string];
                 [traversedProtocols enumerateObjectsUsingBlock:^(Protocol * _Nonnull obj, NSUInteger idx, BOOL * _Nonnull stop) {
                     [adapterChain appendFormat:@"%@ -> ", NSStringFromProtocol(obj)];
@@ -412,9 +2269,17 @@ static CFMutableSetRef _factoryBlocks;
                 break;
             }
 #endif
-            route = CFDictionaryGetValue(self.moduleConfigProtocolToRouterMap, (__bridge const void *)(adaptee));
-            if (route == nil) {
-                route = [self easyRouteForModuleProtocol:adaptee];
+            const ZIKRouteIndexEntry *entry = NULL;
+            if (_lookupRouteIndex(self, (__bridge const void *)(adaptee), ZIKRouteIndexKindModuleProtocol, &entry)) {
+                route = entry ? (__bridge id)(entry->route) : nil;
+            } else {
+                route = _ZIKRegistryLookupValue(self, moduleConfigProtocolToRouterMap, (__bridge const void *)(adaptee));
+                if (route == nil && _lazyRegistrations && [self registerLazyRoutersForName:NSStringFromProtocol(adaptee) kind:ZIKRouteTableModuleProtocolsKey]) {
+                    route = _ZIKRegistryLookupValue(self, moduleConfigProtocolToRouterMap, (__bridge const void *)(adaptee));
+                }
+                if (route == nil) {
+                    route = [self easyRouteForModuleProtocol:adaptee];
+                }
             }
             if (route == nil && [self respondsToSelector:@selector(_swiftRouteForDestinationAdapter:)]) {
                 route = [self _swiftRouteForModuleAdapter:adaptee];
@@ -422,62 +2287,839 @@ static CFMutableSetRef _factoryBlocks;
             adapter = adaptee;
         } while (route == nil);
     }
-    return [self _routerTypeForObject:route];
+    return route;
+}
+
++ (void)invalidateResolvedRoutes {
+    if (self == [ZIKRouteRegistry class]) {
+        for (Class registry in _registries) {
+            [registry invalidateResolvedRoutes];
+        }
+        return;
+    }
+    dispatch_semaphore_wait(_resolvedRoutesSema, DISPATCH_TIME_FOREVER);
+    CFDictionaryRemoveAllValues(self.destinationToResolvedRouteMap);
+    CFDictionaryRemoveAllValues(self.destinationAdapterToRouteMap);
+    CFDictionaryRemoveAllValues(self.moduleAdapterToRouteMap);
+    dispatch_semaphore_signal(_resolvedRoutesSema);
+    __atomic_fetch_add(&_routesGeneration, 1, __ATOMIC_RELEASE);
+}
+
+static void _recordLookup(Class registry, ZIKRouterType *_Nullable routerType, uint64_t startTime) {
+    zix_incrementRouterCounter([registry lookupCounter]);
+    if (routerType == nil) {
+        zix_incrementRouterCounter([registry lookupMissCounter]);
+    }
+    zix_recordRouterTiming(ZIKRouterTimingLookup, startTime);
+}
+
+static const char *_Nullable _lookupSignpostDetail(ZIKRouterType *_Nullable routerType) {
+    if (routerType == nil) {
+        return "not found";
+    }
+    if (routerType.routerClass) {
+        return class_getName(routerType.routerClass);
+    }
+    return [routerType.route description].UTF8String;
+}
+
++ (nullable ZIKRouterType *)routerToDestination:(Protocol *)destinationProtocol {
+    uint64_t startTime = zix_routeMetricsTime();
+    uint64_t signpost = zix_beginRouteSignpost(ZIKRouteSignpostStageLookup, destinationProtocol ? protocol_getName(destinationProtocol) : "nil");
+    _beginSnapshotReading();
+    ZIKRouterType *routerType = [self _routerToDestination:destinationProtocol];
+    _endSnapshotReading();
+    zix_endRouteSignpost(ZIKRouteSignpostStageLookup, signpost, signpost ? _lookupSignpostDetail(routerType) : NULL);
+    _recordLookup(self, routerType, startTime);
+    return routerType;
+}
+
++ (nullable ZIKRouterType *)routerToModule:(Protocol *)configProtocol {
+    uint64_t startTime = zix_routeMetricsTime();
+    uint64_t signpost = zix_beginRouteSignpost(ZIKRouteSignpostStageLookup, configProtocol ? protocol_getName(configProtocol) : "nil");
+    _beginSnapshotReading();
+    ZIKRouterType *routerType = [self _routerToModule:configProtocol];
+    _endSnapshotReading();
+    zix_endRouteSignpost(ZIKRouteSignpostStageLookup, signpost, signpost ? _lookupSignpostDetail(routerType) : NULL);
+    _recordLookup(self, routerType, startTime);
+    return routerType;
+}
+
++ (nullable ZIKRouterType *)routerToIdentifier:(NSString *)identifier {
+    uint64_t startTime = zix_routeMetricsTime();
+    uint64_t signpost = zix_beginRouteSignpost(ZIKRouteSignpostStageLookup, identifier ? identifier.UTF8String : "nil");
+    ZIKRouterType *routerType = [self _routerToIdentifier:identifier];
+    zix_endRouteSignpost(ZIKRouteSignpostStageLookup, signpost, signpost ? _lookupSignpostDetail(routerType) : NULL);
+    _recordLookup(self, routerType, startTime);
+    return routerType;
+}
+
++ (nullable ZIKRouterType *)_routerToDestination:(Protocol *)destinationProtocol {
+    NSParameterAssert(destinationProtocol);
+    NSAssert(self.destinationProtocolToRouterMap != nil, @"Didn't register any protocol yet.");
+    if (!destinationProtocol) {
+        NSAssert1(NO, @"+routerToDestination: destinationProtocol is nil. callStackSymbols: %@",[NSThread callStackSymbols]);
+        return nil;
+    }
+    ZIKRouterType *launchRouterType = _launchRouterType(self, (__bridge const void *)(destinationProtocol), ZIKRouteIndexKindDestinationProtocol);
+    if (launchRouterType) {
+        return launchRouterType;
+    }
+    _waitForBackgroundRegistration();
+    const ZIKRouteIndexEntry *entry = NULL;
+    if (_lookupRouteIndex(self, (__bridge const void *)(destinationProtocol), ZIKRouteIndexKindDestinationProtocol, &entry)) {
+        if (entry) {
+            return _routerTypeOfIndexEntry(self, entry);
+        }
+        return [self _routerTypeForObject:[self _routeForDestinationAdapter:destinationProtocol]];
+    }
+    id route = _ZIKRegistryLookupValue(self, destinationProtocolToRouterMap, (__bridge const void *)(destinationProtocol));
+    if (route == nil && _lazyRegistrations && [self registerLazyRoutersForName:NSStringFromProtocol(destinationProtocol) kind:ZIKRouteTableDestinationProtocolsKey]) {
+        route = _ZIKRegistryLookupValue(self, destinationProtocolToRouterMap, (__bridge const void *)(destinationProtocol));
+    }
+    if (route == nil) {
+        route = [self easyRouteForDestinationProtocol:destinationProtocol];
+    }
+    if (route == nil) {
+        route = [self _routeForDestinationAdapter:destinationProtocol];
+    }
+    return [self _routerTypeForObject:route];
+}
+
++ (nullable ZIKRouterType *)_routerToModule:(Protocol *)configProtocol {
+    NSParameterAssert(configProtocol);
+    NSAssert(self.moduleConfigProtocolToRouterMap != nil, @"Didn't register any protocol yet.");
+    if (!configProtocol) {
+        NSAssert1(NO, @"+routerToModule: module configProtocol is nil. callStackSymbols: %@",[NSThread callStackSymbols]);
+        return nil;
+    }
+    ZIKRouterType *launchRouterType = _launchRouterType(self, (__bridge const void *)(configProtocol), ZIKRouteIndexKindModuleProtocol);
+    if (launchRouterType) {
+        return launchRouterType;
+    }
+    _waitForBackgroundRegistration();
+    const ZIKRouteIndexEntry *entry = NULL;
+    if (_lookupRouteIndex(self, (__bridge const void *)(configProtocol), ZIKRouteIndexKindModuleProtocol, &entry)) {
+        if (entry) {
+            return _routerTypeOfIndexEntry(self, entry);
+        }
+        return [self _routerTypeForObject:[self _routeForModuleAdapter:configProtocol]];
+    }
+    id route = _ZIKRegistryLookupValue(self, moduleConfigProtocolToRouterMap, (__bridge const void *)(configProtocol));
+    if (route == nil && _lazyRegistrations && [self registerLazyRoutersForName:NSStringFromProtocol(configProtocol) kind:ZIKRouteTableModuleProtocolsKey]) {
+        route = _ZIKRegistryLookupValue(self, moduleConfigProtocolToRouterMap, (__bridge const void *)(configProtocol));
+    }
+    if (route == nil) {
+        route = [self easyRouteForModuleProtocol:configProtocol];
+    }
+    if (route == nil) {
+        route = [self _routeForModuleAdapter:configProtocol];
+    }
+    return [self _routerTypeForObject:route];
+}
+
++ (nullable ZIKRouterType *)routerToIdentifierHandle:(ZIKRouteIdentifierHandle)handle {
+    uint64_t startTime = zix_routeMetricsTime();
+    uint64_t signpost = zix_beginRouteSignpost(ZIKRouteSignpostStageLookup, "identifier handle");
+    _beginSnapshotReading();
+    ZIKRouterType *routerType = [self _routerToIdentifierHandle:handle];
+    _endSnapshotReading();
+    zix_endRouteSignpost(ZIKRouteSignpostStageLookup, signpost, signpost ? _lookupSignpostDetail(routerType) : NULL);
+    _recordLookup(self, routerType, startTime);
+    return routerType;
+}
+
++ (nullable ZIKRouterType *)_routerToIdentifierHandle:(ZIKRouteIdentifierHandle)handle {
+    if (handle == 0) {
+        return nil;
+    }
+    ZIKRouterType *launchRouterType = _launchRouterTypeForIdentifierHandle(self, handle);
+    if (launchRouterType) {
+        return launchRouterType;
+    }
+    _waitForBackgroundRegistration();
+    ZIKRouteRegistrySnapshot *snapshot = _snapshotOfRegistry(self);
+    if (snapshot && handle < snapshot->identifierRouteCount) {
+        ZIKIdentifierRoute identifierRoute = snapshot->identifierRoutes[handle];
+        if (identifierRoute.routerType) {
+            return (__bridge ZIKRouterType *)identifierRoute.routerType;
+        }
+        if (identifierRoute.route) {
+            return [self _routerTypeForObject:(__bridge id)identifierRoute.route];
+        }
+        if (_lazyRegistrations == nil) {
+            return nil;
+        }
+    }
+    // Snapshot is not published yet, handle is interned after publishing, or identifier may still be registered lazily
+    return [self _routerToIdentifier:zix_routeIdentifierOfHandle(handle)];
+}
+
++ (nullable ZIKRouterType *)_routerToIdentifier:(NSString *)identifier {
+    if (identifier == nil) {
+        return nil;
+    }
+    if (_launchSnapshots) {
+        ZIKRouterType *launchRouterType = _launchRouterTypeForIdentifierHandle(self, _internedHandleOfIdentifier(identifier));
+        if (launchRouterType) {
+            return launchRouterType;
+        }
+    }
+    _waitForBackgroundRegistration();
+    id route = _ZIKRegistryLookupValue(self, identifierToRouterMap, (CFStringRef)identifier);
+    if (route == nil && _lazyRegistrations && [self registerLazyRoutersForName:identifier kind:ZIKRouteTableIdentifiersKey]) {
+        route = _ZIKRegistryLookupValue(self, identifierToRouterMap, (CFStringRef)identifier);
+    }
+    if (route == nil) {
+        route = [self easyRouteForIdentifier:identifier];
+    }
+    return [self _routerTypeForObject:route];
+}
+
++ (void)enumerateRoutersForDestinationClass:(Class)destinationClass handler:(void(^)(ZIKRouterType * route))handler {
+    NSAssert([self isDestinationClassRoutable:destinationClass], @"destination class (%@) should conforms to ZIKRoutableView or ZIKRoutableService.", NSStringFromClass(destinationClass));
+    NSParameterAssert(handler);
+    if (!destinationClass) {
+        return;
+    }
+    _waitForBackgroundRegistration();
+    Class rootClass = [self routableRootClassOfDestinationClass:destinationClass];
+    if (rootClass == nil) {
+        return;
+    }
+    while (destinationClass) {
+        [self registerLazyRoutersForDestinationClass:destinationClass];
+        id route = _ZIKRegistryLookupValue(self, destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass));
+        if (route) {
+            ZIKRouterType *r = [self _routerTypeForObject:route];
+            if (r) {
+                handler(r);
+            }
+        } else {
+            // Set in registry's map is mutable, copy it before other late registrations change it
+            pthread_mutex_lock(&_lateRegistrationLock);
+            NSSet *routes = [_ZIKRegistryLookupValue(self, destinationToRoutersMap, (__bridge const void *)(destinationClass)) copy];
+            pthread_mutex_unlock(&_lateRegistrationLock);
+            [routes enumerateObjectsUsingBlock:^(id  _Nonnull route, BOOL * _Nonnull stop) {
+                if (handler) {
+                    ZIKRouterType *r = [self _routerTypeForObject:route];
+                    if (r) {
+                        handler(r);
+                    }
+                }
+            }];
+        }
+        
+        if (destinationClass == rootClass) {
+            break;
+        }
+        destinationClass = class_getSuperclass(destinationClass);
+    }
+}
+
+#pragma mark Snapshot
+
+static ZIKRouteRegistrySnapshot *_Nullable _publishOutdatedSnapshot(Class registry) {
+    pthread_mutex_lock(&_lateRegistrationLock);
+    ZIKRouteRegistrySnapshot *snapshot = __atomic_load_n((ZIKRouteRegistrySnapshot **)[registry snapshotStorage], __ATOMIC_ACQUIRE);
+    // When a batch of late registrations is in progress, the batch publishes at its end
+    if (snapshot && snapshot->outdated && _snapshotPublishingSuspended == 0) {
+        [registry publishSnapshot];
+        snapshot = __atomic_load_n((ZIKRouteRegistrySnapshot **)[registry snapshotStorage], __ATOMIC_ACQUIRE);
+    }
+    pthread_mutex_unlock(&_lateRegistrationLock);
+    return snapshot;
+}
+
+/// Current snapshot of registry. Call it in snapshot reading, it may publish a new snapshot for late registrations.
+static ZIKRouteRegistrySnapshot *_Nullable _snapshotOfRegistry(Class registry) {
+    ZIKRouteRegistrySnapshot *snapshot = __atomic_load_n((ZIKRouteRegistrySnapshot **)[registry snapshotStorage], __ATOMIC_ACQUIRE);
+    if (snapshot && __atomic_load_n(&snapshot->outdated, __ATOMIC_ACQUIRE)) {
+        snapshot = _publishOutdatedSnapshot(registry);
+    }
+    return snapshot;
+}
+
+static void _releaseSnapshotMap(CFDictionaryRef _Nullable map) {
+    if (map) {
+        CFRelease(map);
+    }
+}
+
+static void _freeSnapshot(ZIKRouteRegistrySnapshot *snapshot) {
+    zix_freeRouteIndex(snapshot->routeIndex);
+    free(snapshot->identifierRoutes);
+    // Maps only exist in frozen snapshots
+    _releaseSnapshotMap(snapshot->destinationProtocolToRouterMap);
+    _releaseSnapshotMap(snapshot->moduleConfigProtocolToRouterMap);
+    _releaseSnapshotMap(snapshot->destinationToRoutersMap);
+    _releaseSnapshotMap(snapshot->destinationToDefaultRouterMap);
+    _releaseSnapshotMap(snapshot->destinationToExclusiveRouterMap);
+    _releaseSnapshotMap(snapshot->identifierToRouterMap);
+    _releaseSnapshotMap(snapshot->routeToRouterTypeMap);
+    _releaseSnapshotMap(snapshot->adapterToAdapteeMap);
+    _releaseSnapshotMap(snapshot->destinationToEasyRouteMap);
+    _releaseSnapshotMap(snapshot->destinationProtocolToEasyRouteMap);
+    _releaseSnapshotMap(snapshot->moduleConfigProtocolToEasyRouteMap);
+    _releaseSnapshotMap(snapshot->identifierToEasyRouteMap);
+    if (snapshot->unregisteredObjects) {
+        CFRelease(snapshot->unregisteredObjects);
+    }
+    free(snapshot);
+}
+
+/// Free replaced snapshots when no lookup is reading. A reader loading a replaced snapshot must have entered reading before the snapshot was replaced, so it's still counted here.
+static void _freeRetiredSnapshots(void) {
+    pthread_mutex_lock(&_retiredSnapshotsLock);
+    ZIKRouteRegistrySnapshot *snapshot = NULL;
+    ZIKRetiredObject *object = NULL;
+    if (__atomic_load_n(&_snapshotReaders, __ATOMIC_SEQ_CST) == 0) {
+        snapshot = _retiredSnapshots;
+        object = _retiredObjects;
+        __atomic_store_n(&_retiredSnapshots, NULL, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&_retiredObjects, NULL, __ATOMIC_SEQ_CST);
+    }
+    pthread_mutex_unlock(&_retiredSnapshotsLock);
+    while (snapshot) {
+        ZIKRouteRegistrySnapshot *next = snapshot->nextRetired;
+        _freeSnapshot(snapshot);
+        snapshot = next;
+    }
+    while (object) {
+        ZIKRetiredObject *next = object->next;
+        object->free(object->object);
+        free(object);
+        object = next;
+    }
+}
+
+static void _retireSnapshot(ZIKRouteRegistrySnapshot *snapshot) {
+    pthread_mutex_lock(&_retiredSnapshotsLock);
+    snapshot->nextRetired = _retiredSnapshots;
+    __atomic_store_n(&_retiredSnapshots, snapshot, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&_retiredSnapshotsLock);
+    _freeRetiredSnapshots();
+}
+
+/// Enter before loading snapshot in lookup, and leave after the last access to its route index and identifier routes. Can be nested.
+static inline void _beginSnapshotReading(void) {
+    __atomic_fetch_add(&_snapshotReaders, 1, __ATOMIC_SEQ_CST);
+}
+
+static inline void _endSnapshotReading(void) {
+    if (__atomic_sub_fetch(&_snapshotReaders, 1, __ATOMIC_SEQ_CST) == 0 &&
+        (__atomic_load_n(&_retiredSnapshots, __ATOMIC_SEQ_CST) || __atomic_load_n(&_retiredObjects, __ATOMIC_SEQ_CST))) {
+        _freeRetiredSnapshots();
+    }
+}
+
+void zix_beginSnapshotReading(void) {
+    _beginSnapshotReading();
+}
+
+void zix_endSnapshotReading(void) {
+    _endSnapshotReading();
+}
+
+void zix_retireSnapshot(void *snapshot, void (*freeSnapshot)(void *snapshot)) {
+    ZIKRetiredObject *object = malloc(sizeof(ZIKRetiredObject));
+    if (object == NULL) {
+        // Leak it rather than freeing it under readers
+        return;
+    }
+    object->object = snapshot;
+    object->free = freeSnapshot;
+    pthread_mutex_lock(&_retiredSnapshotsLock);
+    object->next = _retiredObjects;
+    __atomic_store_n(&_retiredObjects, object, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&_retiredSnapshotsLock);
+    _freeRetiredSnapshots();
+}
+
+/// Find route of the key in route index. Return false when route index is not published yet, or the key may still be registered lazily, then caller should look up in maps.
+static bool _lookupRouteIndex(Class registry, const void *key, ZIKRouteIndexKind kind, const ZIKRouteIndexEntry *_Nullable *_Nonnull entry) {
+    ZIKRouteRegistrySnapshot *snapshot = _snapshotOfRegistry(registry);
+    if (snapshot == NULL) {
+        return false;
+    }
+    *entry = zix_routeIndexGetEntry(snapshot->routeIndex, key, kind);
+    return *entry != NULL || _lazyRegistrations == nil;
+}
+
+static ZIKRouterType *_Nullable _routerTypeOfIndexEntry(Class registry, const ZIKRouteIndexEntry *entry) {
+    if (entry->routerType) {
+        return (__bridge ZIKRouterType *)(entry->routerType);
+    }
+    return [registry _routerTypeForObject:(__bridge id)(entry->route)];
+}
+
+static void _didChangeRegistryAfterFinished(Class registry) {
+    pthread_mutex_lock(&_lateRegistrationLock);
+    if (_snapshotPublishingSuspended == 0) {
+        ZIKRouteRegistrySnapshot *snapshot = __atomic_load_n((ZIKRouteRegistrySnapshot **)[registry snapshotStorage], __ATOMIC_ACQUIRE);
+        if (snapshot) {
+            // Publish at next lookup instead of rebuilding index for every late registration
+            __atomic_store_n(&snapshot->outdated, true, __ATOMIC_RELEASE);
+        } else {
+            [registry publishSnapshot];
+        }
+    }
+    pthread_mutex_unlock(&_lateRegistrationLock);
+    // Clear after marking, so caches won't be filled from previous snapshot
+    [registry invalidateResolvedRoutes];
+}
+
+typedef struct ZIKRouteIndexingContext {
+    ZIKRouteIndex *index;
+    ZIKRouteIndexKind kind;
+    ZIKRouteIndexFlags flags;
+    CFDictionaryRef routeToRouterTypeMap;
+    CFDictionaryRef _Nullable destinationMap;
+    CFDictionaryRef _Nullable factoryMap;
+    CFDictionaryRef _Nullable configFactoryMap;
+} ZIKRouteIndexingContext;
+
+static void _indexRoute(const void *key, const void *route, void *context) {
+    ZIKRouteIndexingContext *indexing = context;
+    ZIKRouteIndexEntry entry = {
+        .key = key,
+        .kind = indexing->kind,
+        .flags = indexing->flags,
+        .route = route,
+        .routerType = CFDictionaryGetValue(indexing->routeToRouterTypeMap, route),
+        .destinationClass = indexing->destinationMap ? (__bridge Class)CFDictionaryGetValue(indexing->destinationMap, key) : (__bridge Class)key,
+        .factory = indexing->factoryMap ? CFDictionaryGetValue(indexing->factoryMap, key) : NULL,
+        .configFactory = indexing->configFactoryMap ? CFDictionaryGetValue(indexing->configFactoryMap, key) : NULL
+    };
+    zix_routeIndexAddEntry(indexing->index, &entry);
+}
+
+/// Add routes in map to index. Keys already in index are skipped, so maps indexed first take priority. Map is enumerated in place, so indexing doesn't allocate and can't fail halfway.
+static void _indexRoutesInMap(ZIKRouteIndex *index, CFDictionaryRef routeMap, ZIKRouteIndexKind kind, ZIKRouteIndexFlags flags, CFDictionaryRef routeToRouterTypeMap, CFDictionaryRef _Nullable destinationMap, CFDictionaryRef _Nullable factoryMap, CFDictionaryRef _Nullable configFactoryMap) {
+    ZIKRouteIndexingContext context = {
+        .index = index,
+        .kind = kind,
+        .flags = flags,
+        .routeToRouterTypeMap = routeToRouterTypeMap,
+        .destinationMap = destinationMap,
+        .factoryMap = factoryMap,
+        .configFactoryMap = configFactoryMap
+    };
+    CFDictionaryApplyFunction(routeMap, _indexRoute, &context);
+}
+
+/// Fill routes of identifiers in the map into slots of their handles. Slots already filled are kept.
+static void _indexIdentifierRoutesInMap(ZIKIdentifierRoute *identifierRoutes, ZIKRouteIdentifierHandle count, CFDictionaryRef routeMap, CFDictionaryRef routeToRouterTypeMap) {
+    [(__bridge NSDictionary *)routeMap enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull identifier, id _Nonnull route, BOOL * _Nonnull stop) {
+        ZIKRouteIdentifierHandle handle = zix_internRouteIdentifier(identifier);
+        if (handle < count && identifierRoutes[handle].route == NULL) {
+            identifierRoutes[handle].route = (__bridge const void *)route;
+            identifierRoutes[handle].routerType = CFDictionaryGetValue(routeToRouterTypeMap, (__bridge const void *)route);
+        }
+    }];
+}
+
+/**
+ Resolve every adapter -> adaptee chain to its final adaptee, and add the adapter to index with the entry of the final adaptee, so lookup of adapter doesn't walk the chain. Each adapter is visited once.
+ 
+ Adaptees are resolved in the same order as `+_resolveRouteForDestinationAdapter:`, the first adaptee with an entry is the final one. Adapters in a cycle or leading to a cycle get an entry without route. Chains ending without an entry are not added, they may end in adaptees registered in Swift, and are still resolved by walking the chain.
+ */
+static void _indexAdaptersInMap(ZIKRouteIndex *index, CFDictionaryRef adapterToAdapteeMap, ZIKRouteIndexKind kind) {
+    CFIndex count = CFDictionaryGetCount(adapterToAdapteeMap);
+    if (count == 0) {
+        return;
+    }
+    const void **adapters = malloc(sizeof(void *) * count);
+    if (adapters == NULL) {
+        // Adapters not in index are still resolved by walking the chain
+        return;
+    }
+    CFDictionaryGetKeysAndValues(adapterToAdapteeMap, adapters, NULL);
+    // value: final adaptee, kCFNull for chain without entry, kCFBooleanFalse for chain with cycle
+    CFMutableDictionaryRef adapterToTargetMap = CFDictionaryCreateMutable(kCFAllocatorDefault, count, NULL, NULL);
+    CFMutableSetRef traversedAdapters = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+    CFMutableArrayRef chain = CFArrayCreateMutable(kCFAllocatorDefault, 0, NULL);
+    for (CFIndex i = 0; i < count; i++) {
+        const void *adapter = adapters[i];
+        const void *target = NULL;
+        while (true) {
+            target = CFDictionaryGetValue(adapterToTargetMap, adapter);
+            if (target) {
+                break;
+            }
+            if (CFSetContainsValue(traversedAdapters, adapter)) {
+#if ZIKROUTER_CHECK
+                NSMutableString *adapterChain = [NSMutableString string];
+                for (CFIndex idx = CFArrayGetFirstIndexOfValue(chain, CFRangeMake(0, CFArrayGetCount(chain)), adapter); idx < CFArrayGetCount(chain); idx++) {
+                    [adapterChain appendFormat:@"%@ -> ", NSStringFromProtocol((__bridge Protocol *)CFArrayGetValueAtIndex(chain, idx))];
+                }
+                [adapterChain appendFormat:@"%@", NSStringFromProtocol((__bridge Protocol *)adapter)];
+                if (kind == ZIKRouteIndexKindDestinationProtocol) {
+                    NSCAssert(NO, @"Dead cycle in destination adapter -> adaptee chain: %@. Check your +registerDestinationAdapter:forAdaptee:.",adapterChain);
+                } else {
+                    NSCAssert(NO, @"Dead cycle in module adapter -> adaptee chain: %@. Check your +registerModuleAdapter:forAdaptee:.",adapterChain);
+                }
+#endif
+                target = kCFBooleanFalse;
+                break;
+            }
+            CFSetAddValue(traversedAdapters, adapter);
+            CFArrayAppendValue(chain, adapter);
+            const void *adaptee = CFDictionaryGetValue(adapterToAdapteeMap, adapter);
+            if (adaptee == NULL) {
+                target = kCFNull;
+                break;
+            }
+            if (zix_routeIndexGetEntry(index, adaptee, kind)) {
+                target = adaptee;
+                break;
+            }
+            adapter = adaptee;
+        }
+        for (CFIndex idx = 0; idx < CFArrayGetCount(chain); idx++) {
+            CFDictionarySetValue(adapterToTargetMap, CFArrayGetValueAtIndex(chain, idx), target);
+        }
+        CFSetRemoveAllValues(traversedAdapters);
+        CFArrayRemoveAllValues(chain);
+    }
+    for (CFIndex i = 0; i < count; i++) {
+        const void *target = CFDictionaryGetValue(adapterToTargetMap, adapters[i]);
+        if (target == kCFNull || zix_routeIndexGetEntry(index, adapters[i], kind)) {
+            continue;
+        }
+        ZIKRouteIndexEntry entry = {
+            .key = adapters[i],
+            .kind = kind,
+            .flags = ZIKRouteIndexFlagAdapter
+        };
+        if (target != kCFBooleanFalse) {
+            // Copy before adding, adding may move entries
+            entry = *zix_routeIndexGetEntry(index, target, kind);
+            entry.key = adapters[i];
+            entry.flags |= ZIKRouteIndexFlagAdapter;
+        }
+        zix_routeIndexAddEntry(index, &entry);
+    }
+    CFRelease(chain);
+    CFRelease(traversedAdapters);
+    CFRelease(adapterToTargetMap);
+    free(adapters);
+}
+
+#if ZIKROUTER_CHECK
+/// Check conflicts of exclusive routers with other registrations in one pass, instead of probing all maps in every registration.
+static void _checkExclusiveRoutes(Class registry) {
+    CFDictionaryRef destinationToDefaultRouterMap = [registry destinationToDefaultRouterMap];
+    CFDictionaryRef destinationToRoutersMap = [registry destinationToRoutersMap];
+    CFSetRef runtimeFactoryDestinationClasses = [registry runtimeFactoryDestinationClasses];
+    CFDictionaryRef destinationToDefaultFactoryMap = [registry destinationToDefaultFactoryMap];
+    NSMutableString *errorDescription = [NSMutableString string];
+    [(__bridge NSDictionary *)[registry destinationToExclusiveRouterMap] enumerateKeysAndObjectsUsingBlock:^(Class _Nonnull destinationClass, id _Nonnull route, BOOL * _Nonnull stop) {
+        const void *key = (__bridge const void *)(destinationClass);
+        // Resolved exclusive router is also saved as default router
+        id defaultRoute = CFDictionaryGetValue(destinationToDefaultRouterMap, key);
+        CFSetRef routers = CFDictionaryGetValue(destinationToRoutersMap, key);
+        if ((defaultRoute && defaultRoute != route) || (routers && CFSetGetCount(routers) > 0)) {
+            [errorDescription appendFormat:@"\n\n❌destinationClass (%@) already registered with another router (%@), check and remove them. You shall only use this exclusive router (%@) for this destinationClass.", NSStringFromClass(destinationClass), defaultRoute ?: [(__bridge NSSet *)routers anyObject], route];
+        }
+        if (CFSetContainsValue(runtimeFactoryDestinationClasses, key)) {
+            [errorDescription appendFormat:@"\n\n❌destinationClass (%@) already registered with `registerXXX:forMakingXXX:`, check and remove them. You shall only use this exclusive router (%@) for this destinationClass.", NSStringFromClass(destinationClass), route];
+        }
+        if (CFDictionaryGetValue(destinationToDefaultFactoryMap, key)) {
+            [errorDescription appendFormat:@"\n\n❌destinationClass (%@) already registered with `registerXXX:forMakingXXX:making:` or `registerXXX:forMakingXXX:factory:`, check and remove them. You shall only use this exclusive router (%@) for this destinationClass.", NSStringFromClass(destinationClass), route];
+        }
+    }];
+    if (errorDescription.length > 0) {
+        ZIX_LOG(Registry, Error, @"❌Found router registration errors:%@", errorDescription);
+        NSCAssert(NO, errorDescription);
+    }
+}
+#endif
+
++ (void)publishSnapshot {
+#if ZIKROUTER_CHECK
+    _checkExclusiveRoutes(self);
+#endif
+    ZIKRouteRegistrySnapshot *snapshot = [self _createSnapshotCopyingMaps:_freezesRegistration];
+    ZIKRouteRegistrySnapshot *previousSnapshot = __atomic_exchange_n((ZIKRouteRegistrySnapshot **)[self snapshotStorage], snapshot, __ATOMIC_ACQ_REL);
+    // Maps of frozen snapshots are also read in snapshot reading, so previous snapshot is retired in both modes
+    if (previousSnapshot) {
+        previousSnapshot->unregisteredObjects = _takeUnregisteredObjects(self);
+        // Other threads may still be looking up in previous snapshot
+        _retireSnapshot(previousSnapshot);
+    }
+}
+
+/// Index current routes of the registry. Maps are only copied into the snapshot when copiesMaps is YES.
++ (ZIKRouteRegistrySnapshot *)_createSnapshotCopyingMaps:(BOOL)copiesMaps {
+    ZIKRouteRegistrySnapshot *snapshot = calloc(1, sizeof(ZIKRouteRegistrySnapshot));
+    CFDictionaryRef routeToRouterTypeMap = self.routeToRouterTypeMap;
+    size_t count = CFDictionaryGetCount(self.destinationToDefaultRouterMap) + CFDictionaryGetCount(self.destinationToExclusiveRouterMap) + CFDictionaryGetCount(self.destinationToEasyRouteMap) +
+    CFDictionaryGetCount(self.destinationProtocolToRouterMap) + CFDictionaryGetCount(self.destinationProtocolToEasyRouteMap) +
+    CFDictionaryGetCount(self.moduleConfigProtocolToRouterMap) + CFDictionaryGetCount(self.moduleConfigProtocolToEasyRouteMap) +
+    // Adapter map is shared by destination adapters and module adapters
+    CFDictionaryGetCount(self.adapterToAdapteeMap) * 2;
+    ZIKRouteIndex *index = zix_createRouteIndex(count);
+    // Same priority as lookup in maps: registered router, exclusive router, then easy route
+    _indexRoutesInMap(index, self.destinationToDefaultRouterMap, ZIKRouteIndexKindDestinationClass, 0, routeToRouterTypeMap, NULL, self.destinationToDefaultFactoryMap, self.destinationToDefaultConfigFactoryMap);
+    _indexRoutesInMap(index, self.destinationToExclusiveRouterMap, ZIKRouteIndexKindDestinationClass, ZIKRouteIndexFlagExclusive, routeToRouterTypeMap, NULL, NULL, NULL);
+    _indexRoutesInMap(index, self.destinationToEasyRouteMap, ZIKRouteIndexKindDestinationClass, ZIKRouteIndexFlagEasyRoute, routeToRouterTypeMap, NULL, self.destinationToDefaultFactoryMap, self.destinationToDefaultConfigFactoryMap);
+    _indexRoutesInMap(index, self.destinationProtocolToRouterMap, ZIKRouteIndexKindDestinationProtocol, 0, routeToRouterTypeMap, self.destinationProtocolToDestinationMap, self.destinationProtocolToFactoryMap, NULL);
+    _indexRoutesInMap(index, self.destinationProtocolToEasyRouteMap, ZIKRouteIndexKindDestinationProtocol, ZIKRouteIndexFlagEasyRoute, routeToRouterTypeMap, self.destinationProtocolToDestinationMap, self.destinationProtocolToFactoryMap, NULL);
+    _indexRoutesInMap(index, self.moduleConfigProtocolToRouterMap, ZIKRouteIndexKindModuleProtocol, 0, routeToRouterTypeMap, self.moduleConfigProtocolToDestinationMap, NULL, self.moduleConfigProtocolToFactoryMap);
+    _indexRoutesInMap(index, self.moduleConfigProtocolToEasyRouteMap, ZIKRouteIndexKindModuleProtocol, ZIKRouteIndexFlagEasyRoute, routeToRouterTypeMap, self.moduleConfigProtocolToDestinationMap, NULL, self.moduleConfigProtocolToFactoryMap);
+    // Adaptees may still be registered lazily, then adapters are resolved by walking the chain
+    if (_lazyRegistrations == nil) {
+        _indexAdaptersInMap(index, self.adapterToAdapteeMap, ZIKRouteIndexKindDestinationProtocol);
+        _indexAdaptersInMap(index, self.adapterToAdapteeMap, ZIKRouteIndexKindModuleProtocol);
+    }
+    snapshot->routeIndex = index;
+    
+    CFDictionaryRef identifierToRouterMap = self.identifierToRouterMap;
+    CFDictionaryRef identifierToEasyRouteMap = self.identifierToEasyRouteMap;
+    if (CFDictionaryGetCount(identifierToRouterMap) + CFDictionaryGetCount(identifierToEasyRouteMap) > 0) {
+        // Easy routes are added without interning, intern them before counting, then all handles fit in the array
+        for (NSString *identifier in (__bridge NSDictionary *)identifierToEasyRouteMap) {
+            zix_internRouteIdentifier(identifier);
+        }
+        ZIKRouteIdentifierHandle count = _internedIdentifierCount() + 1;
+        snapshot->identifierRoutes = calloc(count, sizeof(ZIKIdentifierRoute));
+        snapshot->identifierRouteCount = count;
+        // Same priority as lookup in maps: registered router, then easy route
+        _indexIdentifierRoutesInMap(snapshot->identifierRoutes, count, identifierToRouterMap, routeToRouterTypeMap);
+        _indexIdentifierRoutesInMap(snapshot->identifierRoutes, count, identifierToEasyRouteMap, routeToRouterTypeMap);
+    }
+    
+    if (copiesMaps) {
+        snapshot->destinationProtocolToRouterMap = CFDictionaryCreateCopy(kCFAllocatorDefault, [self destinationProtocolToRouterMap]);
+        snapshot->moduleConfigProtocolToRouterMap = CFDictionaryCreateCopy(kCFAllocatorDefault, [self moduleConfigProtocolToRouterMap]);
+        snapshot->destinationToDefaultRouterMap = CFDictionaryCreateCopy(kCFAllocatorDefault, [self destinationToDefaultRouterMap]);
+        snapshot->destinationToExclusiveRouterMap = CFDictionaryCreateCopy(kCFAllocatorDefault, [self destinationToExclusiveRouterMap]);
+        snapshot->identifierToRouterMap = CFDictionaryCreateCopy(kCFAllocatorDefault, [self identifierToRouterMap]);
+        snapshot->routeToRouterTypeMap = CFDictionaryCreateCopy(kCFAllocatorDefault, [self routeToRouterTypeMap]);
+        snapshot->adapterToAdapteeMap = CFDictionaryCreateCopy(kCFAllocatorDefault, [self adapterToAdapteeMap]);
+        snapshot->destinationToEasyRouteMap = CFDictionaryCreateCopy(kCFAllocatorDefault, [self destinationToEasyRouteMap]);
+        snapshot->destinationProtocolToEasyRouteMap = CFDictionaryCreateCopy(kCFAllocatorDefault, [self destinationProtocolToEasyRouteMap]);
+        snapshot->moduleConfigProtocolToEasyRouteMap = CFDictionaryCreateCopy(kCFAllocatorDefault, [self moduleConfigProtocolToEasyRouteMap]);
+        snapshot->identifierToEasyRouteMap = CFDictionaryCreateCopy(kCFAllocatorDefault, [self identifierToEasyRouteMap]);
+        // Router sets are mutable, copy them too
+        CFDictionaryRef destinationToRoutersMap = self.destinationToRoutersMap;
+        CFMutableDictionaryRef routersMap = CFDictionaryCreateMutable(kCFAllocatorDefault, CFDictionaryGetCount(destinationToRoutersMap), NULL, &kCFTypeDictionaryValueCallBacks);
+        [(__bridge NSDictionary *)destinationToRoutersMap enumerateKeysAndObjectsUsingBlock:^(Class _Nonnull destinationClass, NSSet * _Nonnull routers, BOOL * _Nonnull stop) {
+            CFSetRef routersCopy = CFSetCreateCopy(kCFAllocatorDefault, (__bridge CFSetRef)routers);
+            CFDictionarySetValue(routersMap, (__bridge const void *)(destinationClass), routersCopy);
+            CFRelease(routersCopy);
+        }];
+        snapshot->destinationToRoutersMap = routersMap;
+    }
+    return snapshot;
 }
 
-+ (nullable ZIKRouterType *)routerToIdentifier:(NSString *)identifier {
-    if (identifier == nil) {
-        return nil;
+#pragma mark Memory Footprint
+
+void zix_compactRegistryContainer(CFTypeRef *container) {
+    CFTypeRef oldContainer = *container;
+    if (oldContainer == NULL) {
+        return;
     }
-    id route = CFDictionaryGetValue(self.identifierToRouterMap, (CFStringRef)identifier);
-    if (route == nil) {
-        route = [self easyRouteForIdentifier:identifier];
+    // Copies keep callbacks of the source, and only allocate storage for current values
+    CFTypeID typeID = CFGetTypeID(oldContainer);
+    CFTypeRef compacted = NULL;
+    if (typeID == CFDictionaryGetTypeID()) {
+        compacted = CFDictionaryCreateMutableCopy(kCFAllocatorDefault, 0, oldContainer);
+    } else if (typeID == CFSetGetTypeID()) {
+        compacted = CFSetCreateMutableCopy(kCFAllocatorDefault, 0, oldContainer);
+    } else if (typeID == CFArrayGetTypeID()) {
+        compacted = CFArrayCreateMutableCopy(kCFAllocatorDefault, 0, oldContainer);
+    }
+    if (compacted) {
+        *container = compacted;
+        CFRelease(oldContainer);
     }
-    return [self _routerTypeForObject:route];
 }
 
-+ (void)enumerateRoutersForDestinationClass:(Class)destinationClass handler:(void(^)(ZIKRouterType * route))handler {
-    NSAssert([self isDestinationClassRoutable:destinationClass], @"destination class (%@) should conforms to ZIKRoutableView or ZIKRoutableService.", NSStringFromClass(destinationClass));
-    NSParameterAssert(handler);
-    if (!destinationClass) {
-        return;
+/// Containers reported in +memoryFootprint, names of their class properties.
+static NSArray<NSString *> *_footprintContainerNames(void) {
+    static NSArray<NSString *> *names;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        names = @[@"destinationProtocolToRouterMap", @"moduleConfigProtocolToRouterMap", @"destinationToRoutersMap", @"destinationToDefaultRouterMap", @"destinationToExclusiveRouterMap", @"identifierToRouterMap", @"routeToRouterTypeMap", @"allRoutes", @"allRoutesSet",
+                  @"destinationProtocolToDestinationMap", @"moduleConfigProtocolToDestinationMap", @"identifierToDestinationMap", @"runtimeFactoryDestinationClasses",
+                  @"destinationProtocolToFactoryMap", @"identifierToFactoryMap", @"destinationToDefaultFactoryMap", @"moduleConfigProtocolToFactoryMap", @"identifierToConfigFactoryMap", @"destinationToDefaultConfigFactoryMap",
+                  @"destinationToEasyRouteMap", @"destinationProtocolToEasyRouteMap", @"moduleConfigProtocolToEasyRouteMap", @"identifierToEasyRouteMap",
+                  @"adapterToAdapteeMap", @"destinationToResolvedRouteMap", @"destinationAdapterToRouteMap", @"moduleAdapterToRouteMap"];
+    });
+    return names;
+}
+
+static NSDictionary<NSString *, NSNumber *> *_footprintEntry(CFIndex count, size_t bytes) {
+    return @{@"count": @(count), @"bytes": @(bytes)};
+}
+
+/// Bytes of container object and its storage. CF hash tables don't expose their capacity, buckets are estimated with the next power of two of count.
+static size_t _containerBytes(CFTypeRef container, CFIndex *count) {
+    size_t bytes = malloc_size(container);
+    CFTypeID typeID = CFGetTypeID(container);
+    size_t slots = 0;
+    if (typeID == CFArrayGetTypeID()) {
+        *count = CFArrayGetCount(container);
+        return bytes + *count * sizeof(void *);
     }
-    CFDictionaryRef destinationToExclusiveRouterMap = self.destinationToExclusiveRouterMap;
-    CFDictionaryRef destinationToRoutersMap = self.destinationToRoutersMap;
-    while (destinationClass) {
-        if (![self isDestinationClassRoutable:destinationClass]) {
-            break;
+    if (typeID == CFDictionaryGetTypeID()) {
+        *count = CFDictionaryGetCount(container);
+        // Keys and values
+        slots = 2;
+    } else if (typeID == CFSetGetTypeID()) {
+        *count = CFSetGetCount(container);
+        slots = 1;
+    } else {
+        *count = 0;
+        return bytes;
+    }
+    size_t buckets = 0;
+    if (*count > 0) {
+        buckets = 1;
+        while (buckets < (size_t)*count) {
+            buckets <<= 1;
         }
-        id route = CFDictionaryGetValue(destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass));
-        if (route) {
-            ZIKRouterType *r = [self _routerTypeForObject:route];
-            if (r) {
-                handler(r);
-            }
-        } else {
-            CFMutableSetRef routers = (CFMutableSetRef)CFDictionaryGetValue(destinationToRoutersMap, (__bridge const void *)(destinationClass));
-            NSSet *routes = (__bridge NSSet *)(routers);
-            [routes enumerateObjectsUsingBlock:^(id  _Nonnull route, BOOL * _Nonnull stop) {
-                if (handler) {
-                    ZIKRouterType *r = [self _routerTypeForObject:route];
-                    if (r) {
-                        handler(r);
-                    }
-                }
+    }
+    return bytes + buckets * slots * sizeof(void *);
+}
+
+static void _addFactoryBlockBytes(const void *value, void *context) {
+    *(size_t *)context += malloc_size(value);
+}
+
++ (NSDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *)memoryFootprint {
+    NSMutableDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *footprint = [NSMutableDictionary dictionary];
+    if (self == [ZIKRouteRegistry class]) {
+        for (Class registry in [[self registries] copy]) {
+            NSString *prefix = NSStringFromClass(registry);
+            [[registry memoryFootprint] enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull name, NSDictionary<NSString *, NSNumber *> * _Nonnull entry, BOOL * _Nonnull stop) {
+                footprint[[NSString stringWithFormat:@"%@.%@", prefix, name]] = entry;
             }];
         }
-        
-        destinationClass = class_getSuperclass(destinationClass);
+        CFIndex count = 0;
+        size_t bytes = 0;
+        pthread_mutex_lock(&_factoryBlocksLock);
+        if (_factoryBlocks) {
+            bytes = _containerBytes(_factoryBlocks, &count);
+            CFSetApplyFunction(_factoryBlocks, _addFactoryBlockBytes, &bytes);
+        }
+        pthread_mutex_unlock(&_factoryBlocksLock);
+        footprint[@"factoryBlocks"] = _footprintEntry(count, bytes);
+        return footprint;
+    }
+    // Resolved routes are updated in lookup
+    dispatch_semaphore_wait(_resolvedRoutesSema, DISPATCH_TIME_FOREVER);
+    for (NSString *name in _footprintContainerNames()) {
+        CFTypeRef container = ((CFTypeRef(*)(id, SEL))objc_msgSend)(self, NSSelectorFromString(name));
+        CFIndex count = 0;
+        size_t bytes = container ? _containerBytes(container, &count) : 0;
+        footprint[name] = _footprintEntry(count, bytes);
+    }
+    dispatch_semaphore_signal(_resolvedRoutesSema);
+    CFArrayRef allRoutes = self.allRoutes;
+    CFIndex routeCount = 0;
+    size_t routeBytes = 0;
+    for (CFIndex i = 0, count = CFArrayGetCount(allRoutes); i < count; i++) {
+        id route = (__bridge id)CFArrayGetValueAtIndex(allRoutes, i);
+        // Router classes are not allocated by registry
+        if (class_isMetaClass(object_getClass(route))) {
+            continue;
+        }
+        routeCount++;
+        routeBytes += malloc_size((__bridge const void *)route);
+    }
+    footprint[@"routeObjects"] = _footprintEntry(routeCount, routeBytes);
+    return footprint;
+}
+
++ (void)compactContainers {
+    NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
+}
+
+#pragma mark Identifier Handle
+
+/// Interned identifiers, handle is index + 1.
+static NSMutableArray<NSString *> *_internedIdentifiers;
+/// key: identifier, value: handle
+static CFMutableDictionaryRef _identifierToHandleMap;
+static pthread_mutex_t _identifierHandleLock = PTHREAD_MUTEX_INITIALIZER;
+
+ZIKRouteIdentifierHandle zix_internRouteIdentifier(NSString *identifier) {
+    NSCParameterAssert(identifier);
+    pthread_mutex_lock(&_identifierHandleLock);
+    if (_identifierToHandleMap == NULL) {
+        _identifierToHandleMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+        _internedIdentifiers = [NSMutableArray array];
+    }
+    ZIKRouteIdentifierHandle handle = (ZIKRouteIdentifierHandle)(uintptr_t)CFDictionaryGetValue(_identifierToHandleMap, (__bridge const void *)identifier);
+    if (handle == 0) {
+        NSString *internedIdentifier = [identifier copy];
+        [_internedIdentifiers addObject:internedIdentifier];
+        handle = (ZIKRouteIdentifierHandle)_internedIdentifiers.count;
+        CFDictionarySetValue(_identifierToHandleMap, (__bridge const void *)internedIdentifier, (const void *)(uintptr_t)handle);
+    }
+    pthread_mutex_unlock(&_identifierHandleLock);
+    return handle;
+}
+
+NSString *_Nullable zix_routeIdentifierOfHandle(ZIKRouteIdentifierHandle handle) {
+    NSString *identifier;
+    pthread_mutex_lock(&_identifierHandleLock);
+    if (handle > 0 && handle <= _internedIdentifiers.count) {
+        identifier = _internedIdentifiers[handle - 1];
     }
+    pthread_mutex_unlock(&_identifierHandleLock);
+    return identifier;
+}
+
+/// Handle of the identifier without interning it, 0 when it's not interned.
+static ZIKRouteIdentifierHandle _internedHandleOfIdentifier(NSString *identifier) {
+    pthread_mutex_lock(&_identifierHandleLock);
+    ZIKRouteIdentifierHandle handle = _identifierToHandleMap ? (ZIKRouteIdentifierHandle)(uintptr_t)CFDictionaryGetValue(_identifierToHandleMap, (__bridge const void *)identifier) : 0;
+    pthread_mutex_unlock(&_identifierHandleLock);
+    return handle;
+}
+
+static ZIKRouteIdentifierHandle _internedIdentifierCount(void) {
+    pthread_mutex_lock(&_identifierHandleLock);
+    ZIKRouteIdentifierHandle count = (ZIKRouteIdentifierHandle)_internedIdentifiers.count;
+    pthread_mutex_unlock(&_identifierHandleLock);
+    return count;
 }
 
 #pragma mark Register
 
+/// Router type is immutable, create it once for each registered route and reuse it in every lookup.
+static void _registerRouterTypeForRoute(id routeObject, Class registry) {
+    CFMutableDictionaryRef routeToRouterTypeMap = [registry routeToRouterTypeMap];
+    if (!CFDictionaryContainsKey(routeToRouterTypeMap, (__bridge const void *)(routeObject))) {
+        ZIKRouterType *routerType = [registry _routerTypeForObject:routeObject];
+        if (routerType) {
+            CFDictionarySetValue(routeToRouterTypeMap, (__bridge const void *)(routeObject), (__bridge const void *)(routerType));
+        }
+    }
+    if (_registrationFinished) {
+        _didChangeRegistryAfterFinished(registry);
+    }
+}
+
+static void _addRouteToAllRoutes(id routeObject, Class registry) {
+    CFMutableSetRef allRoutesSet = [registry allRoutesSet];
+    if (!CFSetContainsValue(allRoutesSet, (__bridge const void *)(routeObject))) {
+        CFSetAddValue(allRoutesSet, (__bridge const void *)(routeObject));
+        CFArrayAppendValue([registry allRoutes], (__bridge const void *)(routeObject));
+    }
+}
+
 static __attribute__((always_inline)) void _registerDestinationClassWithRoute(Class destinationClass, id routeObject, Class registry) {
     NSCParameterAssert(zix_classIsSubclassOfClass(registry, [ZIKRouteRegistry class]));
+    if (_routeTableRecorder) {
+        _recordRouteTableRegistration(registry, ZIKRouteTableDestinationsKey, NSStringFromClass(destinationClass), routeObject);
+    }
     NSCParameterAssert([registry isDestinationClassRoutable:destinationClass]);
-    NSCAssert3(![registry destinationToExclusiveRouterMap] ||
-               ([registry destinationToExclusiveRouterMap] && !CFDictionaryGetValue([registry destinationToExclusiveRouterMap], (__bridge const void *)(destinationClass))), @"There is a registered exclusive router (%@), can't register this router (%@) for this destinationClass (%@).",CFDictionaryGetValue([registry destinationToExclusiveRouterMap], (__bridge const void *)(destinationClass)), routeObject, destinationClass);
     
     CFMutableDictionaryRef destinationToDefaultRouterMap = [registry destinationToDefaultRouterMap];
     if (!CFDictionaryContainsKey(destinationToDefaultRouterMap, (__bridge const void *)(destinationClass))) {
@@ -490,69 +3132,60 @@ static __attribute__((always_inline)) void _registerDestinationClassWithRoute(Cl
         CFDictionarySetValue(destinationToRoutersMap, (__bridge const void *)(destinationClass), routers);
     }
     CFSetAddValue(routers, (__bridge const void *)(routeObject));
+    _addRouteToAllRoutes(routeObject, registry);
+    _registerRouterTypeForRoute(routeObject, registry);
     
 #if ZIKROUTER_CHECK
-    CFMutableSetRef destinations = (CFMutableSetRef)CFDictionaryGetValue([registry _check_routerToDestinationsMap], (__bridge const void *)(routeObject));
-    if (destinations == NULL) {
-        destinations = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
-        CFDictionarySetValue([registry _check_routerToDestinationsMap], (__bridge const void *)(routeObject), destinations);
-    }
-    CFSetAddValue(destinations, (__bridge const void *)(destinationClass));
+    zix_routeEdgeListAddEdge([registry _check_routerToDestinationEdges], (__bridge const void *)(routeObject), (__bridge const void *)(destinationClass));
 #endif
 }
 
 static __attribute__((always_inline)) void _registerExclusiveDestinationClassWithRoute(Class destinationClass, id routeObject, Class registry) {
     NSCParameterAssert(zix_classIsSubclassOfClass(registry, [ZIKRouteRegistry class]));
+    if (_routeTableRecorder) {
+        _recordRouteTableRegistration(registry, ZIKRouteTableExclusiveDestinationsKey, NSStringFromClass(destinationClass), routeObject);
+    }
     NSCParameterAssert([registry isDestinationClassRoutable:destinationClass]);
     NSCAssert3(!CFDictionaryGetValue([registry destinationToExclusiveRouterMap], (__bridge const void *)(destinationClass)), @"There is already a registered exclusive router (%@) for this destinationClass (%@), can't register this router (%@). You can only specific one exclusive router for each destinationClass. Choose the router used as dependency injector.",CFDictionaryGetValue([registry destinationToExclusiveRouterMap], (__bridge const void *)(destinationClass)), NSStringFromClass(destinationClass), routeObject);
-    NSCAssert3(!CFDictionaryGetValue([registry destinationToDefaultRouterMap], (__bridge const void *)(destinationClass)), @"destinationClass (%@) already registered with another router (%@), check and remove them. You shall only use this exclusive router (%@) for this destinationClass.",NSStringFromClass(destinationClass), CFDictionaryGetValue([registry destinationToDefaultRouterMap], (__bridge const void *)(destinationClass)), routeObject);
-    NSCAssert3(!CFDictionaryContainsKey([registry destinationToRoutersMap], (__bridge const void *)(destinationClass)) ||
-              (CFDictionaryContainsKey([registry destinationToRoutersMap], (__bridge const void *)(destinationClass)) &&
-               !CFSetContainsValue(
-                                   (CFMutableSetRef)CFDictionaryGetValue([registry destinationToRoutersMap], (__bridge const void *)(destinationClass)),
-                                   (__bridge const void *)(routeObject)
-                                   ))
-              , @"destinationClass (%@) already registered with another router (%@), check and remove them. You shall only use this exclusive router (%@) for this destinationClass.", NSStringFromClass(destinationClass), [(__bridge NSSet *)CFDictionaryGetValue([registry destinationToRoutersMap], (__bridge const void *)(destinationClass)) anyObject], routeObject);
-    NSCAssert2(!CFSetContainsValue([registry runtimeFactoryDestinationClasses], (__bridge const void *)(destinationClass)), @"destinationClass (%@) already registered with `registerXXX:forMakingXXX:`, check and remove them. You shall only use this exclusive router (%@) for this destinationClass.", NSStringFromClass(destinationClass), routeObject);
-    NSCAssert2(!CFDictionaryGetValue([registry destinationToDefaultFactoryMap], (__bridge const void *)(destinationClass)), @"destinationClass (%@) already registered with `registerXXX:forMakingXXX:making:` or `registerXXX:forMakingXXX:factory:`, check and remove them. You shall only use this exclusive router (%@) for this destinationClass.", NSStringFromClass(destinationClass), routeObject);
+    // Conflicts with other registrations are checked in _checkExclusiveRoutes() when publishing snapshot
     
     CFDictionaryAddValue([registry destinationToExclusiveRouterMap], (__bridge const void *)(destinationClass), (__bridge const void *)(routeObject));
+    _addRouteToAllRoutes(routeObject, registry);
+    _registerRouterTypeForRoute(routeObject, registry);
     
 #if ZIKROUTER_CHECK
-    CFMutableSetRef destinations = (CFMutableSetRef)CFDictionaryGetValue([registry _check_routerToDestinationsMap], (__bridge const void *)(routeObject));
-    if (destinations == NULL) {
-        destinations = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
-        CFDictionarySetValue([registry _check_routerToDestinationsMap], (__bridge const void *)(routeObject), destinations);
-    }
-    CFSetAddValue(destinations, (__bridge const void *)(destinationClass));
+    zix_routeEdgeListAddEdge([registry _check_routerToDestinationEdges], (__bridge const void *)(routeObject), (__bridge const void *)(destinationClass));
 #endif
 }
 
 static __attribute__((always_inline)) void _registerDestinationProtocolWithRoute(Protocol *destinationProtocol, id routeObject, Class registry) {
     NSCParameterAssert(zix_classIsSubclassOfClass(registry, [ZIKRouteRegistry class]));
+    if (_routeTableRecorder) {
+        _recordRouteTableRegistration(registry, ZIKRouteTableDestinationProtocolsKey, NSStringFromProtocol(destinationProtocol), routeObject);
+    }
     NSCAssert3(!CFDictionaryGetValue([registry destinationProtocolToRouterMap], (__bridge const void *)(destinationProtocol)) ||
                (Class)CFDictionaryGetValue([registry destinationProtocolToRouterMap], (__bridge const void *)(destinationProtocol)) == routeObject
                , @"Destination protocol (%@) already registered with another router (%@), can't register with this router (%@). Same destination protocol should only be used by one routeObject.",NSStringFromProtocol(destinationProtocol),CFDictionaryGetValue([registry destinationProtocolToRouterMap], (__bridge const void *)(destinationProtocol)),routeObject);
     
     CFDictionaryAddValue([registry destinationProtocolToRouterMap], (__bridge const void *)(destinationProtocol), (__bridge const void *)(routeObject));
+    _registerRouterTypeForRoute(routeObject, registry);
 #if ZIKROUTER_CHECK
-    CFMutableSetRef destinationProtocols = (CFMutableSetRef)CFDictionaryGetValue([registry _check_routerToDestinationProtocolsMap], (__bridge const void *)(routeObject));
-    if (destinationProtocols == NULL) {
-        destinationProtocols = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
-        CFDictionarySetValue([registry _check_routerToDestinationProtocolsMap], (__bridge const void *)(routeObject), destinationProtocols);
-    }
-    CFSetAddValue(destinationProtocols, (__bridge const void *)(destinationProtocol));
+    zix_routeEdgeListAddEdge([registry _check_routerToDestinationProtocolEdges], (__bridge const void *)(routeObject), (__bridge const void *)(destinationProtocol));
 #endif
 }
 
 
 static __attribute__((always_inline)) void _registerModuleProtocolWithRoute(Protocol *configProtocol, id routeObject, Class registry)  {
     NSCParameterAssert(zix_classIsSubclassOfClass(registry, [ZIKRouteRegistry class]));
+    if (_routeTableRecorder) {
+        _recordRouteTableRegistration(registry, ZIKRouteTableModuleProtocolsKey, NSStringFromProtocol(configProtocol), routeObject);
+    }
     NSCAssert3(!CFDictionaryGetValue([registry moduleConfigProtocolToRouterMap], (__bridge const void *)(configProtocol)) ||
                (Class)CFDictionaryGetValue([registry moduleConfigProtocolToRouterMap], (__bridge const void *)(configProtocol)) == routeObject
                , @"Module config protocol (%@) already registered with another router (%@), can't register with this router (%@). Same configProtocol should only be used by one routeObject.",NSStringFromProtocol(configProtocol),CFDictionaryGetValue([registry moduleConfigProtocolToRouterMap], (__bridge const void *)(configProtocol)),routeObject);
     
     CFDictionaryAddValue([registry moduleConfigProtocolToRouterMap], (__bridge const void *)(configProtocol), (__bridge const void *)(routeObject));
+    _registerRouterTypeForRoute(routeObject, registry);
 }
 
 static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString *identifier, id routeObject, Class registry) {
@@ -561,6 +3194,9 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     if (identifier == nil) {
         return;
     }
+    if (_routeTableRecorder) {
+        _recordRouteTableRegistration(registry, ZIKRouteTableIdentifiersKey, identifier, routeObject);
+    }
     NSCAssert3(!CFDictionaryGetValue([registry identifierToRouterMap], (CFStringRef)identifier) ||
                (Class)CFDictionaryGetValue([registry identifierToRouterMap], (CFStringRef)identifier) == routeObject
                , @"Identifier (%@) already registered with another router (%@), can't register with this router (%@).",identifier, CFDictionaryGetValue([registry identifierToRouterMap], (CFStringRef)identifier), routeObject);
@@ -569,10 +3205,13 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     NSCAssert4(!CFDictionaryGetValue([registry identifierToFactoryMap], (CFStringRef)identifier), @"Identifier (%@) already registered with a factory or block (%p) for destination (%@), can't register with this router (%@).", identifier, CFDictionaryGetValue([registry identifierToFactoryMap], (CFStringRef)identifier), NSStringFromClass(CFDictionaryGetValue([registry identifierToDestinationMap], (CFStringRef)identifier)), routeObject);
     NSCAssert4(!CFDictionaryGetValue([registry identifierToConfigFactoryMap], (CFStringRef)identifier), @"Identifier (%@) already registered with a config factory or block (%p) for destination (%@), can't register with this router (%@).", identifier, CFDictionaryGetValue([registry identifierToConfigFactoryMap], (CFStringRef)identifier), NSStringFromClass(CFDictionaryGetValue([registry identifierToDestinationMap], (CFStringRef)identifier)), routeObject);
     
+    zix_internRouteIdentifier(identifier);
     CFDictionaryAddValue([registry identifierToRouterMap], (CFStringRef)identifier, (__bridge const void *)(routeObject));
+    _registerRouterTypeForRoute(routeObject, registry);
 }
 
 + (void)registerDestinationProtocol:(Protocol *)destinationProtocol forMakingDestination:(Class)destinationClass {
+    [self markDynamicRegistration];
     NSParameterAssert([destinationClass isKindOfClass:[NSObject class]]);
     NSAssert([destinationClass conformsToProtocol:destinationProtocol], @"destination class (%@) should conforms to registering protocol (%@)", NSStringFromClass(destinationClass), NSStringFromProtocol(destinationProtocol));
     NSAssert([self isDestinationClassRoutable:destinationClass], @"destination class (%@) should conforms to ZIKRoutableView or ZIKRoutableService.", NSStringFromClass(destinationClass));
@@ -582,9 +3221,11 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
               (self.destinationToExclusiveRouterMap && !CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass))), @"There is a registered exclusive router (%@), can't register destination protocol (%@) for this destinationClass (%@).",CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass)), NSStringFromProtocol(destinationProtocol), destinationClass);
     CFDictionaryAddValue(self.destinationProtocolToDestinationMap, (__bridge const void *)destinationProtocol, (__bridge const void *)destinationClass);
     CFSetAddValue(self.runtimeFactoryDestinationClasses, (__bridge const void *)destinationClass);
+    [self _updateEasyRouteForDestinationClass:destinationClass destinationProtocol:destinationProtocol moduleProtocol:nil identifier:nil];
 }
 
 + (void)registerIdentifier:(NSString *)identifier forMakingDestination:(Class)destinationClass {
+    [self markDynamicRegistration];
     NSParameterAssert(identifier);
     NSParameterAssert([destinationClass isKindOfClass:[NSObject class]]);
     NSAssert([self isDestinationClassRoutable:destinationClass], @"destination class (%@) should conforms to ZIKRoutableView or ZIKRoutableService.", NSStringFromClass(destinationClass));
@@ -596,9 +3237,11 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
               (self.destinationToExclusiveRouterMap && !CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass))), @"There is a registered exclusive router (%@), can't register identifier (%@) for this destinationClass (%@).",CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass)), identifier, destinationClass);
     CFDictionaryAddValue(self.identifierToDestinationMap, (CFStringRef)identifier, (__bridge const void *)destinationClass);
     CFSetAddValue(self.runtimeFactoryDestinationClasses, (__bridge const void *)destinationClass);
+    [self _updateEasyRouteForDestinationClass:destinationClass destinationProtocol:nil moduleProtocol:nil identifier:identifier];
 }
 
 + (void)registerDestinationProtocol:(Protocol *)destinationProtocol forMakingDestination:(Class)destinationClass factoryBlock:(id _Nullable(^ _Nonnull)(ZIKPerformRouteConfiguration * _Nonnull))block {
+    [self markDynamicRegistration];
     NSCParameterAssert(block);
     NSAssert([destinationClass conformsToProtocol:destinationProtocol], @"destination class (%@) should conforms to registering protocol (%@)", NSStringFromClass(destinationClass), NSStringFromProtocol(destinationProtocol));
     NSAssert([self isDestinationClassRoutable:destinationClass], @"destination class (%@) should conforms to ZIKRoutableView or ZIKRoutableService.", NSStringFromClass(destinationClass));
@@ -606,13 +3249,17 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     NSAssert3(!CFDictionaryGetValue(self.destinationProtocolToFactoryMap, (__bridge const void *)destinationProtocol), @"Protocol (%@) already registered with a factory or block (%p), can't be registered with destination (%@).", NSStringFromProtocol(destinationProtocol), CFDictionaryGetValue(self.destinationProtocolToFactoryMap, (__bridge const void *)destinationProtocol), NSStringFromClass(destinationClass));
     NSAssert3(!self.destinationToExclusiveRouterMap ||
               (self.destinationToExclusiveRouterMap && !CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass))), @"There is a registered exclusive router (%@), can't register destination protocol (%@) for this destinationClass (%@).",CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass)), NSStringFromProtocol(destinationProtocol), destinationClass);
+    pthread_mutex_lock(&_factoryBlocksLock);
     CFSetAddValue(_factoryBlocks, CFBridgingRetain(block));
+    pthread_mutex_unlock(&_factoryBlocksLock);
     CFDictionaryAddValue(self.destinationProtocolToFactoryMap, (__bridge const void *)destinationProtocol, (void *)block);
     CFDictionaryAddValue(self.destinationToDefaultFactoryMap, (__bridge const void *)destinationClass, (void *)block);
     CFDictionaryAddValue(self.destinationProtocolToDestinationMap, (__bridge const void *)destinationProtocol, (__bridge const void *)destinationClass);
+    [self _updateEasyRouteForDestinationClass:destinationClass destinationProtocol:destinationProtocol moduleProtocol:nil identifier:nil];
 }
 
 + (void)registerModuleProtocol:(Protocol *)configProtocol forMakingDestination:(Class)destinationClass factoryBlock:(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(^ _Nonnull)(void))block {
+    [self markDynamicRegistration];
     NSCParameterAssert(block);
 #if DEBUG
     ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *config = block();
@@ -623,13 +3270,17 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     NSAssert3(!CFDictionaryGetValue(self.destinationToDefaultConfigFactoryMap, (__bridge const void *)configProtocol), @"Protocol (%@) already registered with a factory or block (%p), can't be registered with destination (%@).", NSStringFromProtocol(configProtocol), CFDictionaryGetValue(self.destinationToDefaultConfigFactoryMap, (__bridge const void *)configProtocol), NSStringFromClass(destinationClass));
     NSAssert3(!self.destinationToExclusiveRouterMap ||
               (self.destinationToExclusiveRouterMap && !CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass))), @"There is a registered exclusive router (%@), can't register module config protocol (%@) for this destinationClass (%@).",CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass)), NSStringFromProtocol(configProtocol), destinationClass);
+    pthread_mutex_lock(&_factoryBlocksLock);
     CFSetAddValue(_factoryBlocks, CFBridgingRetain(block));
+    pthread_mutex_unlock(&_factoryBlocksLock);
     CFDictionaryAddValue(self.moduleConfigProtocolToFactoryMap, (__bridge const void *)configProtocol, (void *)block);
     CFDictionaryAddValue(self.destinationToDefaultConfigFactoryMap, (__bridge const void *)destinationClass, (void *)block);
     CFDictionaryAddValue(self.moduleConfigProtocolToDestinationMap, (__bridge const void *)configProtocol, (__bridge const void *)destinationClass);
+    [self _updateEasyRouteForDestinationClass:destinationClass destinationProtocol:nil moduleProtocol:configProtocol identifier:nil];
 }
 
 + (void)registerIdentifier:(NSString *)identifier forMakingDestination:(Class)destinationClass factoryBlock:(id _Nullable(^ _Nonnull)(ZIKPerformRouteConfiguration * _Nonnull))block {
+    [self markDynamicRegistration];
     NSParameterAssert(identifier);
     NSParameterAssert(block);
     NSAssert([self isDestinationClassRoutable:destinationClass], @"destination class (%@) should conforms to ZIKRoutableView or ZIKRoutableService.", NSStringFromClass(destinationClass));
@@ -639,13 +3290,17 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     NSAssert4(!CFDictionaryGetValue(self.identifierToConfigFactoryMap, (CFStringRef)identifier), @"Identifier (%@) already registered with a config factory or block (%p) for destination (%@), can't be registered with destination (%@).", identifier, CFDictionaryGetValue(self.identifierToConfigFactoryMap, (CFStringRef)identifier), NSStringFromClass(CFDictionaryGetValue(self.identifierToDestinationMap, (CFStringRef)identifier)), NSStringFromClass(destinationClass));
     NSAssert3(!self.destinationToExclusiveRouterMap ||
               (self.destinationToExclusiveRouterMap && !CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass))), @"There is a registered exclusive router (%@), can't register identifier (%@) for this destinationClass (%@).",CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass)), identifier, destinationClass);
+    pthread_mutex_lock(&_factoryBlocksLock);
     CFSetAddValue(_factoryBlocks, CFBridgingRetain(block));
+    pthread_mutex_unlock(&_factoryBlocksLock);
     CFDictionaryAddValue(self.identifierToFactoryMap, (CFStringRef)identifier, (__bridge const void *)block);
     CFDictionaryAddValue(self.destinationToDefaultFactoryMap, (__bridge const void *)destinationClass, (void *)block);
     CFDictionaryAddValue(self.identifierToDestinationMap, (CFStringRef)identifier, (__bridge const void *)destinationClass);
+    [self _updateEasyRouteForDestinationClass:destinationClass destinationProtocol:nil moduleProtocol:nil identifier:identifier];
 }
 
 + (void)registerIdentifier:(NSString *)identifier forMakingDestination:(Class)destinationClass configFactoryBlock:(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(^ _Nonnull)(void))block {
+    [self markDynamicRegistration];
     NSParameterAssert(identifier);
     NSParameterAssert(block);
 #if DEBUG
@@ -659,13 +3314,17 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     NSAssert4(!CFDictionaryGetValue(self.identifierToConfigFactoryMap, (CFStringRef)identifier), @"Identifier (%@) already registered with a config factory or block (%p) for destination (%@), can't be registered with destination (%@).", identifier, CFDictionaryGetValue(self.identifierToConfigFactoryMap, (CFStringRef)identifier), NSStringFromClass(CFDictionaryGetValue(self.identifierToDestinationMap, (CFStringRef)identifier)), NSStringFromClass(destinationClass));
     NSAssert3(!self.destinationToExclusiveRouterMap ||
               (self.destinationToExclusiveRouterMap && !CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass))), @"There is a registered exclusive router (%@), can't register identifier (%@) for this destinationClass (%@).",CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass)), identifier, destinationClass);
+    pthread_mutex_lock(&_factoryBlocksLock);
     CFSetAddValue(_factoryBlocks, CFBridgingRetain(block));
+    pthread_mutex_unlock(&_factoryBlocksLock);
     CFDictionaryAddValue(self.identifierToConfigFactoryMap, (CFStringRef)identifier, (__bridge const void *)block);
     CFDictionaryAddValue(self.destinationToDefaultConfigFactoryMap, (__bridge const void *)destinationClass, (void *)block);
     CFDictionaryAddValue(self.identifierToDestinationMap, (CFStringRef)identifier, (__bridge const void *)destinationClass);
+    [self _updateEasyRouteForDestinationClass:destinationClass destinationProtocol:nil moduleProtocol:nil identifier:identifier];
 }
 
 + (void)registerDestinationProtocol:(Protocol *)destinationProtocol forMakingDestination:(Class)destinationClass factoryFunction:(id _Nullable(*)(ZIKPerformRouteConfiguration * _Nonnull))function {
+    [self markDynamicRegistration];
     NSParameterAssert(function);
     NSAssert([destinationClass conformsToProtocol:destinationProtocol], @"destination class (%@) should conforms to registering protocol (%@)", NSStringFromClass(destinationClass), NSStringFromProtocol(destinationProtocol));
     NSAssert([self isDestinationClassRoutable:destinationClass], @"destination class (%@) should conforms to ZIKRoutableView or ZIKRoutableService.", NSStringFromClass(destinationClass));
@@ -678,9 +3337,47 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     CFDictionaryAddValue(self.destinationProtocolToFactoryMap, (__bridge const void *)destinationProtocol, (void *)function);
     CFDictionaryAddValue(self.destinationToDefaultFactoryMap, (__bridge const void *)destinationClass, (void *)function);
     CFDictionaryAddValue(self.destinationProtocolToDestinationMap, (__bridge const void *)destinationProtocol, (__bridge const void *)destinationClass);
+    [self _updateEasyRouteForDestinationClass:destinationClass destinationProtocol:destinationProtocol moduleProtocol:nil identifier:nil];
+}
+
++ (NSUInteger)registerDestinationFactoryTable:(const ZIKDestinationFactoryEntry *)table count:(NSUInteger)count {
+    NSParameterAssert(table || count == 0);
+    if (table == NULL || count == 0) {
+        return 0;
+    }
+    [self markDynamicRegistration];
+    // Read maps once for all entries
+    CFMutableDictionaryRef protocolToFactoryMap = self.destinationProtocolToFactoryMap;
+    CFMutableDictionaryRef destinationToFactoryMap = self.destinationToDefaultFactoryMap;
+    CFMutableDictionaryRef protocolToDestinationMap = self.destinationProtocolToDestinationMap;
+    NSUInteger registeredCount = 0;
+    for (NSUInteger i = 0; i < count; i++) {
+        const ZIKDestinationFactoryEntry *entry = &table[i];
+        Protocol *destinationProtocol = entry->protocolName ? objc_getProtocol(entry->protocolName) : nil;
+        Class destinationClass = entry->destinationClassName ? objc_getClass(entry->destinationClassName) : Nil;
+        NSAssert(destinationProtocol && destinationClass && entry->factory, @"Invalid factory entry (%s, %s, %p), protocol or class doesn't exist.", entry->protocolName, entry->destinationClassName, entry->factory);
+        if (!destinationProtocol || !destinationClass || !entry->factory) {
+            continue;
+        }
+#if DEBUG
+        NSAssert([destinationClass conformsToProtocol:destinationProtocol], @"destination class (%@) should conforms to registering protocol (%@)", NSStringFromClass(destinationClass), NSStringFromProtocol(destinationProtocol));
+        NSAssert([self isDestinationClassRoutable:destinationClass], @"destination class (%@) should conforms to ZIKRoutableView or ZIKRoutableService.", NSStringFromClass(destinationClass));
+        NSAssert3(!CFDictionaryGetValue(protocolToDestinationMap, (__bridge const void *)destinationProtocol), @"Protocol (%@) already registered with another destination (%@), can't be registered with destination (%@).", NSStringFromProtocol(destinationProtocol), NSStringFromClass((Class)CFDictionaryGetValue(protocolToDestinationMap, (__bridge const void *)destinationProtocol)), NSStringFromClass(destinationClass));
+        NSAssert3(!CFDictionaryGetValue(protocolToFactoryMap, (__bridge const void *)destinationProtocol), @"Protocol (%@) already registered with a factory or block (%p), can't be registered with function (%@).", NSStringFromProtocol(destinationProtocol), CFDictionaryGetValue(protocolToFactoryMap, (__bridge const void *)destinationProtocol), [ZIKImageSymbol symbolNameForAddress:entry->factory]);
+        NSAssert3(!self.destinationToExclusiveRouterMap ||
+                  !CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass)), @"There is a registered exclusive router (%@), can't register destination protocol (%@) for this destinationClass (%@).",CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass)), NSStringFromProtocol(destinationProtocol), destinationClass);
+#endif
+        CFDictionaryAddValue(protocolToFactoryMap, (__bridge const void *)destinationProtocol, (void *)entry->factory);
+        CFDictionaryAddValue(destinationToFactoryMap, (__bridge const void *)destinationClass, (void *)entry->factory);
+        CFDictionaryAddValue(protocolToDestinationMap, (__bridge const void *)destinationProtocol, (__bridge const void *)destinationClass);
+        [self _updateEasyRouteForDestinationClass:destinationClass destinationProtocol:destinationProtocol moduleProtocol:nil identifier:nil];
+        registeredCount++;
+    }
+    return registeredCount;
 }
 
 + (void)registerModuleProtocol:(Protocol *)configProtocol forMakingDestination:(Class)destinationClass factoryFunction:(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *_Nonnull(* _Nonnull)(void))function {
+    [self markDynamicRegistration];
     NSParameterAssert(function);
 #if DEBUG
     ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *config = function();
@@ -696,9 +3393,11 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     CFDictionaryAddValue(self.moduleConfigProtocolToFactoryMap, (__bridge const void *)configProtocol, (void *)function);
     CFDictionaryAddValue(self.destinationToDefaultConfigFactoryMap, (__bridge const void *)destinationClass, (void *)function);
     CFDictionaryAddValue(self.moduleConfigProtocolToDestinationMap, (__bridge const void *)configProtocol, (__bridge const void *)destinationClass);
+    [self _updateEasyRouteForDestinationClass:destinationClass destinationProtocol:nil moduleProtocol:configProtocol identifier:nil];
 }
 
 + (void)registerIdentifier:(NSString *)identifier forMakingDestination:(Class)destinationClass factoryFunction:(id _Nullable(*)(ZIKPerformRouteConfiguration * _Nonnull))function {
+    [self markDynamicRegistration];
     NSParameterAssert(identifier);
     NSParameterAssert(function);
     NSAssert([self isDestinationClassRoutable:destinationClass], @"destination class (%@) should conforms to ZIKRoutableView or ZIKRoutableService.", NSStringFromClass(destinationClass));
@@ -713,9 +3412,11 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     CFDictionaryAddValue(self.identifierToFactoryMap, (CFStringRef)identifier, (void *)function);
     CFDictionaryAddValue(self.destinationToDefaultFactoryMap, (__bridge const void *)destinationClass, (void *)function);
     CFDictionaryAddValue(self.identifierToDestinationMap, (CFStringRef)identifier, (__bridge const void *)destinationClass);
+    [self _updateEasyRouteForDestinationClass:destinationClass destinationProtocol:nil moduleProtocol:nil identifier:identifier];
 }
 
 + (void)registerIdentifier:(NSString *)identifier forMakingDestination:(Class)destinationClass configFactoryFunction:(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *_Nonnull(* _Nonnull)(void))function {
+    [self markDynamicRegistration];
     NSParameterAssert(identifier);
     NSParameterAssert(function);
 #if DEBUG
@@ -734,6 +3435,7 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     CFDictionaryAddValue(self.identifierToConfigFactoryMap, (CFStringRef)identifier, (void *)function);
     CFDictionaryAddValue(self.destinationToDefaultConfigFactoryMap, (__bridge const void *)destinationClass, (void *)function);
     CFDictionaryAddValue(self.identifierToDestinationMap, (CFStringRef)identifier, (__bridge const void *)destinationClass);
+    [self _updateEasyRouteForDestinationClass:destinationClass destinationProtocol:nil moduleProtocol:nil identifier:identifier];
 }
 
 + (void)registerDestination:(Class)destinationClass router:(Class)routerClass {
@@ -790,12 +3492,24 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     NSAssert2(CFDictionaryGetValue(self.destinationProtocolToRouterMap, (__bridge const void *)(adapterProtocol)) == nil, @"Adapter (%@) already register with router (%@)", NSStringFromProtocol(adapterProtocol), CFDictionaryGetValue(self.destinationProtocolToRouterMap, (__bridge const void *)(adapterProtocol)));
     NSAssert3(CFDictionaryGetValue(self.adapterToAdapteeMap, (__bridge const void *)(adapterProtocol)) == nil, @"Adapter (%@) can't register adaptee (%@),  already register another adaptee (%@)", NSStringFromProtocol(adapterProtocol), NSStringFromProtocol(adapteeProtocol), CFDictionaryGetValue(self.adapterToAdapteeMap, (__bridge const void *)(adapterProtocol)));
     CFDictionarySetValue(self.adapterToAdapteeMap, (__bridge const void *)(adapterProtocol), (__bridge const void *)(adapteeProtocol));
+    if (_registrationFinished) {
+        _didChangeRegistryAfterFinished(self);
+    }
+    if (_routeTableRecorder) {
+        _recordRouteTableRegistration(self, ZIKRouteTableDestinationAdaptersKey, @[NSStringFromProtocol(adapterProtocol), NSStringFromProtocol(adapteeProtocol)], _recordingRouterClass);
+    }
 }
 
 + (void)registerModuleAdapter:(Protocol *)adapterProtocol forAdaptee:(Protocol *)adapteeProtocol {
     NSAssert2(CFDictionaryGetValue(self.moduleConfigProtocolToRouterMap, (__bridge const void *)(adapterProtocol)) == nil, @"Adapter (%@) already register with router (%@)", NSStringFromProtocol(adapterProtocol), CFDictionaryGetValue(self.moduleConfigProtocolToRouterMap, (__bridge const void *)(adapterProtocol)));
     NSAssert3(CFDictionaryGetValue(self.adapterToAdapteeMap, (__bridge const void *)(adapterProtocol)) == nil, @"Adapter (%@) can't register adaptee (%@),  already register another adaptee (%@)", NSStringFromProtocol(adapterProtocol), NSStringFromProtocol(adapteeProtocol), CFDictionaryGetValue(self.adapterToAdapteeMap, (__bridge const void *)(adapterProtocol)));
     CFDictionarySetValue(self.adapterToAdapteeMap, (__bridge const void *)(adapterProtocol), (__bridge const void *)(adapteeProtocol));
+    if (_registrationFinished) {
+        _didChangeRegistryAfterFinished(self);
+    }
+    if (_routeTableRecorder) {
+        _recordRouteTableRegistration(self, ZIKRouteTableModuleAdaptersKey, @[NSStringFromProtocol(adapterProtocol), NSStringFromProtocol(adapteeProtocol)], _recordingRouterClass);
+    }
 }
 
 #pragma mark Manually Register
@@ -810,7 +3524,283 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     
     NSSet *registries = [[self registries] copy];
     for (Class registry in registries) {
-        [registry didFinishRegistration];
+        [registry publishSnapshot];
+    }
+    _didFinishRegistrationForRegistries(registries);
+}
+
+#pragma mark Unregister
+
++ (void)unregisterRouterClass:(Class)routerClass {
+    NSParameterAssert([routerClass isSubclassOfClass:[ZIKRouter class]]);
+    [self _unregisterRoutes:@[routerClass] inImage:NULL];
+}
+
++ (void)unregisterRoute:(ZIKRoute *)route {
+    NSParameterAssert([route isKindOfClass:[ZIKRoute class]]);
+    [self _unregisterRoutes:@[route] inImage:NULL];
+}
+
++ (void)unregisterRoutesInImage:(const void *)header {
+    NSParameterAssert(header);
+    [self _unregisterRoutes:nil inImage:header];
+}
+
+/// Unregister the routes, or all routes and factories in the image, then publish new snapshots at once.
++ (void)_unregisterRoutes:(nullable NSArray *)routes inImage:(nullable const void *)header {
+    if (!_registrationFinished) {
+        NSAssert(NO, @"Only unregister after registration is finished.");
+        return;
+    }
+    _waitForBackgroundRegistration();
+    NSSet *registries = self == [ZIKRouteRegistry class] ? [[self registries] copy] : [NSSet setWithObject:self];
+    // Routers waiting for lazy registration can't be found without registering them, register them now so they won't come back later
+    for (Class registry in registries) {
+        [registry registerLazyRouters];
+    }
+    pthread_mutex_lock(&_lateRegistrationLock);
+    _snapshotPublishingSuspended++;
+    for (Class registry in registries) {
+        for (id route in routes ?: _routesInImage(registry, header)) {
+            _unregisterRouteInRegistry(registry, route);
+        }
+        if (header) {
+            _unregisterFactoriesInImage(registry, header);
+        }
+    }
+    _snapshotPublishingSuspended--;
+    if (_snapshotPublishingSuspended == 0) {
+        for (Class registry in registries) {
+            [registry publishSnapshot];
+        }
+    }
+    pthread_mutex_unlock(&_lateRegistrationLock);
+    for (Class registry in registries) {
+        [registry invalidateResolvedRoutes];
+    }
+    if (header) {
+        // A class loaded later may take the address of a class in the image
+        zix_evictRuntimeCachesInImage(header);
+        if (_launchRouterClasses) {
+            zix_classSetRemoveClassesInImage(_launchRouterClasses, header);
+        }
+        zix_discardPrewarmedDestinationsInImage(header);
+        for (Class registry in registries) {
+            [registry evictCachesInImage:header];
+        }
+    }
+}
+
+static CFArrayRef _Nullable _takeUnregisteredObjects(Class registry) {
+    if (_unregisteredObjects == NULL) {
+        return NULL;
+    }
+    CFArrayRef objects = CFDictionaryGetValue(_unregisteredObjects, (__bridge const void *)(registry));
+    if (objects) {
+        CFRetain(objects);
+        CFDictionaryRemoveValue(_unregisteredObjects, (__bridge const void *)(registry));
+    }
+    return objects;
+}
+
+/// Keep the removed object alive until current snapshot of the registry is freed, lookups on other threads may still read it from the snapshot.
+static void _keepUnregisteredObject(Class registry, const void *object) {
+    if (_unregisteredObjects == NULL) {
+        _unregisteredObjects = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    }
+    CFMutableArrayRef objects = (CFMutableArrayRef)CFDictionaryGetValue(_unregisteredObjects, (__bridge const void *)(registry));
+    if (objects == NULL) {
+        objects = CFArrayCreateMutable(kCFAllocatorDefault, 0, &kCFTypeArrayCallBacks);
+        CFDictionarySetValue(_unregisteredObjects, (__bridge const void *)(registry), objects);
+        CFRelease(objects);
+    }
+    CFArrayAppendValue(objects, object);
+}
+
+/// Remove entries passing the test and return their keys. Values released by the map should be kept in the test.
+static NSArray *_removeEntriesInMap(CFMutableDictionaryRef map, BOOL(NS_NOESCAPE ^test)(const void *key, const void *value)) {
+    NSMutableArray *removedKeys = [NSMutableArray array];
+    CFIndex count = CFDictionaryGetCount(map);
+    if (count == 0) {
+        return removedKeys;
+    }
+    const void **keys = malloc(sizeof(void *) * count * 2);
+    const void **values = keys + count;
+    CFDictionaryGetKeysAndValues(map, keys, values);
+    for (CFIndex i = 0; i < count; i++) {
+        if (test(keys[i], values[i])) {
+            [removedKeys addObject:(__bridge id)(keys[i])];
+            CFDictionaryRemoveValue(map, keys[i]);
+        }
+    }
+    free(keys);
+    return removedKeys;
+}
+
+static void _unregisterRouterTypeOfRoute(Class registry, const void *route) {
+    CFMutableDictionaryRef routeToRouterTypeMap = [registry routeToRouterTypeMap];
+    const void *routerType = CFDictionaryGetValue(routeToRouterTypeMap, route);
+    if (routerType) {
+        _keepUnregisteredObject(registry, routerType);
+        CFDictionaryRemoveValue(routeToRouterTypeMap, route);
+    }
+}
+
+/// Router classes and routes implemented in the image.
+static NSArray *_routesInImage(Class registry, const void *header) {
+    NSMutableSet *routes = [NSMutableSet set];
+    // Routers only registered with pure Swift protocols are not in registry's maps, so search classes in the image
+    void(^handler)(__unsafe_unretained Class) = ^(__unsafe_unretained Class  _Nonnull aClass) {
+        if ([registry isRegisterableRouterClass:aClass]) {
+            [routes addObject:aClass];
+        }
+    };
+    if (_usesSectionRegistration) {
+        zix_enumerateClassesInImageSection(header, ZIKROUTER_ROUTES_SECTION, handler);
+    } else {
+        zix_enumerateClassesInImageForParentClass(header, [ZIKRouter class], handler);
+    }
+    void(^addRouteInImage)(id) = ^(id route) {
+        if ([route isKindOfClass:[ZIKRoute class]] && zix_imageHeaderOfBlock(((ZIKRoute *)route).makeDestinationBlock) == header) {
+            [routes addObject:route];
+        }
+    };
+    for (id route in (__bridge NSSet *)[registry allRoutesSet]) {
+        addRouteInImage(route);
+    }
+    // Routes only registered with protocols or identifiers are not in allRoutes
+    for (id route in (__bridge NSDictionary *)[registry routeToRouterTypeMap]) {
+        addRouteInImage(route);
+    }
+    return routes.allObjects;
+}
+
+/// Remove the router class or route from all maps of the registry. Call it with _lateRegistrationLock, then publish snapshot.
+static void _unregisterRouteInRegistry(Class registry, id routeObject) {
+    const void *route = (__bridge const void *)(routeObject);
+    if ([registry respondsToSelector:@selector(_swiftUnregisterRoute:)]) {
+        [registry _swiftUnregisterRoute:routeObject];
+    }
+    if (!CFSetContainsValue([registry allRoutesSet], route) && !CFDictionaryContainsKey([registry routeToRouterTypeMap], route)) {
+        return;
+    }
+    _keepUnregisteredObject(registry, route);
+    BOOL(^isRoute)(const void *, const void *) = ^BOOL(const void *key, const void *value) {
+        return value == route;
+    };
+    _removeEntriesInMap([registry destinationProtocolToRouterMap], isRoute);
+    _removeEntriesInMap([registry moduleConfigProtocolToRouterMap], isRoute);
+    _removeEntriesInMap([registry identifierToRouterMap], isRoute);
+    _removeEntriesInMap([registry destinationToExclusiveRouterMap], isRoute);
+    NSArray<Class> *defaultDestinations = _removeEntriesInMap([registry destinationToDefaultRouterMap], isRoute);
+    CFMutableDictionaryRef destinationToRoutersMap = [registry destinationToRoutersMap];
+    _removeEntriesInMap(destinationToRoutersMap, ^BOOL(const void *key, const void *routers) {
+        CFSetRemoveValue((CFMutableSetRef)routers, route);
+        return CFSetGetCount(routers) == 0;
+    });
+    CFMutableArrayRef allRoutes = [registry allRoutes];
+    CFIndex index = CFArrayGetFirstIndexOfValue(allRoutes, CFRangeMake(0, CFArrayGetCount(allRoutes)), route);
+    if (index != kCFNotFound) {
+        CFArrayRemoveValueAtIndex(allRoutes, index);
+    }
+    CFSetRemoveValue([registry allRoutesSet], route);
+    // Default router is the first registered one, so the earliest registered router in the rest takes its place
+    CFMutableDictionaryRef destinationToDefaultRouterMap = [registry destinationToDefaultRouterMap];
+    for (Class destinationClass in defaultDestinations) {
+        CFSetRef routers = CFDictionaryGetValue(destinationToRoutersMap, (__bridge const void *)(destinationClass));
+        if (routers == NULL) {
+            continue;
+        }
+        for (CFIndex i = 0; i < CFArrayGetCount(allRoutes); i++) {
+            const void *candidate = CFArrayGetValueAtIndex(allRoutes, i);
+            if (CFSetContainsValue(routers, candidate)) {
+                CFDictionarySetValue(destinationToDefaultRouterMap, (__bridge const void *)(destinationClass), candidate);
+                break;
+            }
+        }
+    }
+    _unregisterRouterTypeOfRoute(registry, route);
+    if ([routeObject isKindOfClass:[ZIKRoute class]]) {
+        [(ZIKRoute *)routeObject didUnregister];
+    }
+}
+
+/// Remove factory of the key. Blocks retained in registration are released with current snapshot.
+static void _unregisterFactoryInMap(Class registry, CFMutableDictionaryRef factoryMap, const void *key) {
+    const void *factory = CFDictionaryGetValue(factoryMap, key);
+    if (factory == NULL) {
+        return;
+    }
+    CFDictionaryRemoveValue(factoryMap, key);
+    pthread_mutex_lock(&_factoryBlocksLock);
+    BOOL isBlock = CFSetContainsValue(_factoryBlocks, factory);
+    if (isBlock) {
+        CFSetRemoveValue(_factoryBlocks, factory);
+    }
+    pthread_mutex_unlock(&_factoryBlocksLock);
+    if (isBlock) {
+        _keepUnregisteredObject(registry, factory);
+        // Balance CFBridgingRetain in registration
+        CFRelease(factory);
+    }
+}
+
+static void _unregisterEasyRouteInMap(Class registry, CFMutableDictionaryRef easyRouteMap, const void *key) {
+    const void *route = CFDictionaryGetValue(easyRouteMap, key);
+    if (route == NULL) {
+        return;
+    }
+    _keepUnregisteredObject(registry, route);
+    _unregisterRouterTypeOfRoute(registry, route);
+    CFDictionaryRemoveValue(easyRouteMap, key);
+}
+
+/// Remove registrations for making destination classes in the image, with their factories and easy routes.
+static void _unregisterFactoriesInImage(Class registry, const void *header) {
+    BOOL(^destinationInImage)(const void *, const void *) = ^BOOL(const void *key, const void *destinationClass) {
+        return zix_imageHeaderOfClass((__bridge Class)(destinationClass)) == header;
+    };
+    for (Protocol *destinationProtocol in _removeEntriesInMap([registry destinationProtocolToDestinationMap], destinationInImage)) {
+        const void *key = (__bridge const void *)(destinationProtocol);
+        _unregisterFactoryInMap(registry, [registry destinationProtocolToFactoryMap], key);
+        _unregisterEasyRouteInMap(registry, [registry destinationProtocolToEasyRouteMap], key);
+    }
+    for (Protocol *configProtocol in _removeEntriesInMap([registry moduleConfigProtocolToDestinationMap], destinationInImage)) {
+        const void *key = (__bridge const void *)(configProtocol);
+        _unregisterFactoryInMap(registry, [registry moduleConfigProtocolToFactoryMap], key);
+        _unregisterEasyRouteInMap(registry, [registry moduleConfigProtocolToEasyRouteMap], key);
+    }
+    for (NSString *identifier in _removeEntriesInMap([registry identifierToDestinationMap], destinationInImage)) {
+        const void *key = (__bridge const void *)(identifier);
+        _unregisterFactoryInMap(registry, [registry identifierToFactoryMap], key);
+        _unregisterFactoryInMap(registry, [registry identifierToConfigFactoryMap], key);
+        _unregisterEasyRouteInMap(registry, [registry identifierToEasyRouteMap], key);
+    }
+    
+    NSMutableSet<Class> *destinationClasses = [NSMutableSet set];
+    void(^addDestinationInImage)(Class) = ^(Class destinationClass) {
+        if (zix_imageHeaderOfClass(destinationClass) == header) {
+            [destinationClasses addObject:destinationClass];
+        }
+    };
+    for (Class destinationClass in (__bridge NSSet *)[registry runtimeFactoryDestinationClasses]) {
+        addDestinationInImage(destinationClass);
+    }
+    for (Class destinationClass in (__bridge NSDictionary *)[registry destinationToDefaultFactoryMap]) {
+        addDestinationInImage(destinationClass);
+    }
+    for (Class destinationClass in (__bridge NSDictionary *)[registry destinationToDefaultConfigFactoryMap]) {
+        addDestinationInImage(destinationClass);
+    }
+    for (Class destinationClass in (__bridge NSDictionary *)[registry destinationToEasyRouteMap]) {
+        addDestinationInImage(destinationClass);
+    }
+    for (Class destinationClass in destinationClasses) {
+        const void *key = (__bridge const void *)(destinationClass);
+        CFSetRemoveValue([registry runtimeFactoryDestinationClasses], key);
+        _unregisterFactoryInMap(registry, [registry destinationToDefaultFactoryMap], key);
+        _unregisterFactoryInMap(registry, [registry destinationToDefaultConfigFactoryMap], key);
+        _unregisterEasyRouteInMap(registry, [registry destinationToEasyRouteMap], key);
     }
 }
 
@@ -822,39 +3812,71 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     if (routeKey == nil) {
         return NO;
     }
-    CFMutableSetRef destinationProtocols = (CFMutableSetRef)CFDictionaryGetValue(self._check_routerToDestinationProtocolsMap, (__bridge const void *)(routeKey));
-    if (destinationProtocols != NULL) {
-        for (Protocol *destinationProtocol in (__bridge NSSet*)destinationProtocols) {
-            if (![destinationClass conformsToProtocol:destinationProtocol]) {
+    __block BOOL conforms = YES;
+    zix_routeEdgeListEnumerateTargets(self._check_routerToDestinationProtocolEdges, (__bridge const void *)(routeKey), ^(const void * _Nonnull target, BOOL * _Nonnull stop) {
+        Protocol *destinationProtocol = (__bridge Protocol *)target;
+        if (![destinationClass conformsToProtocol:destinationProtocol]) {
+            if (protocol) {
                 *protocol = destinationProtocol;
-                return NO;
             }
+            conforms = NO;
+            *stop = YES;
         }
-    }
-#endif
+    });
+    return conforms;
+#else
     return YES;
+#endif
 }
 
 + (nullable Class)validateDestinationsForRoute:(id)route handler:(BOOL(^)(Class destinationClass))handler {
 #if ZIKROUTER_CHECK
     NSParameterAssert([self _routerTypeForObject:route]);
-    CFMutableSetRef destinationClasses = (CFMutableSetRef)CFDictionaryGetValue(self._check_routerToDestinationsMap, (__bridge const void *)(route));
     __block Class badClass = nil;
-    [(__bridge NSSet *)(destinationClasses) enumerateObjectsUsingBlock:^(Class  _Nonnull destinationClass, BOOL * _Nonnull stop) {
-        if (handler) {
-            if (!handler(destinationClass)) {
-                badClass = destinationClass;
-                *stop = YES;
-            }
-            ;
+    zix_routeEdgeListEnumerateTargets(self._check_routerToDestinationEdges, (__bridge const void *)(route), ^(const void * _Nonnull target, BOOL * _Nonnull stop) {
+        Class destinationClass = (__bridge Class)target;
+        if (handler && !handler(destinationClass)) {
+            badClass = destinationClass;
+            *stop = YES;
         }
-    }];
+    });
     return badClass;
 #else
     return nil;
 #endif
 }
 
++ (nullable NSString *)validateConcurrentlyWithCount:(NSUInteger)count handler:(NSString *_Nullable(^)(NSUInteger index))handler {
+#if ZIKROUTER_CHECK
+    NSParameterAssert(handler);
+    if (count == 0) {
+        return nil;
+    }
+    // Each check writes its own slot, no lock is needed
+    CFTypeRef *results = calloc(count, sizeof(CFTypeRef));
+    qos_class_t qos = ZIKRouteRegistry.validatesInBackground ? QOS_CLASS_UTILITY : QOS_CLASS_USER_INITIATED;
+    dispatch_apply(count, zix_globalQueueWithQOS(qos), ^(size_t idx) {
+        @autoreleasepool {
+            NSString *error = handler(idx);
+            if (error.length > 0) {
+                results[idx] = CFBridgingRetain(error);
+            }
+        }
+    });
+    NSMutableString *errorDescription = [NSMutableString string];
+    for (NSUInteger idx = 0; idx < count; idx++) {
+        if (results[idx]) {
+            [errorDescription appendString:(__bridge NSString *)results[idx]];
+            CFRelease(results[idx]);
+        }
+    }
+    free(results);
+    return errorDescription.length > 0 ? errorDescription : nil;
+#else
+    return nil;
+#endif
+}
+
 + (void)validateMakeableConfiguration:(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *)config {
     NSAssert1([config conformsToProtocol:@protocol(ZIKConfigurationMakeable)], @"configuration class (%@) should conforms to ZIKConfigurationMakeable when registering as factory.", config);
 #if DEBUG
@@ -888,10 +3910,50 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
     return nil;
 }
++ (CFMutableDictionaryRef)routeToRouterTypeMap {
+    NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
+    return nil;
+}
++ (CFMutableArrayRef)allRoutes {
+    NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
+    return nil;
+}
++ (CFMutableSetRef)allRoutesSet {
+    NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
+    return nil;
+}
 + (CFMutableDictionaryRef)adapterToAdapteeMap {
     NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
     return nil;
 }
++ (CFMutableDictionaryRef)destinationToResolvedRouteMap {
+    NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
+    return nil;
+}
++ (CFMutableDictionaryRef)destinationAdapterToRouteMap {
+    NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
+    return nil;
+}
++ (CFMutableDictionaryRef)moduleAdapterToRouteMap {
+    NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
+    return nil;
+}
++ (CFMutableDictionaryRef)destinationToEasyRouteMap {
+    NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
+    return nil;
+}
++ (CFMutableDictionaryRef)destinationProtocolToEasyRouteMap {
+    NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
+    return nil;
+}
++ (CFMutableDictionaryRef)moduleConfigProtocolToEasyRouteMap {
+    NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
+    return nil;
+}
++ (CFMutableDictionaryRef)identifierToEasyRouteMap {
+    NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
+    return nil;
+}
 + (CFMutableDictionaryRef)destinationProtocolToDestinationMap {
     NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
     return nil;
@@ -932,19 +3994,30 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
     return nil;
 }
-+ (CFMutableDictionaryRef)_check_routerToDestinationsMap {
+#if ZIKROUTER_CHECK
++ (ZIKRouteEdgeList *)_check_routerToDestinationEdges {
     NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
-    return nil;
+    return NULL;
 }
-+ (CFMutableDictionaryRef)_check_routerToDestinationProtocolsMap {
++ (ZIKRouteEdgeList *)_check_routerToDestinationProtocolEdges {
     NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
-    return nil;
+    return NULL;
+}
+#endif
+
++ (void *_Nullable *)snapshotStorage {
+    NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
+    return NULL;
 }
 
 + (void)willEnumerateClasses {
     
 }
 
++ (nullable Class)routerBaseClass {
+    return nil;
+}
+
 + (void)handleEnumerateRouterClass:(Class)aClass {
     
 }
@@ -953,6 +4026,14 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     
 }
 
++ (void)validateRegistration {
+    
+}
+
++ (void)evictCachesInImage:(const void *)header {
+    
+}
+
 + (BOOL)isRegisterableRouterClass:(Class)aClass {
     NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
     return NO;
@@ -963,4 +4044,9 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     return NO;
 }
 
++ (nullable Class)routableRootClassOfDestinationClass:(Class)aClass {
+    NSAssert(NO, @"%@ must override %@",self,NSStringFromSelector(_cmd));
+    return nil;
+}
+
 @end
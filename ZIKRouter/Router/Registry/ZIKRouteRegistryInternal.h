@@ -10,10 +10,13 @@
 //
 
 #import "ZIKRouteRegistry.h"
+#import "ZIKRouteMetrics.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
 @class ZIKRouter, ZIKRoute, ZIKRouterType, ZIKPerformRouteConfiguration;
+struct ZIKRouteEdgeList;
+struct ZIKDestinationFactoryEntry;
 @protocol ZIKConfigurationMakeable;
 
 @interface ZIKRouteRegistry ()
@@ -31,6 +34,11 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (nullable id)routeKeyForRouter:(ZIKRouter *)router;
 
+/// Counter of lookups in ZIKRouterMetrics.
++ (ZIKRouterCounter)lookupCounter;
+/// Counter of lookups without router found in ZIKRouterMetrics.
++ (ZIKRouterCounter)lookupMissCounter;
+
 #pragma mark Subclass Container
 
 /// key: destination protocol, value: router class or ZIKRoute
@@ -45,12 +53,18 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, class, readonly) CFMutableDictionaryRef destinationToExclusiveRouterMap;
 /// key: identifier string, value: router class or ZIKRoute
 @property (nonatomic, class, readonly) CFMutableDictionaryRef identifierToRouterMap;
+/// key: router class or ZIKRoute, value: router type of the route, created when registering
+@property (nonatomic, class, readonly) CFMutableDictionaryRef routeToRouterTypeMap;
+/// Router classes and ZIKRoutes registered with destination classes, in registration order without duplicates. Appended when registering, so enumerating all routers is a walk over the array.
+@property (nonatomic, class, readonly) CFMutableArrayRef allRoutes;
+/// Routes in allRoutes, for checking duplicates when appending.
+@property (nonatomic, class, readonly) CFMutableSetRef allRoutesSet;
 
 #if ZIKROUTER_CHECK
-/// key: router class or ZIKRoute, value: destination class set
-@property (nonatomic, class, readonly) CFMutableDictionaryRef _check_routerToDestinationsMap;
-/// key: router class or ZIKRoute, value: destination protocol set
-@property (nonatomic, class, readonly) CFMutableDictionaryRef _check_routerToDestinationProtocolsMap;
+/// Edges from router class or ZIKRoute to destination class, see ZIKRouteEdgeList.h
+@property (nonatomic, class, readonly) struct ZIKRouteEdgeList *_check_routerToDestinationEdges;
+/// Edges from router class or ZIKRoute to destination protocol, see ZIKRouteEdgeList.h
+@property (nonatomic, class, readonly) struct ZIKRouteEdgeList *_check_routerToDestinationProtocolEdges;
 #endif
 
 #pragma mark Runtime Factory Container
@@ -80,18 +94,83 @@ NS_ASSUME_NONNULL_BEGIN
 /// key: destination class, value: module config factory function / block set
 @property (nonatomic, class, readonly) CFMutableDictionaryRef destinationToDefaultConfigFactoryMap;
 
+#pragma mark Easy Route Container
+
+/// key: destination class, value: ZIKRoute made from registered factory, created when registering
+@property (nonatomic, class, readonly) CFMutableDictionaryRef destinationToEasyRouteMap;
+/// key: destination protocol, value: ZIKRoute made from registered factory, created when registering
+@property (nonatomic, class, readonly) CFMutableDictionaryRef destinationProtocolToEasyRouteMap;
+/// key: module config protocol, value: ZIKRoute made from registered factory, created when registering
+@property (nonatomic, class, readonly) CFMutableDictionaryRef moduleConfigProtocolToEasyRouteMap;
+/// key: identifier string, value: ZIKRoute made from registered factory, created when registering
+@property (nonatomic, class, readonly) CFMutableDictionaryRef identifierToEasyRouteMap;
+
 #pragma mark Adapter
 
 /// key: adapter protocol, value: adaptee protocol
 @property (nonatomic, class, readonly) CFMutableDictionaryRef adapterToAdapteeMap;
+/// key: requested destination class, value: router class or ZIKRoute resolved from the class and its superclasses, or kCFNull. Only available after registration finished.
+@property (nonatomic, class, readonly) CFMutableDictionaryRef destinationToResolvedRouteMap;
+/// key: destination protocol not registered directly, value: router class or ZIKRoute resolved with adapters, or kCFNull. Only available after registration finished.
+@property (nonatomic, class, readonly) CFMutableDictionaryRef destinationAdapterToRouteMap;
+/// key: module config protocol not registered directly, value: router class or ZIKRoute resolved with adapters, or kCFNull. Only available after registration finished.
+@property (nonatomic, class, readonly) CFMutableDictionaryRef moduleAdapterToRouteMap;
+
+#pragma mark Snapshot
 
+/// Storage of the snapshot pointer of this registry.
+@property (nonatomic, class, readonly) void *_Nullable *_Nonnull snapshotStorage;
+
+/// Build route index from lookup maps and publish it atomically after registration is finished. Immutable copy of lookup maps is also published when `freezesRegistration` is YES. Registrations after finishing mark current snapshot outdated, and it's published again at the next lookup.
++ (void)publishSnapshot;
+
+/// Wait until registration on background queue is finished when `registersInBackground` is YES. It returns immediately on the background registration queue. Lookups in registry call it already, Swift lookups should call it before reading their containers.
++ (void)waitForBackgroundRegistration;
+
+/// Base class of routers in this registry, such as ZIKViewRouter. When it's not nil, +registerAll classifies enumerated classes for all registries in one superclass walk, and calls +registerRouterClass: with this registry's routers directly. Registry returning nil gets every enumerated class in +handleEnumerateRouterClass:. Default is nil.
+@property (nonatomic, class, readonly, nullable) Class routerBaseClass;
 + (void)handleEnumerateRouterClass:(Class)aClass;
+/// Called on the registering thread when registration is finished. Install what routes need before performing here.
 + (void)didFinishRegistration;
+/// Remove cached objects of classes in the image, such as shared destinations. Called after routes in the image are unregistered, before the image is unloaded.
++ (void)evictCachesInImage:(const void *)header;
+/// Validate routers when ZIKROUTER_CHECK is enabled. It's called after +didFinishRegistration, on a background queue when `validatesInBackground` is YES, so it must only read registry.
++ (void)validateRegistration;
+
+/// Call +registerRoutableDestination of the router class, and record its registration when exporting route table.
++ (void)registerRouterClass:(Class)routerClass;
+
+/// Mark current registering router as dynamic in exporting route table, then its +registerRoutableDestination will be called when loading route table. Call it when router registers something not stored in registry.
++ (void)markDynamicRegistration;
+
+/// Unregister routes in the image, then register its routers again by enumerating classes. Return the route table recorded during registration. Only for testing route table.
++ (NSDictionary *)reregisterRoutersInImageRecordingRouteTable:(const void *)header;
+/// Unregister routes in the image, then register its routers again with the route table. Return NO without unregistering anything when the table is stale. Only for testing route table.
++ (BOOL)reregisterRoutersInImage:(const void *)header withRouteTable:(NSDictionary *)table;
+
+/// Register all routers not registered yet when `registersLazily` is YES.
++ (void)registerLazyRouters;
+/// Register routers of the destination class if they are not registered yet when `registersLazily` is YES.
++ (void)registerLazyRoutersForDestinationClass:(Class)destinationClass;
+/// Whether the registry may still have routers waiting for lazy registration.
++ (BOOL)hasLazyRegistrations;
 
 /// Whether the class can be registered into this registry.
 + (BOOL)isRegisterableRouterClass:(Class)aClass;
 
 + (BOOL)isDestinationClassRoutable:(Class)aClass;
+/// The ancestor closest to root class that is still routable, cached for each class. Loops walking superclasses of a destination class stop at this class. Return nil when the class is not routable.
++ (nullable Class)routableRootClassOfDestinationClass:(Class)aClass;
+
+#pragma mark Export
+
+/// URL patterns registered with routers of this registry. Default is nil. Overridden when URLRouter is included.
++ (nullable NSSet<NSString *> *)registeredURLPatterns;
+
+#pragma mark Memory Footprint
+
+/// Rebuild containers at the capacity they need. Called when registration is finished and `compactsRegistration` is YES. Registries compact each container with `zix_compactRegistryContainer`.
++ (void)compactContainers;
 
 #pragma mark Discover
 
@@ -99,6 +178,8 @@ NS_ASSUME_NONNULL_BEGIN
 + (nullable ZIKRouterType *)routerToDestination:(Protocol *)destinationProtocol;
 + (nullable ZIKRouterType *)routerToModule:(Protocol *)configProtocol;
 + (nullable ZIKRouterType *)routerToIdentifier:(NSString *)identifier;
+/// Lookup with handle from `zix_internRouteIdentifier`. Route of the handle is read from the published snapshot without hashing the identifier.
++ (nullable ZIKRouterType *)routerToIdentifierHandle:(ZIKRouteIdentifierHandle)handle;
 
 + (void)enumerateRoutersForDestinationClass:(Class)destinationClass handler:(void(^)(ZIKRouterType * route))handler;
 
@@ -133,6 +214,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 
 + (void)registerDestinationProtocol:(Protocol *)destinationProtocol forMakingDestination:(Class)destinationClass factoryFunction:(id _Nullable(* _Nonnull)(ZIKPerformRouteConfiguration * _Nonnull))function;
+/// Register each entry as registerDestinationProtocol:forMakingDestination:factoryFunction:, checking duplicated registration only in DEBUG. Return count of registered entries.
++ (NSUInteger)registerDestinationFactoryTable:(const struct ZIKDestinationFactoryEntry *)table count:(NSUInteger)count;
 + (void)registerModuleProtocol:(Protocol *)configProtocol forMakingDestination:(Class)destinationClass factoryFunction:(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *_Nonnull(* _Nonnull)(void))function;
 + (void)registerIdentifier:(NSString *)identifier forMakingDestination:(Class)destinationClass factoryFunction:(id _Nullable(* _Nonnull)(ZIKPerformRouteConfiguration * _Nonnull))function;
 + (void)registerIdentifier:(NSString *)identifier forMakingDestination:(Class)destinationClass configFactoryFunction:(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *_Nonnull(* _Nonnull)(void))function;
@@ -144,9 +227,14 @@ NS_ASSUME_NONNULL_BEGIN
 + (BOOL)validateDestinationConformance:(Class)destinationClass forRouter:(ZIKRouter *)router protocol:(Protocol *_Nullable*_Nullable)protocol;
 // Validate all registered view classes of this router class, return the class when the validater return false. Only available when ZIKROUTER_CHECK is true.
 + (nullable Class)validateDestinationsForRoute:(id)route handler:(BOOL(^)(Class destinationClass))handler;
+// Run `count` independent checks concurrently, and join returned error descriptions in order of index, so the result doesn't depend on scheduling. Return nil when all checks pass. Handler is called on multiple threads, it must only read registry. Only available when ZIKROUTER_CHECK is true.
++ (nullable NSString *)validateConcurrentlyWithCount:(NSUInteger)count handler:(NSString *_Nullable(^)(NSUInteger index))handler;
 // Validate registered makeable configuration.
 + (void)validateMakeableConfiguration:(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *)configiration;
 
 @end
 
+/// Replace the mutable dictionary, set or array with a mutable copy sized for its current values, and release the old one. Do nothing when the container is not created. Nothing may be reading the container.
+FOUNDATION_EXTERN void zix_compactRegistryContainer(CFTypeRef _Nullable *_Nonnull container);
+
 NS_ASSUME_NONNULL_END
@@ -0,0 +1,42 @@
+//
+//  ZIKRouteHandle.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import <Foundation/Foundation.h>
+#import "ZIKRouterType.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Cached result of a router lookup. Keep the handle in hot code, such as configuring cells, and read `routerType` each time. The lookup block is called at the first read, and called again only when routes are changed, such as routers registered after registration is finished. Validating the cached router type is one compare with `ZIKRouteRegistry.routesGeneration`.
+ 
+ @discussion
+ Handle can be read from any thread. Router types resolved before are kept by the handle, so a router type returned on one thread is never released while another thread resolves again.
+ */
+@interface ZIKRouteHandle<__covariant RouterType: ZIKRouterType *> : NSObject
+
+/// Create handle with a lookup, such as `^{ return ZIKRouterToService(AServiceInput); }`. Use macro `ZIKRouteHandleToView` or `ZIKRouteHandleToService` to create handle in a type safe way.
++ (instancetype)handleWithLookup:(RouterType _Nullable(^)(void))lookup;
+
+/// Router type resolved in current routes generation. Nil when lookup returns nil.
+@property (nonatomic, readonly, nullable) RouterType routerType;
+
+/// Whether the cached router type is resolved in current routes generation. When it's NO, next read of `routerType` calls the lookup again.
+@property (nonatomic, readonly, getter=isValid) BOOL valid;
+
+/// Routes generation when the cached router type was resolved, 0 when it's not resolved yet.
+@property (nonatomic, readonly) uint64_t generation;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
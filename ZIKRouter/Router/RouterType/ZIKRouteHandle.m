@@ -0,0 +1,79 @@
+//
+//  ZIKRouteHandle.m
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKRouteHandle.h"
+#import "ZIKRouteRegistry.h"
+#import <pthread.h>
+
+@interface ZIKRouteHandle() {
+    ZIKRouterType *_Nullable(^_lookup)(void);
+    /// Router type of `_generation`, kept by `_resolvedRouterTypes`. Read without lock.
+    void *_routerType;
+    uint64_t _generation;
+    /// All router types resolved by this handle, so `_routerType` read by other threads is never released. Routes rarely change after registration, so it won't grow much.
+    NSMutableArray<ZIKRouterType *> *_resolvedRouterTypes;
+    pthread_mutex_t _lock;
+}
+@end
+
+@implementation ZIKRouteHandle
+
++ (instancetype)handleWithLookup:(ZIKRouterType * _Nullable (^)(void))lookup {
+    NSParameterAssert(lookup);
+    return [[self alloc] initWithLookup:lookup];
+}
+
+- (instancetype)initWithLookup:(ZIKRouterType * _Nullable (^)(void))lookup {
+    if (self = [super init]) {
+        _lookup = [lookup copy];
+        _resolvedRouterTypes = [NSMutableArray array];
+        pthread_mutex_init(&_lock, NULL);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_lock);
+}
+
+- (nullable ZIKRouterType *)routerType {
+    uint64_t currentGeneration = [ZIKRouteRegistry routesGeneration];
+    if (__atomic_load_n(&_generation, __ATOMIC_ACQUIRE) == currentGeneration) {
+        return (__bridge ZIKRouterType *)__atomic_load_n(&_routerType, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_lock(&_lock);
+    if (_generation != currentGeneration) {
+        // Generation is read before lookup, so routes changed while resolving make it stale
+        ZIKRouterType *routerType = _lookup();
+        if (routerType && [_resolvedRouterTypes indexOfObjectIdenticalTo:routerType] == NSNotFound) {
+            [_resolvedRouterTypes addObject:routerType];
+        }
+        __atomic_store_n(&_routerType, (__bridge void *)routerType, __ATOMIC_RELAXED);
+        __atomic_store_n(&_generation, currentGeneration, __ATOMIC_RELEASE);
+    }
+    ZIKRouterType *routerType = (__bridge ZIKRouterType *)_routerType;
+    pthread_mutex_unlock(&_lock);
+    return routerType;
+}
+
+- (BOOL)isValid {
+    return __atomic_load_n(&_generation, __ATOMIC_ACQUIRE) == [ZIKRouteRegistry routesGeneration];
+}
+
+- (uint64_t)generation {
+    return __atomic_load_n(&_generation, __ATOMIC_ACQUIRE);
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%@, routerType:%@, generation:%llu", [super description], (__bridge ZIKRouterType *)_routerType, self.generation];
+}
+
+@end
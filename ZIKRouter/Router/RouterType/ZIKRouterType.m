@@ -13,11 +13,20 @@
 #import "ZIKRoute.h"
 #import "ZIKRouter.h"
 
-@interface ZIKRouterType()
+@interface ZIKRouterType() {
+    /// Answers of -respondsToSelector: and -conformsToProtocol: from routeObject, guarded by _answersSema. Route object can't change, so answers never expire.
+    CFMutableDictionaryRef _respondsAnswers;
+    CFMutableDictionaryRef _conformsAnswers;
+    dispatch_semaphore_t _answersSema;
+}
 @property (nonatomic, strong) Class routerClass;
 @property (nonatomic, strong) ZIKRoute *route;
 @end
 
+/// Values in answer caches, NULL means not cached yet.
+#define ZIKRouterTypeAnswerYES ((const void *)1)
+#define ZIKRouterTypeAnswerNO ((const void *)2)
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wincomplete-implementation"
 
@@ -32,6 +41,7 @@
     }
     if (self = [super init]) {
         _routerClass = routerClass;
+        _answersSema = dispatch_semaphore_create(1);
     }
     return self;
 }
@@ -40,6 +50,7 @@
     NSParameterAssert(route);
     if (self = [super init]) {
         _route = route;
+        _answersSema = dispatch_semaphore_create(1);
     }
     return self;
 }
@@ -63,24 +74,99 @@
     return _route;
 }
 
+- (void)dealloc {
+    if (_respondsAnswers) {
+        CFRelease(_respondsAnswers);
+    }
+    if (_conformsAnswers) {
+        CFRelease(_conformsAnswers);
+    }
+}
+
+/// Get cached answer for key, or ask the block and cache its answer. Keys are selectors and protocols, they are never released.
+- (BOOL)_answerInCache:(CFMutableDictionaryRef *)cache forKey:(const void *)key asking:(BOOL(NS_NOESCAPE ^)(void))ask {
+    dispatch_semaphore_wait(_answersSema, DISPATCH_TIME_FOREVER);
+    const void *answer = *cache ? CFDictionaryGetValue(*cache, key) : NULL;
+    dispatch_semaphore_signal(_answersSema);
+    if (answer) {
+        return answer == ZIKRouterTypeAnswerYES;
+    }
+    BOOL result = ask();
+    dispatch_semaphore_wait(_answersSema, DISPATCH_TIME_FOREVER);
+    if (*cache == NULL) {
+        *cache = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+    }
+    CFDictionarySetValue(*cache, key, result ? ZIKRouterTypeAnswerYES : ZIKRouterTypeAnswerNO);
+    dispatch_semaphore_signal(_answersSema);
+    return result;
+}
+
 - (BOOL)respondsToSelector:(SEL)aSelector {
     if ([super respondsToSelector:aSelector]) {
         return YES;
     }
-    return [self.routeObject respondsToSelector:aSelector];
+    if (aSelector == NULL) {
+        return NO;
+    }
+    id routeObject = self.routeObject;
+    return [self _answerInCache:&_respondsAnswers forKey:aSelector asking:^BOOL{
+        return [routeObject respondsToSelector:aSelector];
+    }];
 }
 
 - (BOOL)conformsToProtocol:(Protocol *)protocol {
+    if (protocol == nil) {
+        return NO;
+    }
     if ([super conformsToProtocol:protocol]) {
         return YES;
     }
-    return [self.routeObject conformsToProtocol:protocol];
+    id routeObject = self.routeObject;
+    return [self _answerInCache:&_conformsAnswers forKey:(__bridge const void *)protocol asking:^BOOL{
+        return [routeObject conformsToProtocol:protocol];
+    }];
 }
 
 - (id)forwardingTargetForSelector:(SEL)aSelector {
     return self.routeObject;
 }
 
+#pragma mark Trampolines
+
+// Hot methods are sent to routeObject directly, other methods are still forwarded
+
+- (id)defaultRouteConfiguration {
+    return [self.routeObject defaultRouteConfiguration];
+}
+
+- (id)defaultRemoveConfiguration {
+    return [self.routeObject defaultRemoveConfiguration];
+}
+
+- (BOOL)canMakeDestinationSynchronously {
+    return [self.routeObject canMakeDestinationSynchronously];
+}
+
+- (BOOL)canMakeDestination {
+    return [self.routeObject canMakeDestination];
+}
+
+- (id)makeDestination {
+    return [self.routeObject makeDestination];
+}
+
+- (id)makeDestinationWithPreparation:(void(^)(id destination))prepare {
+    return [self.routeObject makeDestinationWithPreparation:prepare];
+}
+
+- (id)makeDestinationWithConfiguring:(void(NS_NOESCAPE ^)(ZIKPerformRouteConfiguration *config))configBuilder {
+    return [self.routeObject makeDestinationWithConfiguring:configBuilder];
+}
+
+- (id)makeDestinationWithStrictConfiguring:(void(NS_NOESCAPE ^)(ZIKPerformRouteStrictConfiguration *config, ZIKPerformRouteConfiguration *module))configBuilder {
+    return [self.routeObject makeDestinationWithStrictConfiguring:configBuilder];
+}
+
 - (NSString *)description {
     if (self.routerClass) {
         return [NSString stringWithFormat:@"%@: routerClass: %@",[super description], NSStringFromClass(self.routerClass)];
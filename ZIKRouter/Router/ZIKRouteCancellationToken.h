@@ -0,0 +1,34 @@
+//
+//  ZIKRouteCancellationToken.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Token for cancelling performing and making of routers. Set it to `ZIKPerformRouteConfiguration.cancellationToken`, and call -cancel when the result is not needed any more, such as when user navigates away.
+ 
+ @discussion
+ A cancelled route fails with ZIKRouteErrorActionFailed, and a destination made after cancelling is dropped. -destinationWithConfiguration: of slow routers can check `configuration.cancellationToken.isCancelled` or add a cancellation handler to abort making early. One token can be shared by several routes. All methods are thread safe.
+ */
+@interface ZIKRouteCancellationToken : NSObject
+
+@property (nonatomic, readonly, getter=isCancelled) BOOL cancelled;
+
+/// Cancel the token and call cancellation handlers on current thread. Only the first calling takes effect.
+- (void)cancel;
+
+/// Add handler called when the token is cancelled. When the token is already cancelled, the handler is called immediately.
+- (void)addCancellationHandler:(void(^)(void))handler;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,62 @@
+//
+//  ZIKRouteCancellationToken.m
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKRouteCancellationToken.h"
+
+@interface ZIKRouteCancellationToken ()
+{
+    BOOL _cancelled;
+    /// Nil after cancelled.
+    NSMutableArray<void(^)(void)> *_cancellationHandlers;
+}
+@end
+
+@implementation ZIKRouteCancellationToken
+
+- (BOOL)isCancelled {
+    return __atomic_load_n(&_cancelled, __ATOMIC_ACQUIRE);
+}
+
+- (void)cancel {
+    NSArray<void(^)(void)> *handlers;
+    @synchronized (self) {
+        if (_cancelled) {
+            return;
+        }
+        __atomic_store_n(&_cancelled, YES, __ATOMIC_RELEASE);
+        handlers = _cancellationHandlers;
+        _cancellationHandlers = nil;
+    }
+    // Call outside the lock, handlers may cancel routes sharing this token
+    for (void(^handler)(void) in handlers) {
+        handler();
+    }
+}
+
+- (void)addCancellationHandler:(void(^)(void))handler {
+    NSParameterAssert(handler);
+    @synchronized (self) {
+        if (!_cancelled) {
+            if (_cancellationHandlers == nil) {
+                _cancellationHandlers = [NSMutableArray array];
+            }
+            [_cancellationHandlers addObject:[handler copy]];
+            return;
+        }
+    }
+    handler();
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p, cancelled: %@>", NSStringFromClass([self class]), self, self.isCancelled ? @"YES" : @"NO"];
+}
+
+@end
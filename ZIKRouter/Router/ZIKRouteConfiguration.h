@@ -10,6 +10,7 @@
 //
 
 #import <Foundation/Foundation.h>
+#import "ZIKRouteCancellationToken.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -39,6 +40,18 @@ FOUNDATION_EXTERN ZIKRouteAction const ZIKRouteActionPerformRoute;
 /// Remove route. See ZIKRouteErrorActionFailed.
 FOUNDATION_EXTERN ZIKRouteAction const ZIKRouteActionRemoveRoute;
 
+/// Priority of performing a route on main thread, for ordering routes fired at the same time, such as at launch.
+typedef NS_ENUM(NSInteger, ZIKRoutePriority) {
+    /// Perform the route immediately when it's called. This is the default.
+    ZIKRoutePriorityImmediate = 0,
+    /// Perform the route in current or next run loop pass on main thread, before all routes with lower priority.
+    ZIKRoutePriorityUserInitiated,
+    /// Perform the route when main run loop is idle in default mode, several routes in one short time slice.
+    ZIKRoutePriorityUtility,
+    /// Perform the route when main run loop is idle in default mode and no utility route is waiting, one route each time, such as prefetching services.
+    ZIKRoutePriorityBackground
+};
+
 typedef void(^ZIKRouteErrorHandler)(ZIKRouteAction routeAction, NSError *error);
 typedef void(^ZIKRouteStateNotifier)(ZIKRouterState oldState, ZIKRouterState newState);
 
@@ -89,6 +102,38 @@ typedef void(^ZIKPerformRouteCompletion)(BOOL success, id _Nullable destination,
 /// Success handler for current performing, will reset to nil after performed.
 @property (nonatomic, copy, nullable) void(^performerSuccessHandler)(id destination);
 
+/// Key of destination prewarmed with +[ZIKRouter prewarmDestinationForKey:configuring:]. When it's set, router adopts the prewarmed destination for the key instead of creating a new one.
+@property (nonatomic, copy, nullable) NSString *prewarmKey;
+
+/// Scope object for services with `ZIKServiceLifetimeScoped`. Services are shared in the same scope, and released when the scope is deallocated or +[ZIKServiceRouter endServiceScope:] is called. When it's nil, scoped services are not shared.
+@property (nonatomic, weak, nullable) id serviceScope;
+
+/// Key for sharing one construction among concurrent makings of a service router. When a service with the same router and key is being made on another thread, the router waits for it and gets the same destination instead of making a new one. It only makes a new destination at once when waiting forms a cycle, such as services getting each other on two threads. Waiting the thread in other ways can't be detected, so the making must not synchronously wait for the requesting thread, such as dispatching sync to main queue when the service is also requested on main thread. Makings are always coalesced for services with shared lifetime, set this for transient services whose destinations are interchangeable, such as a config service requested by several modules at launch. It only affects destinations made by the router, not `makeDestinationWith` called by user.
+@property (nonatomic, copy, nullable) NSString *coalescingKey;
+
+/// Queue for making destination. When it's set, -destinationWithConfiguration: is called on this queue as if the router's +makesDestinationInBackground is YES, then destination is performed on main queue. Synchronous making, such as +makeDestinationWithConfiguring:, ignores it. Default is nil.
+@property (nonatomic, strong, nullable) dispatch_queue_t performQueue;
+
+/// Queue for successHandler, performerSuccessHandler, errorHandler, performerErrorHandler and completionHandler when performing finishes. When it's nil, they are called on the thread finishing the route. When it's main queue and the route finishes on main thread, they are called without dispatching. Synchronous making ignores it. Default is nil.
+@property (nonatomic, strong, nullable) dispatch_queue_t callbackQueue;
+
+/// Token for cancelling this performing. Performing with a cancelled token fails immediately. Cancelling while destination is made in background fails performing on main queue and drops the destination. Default is nil.
+@property (nonatomic, strong, nullable) ZIKRouteCancellationToken *cancellationToken;
+
+/// Seconds to wait for making destination in background before performing fails with ZIKRouteErrorDestinationUnavailable. When it's 0, the router's +destinationMakingTimeout is used. Default is 0.
+@property (nonatomic) NSTimeInterval destinationMakingTimeout;
+
+/// Priority for scheduling this performing. When it's not ZIKRoutePriorityImmediate, the router is retained and performed later on main thread, and its state stays unrouted until then. Synchronous making, such as +makeDestinationWithConfiguring:, ignores it. Default is ZIKRoutePriorityImmediate.
+@property (nonatomic) ZIKRoutePriority priority;
+
+/**
+ Release blocks only used for performing after performing succeeds, such as prepareDestination, successHandler, performerSuccessHandler and completionHandler, so routers kept for removing don't retain objects captured by those blocks. Default is NO.
+ 
+ @discussion
+ Blocks are released after success handlers are called. Handlers for removing and stateNotifier are kept. Performing the router again after removing won't call the released blocks. View routers keep all blocks when handleExternalRoute is YES or route type is ZIKViewRouteTypeMakeDestination, because destination may be displayed again from external and prepared with them.
+ */
+@property (nonatomic) BOOL releasesPerformHandlersWhenRouted;
+
 @property (nonatomic, copy, nullable) void(^routeCompletion)(id destination) API_DEPRECATED_WITH_REPLACEMENT("successHandler", ios(7.0, 7.0));
 
 /**
@@ -102,6 +147,9 @@ typedef void(^ZIKPerformRouteCompletion)(BOOL success, id _Nullable destination,
 /// User info when handle route action from URL Scheme. Will reset to empty after router remove route.
 @property (nonatomic, strong, readonly) NSDictionary<NSString *, id> *userInfo;
 
+/// Get one object in user info without creating the userInfo dictionary.
+- (nullable id)userInfoObjectForKey:(NSString *)key;
+
 /**
  Add user info.
  
@@ -269,6 +317,21 @@ typedef void(^ZIKConstructBlock)();
  */
 @property (nonatomic, strong, nullable) Destination makedDestination;
 
+/**
+ Make destination with a non-escaping factory and set it as `makedDestination`, then return it. Call it in `makeDestinationWith` to pass parameters to the destination's initializer directly. The factory is not copied to heap, and scalar or struct parameters are captured by value instead of being kept in a `makeDestination` block.
+ 
+ @code
+ config.makeDestinationWith = id^(NSString *account, NSInteger level) {
+     return [weakConfig makeDestinationUsing:^LoginService * _Nullable{
+         return [[LoginService alloc] initWithAccount:account level:level];
+     }];
+ };
+ @endcode
+ 
+ @note `makeDestination` is not set, so the configuration doesn't make destination again after `makedDestination` is used. Set `makeDestination` when the router may make destination again with this configuration.
+ */
+- (nullable Destination)makeDestinationUsing:(Destination _Nullable(NS_NOESCAPE ^)(void))factory;
+
 /**
  Asynchronous factory method passing required parameters for initializing destination module, and get destination in `didMakeDestination`.
  
@@ -435,6 +498,9 @@ typedef void(^ZIKConstructBlock)();
 /// User info when handle route action from URL Scheme.
 @property (nonatomic, strong, readonly) NSDictionary<NSString *, id> *userInfo;
 
+/// Get one object in user info without creating the userInfo dictionary.
+- (nullable id)userInfoObjectForKey:(NSString *)key;
+
 /**
  Add user info.
  
@@ -15,10 +15,157 @@
 #import "ZIKRouterRuntime.h"
 #import "ZIKRouterInternal.h"
 
-@interface ZIKRouteConfiguration ()
-
+@interface ZIKRouteConfiguration () {
+    /// Not a property, so it's not shared by -setPropertiesFromConfiguration:.
+    NSMutableArray<ZIKRouteErrorHandler> *_performerErrorHandlers;
+}
 @end
 
+typedef NS_ENUM(uint8_t, ZIKConfigurationPropertyKind) {
+    ZIKConfigurationPropertyKindObject,
+    ZIKConfigurationPropertyKindBool,
+    ZIKConfigurationPropertyKindInt8,
+    ZIKConfigurationPropertyKindInt16,
+    ZIKConfigurationPropertyKindInt32,
+    ZIKConfigurationPropertyKindInt64,
+    ZIKConfigurationPropertyKindFloat,
+    ZIKConfigurationPropertyKindDouble,
+    /// Struct and other types, or property without accessors, copied with KVC.
+    ZIKConfigurationPropertyKindKVC
+};
+
+/// Writable property of a configuration class.
+typedef struct ZIKConfigurationProperty {
+    SEL getter;
+    SEL setter;
+    IMP getterIMP;
+    IMP setterIMP;
+    /// Property name, retained by the table.
+    const void *key;
+    ZIKConfigurationPropertyKind kind;
+} ZIKConfigurationProperty;
+
+typedef struct ZIKConfigurationPropertyTable {
+    uint32_t count;
+    ZIKConfigurationProperty properties[];
+} ZIKConfigurationPropertyTable;
+
+static ZIKConfigurationPropertyKind _propertyKindForType(const char *type) {
+    if (type == NULL) {
+        return ZIKConfigurationPropertyKindKVC;
+    }
+    // Skip type qualifiers
+    while (*type == 'r' || *type == 'n' || *type == 'N' || *type == 'o' || *type == 'O' || *type == 'R' || *type == 'V') {
+        type++;
+    }
+    switch (*type) {
+        case '@':
+        case '#':
+            return ZIKConfigurationPropertyKindObject;
+        case 'B':
+            return ZIKConfigurationPropertyKindBool;
+        case 'c':
+        case 'C':
+            return ZIKConfigurationPropertyKindInt8;
+        case 's':
+        case 'S':
+            return ZIKConfigurationPropertyKindInt16;
+        case 'i':
+        case 'I':
+            return ZIKConfigurationPropertyKindInt32;
+        case 'l':
+        case 'L':
+            return sizeof(long) == 8 ? ZIKConfigurationPropertyKindInt64 : ZIKConfigurationPropertyKindInt32;
+        case 'q':
+        case 'Q':
+            return ZIKConfigurationPropertyKindInt64;
+        case 'f':
+            return ZIKConfigurationPropertyKindFloat;
+        case 'd':
+            return ZIKConfigurationPropertyKindDouble;
+        default:
+            return ZIKConfigurationPropertyKindKVC;
+    }
+}
+
+static ZIKConfigurationPropertyTable *_createPropertyTable(Class configClass) {
+    NSMutableArray<NSValue *> *properties = [NSMutableArray array];
+    NSMutableSet<NSString *> *names = [NSMutableSet set];
+    Class aClass = configClass;
+    while (aClass && aClass != [ZIKRouteConfiguration class]) {
+        unsigned int count = 0;
+        objc_property_t *propertyList = class_copyPropertyList(aClass, &count);
+        for (unsigned int i = 0; i < count; i++) {
+            objc_property_t property = propertyList[i];
+            char *readonly = property_copyAttributeValue(property, "R");
+            if (readonly) {
+                free(readonly);
+                continue;
+            }
+            const char *propertyName = property_getName(property);
+            if (propertyName == NULL) {
+                continue;
+            }
+            NSString *name = [NSString stringWithUTF8String:propertyName];
+            // Property redeclared in subclass is copied once
+            if (name == nil || [names containsObject:name]) {
+                continue;
+            }
+            [names addObject:name];
+            
+            ZIKConfigurationProperty entry = {0};
+            char *getterName = property_copyAttributeValue(property, "G");
+            entry.getter = getterName ? sel_registerName(getterName) : sel_registerName(propertyName);
+            free(getterName);
+            char *setterName = property_copyAttributeValue(property, "S");
+            if (setterName) {
+                entry.setter = sel_registerName(setterName);
+                free(setterName);
+            } else {
+                NSString *defaultSetter = [NSString stringWithFormat:@"set%@%@:", [[name substringToIndex:1] uppercaseString], [name substringFromIndex:1]];
+                entry.setter = NSSelectorFromString(defaultSetter);
+            }
+            char *type = property_copyAttributeValue(property, "T");
+            entry.kind = _propertyKindForType(type);
+            free(type);
+            if (![configClass instancesRespondToSelector:entry.getter] || ![configClass instancesRespondToSelector:entry.setter]) {
+                entry.kind = ZIKConfigurationPropertyKindKVC;
+            }
+            entry.getterIMP = class_getMethodImplementation(configClass, entry.getter);
+            entry.setterIMP = class_getMethodImplementation(configClass, entry.setter);
+            entry.key = CFBridgingRetain(name);
+            [properties addObject:[NSValue valueWithBytes:&entry objCType:@encode(ZIKConfigurationProperty)]];
+        }
+        free(propertyList);
+        aClass = class_getSuperclass(aClass);
+    }
+    ZIKConfigurationPropertyTable *table = malloc(sizeof(ZIKConfigurationPropertyTable) + properties.count * sizeof(ZIKConfigurationProperty));
+    table->count = (uint32_t)properties.count;
+    for (NSUInteger i = 0; i < properties.count; i++) {
+        [properties[i] getValue:&table->properties[i]];
+    }
+    return table;
+}
+
+/// Writable properties of the class and its superclasses until ZIKRouteConfiguration. Tables are built once for each class and never freed.
+static const ZIKConfigurationPropertyTable *_propertyTableForClass(Class configClass) {
+    static CFMutableDictionaryRef tables;
+    static dispatch_semaphore_t sema;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        tables = CFDictionaryCreateMutable(NULL, 0, NULL, NULL);
+        sema = dispatch_semaphore_create(1);
+    });
+    dispatch_semaphore_wait(sema, DISPATCH_TIME_FOREVER);
+    ZIKConfigurationPropertyTable *table = (ZIKConfigurationPropertyTable *)CFDictionaryGetValue(tables, (__bridge const void *)configClass);
+    if (table == NULL) {
+        table = _createPropertyTable(configClass);
+        CFDictionarySetValue(tables, (__bridge const void *)configClass, table);
+    }
+    dispatch_semaphore_signal(sema);
+    return table;
+}
+
 @implementation ZIKRouteConfiguration
 
 - (id)copyWithZone:(nullable NSZone *)zone {
@@ -27,48 +174,209 @@
     config.performerErrorHandler = self.performerErrorHandler;
     config.stateNotifier = self.stateNotifier;
     config._prepareDestination = self._prepareDestination;
+    config->_performerErrorHandlers = [_performerErrorHandlers mutableCopy];
     return config;
 }
 
+- (void)addPerformerErrorHandler:(ZIKRouteErrorHandler)handler {
+    NSParameterAssert(handler);
+    if (!_performerErrorHandlers) {
+        _performerErrorHandlers = [NSMutableArray array];
+    }
+    [_performerErrorHandlers addObject:[handler copy]];
+}
+
+- (NSArray<ZIKRouteErrorHandler> *)takePerformerErrorHandlers {
+    NSArray<ZIKRouteErrorHandler> *handlers = _performerErrorHandlers;
+    _performerErrorHandlers = nil;
+    return handlers;
+}
+
 - (BOOL)setPropertiesFromConfiguration:(ZIKRouteConfiguration *)configuration {
     if ([configuration isKindOfClass:[self class]] == NO) {
         NSAssert2(NO, @"Invalid configuration (%@) to copy property values to %@",[configuration class], [self class]);
         return NO;
     }
-    NSMutableArray<NSString *> *keys = [NSMutableArray array];
     Class configClass = [self class];
-    while (configClass && configClass != [ZIKRouteConfiguration class]) {
-        unsigned int count = 0;
-        objc_property_t *properties = class_copyPropertyList(configClass, &count);
-        for (int i = 0; i < count; i++) {
-            objc_property_t property = properties[i];
-            if (property) {
-                const char *readonly = property_copyAttributeValue(property, "R");
-                if (readonly) {
-                    continue;
-                }
-                const char *propertyName = property_getName(property);
-                if (propertyName == NULL) {
-                    continue;
-                }
-                NSString *name = [NSString stringWithUTF8String:propertyName];
-                if (name == nil) {
-                    continue;
-                }
-                [keys addObject:name];
+    const ZIKConfigurationPropertyTable *table = _propertyTableForClass(configClass);
+    // Getters are cached for the class, source of subclass may override them
+    BOOL sameClass = [configuration class] == configClass;
+    for (uint32_t i = 0; i < table->count; i++) {
+        const ZIKConfigurationProperty *property = &table->properties[i];
+        IMP getter = sameClass ? property->getterIMP : class_getMethodImplementation([configuration class], property->getter);
+        IMP setter = property->setterIMP;
+        switch (property->kind) {
+            case ZIKConfigurationPropertyKindObject:
+                ((void(*)(id, SEL, id))setter)(self, property->setter, ((id(*)(id, SEL))getter)(configuration, property->getter));
+                break;
+            case ZIKConfigurationPropertyKindBool:
+                ((void(*)(id, SEL, bool))setter)(self, property->setter, ((bool(*)(id, SEL))getter)(configuration, property->getter));
+                break;
+            case ZIKConfigurationPropertyKindInt8:
+                ((void(*)(id, SEL, int8_t))setter)(self, property->setter, ((int8_t(*)(id, SEL))getter)(configuration, property->getter));
+                break;
+            case ZIKConfigurationPropertyKindInt16:
+                ((void(*)(id, SEL, int16_t))setter)(self, property->setter, ((int16_t(*)(id, SEL))getter)(configuration, property->getter));
+                break;
+            case ZIKConfigurationPropertyKindInt32:
+                ((void(*)(id, SEL, int32_t))setter)(self, property->setter, ((int32_t(*)(id, SEL))getter)(configuration, property->getter));
+                break;
+            case ZIKConfigurationPropertyKindInt64:
+                ((void(*)(id, SEL, int64_t))setter)(self, property->setter, ((int64_t(*)(id, SEL))getter)(configuration, property->getter));
+                break;
+            case ZIKConfigurationPropertyKindFloat:
+                ((void(*)(id, SEL, float))setter)(self, property->setter, ((float(*)(id, SEL))getter)(configuration, property->getter));
+                break;
+            case ZIKConfigurationPropertyKindDouble:
+                ((void(*)(id, SEL, double))setter)(self, property->setter, ((double(*)(id, SEL))getter)(configuration, property->getter));
+                break;
+            case ZIKConfigurationPropertyKindKVC: {
+                NSString *key = (__bridge NSString *)property->key;
+                [self setValue:[configuration valueForKey:key] forKey:key];
+                break;
             }
         }
-        configClass = class_getSuperclass(configClass);
     }
-    
-    [self setValuesForKeysWithDictionary:[configuration dictionaryWithValuesForKeys:keys]];
     return YES;
 }
 
 @end
 
-@interface ZIKPerformRouteConfiguration()
-@property (nonatomic, strong) NSMutableDictionary<NSString *, id> *userInfo;
+/// Number of user info entries stored inline before upgrading to a dictionary.
+#define ZIKRouteUserInfoInlineCapacity 4
+
+/// User info storing a few entries inline. Most routes carry zero to three entries, so it only creates a dictionary when it grows. It's shared by copies of the configuration.
+@interface ZIKRouteUserInfo : NSObject {
+    @package
+    NSUInteger _count;
+    __strong NSString *_keys[ZIKRouteUserInfoInlineCapacity];
+    __strong id _objects[ZIKRouteUserInfoInlineCapacity];
+    /// Used instead of inline entries after upgrading.
+    NSMutableDictionary<NSString *, id> *_dictionary;
+    /// Immutable dictionary returned from `userInfo`, cleared when changed.
+    NSDictionary<NSString *, id> *_snapshot;
+}
+@end
+@implementation ZIKRouteUserInfo
+
+static inline NSUInteger _inlineIndexOfKey(ZIKRouteUserInfo *info, NSString *key) {
+    for (NSUInteger i = 0; i < info->_count; i++) {
+        NSString *k = info->_keys[i];
+        if (k == key || [k isEqualToString:key]) {
+            return i;
+        }
+    }
+    return NSNotFound;
+}
+
+- (nullable id)objectForKey:(NSString *)key {
+    if (_dictionary) {
+        return _dictionary[key];
+    }
+    NSUInteger index = _inlineIndexOfKey(self, key);
+    return index == NSNotFound ? nil : _objects[index];
+}
+
+- (void)setObject:(nullable id)object forKey:(NSString *)key {
+    _snapshot = nil;
+    if (_dictionary) {
+        _dictionary[key] = object;
+        return;
+    }
+    NSUInteger index = _inlineIndexOfKey(self, key);
+    if (index != NSNotFound) {
+        if (object) {
+            _objects[index] = object;
+            return;
+        }
+        // Move last entry into the removed slot
+        _count--;
+        _keys[index] = _keys[_count];
+        _objects[index] = _objects[_count];
+        _keys[_count] = nil;
+        _objects[_count] = nil;
+        return;
+    }
+    if (object == nil) {
+        return;
+    }
+    if (_count < ZIKRouteUserInfoInlineCapacity) {
+        _keys[_count] = [key copy];
+        _objects[_count] = object;
+        _count++;
+        return;
+    }
+    _dictionary = [self _inlineEntries];
+    _dictionary[key] = object;
+    [self _clearInlineEntries];
+}
+
+- (void)addEntriesFromDictionary:(NSDictionary<NSString *, id> *)dictionary {
+    if (_dictionary == nil && _count + dictionary.count > ZIKRouteUserInfoInlineCapacity) {
+        _dictionary = [self _inlineEntries];
+        [self _clearInlineEntries];
+    }
+    if (_dictionary) {
+        _snapshot = nil;
+        [_dictionary addEntriesFromDictionary:dictionary];
+        return;
+    }
+    [dictionary enumerateKeysAndObjectsUsingBlock:^(NSString *key, id object, BOOL *stop) {
+        [self setObject:object forKey:key];
+    }];
+}
+
+- (void)removeAllObjects {
+    _snapshot = nil;
+    [self _clearInlineEntries];
+    // Routes only carry user info from URL, so keep the inline form after removing.
+    _dictionary = nil;
+}
+
+- (NSMutableDictionary<NSString *, id> *)_inlineEntries {
+    NSMutableDictionary<NSString *, id> *entries = [NSMutableDictionary dictionaryWithCapacity:_count];
+    for (NSUInteger i = 0; i < _count; i++) {
+        entries[_keys[i]] = _objects[i];
+    }
+    return entries;
+}
+
+- (void)_clearInlineEntries {
+    for (NSUInteger i = 0; i < _count; i++) {
+        _keys[i] = nil;
+        _objects[i] = nil;
+    }
+    _count = 0;
+}
+
+- (ZIKRouteUserInfo *)storageCopy {
+    ZIKRouteUserInfo *copy = [ZIKRouteUserInfo new];
+    copy->_count = _count;
+    for (NSUInteger i = 0; i < _count; i++) {
+        copy->_keys[i] = _keys[i];
+        copy->_objects[i] = _objects[i];
+    }
+    copy->_dictionary = [_dictionary mutableCopy];
+    copy->_snapshot = _snapshot;
+    return copy;
+}
+
+- (NSDictionary<NSString *, id> *)dictionary {
+    if (_snapshot == nil) {
+        _snapshot = _dictionary ? [_dictionary copy] : [[self _inlineEntries] copy];
+    }
+    return _snapshot;
+}
+
+@end
+
+@interface ZIKPerformRouteConfiguration() {
+    NSMutableArray<void(^)(id destination)> *_performerSuccessHandlers;
+    /// Whether `userInfoStorage` is borrowed from a configuration template, and must be copied before changing.
+    BOOL _userInfoStorageBorrowed;
+}
+/// Storage of userInfo. It's a writable property, so copies of the configuration share user info.
+@property (nonatomic, strong, nullable) ZIKRouteUserInfo *userInfoStorage;
 @end
 
 @implementation ZIKPerformRouteConfiguration
@@ -81,36 +389,57 @@
     return self.successHandler;
 }
 
-- (NSMutableDictionary<NSString *, id> *)userInfo {
-    if (_userInfo == nil) {
-        _userInfo = [NSMutableDictionary dictionary];
+- (NSDictionary<NSString *, id> *)userInfo {
+    if (_userInfoStorage == nil) {
+        return @{};
+    }
+    return [_userInfoStorage dictionary];
+}
+
+- (nullable id)userInfoObjectForKey:(NSString *)key {
+    if (key == nil) {
+        return nil;
+    }
+    return [_userInfoStorage objectForKey:key];
+}
+
+/// Copy user info borrowed from a configuration template before changing it.
+static inline void _ownUserInfoStorage(ZIKPerformRouteConfiguration *configuration) {
+    if (configuration->_userInfoStorageBorrowed) {
+        configuration->_userInfoStorageBorrowed = NO;
+        configuration->_userInfoStorage = [configuration->_userInfoStorage storageCopy];
     }
-    return _userInfo;
 }
 
 - (void)addUserInfoForKey:(NSString *)key object:(id)object {
     if (key == nil) {
         return;
     }
-    if (_userInfo == nil) {
-        _userInfo = [NSMutableDictionary dictionary];
+    _ownUserInfoStorage(self);
+    if (_userInfoStorage == nil) {
+        if (object == nil) {
+            return;
+        }
+        _userInfoStorage = [ZIKRouteUserInfo new];
     }
-    _userInfo[key] = object;
+    [_userInfoStorage setObject:object forKey:key];
 }
 
 - (void)addUserInfo:(NSDictionary<NSString *, id> *)userInfo {
-    if (userInfo == nil) {
+    if (userInfo.count == 0) {
         return;
     }
-    if (_userInfo == nil) {
-        _userInfo = [NSMutableDictionary dictionary];
+    _ownUserInfoStorage(self);
+    if (_userInfoStorage == nil) {
+        _userInfoStorage = [ZIKRouteUserInfo new];
     }
-    [_userInfo addEntriesFromDictionary:userInfo];
+    [_userInfoStorage addEntriesFromDictionary:userInfo];
 }
 
 - (void)removeUserInfo {
-    if (_userInfo) {
-        [_userInfo removeAllObjects];
+    if (_userInfoStorage && (_userInfoStorage->_count > 0 || _userInfoStorage->_dictionary)) {
+        _ownUserInfoStorage(self);
+        [_userInfoStorage removeAllObjects];
     }
 }
 
@@ -120,13 +449,46 @@
     config.successHandler = self.successHandler;
     config.completionHandler = self.completionHandler;
     config.performerSuccessHandler = self.performerSuccessHandler;
+    config->_performerSuccessHandlers = [_performerSuccessHandlers mutableCopy];
+    config.prewarmKey = self.prewarmKey;
+    config.serviceScope = self.serviceScope;
+    config.coalescingKey = self.coalescingKey;
+    config.performQueue = self.performQueue;
+    config.callbackQueue = self.callbackQueue;
+    config.cancellationToken = self.cancellationToken;
+    config.destinationMakingTimeout = self.destinationMakingTimeout;
+    config.priority = self.priority;
+    config.releasesPerformHandlersWhenRouted = self.releasesPerformHandlersWhenRouted;
     config.route = self.route;
-    if (_userInfo) {
-        config.userInfo = _userInfo;
+    if (_userInfoStorage) {
+        config.userInfoStorage = _userInfoStorage;
+        config->_userInfoStorageBorrowed = _userInfoStorageBorrowed;
     }
     return config;
 }
 
+- (instancetype)templateCopy {
+    ZIKPerformRouteConfiguration *config = [self copy];
+    if (config->_userInfoStorage) {
+        config->_userInfoStorageBorrowed = YES;
+    }
+    return config;
+}
+
+- (void)addPerformerSuccessHandler:(void(^)(id destination))handler {
+    NSParameterAssert(handler);
+    if (!_performerSuccessHandlers) {
+        _performerSuccessHandlers = [NSMutableArray array];
+    }
+    [_performerSuccessHandlers addObject:[handler copy]];
+}
+
+- (NSArray<void(^)(id destination)> *)takePerformerSuccessHandlers {
+    NSArray<void(^)(id destination)> *handlers = _performerSuccessHandlers;
+    _performerSuccessHandlers = nil;
+    return handlers;
+}
+
 @end
 
 @interface ZIKServiceMakeableConfiguration ()
@@ -145,6 +507,13 @@
     return _makeDestinationWith;
 }
 
+- (nullable id)makeDestinationUsing:(id _Nullable(NS_NOESCAPE ^)(void))factory {
+    NSParameterAssert(factory);
+    id destination = factory();
+    self.makedDestination = destination;
+    return destination;
+}
+
 - (ZIKConstructBlock)constructDestination {
     if (!_constructDestination) {
         return ^{ NSAssert(NO, @"constructDestination is not set"); };
@@ -205,6 +574,11 @@
 
 @end
 
+@interface ZIKRemoveRouteConfiguration () {
+    NSMutableArray<void(^)(void)> *_performerSuccessHandlers;
+}
+@end
+
 @implementation ZIKRemoveRouteConfiguration
 
 - (id)copyWithZone:(nullable NSZone *)zone {
@@ -213,9 +587,24 @@
     config.successHandler = self.successHandler;
     config.completionHandler = self.completionHandler;
     config.performerSuccessHandler = self.performerSuccessHandler;
+    config->_performerSuccessHandlers = [_performerSuccessHandlers mutableCopy];
     return config;
 }
 
+- (void)addPerformerSuccessHandler:(void(^)(void))handler {
+    NSParameterAssert(handler);
+    if (!_performerSuccessHandlers) {
+        _performerSuccessHandlers = [NSMutableArray array];
+    }
+    [_performerSuccessHandlers addObject:[handler copy]];
+}
+
+- (NSArray<void(^)(void)> *)takePerformerSuccessHandlers {
+    NSArray<void(^)(void)> *handlers = _performerSuccessHandlers;
+    _performerSuccessHandlers = nil;
+    return handlers;
+}
+
 @end
 
 @implementation ZIKRouteStrictConfiguration
@@ -226,6 +615,10 @@
     return self;
 }
 
+- (void)unbindConfiguration {
+    _configuration = nil;
+}
+
 - (BOOL)respondsToSelector:(SEL)aSelector {
     if ([super respondsToSelector:aSelector]) {
         return YES;
@@ -307,6 +700,10 @@
     return self.configuration.userInfo;
 }
 
+- (nullable id)userInfoObjectForKey:(NSString *)key {
+    return [self.configuration userInfoObjectForKey:key];
+}
+
 - (void)addUserInfoForKey:(NSString *)key object:(id)object {
     [self.configuration addUserInfoForKey:key object:object];
 }
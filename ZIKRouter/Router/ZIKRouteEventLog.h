@@ -0,0 +1,49 @@
+//
+//  ZIKRouteEventLog.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKRouter.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Write recent route events into a file descriptor, oldest first, one event per line. It doesn't allocate memory or take locks, and only calls async-signal-safe functions, so it can be called from a crash reporter's signal handler. Events being written at the same time are skipped.
+ */
+FOUNDATION_EXTERN void zix_writeRouteEventLog(int fileDescriptor);
+
+@interface ZIKRouter (EventLog)
+
+/**
+ Recent route events for diagnosing navigation bugs in production, oldest first.
+ 
+ @discussion
+ Each state change of routers and each error passed to global error handler is recorded into a fixed-size lock-free ring buffer, which is always on and keeps the latest 256 events. An event only has time, router class, action, state and error code, such as `-1.204s AServiceRouter Routing -> Routed` or `-0.031s AViewRouter perform error 3 in Unrouted`. Time is relative to now.
+ */
+@property (class, nonatomic, readonly) NSArray<NSString *> *recentRouteEvents;
+
+/**
+ Record route operations into a trace file, for replaying real navigation sequences in benchmarks. Recording replaces the previous file and stops any previous recording.
+ 
+ @discussion
+ The recorder drains the route event ring buffer on a background queue every 250ms, and pairs the start and end of each perform and remove. Each operation is a line of `start(us) action router-class route-type duration(us) succeeded`, such as `1204331 perform AViewRouter 0 5120 1`. Route type is -1 for service routers. Start time is relative to the start of recording. Lines starting with `#` are comments.
+ 
+ The ring buffer only keeps 256 events, so events may be overwritten before being drained when routing too frequently. Overwritten events are counted at the end of the file, operations missing their start events are not recorded.
+ 
+ @param path Path of the trace file.
+ @return Whether the file is created.
+ */
++ (BOOL)startRecordingRouteOperationsToFile:(NSString *)path;
+
+/// Drain remaining events and close the trace file.
++ (void)stopRecordingRouteOperations;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,343 @@
+//
+//  ZIKRouteEventLog.m
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKRouteEventLog.h"
+#import "ZIKRouterPrivate.h"
+#import <mach/mach_time.h>
+#import <objc/runtime.h>
+#import <unistd.h>
+
+// Must be power of 2
+#define ZIX_EVENT_LOG_CAPACITY 256
+#define ZIX_EVENT_LINE_LENGTH 256
+
+typedef NS_ENUM(uint8_t, ZIKRouteEventKind) {
+    ZIKRouteEventKindState,
+    ZIKRouteEventKindPerformError,
+    ZIKRouteEventKindRemoveError,
+    ZIKRouteEventKindOtherError
+};
+
+/// Fields are written and read with relaxed atomics, and validated with sequence like a seqlock, so readers never take a half written event.
+typedef struct ZIKRouteEvent {
+    /// 0 while writing, position + 1 after written.
+    uint64_t sequence;
+    uint64_t time;
+    const char *routerName;
+    /// Address of the router, only for pairing events of the same router.
+    const void *router;
+    int64_t errorCode;
+    uint8_t kind;
+    uint8_t oldState;
+    uint8_t state;
+    /// Route type when routing or removing starts, -1 when it's unknown.
+    int8_t routeType;
+} ZIKRouteEvent;
+
+static ZIKRouteEvent _routeEvents[ZIX_EVENT_LOG_CAPACITY];
+static uint64_t _routeEventPosition;
+static mach_timebase_info_data_t _routeEventTimebase;
+
+static void _initializeRouteEventTimebase(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mach_timebase_info(&_routeEventTimebase);
+    });
+}
+
+static void _logRouteEvent(Class _Nullable routerClass, const void *_Nullable router, ZIKRouteEventKind kind, ZIKRouterState oldState, ZIKRouterState state, int64_t errorCode, NSInteger routeType) {
+    _initializeRouteEventTimebase();
+    uint64_t position = __atomic_fetch_add(&_routeEventPosition, 1, __ATOMIC_RELAXED);
+    ZIKRouteEvent *event = &_routeEvents[position & (ZIX_EVENT_LOG_CAPACITY - 1)];
+    __atomic_store_n(&event->sequence, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&event->time, mach_absolute_time(), __ATOMIC_RELAXED);
+    __atomic_store_n(&event->routerName, routerClass ? class_getName(routerClass) : "nil", __ATOMIC_RELAXED);
+    __atomic_store_n(&event->router, router, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->errorCode, errorCode, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->kind, kind, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->oldState, (uint8_t)oldState, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->state, (uint8_t)state, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->routeType, (int8_t)routeType, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->sequence, position + 1, __ATOMIC_RELEASE);
+}
+
+void zix_logRouteStateEvent(Class routerClass, const void *router, ZIKRouterState oldState, ZIKRouterState state, NSInteger routeType) {
+    _logRouteEvent(routerClass, router, ZIKRouteEventKindState, oldState, state, 0, routeType);
+}
+
+void zix_logRouteErrorEvent(Class _Nullable routerClass, ZIKRouteAction action, ZIKRouterState state, NSInteger errorCode) {
+    ZIKRouteEventKind kind = ZIKRouteEventKindOtherError;
+    if ([action isEqualToString:ZIKRouteActionPerformRoute]) {
+        kind = ZIKRouteEventKindPerformError;
+    } else if ([action isEqualToString:ZIKRouteActionRemoveRoute]) {
+        kind = ZIKRouteEventKindRemoveError;
+    }
+    _logRouteEvent(routerClass, NULL, kind, state, state, errorCode, -1);
+}
+
+/// Copy the event at position. Return false when it's overwritten or being written.
+static bool _readRouteEvent(uint64_t position, ZIKRouteEvent *copy) {
+    ZIKRouteEvent *event = &_routeEvents[position & (ZIX_EVENT_LOG_CAPACITY - 1)];
+    uint64_t sequence = __atomic_load_n(&event->sequence, __ATOMIC_ACQUIRE);
+    if (sequence != position + 1) {
+        return false;
+    }
+    copy->time = __atomic_load_n(&event->time, __ATOMIC_RELAXED);
+    copy->routerName = __atomic_load_n(&event->routerName, __ATOMIC_RELAXED);
+    copy->router = __atomic_load_n(&event->router, __ATOMIC_RELAXED);
+    copy->errorCode = __atomic_load_n(&event->errorCode, __ATOMIC_RELAXED);
+    copy->kind = __atomic_load_n(&event->kind, __ATOMIC_RELAXED);
+    copy->oldState = __atomic_load_n(&event->oldState, __ATOMIC_RELAXED);
+    copy->state = __atomic_load_n(&event->state, __ATOMIC_RELAXED);
+    copy->routeType = __atomic_load_n(&event->routeType, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&event->sequence, __ATOMIC_RELAXED) == sequence;
+}
+
+#pragma mark Formatting
+
+// Formatting doesn't use stdio, so it's async-signal-safe
+
+static size_t _appendString(char *buffer, size_t length, const char *string) {
+    while (*string && length < ZIX_EVENT_LINE_LENGTH - 1) {
+        buffer[length++] = *string++;
+    }
+    return length;
+}
+
+static size_t _appendUnsigned(char *buffer, size_t length, uint64_t value, unsigned minimumDigits) {
+    char digits[20];
+    unsigned count = 0;
+    do {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0 || count < minimumDigits);
+    while (count > 0 && length < ZIX_EVENT_LINE_LENGTH - 1) {
+        buffer[length++] = digits[--count];
+    }
+    return length;
+}
+
+static const char *_stateName(uint8_t state) {
+    static const char *const names[] = {"Unrouted", "Routing", "Routed", "Removing", "Removed"};
+    return state < sizeof(names) / sizeof(names[0]) ? names[state] : "Unknown";
+}
+
+/// Format event into a null-terminated line without newline, return its length.
+static size_t _formatRouteEvent(const ZIKRouteEvent *event, uint64_t now, char *buffer) {
+    size_t length = 0;
+    uint64_t elapsed = now > event->time ? now - event->time : 0;
+    if (_routeEventTimebase.denom) {
+        elapsed = elapsed * _routeEventTimebase.numer / _routeEventTimebase.denom;
+    }
+    uint64_t milliseconds = elapsed / NSEC_PER_MSEC;
+    length = _appendString(buffer, length, "-");
+    length = _appendUnsigned(buffer, length, milliseconds / 1000, 1);
+    length = _appendString(buffer, length, ".");
+    length = _appendUnsigned(buffer, length, milliseconds % 1000, 3);
+    length = _appendString(buffer, length, "s ");
+    length = _appendString(buffer, length, event->routerName);
+    if (event->kind == ZIKRouteEventKindState) {
+        length = _appendString(buffer, length, " ");
+        length = _appendString(buffer, length, _stateName(event->oldState));
+        length = _appendString(buffer, length, " -> ");
+        length = _appendString(buffer, length, _stateName(event->state));
+    } else {
+        const char *action = event->kind == ZIKRouteEventKindPerformError ? " perform" : event->kind == ZIKRouteEventKindRemoveError ? " remove" : "";
+        length = _appendString(buffer, length, action);
+        length = _appendString(buffer, length, " error ");
+        if (event->errorCode < 0) {
+            length = _appendString(buffer, length, "-");
+        }
+        length = _appendUnsigned(buffer, length, event->errorCode < 0 ? -(uint64_t)event->errorCode : (uint64_t)event->errorCode, 1);
+        length = _appendString(buffer, length, " in ");
+        length = _appendString(buffer, length, _stateName(event->state));
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+void zix_writeRouteEventLog(int fileDescriptor) {
+    uint64_t now = mach_absolute_time();
+    uint64_t end = __atomic_load_n(&_routeEventPosition, __ATOMIC_ACQUIRE);
+    uint64_t start = end > ZIX_EVENT_LOG_CAPACITY ? end - ZIX_EVENT_LOG_CAPACITY : 0;
+    for (uint64_t position = start; position < end; position++) {
+        ZIKRouteEvent event;
+        if (!_readRouteEvent(position, &event)) {
+            continue;
+        }
+        char line[ZIX_EVENT_LINE_LENGTH + 1];
+        size_t length = _formatRouteEvent(&event, now, line);
+        line[length++] = '\n';
+        write(fileDescriptor, line, length);
+    }
+}
+
+#pragma mark Recording
+
+#define ZIX_RECORDING_INTERVAL_MSEC 250
+
+/// Routing or removing that hasn't ended yet.
+typedef struct ZIKRouteTraceOperation {
+    uint64_t time;
+    const char *routerName;
+    int8_t routeType;
+    bool remove;
+} ZIKRouteTraceOperation;
+
+// Only accessed in recording queue
+static NSFileHandle *_recordingFile;
+static dispatch_source_t _recordingTimer;
+static uint64_t _recordingPosition;
+static uint64_t _recordingStartTime;
+static uint64_t _droppedEventCount;
+/// Router address -> ZIKRouteTraceOperation.
+static NSMutableDictionary<NSNumber *, NSValue *> *_pendingOperations;
+
+static dispatch_queue_t _routeRecordingQueue(void) {
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("com.zuik.router.route_recording", DISPATCH_QUEUE_SERIAL);
+    });
+    return queue;
+}
+
+static uint64_t _recordingMicroseconds(uint64_t time) {
+    uint64_t elapsed = time > _recordingStartTime ? time - _recordingStartTime : 0;
+    return elapsed * _routeEventTimebase.numer / _routeEventTimebase.denom / NSEC_PER_USEC;
+}
+
+static void _recordRouteEvent(const ZIKRouteEvent *event, NSMutableString *lines) {
+    if (event->kind != ZIKRouteEventKindState) {
+        return;
+    }
+    NSNumber *key = @((uintptr_t)event->router);
+    if (event->state == ZIKRouterStateRouting || event->state == ZIKRouterStateRemoving) {
+        ZIKRouteTraceOperation operation = {event->time, event->routerName, event->routeType, event->state == ZIKRouterStateRemoving};
+        _pendingOperations[key] = [NSValue valueWithBytes:&operation objCType:@encode(ZIKRouteTraceOperation)];
+        return;
+    }
+    if (event->oldState != ZIKRouterStateRouting && event->oldState != ZIKRouterStateRemoving) {
+        return;
+    }
+    NSValue *value = _pendingOperations[key];
+    if (value == nil) {
+        return;
+    }
+    [_pendingOperations removeObjectForKey:key];
+    ZIKRouteTraceOperation operation;
+    [value getValue:&operation];
+    if (operation.remove != (event->oldState == ZIKRouterStateRemoving)) {
+        return;
+    }
+    BOOL succeeded = event->state == (operation.remove ? ZIKRouterStateRemoved : ZIKRouterStateRouted);
+    uint64_t start = _recordingMicroseconds(operation.time);
+    [lines appendFormat:@"%llu %s %s %d %llu %d\n", start, operation.remove ? "remove" : "perform", operation.routerName, operation.routeType, _recordingMicroseconds(event->time) - start, succeeded];
+}
+
+/// Record events from `_recordingPosition` to the latest written event.
+static void _drainRouteEvents(void) {
+    uint64_t end = __atomic_load_n(&_routeEventPosition, __ATOMIC_ACQUIRE);
+    if (end - _recordingPosition > ZIX_EVENT_LOG_CAPACITY) {
+        _droppedEventCount += end - ZIX_EVENT_LOG_CAPACITY - _recordingPosition;
+        _recordingPosition = end - ZIX_EVENT_LOG_CAPACITY;
+    }
+    NSMutableString *lines = [NSMutableString string];
+    for (; _recordingPosition < end; _recordingPosition++) {
+        ZIKRouteEvent event;
+        if (_readRouteEvent(_recordingPosition, &event)) {
+            _recordRouteEvent(&event, lines);
+            continue;
+        }
+        ZIKRouteEvent *slot = &_routeEvents[_recordingPosition & (ZIX_EVENT_LOG_CAPACITY - 1)];
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) == 0) {
+            // Still being written, read it in next drain
+            break;
+        }
+        _droppedEventCount++;
+    }
+    if (lines.length > 0) {
+        [_recordingFile writeData:[lines dataUsingEncoding:NSUTF8StringEncoding]];
+    }
+}
+
+@implementation ZIKRouter (EventLog)
+
++ (NSArray<NSString *> *)recentRouteEvents {
+    uint64_t now = mach_absolute_time();
+    uint64_t end = __atomic_load_n(&_routeEventPosition, __ATOMIC_ACQUIRE);
+    uint64_t start = end > ZIX_EVENT_LOG_CAPACITY ? end - ZIX_EVENT_LOG_CAPACITY : 0;
+    NSMutableArray<NSString *> *events = [NSMutableArray arrayWithCapacity:(NSUInteger)(end - start)];
+    for (uint64_t position = start; position < end; position++) {
+        ZIKRouteEvent event;
+        if (!_readRouteEvent(position, &event)) {
+            continue;
+        }
+        char line[ZIX_EVENT_LINE_LENGTH + 1];
+        _formatRouteEvent(&event, now, line);
+        // Class name may be truncated in the middle of a UTF-8 character
+        NSString *description = [NSString stringWithUTF8String:line];
+        if (description) {
+            [events addObject:description];
+        }
+    }
+    return events;
+}
+
++ (BOOL)startRecordingRouteOperationsToFile:(NSString *)path {
+    [self stopRecordingRouteOperations];
+    if (![[NSFileManager defaultManager] createFileAtPath:path contents:nil attributes:nil]) {
+        return NO;
+    }
+    NSFileHandle *file = [NSFileHandle fileHandleForWritingAtPath:path];
+    if (file == nil) {
+        return NO;
+    }
+    _initializeRouteEventTimebase();
+    dispatch_queue_t queue = _routeRecordingQueue();
+    dispatch_sync(queue, ^{
+        _recordingFile = file;
+        _recordingPosition = __atomic_load_n(&_routeEventPosition, __ATOMIC_ACQUIRE);
+        _recordingStartTime = mach_absolute_time();
+        _droppedEventCount = 0;
+        _pendingOperations = [NSMutableDictionary dictionary];
+        [file writeData:[@"# ZIKRouteTrace 1: start(us) action router-class route-type duration(us) succeeded\n" dataUsingEncoding:NSUTF8StringEncoding]];
+        
+        uint64_t interval = ZIX_RECORDING_INTERVAL_MSEC * NSEC_PER_MSEC;
+        _recordingTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, queue);
+        dispatch_source_set_timer(_recordingTimer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)interval), interval, interval / 5);
+        dispatch_source_set_event_handler(_recordingTimer, ^{
+            _drainRouteEvents();
+        });
+        dispatch_resume(_recordingTimer);
+    });
+    return YES;
+}
+
++ (void)stopRecordingRouteOperations {
+    dispatch_sync(_routeRecordingQueue(), ^{
+        if (_recordingFile == nil) {
+            return;
+        }
+        dispatch_source_cancel(_recordingTimer);
+        _recordingTimer = nil;
+        _drainRouteEvents();
+        NSString *footer = [NSString stringWithFormat:@"# dropped %llu events\n", _droppedEventCount];
+        [_recordingFile writeData:[footer dataUsingEncoding:NSUTF8StringEncoding]];
+        [_recordingFile closeFile];
+        _recordingFile = nil;
+        _pendingOperations = nil;
+    });
+}
+
+@end
@@ -0,0 +1,258 @@
+//
+//  ZIKRouteMetrics.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKRouter.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Latency recorded for each router class.
+typedef NS_ENUM(NSInteger, ZIKRouteMetric) {
+    /// From beginning to perform until destination is got.
+    ZIKRouteMetricDestination,
+    /// From beginning to perform until perform is finished. For view router, it's when the transition is finished and the destination appeared.
+    ZIKRouteMetricPerform,
+    /// From beginning to remove until remove is finished.
+    ZIKRouteMetricRemove,
+    /// Only for view router. From beginning to perform until destination appeared, when UIViewController's -viewDidAppear: or UIView's -didMoveToWindow is called. It's the time user waits before destination is interactive, and may be earlier than ZIKRouteMetricPerform which waits for the transition completion.
+    ZIKRouteMetricAppear
+};
+
+/// Number of buckets in ZIKRouteLatencyHistogram.
+FOUNDATION_EXTERN const NSUInteger ZIKRouteLatencyBucketCount;
+
+/// Latency histogram with log2 buckets. Bucket 0 counts durations under 1 microsecond, bucket i counts durations in [2^(i-1), 2^i) microseconds, and the last bucket also counts all longer durations.
+@interface ZIKRouteLatencyHistogram : NSObject
+@property (nonatomic, readonly) uint64_t count;
+@property (nonatomic, readonly) NSTimeInterval totalDuration;
+@property (nonatomic, readonly) NSArray<NSNumber *> *bucketCounts;
+/// Estimated duration at the percentile in 0 ~ 100. It's the upper bound of the bucket containing the percentile. Return 0 when count is 0.
+- (NSTimeInterval)durationAtPercentile:(double)percentile;
+- (instancetype)init NS_UNAVAILABLE;
+@end
+
+/// Cumulative counters in ZIKRouterMetrics. They are always recorded with relaxed atomics, and never reset.
+typedef NS_ENUM(NSInteger, ZIKRouterCounter) {
+    /// Finding view router with protocol, identifier or destination class in ZIKViewRouteRegistry.
+    ZIKRouterCounterViewLookup,
+    /// View router lookups without any router found.
+    ZIKRouterCounterViewLookupMiss,
+    /// Finding service router with protocol, identifier or destination class in ZIKServiceRouteRegistry.
+    ZIKRouterCounterServiceLookup,
+    /// Service router lookups without any router found.
+    ZIKRouterCounterServiceLookupMiss,
+    /// Routes for destination class and adapter found in the resolved route cache after registration is finished.
+    ZIKRouterCounterResolvedRouteCacheHit,
+    /// Routes for destination class and adapter resolved and stored into the resolved route cache.
+    ZIKRouterCounterResolvedRouteCacheMiss,
+    /// ZIKRouterType created in lookup because the route doesn't have a shared one.
+    ZIKRouterCounterRouterTypeCreation,
+    /// Easy routes made from registered factories.
+    ZIKRouterCounterEasyRouteConstruction,
+    /// Steps from adapter to adaptee when resolving route for adapter.
+    ZIKRouterCounterAdapterHop,
+    /// Router instances initialized.
+    ZIKRouterCounterRouterAllocation,
+    /// Checking auto created UIView routers waiting to prepare or finish.
+    ZIKRouterCounterWaitingRouterDrain,
+    /// Waiting UIView routers removed from waiting list in the checks.
+    ZIKRouterCounterWaitingRouterDrained,
+    /// Matching url in ZIKURLRouter.
+    ZIKRouterCounterURLMatch,
+    /// Url matchings without any pattern matched.
+    ZIKRouterCounterURLMatchMiss,
+    /// Url results found in result cache of ZIKURLRouter.
+    ZIKRouterCounterURLResultCacheHit,
+    /// Url results not in result cache when the cache is enabled.
+    ZIKRouterCounterURLResultCacheMiss,
+    /// Invocations of the hooked UIKit or AppKit methods.
+    ZIKRouterCounterHookViewDidLoad,
+    ZIKRouterCounterHookViewWillAppear,
+    ZIKRouterCounterHookViewDidAppear,
+    ZIKRouterCounterHookViewWillDisappear,
+    ZIKRouterCounterHookViewDidDisappear,
+    ZIKRouterCounterHookWillMoveToParentViewController,
+    ZIKRouterCounterHookDidMoveToParentViewController,
+    ZIKRouterCounterHookWillMoveToSuperview,
+    ZIKRouterCounterHookDidMoveToSuperview,
+    ZIKRouterCounterHookWillMoveToWindow,
+    ZIKRouterCounterHookDidMoveToWindow,
+    ZIKRouterCounterHookInstantiateInitialViewController,
+    ZIKRouterCounterHookPrepareForSegue,
+    ZIKRouterCounterHookSeguePerform,
+    /// Only for AppKit.
+    ZIKRouterCounterHookPresentViewController,
+    ZIKRouterCounterHookAnimatePresentation,
+    ZIKRouterCounterHookAnimateDismissal,
+    ZIKRouterCounterHookSetContentViewController
+};
+
+/// Cumulative durations in ZIKRouterMetrics. They are only recorded when +[ZIKRouter recordsMetrics] is YES, because reading time is more expensive than counting.
+typedef NS_ENUM(NSInteger, ZIKRouterTiming) {
+    /// Lookups in ZIKViewRouteRegistry and ZIKServiceRouteRegistry.
+    ZIKRouterTimingLookup,
+    /// Url matchings in ZIKURLRouter, including result cache.
+    ZIKRouterTimingURLMatch
+};
+
+/**
+ Snapshot of cumulative counters and timings of all routers.
+ 
+ @discussion
+ Counters cost a relaxed atomic addition, so they can stay on in production. Upload the difference between two snapshots with `-metricsBySubtractingMetrics:` if you need periodic aggregates.
+ */
+@interface ZIKRouterMetrics : NSObject
+/// Take a snapshot of current values.
++ (instancetype)currentMetrics;
+- (uint64_t)valueForCounter:(ZIKRouterCounter)counter;
+/// Number of recorded durations for the timing.
+- (uint64_t)countForTiming:(ZIKRouterTiming)timing;
+/// Total of recorded durations for the timing.
+- (NSTimeInterval)durationForTiming:(ZIKRouterTiming)timing;
+/// Hits in hits and misses of resolved route cache. 0 when there is no access.
+@property (nonatomic, readonly) double resolvedRouteCacheHitRate;
+/// Hits in hits and misses of result cache of ZIKURLRouter. 0 when there is no access.
+@property (nonatomic, readonly) double urlResultCacheHitRate;
+/// Values increased since the earlier metrics.
+- (ZIKRouterMetrics *)metricsBySubtractingMetrics:(ZIKRouterMetrics *)metrics;
+/// Counters and timings with names as keys, such as `viewLookup`, `hookViewWillAppear` and `lookupDuration`, for uploading.
+- (NSDictionary<NSString *, NSNumber *> *)dictionaryRepresentation;
+- (instancetype)init NS_UNAVAILABLE;
+@end
+
+/// Profile of a hooked UIKit or AppKit method, recorded when +[ZIKRouter hookProfilingSampleInterval] is larger than 0.
+@interface ZIKRouteHookProfile : NSObject
+/// Counter of the hook, such as ZIKRouterCounterHookViewWillAppear.
+@property (nonatomic, readonly) ZIKRouterCounter hook;
+/// Name of the hook, such as `hookViewWillAppear`, same as the key in `-[ZIKRouterMetrics dictionaryRepresentation]`.
+@property (nonatomic, readonly) NSString *name;
+/// Invocations while profiling.
+@property (nonatomic, readonly) uint64_t callCount;
+/// Invocations returned without routing work, such as views not routable or already routed.
+@property (nonatomic, readonly) uint64_t earlyExitCount;
+/// Invocations doing routing work, such as notifying routers and AOP callbacks.
+@property (nonatomic, readonly) uint64_t processedCount;
+/// Timed invocations, one of every `hookProfilingSampleInterval` invocations.
+@property (nonatomic, readonly) uint64_t sampledCount;
+/// Total time of sampled invocations, excluding the original implementation of the method.
+@property (nonatomic, readonly) NSTimeInterval sampledDuration;
+/// Average duration of sampled invocations multiplied by callCount.
+@property (nonatomic, readonly) NSTimeInterval estimatedDuration;
+- (instancetype)init NS_UNAVAILABLE;
+@end
+
+/// Stages of a router instance, recorded when +[ZIKRouter recordsStageTimestamps] is YES.
+typedef NS_ENUM(NSInteger, ZIKRouterStage) {
+    /// Router is initialized.
+    ZIKRouterStageInit,
+    /// Destination is created or adopted, and attached to the router.
+    ZIKRouterStageDestinationCreated,
+    /// Destination is prepared with configuration before performing.
+    ZIKRouterStageDestinationPrepared,
+    /// State becomes routing.
+    ZIKRouterStagePerformStarted,
+    /// Performing succeeded and state becomes routed.
+    ZIKRouterStagePerformSucceeded,
+    /// Performing failed.
+    ZIKRouterStagePerformFailed,
+    /// State becomes removed.
+    ZIKRouterStageRemoved
+};
+
+/// Route callbacks watched when +[ZIKRouter slowCallbackThreshold] is larger than 0.
+typedef NS_ENUM(NSInteger, ZIKRouteCallbackStage) {
+    /// -destinationWithConfiguration: of router.
+    ZIKRouteCallbackStageDestinationWithConfiguration,
+    /// `prepareDestination` blocks of configuration.
+    ZIKRouteCallbackStagePrepareDestinationBlock,
+    /// -prepareDestination:configuration: of router.
+    ZIKRouteCallbackStagePrepareDestination,
+    /// -didFinishPrepareDestination:configuration: of router.
+    ZIKRouteCallbackStageDidFinishPrepareDestination,
+    /// -performRouteOnDestination:configuration: of router. For view router, it returns when the transition is started.
+    ZIKRouteCallbackStagePerformRouteOnDestination,
+    /// Success, error and completion handlers of provider and performer.
+    ZIKRouteCallbackStageHandlers
+};
+
+/// A route callback that ran longer than +[ZIKRouter slowCallbackThreshold].
+@interface ZIKSlowRouteCallback : NSObject
+@property (nonatomic, readonly) Class routerClass;
+@property (nonatomic, readonly) ZIKRouteCallbackStage stage;
+@property (nonatomic, readonly) NSTimeInterval duration;
+@property (nonatomic, readonly, getter=isMainThread) BOOL mainThread;
+/// Return addresses sampled from the callback's thread when it exceeded the threshold, top frame first, so they show where the callback was stuck. Empty when the callback returned before it was sampled, or the stack can't be walked on current architecture.
+@property (nonatomic, readonly) NSArray<NSNumber *> *sampledCallStack;
+/// Symbolicated `sampledCallStack`. It's slow, only read it when you need to show it.
+@property (nonatomic, readonly) NSString *sampledCallStackDescription;
+- (instancetype)init NS_UNAVAILABLE;
+@end
+
+@interface ZIKRouter (Metrics)
+
+/**
+ Whether routers record latency metrics. Default is NO.
+ 
+ @discussion
+ Latencies are recorded when router state changes, into histograms owned by the current thread, so recording doesn't use any lock. Histograms are cumulative after enabled, upload the difference between two snapshots if you need periodic aggregates.
+ 
+ It also enables timings in ZIKRouterMetrics.
+ */
+@property (class, nonatomic) BOOL recordsMetrics;
+
+/**
+ Whether routers record monotonic timestamps of their stages. Default is NO.
+ 
+ @discussion
+ Timestamps are `mach_absolute_time()` of the latest time the router reached each ZIKRouterStage, so tools can compute stage breakdowns of any router without subclassing. Routers only allocate storage for timestamps when it's YES, other routers only keep an empty pointer.
+ */
+@property (class, nonatomic) BOOL recordsStageTimestamps;
+
+/// Timestamp of the latest time the router reached the stage, in `mach_absolute_time()` units. 0 when it's not reached, or not recorded.
+- (uint64_t)timestampForStage:(ZIKRouterStage)stage;
+
+/// Seconds from one stage to another. 0 when any of them is not recorded, or toStage is earlier.
+- (NSTimeInterval)durationFromStage:(ZIKRouterStage)fromStage toStage:(ZIKRouterStage)toStage;
+
+/**
+ Threshold in seconds of the watchdog for route callbacks. Default is 0 and the watchdog is disabled.
+ 
+ @discussion
+ Each ZIKRouteCallbackStage is watched when it's larger than 0. When a callback is still running after the threshold, the call stack of its thread is sampled from a watchdog queue. When the callback returns, a ZIKSlowRouteCallback is reported to `slowCallbackHandler`.
+ 
+ Watching costs an allocation and a `dispatch_after` for each callback, so enable it in debug builds or for a sample of users. When disabled, it costs one relaxed atomic load for each callback.
+ */
+@property (class, nonatomic) NSTimeInterval slowCallbackThreshold;
+
+/// Receiver of slow callbacks, such as uploading them with metrics. It's called on a background queue.
+@property (class, nonatomic, copy, nullable) void(^slowCallbackHandler)(ZIKSlowRouteCallback *callback);
+
+/**
+ Sampling interval of the profiler for hooked UIKit and AppKit methods: -viewDidLoad, appearance methods, -willMoveToParentViewController:, -didMoveToParentViewController:, and superview and window methods of UIView. Default is 0 and the profiler is disabled.
+ 
+ @discussion
+ When it's N, every invocation of the hooks is counted as early exit or processed, and one of every N invocations is timed. Time in the original implementation is excluded, so the duration is the overhead of ZIKRouter, such as in scrolling views with many subviews. Read them with +hookProfiles.
+ 
+ Counting costs relaxed atomic additions, timing costs reading the clock 4 times. When disabled, each hook costs one relaxed atomic load.
+ */
+@property (class, nonatomic) NSUInteger hookProfilingSampleInterval;
+
+/// Profiles of hooks invoked while profiling, sorted by estimated duration in descending order. Profiles are cumulative until +resetHookProfiles.
++ (NSArray<ZIKRouteHookProfile *> *)hookProfiles;
+
+/// Clear recorded hook profiles.
++ (void)resetHookProfiles;
+
+/// Aggregate histograms of all threads, including threads already exited. Key is router class name, value's key is ZIKRouteMetric. Metrics without any record are not included.
++ (NSDictionary<NSString *, NSDictionary<NSNumber *, ZIKRouteLatencyHistogram *> *> *)metricsSnapshot;
+
+@end
+
+NS_ASSUME_NONNULL_END
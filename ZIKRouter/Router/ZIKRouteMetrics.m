@@ -0,0 +1,851 @@
+//
+//  ZIKRouteMetrics.m
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKRouteMetrics.h"
+#import "ZIKRouterPrivate.h"
+#import "ZIKRouterRuntime.h"
+#import <objc/runtime.h>
+#import <mach/mach_time.h>
+#import <mach/mach.h>
+#import <pthread.h>
+#import <sched.h>
+
+#define ZIX_BUCKET_COUNT 24
+#define ZIX_METRIC_COUNT (ZIKRouteMetricAppear + 1)
+#define ZIX_COUNTER_COUNT (ZIKRouterCounterHookSetContentViewController + 1)
+#define ZIX_TIMING_COUNT (ZIKRouterTimingURLMatch + 1)
+#define ZIX_HOOK_COUNT (ZIX_COUNTER_COUNT - ZIKRouterCounterHookViewDidLoad)
+
+const NSUInteger ZIKRouteLatencyBucketCount = ZIX_BUCKET_COUNT;
+
+static bool _recordsRouteMetrics = false;
+static bool _recordsRouterStages = false;
+
+typedef struct ZIKRouteHistogramData {
+    uint64_t count;
+    uint64_t totalNanoseconds;
+    uint32_t buckets[ZIX_BUCKET_COUNT];
+} ZIKRouteHistogramData;
+
+typedef struct ZIKRouteMetricsEntry {
+    /// Router class, published after the entry is initialized.
+    const void *key;
+    ZIKRouteHistogramData histograms[ZIX_METRIC_COUNT];
+} ZIKRouteMetricsEntry;
+
+/// Open-addressing table keyed by router class. Only its thread writes it, other threads only read it.
+typedef struct ZIKRouteMetricsTable {
+    size_t mask;
+    ZIKRouteMetricsEntry entries[];
+} ZIKRouteMetricsTable;
+
+typedef struct ZIKRouteMetricsThread {
+    struct ZIKRouteMetricsThread *next;
+    /// Replaced with a larger table when it's half full. Old tables are retired with `zix_retireSnapshot`, because other threads may be reading them.
+    ZIKRouteMetricsTable *table;
+    size_t count;
+} ZIKRouteMetricsThread;
+
+/// Guards _metricsThreads and _exitedThreadsMetrics. Only taken when a thread records its first metric, when it exits, and when taking snapshot.
+static pthread_mutex_t _metricsThreadsLock = PTHREAD_MUTEX_INITIALIZER;
+/// Threads that recorded metrics and are still alive. Removed when the thread exits.
+static ZIKRouteMetricsThread *_metricsThreads = NULL;
+/// Metrics merged from exited threads.
+static ZIKRouteMetricsThread _exitedThreadsMetrics = {0};
+static pthread_key_t _metricsThreadKey;
+static __thread ZIKRouteMetricsThread *_currentMetricsThread = NULL;
+
+static ZIKRouteMetricsTable *_createMetricsTable(size_t capacity) {
+    ZIKRouteMetricsTable *table = calloc(1, sizeof(ZIKRouteMetricsTable) + capacity * sizeof(ZIKRouteMetricsEntry));
+    table->mask = capacity - 1;
+    return table;
+}
+
+static inline size_t _slotForKey(const ZIKRouteMetricsTable *table, const void *key) {
+    uint64_t hash = (uint64_t)(uintptr_t)key * 0x9E3779B97F4A7C15ULL;
+    return (size_t)(hash >> 32) & table->mask;
+}
+
+static ZIKRouteMetricsEntry *_insertEntry(ZIKRouteMetricsTable *table, const void *key) {
+    size_t slot = _slotForKey(table, key);
+    while (table->entries[slot].key) {
+        slot = (slot + 1) & table->mask;
+    }
+    return &table->entries[slot];
+}
+
+static ZIKRouteMetricsEntry *_metricsEntry(ZIKRouteMetricsThread *thread, const void *key);
+
+static void _freeMetricsTable(void *table) {
+    free(table);
+}
+
+/// Destructor of _metricsThreadKey. Merge metrics of the exiting thread into _exitedThreadsMetrics, then free the thread's node.
+static void _metricsThreadDidExit(void *value) {
+    ZIKRouteMetricsThread *thread = value;
+    pthread_mutex_lock(&_metricsThreadsLock);
+    for (ZIKRouteMetricsThread **link = &_metricsThreads; *link; link = &(*link)->next) {
+        if (*link == thread) {
+            *link = thread->next;
+            break;
+        }
+    }
+    ZIKRouteMetricsTable *table = thread->table;
+    for (size_t slot = 0; slot <= table->mask; slot++) {
+        ZIKRouteMetricsEntry *entry = &table->entries[slot];
+        if (entry->key == NULL) {
+            continue;
+        }
+        ZIKRouteMetricsEntry *merged = _metricsEntry(&_exitedThreadsMetrics, entry->key);
+        for (size_t metric = 0; metric < ZIX_METRIC_COUNT; metric++) {
+            ZIKRouteHistogramData *source = &entry->histograms[metric];
+            ZIKRouteHistogramData *histogram = &merged->histograms[metric];
+            __atomic_store_n(&histogram->count, histogram->count + source->count, __ATOMIC_RELAXED);
+            __atomic_store_n(&histogram->totalNanoseconds, histogram->totalNanoseconds + source->totalNanoseconds, __ATOMIC_RELAXED);
+            for (size_t i = 0; i < ZIX_BUCKET_COUNT; i++) {
+                __atomic_store_n(&histogram->buckets[i], histogram->buckets[i] + source->buckets[i], __ATOMIC_RELAXED);
+            }
+        }
+    }
+    pthread_mutex_unlock(&_metricsThreadsLock);
+    // Snapshot only reads threads in the list with lock, so the node and its table can be freed now
+    free(table);
+    free(thread);
+    _currentMetricsThread = NULL;
+}
+
+static ZIKRouteMetricsThread *_metricsThread(void) {
+    ZIKRouteMetricsThread *thread = _currentMetricsThread;
+    if (thread) {
+        return thread;
+    }
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        pthread_key_create(&_metricsThreadKey, _metricsThreadDidExit);
+        pthread_mutex_lock(&_metricsThreadsLock);
+        _exitedThreadsMetrics.table = _createMetricsTable(16);
+        pthread_mutex_unlock(&_metricsThreadsLock);
+    });
+    thread = calloc(1, sizeof(ZIKRouteMetricsThread));
+    thread->table = _createMetricsTable(16);
+    pthread_mutex_lock(&_metricsThreadsLock);
+    thread->next = _metricsThreads;
+    _metricsThreads = thread;
+    pthread_mutex_unlock(&_metricsThreadsLock);
+    pthread_setspecific(_metricsThreadKey, thread);
+    _currentMetricsThread = thread;
+    return thread;
+}
+
+static ZIKRouteMetricsEntry *_metricsEntry(ZIKRouteMetricsThread *thread, const void *key) {
+    ZIKRouteMetricsTable *table = thread->table;
+    size_t slot = _slotForKey(table, key);
+    ZIKRouteMetricsEntry *entry = &table->entries[slot];
+    while (entry->key) {
+        if (entry->key == key) {
+            return entry;
+        }
+        slot = (slot + 1) & table->mask;
+        entry = &table->entries[slot];
+    }
+    // Keep load factor under 0.5
+    if ((thread->count + 1) * 2 > table->mask + 1) {
+        ZIKRouteMetricsTable *newTable = _createMetricsTable((table->mask + 1) * 2);
+        for (size_t i = 0; i <= table->mask; i++) {
+            ZIKRouteMetricsEntry *oldEntry = &table->entries[i];
+            if (oldEntry->key) {
+                *_insertEntry(newTable, oldEntry->key) = *oldEntry;
+            }
+        }
+        __atomic_store_n(&thread->table, newTable, __ATOMIC_RELEASE);
+        // Snapshot may still be reading the old table
+        zix_retireSnapshot(table, _freeMetricsTable);
+        table = newTable;
+    }
+    entry = _insertEntry(table, key);
+    thread->count++;
+    __atomic_store_n(&entry->key, key, __ATOMIC_RELEASE);
+    return entry;
+}
+
+static uint64_t _nanosecondsFromMachTime(uint64_t machTime) {
+    static mach_timebase_info_data_t timebase;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mach_timebase_info(&timebase);
+    });
+    return machTime * timebase.numer / timebase.denom;
+}
+
+static inline size_t _bucketForNanoseconds(uint64_t nanoseconds) {
+    uint64_t microseconds = nanoseconds / 1000;
+    if (microseconds == 0) {
+        return 0;
+    }
+    size_t bucket = 64 - __builtin_clzll(microseconds);
+    return bucket < ZIX_BUCKET_COUNT ? bucket : ZIX_BUCKET_COUNT - 1;
+}
+
+void zix_recordRouteMetric(Class routerClass, ZIKRouteMetric metric, uint64_t startTime) {
+    if (startTime == 0 || metric < 0 || metric >= ZIX_METRIC_COUNT) {
+        return;
+    }
+    uint64_t nanoseconds = _nanosecondsFromMachTime(mach_absolute_time() - startTime);
+    ZIKRouteMetricsEntry *entry = _metricsEntry(_metricsThread(), (__bridge const void *)routerClass);
+    ZIKRouteHistogramData *histogram = &entry->histograms[metric];
+    // Only current thread writes the entry, atomic stores keep readers from seeing torn values
+    size_t bucket = _bucketForNanoseconds(nanoseconds);
+    __atomic_store_n(&histogram->buckets[bucket], histogram->buckets[bucket] + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&histogram->totalNanoseconds, histogram->totalNanoseconds + nanoseconds, __ATOMIC_RELAXED);
+    __atomic_store_n(&histogram->count, histogram->count + 1, __ATOMIC_RELAXED);
+}
+
+uint64_t zix_routeMetricsTime(void) {
+    if (!__atomic_load_n(&_recordsRouteMetrics, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+    return mach_absolute_time();
+}
+
+uint64_t zix_routerStageTime(void) {
+    if (!__atomic_load_n(&_recordsRouterStages, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+    return mach_absolute_time();
+}
+
+uint64_t zix_routerCounters[ZIX_COUNTER_COUNT];
+
+typedef struct ZIKRouterTimingData {
+    uint64_t count;
+    uint64_t totalNanoseconds;
+} ZIKRouterTimingData;
+
+static ZIKRouterTimingData _routerTimings[ZIX_TIMING_COUNT];
+
+void zix_recordRouterTiming(ZIKRouterTiming timing, uint64_t startTime) {
+    if (startTime == 0 || timing < 0 || timing >= ZIX_TIMING_COUNT) {
+        return;
+    }
+    uint64_t nanoseconds = _nanosecondsFromMachTime(mach_absolute_time() - startTime);
+    // Count and total may be read from different records, it's acceptable for aggregates
+    __atomic_fetch_add(&_routerTimings[timing].totalNanoseconds, nanoseconds, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&_routerTimings[timing].count, 1, __ATOMIC_RELAXED);
+}
+
+static const char *const _counterNames[ZIX_COUNTER_COUNT] = {
+    [ZIKRouterCounterViewLookup] = "viewLookup",
+    [ZIKRouterCounterViewLookupMiss] = "viewLookupMiss",
+    [ZIKRouterCounterServiceLookup] = "serviceLookup",
+    [ZIKRouterCounterServiceLookupMiss] = "serviceLookupMiss",
+    [ZIKRouterCounterResolvedRouteCacheHit] = "resolvedRouteCacheHit",
+    [ZIKRouterCounterResolvedRouteCacheMiss] = "resolvedRouteCacheMiss",
+    [ZIKRouterCounterRouterTypeCreation] = "routerTypeCreation",
+    [ZIKRouterCounterEasyRouteConstruction] = "easyRouteConstruction",
+    [ZIKRouterCounterAdapterHop] = "adapterHop",
+    [ZIKRouterCounterRouterAllocation] = "routerAllocation",
+    [ZIKRouterCounterWaitingRouterDrain] = "waitingRouterDrain",
+    [ZIKRouterCounterWaitingRouterDrained] = "waitingRouterDrained",
+    [ZIKRouterCounterURLMatch] = "urlMatch",
+    [ZIKRouterCounterURLMatchMiss] = "urlMatchMiss",
+    [ZIKRouterCounterURLResultCacheHit] = "urlResultCacheHit",
+    [ZIKRouterCounterURLResultCacheMiss] = "urlResultCacheMiss",
+    [ZIKRouterCounterHookViewDidLoad] = "hookViewDidLoad",
+    [ZIKRouterCounterHookViewWillAppear] = "hookViewWillAppear",
+    [ZIKRouterCounterHookViewDidAppear] = "hookViewDidAppear",
+    [ZIKRouterCounterHookViewWillDisappear] = "hookViewWillDisappear",
+    [ZIKRouterCounterHookViewDidDisappear] = "hookViewDidDisappear",
+    [ZIKRouterCounterHookWillMoveToParentViewController] = "hookWillMoveToParentViewController",
+    [ZIKRouterCounterHookDidMoveToParentViewController] = "hookDidMoveToParentViewController",
+    [ZIKRouterCounterHookWillMoveToSuperview] = "hookWillMoveToSuperview",
+    [ZIKRouterCounterHookDidMoveToSuperview] = "hookDidMoveToSuperview",
+    [ZIKRouterCounterHookWillMoveToWindow] = "hookWillMoveToWindow",
+    [ZIKRouterCounterHookDidMoveToWindow] = "hookDidMoveToWindow",
+    [ZIKRouterCounterHookInstantiateInitialViewController] = "hookInstantiateInitialViewController",
+    [ZIKRouterCounterHookPrepareForSegue] = "hookPrepareForSegue",
+    [ZIKRouterCounterHookSeguePerform] = "hookSeguePerform",
+    [ZIKRouterCounterHookPresentViewController] = "hookPresentViewController",
+    [ZIKRouterCounterHookAnimatePresentation] = "hookAnimatePresentation",
+    [ZIKRouterCounterHookAnimateDismissal] = "hookAnimateDismissal",
+    [ZIKRouterCounterHookSetContentViewController] = "hookSetContentViewController",
+};
+
+static const char *const _timingNames[ZIX_TIMING_COUNT] = {
+    [ZIKRouterTimingLookup] = "lookup",
+    [ZIKRouterTimingURLMatch] = "urlMatch",
+};
+
+@interface ZIKRouterMetrics () {
+    uint64_t _counters[ZIX_COUNTER_COUNT];
+    ZIKRouterTimingData _timings[ZIX_TIMING_COUNT];
+}
+@end
+
+@implementation ZIKRouterMetrics
+
++ (instancetype)currentMetrics {
+    ZIKRouterMetrics *metrics = [[self alloc] _init];
+    for (size_t i = 0; i < ZIX_COUNTER_COUNT; i++) {
+        metrics->_counters[i] = __atomic_load_n(&zix_routerCounters[i], __ATOMIC_RELAXED);
+    }
+    for (size_t i = 0; i < ZIX_TIMING_COUNT; i++) {
+        metrics->_timings[i].count = __atomic_load_n(&_routerTimings[i].count, __ATOMIC_RELAXED);
+        metrics->_timings[i].totalNanoseconds = __atomic_load_n(&_routerTimings[i].totalNanoseconds, __ATOMIC_RELAXED);
+    }
+    return metrics;
+}
+
+- (instancetype)_init {
+    return [super init];
+}
+
+- (uint64_t)valueForCounter:(ZIKRouterCounter)counter {
+    if (counter < 0 || counter >= ZIX_COUNTER_COUNT) {
+        return 0;
+    }
+    return _counters[counter];
+}
+
+- (uint64_t)countForTiming:(ZIKRouterTiming)timing {
+    if (timing < 0 || timing >= ZIX_TIMING_COUNT) {
+        return 0;
+    }
+    return _timings[timing].count;
+}
+
+- (NSTimeInterval)durationForTiming:(ZIKRouterTiming)timing {
+    if (timing < 0 || timing >= ZIX_TIMING_COUNT) {
+        return 0;
+    }
+    return (NSTimeInterval)_timings[timing].totalNanoseconds / NSEC_PER_SEC;
+}
+
+static double _hitRate(uint64_t hits, uint64_t misses) {
+    if (hits + misses == 0) {
+        return 0;
+    }
+    return (double)hits / (hits + misses);
+}
+
+- (double)resolvedRouteCacheHitRate {
+    return _hitRate(_counters[ZIKRouterCounterResolvedRouteCacheHit], _counters[ZIKRouterCounterResolvedRouteCacheMiss]);
+}
+
+- (double)urlResultCacheHitRate {
+    return _hitRate(_counters[ZIKRouterCounterURLResultCacheHit], _counters[ZIKRouterCounterURLResultCacheMiss]);
+}
+
+- (ZIKRouterMetrics *)metricsBySubtractingMetrics:(ZIKRouterMetrics *)metrics {
+    NSParameterAssert(metrics);
+    ZIKRouterMetrics *difference = [[ZIKRouterMetrics alloc] _init];
+    for (size_t i = 0; i < ZIX_COUNTER_COUNT; i++) {
+        difference->_counters[i] = _counters[i] - metrics->_counters[i];
+    }
+    for (size_t i = 0; i < ZIX_TIMING_COUNT; i++) {
+        difference->_timings[i].count = _timings[i].count - metrics->_timings[i].count;
+        difference->_timings[i].totalNanoseconds = _timings[i].totalNanoseconds - metrics->_timings[i].totalNanoseconds;
+    }
+    return difference;
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)dictionaryRepresentation {
+    NSMutableDictionary<NSString *, NSNumber *> *dictionary = [NSMutableDictionary dictionaryWithCapacity:ZIX_COUNTER_COUNT + ZIX_TIMING_COUNT * 2];
+    for (size_t i = 0; i < ZIX_COUNTER_COUNT; i++) {
+        dictionary[@(_counterNames[i])] = @(_counters[i]);
+    }
+    for (size_t i = 0; i < ZIX_TIMING_COUNT; i++) {
+        dictionary[[NSString stringWithFormat:@"%sCount", _timingNames[i]]] = @(_timings[i].count);
+        dictionary[[NSString stringWithFormat:@"%sDuration", _timingNames[i]]] = @((NSTimeInterval)_timings[i].totalNanoseconds / NSEC_PER_SEC);
+    }
+    return dictionary;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%@, resolvedRouteCacheHitRate: %.3f, urlResultCacheHitRate: %.3f, %@", [super description], self.resolvedRouteCacheHitRate, self.urlResultCacheHitRate, [self dictionaryRepresentation]];
+}
+
+@end
+
+@interface ZIKRouteLatencyHistogram () {
+    ZIKRouteHistogramData _data;
+}
+@end
+
+@implementation ZIKRouteLatencyHistogram
+
+- (instancetype)initWithData:(const ZIKRouteHistogramData *)data {
+    if (self = [super init]) {
+        _data = *data;
+    }
+    return self;
+}
+
+- (uint64_t)count {
+    return _data.count;
+}
+
+- (NSTimeInterval)totalDuration {
+    return (NSTimeInterval)_data.totalNanoseconds / NSEC_PER_SEC;
+}
+
+- (NSArray<NSNumber *> *)bucketCounts {
+    NSMutableArray<NSNumber *> *counts = [NSMutableArray arrayWithCapacity:ZIX_BUCKET_COUNT];
+    for (size_t i = 0; i < ZIX_BUCKET_COUNT; i++) {
+        [counts addObject:@(_data.buckets[i])];
+    }
+    return counts;
+}
+
+- (NSTimeInterval)durationAtPercentile:(double)percentile {
+    uint64_t total = 0;
+    for (size_t i = 0; i < ZIX_BUCKET_COUNT; i++) {
+        total += _data.buckets[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    double rank = MIN(MAX(percentile, 0), 100) / 100 * total;
+    uint64_t accumulated = 0;
+    size_t bucket = 0;
+    for (; bucket < ZIX_BUCKET_COUNT - 1; bucket++) {
+        accumulated += _data.buckets[bucket];
+        if (accumulated >= rank && accumulated > 0) {
+            break;
+        }
+    }
+    return (NSTimeInterval)(1ULL << bucket) / USEC_PER_SEC;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%@, count: %llu, total: %.6f, p50: %.6f, p90: %.6f, p99: %.6f", [super description], _data.count, self.totalDuration, [self durationAtPercentile:50], [self durationAtPercentile:90], [self durationAtPercentile:99]];
+}
+
+@end
+
+#pragma mark Hook Profiler
+
+uint64_t zix_hookProfilingSampleInterval = 0;
+
+typedef struct ZIKHookProfileData {
+    uint64_t callCount;
+    uint64_t earlyExitCount;
+    uint64_t sampledCount;
+    uint64_t sampledNanoseconds;
+} ZIKHookProfileData;
+
+static ZIKHookProfileData _hookProfiles[ZIX_HOOK_COUNT];
+
+static inline ZIKHookProfileData *_hookProfileData(ZIKRouterCounter hook) {
+    NSCAssert(hook >= ZIKRouterCounterHookViewDidLoad && hook < ZIX_COUNTER_COUNT, @"Invalid hook counter %@", @(hook));
+    return &_hookProfiles[hook - ZIKRouterCounterHookViewDidLoad];
+}
+
+ZIKHookProfile zix_startHookProfile(ZIKRouterCounter hook) {
+    ZIKHookProfile profile = { hook, true };
+    uint64_t interval = __atomic_load_n(&zix_hookProfilingSampleInterval, __ATOMIC_RELAXED);
+    uint64_t callCount = __atomic_add_fetch(&_hookProfileData(hook)->callCount, 1, __ATOMIC_RELAXED);
+    if (interval > 0 && callCount % interval == 0) {
+        profile.startTime = mach_absolute_time();
+    }
+    return profile;
+}
+
+void zix_finishHookProfile(ZIKHookProfile *profile) {
+    ZIKHookProfileData *data = _hookProfileData(profile->hook);
+    if (!profile->processed) {
+        __atomic_fetch_add(&data->earlyExitCount, 1, __ATOMIC_RELAXED);
+    }
+    if (profile->startTime) {
+        uint64_t nanoseconds = _nanosecondsFromMachTime(mach_absolute_time() - profile->startTime - profile->originalDuration);
+        __atomic_fetch_add(&data->sampledNanoseconds, nanoseconds, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&data->sampledCount, 1, __ATOMIC_RELAXED);
+    }
+}
+
+uint64_t zix_hookProfileTime(void) {
+    return mach_absolute_time();
+}
+
+@interface ZIKRouteHookProfile ()
+@property (nonatomic) ZIKRouterCounter hook;
+@property (nonatomic) uint64_t callCount;
+@property (nonatomic) uint64_t earlyExitCount;
+@property (nonatomic) uint64_t sampledCount;
+@property (nonatomic) NSTimeInterval sampledDuration;
+- (instancetype)_init;
+@end
+
+@implementation ZIKRouteHookProfile
+
+- (instancetype)_init {
+    return [super init];
+}
+
+- (NSString *)name {
+    return @(_counterNames[self.hook]);
+}
+
+- (uint64_t)processedCount {
+    // Counters are read separately, invocations in progress may be counted as called but not exited yet
+    return self.callCount > self.earlyExitCount ? self.callCount - self.earlyExitCount : 0;
+}
+
+- (NSTimeInterval)estimatedDuration {
+    if (self.sampledCount == 0) {
+        return 0;
+    }
+    return self.sampledDuration / self.sampledCount * self.callCount;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%@, name: %@, callCount: %llu, earlyExitCount: %llu, sampledCount: %llu, sampledDuration: %.6f, estimatedDuration: %.6f", [super description], self.name, self.callCount, self.earlyExitCount, self.sampledCount, self.sampledDuration, self.estimatedDuration];
+}
+
+@end
+
+#pragma mark Slow Callback Watchdog
+
+#define ZIX_SAMPLED_FRAME_LIMIT 64
+
+uint64_t zix_slowCallbackThreshold = 0;
+static const void *_slowCallbackHandler = NULL;
+
+typedef NS_ENUM(int, ZIKCallbackWatchState) {
+    ZIKCallbackWatchStateRunning,
+    ZIKCallbackWatchStateSampling,
+    ZIKCallbackWatchStateSampled,
+    ZIKCallbackWatchStateFinished
+};
+
+/// Shared by the watched thread and the watchdog queue, freed by the last one releasing it.
+typedef struct ZIKCallbackWatchRecord {
+    thread_act_t thread;
+    bool mainThread;
+    uint64_t startTime;
+    int state;
+    int refCount;
+    uint32_t frameCount;
+    uintptr_t frames[ZIX_SAMPLED_FRAME_LIMIT];
+} ZIKCallbackWatchRecord;
+
+static void _releaseWatchRecord(ZIKCallbackWatchRecord *record) {
+    if (__atomic_sub_fetch(&record->refCount, 1, __ATOMIC_ACQ_REL) == 0) {
+        free(record);
+    }
+}
+
+/// Walk frame pointers of a suspended thread. It must not allocate memory, the thread may be holding the malloc lock.
+static uint32_t _sampleSuspendedThread(thread_act_t thread, uintptr_t *frames, uint32_t limit) {
+#if defined(__arm64__) || defined(__x86_64__)
+    uintptr_t pc, fp;
+    // Return address of a leaf function is only in lr
+    uintptr_t lr = 0;
+#if defined(__arm64__)
+    arm_thread_state64_t state;
+    mach_msg_type_number_t stateCount = ARM_THREAD_STATE64_COUNT;
+    if (thread_get_state(thread, ARM_THREAD_STATE64, (thread_state_t)&state, &stateCount) != KERN_SUCCESS) {
+        return 0;
+    }
+#ifdef arm_thread_state64_get_pc
+    pc = arm_thread_state64_get_pc(state);
+    lr = arm_thread_state64_get_lr(state);
+    fp = arm_thread_state64_get_fp(state);
+#else
+    pc = state.__pc;
+    lr = state.__lr;
+    fp = state.__fp;
+#endif
+    // Strip pointer authentication bits
+    const uintptr_t addressMask = 0x0000000FFFFFFFFFULL;
+#else
+    x86_thread_state64_t state;
+    mach_msg_type_number_t stateCount = x86_THREAD_STATE64_COUNT;
+    if (thread_get_state(thread, x86_THREAD_STATE64, (thread_state_t)&state, &stateCount) != KERN_SUCCESS) {
+        return 0;
+    }
+    pc = state.__rip;
+    fp = state.__rbp;
+    const uintptr_t addressMask = UINTPTR_MAX;
+#endif
+    uint32_t count = 0;
+    frames[count++] = pc & addressMask;
+    if (lr) {
+        frames[count++] = lr & addressMask;
+    }
+    while (fp && count < limit) {
+        uintptr_t frame[2];
+        vm_size_t size = 0;
+        // Frame pointers may be invalid in code built without them, read with the kernel rather than dereferencing
+        if (vm_read_overwrite(mach_task_self(), (vm_address_t)fp, sizeof(frame), (vm_address_t)frame, &size) != KERN_SUCCESS || size != sizeof(frame)) {
+            break;
+        }
+        if (frame[1] == 0) {
+            break;
+        }
+        frames[count++] = frame[1] & addressMask;
+        // Caller's frame is at higher address
+        if (frame[0] <= fp) {
+            break;
+        }
+        fp = frame[0];
+    }
+    return count;
+#else
+    return 0;
+#endif
+}
+
+static void _sampleWatchedThread(void *context) {
+    ZIKCallbackWatchRecord *record = context;
+    int expected = ZIKCallbackWatchStateRunning;
+    // The thread is still in the callback until state is changed back from sampling
+    if (__atomic_compare_exchange_n(&record->state, &expected, ZIKCallbackWatchStateSampling, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        if (thread_suspend(record->thread) == KERN_SUCCESS) {
+            record->frameCount = _sampleSuspendedThread(record->thread, record->frames, ZIX_SAMPLED_FRAME_LIMIT);
+            thread_resume(record->thread);
+        }
+        __atomic_store_n(&record->state, ZIKCallbackWatchStateSampled, __ATOMIC_RELEASE);
+    }
+    _releaseWatchRecord(record);
+}
+
+static dispatch_queue_t _watchdogQueue(void) {
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = zix_createSerialQueueWithQOS("com.zuik.router.callback_watchdog", QOS_CLASS_USER_INTERACTIVE);
+    });
+    return queue;
+}
+
+void *zix_beginWatchingCallback(void) {
+    uint64_t threshold = __atomic_load_n(&zix_slowCallbackThreshold, __ATOMIC_RELAXED);
+    if (threshold == 0) {
+        return NULL;
+    }
+    ZIKCallbackWatchRecord *record = calloc(1, sizeof(ZIKCallbackWatchRecord));
+    record->thread = pthread_mach_thread_np(pthread_self());
+    record->mainThread = pthread_main_np() != 0;
+    record->refCount = 2;
+    record->startTime = mach_absolute_time();
+    dispatch_after_f(dispatch_time(DISPATCH_TIME_NOW, (int64_t)threshold), _watchdogQueue(), record, _sampleWatchedThread);
+    return record;
+}
+
+@interface ZIKSlowRouteCallback ()
+@property (nonatomic) Class routerClass;
+@property (nonatomic) ZIKRouteCallbackStage stage;
+@property (nonatomic) NSTimeInterval duration;
+@property (nonatomic, getter=isMainThread) BOOL mainThread;
+@property (nonatomic, copy) NSArray<NSNumber *> *sampledCallStack;
+- (instancetype)_init;
+@end
+
+void zix_finishWatchingCallback(void *context, Class routerClass, ZIKRouteCallbackStage stage) {
+    ZIKCallbackWatchRecord *record = context;
+    uint64_t nanoseconds = _nanosecondsFromMachTime(mach_absolute_time() - record->startTime);
+    int state = __atomic_load_n(&record->state, __ATOMIC_ACQUIRE);
+    while (state != ZIKCallbackWatchStateSampled) {
+        if (state == ZIKCallbackWatchStateRunning &&
+            __atomic_compare_exchange_n(&record->state, &state, ZIKCallbackWatchStateFinished, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+        if (state == ZIKCallbackWatchStateSampling) {
+            // Watchdog already resumed this thread and is publishing the sample
+            sched_yield();
+            state = __atomic_load_n(&record->state, __ATOMIC_ACQUIRE);
+        }
+    }
+    void(^handler)(ZIKSlowRouteCallback *) = zix_loadGlobalErrorHandler(&_slowCallbackHandler);
+    uint64_t threshold = __atomic_load_n(&zix_slowCallbackThreshold, __ATOMIC_RELAXED);
+    if (handler && threshold > 0 && nanoseconds >= threshold) {
+        NSMutableArray<NSNumber *> *callStack = [NSMutableArray arrayWithCapacity:record->frameCount];
+        if (state == ZIKCallbackWatchStateSampled) {
+            for (uint32_t i = 0; i < record->frameCount; i++) {
+                [callStack addObject:@(record->frames[i])];
+            }
+        }
+        ZIKSlowRouteCallback *callback = [[ZIKSlowRouteCallback alloc] _init];
+        callback.routerClass = routerClass;
+        callback.stage = stage;
+        callback.duration = (NSTimeInterval)nanoseconds / NSEC_PER_SEC;
+        callback.mainThread = record->mainThread;
+        callback.sampledCallStack = callStack;
+        dispatch_async(zix_globalQueueWithQOS(QOS_CLASS_UTILITY), ^{
+            handler(callback);
+        });
+    }
+    _releaseWatchRecord(record);
+}
+
+@implementation ZIKSlowRouteCallback
+
+- (instancetype)_init {
+    return [super init];
+}
+
+- (NSString *)sampledCallStackDescription {
+    return zix_symbolicateCallStack(self.sampledCallStack);
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%@, routerClass: %@, stage: %@, duration: %.6f, mainThread: %@, sampledCallStack: %@", [super description], NSStringFromClass(self.routerClass), @(self.stage), self.duration, self.mainThread ? @"YES" : @"NO", self.sampledCallStackDescription];
+}
+
+@end
+
+@implementation ZIKRouter (Metrics)
+
++ (BOOL)recordsMetrics {
+    return __atomic_load_n(&_recordsRouteMetrics, __ATOMIC_RELAXED);
+}
+
++ (void)setRecordsMetrics:(BOOL)recordsMetrics {
+    __atomic_store_n(&_recordsRouteMetrics, (bool)recordsMetrics, __ATOMIC_RELAXED);
+}
+
++ (BOOL)recordsStageTimestamps {
+    return __atomic_load_n(&_recordsRouterStages, __ATOMIC_RELAXED);
+}
+
++ (void)setRecordsStageTimestamps:(BOOL)recordsStageTimestamps {
+    __atomic_store_n(&_recordsRouterStages, (bool)recordsStageTimestamps, __ATOMIC_RELAXED);
+}
+
++ (NSTimeInterval)slowCallbackThreshold {
+    return (NSTimeInterval)__atomic_load_n(&zix_slowCallbackThreshold, __ATOMIC_RELAXED) / NSEC_PER_SEC;
+}
+
++ (void)setSlowCallbackThreshold:(NSTimeInterval)slowCallbackThreshold {
+    uint64_t nanoseconds = slowCallbackThreshold > 0 ? (uint64_t)(slowCallbackThreshold * NSEC_PER_SEC) : 0;
+    __atomic_store_n(&zix_slowCallbackThreshold, nanoseconds, __ATOMIC_RELAXED);
+}
+
++ (void (^)(ZIKSlowRouteCallback * _Nonnull))slowCallbackHandler {
+    return zix_loadGlobalErrorHandler(&_slowCallbackHandler);
+}
+
++ (void)setSlowCallbackHandler:(void (^)(ZIKSlowRouteCallback * _Nonnull))slowCallbackHandler {
+    // Read without lock when callbacks finish, publish it like global error handler
+    zix_publishGlobalErrorHandler(&_slowCallbackHandler, slowCallbackHandler);
+}
+
++ (NSUInteger)hookProfilingSampleInterval {
+    return (NSUInteger)__atomic_load_n(&zix_hookProfilingSampleInterval, __ATOMIC_RELAXED);
+}
+
++ (void)setHookProfilingSampleInterval:(NSUInteger)hookProfilingSampleInterval {
+    __atomic_store_n(&zix_hookProfilingSampleInterval, (uint64_t)hookProfilingSampleInterval, __ATOMIC_RELAXED);
+}
+
++ (NSArray<ZIKRouteHookProfile *> *)hookProfiles {
+    NSMutableArray<ZIKRouteHookProfile *> *profiles = [NSMutableArray array];
+    for (NSInteger hook = ZIKRouterCounterHookViewDidLoad; hook < ZIX_COUNTER_COUNT; hook++) {
+        ZIKHookProfileData *data = _hookProfileData(hook);
+        uint64_t callCount = __atomic_load_n(&data->callCount, __ATOMIC_RELAXED);
+        if (callCount == 0) {
+            continue;
+        }
+        ZIKRouteHookProfile *profile = [[ZIKRouteHookProfile alloc] _init];
+        profile.hook = hook;
+        profile.callCount = callCount;
+        profile.earlyExitCount = __atomic_load_n(&data->earlyExitCount, __ATOMIC_RELAXED);
+        profile.sampledCount = __atomic_load_n(&data->sampledCount, __ATOMIC_RELAXED);
+        profile.sampledDuration = (NSTimeInterval)__atomic_load_n(&data->sampledNanoseconds, __ATOMIC_RELAXED) / NSEC_PER_SEC;
+        [profiles addObject:profile];
+    }
+    [profiles sortUsingComparator:^NSComparisonResult(ZIKRouteHookProfile * _Nonnull profile1, ZIKRouteHookProfile * _Nonnull profile2) {
+        return [@(profile2.estimatedDuration) compare:@(profile1.estimatedDuration)];
+    }];
+    return profiles;
+}
+
++ (void)resetHookProfiles {
+    for (size_t i = 0; i < ZIX_HOOK_COUNT; i++) {
+        __atomic_store_n(&_hookProfiles[i].callCount, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&_hookProfiles[i].earlyExitCount, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&_hookProfiles[i].sampledCount, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&_hookProfiles[i].sampledNanoseconds, 0, __ATOMIC_RELAXED);
+    }
+}
+
+- (uint64_t)timestampForStage:(ZIKRouterStage)stage {
+    return zix_routerStageTimestamp(self, stage);
+}
+
+- (NSTimeInterval)durationFromStage:(ZIKRouterStage)fromStage toStage:(ZIKRouterStage)toStage {
+    uint64_t fromTime = zix_routerStageTimestamp(self, fromStage);
+    uint64_t toTime = zix_routerStageTimestamp(self, toStage);
+    if (fromTime == 0 || toTime < fromTime) {
+        return 0;
+    }
+    return (NSTimeInterval)_nanosecondsFromMachTime(toTime - fromTime) / NSEC_PER_SEC;
+}
+
+static void _aggregateMetricsOfThread(ZIKRouteMetricsThread *thread, NSMutableDictionary<NSValue *, NSMutableData *> *aggregates) {
+    ZIKRouteMetricsTable *table = __atomic_load_n(&thread->table, __ATOMIC_ACQUIRE);
+    if (table == NULL) {
+        return;
+    }
+    for (size_t slot = 0; slot <= table->mask; slot++) {
+        ZIKRouteMetricsEntry *entry = &table->entries[slot];
+        const void *key = __atomic_load_n(&entry->key, __ATOMIC_ACQUIRE);
+        if (key == NULL) {
+            continue;
+        }
+        NSValue *classKey = [NSValue valueWithPointer:key];
+        NSMutableData *aggregate = aggregates[classKey];
+        if (aggregate == nil) {
+            aggregate = [NSMutableData dataWithLength:sizeof(ZIKRouteHistogramData) * ZIX_METRIC_COUNT];
+            aggregates[classKey] = aggregate;
+        }
+        ZIKRouteHistogramData *histograms = aggregate.mutableBytes;
+        for (size_t metric = 0; metric < ZIX_METRIC_COUNT; metric++) {
+            ZIKRouteHistogramData *source = &entry->histograms[metric];
+            histograms[metric].count += __atomic_load_n(&source->count, __ATOMIC_RELAXED);
+            histograms[metric].totalNanoseconds += __atomic_load_n(&source->totalNanoseconds, __ATOMIC_RELAXED);
+            for (size_t i = 0; i < ZIX_BUCKET_COUNT; i++) {
+                histograms[metric].buckets[i] += __atomic_load_n(&source->buckets[i], __ATOMIC_RELAXED);
+            }
+        }
+    }
+}
+
++ (NSDictionary<NSString *, NSDictionary<NSNumber *, ZIKRouteLatencyHistogram *> *> *)metricsSnapshot {
+    NSMutableDictionary<NSValue *, NSMutableData *> *aggregates = [NSMutableDictionary dictionary];
+    // Threads keep writing their tables without lock, replaced tables are freed after leaving snapshot reading
+    zix_beginSnapshotReading();
+    pthread_mutex_lock(&_metricsThreadsLock);
+    for (ZIKRouteMetricsThread *thread = _metricsThreads; thread; thread = thread->next) {
+        _aggregateMetricsOfThread(thread, aggregates);
+    }
+    _aggregateMetricsOfThread(&_exitedThreadsMetrics, aggregates);
+    pthread_mutex_unlock(&_metricsThreadsLock);
+    zix_endSnapshotReading();
+    
+    NSMutableDictionary<NSString *, NSDictionary<NSNumber *, ZIKRouteLatencyHistogram *> *> *snapshot = [NSMutableDictionary dictionaryWithCapacity:aggregates.count];
+    [aggregates enumerateKeysAndObjectsUsingBlock:^(NSValue * _Nonnull classKey, NSMutableData * _Nonnull aggregate, BOOL * _Nonnull stop) {
+        const ZIKRouteHistogramData *histograms = aggregate.bytes;
+        NSMutableDictionary<NSNumber *, ZIKRouteLatencyHistogram *> *metrics = [NSMutableDictionary dictionary];
+        for (NSInteger metric = 0; metric < ZIX_METRIC_COUNT; metric++) {
+            if (histograms[metric].count > 0) {
+                metrics[@(metric)] = [[ZIKRouteLatencyHistogram alloc] initWithData:&histograms[metric]];
+            }
+        }
+        if (metrics.count > 0) {
+            Class routerClass = (__bridge Class)classKey.pointerValue;
+            snapshot[NSStringFromClass(routerClass)] = metrics;
+        }
+    }];
+    return snapshot;
+}
+
+@end
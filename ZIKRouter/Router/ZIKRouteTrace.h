@@ -0,0 +1,44 @@
+//
+//  ZIKRouteTrace.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKRouter.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Set this environment variable to a file path, then registration is traced from its beginning, and the trace is written into the file.
+FOUNDATION_EXTERN NSString *const ZIKRouteTraceOutputEnvironmentKey;
+
+@interface ZIKRouter (Trace)
+
+/**
+ Start recording trace events into a file with Chrome Trace Event JSON format. Open the file with Perfetto or chrome://tracing.
+
+ @discussion
+ Events include registration stages, each registry's +handleEnumerateRouterClass:, +didFinishRegistration and validation, performing and removing of each router, and hooked UIKit or AppKit methods. Events are written into a lock-free ring buffer, and flushed into the file on a background queue. Events are dropped when the buffer is full.
+
+ To trace registration at launch, set environment variable `ZIKROUTER_TRACE_OUTPUT` rather than calling this.
+
+ @param path The file path. Existing file is replaced.
+ @return NO when it's already tracing or the file can't be created.
+ */
++ (BOOL)startTracingToFile:(NSString *)path;
+
+/// Flush remaining events and close the file. Do nothing when it's not tracing.
++ (void)stopTracing;
+
+@property (class, nonatomic, readonly, getter=isTracing) BOOL tracing;
+
+/// Events dropped because the buffer was full, since the first tracing.
+@property (class, nonatomic, readonly) uint64_t droppedTraceEventCount;
+
+@end
+
+NS_ASSUME_NONNULL_END
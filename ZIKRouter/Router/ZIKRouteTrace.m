@@ -0,0 +1,286 @@
+//
+//  ZIKRouteTrace.m
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKRouteTrace.h"
+#import "ZIKRouterPrivate.h"
+#import "ZIKRouterRuntime.h"
+#import <mach/mach_time.h>
+#import <pthread.h>
+#import <unistd.h>
+
+NSString *const ZIKRouteTraceOutputEnvironmentKey = @"ZIKROUTER_TRACE_OUTPUT";
+
+// Must be power of 2
+#define ZIX_TRACE_BUFFER_CAPACITY 4096
+#define ZIX_TRACE_TEXT_LENGTH 96
+#define ZIX_TRACE_FLUSH_INTERVAL (500 * NSEC_PER_MSEC)
+
+typedef struct ZIKTraceEvent {
+    /// Position + 1 after the event is written, position + capacity after it's flushed.
+    uint64_t sequence;
+    uint64_t startTime;
+    uint64_t endTime;
+    uint64_t threadID;
+    const char *category;
+    char name[ZIX_TRACE_TEXT_LENGTH];
+    char detail[ZIX_TRACE_TEXT_LENGTH];
+} ZIKTraceEvent;
+
+bool zix_routeTracing = false;
+
+/// Bounded multi-producer ring buffer. Producers claim positions with CAS, the flush queue is the only consumer.
+static ZIKTraceEvent *_traceEvents;
+static uint64_t _traceEnqueuePosition;
+/// Only accessed on _traceQueue.
+static uint64_t _traceDequeuePosition;
+static uint64_t _droppedTraceEvents;
+static uint64_t _mainThreadID;
+static __thread uint64_t _currentTraceThreadID;
+
+/// Lock for starting and stopping.
+static pthread_mutex_t _traceLock = PTHREAD_MUTEX_INITIALIZER;
+static dispatch_queue_t _traceQueue;
+static dispatch_source_t _traceTimer;
+/// Below are only accessed on _traceQueue.
+static FILE *_traceFile;
+static uint64_t _traceBaseTime;
+static BOOL _hasWrittenTraceEvent;
+
+static double _microsecondsFromMachTime(uint64_t machTime) {
+    static mach_timebase_info_data_t timebase;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mach_timebase_info(&timebase);
+    });
+    return (double)machTime * timebase.numer / timebase.denom / NSEC_PER_USEC;
+}
+
+static uint64_t _traceThreadID(void) {
+    uint64_t threadID = _currentTraceThreadID;
+    if (threadID == 0) {
+        pthread_threadid_np(NULL, &threadID);
+        _currentTraceThreadID = threadID;
+        if (pthread_main_np()) {
+            __atomic_store_n(&_mainThreadID, threadID, __ATOMIC_RELAXED);
+        }
+    }
+    return threadID;
+}
+
+/// Copy text with at most ZIX_TRACE_TEXT_LENGTH - 1 bytes, without breaking a UTF-8 character.
+static void _copyTraceText(char *destination, const char *_Nullable source) {
+    if (source == NULL) {
+        destination[0] = '\0';
+        return;
+    }
+    size_t length = strlen(source);
+    if (length >= ZIX_TRACE_TEXT_LENGTH) {
+        length = ZIX_TRACE_TEXT_LENGTH - 1;
+        while (length > 0 && ((unsigned char)source[length] & 0xC0) == 0x80) {
+            length--;
+        }
+    }
+    memcpy(destination, source, length);
+    destination[length] = '\0';
+}
+
+uint64_t zix_traceTime(void) {
+    if (!zix_isTracing()) {
+        return 0;
+    }
+    return mach_absolute_time();
+}
+
+void zix_traceComplete(const char *name, const char *category, uint64_t startTime, const char *detail) {
+    if (startTime == 0) {
+        return;
+    }
+    uint64_t endTime = mach_absolute_time();
+    uint64_t position = __atomic_load_n(&_traceEnqueuePosition, __ATOMIC_RELAXED);
+    ZIKTraceEvent *event;
+    while (true) {
+        event = &_traceEvents[position & (ZIX_TRACE_BUFFER_CAPACITY - 1)];
+        uint64_t sequence = __atomic_load_n(&event->sequence, __ATOMIC_ACQUIRE);
+        int64_t difference = (int64_t)(sequence - position);
+        if (difference == 0) {
+            if (__atomic_compare_exchange_n(&_traceEnqueuePosition, &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The slot is not flushed yet, don't wait for the flush queue
+            __atomic_fetch_add(&_droppedTraceEvents, 1, __ATOMIC_RELAXED);
+            return;
+        } else {
+            position = __atomic_load_n(&_traceEnqueuePosition, __ATOMIC_RELAXED);
+        }
+    }
+    event->startTime = startTime;
+    event->endTime = endTime;
+    event->threadID = _traceThreadID();
+    event->category = category;
+    _copyTraceText(event->name, name);
+    _copyTraceText(event->detail, detail);
+    __atomic_store_n(&event->sequence, position + 1, __ATOMIC_RELEASE);
+}
+
+static void _writeJSONString(FILE *file, const char *string) {
+    fputc('"', file);
+    for (const unsigned char *c = (const unsigned char *)string; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', file);
+            fputc(*c, file);
+        } else if (*c < 0x20) {
+            fprintf(file, "\\u%04x", *c);
+        } else {
+            fputc(*c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+static void _beginTraceRecord(void) {
+    fputs(_hasWrittenTraceEvent ? ",\n" : "\n", _traceFile);
+    _hasWrittenTraceEvent = YES;
+}
+
+static void _writeTraceEvent(const ZIKTraceEvent *event) {
+    FILE *file = _traceFile;
+    _beginTraceRecord();
+    fputs("{\"name\":", file);
+    _writeJSONString(file, event->name);
+    fputs(",\"cat\":", file);
+    _writeJSONString(file, event->category);
+    fprintf(file, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%llu",
+            _microsecondsFromMachTime(event->startTime - _traceBaseTime),
+            _microsecondsFromMachTime(event->endTime - event->startTime),
+            getpid(), event->threadID);
+    if (event->detail[0] != '\0') {
+        fputs(",\"args\":{\"detail\":", file);
+        _writeJSONString(file, event->detail);
+        fputc('}', file);
+    }
+    fputc('}', file);
+}
+
+static void _writeNameMetadata(const char *metadataName, uint64_t threadID, const char *name) {
+    FILE *file = _traceFile;
+    _beginTraceRecord();
+    fprintf(file, "{\"name\":\"%s\",\"ph\":\"M\",\"pid\":%d,\"tid\":%llu,\"args\":{\"name\":", metadataName, getpid(), threadID);
+    _writeJSONString(file, name);
+    fputs("}}", file);
+}
+
+/// Write published events in order. Events before current recording are skipped, they were racing with the previous stopping.
+static void _flushTraceEvents(void) {
+    uint64_t position = _traceDequeuePosition;
+    while (true) {
+        ZIKTraceEvent *event = &_traceEvents[position & (ZIX_TRACE_BUFFER_CAPACITY - 1)];
+        uint64_t sequence = __atomic_load_n(&event->sequence, __ATOMIC_ACQUIRE);
+        if (sequence != position + 1) {
+            break;
+        }
+        if (_traceFile && event->startTime >= _traceBaseTime) {
+            _writeTraceEvent(event);
+        }
+        __atomic_store_n(&event->sequence, position + ZIX_TRACE_BUFFER_CAPACITY, __ATOMIC_RELEASE);
+        position++;
+    }
+    _traceDequeuePosition = position;
+    if (_traceFile) {
+        fflush(_traceFile);
+    }
+}
+
+void zix_startTracingFromEnvironment(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *path = [NSProcessInfo processInfo].environment[ZIKRouteTraceOutputEnvironmentKey];
+        if (path.length > 0) {
+            [ZIKRouter startTracingToFile:path];
+        }
+    });
+}
+
+@implementation ZIKRouter (Trace)
+
++ (BOOL)startTracingToFile:(NSString *)path {
+    NSParameterAssert(path);
+    if (path.length == 0) {
+        return NO;
+    }
+    pthread_mutex_lock(&_traceLock);
+    if (_traceTimer) {
+        pthread_mutex_unlock(&_traceLock);
+        return NO;
+    }
+    FILE *file = fopen(path.fileSystemRepresentation, "w");
+    if (file == NULL) {
+        pthread_mutex_unlock(&_traceLock);
+        return NO;
+    }
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _traceEvents = calloc(ZIX_TRACE_BUFFER_CAPACITY, sizeof(ZIKTraceEvent));
+        for (uint64_t i = 0; i < ZIX_TRACE_BUFFER_CAPACITY; i++) {
+            _traceEvents[i].sequence = i;
+        }
+        _traceQueue = zix_createSerialQueueWithQOS("com.zuik.router.trace", QOS_CLASS_UTILITY);
+    });
+    dispatch_sync(_traceQueue, ^{
+        _traceFile = file;
+        _traceBaseTime = mach_absolute_time();
+        _hasWrittenTraceEvent = NO;
+        // Perfetto and chrome://tracing accept the array without `]`, so the file is valid even if the app is killed
+        fputc('[', file);
+        _writeNameMetadata("process_name", 0, [NSProcessInfo processInfo].processName.UTF8String ?: "");
+    });
+    _traceTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, _traceQueue);
+    dispatch_source_set_timer(_traceTimer, dispatch_time(DISPATCH_TIME_NOW, ZIX_TRACE_FLUSH_INTERVAL), ZIX_TRACE_FLUSH_INTERVAL, ZIX_TRACE_FLUSH_INTERVAL / 5);
+    dispatch_source_set_event_handler(_traceTimer, ^{
+        _flushTraceEvents();
+    });
+    dispatch_resume(_traceTimer);
+    __atomic_store_n(&zix_routeTracing, true, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&_traceLock);
+    return YES;
+}
+
++ (void)stopTracing {
+    pthread_mutex_lock(&_traceLock);
+    if (_traceTimer == nil) {
+        pthread_mutex_unlock(&_traceLock);
+        return;
+    }
+    __atomic_store_n(&zix_routeTracing, false, __ATOMIC_RELEASE);
+    dispatch_source_cancel(_traceTimer);
+    _traceTimer = nil;
+    dispatch_sync(_traceQueue, ^{
+        _flushTraceEvents();
+        uint64_t mainThreadID = __atomic_load_n(&_mainThreadID, __ATOMIC_RELAXED);
+        if (mainThreadID) {
+            _writeNameMetadata("thread_name", mainThreadID, "main");
+        }
+        fputs("\n]\n", _traceFile);
+        fclose(_traceFile);
+        _traceFile = NULL;
+    });
+    pthread_mutex_unlock(&_traceLock);
+}
+
++ (BOOL)isTracing {
+    return zix_isTracing();
+}
+
++ (uint64_t)droppedTraceEventCount {
+    return __atomic_load_n(&_droppedTraceEvents, __ATOMIC_RELAXED);
+}
+
+@end
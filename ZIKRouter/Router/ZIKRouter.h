@@ -14,6 +14,28 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/// Compact handle of an interned identifier, from `+[ZIKRouter handleForIdentifier:]`. 0 is invalid.
+typedef uint32_t ZIKRouteIdentifierHandle;
+
+/**
+ Entry of a static factory table, registering a destination protocol with destination class and factory function. Classes and protocols are referenced by name, so a table can be a `static const` array in read-only data, such as one emitted by code generation.
+ 
+ @code
+ static const ZIKDestinationFactoryEntry kServiceFactories[] = {
+    {"LoginServiceInput", "LoginService", makeLoginService},
+    {"PayServiceInput", "PayService", makePayService},
+ };
+ @endcode
+ */
+typedef struct ZIKDestinationFactoryEntry {
+    /// Name of the protocol conformed by destination. The protocol must be adopted by some class or referenced with @protocol, so it exists at runtime.
+    const char *protocolName;
+    /// Name of the destination class, used with objc_getClass.
+    const char *destinationClassName;
+    /// Function creating the destination.
+    id _Nullable (*factory)(ZIKPerformRouteConfiguration *config);
+} ZIKDestinationFactoryEntry;
+
 /// Enable this to check whether all routers and routable protocols are properly implemented. If you want to disable this checking, add ZIKROUTER_CHECK=0 in Build Settings -> Preprocessor Macros of ZIKRouter target.
 #ifdef DEBUG
 #ifndef ZIKROUTER_CHECK
@@ -23,6 +45,44 @@ NS_ASSUME_NONNULL_BEGIN
 #define ZIKROUTER_CHECK 0
 #endif
 
+/**
+ Validation of route configurations that only catches programmer errors, such as unsupported route type, wrong source class, missing segue identifier or popover source, and bad destination returned from -destinationWithConfiguration:. Default is 1. Add ZIKROUTER_VALIDATE_CONFIGURATION=0 in Build Settings -> Preprocessor Macros of ZIKRouter target for release builds to compile them away.
+ 
+ Checks about current runtime state are always kept, such as whether source is dealloced, whether source is still in navigation stack or window hierarchy, and whether source already presented another view.
+ */
+#ifndef ZIKROUTER_VALIDATE_CONFIGURATION
+#define ZIKROUTER_VALIDATE_CONFIGURATION 1
+#endif
+
+/**
+ Install hooks of UIKit and AppKit only when features need them. Default is 0, and all hooks are installed in +load of ZIKViewRouter. Add ZIKROUTER_SELECTIVE_HOOKS=1 in Build Settings -> Preprocessor Macros of ZIKRouter target to enable it.
+ 
+ When it's enabled, view controller hooks are installed when view routers are registered, UIView/NSView hooks are installed only when any UIView/NSView destination is registered, and segue hooks are installed when the first storyboard is created. Destinations appearing before their hooks are installed are not tracked, so finish registration before showing any UI.
+ */
+#ifndef ZIKROUTER_SELECTIVE_HOOKS
+#define ZIKROUTER_SELECTIVE_HOOKS 0
+#endif
+
+/// Assert when a route exceeds `+performBudget` of its router in DEBUG. Default is 0, and it only logs a warning. Add ZIKROUTER_ASSERT_PERFORM_BUDGET=1 in Build Settings -> Preprocessor Macros of ZIKRouter target to enable it.
+#ifndef ZIKROUTER_ASSERT_PERFORM_BUDGET
+#define ZIKROUTER_ASSERT_PERFORM_BUDGET 0
+#endif
+
+@class ZIKRouter;
+
+/// A state change of a router, delivered to global state observers in batches.
+@interface ZIKRouterStateEvent : NSObject
+/// The router changing state. It's nil when router is already released before delivering.
+@property (nonatomic, readonly, weak, nullable) ZIKRouter *router;
+@property (nonatomic, readonly, unsafe_unretained) Class routerClass;
+@property (nonatomic, readonly, assign) ZIKRouterState oldState;
+@property (nonatomic, readonly, assign) ZIKRouterState state;
+/// Time of the change from CFAbsoluteTimeGetCurrent().
+@property (nonatomic, readonly, assign) CFAbsoluteTime timestamp;
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+@end
+
 /**
  Abstract superclass for router that can perform route and remove route.
  @note
@@ -57,6 +117,45 @@ NS_ASSUME_NONNULL_BEGIN
 - (instancetype)init NS_UNAVAILABLE;
 + (instancetype)new NS_UNAVAILABLE;
 
+#pragma mark State
+
+/**
+ Observe state changes of this router. Handlers are invoked in adding order on the thread changing the state, after `configuration.stateNotifier`.
+ 
+ @discussion
+ It's cheaper than observing `state` with KVO. Router stores its KVO observation info itself, and only sends KVO notifications for `state`, `preState` and `destination` when there is any KVO observer.
+
+ @param handler Handler for state changes. Use weakSelf in handler to avoid retain cycle.
+ @return Token for removing the handler with -removeStateObserver:.
+ */
+- (id)addStateObserver:(void(^)(ZIKRouterState oldState, ZIKRouterState newState))handler;
+
+/// Remove handler with the token from -addStateObserver:.
+- (void)removeStateObserver:(id)observer;
+
+/**
+ Observe state changes of all routers of this class and its subclasses. Events are delivered asynchronously in batches, so observers don't add latency to transitions.
+ 
+ @discussion
+ Routers append events to a pending buffer and schedule one delivery when the buffer becomes non-empty. Events changed before the delivery runs are delivered together, in changing order. When there is no global observer, changing state only checks a pointer.
+
+ @param handler Handler for a batch of events.
+ @param queue Queue to invoke handler. Default is a serial background queue shared by all global observers.
+ @return Token for removing the handler with +removeGlobalStateObserver:.
+ */
++ (id)addGlobalStateObserver:(void(^)(NSArray<ZIKRouterStateEvent *> *events))handler queue:(nullable dispatch_queue_t)queue;
+
+/// Remove handler with the token from +addGlobalStateObserver:queue:. Batches already dispatched to the observer's queue may still be delivered.
++ (void)removeGlobalStateObserver:(id)observer;
+
+/**
+ Whether perform and remove requests are queued while the router is routing or removing. Default is NO, and these requests fail at once.
+ 
+ @discussion
+ When it's YES, requests from -performRouteWithSuccessHandler:errorHandler:, -removeRouteWithSuccessHandler:errorHandler: and the methods based on them are queued during a transition, and executed in order on main queue after the state settles. -removeRouteWithConfiguring: and -removeRouteWithStrictConfiguring: build their configurations at once and queue them. A queued perform followed by a remove cancel out: both are dropped, and their error handlers get ZIKRouteErrorActionFailed. Requests still queued when the router is prepared for reuse also fail with ZIKRouteErrorActionFailed.
+ */
+@property (nonatomic, assign) BOOL queuesRequests;
+
 #pragma mark Perform
 
 /// Whether the router can perform route now.
@@ -129,6 +228,9 @@ NS_ASSUME_NONNULL_BEGIN
 /// Whether the destination is instantiated synchronously.
 + (BOOL)canMakeDestinationSynchronously;
 
+/// Cancel making destination in background when the router's +makesDestinationInBackground is YES. Performing fails with ZIKRouteErrorActionFailed on main thread, and the destination made later is dropped. Return NO when the router is not making destination.
+- (BOOL)cancelMakingDestination;
+
 /// The router may can't make destination synchronously, or it's not for providing a destination but only for performing some actions.
 + (BOOL)canMakeDestination;
 
@@ -149,6 +251,69 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (nullable Destination)makeDestinationWithStrictConfiguring:(void(NS_NOESCAPE ^ _Nullable)(ZIKPerformRouteStrictConfiguration<Destination> *config, RouteConfig module))configBuilder;
 
+#pragma mark Prewarm
+
+/**
+ Create destination ahead of time for a navigation that is likely to happen, such as detail page of a product in the list. The destination is kept in a bounded cache, and adopted by the next performing of this router class whose `configuration.prewarmKey` is the same key, instead of calling -destinationWithConfiguration: again.
+ 
+ @discussion
+ Call it when app is idle, such as after the list finished displaying. The destination is only created with the configuration, it's still prepared when performing. Each prewarmed destination is adopted once. Least recently prewarmed destination is discarded when there are more than 8 prewarmed destinations. View routers should call it on main thread.
+ 
+ @param key Identity of the destination, such as product id. It's also set to `config.prewarmKey` before configBuilder is called.
+ @param configBuilder Builder for configuration making the destination.
+ */
++ (void)prewarmDestinationForKey:(NSString *)key configuring:(void(NS_NOESCAPE ^ _Nullable)(RouteConfig config))configBuilder;
+
+/// Discard prewarmed destination of this router class for the key.
++ (void)discardPrewarmedDestinationForKey:(NSString *)key;
+
+/// Discard all prewarmed destinations, such as when receiving memory warning.
++ (void)discardPrewarmedDestinations;
+
+/**
+ Release caches of all routers, such as url matching results, idle routers, reusable containers, prewarmed and preloaded destinations. Must be called on main thread.
+ 
+ @discussion
+ It's called automatically when receiving memory warning, or when memory pressure is critical on macOS. Call it when app needs the memory for other work, such as before processing large images.
+ */
++ (void)trimCaches;
+
+/**
+ Run warming work when main run loop is idle, such as resolving router types, creating easy routes, making destinations for caches or compiling URL patterns, so its cost is moved out of launch and first interaction. Can be called on any thread.
+ 
+ @discussion
+ Work runs on main thread before main run loop is going to sleep in default mode, one work in each idle pass, after routes with higher `ZIKRoutePriority`. When `inBackground` is YES, the work is dispatched to a serial utility queue at that time instead, so it doesn't block main thread. Only use it for thread-safe work. Work runs in FIFO order.
+ 
+ @param work Warming work. Keep each work small, such as warming one router.
+ @param inBackground Whether to run the work on a background queue.
+ */
++ (void)warmWhenIdle:(void(^)(void))work inBackground:(BOOL)inBackground;
+
+#pragma mark Router of Destination
+
+/**
+ Find the router currently managing the destination, without scanning your own records of routers.
+ 
+ @discussion
+ The destination is bound to the router when it's attached in performing, and unbound when the route is removed or the router is reused. Destinations from `+makeDestination` and its variants are not bound, because their routers are discarded after making. References to destinations and routers are weak, so their lifetime is not extended. When the destination is performed again by another router, the later router is returned.
+ 
+ When called by a subclass, only router of the class or its subclasses is returned.
+ 
+ @param destination The destination from a router.
+ @return The router managing the destination, or nil when the destination is not managed by any router now.
+ */
++ (nullable instancetype)routerForDestination:(id)destination;
+
+#pragma mark Identifier Handle
+
+/**
+ Get the compact handle of an identifier. Identifiers are interned when they are registered, and the handle of the same identifier never changes in the process. Keep the handle and find routers with `ZIKViewRouter.toIdentifierHandle` or `ZIKServiceRouter.toIdentifierHandle`, then lookup doesn't hash the string again.
+ 
+ @param identifier Identifier registered with +registerIdentifier: or URL pattern.
+ @return Handle of the identifier. It's interned when it's not registered yet, so handles can be prepared before registration.
+ */
++ (ZIKRouteIdentifierHandle)handleForIdentifier:(NSString *)identifier;
+
 #pragma mark Debug
 
 + (NSString *)descriptionOfState:(ZIKRouterState)state;
@@ -13,7 +13,15 @@
 #import "ZIKRouterInternal.h"
 #import "ZIKRouterPrivate.h"
 #import "ZIKRouteConfigurationPrivate.h"
+#import "ZIKRoutePrivate.h"
+#import "ZIKRouteSignpost.h"
+#import "ZIKRouterLog.h"
+#import "ZIKRouteScheduler.h"
+#import "ZIKRouteCacheTrimmer.h"
+#import "ZIKRouterRuntime.h"
 #import <objc/runtime.h>
+#import <pthread.h>
+#import <execinfo.h>
 
 ZIKRouteAction const ZIKRouteActionInit = @"ZIKRouteActionInit";
 ZIKRouteAction const ZIKRouteActionPerformRoute = @"ZIKRouteActionPerformRoute";
@@ -21,12 +29,426 @@ ZIKRouteAction const ZIKRouteActionRemoveRoute = @"ZIKRouteActionRemoveRoute";
 
 NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
 
+#pragma mark Lazy Error
+
+/// Error building its localized description only when it's read. Failure paths usually end with `error.code` checks, so formatting router descriptions and call stacks is wasted work.
+@interface ZIKLazyDescriptionError : NSError {
+    NSString *(^_descriptionProvider)(void);
+    NSDictionary *_resolvedUserInfo;
+    dispatch_semaphore_t _resolveSema;
+}
+@end
+@implementation ZIKLazyDescriptionError
+
+- (instancetype)initWithDomain:(NSErrorDomain)domain code:(NSInteger)code descriptionProvider:(NSString *(^)(void))provider {
+    if (self = [super initWithDomain:domain code:code userInfo:nil]) {
+        _descriptionProvider = [provider copy];
+        _resolveSema = dispatch_semaphore_create(1);
+    }
+    return self;
+}
+
+- (NSDictionary<NSErrorUserInfoKey, id> *)userInfo {
+    dispatch_semaphore_wait(_resolveSema, DISPATCH_TIME_FOREVER);
+    if (_resolvedUserInfo == nil) {
+        NSString *description = _descriptionProvider ? _descriptionProvider() : nil;
+        _resolvedUserInfo = @{NSLocalizedDescriptionKey: description ?: @""};
+        _descriptionProvider = nil;
+    }
+    NSDictionary *userInfo = _resolvedUserInfo;
+    dispatch_semaphore_signal(_resolveSema);
+    return userInfo;
+}
+
+- (NSString *)localizedDescription {
+    return self.userInfo[NSLocalizedDescriptionKey];
+}
+
+@end
+
+NSString *zix_routerDescription(ZIKRouter *_Nullable router, Class routerClass, const void *address) {
+    if (router) {
+        return [router description];
+    }
+    return [NSString stringWithFormat:@"<%@: %p> (deallocated)", NSStringFromClass(routerClass), address];
+}
+
+NSString *zix_symbolicateCallStack(NSArray<NSNumber *> *returnAddresses) {
+    NSUInteger count = returnAddresses.count;
+    if (count == 0) {
+        return @"()";
+    }
+    void **frames = malloc(sizeof(void *) * count);
+    for (NSUInteger i = 0; i < count; i++) {
+        frames[i] = (void *)(uintptr_t)[returnAddresses[i] unsignedLongLongValue];
+    }
+    char **symbols = backtrace_symbols(frames, (int)count);
+    NSMutableArray<NSString *> *lines = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; symbols && i < count; i++) {
+        [lines addObject:@(symbols[i])];
+    }
+    free(symbols);
+    free(frames);
+    return [lines description];
+}
+
+static void _releaseGlobalErrorHandler(void *handler) {
+    CFRelease(handler);
+}
+
+void zix_publishGlobalErrorHandler(const void **slot, id handler) {
+    const void *published = handler ? CFBridgingRetain([handler copy]) : NULL;
+    const void *previous = __atomic_exchange_n(slot, published, __ATOMIC_ACQ_REL);
+    if (previous) {
+        // Readers may be retaining previous handler, release it after they leave
+        zix_retireSnapshot((void *)previous, _releaseGlobalErrorHandler);
+    }
+}
+
+static __thread BOOL _probingCanRemove;
+
+BOOL zix_isProbingCanRemove(void) {
+    return _probingCanRemove;
+}
+
+/// Returned by -checkCanRemove inside -canRemove, the reason is discarded.
+NSString *const ZIKRouterCanNotRemoveMessage = @"Router can't remove";
+
+#pragma mark State Events
+
+@interface ZIKRouterStateEvent ()
+- (instancetype)initWithRouter:(ZIKRouter *)router oldState:(ZIKRouterState)oldState state:(ZIKRouterState)state;
+@end
+@implementation ZIKRouterStateEvent
+
+- (instancetype)initWithRouter:(ZIKRouter *)router oldState:(ZIKRouterState)oldState state:(ZIKRouterState)state {
+    if (self = [super init]) {
+        _router = router;
+        _routerClass = [router class];
+        _oldState = oldState;
+        _state = state;
+        _timestamp = CFAbsoluteTimeGetCurrent();
+    }
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p, routerClass: %@, oldState: %ld, state: %ld, timestamp: %f>", NSStringFromClass([self class]), self, NSStringFromClass(_routerClass), (long)_oldState, (long)_state, _timestamp];
+}
+
+@end
+
+@interface ZIKGlobalStateObserver : NSObject
+@property (nonatomic, unsafe_unretained) Class routerClass;
+@property (nonatomic, copy) void(^handler)(NSArray<ZIKRouterStateEvent *> *events);
+@property (nonatomic, strong, nullable) dispatch_queue_t queue;
+@end
+@implementation ZIKGlobalStateObserver
+@end
+
+/// Immutable array of ZIKGlobalStateObserver, NULL when there is no observer. Replaced arrays are not released, because delivering may still be enumerating them.
+static const void *_globalStateObservers;
+static dispatch_semaphore_t _globalStateObserversSema;
+/// Events waiting for delivery, guarded by _pendingStateEventsSema. It's nil when a delivery is not scheduled.
+static NSMutableArray<ZIKRouterStateEvent *> *_pendingStateEvents;
+static dispatch_semaphore_t _pendingStateEventsSema;
+static dispatch_queue_t _stateEventsQueue;
+
+void (*zix_serviceDependencyWarmer)(ZIKRouter *router);
+
+static inline BOOL _hasGlobalStateObservers(void) {
+    return __atomic_load_n(&_globalStateObservers, __ATOMIC_RELAXED) != NULL;
+}
+
+static void _deliverPendingStateEvents(void) {
+    dispatch_semaphore_wait(_pendingStateEventsSema, DISPATCH_TIME_FOREVER);
+    NSArray<ZIKRouterStateEvent *> *events = _pendingStateEvents;
+    _pendingStateEvents = nil;
+    dispatch_semaphore_signal(_pendingStateEventsSema);
+    
+    NSArray<ZIKGlobalStateObserver *> *observers = (__bridge NSArray *)__atomic_load_n(&_globalStateObservers, __ATOMIC_ACQUIRE);
+    Class ZIKRouterClass = [ZIKRouter class];
+    for (ZIKGlobalStateObserver *observer in observers) {
+        NSArray<ZIKRouterStateEvent *> *batch = events;
+        Class routerClass = observer.routerClass;
+        if (routerClass != ZIKRouterClass) {
+            NSMutableArray<ZIKRouterStateEvent *> *filtered = [NSMutableArray array];
+            for (ZIKRouterStateEvent *event in events) {
+                if ([event.routerClass isSubclassOfClass:routerClass]) {
+                    [filtered addObject:event];
+                }
+            }
+            batch = filtered;
+        }
+        if (batch.count == 0) {
+            continue;
+        }
+        void(^handler)(NSArray<ZIKRouterStateEvent *> *) = observer.handler;
+        if (observer.queue) {
+            dispatch_async(observer.queue, ^{
+                handler(batch);
+            });
+        } else {
+            handler(batch);
+        }
+    }
+}
+
+static void _enqueueStateEvent(ZIKRouter *router, ZIKRouterState oldState, ZIKRouterState state) {
+    ZIKRouterStateEvent *event = [[ZIKRouterStateEvent alloc] initWithRouter:router oldState:oldState state:state];
+    BOOL scheduling = NO;
+    dispatch_semaphore_wait(_pendingStateEventsSema, DISPATCH_TIME_FOREVER);
+    if (_pendingStateEvents == nil) {
+        _pendingStateEvents = [NSMutableArray array];
+        scheduling = YES;
+    }
+    [_pendingStateEvents addObject:event];
+    dispatch_semaphore_signal(_pendingStateEventsSema);
+    if (scheduling) {
+        dispatch_async(_stateEventsQueue, ^{
+            _deliverPendingStateEvents();
+        });
+    }
+}
+
+#pragma mark Interceptor Chain
+
+/// Immutable interceptors of a point, in invoking order.
+typedef struct ZIKRouteInterceptorChain {
+    NSUInteger count;
+    /// Handler blocks retained by the chain.
+    const void *handlers[];
+} ZIKRouteInterceptorChain;
+
+/// NULL when the point has no interceptor, so routers only load and branch.
+static ZIKRouteInterceptorChain *_Nullable _interceptorChains[ZIKRouteInterceptionPointCount];
+
+@interface ZIKRouteInterceptorEntry : NSObject
+@property (nonatomic, assign) ZIKRouteInterceptionPoint point;
+@property (nonatomic, assign) NSInteger priority;
+@property (nonatomic, assign, nullable) const void *key;
+@property (nonatomic, copy) id handler;
+@end
+@implementation ZIKRouteInterceptorEntry
+@end
+
+static inline ZIKRouteInterceptorChain *_Nullable _interceptorChain(ZIKRouteInterceptionPoint point) {
+    return __atomic_load_n(&_interceptorChains[point], __ATOMIC_ACQUIRE);
+}
+
+void zix_setRouteInterceptor(ZIKRouteInterceptionPoint point, id _Nullable handler, NSInteger priority, const void *_Nullable key) {
+    NSCParameterAssert(point < ZIKRouteInterceptionPointCount);
+    NSCParameterAssert(handler || key);
+    if (point >= ZIKRouteInterceptionPointCount) {
+        return;
+    }
+    static dispatch_semaphore_t sema;
+    // Entries of all points in adding order
+    static NSMutableArray<ZIKRouteInterceptorEntry *> *entries;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sema = dispatch_semaphore_create(1);
+        entries = [NSMutableArray array];
+    });
+    dispatch_semaphore_wait(sema, DISPATCH_TIME_FOREVER);
+    if (key) {
+        NSUInteger index = [entries indexOfObjectPassingTest:^BOOL(ZIKRouteInterceptorEntry *entry, NSUInteger idx, BOOL *stop) {
+            return entry.point == point && entry.key == key;
+        }];
+        if (index != NSNotFound) {
+            [entries removeObjectAtIndex:index];
+        }
+    }
+    if (handler) {
+        ZIKRouteInterceptorEntry *entry = [ZIKRouteInterceptorEntry new];
+        entry.point = point;
+        entry.priority = priority;
+        entry.key = key;
+        entry.handler = handler;
+        [entries addObject:entry];
+    }
+    
+    NSMutableArray<ZIKRouteInterceptorEntry *> *pointEntries = [NSMutableArray array];
+    for (ZIKRouteInterceptorEntry *entry in entries) {
+        if (entry.point == point) {
+            [pointEntries addObject:entry];
+        }
+    }
+    // Stable sort keeps adding order for same priority
+    [pointEntries sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(ZIKRouteInterceptorEntry *entry1, ZIKRouteInterceptorEntry *entry2) {
+        if (entry1.priority == entry2.priority) {
+            return NSOrderedSame;
+        }
+        return entry1.priority > entry2.priority ? NSOrderedAscending : NSOrderedDescending;
+    }];
+    ZIKRouteInterceptorChain *chain = NULL;
+    if (pointEntries.count > 0) {
+        chain = malloc(sizeof(ZIKRouteInterceptorChain) + pointEntries.count * sizeof(void *));
+        chain->count = pointEntries.count;
+        for (NSUInteger i = 0; i < pointEntries.count; i++) {
+            chain->handlers[i] = CFBridgingRetain(pointEntries[i].handler);
+        }
+    }
+    // Old chain may be still being read by routers on other threads, so it's not freed
+    __atomic_store_n(&_interceptorChains[point], chain, __ATOMIC_RELEASE);
+    dispatch_semaphore_signal(sema);
+}
+
+static void _interceptWithConfiguration(ZIKRouteInterceptorChain *chain, ZIKRouter *router, ZIKPerformRouteConfiguration *configuration) {
+    for (NSUInteger i = 0; i < chain->count; i++) {
+        void(^interceptor)(ZIKRouter *, ZIKPerformRouteConfiguration *) = (__bridge id)chain->handlers[i];
+        interceptor(router, configuration);
+    }
+}
+
+/// Interceptors before performing can cancel the configuration's cancellation token, then interceptors after it are skipped.
+static void _interceptBeforePerform(ZIKRouteInterceptorChain *chain, ZIKRouter *router, ZIKPerformRouteConfiguration *configuration) {
+    for (NSUInteger i = 0; i < chain->count; i++) {
+        void(^interceptor)(ZIKRouter *, ZIKPerformRouteConfiguration *) = (__bridge id)chain->handlers[i];
+        interceptor(router, configuration);
+        if (configuration.cancellationToken.isCancelled) {
+            return;
+        }
+    }
+}
+
+static void _interceptWithAction(ZIKRouteInterceptorChain *chain, ZIKRouter *router, ZIKRouteAction routeAction) {
+    for (NSUInteger i = 0; i < chain->count; i++) {
+        void(^interceptor)(ZIKRouter *, ZIKRouteAction) = (__bridge id)chain->handlers[i];
+        interceptor(router, routeAction);
+    }
+}
+
+static void _interceptWithError(ZIKRouteInterceptorChain *chain, ZIKRouter *router, NSError *error) {
+    for (NSUInteger i = 0; i < chain->count; i++) {
+        void(^interceptor)(ZIKRouter *, NSError *) = (__bridge id)chain->handlers[i];
+        interceptor(router, error);
+    }
+}
+
+static id _Nullable _takePrewarmedDestination(Class routerClass, NSString *key);
+
+/// Depth of synchronous performing, removing and making on current thread. Routers performing each other in a cycle keep increasing it.
+static __thread NSInteger _recursiveDepth = 0;
+static const NSInteger ZIKMaxRecursiveDepth = 200;
+
+static inline void _leaveRecursiveScope(NSInteger *depth) {
+    NSCAssert(_recursiveDepth == *depth, @"Recursive scope must be left on the thread entering it");
+    _recursiveDepth--;
+}
+
+/// Increase depth until the end of current scope. Depth is only counted while the caller is on the stack, so routes ending on another thread, such as routes making destination in background or performing in performQueue, don't leak depth of the worker thread.
+#define ZIX_RECURSIVE_SCOPE \
+    __attribute__((cleanup(_leaveRecursiveScope), unused)) NSInteger _zix_recursiveDepth = ++_recursiveDepth
+
+/// Router's state and previous state are packed into one word, so a transition is a single compare-and-swap.
+static inline uint64_t _stateWordWithState(ZIKRouterState state, ZIKRouterState preState) {
+    return (uint64_t)(uint32_t)state | ((uint64_t)(uint32_t)preState << 32);
+}
+
+static inline ZIKRouterState _stateFromWord(uint64_t word) {
+    return (ZIKRouterState)(uint32_t)word;
+}
+
+static inline ZIKRouterState _preStateFromWord(uint64_t word) {
+    return (ZIKRouterState)(uint32_t)(word >> 32);
+}
+
+/// Transitions of routers observed with KVO check and change the state under this lock, so observers only get notifications for real changes. Recursive for observers changing the state again.
+static pthread_mutex_t _observedStateLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER;
+
+#pragma mark Router of Destination
+
+/// key: destination, value: router managing it. Both are weak.
+static NSMapTable *_destinationToRouterTable;
+static dispatch_semaphore_t _destinationToRouterSema;
+
+static void _initDestinationToRouterTable(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _destinationToRouterTable = [NSMapTable weakToWeakObjectsMapTable];
+        _destinationToRouterSema = dispatch_semaphore_create(1);
+    });
+}
+
+static void _bindDestinationToRouter(id destination, ZIKRouter *router) {
+    _initDestinationToRouterTable();
+    dispatch_semaphore_wait(_destinationToRouterSema, DISPATCH_TIME_FOREVER);
+    [_destinationToRouterTable setObject:router forKey:destination];
+    dispatch_semaphore_signal(_destinationToRouterSema);
+}
+
+/// Only unbind when the destination is still bound to the router, it may be performed by another router later.
+static void _unbindDestinationFromRouter(id _Nullable destination, ZIKRouter *router) {
+    if (destination == nil) {
+        return;
+    }
+    _initDestinationToRouterTable();
+    dispatch_semaphore_wait(_destinationToRouterSema, DISPATCH_TIME_FOREVER);
+    if ([_destinationToRouterTable objectForKey:destination] == router) {
+        [_destinationToRouterTable removeObjectForKey:destination];
+    }
+    dispatch_semaphore_signal(_destinationToRouterSema);
+}
+
+/// Perform or remove request queued while the router is routing or removing.
+@interface ZIKQueuedRouteRequest : NSObject
+@property (nonatomic, copy) ZIKRouteAction action;
+@property (nonatomic, copy, nullable) id successHandler;
+@property (nonatomic, copy, nullable) void(^errorHandler)(ZIKRouteAction routeAction, NSError *error);
+/// Remove configuration built by -removeRouteWithConfiguring: or -removeRouteWithStrictConfiguring: when the request is queued.
+@property (nonatomic, strong, nullable) ZIKRemoveRouteConfiguration *removeConfiguration;
+@end
+@implementation ZIKQueuedRouteRequest
+
+- (void)failWithError:(NSError *)error {
+    if (self.errorHandler) {
+        self.errorHandler(self.action, error);
+    }
+    ZIKRemoveRouteConfiguration *configuration = self.removeConfiguration;
+    if (configuration.errorHandler) {
+        configuration.errorHandler(self.action, error);
+    }
+    if (configuration.performerErrorHandler) {
+        configuration.performerErrorHandler(self.action, error);
+    }
+    if (configuration.completionHandler) {
+        configuration.completionHandler(NO, self.action, error);
+    }
+}
+
+@end
+
 @interface ZIKRouter () {
-    dispatch_semaphore_t _stateSema;
     __weak id _destination;
-    ZIKRouterState _preState;
+    /// State in low 32 bits and previous state in high 32 bits.
+    uint64_t _stateWord;
+    /// KVO observation info stored in the router instead of the global table, so state changes only check it for sending KVO.
+    void *_observationInfo;
+    /// Token of current making destination in background, 0 when not making. Finishing, cancelling and timeout claim it by swapping it to 0.
+    uint64_t _makingDestinationToken;
+    /// Start time of performing and removing for metrics, 0 when not recording.
+    uint64_t _performStartTime;
+    uint64_t _removeStartTime;
+    /// Start time of performing and removing for trace events, 0 when not tracing.
+    uint64_t _performTraceTime;
+    uint64_t _removeTraceTime;
+    /// Requests waiting for current transition when queuesRequests is YES, guarded by @synchronized(self).
+    NSMutableArray<ZIKQueuedRouteRequest *> *_queuedRequests;
+    /// Whether a request popped from _queuedRequests hasn't started yet, guarded by @synchronized(self). New requests are queued behind it.
+    BOOL _startingQueuedRequest;
+    /// Timestamps indexed by ZIKRouterStage, only allocated when recording stages.
+    uint64_t *_stageTimestamps;
+    /// Strict configuration kept by pooled router for making destination, rebound to each new configuration instead of allocating a new one.
+    ZIKPerformRouteStrictConfiguration *_reusableStrictConfiguration;
+#ifdef DEBUG
+    /// Time of beginning to perform and attaching destination for checking +performBudget, 0 when there is no budget.
+    CFAbsoluteTime _budgetStartTime;
+    CFAbsoluteTime _budgetDestinationTime;
+#endif
 }
-@property (nonatomic, assign) ZIKRouterState state;
+/// Handlers from -addStateObserver:, replaced with a new array when changed.
+@property (atomic, copy, nullable) NSArray<void(^)(ZIKRouterState, ZIKRouterState)> *stateObservers;
 @property (nonatomic, strong, nullable) NSError *error;
 @property (nonatomic, copy) ZIKPerformRouteConfiguration *configuration;
 @property (nonatomic, copy, nullable) ZIKRemoveRouteConfiguration *removeConfiguration;
@@ -35,21 +457,92 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
 @implementation ZIKRouter
 @dynamic globalErrorHandler;
 
+#define ZIX_ROUTER_STAGE_COUNT (ZIKRouterStageRemoved + 1)
+
+static void _recordRouterStage(ZIKRouter *router, ZIKRouterStage stage) {
+    uint64_t time = zix_routerStageTime();
+    if (time == 0) {
+        return;
+    }
+    uint64_t *timestamps = __atomic_load_n(&router->_stageTimestamps, __ATOMIC_ACQUIRE);
+    if (timestamps == NULL) {
+        // Background making may attach destination while another thread is recording
+        uint64_t *newTimestamps = calloc(ZIX_ROUTER_STAGE_COUNT, sizeof(uint64_t));
+        if (__atomic_compare_exchange_n(&router->_stageTimestamps, &timestamps, newTimestamps, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            timestamps = newTimestamps;
+        } else {
+            free(newTimestamps);
+        }
+    }
+    __atomic_store_n(&timestamps[stage], time, __ATOMIC_RELAXED);
+}
+
+#ifdef DEBUG
+static void _checkPerformBudget(ZIKRouter *router) {
+    CFAbsoluteTime startTime = router->_budgetStartTime;
+    if (startTime == 0) {
+        return;
+    }
+    router->_budgetStartTime = 0;
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    NSTimeInterval budget = [[router class] performBudget];
+    if (now - startTime <= budget) {
+        return;
+    }
+    CFAbsoluteTime destinationTime = router->_budgetDestinationTime > 0 ? router->_budgetDestinationTime : startTime;
+    NSString *message = [NSString stringWithFormat:@"Router (%@) exceeded its performBudget %.1fms, took %.1fms: making destination %.1fms, preparing destination %.1fms.", [router class], budget * 1000, (now - startTime) * 1000, (destinationTime - startTime) * 1000, (now - destinationTime) * 1000];
+    ZIX_LOG(Route, Warning, @"%@", message);
+#if ZIKROUTER_ASSERT_PERFORM_BUDGET
+    NSCAssert(NO, @"%@", message);
+#endif
+}
+#endif
+
+uint64_t zix_routerStageTimestamp(ZIKRouter *router, ZIKRouterStage stage) {
+    uint64_t *timestamps = __atomic_load_n(&router->_stageTimestamps, __ATOMIC_ACQUIRE);
+    if (timestamps == NULL || stage < 0 || stage >= ZIX_ROUTER_STAGE_COUNT) {
+        return 0;
+    }
+    return __atomic_load_n(&timestamps[stage], __ATOMIC_RELAXED);
+}
+
+- (void)dealloc {
+    free(_stageTimestamps);
+}
+
 - (instancetype)initWithConfiguration:(ZIKPerformRouteConfiguration *)configuration removeConfiguration:(nullable ZIKRemoveRouteConfiguration *)removeConfiguration {
     NSParameterAssert(configuration || [[self class] isAbstractRouter]);
     
     if (self = [super init]) {
-        _state = ZIKRouterStateUnrouted;
+        zix_incrementRouterCounter(ZIKRouterCounterRouterAllocation);
+        _recordRouterStage(self, ZIKRouterStageInit);
+        _stateWord = _stateWordWithState(ZIKRouterStateUnrouted, ZIKRouterStateUnrouted);
         _configuration = configuration;
         _removeConfiguration = removeConfiguration;
-        _stateSema = dispatch_semaphore_create(1);
     }
     return self;
 }
 
+__thread __unsafe_unretained ZIKRoute *zix_injectingRoute;
+
+/// Default configuration for initializing router. Take the injecting route when it's calling this router class, so the route's configuration is the only configuration made.
+static ZIKPerformRouteConfiguration *_takeDefaultRouteConfiguration(Class routerClass) {
+    ZIKRoute *route = zix_injectingRoute;
+    if (route && [routerClass isSubclassOfClass:[route routerClass]]) {
+        // Routers made when configuring use their own configurations
+        zix_injectingRoute = nil;
+        ZIKPerformRouteConfiguration *configuration = [route defaultRouteConfigurationFromBlock];
+        if (configuration) {
+            return configuration;
+        }
+    }
+    return [routerClass defaultRouteConfiguration];
+}
+
 - (instancetype)initWithConfiguring:(void(NS_NOESCAPE ^)(ZIKPerformRouteConfiguration *configuration))configBuilder removing:(void(NS_NOESCAPE ^ _Nullable)(ZIKRemoveRouteConfiguration *configuration))removeConfigBuilder {
     NSParameterAssert(configBuilder);
-    ZIKPerformRouteConfiguration *configuration = [[self class] defaultRouteConfiguration];
+    uint64_t signpost = zix_beginRouterSignpost(ZIKRouteSignpostStageRouterInit, self);
+    ZIKPerformRouteConfiguration *configuration = _takeDefaultRouteConfiguration([self class]);
     if (configBuilder) {
         configBuilder(configuration);
         if (configuration.injected) {
@@ -66,13 +559,16 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
             removeConfiguration = removeConfiguration.injected;
         }
     }
-    return [self initWithConfiguration:configuration removeConfiguration:removeConfiguration];
+    self = [self initWithConfiguration:configuration removeConfiguration:removeConfiguration];
+    zix_endRouterSignpost(ZIKRouteSignpostStageRouterInit, signpost, self);
+    return self;
 }
 
 - (instancetype)initWithStrictConfiguring:(void (NS_NOESCAPE ^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, ZIKPerformRouteConfiguration * _Nonnull))configBuilder
                            strictRemoving:(void (NS_NOESCAPE ^)(ZIKRemoveRouteStrictConfiguration<id> * _Nonnull))removeConfigBuilder {
     NSParameterAssert(configBuilder);
-    ZIKPerformRouteConfiguration *configuration = [[self class] defaultRouteConfiguration];
+    uint64_t signpost = zix_beginRouterSignpost(ZIKRouteSignpostStageRouterInit, self);
+    ZIKPerformRouteConfiguration *configuration = _takeDefaultRouteConfiguration([self class]);
     if (configBuilder) {
         ZIKPerformRouteStrictConfiguration *strictConfig = [[self class] defaultRouteStrictConfigurationFor:configuration];
         configBuilder(strictConfig, configuration);
@@ -91,40 +587,289 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
             removeConfiguration = removeConfiguration.injected;
         }
     }
-    return [self initWithConfiguration:configuration removeConfiguration:removeConfiguration];
+    self = [self initWithConfiguration:configuration removeConfiguration:removeConfiguration];
+    zix_endRouterSignpost(ZIKRouteSignpostStageRouterInit, signpost, self);
+    return self;
 }
 
 - (void)attachDestination:(id)destination {
+#ifdef DEBUG
+    if (_budgetStartTime > 0 && destination && _budgetDestinationTime == 0) {
+        _budgetDestinationTime = CFAbsoluteTimeGetCurrent();
+    }
+#endif
+    if (_performStartTime && destination && _destination == nil) {
+        zix_recordRouteMetric([self class], ZIKRouteMetricDestination, _performStartTime);
+    }
+    if (_makingDestinationOnly) {
+        // Nothing observes the router or finds it from the destination, only keep destination for preparing
+        _destination = destination;
+        if (destination) {
+            _recordRouterStage(self, ZIKRouterStageDestinationCreated);
+        }
+        return;
+    }
+    id oldDestination = _destination;
+    if (oldDestination != destination) {
+        _unbindDestinationFromRouter(oldDestination, self);
+    }
+    if (destination) {
+        _bindDestinationToRouter(destination, self);
+        _recordRouterStage(self, ZIKRouterStageDestinationCreated);
+    }
+    if (_observationInfo == NULL) {
+        _destination = destination;
+        return;
+    }
     [self willChangeValueForKey:@"destination"];
     _destination = destination;
     [self didChangeValueForKey:@"destination"];
 }
 
+- (void *)observationInfo {
+    return _observationInfo;
+}
+
+- (void)setObservationInfo:(void *)observationInfo {
+    _observationInfo = observationInfo;
+}
+
+- (id)addStateObserver:(void(^)(ZIKRouterState oldState, ZIKRouterState newState))handler {
+    NSParameterAssert(handler);
+    id observer = [handler copy];
+    @synchronized (self) {
+        NSArray *observers = self.stateObservers;
+        self.stateObservers = observers ? [observers arrayByAddingObject:observer] : @[observer];
+    }
+    return observer;
+}
+
++ (id)addGlobalStateObserver:(void(^)(NSArray<ZIKRouterStateEvent *> *events))handler queue:(nullable dispatch_queue_t)queue {
+    NSParameterAssert(handler);
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _globalStateObserversSema = dispatch_semaphore_create(1);
+        _pendingStateEventsSema = dispatch_semaphore_create(1);
+        _stateEventsQueue = zix_createSerialQueueWithQOS("com.zuik.router.state_events", QOS_CLASS_UTILITY);
+    });
+    ZIKGlobalStateObserver *observer = [ZIKGlobalStateObserver new];
+    observer.routerClass = self;
+    observer.handler = handler;
+    observer.queue = queue;
+    dispatch_semaphore_wait(_globalStateObserversSema, DISPATCH_TIME_FOREVER);
+    NSArray *observers = (__bridge NSArray *)__atomic_load_n(&_globalStateObservers, __ATOMIC_ACQUIRE);
+    NSArray *newObservers = observers ? [observers arrayByAddingObject:observer] : @[observer];
+    // Previous array is leaked on purpose
+    __atomic_store_n(&_globalStateObservers, CFBridgingRetain(newObservers), __ATOMIC_RELEASE);
+    dispatch_semaphore_signal(_globalStateObserversSema);
+    return observer;
+}
+
++ (void)removeGlobalStateObserver:(id)observer {
+    if (!observer || !_globalStateObserversSema) {
+        return;
+    }
+    dispatch_semaphore_wait(_globalStateObserversSema, DISPATCH_TIME_FOREVER);
+    NSMutableArray *observers = [(__bridge NSArray *)__atomic_load_n(&_globalStateObservers, __ATOMIC_ACQUIRE) mutableCopy];
+    if ([observers indexOfObjectIdenticalTo:observer] != NSNotFound) {
+        [observers removeObjectIdenticalTo:observer];
+        const void *published = observers.count > 0 ? CFBridgingRetain([observers copy]) : NULL;
+        __atomic_store_n(&_globalStateObservers, published, __ATOMIC_RELEASE);
+    }
+    dispatch_semaphore_signal(_globalStateObserversSema);
+}
+
+- (void)removeStateObserver:(id)observer {
+    if (!observer) {
+        return;
+    }
+    @synchronized (self) {
+        NSMutableArray *observers = [self.stateObservers mutableCopy];
+        [observers removeObjectIdenticalTo:observer];
+        self.stateObservers = observers.count > 0 ? observers : nil;
+    }
+}
+
++ (BOOL)automaticallyNotifiesObserversForKey:(NSString *)key {
+    // KVO of state is sent manually in -notifyRouteState:
+    if ([key isEqualToString:@"state"] || [key isEqualToString:@"preState"]) {
+        return NO;
+    }
+    return [super automaticallyNotifiesObserversForKey:key];
+}
+
+- (ZIKRouterState)state {
+    return _stateFromWord(__atomic_load_n(&_stateWord, __ATOMIC_ACQUIRE));
+}
+
+- (ZIKRouterState)preState {
+    return _preStateFromWord(__atomic_load_n(&_stateWord, __ATOMIC_ACQUIRE));
+}
+
 - (void)notifyRouteState:(ZIKRouterState)state {
-    dispatch_semaphore_wait(_stateSema, DISPATCH_TIME_FOREVER);
-    ZIKRouterState oldState = self.state;
-    if (oldState == state) {
-        dispatch_semaphore_signal(_stateSema);
+    uint64_t oldWord = __atomic_load_n(&_stateWord, __ATOMIC_ACQUIRE);
+    if (_stateFromWord(oldWord) == state) {
         return;
     }
-    if (state == ZIKRouterStateRouting || state == ZIKRouterStateRemoving) {
-        [[self class] increaseRecursiveDepth];
-    } else if (state == ZIKRouterStateRemoved) {
-        [_configuration removeUserInfo];
+    BOOL observed = _observationInfo != NULL;
+    if (observed) {
+        pthread_mutex_lock(&_observedStateLock);
+        oldWord = __atomic_load_n(&_stateWord, __ATOMIC_ACQUIRE);
+        if (_stateFromWord(oldWord) == state) {
+            pthread_mutex_unlock(&_observedStateLock);
+            return;
+        }
+        [self willChangeValueForKey:@"preState"];
+        [self willChangeValueForKey:@"state"];
     }
+    ZIKRouterState oldState;
+    BOOL changed = YES;
+    do {
+        oldState = _stateFromWord(oldWord);
+        if (oldState == state) {
+            // Another thread already changed to the state. Observed transitions are serialized, so it only happens before observing
+            changed = NO;
+            break;
+        }
+    } while (!__atomic_compare_exchange_n(&_stateWord, &oldWord, _stateWordWithState(state, oldState), true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
     
-    [self willChangeValueForKey:@"preState"];
-    _preState = oldState;
-    [self didChangeValueForKey:@"preState"];
-    self.state = state;
-    
+    // Callbacks are invoked after the transition without holding any lock
+    if (changed) {
+        BOOL starting = state == ZIKRouterStateRouting || state == ZIKRouterStateRemoving;
+        zix_logRouteStateEvent(object_getClass(self), (__bridge const void *)self, oldState, state, starting ? [self eventLogRouteType] : -1);
+        if (state == ZIKRouterStateRemoved) {
+            [_configuration removeUserInfo];
+            _unbindDestinationFromRouter(_destination, self);
+        }
+        if (state == ZIKRouterStateRouting) {
+            _performStartTime = zix_routeMetricsTime();
+            _performTraceTime = zix_traceTime();
+            _recordRouterStage(self, ZIKRouterStagePerformStarted);
+#ifdef DEBUG
+            _budgetStartTime = [[self class] performBudget] > 0 ? CFAbsoluteTimeGetCurrent() : 0;
+            _budgetDestinationTime = 0;
+#endif
+        } else if (state == ZIKRouterStateRouted && oldState == ZIKRouterStateRouting) {
+            _recordRouterStage(self, ZIKRouterStagePerformSucceeded);
+        } else if (state == ZIKRouterStateRemoved) {
+            _recordRouterStage(self, ZIKRouterStageRemoved);
+        } else if (state == ZIKRouterStateRemoving) {
+            _removeStartTime = zix_routeMetricsTime();
+            _removeTraceTime = zix_traceTime();
+        }
+    }
+    if (observed) {
+        [self didChangeValueForKey:@"state"];
+        [self didChangeValueForKey:@"preState"];
+        pthread_mutex_unlock(&_observedStateLock);
+    }
+    if (!changed) {
+        return;
+    }
     if (self.original_configuration.stateNotifier) {
         self.original_configuration.stateNotifier(oldState, state);
     }
+    if (_stateObservers) {
+        for (void(^observer)(ZIKRouterState, ZIKRouterState) in self.stateObservers) {
+            observer(oldState, state);
+        }
+    }
+    if (_hasGlobalStateObservers()) {
+        _enqueueStateEvent(self, oldState, state);
+    }
+    if (_queuesRequests && state != ZIKRouterStateRouting && state != ZIKRouterStateRemoving) {
+        [self _scheduleQueuedRequest];
+    }
+}
+
+#pragma mark Request Queue
+
+/// Queue the request when the router is in transition, or earlier requests are still waiting. Return NO when the request should be executed now.
+- (BOOL)_enqueueRequestWithAction:(ZIKRouteAction)action successHandler:(nullable id)successHandler errorHandler:(void(^ _Nullable)(ZIKRouteAction routeAction, NSError *error))errorHandler {
+    if (!_queuesRequests) {
+        return NO;
+    }
+    ZIKQueuedRouteRequest *request = [ZIKQueuedRouteRequest new];
+    request.action = action;
+    request.successHandler = successHandler;
+    request.errorHandler = errorHandler;
+    return [self _enqueueRequest:request];
+}
+
+- (BOOL)_enqueueRequest:(ZIKQueuedRouteRequest *)request {
+    ZIKQueuedRouteRequest *cancelledRequest;
+    @synchronized (self) {
+        ZIKRouterState state = self.state;
+        if (state != ZIKRouterStateRouting && state != ZIKRouterStateRemoving && _queuedRequests.count == 0 && !_startingQueuedRequest) {
+            return NO;
+        }
+        ZIKQueuedRouteRequest *lastRequest = _queuedRequests.lastObject;
+        if (request.action == ZIKRouteActionRemoveRoute && lastRequest.action == ZIKRouteActionPerformRoute) {
+            [_queuedRequests removeLastObject];
+            cancelledRequest = lastRequest;
+        } else {
+            if (_queuedRequests == nil) {
+                _queuedRequests = [NSMutableArray array];
+            }
+            [_queuedRequests addObject:request];
+        }
+    }
+    if (cancelledRequest) {
+        // Handlers are called out of the lock
+        NSError *error = [ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescriptionProvider:[self _lazyDescriptionWithFormat:@"Queued perform and remove requests of %@ cancel out"]];
+        [cancelledRequest failWithError:error];
+        [request failWithError:error];
+        return YES;
+    }
+    // The transition may be finished before the request is queued
+    ZIKRouterState state = self.state;
+    if (state != ZIKRouterStateRouting && state != ZIKRouterStateRemoving) {
+        [self _scheduleQueuedRequest];
+    }
+    return YES;
+}
+
+- (void)_scheduleQueuedRequest {
+    @synchronized (self) {
+        if (_queuedRequests.count == 0) {
+            return;
+        }
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self _executeQueuedRequest];
+    });
+}
+
+/// Execute the first queued request if the state is settled. Extra scheduled executions are harmless, they return when the router is in transition or nothing is queued.
+- (void)_executeQueuedRequest {
+    ZIKQueuedRouteRequest *request;
+    @synchronized (self) {
+        ZIKRouterState state = self.state;
+        if (state == ZIKRouterStateRouting || state == ZIKRouterStateRemoving || _queuedRequests.count == 0 || _startingQueuedRequest) {
+            return;
+        }
+        request = _queuedRequests.firstObject;
+        [_queuedRequests removeObjectAtIndex:0];
+        // Keep later requests behind this one until it changes state or fails
+        _startingQueuedRequest = YES;
+    }
+    if (request.action == ZIKRouteActionPerformRoute) {
+        [self _performRouteWithSuccessHandler:request.successHandler errorHandler:request.errorHandler];
+    } else if (request.removeConfiguration) {
+        _removeConfiguration = request.removeConfiguration;
+        // Configuration is already built, call its handlers when failing
+        [self _removeRouteWithConfiguring:^(ZIKRemoveRouteConfiguration *config) {}];
+    } else {
+        [self _removeRouteWithSuccessHandler:request.successHandler errorHandler:request.errorHandler];
+    }
+    @synchronized (self) {
+        _startingQueuedRequest = NO;
+    }
+    // Request failing without transition doesn't change state
+    ZIKRouterState state = self.state;
     if (state != ZIKRouterStateRouting && state != ZIKRouterStateRemoving) {
-        [[self class] decreaseRecursiveDepth];
+        [self _scheduleQueuedRequest];
     }
-    dispatch_semaphore_signal(_stateSema);
 }
 
 #pragma mark Perform
@@ -145,6 +890,20 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
 - (void)performWithConfiguration:(ZIKPerformRouteConfiguration *)configuration {
     NSAssert(self.state == ZIKRouterStateRouting, @"State should be routing in -performWithConfiguration:");
     NSAssert([configuration isKindOfClass:[[[self class] defaultRouteConfiguration] class]], @"When using custom configuration class，you must override +defaultRouteConfiguration to return your custom configuration instance.");
+    ZIKRouteCancellationToken *cancellationToken = configuration.cancellationToken;
+    if (cancellationToken.isCancelled) {
+        [self endPerformRouteWithError:[ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescriptionFormat:@"Performing was cancelled before making destination, configuration: %@", configuration]];
+        return;
+    }
+    ZIKRouteInterceptorChain *beforeChain = _interceptorChain(ZIKRouteInterceptionPointBeforePerform);
+    if (beforeChain) {
+        _interceptBeforePerform(beforeChain, self, configuration);
+        cancellationToken = configuration.cancellationToken;
+        if (cancellationToken.isCancelled) {
+            [self endPerformRouteWithError:[ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescriptionFormat:@"Performing was cancelled by interceptor, configuration: %@", configuration]];
+            return;
+        }
+    }
     id destination;
     if ([configuration conformsToProtocol:@protocol(ZIKConfigurationSyncMakeable)]) {
         id<ZIKConfigurationSyncMakeable> makeableConfiguration = (id<ZIKConfigurationSyncMakeable>)configuration;
@@ -153,15 +912,106 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
             destination = makedDestination;
         }
     }
-    if (destination == nil) {
-        destination = [self destinationWithConfiguration:configuration];
+    if (destination == nil && configuration.prewarmKey) {
+        destination = _takePrewarmedDestination([self class], configuration.prewarmKey);
+    }
+    if (destination == nil && (configuration.performQueue || [[self class] makesDestinationInBackground])) {
+        [self makeDestinationInBackgroundWithConfiguration:configuration];
+    } else {
+        if (destination == nil) {
+            destination = [self makeDestinationWithConfiguration:configuration];
+        }
+        if (cancellationToken.isCancelled) {
+            // Cancelled while making
+            [self endPerformRouteWithError:[ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescriptionFormat:@"Making destination was cancelled, configuration: %@", configuration]];
+        } else {
+            [self performWithDestination:destination configuration:configuration];
+        }
     }
+    ZIKRouteInterceptorChain *afterChain = _interceptorChain(ZIKRouteInterceptionPointAfterPerform);
+    if (afterChain) {
+        _interceptWithConfiguration(afterChain, self, configuration);
+    }
+}
+
+- (nullable id)makeDestinationWithConfiguration:(ZIKPerformRouteConfiguration *)configuration {
+    ZIX_WATCH_CALLBACK_SCOPE(self, ZIKRouteCallbackStageDestinationWithConfiguration);
+    uint64_t signpost = zix_beginRouterSignpost(ZIKRouteSignpostStageMakeDestination, self);
+    id destination = [self destinationWithConfiguration:configuration];
+    zix_endRouterSignpost(ZIKRouteSignpostStageMakeDestination, signpost, self);
+    return destination;
+}
+
+- (void)performWithDestination:(nullable id)destination configuration:(ZIKPerformRouteConfiguration *)configuration {
     [self attachDestination:destination];
     if (destination == nil) {
         [self endPerformRouteWithError:[ZIKRouter errorWithCode:ZIKRouteErrorDestinationUnavailable localizedDescriptionFormat:@"Destination from router is nil. Maybe your configuration is invalid (%@), or there is a bug in the router.", configuration]];
-        return;
+    } else {
+        ZIX_WATCH_CALLBACK_SCOPE(self, ZIKRouteCallbackStagePerformRouteOnDestination);
+        uint64_t signpost = zix_beginRouterSignpost(ZIKRouteSignpostStagePerformRoute, self);
+        [self performRouteOnDestination:destination configuration:configuration];
+        zix_endRouterSignpost(ZIKRouteSignpostStagePerformRoute, signpost, self);
     }
-    [self performRouteOnDestination:destination configuration:configuration];
+}
+
+- (BOOL)claimMakingDestinationToken:(uint64_t)token {
+    return __atomic_compare_exchange_n(&_makingDestinationToken, &token, 0, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+- (void)makeDestinationInBackgroundWithConfiguration:(ZIKPerformRouteConfiguration *)configuration {
+    static uint64_t tokenCounter = 0;
+    uint64_t token = __atomic_add_fetch(&tokenCounter, 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&_makingDestinationToken, token, __ATOMIC_RELEASE);
+    // Router is retained until making is finished
+    dispatch_async(configuration.performQueue ?: zix_globalQueueWithQOS(QOS_CLASS_USER_INITIATED), ^{
+        if (__atomic_load_n(&self->_makingDestinationToken, __ATOMIC_ACQUIRE) != token) {
+            return;
+        }
+        id destination = [self makeDestinationWithConfiguration:configuration];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            // Drop the destination if making was cancelled or timed out
+            if ([self claimMakingDestinationToken:token]) {
+                [self performWithDestination:destination configuration:configuration];
+            }
+        });
+    });
+    ZIKRouteCancellationToken *cancellationToken = configuration.cancellationToken;
+    if (cancellationToken) {
+        __weak typeof(self) weakSelf = self;
+        [cancellationToken addCancellationHandler:^{
+            // Only cancel this making, the router may be making again
+            [weakSelf cancelMakingDestinationWithToken:token];
+        }];
+    }
+    NSTimeInterval timeout = configuration.destinationMakingTimeout > 0 ? configuration.destinationMakingTimeout : [[self class] destinationMakingTimeout];
+    if (timeout > 0) {
+        __weak typeof(self) weakSelf = self;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeout * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            __strong typeof(weakSelf) strongSelf = weakSelf;
+            if ([strongSelf claimMakingDestinationToken:token]) {
+                [strongSelf endPerformRouteWithError:[ZIKRouter errorWithCode:ZIKRouteErrorDestinationUnavailable localizedDescriptionFormat:@"Making destination timed out after %.2f seconds, configuration: %@", timeout, configuration]];
+            }
+        });
+    }
+}
+
+- (BOOL)cancelMakingDestination {
+    return [self cancelMakingDestinationWithToken:__atomic_load_n(&_makingDestinationToken, __ATOMIC_ACQUIRE)];
+}
+
+- (BOOL)cancelMakingDestinationWithToken:(uint64_t)token {
+    if (token == 0 || ![self claimMakingDestinationToken:token]) {
+        return NO;
+    }
+    void(^cancel)(void) = ^{
+        [self endPerformRouteWithError:[ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescriptionFormat:@"Making destination was cancelled, configuration: %@", self.original_configuration]];
+    };
+    if ([NSThread isMainThread]) {
+        cancel();
+    } else {
+        dispatch_async(dispatch_get_main_queue(), cancel);
+    }
+    return YES;
 }
 
 - (void)performRoute {
@@ -170,20 +1020,35 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
 
 - (void)performRouteWithSuccessHandler:(void(^)(id destination))performerSuccessHandler
                           errorHandler:(void(^)(ZIKRouteAction routeAction, NSError *error))performerErrorHandler {
+    if ([self _enqueueRequestWithAction:ZIKRouteActionPerformRoute successHandler:performerSuccessHandler errorHandler:performerErrorHandler]) {
+        return;
+    }
+    ZIKRoutePriority priority = self.original_configuration.priority;
+    if (priority != ZIKRoutePriorityImmediate && !_makingDestinationOnly) {
+        // Router is retained until it's performed
+        zix_scheduleMainThreadWork(priority, ^{
+            [self _performRouteWithSuccessHandler:performerSuccessHandler errorHandler:performerErrorHandler];
+        });
+        return;
+    }
+    [self _performRouteWithSuccessHandler:performerSuccessHandler errorHandler:performerErrorHandler];
+}
+
+- (void)_performRouteWithSuccessHandler:(void(^ _Nullable)(id destination))performerSuccessHandler
+                           errorHandler:(void(^ _Nullable)(ZIKRouteAction routeAction, NSError *error))performerErrorHandler {
     NSAssert(self.original_configuration, @"router must has configuration");
     ZIKRouterState state = self.state;
     if (state == ZIKRouterStateRouted && self.destination != nil && [self shouldRemoveBeforePerform]) {
         ZIKRouteAction action = ZIKRouteActionPerformRoute;
-        NSString *description = [NSString stringWithFormat:@"%@ 's state is routed, can't perform route before it's removed",self];
-        NSError *error = [ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescription:description];
-        [self notifyError_actionFailedWithAction:action errorDescription:@"%@", description];
+        NSError *error = [ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescriptionProvider:[self _lazyDescriptionWithFormat:@"%@ 's state is routed, can't perform route before it's removed"]];
+        [self notifyError:error routeAction:action];
         if (performerErrorHandler) {
             performerErrorHandler(action,error);
         }
         return;
     } else if (state == ZIKRouterStateRouting) {
         ZIKRouteAction action = ZIKRouteActionPerformRoute;
-        NSError *error = [ZIKRouter errorWithCode:ZIKRouteErrorOverRoute localizedDescriptionFormat:@"%@ is routing, can't perform route again",self];
+        NSError *error = [ZIKRouter errorWithCode:ZIKRouteErrorOverRoute localizedDescriptionProvider:[self _lazyDescriptionWithFormat:@"%@ is routing, can't perform route again"]];
         if (performerErrorHandler) {
             performerErrorHandler(action,error);
         }
@@ -191,45 +1056,37 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
         return;
     } else if (state == ZIKRouterStateRemoving) {
         ZIKRouteAction action = ZIKRouteActionPerformRoute;
-        NSError *error = [ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescriptionFormat:@"%@ 's state is removing, can't perform route again",self];
+        NSError *error = [ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescriptionProvider:[self _lazyDescriptionWithFormat:@"%@ 's state is removing, can't perform route again"]];
         if (performerErrorHandler) {
             performerErrorHandler(action,error);
         }
         [[self class] notifyGlobalErrorWithRouter:self action:action error:error];
         return;
     }
+    ZIX_RECURSIVE_SCOPE;
     if ([[self class] _validateInfiniteRecursion] == NO) {
         ZIKRouteAction action = ZIKRouteActionPerformRoute;
-        NSString *description = [NSString stringWithFormat:@"Infinite recursion for performing route detected. There may be cycle dependencies. Recursive call stack:\n%@",[NSThread callStackSymbols]];
-        NSError *error = [ZIKRouter errorWithCode:ZIKRouteErrorInfiniteRecursion localizedDescription:description];
-        [self notifyError_infiniteRecursionWithAction:ZIKRouteActionPerformRoute errorDescription:@"%@", description];
-        [[self class] decreaseRecursiveDepth];
+        NSArray<NSNumber *> *callStack = [NSThread callStackReturnAddresses];
+        NSError *error = [ZIKRouter errorWithCode:ZIKRouteErrorInfiniteRecursion localizedDescriptionProvider:^NSString *{
+            return [NSString stringWithFormat:@"Infinite recursion for performing route detected. There may be cycle dependencies. Recursive call stack:\n%@", zix_symbolicateCallStack(callStack)];
+        }];
+        [self notifyError:error routeAction:action];
         if (performerErrorHandler) {
             performerErrorHandler(action,error);
         }
         return;
     }
     [self notifyRouteState:ZIKRouterStateRouting];
+    void(*warmer)(ZIKRouter *) = __atomic_load_n(&zix_serviceDependencyWarmer, __ATOMIC_ACQUIRE);
+    if (warmer) {
+        warmer(self);
+    }
     ZIKPerformRouteConfiguration *configuration = self.original_configuration;
     if (performerSuccessHandler) {
-        void(^ori_performerSuccessHandler)(id) = configuration.performerSuccessHandler;
-        if (ori_performerSuccessHandler) {
-            performerSuccessHandler = ^(id destination) {
-                ori_performerSuccessHandler(destination);
-                performerSuccessHandler(destination);
-            };
-        }
-        configuration.performerSuccessHandler = performerSuccessHandler;
+        [configuration addPerformerSuccessHandler:performerSuccessHandler];
     }
     if (performerErrorHandler) {
-        ZIKRouteErrorHandler ori_performerErrorHandler = configuration.performerErrorHandler;
-        if (ori_performerErrorHandler) {
-            performerErrorHandler = ^(ZIKRouteAction routeAction, NSError *error) {
-                ori_performerErrorHandler(routeAction, error);
-                performerErrorHandler(routeAction, error);
-            };
-        }
-        configuration.performerErrorHandler = performerErrorHandler;
+        [configuration addPerformerErrorHandler:performerErrorHandler];
     }
     [self performWithConfiguration:configuration];
 }
@@ -330,7 +1187,11 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
 }
 
 - (BOOL)canRemove {
-    return [self checkCanRemove] == nil;
+    BOOL probing = _probingCanRemove;
+    _probingCanRemove = YES;
+    BOOL canRemove = [self checkCanRemove] == nil;
+    _probingCanRemove = probing;
+    return canRemove;
 }
 
 - (NSString *)checkCanRemove {
@@ -338,9 +1199,15 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
         if (self.state != ZIKRouterStateRemoved) {
             [self notifyRouteState:ZIKRouterStateRemoved];
         }
+        if (zix_isProbingCanRemove()) {
+            return ZIKRouterCanNotRemoveMessage;
+        }
         return [NSString stringWithFormat:@"Router can't remove, destination is dealloced. router:%@",self];
     }
     if (self.state != ZIKRouterStateRouted || !self.original_configuration) {
+        if (zix_isProbingCanRemove()) {
+            return ZIKRouterCanNotRemoveMessage;
+        }
         return [NSString stringWithFormat:@"Router can't remove, it's not performed, current state:%ld router:%@",(long)self.state,self];
     }
     return nil;
@@ -350,11 +1217,44 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
     [self removeRouteWithSuccessHandler:nil errorHandler:nil];
 }
 
+/// Provider formatting `format` with description of router. Format should only contain one `%@` for the router.
+- (NSString *(^)(void))_lazyDescriptionWithFormat:(NSString *)format {
+    __weak ZIKRouter *weakSelf = self;
+    Class routerClass = [self class];
+    const void *address = (__bridge const void *)self;
+    return ^NSString *{
+        return [NSString stringWithFormat:format, zix_routerDescription(weakSelf, routerClass, address)];
+    };
+}
+
+- (NSError *)_lazyRemoveStateError {
+    ZIKRouterState state = self.state;
+    __weak ZIKPerformRouteConfiguration *configuration = self.original_configuration;
+    return [ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescriptionProvider:^NSString *{
+        return [NSString stringWithFormat:@"State should be ZIKRouterStateRouted when removeRoute, current state:%ld, configuration:%@", (long)state, configuration];
+    }];
+}
+
+- (NSError *)_lazyCanNotRemoveErrorWithMessage:(NSString *)errorMessage {
+    __weak ZIKPerformRouteConfiguration *configuration = self.original_configuration;
+    return [ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescriptionProvider:^NSString *{
+        return [NSString stringWithFormat:@"%@, configuration:%@", errorMessage, configuration];
+    }];
+}
+
 - (void)removeRouteWithSuccessHandler:(void(^)(void))performerSuccessHandler
                          errorHandler:(void(^)(ZIKRouteAction routeAction, NSError *error))performerErrorHandler {
+    if ([self _enqueueRequestWithAction:ZIKRouteActionRemoveRoute successHandler:performerSuccessHandler errorHandler:performerErrorHandler]) {
+        return;
+    }
+    [self _removeRouteWithSuccessHandler:performerSuccessHandler errorHandler:performerErrorHandler];
+}
+
+- (void)_removeRouteWithSuccessHandler:(void(^ _Nullable)(void))performerSuccessHandler
+                          errorHandler:(void(^ _Nullable)(ZIKRouteAction routeAction, NSError *error))performerErrorHandler {
     if (self.state != ZIKRouterStateRouted || !self.original_configuration) {
         ZIKRouteAction action = ZIKRouteActionRemoveRoute;
-        NSError *error = [ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescriptionFormat:@"State should be ZIKRouterStateRouted when removeRoute, current state:%ld, configuration:%@",self.state,self.original_configuration];
+        NSError *error = [self _lazyRemoveStateError];
         if (performerErrorHandler) {
             performerErrorHandler(action,error);
         }
@@ -363,35 +1263,21 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
     }
     NSString *errorMessage = [self checkCanRemove];
     if (errorMessage != nil) {
-        NSString *description = [NSString stringWithFormat:@"%@, configuration:%@",errorMessage,self.original_configuration];
-        [self notifyError_actionFailedWithAction:ZIKRouteActionRemoveRoute
-                                errorDescription:description];
+        NSError *error = [self _lazyCanNotRemoveErrorWithMessage:errorMessage];
+        [self notifyError:error routeAction:ZIKRouteActionRemoveRoute];
         if (performerErrorHandler) {
-            performerErrorHandler(ZIKRouteActionRemoveRoute,[ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescription:description]);
+            performerErrorHandler(ZIKRouteActionRemoveRoute, error);
         }
         return;
     }
+    ZIX_RECURSIVE_SCOPE;
     [self notifyRouteState:ZIKRouterStateRemoving];
     ZIKRemoveRouteConfiguration *configuration = self.original_removeConfiguration;
     if (performerSuccessHandler) {
-        void(^ori_performerSuccessHandler)(void) = configuration.performerSuccessHandler;
-        if (ori_performerSuccessHandler) {
-            performerSuccessHandler = ^{
-                ori_performerSuccessHandler();
-                performerSuccessHandler();
-            };
-        }
-        configuration.performerSuccessHandler = performerSuccessHandler;
+        [configuration addPerformerSuccessHandler:performerSuccessHandler];
     }
     if (performerErrorHandler) {
-        void(^ori_performerErrorHandler)(ZIKRouteAction routeAction, NSError *error) = configuration.performerErrorHandler;
-        if (ori_performerErrorHandler) {
-            performerErrorHandler = ^(ZIKRouteAction routeAction, NSError *error){
-                ori_performerErrorHandler(routeAction, error);
-                performerErrorHandler(routeAction, error);
-            };
-        }
-        configuration.performerErrorHandler = performerErrorHandler;
+        [configuration addPerformerErrorHandler:performerErrorHandler];
     }
     [self removeDestination:self.destination removeConfiguration:configuration];
 }
@@ -409,9 +1295,34 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
 }
 
 - (void)removeRouteWithConfiguring:(void(NS_NOESCAPE ^)(ZIKRemoveRouteConfiguration *config))removeConfigBuilder {
+    if (_queuesRequests) {
+        // Build the configuration now, the builder can't be kept in queue
+        ZIKRemoveRouteConfiguration *configuration = [self.original_removeConfiguration copy];
+        if (removeConfigBuilder) {
+            removeConfigBuilder(configuration);
+        }
+        [self _removeRouteWithQueuedConfiguration:configuration];
+        return;
+    }
+    [self _removeRouteWithConfiguring:removeConfigBuilder];
+}
+
+/// Queue removing with built configuration, or remove now when nothing is in transition.
+- (void)_removeRouteWithQueuedConfiguration:(ZIKRemoveRouteConfiguration *)configuration {
+    ZIKQueuedRouteRequest *request = [ZIKQueuedRouteRequest new];
+    request.action = ZIKRouteActionRemoveRoute;
+    request.removeConfiguration = configuration;
+    if ([self _enqueueRequest:request]) {
+        return;
+    }
+    _removeConfiguration = configuration;
+    [self _removeRouteWithConfiguring:^(ZIKRemoveRouteConfiguration *config) {}];
+}
+
+- (void)_removeRouteWithConfiguring:(void(NS_NOESCAPE ^ _Nullable)(ZIKRemoveRouteConfiguration *config))removeConfigBuilder {
     if (self.state != ZIKRouterStateRouted || !self.original_configuration) {
         ZIKRouteAction action = ZIKRouteActionRemoveRoute;
-        NSError *error = [ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescriptionFormat:@"State should be ZIKRouterStateRouted when removeRoute, current state:%ld, configuration:%@",self.state,self.original_configuration];
+        NSError *error = [self _lazyRemoveStateError];
         [[self class] notifyGlobalErrorWithRouter:self action:action error:error];
         if (removeConfigBuilder) {
             ZIKRemoveRouteConfiguration *configuration = self.original_removeConfiguration;
@@ -431,11 +1342,9 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
     NSString *errorMessage = [self checkCanRemove];
     if (errorMessage != nil) {
         ZIKRouteAction action = ZIKRouteActionRemoveRoute;
-        NSString *description = [NSString stringWithFormat:@"%@, configuration:%@",errorMessage,self.original_configuration];
-        [self notifyError_actionFailedWithAction:action
-                                errorDescription:description];
+        NSError *error = [self _lazyCanNotRemoveErrorWithMessage:errorMessage];
+        [self notifyError:error routeAction:action];
         if (removeConfigBuilder) {
-            NSError *error = [ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescription:description];
             ZIKRemoveRouteConfiguration *configuration = self.original_removeConfiguration;
             removeConfigBuilder(configuration);
             if (configuration.errorHandler) {
@@ -450,6 +1359,7 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
         }
         return;
     }
+    ZIX_RECURSIVE_SCOPE;
     [self notifyRouteState:ZIKRouterStateRemoving];
     ZIKRemoveRouteConfiguration *configuration = self.original_removeConfiguration;
     if (removeConfigBuilder) {
@@ -459,19 +1369,27 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
 }
 
 - (void)removeRouteWithStrictConfiguring:(void (NS_NOESCAPE ^)(ZIKRemoveRouteStrictConfiguration<id> * _Nonnull))removeConfigBuilder {
+    if (_queuesRequests) {
+        ZIKRemoveRouteConfiguration *configuration = [self.original_removeConfiguration copy];
+        if (removeConfigBuilder) {
+            ZIKRemoveRouteStrictConfiguration *strictConfig = [[self class] defaultRemoveStrictConfigurationFor:configuration];
+            removeConfigBuilder(strictConfig);
+        }
+        [self _removeRouteWithQueuedConfiguration:configuration];
+        return;
+    }
     if (self.state != ZIKRouterStateRouted || !self.original_configuration) {
         ZIKRouteAction action = ZIKRouteActionRemoveRoute;
-        NSError *error = [ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescriptionFormat:@"State should be ZIKRouterStateRouted when removeRoute, current state:%ld, configuration:%@",self.state,self.original_configuration];
+        NSError *error = [self _lazyRemoveStateError];
         [[self class] notifyGlobalErrorWithRouter:self action:action error:error];
         return;
     }
     NSString *errorMessage = [self checkCanRemove];
     if (errorMessage != nil) {
-        NSString *description = [NSString stringWithFormat:@"%@, configuration:%@",errorMessage,self.original_configuration];
-        [self notifyError_actionFailedWithAction:ZIKRouteActionRemoveRoute
-                                errorDescription:description];
+        [self notifyError:[self _lazyCanNotRemoveErrorWithMessage:errorMessage] routeAction:ZIKRouteActionRemoveRoute];
         return;
     }
+    ZIX_RECURSIVE_SCOPE;
     [self notifyRouteState:ZIKRouterStateRemoving];
     ZIKRemoveRouteConfiguration *configuration = self.original_removeConfiguration;
     if (removeConfigBuilder) {
@@ -481,8 +1399,286 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
     [self removeDestination:self.destination removeConfiguration:configuration];
 }
 
+#pragma mark Prewarm
+
+/// Max count of prewarmed destinations of all router classes.
+static const NSUInteger ZIKPrewarmedDestinationLimit = 8;
+/// Keys of prewarmed destinations, from least recently prewarmed to most recently prewarmed.
+static NSMutableArray<NSString *> *_prewarmedKeys;
+/// key: router class name and prewarm key, value: destination.
+static NSMutableDictionary<NSString *, id> *_prewarmedDestinations;
+static dispatch_semaphore_t _prewarmSema;
+/// Count of prewarmed destinations, so performing skips the lock when there is none.
+static NSUInteger _prewarmedCount = 0;
+
+static NSString *_prewarmCacheKey(Class routerClass, NSString *key) {
+    return [NSString stringWithFormat:@"%@:%@", NSStringFromClass(routerClass), key];
+}
+
+static void _initPrewarmCache(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _prewarmedKeys = [NSMutableArray array];
+        _prewarmedDestinations = [NSMutableDictionary dictionary];
+        _prewarmSema = dispatch_semaphore_create(1);
+        zix_registerCacheTrimmer(ZIKRouteCachePriorityHigh, ^{
+            [ZIKRouter discardPrewarmedDestinations];
+        });
+    });
+}
+
+static id _Nullable _takePrewarmedDestination(Class routerClass, NSString *key) {
+    if (__atomic_load_n(&_prewarmedCount, __ATOMIC_ACQUIRE) == 0) {
+        return nil;
+    }
+    NSString *cacheKey = _prewarmCacheKey(routerClass, key);
+    dispatch_semaphore_wait(_prewarmSema, DISPATCH_TIME_FOREVER);
+    id destination = _prewarmedDestinations[cacheKey];
+    if (destination) {
+        [_prewarmedDestinations removeObjectForKey:cacheKey];
+        [_prewarmedKeys removeObject:cacheKey];
+        __atomic_store_n(&_prewarmedCount, _prewarmedKeys.count, __ATOMIC_RELEASE);
+    }
+    dispatch_semaphore_signal(_prewarmSema);
+    return destination;
+}
+
++ (void)prewarmDestinationForKey:(NSString *)key configuring:(void(NS_NOESCAPE ^ _Nullable)(ZIKPerformRouteConfiguration *config))configBuilder {
+    NSParameterAssert(key);
+    NSAssert(self != [ZIKRouter class], @"Only prewarm destination from router subclass");
+    if (!key || [self isAbstractRouter]) {
+        return;
+    }
+    ZIKPerformRouteConfiguration *configuration = [self defaultRouteConfiguration];
+    configuration.prewarmKey = key;
+    if (configBuilder) {
+        configBuilder(configuration);
+        if (configuration.injected) {
+            configuration = configuration.injected;
+        }
+    }
+    ZIKRouter *router = [[self alloc] initWithConfiguration:configuration removeConfiguration:nil];
+    id destination = [router destinationWithConfiguration:configuration];
+    if (!destination) {
+        return;
+    }
+    _initPrewarmCache();
+    NSString *cacheKey = _prewarmCacheKey(self, key);
+    dispatch_semaphore_wait(_prewarmSema, DISPATCH_TIME_FOREVER);
+    [_prewarmedKeys removeObject:cacheKey];
+    [_prewarmedKeys addObject:cacheKey];
+    _prewarmedDestinations[cacheKey] = destination;
+    // Release discarded destinations outside the lock
+    NSMutableArray *discarded = [NSMutableArray array];
+    while (_prewarmedKeys.count > ZIKPrewarmedDestinationLimit) {
+        NSString *oldestKey = _prewarmedKeys.firstObject;
+        id oldest = _prewarmedDestinations[oldestKey];
+        if (oldest) {
+            [discarded addObject:oldest];
+        }
+        [_prewarmedDestinations removeObjectForKey:oldestKey];
+        [_prewarmedKeys removeObjectAtIndex:0];
+    }
+    __atomic_store_n(&_prewarmedCount, _prewarmedKeys.count, __ATOMIC_RELEASE);
+    dispatch_semaphore_signal(_prewarmSema);
+}
+
++ (void)discardPrewarmedDestinationForKey:(NSString *)key {
+    if (!key) {
+        return;
+    }
+    _takePrewarmedDestination(self, key);
+}
+
++ (void)discardPrewarmedDestinations {
+    if (__atomic_load_n(&_prewarmedCount, __ATOMIC_ACQUIRE) == 0) {
+        return;
+    }
+    dispatch_semaphore_wait(_prewarmSema, DISPATCH_TIME_FOREVER);
+    // Release discarded destinations outside the lock
+    NSDictionary *discarded = [_prewarmedDestinations copy];
+    [_prewarmedDestinations removeAllObjects];
+    [_prewarmedKeys removeAllObjects];
+    __atomic_store_n(&_prewarmedCount, 0, __ATOMIC_RELEASE);
+    dispatch_semaphore_signal(_prewarmSema);
+    discarded = nil;
+}
+
++ (void)trimCaches {
+    zix_trimCaches(ZIKRouteCachePriorityHigh);
+}
+
+void zix_discardPrewarmedDestinationsInImage(const void *header) {
+    if (__atomic_load_n(&_prewarmedCount, __ATOMIC_ACQUIRE) == 0) {
+        return;
+    }
+    dispatch_semaphore_wait(_prewarmSema, DISPATCH_TIME_FOREVER);
+    // Release discarded destinations outside the lock
+    NSMutableArray *discarded = [NSMutableArray array];
+    for (NSString *cacheKey in [_prewarmedKeys copy]) {
+        id destination = _prewarmedDestinations[cacheKey];
+        NSString *routerName = [cacheKey substringToIndex:[cacheKey rangeOfString:@":"].location];
+        if (zix_imageHeaderOfClass(object_getClass(destination)) != header && zix_imageHeaderOfClass(NSClassFromString(routerName)) != header) {
+            continue;
+        }
+        if (destination) {
+            [discarded addObject:destination];
+        }
+        [_prewarmedDestinations removeObjectForKey:cacheKey];
+        [_prewarmedKeys removeObject:cacheKey];
+    }
+    __atomic_store_n(&_prewarmedCount, _prewarmedKeys.count, __ATOMIC_RELEASE);
+    dispatch_semaphore_signal(_prewarmSema);
+}
+
++ (void)warmWhenIdle:(void(^)(void))work inBackground:(BOOL)inBackground {
+    NSParameterAssert(work);
+    if (!work) {
+        return;
+    }
+    if (!inBackground) {
+        zix_scheduleMainThreadWork(ZIKRoutePriorityBackground, work);
+        return;
+    }
+    static dispatch_queue_t warmingQueue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        warmingQueue = zix_createSerialQueueWithQOS("com.zuik.router.idle_warming", QOS_CLASS_UTILITY);
+    });
+    // Start when main thread is idle, so it doesn't compete with launch for CPU and locks
+    zix_scheduleMainThreadWork(ZIKRoutePriorityBackground, ^{
+        dispatch_async(warmingQueue, work);
+    });
+}
+
+#pragma mark Router of Destination
+
++ (nullable instancetype)routerForDestination:(id)destination {
+    NSParameterAssert(destination);
+    if (destination == nil) {
+        return nil;
+    }
+    _initDestinationToRouterTable();
+    dispatch_semaphore_wait(_destinationToRouterSema, DISPATCH_TIME_FOREVER);
+    ZIKRouter *router = [_destinationToRouterTable objectForKey:destination];
+    dispatch_semaphore_signal(_destinationToRouterSema);
+    if (router && ![router isKindOfClass:self]) {
+        return nil;
+    }
+    return router;
+}
+
+#pragma mark Identifier Handle
+
++ (ZIKRouteIdentifierHandle)handleForIdentifier:(NSString *)identifier {
+    NSParameterAssert(identifier);
+    if (identifier == nil) {
+        return 0;
+    }
+    return zix_internRouteIdentifier(identifier);
+}
+
 #pragma mark Make Destination
 
+/// Max count of idle routers kept for each router class. Nested making of the same router takes more than one.
+static const NSUInteger ZIKReusableRouterLimit = 4;
+/// key: router class, value: NSMutableArray of idle routers.
+static CFMutableDictionaryRef _reusableRouters;
+static dispatch_semaphore_t _reusableRoutersSema;
+
+static ZIKRouter *_Nullable _dequeueReusableRouter(Class routerClass) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _reusableRouters = CFDictionaryCreateMutable(NULL, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+        _reusableRoutersSema = dispatch_semaphore_create(1);
+        zix_registerCacheTrimmer(ZIKRouteCachePriorityDefault, ^{
+            dispatch_semaphore_wait(_reusableRoutersSema, DISPATCH_TIME_FOREVER);
+            // Release idle routers outside the lock
+            NSDictionary *discarded = [(__bridge NSDictionary *)_reusableRouters copy];
+            CFDictionaryRemoveAllValues(_reusableRouters);
+            dispatch_semaphore_signal(_reusableRoutersSema);
+            discarded = nil;
+        });
+    });
+    dispatch_semaphore_wait(_reusableRoutersSema, DISPATCH_TIME_FOREVER);
+    NSMutableArray<ZIKRouter *> *routers = (__bridge NSMutableArray *)CFDictionaryGetValue(_reusableRouters, (__bridge const void *)routerClass);
+    ZIKRouter *router = routers.lastObject;
+    if (router) {
+        [routers removeLastObject];
+    }
+    dispatch_semaphore_signal(_reusableRoutersSema);
+    return router;
+}
+
+static void _enqueueReusableRouter(ZIKRouter *router) {
+    // Router making destination asynchronously is still in use
+    ZIKRouterState state = router.state;
+    if (state == ZIKRouterStateRouting || state == ZIKRouterStateRemoving) {
+        return;
+    }
+    [router prepareForReuse];
+    Class routerClass = [router class];
+    dispatch_semaphore_wait(_reusableRoutersSema, DISPATCH_TIME_FOREVER);
+    NSMutableArray<ZIKRouter *> *routers = (__bridge NSMutableArray *)CFDictionaryGetValue(_reusableRouters, (__bridge const void *)routerClass);
+    if (!routers) {
+        routers = [NSMutableArray arrayWithCapacity:ZIKReusableRouterLimit];
+        CFDictionarySetValue(_reusableRouters, (__bridge const void *)routerClass, (__bridge const void *)routers);
+    }
+    if (routers.count < ZIKReusableRouterLimit) {
+        [routers addObject:router];
+    }
+    dispatch_semaphore_signal(_reusableRoutersSema);
+}
+
++ (BOOL)reusesRouterForMakingDestination {
+    return NO;
+}
+
++ (nullable NSArray<Protocol *> *)dependencyServiceProtocols {
+    return nil;
+}
+
+- (void)prepareForReuse {
+    if (!_makingDestinationOnly) {
+        _unbindDestinationFromRouter(_destination, self);
+    }
+    _destination = nil;
+    __atomic_store_n(&_stateWord, _stateWordWithState(ZIKRouterStateUnrouted, ZIKRouterStateUnrouted), __ATOMIC_RELEASE);
+    _error = nil;
+    if (_stageTimestamps) {
+        memset(_stageTimestamps, 0, ZIX_ROUTER_STAGE_COUNT * sizeof(uint64_t));
+    }
+    NSArray<ZIKQueuedRouteRequest *> *queuedRequests;
+    @synchronized (self) {
+        queuedRequests = _queuedRequests;
+        _queuedRequests = nil;
+        _startingQueuedRequest = NO;
+    }
+    _queuesRequests = NO;
+    if (queuedRequests.count > 0) {
+        NSError *error = [ZIKRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescriptionProvider:[self _lazyDescriptionWithFormat:@"%@ is reused, queued requests are cancelled"]];
+        for (ZIKQueuedRouteRequest *request in queuedRequests) {
+            [request failWithError:error];
+        }
+    }
+    // Release blocks in configuration
+    _configuration = nil;
+    _removeConfiguration = nil;
+    [_reusableStrictConfiguration unbindConfiguration];
+}
+
+- (void)reuseWithConfiguration:(ZIKPerformRouteConfiguration *)configuration {
+    NSParameterAssert(configuration);
+    NSAssert(self.state == ZIKRouterStateUnrouted, @"Router should be prepared for reuse before reusing.");
+    _configuration = configuration;
+}
+
+- (void)rebindConfiguration:(ZIKPerformRouteConfiguration *)configuration {
+    NSParameterAssert(configuration);
+    NSAssert(self.state == ZIKRouterStateRouted, @"Only routed router can rebind its destination.");
+    _configuration = configuration;
+}
+
 + (BOOL)canMakeDestination {
     return [self canMakeDestinationSynchronously];
 }
@@ -502,13 +1698,16 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
         return nil;
     }
     __block id dest;
-    ZIKRouter *router = [[self alloc] initWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+    void(^builder)(ZIKPerformRouteConfiguration *) = ^(ZIKPerformRouteConfiguration * _Nonnull config) {
         if (configBuilder) {
             configBuilder(config);
         }
         if (config.injected) {
             config = config.injected;
         }
+        // Destination is returned synchronously
+        config.performQueue = nil;
+        config.callbackQueue = nil;
         void(^successHandler)(id destination) = config.performerSuccessHandler;
         config.performerSuccessHandler = ^(id  _Nonnull destination) {
             if (successHandler) {
@@ -516,8 +1715,21 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
             }
             dest = destination;
         };
-    } removing:NULL];
+    };
+    BOOL reusesRouter = [self reusesRouterForMakingDestination];
+    ZIKRouter *router = reusesRouter ? _dequeueReusableRouter(self) : nil;
+    if (router) {
+        ZIKPerformRouteConfiguration *configuration = _takeDefaultRouteConfiguration(self);
+        builder(configuration);
+        [router reuseWithConfiguration:configuration.injected ?: configuration];
+    } else {
+        router = [[self alloc] initWithConfiguring:builder removing:NULL];
+    }
+    router->_makingDestinationOnly = YES;
     [router performRoute];
+    if (reusesRouter) {
+        _enqueueReusableRouter(router);
+    }
     return dest;
 }
 
@@ -528,13 +1740,16 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
         return nil;
     }
     __block id dest;
-    ZIKRouter *router = [[self alloc] initWithStrictConfiguring:^(ZIKPerformRouteStrictConfiguration *strictConfig, ZIKPerformRouteConfiguration *config) {
+    void(^builder)(ZIKPerformRouteStrictConfiguration *, ZIKPerformRouteConfiguration *) = ^(ZIKPerformRouteStrictConfiguration *strictConfig, ZIKPerformRouteConfiguration *config) {
         if (configBuilder) {
             configBuilder(strictConfig, config);
         }
         if (config.injected) {
             config = config.injected;
         }
+        // Destination is returned synchronously
+        config.performQueue = nil;
+        config.callbackQueue = nil;
         void(^successHandler)(id destination) = config.performerSuccessHandler;
         config.performerSuccessHandler = ^(id  _Nonnull destination) {
             if (successHandler) {
@@ -542,8 +1757,28 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
             }
             dest = destination;
         };
-    } strictRemoving:nil];
+    };
+    BOOL reusesRouter = [self reusesRouterForMakingDestination];
+    ZIKRouter *router = reusesRouter ? _dequeueReusableRouter(self) : nil;
+    if (router) {
+        ZIKPerformRouteConfiguration *configuration = _takeDefaultRouteConfiguration(self);
+        ZIKPerformRouteStrictConfiguration *strictConfig = router->_reusableStrictConfiguration;
+        if (strictConfig) {
+            strictConfig.configuration = configuration;
+        } else {
+            strictConfig = [self defaultRouteStrictConfigurationFor:configuration];
+            router->_reusableStrictConfiguration = strictConfig;
+        }
+        builder(strictConfig, configuration);
+        [router reuseWithConfiguration:configuration.injected ?: configuration];
+    } else {
+        router = [[self alloc] initWithStrictConfiguring:builder strictRemoving:nil];
+    }
+    router->_makingDestinationOnly = YES;
     [router performRoute];
+    if (reusesRouter) {
+        _enqueueReusableRouter(router);
+    }
     return dest;
 }
 
@@ -551,6 +1786,46 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
     return [self makeDestinationWithPreparation:nil];
 }
 
+BOOL zix_routerHooksInstalled(void) {
+    for (NSUInteger point = 0; point < ZIKRouteInterceptionPointCount; point++) {
+        if (_interceptorChain(point)) {
+            return YES;
+        }
+    }
+    return _hasGlobalStateObservers() ||
+    __atomic_load_n(&zix_serviceDependencyWarmer, __ATOMIC_RELAXED) != NULL ||
+    __atomic_load_n(&zix_slowCallbackThreshold, __ATOMIC_RELAXED) != 0 ||
+    zix_isTracing() ||
+    zix_routeMetricsTime() != 0;
+}
+
+id _Nullable zix_makeDestinationWithoutRouter(Class routerClass, ZIKPerformRouteConfiguration *configuration, id _Nullable(NS_NOESCAPE ^make)(ZIKPerformRouteConfiguration *configuration)) {
+    if (_recursiveDepth > ZIKMaxRecursiveDepth) {
+        NSArray<NSNumber *> *callStack = [NSThread callStackReturnAddresses];
+        NSError *error = [ZIKRouter errorWithCode:ZIKRouteErrorInfiniteRecursion localizedDescriptionProvider:^NSString *{
+            return [NSString stringWithFormat:@"Infinite recursion for making destination detected. There may be cycle dependencies. Recursive call stack:\n%@", zix_symbolicateCallStack(callStack)];
+        }];
+        [routerClass notifyGlobalErrorWithRouter:nil action:ZIKRouteActionPerformRoute error:error];
+        return nil;
+    }
+    id destination;
+    {
+        ZIX_RECURSIVE_SCOPE;
+        destination = make(configuration);
+    }
+    if (destination == nil) {
+        [routerClass notifyGlobalErrorWithRouter:nil action:ZIKRouteActionPerformRoute error:[ZIKRouter errorWithCode:ZIKRouteErrorDestinationUnavailable localizedDescriptionFormat:@"Destination from factory is nil. Maybe your configuration is invalid (%@), or there is a bug in the factory.", configuration]];
+        return nil;
+    }
+    if (configuration.prepareDestination) {
+        configuration.prepareDestination(destination);
+    }
+    if (configuration._prepareDestination) {
+        configuration._prepareDestination(destination);
+    }
+    return destination;
+}
+
 #pragma mark ZIKRouterSubclass
 
 + (BOOL)isAbstractRouter {
@@ -607,7 +1882,19 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
 }
 
 + (BOOL)canMakeDestinationSynchronously {
-    return YES;
+    return ![self makesDestinationInBackground];
+}
+
++ (BOOL)makesDestinationInBackground {
+    return NO;
+}
+
++ (NSTimeInterval)performBudget {
+    return 0;
+}
+
++ (NSTimeInterval)destinationMakingTimeout {
+    return 0;
 }
 
 #pragma mark State Control
@@ -618,8 +1905,10 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
     if (destination == nil) {
         return;
     }
+    uint64_t signpost = zix_beginRouterSignpost(ZIKRouteSignpostStagePrepareDestination, self);
     ZIKPerformRouteConfiguration *configuration = self.original_configuration;
     if (configuration.prepareDestination) {
+        ZIX_WATCH_CALLBACK_SCOPE(self, ZIKRouteCallbackStagePrepareDestinationBlock);
         configuration.prepareDestination(destination);
     }
     BOOL hasMakedDestination = NO;
@@ -630,10 +1919,17 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
         }
     }
     if (configuration._prepareDestination) {
+        ZIX_WATCH_CALLBACK_SCOPE(self, ZIKRouteCallbackStagePrepareDestinationBlock);
         configuration._prepareDestination(destination);
     }
-    [self prepareDestination:destination configuration:configuration];
-    [self didFinishPrepareDestination:destination configuration:configuration];
+    {
+        ZIX_WATCH_CALLBACK_SCOPE(self, ZIKRouteCallbackStagePrepareDestination);
+        [self prepareDestination:destination configuration:configuration];
+    }
+    {
+        ZIX_WATCH_CALLBACK_SCOPE(self, ZIKRouteCallbackStageDidFinishPrepareDestination);
+        [self didFinishPrepareDestination:destination configuration:configuration];
+    }
     if ([configuration conformsToProtocol:@protocol(ZIKConfigurationAsyncMakeable)] && [configuration respondsToSelector:@selector(didMakeDestination)]) {
         id<ZIKConfigurationAsyncMakeable> makeableConfig = (id)configuration;
         void(^didMakeDestination)(id) = makeableConfig.didMakeDestination;
@@ -646,6 +1942,11 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
         id<ZIKConfigurationSyncMakeable> makeableConfiguration = (id<ZIKConfigurationSyncMakeable>)configuration;
         makeableConfiguration.makedDestination = nil;
     }
+    _recordRouterStage(self, ZIKRouterStageDestinationPrepared);
+#ifdef DEBUG
+    _checkPerformBudget(self);
+#endif
+    zix_endRouterSignpost(ZIKRouteSignpostStagePrepareDestination, signpost, self);
 }
 
 - (void)endPerformRouteWithSuccess {
@@ -656,8 +1957,13 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
 
 - (void)endPerformRouteWithError:(NSError *)error {
     NSAssert(self.state == ZIKRouterStateRouting, @"state should be routing when end to route.");
+    _recordRouterStage(self, ZIKRouterStagePerformFailed);
     [self notifyRouteState:self.preState];
     [self notifyError:error routeAction:ZIKRouteActionPerformRoute];
+    ZIKRouteInterceptorChain *chain = _interceptorChain(ZIKRouteInterceptionPointAfterEndPerformWithError);
+    if (chain) {
+        _interceptWithError(chain, self, error);
+    }
 }
 
 - (void)prepareDestinationForRemoving {
@@ -728,15 +2034,79 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
     return [self errorWithCode:code localizedDescription:description];
 }
 
++ (NSError *)errorWithCode:(NSInteger)code localizedDescriptionProvider:(NSString *(^)(void))provider {
+    NSParameterAssert(provider);
+    return [[ZIKLazyDescriptionError alloc] initWithDomain:[self errorDomain] code:code descriptionProvider:provider];
+}
+
+/// Trace the action from its start time, then reset the start time.
+static void _traceRouteAction(ZIKRouter *router, ZIKRouteAction routeAction, uint64_t *traceTime, BOOL succeeded) {
+    uint64_t startTime = *traceTime;
+    if (startTime == 0) {
+        return;
+    }
+    *traceTime = 0;
+    NSString *routeType = [router signpostRouteType];
+    NSString *detail = [NSString stringWithFormat:@"%@%@%@%@", routeAction, routeType ? @" " : @"", routeType ?: @"", succeeded ? @"" : @" failed"];
+    zix_traceComplete(object_getClassName(router), "route", startTime, detail.UTF8String);
+}
+
+/// Call handlers of performing on configuration's callbackQueue. Router is retained until handlers are called.
+static void _callOnCallbackQueue(ZIKRouter *router, ZIKRouteAction routeAction, dispatch_block_t handlers) {
+    dispatch_queue_t queue = [routeAction isEqualToString:ZIKRouteActionPerformRoute] ? router.original_configuration.callbackQueue : nil;
+    if (queue == nil || (queue == dispatch_get_main_queue() && [NSThread isMainThread])) {
+        handlers();
+        return;
+    }
+    dispatch_async(queue, handlers);
+}
+
 - (void)notifySuccessWithAction:(ZIKRouteAction)routeAction {
-    [self notifySuccessToProviderWithAction:routeAction];
-    [self notifySuccessToPerformerWithAction:routeAction];
+    if ([routeAction isEqualToString:ZIKRouteActionPerformRoute]) {
+        _traceRouteAction(self, routeAction, &_performTraceTime, YES);
+    } else if ([routeAction isEqualToString:ZIKRouteActionRemoveRoute]) {
+        _traceRouteAction(self, routeAction, &_removeTraceTime, YES);
+    }
+    if (_performStartTime && [routeAction isEqualToString:ZIKRouteActionPerformRoute]) {
+        zix_recordRouteMetric([self class], ZIKRouteMetricPerform, _performStartTime);
+        _performStartTime = 0;
+    } else if (_removeStartTime && [routeAction isEqualToString:ZIKRouteActionRemoveRoute]) {
+        zix_recordRouteMetric([self class], ZIKRouteMetricRemove, _removeStartTime);
+        _removeStartTime = 0;
+    }
+    uint64_t signpost = zix_beginRouterSignpost(ZIKRouteSignpostStageNotifySuccess, self);
+    _callOnCallbackQueue(self, routeAction, ^{
+        ZIX_WATCH_CALLBACK_SCOPE(self, ZIKRouteCallbackStageHandlers);
+        [self notifySuccessToProviderWithAction:routeAction];
+        [self notifySuccessToPerformerWithAction:routeAction];
+        if (self.state == ZIKRouterStateRouted &&
+            [routeAction isEqualToString:ZIKRouteActionPerformRoute] &&
+            self.original_configuration.releasesPerformHandlersWhenRouted) {
+            [self releasePerformHandlers];
+        }
+    });
+    zix_endRouteSignpost(ZIKRouteSignpostStageNotifySuccess, signpost, routeAction.UTF8String);
+    ZIKRouteInterceptorChain *chain = _interceptorChain(ZIKRouteInterceptionPointAfterSuccessAction);
+    if (chain) {
+        _interceptWithAction(chain, self, routeAction);
+    }
 }
 
 - (void)notifyError:(NSError *)error routeAction:(ZIKRouteAction)routeAction {
+    if ([routeAction isEqualToString:ZIKRouteActionPerformRoute]) {
+        _performStartTime = 0;
+        _traceRouteAction(self, routeAction, &_performTraceTime, NO);
+    } else if ([routeAction isEqualToString:ZIKRouteActionRemoveRoute]) {
+        _removeStartTime = 0;
+        _traceRouteAction(self, routeAction, &_removeTraceTime, NO);
+    }
     NSAssert(self.state != ZIKRouterStateRouting && self.state != ZIKRouterStateRemoving, @"State should not be routing or removing when action failed.");
-    [self notifyErrorToProvider:error routeAction:routeAction];
-    [self notifyErrorToPerformer:error routeAction:routeAction];
+    self.error = error;
+    _callOnCallbackQueue(self, routeAction, ^{
+        ZIX_WATCH_CALLBACK_SCOPE(self, ZIKRouteCallbackStageHandlers);
+        [self notifyErrorToProvider:error routeAction:routeAction];
+        [self notifyErrorToPerformer:error routeAction:routeAction];
+    });
     [[self class] notifyGlobalErrorWithRouter:self action:routeAction error:error];
 }
 
@@ -789,22 +2159,35 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
         if (configuration.performerErrorHandler) {
             configuration.performerErrorHandler = nil;
         }
+        [configuration takePerformerErrorHandlers];
         void(^performerSuccessHandler)(void) = configuration.performerSuccessHandler;
+        NSArray<void(^)(void)> *performerSuccessHandlers = [configuration takePerformerSuccessHandlers];
         if (performerSuccessHandler) {
             configuration.performerSuccessHandler = nil;
             performerSuccessHandler();
         }
+        for (void(^handler)(void) in performerSuccessHandlers) {
+            handler();
+        }
         return;
     }
     ZIKPerformRouteConfiguration *configuration = self.original_configuration;
     if (configuration.performerErrorHandler) {
         configuration.performerErrorHandler = nil;
     }
+    [configuration takePerformerErrorHandlers];
     void(^performerSuccessHandler)(id) = configuration.performerSuccessHandler;
+    NSArray<void(^)(id)> *performerSuccessHandlers = [configuration takePerformerSuccessHandlers];
     if (performerSuccessHandler) {
         configuration.performerSuccessHandler = nil;
         performerSuccessHandler(self.destination);
     }
+    if (performerSuccessHandlers) {
+        id destination = self.destination;
+        for (void(^handler)(id) in performerSuccessHandlers) {
+            handler(destination);
+        }
+    }
 }
 
 - (void)notifyErrorToPerformer:(NSError *)error routeAction:(ZIKRouteAction)routeAction {
@@ -817,21 +2200,31 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
         if (configuration.performerSuccessHandler) {
             configuration.performerSuccessHandler = nil;
         }
+        [configuration takePerformerSuccessHandlers];
         ZIKRouteErrorHandler performerErrorHandler = configuration.performerErrorHandler;
+        NSArray<ZIKRouteErrorHandler> *performerErrorHandlers = [configuration takePerformerErrorHandlers];
         if (performerErrorHandler) {
             configuration.performerErrorHandler = nil;
             performerErrorHandler(routeAction, error);
         }
+        for (ZIKRouteErrorHandler handler in performerErrorHandlers) {
+            handler(routeAction, error);
+        }
     } else {
         ZIKPerformRouteConfiguration *configuration = self.original_configuration;
         if (configuration.performerSuccessHandler) {
             configuration.performerSuccessHandler = nil;
         }
+        [configuration takePerformerSuccessHandlers];
         ZIKRouteErrorHandler performerErrorHandler = configuration.performerErrorHandler;
+        NSArray<ZIKRouteErrorHandler> *performerErrorHandlers = [configuration takePerformerErrorHandlers];
         if (performerErrorHandler) {
             configuration.performerErrorHandler = nil;
             performerErrorHandler(routeAction, error);
         }
+        for (ZIKRouteErrorHandler handler in performerErrorHandlers) {
+            handler(routeAction, error);
+        }
     }
 }
 
@@ -884,49 +2277,24 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
 }
 
 + (void)notifyGlobalErrorWithRouter:(nullable __kindof ZIKRouter *)router action:(ZIKRouteAction)action error:(NSError *)error {
+    zix_logRouteErrorEvent(router ? object_getClass(router) : self, action, router ? router.state : ZIKRouterStateUnrouted, error.code);
     void(^errorHandler)(__kindof ZIKRouter *_Nullable router, ZIKRouteAction action, NSError *error) = self.globalErrorHandler;
     if (errorHandler) {
         errorHandler(router, action, error);
     } else {
 #ifdef DEBUG
-        NSLog(@"❌ZIKRouter Error: router's action (%@) catch error: (%@),\nrouter:(%@)", action, error, router);
+        ZIX_LOG(Route, Error, @"❌ZIKRouter Error: router's action (%@) catch error: (%@),\nrouter:(%@)", action, error, router);
 #endif
     }
 }
 
 + (BOOL)_validateInfiniteRecursion {
-    NSUInteger maxRecursiveDepth = 200;
-    if ([self recursiveDepth] > maxRecursiveDepth) {
+    if (_recursiveDepth > ZIKMaxRecursiveDepth) {
         return NO;
     }
     return YES;
 }
 
-+ (void)increaseRecursiveDepth {
-    NSInteger depth = [self recursiveDepth];
-    [self setRecursiveDepth:++depth];
-}
-
-+ (void)decreaseRecursiveDepth {
-    NSInteger depth = [self recursiveDepth];
-    [self setRecursiveDepth:--depth];
-}
-
-+ (NSInteger)recursiveDepth {
-    NSNumber *depth = objc_getAssociatedObject(self, @selector(recursiveDepth));
-    if ([depth isKindOfClass:[NSNumber class]]) {
-        return [depth unsignedIntegerValue];
-    }
-    return 0;
-}
-
-+ (void)setRecursiveDepth:(NSInteger)depth {
-    if (depth < 0) {
-        depth = 0;
-    }
-    objc_setAssociatedObject(self, @selector(recursiveDepth), @(depth), OBJC_ASSOCIATION_RETAIN);
-}
-
 #pragma mark Getter/Setter
 
 - (ZIKPerformRouteConfiguration *)configuration {
@@ -950,6 +2318,22 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
 
 #pragma mark Debug
 
+- (nullable NSString *)signpostRouteType {
+    return nil;
+}
+
+- (NSInteger)eventLogRouteType {
+    return -1;
+}
+
+- (void)releasePerformHandlers {
+    ZIKPerformRouteConfiguration *configuration = self.original_configuration;
+    configuration.prepareDestination = nil;
+    configuration.successHandler = nil;
+    configuration.performerSuccessHandler = nil;
+    configuration.completionHandler = nil;
+}
+
 + (NSString *)descriptionOfState:(ZIKRouterState)state {
     NSString *description;
     switch (state) {
@@ -31,6 +31,26 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, copy, nullable) void(^_prepareDestination)(Destination destination);
 @end
 
+/// Points in router's state control where interceptors are invoked.
+typedef NS_ENUM(NSUInteger, ZIKRouteInterceptionPoint) {
+    /// Handler is `void(^)(ZIKRouter *router, ZIKPerformRouteConfiguration *configuration)`, invoked when entering -[ZIKRouter performWithConfiguration:]. Cancelling the configuration's cancellation token skips the rest of the chain and fails performing.
+    ZIKRouteInterceptionPointBeforePerform,
+    /// Handler is `void(^)(ZIKRouter *router, ZIKPerformRouteConfiguration *configuration)`, invoked when leaving -[ZIKRouter performWithConfiguration:].
+    ZIKRouteInterceptionPointAfterPerform,
+    /// Handler is `void(^)(ZIKRouter *router, ZIKRouteAction action)`, invoked after -[ZIKRouter notifySuccessWithAction:].
+    ZIKRouteInterceptionPointAfterSuccessAction,
+    /// Handler is `void(^)(ZIKRouter *router, NSError *error)`, invoked after -[ZIKRouter endPerformRouteWithError:].
+    ZIKRouteInterceptionPointAfterEndPerformWithError,
+    ZIKRouteInterceptionPointCount
+};
+
+/**
+ Add interceptor into the chain of the point. Interceptors with higher priority are invoked first, interceptors with same priority are invoked in adding order.
+ 
+ When key is not NULL, the interceptor added with the same key is replaced, and it's removed when handler is nil. Chains are published atomically, so routers read them without lock. Replaced chains are not freed, so avoid changing interceptors frequently.
+ */
+FOUNDATION_EXTERN void zix_setRouteInterceptor(ZIKRouteInterceptionPoint point, id _Nullable handler, NSInteger priority, const void *_Nullable key);
+
 #define ZIX_ADD_CATEGORY(CLASS, Protocol)    \
 @interface CLASS (Protocol) <Protocol>    \
 @end    \
@@ -61,6 +81,44 @@ NS_ASSUME_NONNULL_BEGIN
 /// If the router use a custom configuration, override this and return the configuration.
 + (RemoveConfig)defaultRemoveConfiguration;
 
+/**
+ Whether -performWithConfiguration: calls -destinationWithConfiguration: on a background queue. Default is NO. Return YES when creating destination is slow, such as opening database or decoding large models, and the destination can be created off main thread.
+ 
+ @discussion
+ Destination is attached and -performRouteOnDestination:configuration: is called on main thread after it's made. Performer can cancel making with -cancelMakingDestination. Routers returning YES can't make destination synchronously, so +canMakeDestinationSynchronously returns NO by default.
+ */
++ (BOOL)makesDestinationInBackground;
+
+/// Seconds to wait for making destination in background before performing fails with ZIKRouteErrorDestinationUnavailable. Default is 0, and there is no timeout. `ZIKPerformRouteConfiguration.destinationMakingTimeout` overrides it.
++ (NSTimeInterval)destinationMakingTimeout;
+
+/**
+ Latency budget in seconds from beginning to perform until destination is made and prepared. Default is 0, and there is no budget.
+ 
+ @discussion
+ Only checked in DEBUG. When a route exceeds the budget, time of making destination and preparing destination is logged, so slow routes are found during development. It asserts when ZIKROUTER_ASSERT_PERFORM_BUDGET is 1.
+ */
++ (NSTimeInterval)performBudget;
+
+/**
+ Whether `+makeDestination` and `+makeDestinationWithConfiguring:` reuse idle router instances of this router class instead of creating a new router each time. Default is NO. Only return YES when the router keeps no state of its own after making destination, and its destination doesn't keep the router.
+ 
+ @discussion
+ A pooled router is reset with -prepareForReuse after making destination. Configuration is still created for each making, because destination and module config may keep it. The strict configuration passed to `+makeDestinationWithStrictConfiguring:` is kept by the pooled router and rebound to each new configuration, so don't keep it outside the configuring block. Routers making destination asynchronously are not reused until they are finished.
+ */
++ (BOOL)reusesRouterForMakingDestination;
+
+/**
+ Service protocols or service module protocols the destination will get when it's initialized or performed. Default is nil. Routers of those protocols can declare their own dependencies, and the graph is warmed by `+warmServiceDependenciesWithCompletion:` or when `ZIKRouter.warmsServiceDependencies` is YES.
+ 
+ @discussion
+ Only declare services that can be made on any thread. Cycles in the graph are broken and asserted in debug.
+ */
++ (nullable NSArray<Protocol *> *)dependencyServiceProtocols;
+
+/// Reset the router to unrouted state before it's put into the pool when `+reusesRouterForMakingDestination` is YES. Subclass should reset its own state.
+- (void)prepareForReuse NS_REQUIRES_SUPER;
+
 #pragma mark Advanced Override
 
 /**
@@ -148,6 +206,8 @@ NS_ASSUME_NONNULL_BEGIN
 + (NSError *)errorWithCode:(NSInteger)code localizedDescription:(NSString *)description;
 /// error with domain from +errorDomain.
 + (NSError *)errorWithCode:(NSInteger)code localizedDescriptionFormat:(NSString *)format ,...;
+/// error with domain from +errorDomain. Provider is called once when the description or userInfo of the error is read, use it when formatting the description is expensive and the error may be ignored. Don't capture router strongly in the provider, the error may be retained by your handlers.
++ (NSError *)errorWithCode:(NSInteger)code localizedDescriptionProvider:(NSString *(^)(void))provider;
 
 + (NSString *)errorDomain;
 
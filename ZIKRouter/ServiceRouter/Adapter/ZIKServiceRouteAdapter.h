@@ -19,6 +19,8 @@ NS_ASSUME_NONNULL_BEGIN
  About module adapter, read https://github.com/Zuikyo/ZIKRouter/blob/master/Documentation/English/ModuleAdapter.md
  
  Why you need an adapter to decouple? There is a situation: module A need to use a file log module inside it, and A use the log module with a required interface (ModuleALogProtocol). The app context provides the log module as module B, and module B use a provided interface (ModuleBLogProtocol). So in the app context, you need to adapt required interface(ModuleALogProtocol) and provided interface(ModuleBLogProtocol). Use category, swift extension, NSProxy or custom mediator to forward ModuleALogProtocol to ModuleBLogProtocol. Then module A is totally decoupled with module B.
+ 
+ `ZIKRouterToService(ModuleALogProtocol)` costs the same as `ZIKRouterToService(ModuleBLogProtocol)`: ZIKServiceRouteRegistry resolves ModuleALogProtocol to the log service's router when registration is finished, so the adapter doesn't add a lookup. It only follows the adapters one by one when the log service router is registered lazily from a route table or registered in Swift, then the result is cached.
  */
 @interface ZIKServiceRouteAdapter : ZIKServiceRouter
 
@@ -17,24 +17,69 @@
 #import "ZIKServiceRouterInternal.h"
 #import "ZIKRouteConfigurationPrivate.h"
 
+@interface ZIKBlockServiceRouter () {
+    /// Route and its callbacks resolved from configuration once.
+    ZIKServiceRoute *_route;
+    const ZIKRouteCallbacks *_callbacks;
+}
+@end
+
+static const ZIKRouteCallbacks _emptyCallbacks;
+
 @implementation ZIKBlockServiceRouter
 
 + (BOOL)isAbstractRouter {
     return YES;
 }
 
+- (instancetype)initWithConfiguration:(ZIKPerformRouteConfiguration *)configuration removeConfiguration:(nullable ZIKRemoveRouteConfiguration *)removeConfiguration {
+    if (self = [super initWithConfiguration:configuration removeConfiguration:removeConfiguration]) {
+        _route = (ZIKServiceRoute *)configuration.route;
+        _callbacks = _route ? _route.callbacks : NULL;
+    }
+    return self;
+}
+
+- (void)prepareForReuse {
+    [super prepareForReuse];
+    _route = nil;
+    _callbacks = NULL;
+}
+
 - (ZIKServiceRoute *)route {
-    ZIKServiceRoute *route = (ZIKServiceRoute *)self.original_configuration.route;
-    NSAssert1(route, @"Can't find ZIKServiceRoute for block router (%@). If you add new class method in ZIKRouter or ZIKServiceRouter to create router, you must check your class method in ZIKRoute or ZIKServiceRoute to inject route to router.",self);
-    return route;
+    if (_route == nil) {
+        _route = (ZIKServiceRoute *)self.original_configuration.route;
+        NSAssert1(_route, @"Can't find ZIKServiceRoute for block router (%@). If you add new class method in ZIKRouter or ZIKServiceRouter to create router, you must check your class method in ZIKRoute or ZIKServiceRoute to inject route to router.",self);
+        _callbacks = _route ? _route.callbacks : NULL;
+    }
+    return _route;
+}
+
+static inline const ZIKRouteCallbacks *_callbacksOfRouter(ZIKBlockServiceRouter *router) {
+    if (router->_callbacks == NULL) {
+        [router route];
+    }
+    return router->_callbacks ?: &_emptyCallbacks;
+}
+
+- (ZIKServiceLifetime)destinationLifetime {
+    return self.route.serviceLifetime;
+}
+
+- (id)destinationLifetimeOwner {
+    return self.route;
 }
 
 - (nullable id)destinationWithConfiguration:(ZIKPerformRouteConfiguration *)configuration {
-    return self.route.makeDestinationBlock(configuration, self);
+    id(^makeDestinationBlock)(ZIKPerformRouteConfiguration *config, ZIKRouter *router) = _callbacksOfRouter(self)->makeDestination;
+    if (makeDestinationBlock) {
+        return makeDestinationBlock(configuration, self);
+    }
+    return nil;
 }
 
 - (void)prepareDestination:(id)destination configuration:(ZIKPerformRouteConfiguration *)configuration {
-    void(^prepareDestinationBlock)(id destination, ZIKPerformRouteConfiguration *config, ZIKRouter *router) = self.route.prepareDestinationBlock;
+    void(^prepareDestinationBlock)(id destination, ZIKPerformRouteConfiguration *config, ZIKRouter *router) = _callbacksOfRouter(self)->prepareDestination;
     if (prepareDestinationBlock) {
         prepareDestinationBlock(destination, configuration, self);
         return;
@@ -43,7 +88,7 @@
 }
 
 - (void)didFinishPrepareDestination:(id)destination configuration:(ZIKPerformRouteConfiguration *)configuration {
-    void(^didFinishPrepareDestinationBlock)(id destination, ZIKPerformRouteConfiguration *config, ZIKRouter *router) = self.route.didFinishPrepareDestinationBlock;
+    void(^didFinishPrepareDestinationBlock)(id destination, ZIKPerformRouteConfiguration *config, ZIKRouter *router) = _callbacksOfRouter(self)->didFinishPrepareDestination;
     if (didFinishPrepareDestinationBlock) {
         didFinishPrepareDestinationBlock(destination, configuration, self);
         return;
@@ -54,9 +99,9 @@
 - (ZIKRemoveRouteConfiguration *)original_removeConfiguration {
     if (_removeConfiguration == nil) {
         NSAssert(self.original_configuration, @"Configuration shouldn't be nil when lazy get removeConfiguration");
-        ZIKRoute *route = self.original_configuration.route;
-        if (route && route.makeDefaultRemoveConfigurationBlock) {
-            _removeConfiguration = route.makeDefaultRemoveConfigurationBlock();
+        ZIKRemoveRouteConfiguration *(^makeDefaultRemoveConfiguration)(void) = _callbacksOfRouter(self)->makeDefaultRemoveConfiguration;
+        if (makeDefaultRemoveConfiguration) {
+            _removeConfiguration = makeDefaultRemoveConfiguration();
         } else {
             _removeConfiguration = [[self class] defaultRemoveConfiguration];
         }
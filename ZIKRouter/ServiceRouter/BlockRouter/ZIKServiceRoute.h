@@ -62,6 +62,12 @@ NS_ASSUME_NONNULL_BEGIN
 /// Check whether destination is prepared correctly.
 @property (nonatomic, readonly) ZIKServiceRoute<Destination, RouteConfig> *(^didFinishPrepareDestination)(void(^)(Destination destination, RouteConfig config, ZIKServiceRouter *router));
 
+/// Set lifetime of services made by this route. See +serviceLifetime.
+@property (nonatomic, readonly) ZIKServiceRoute<Destination, RouteConfig> *(^lifetime)(ZIKServiceLifetime lifetime);
+
+/// Lifetime of services made by this route. Default is ZIKServiceLifetimeTransient.
+@property (nonatomic, readonly) ZIKServiceLifetime serviceLifetime;
+
 @end
 
 typedef ZIKServiceRoute<id, ZIKPerformRouteConfiguration *> ZIKAnyServiceRoute;
@@ -12,6 +12,8 @@
 #import "ZIKServiceRoute.h"
 #import "ZIKBlockServiceRouter.h"
 #import "ZIKServiceRouteRegistry.h"
+#import "ZIKRoutePrivate.h"
+#import "ZIKRouterPrivate.h"
 
 @implementation ZIKServiceRoute
 @dynamic nameAs;
@@ -25,6 +27,13 @@
 @dynamic prepareDestination;
 @dynamic didFinishPrepareDestination;
 
+- (ZIKServiceRoute *(^)(ZIKServiceLifetime))lifetime {
+    return ^(ZIKServiceLifetime lifetime) {
+        self->_serviceLifetime = lifetime;
+        return self;
+    };
+}
+
 - (Class)routerClass {
     return [ZIKBlockServiceRouter class];
 }
@@ -33,4 +42,33 @@
     return [ZIKServiceRouteRegistry class];
 }
 
+#pragma mark Make Destination
+
+/// Easy route of a registered factory makes destination by calling the factory directly, without router, router's configuration and state changes. Only when nothing would notice the missing router.
+- (BOOL)_canMakeDestinationWithoutRouter {
+    return self.makesDestinationWithoutRouter &&
+    _serviceLifetime == ZIKServiceLifetimeTransient &&
+    self.makeDefaultConfigurationBlock == nil &&
+    self.prepareDestinationBlock == nil &&
+    self.didFinishPrepareDestinationBlock == nil &&
+    !zix_routerHooksInstalled();
+}
+
+- (id)makeDestinationWithPreparation:(void(^ _Nullable)(id destination))prepare {
+    if (![self _canMakeDestinationWithoutRouter]) {
+        return [super makeDestinationWithPreparation:prepare];
+    }
+    ZIKPerformRouteConfiguration *configuration = [self defaultRouteConfiguration];
+    if (prepare) {
+        configuration.prepareDestination = prepare;
+    }
+    id(^makeDestination)(ZIKPerformRouteConfiguration *, ZIKRouter *) = self.makeDestinationBlock;
+    return zix_makeDestinationWithoutRouter([self routerClass], configuration, ^id _Nullable(ZIKPerformRouteConfiguration *config) {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wnonnull"
+        return makeDestination(config, nil);
+#pragma clang diagnostic pop
+    });
+}
+
 @end
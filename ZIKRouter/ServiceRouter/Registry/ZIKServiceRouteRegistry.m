@@ -11,14 +11,18 @@
 
 #import "ZIKServiceRouteRegistry.h"
 #import "ZIKRouteRegistryInternal.h"
+#import "ZIKRouteEdgeList.h"
 #import "ZIKRouterInternal.h"
 #import "ZIKServiceRouterInternal.h"
 #import "ZIKBlockServiceRouter.h"
 #import "ZIKServiceRouterType.h"
 #import "ZIKServiceRoute.h"
+#import "ZIKRoutePrivate.h"
 #import "ZIKRouterRuntime.h"
+#import "ZIKRouterPrivate.h"
 #import <objc/runtime.h>
 #import "ZIKPlatformCapabilities.h"
+#import "ZIKRouterLog.h"
 #if ZIK_HAS_UIKIT
 #import <UIKit/UIKit.h>
 #else
@@ -31,7 +35,13 @@ static CFMutableDictionaryRef _destinationToRoutersMap;
 static CFMutableDictionaryRef _destinationToDefaultRouterMap;
 static CFMutableDictionaryRef _destinationToExclusiveRouterMap;
 static CFMutableDictionaryRef _identifierToRouterMap;
+static CFMutableDictionaryRef _routeToRouterTypeMap;
+static CFMutableArrayRef      _allRoutes;
+static CFMutableSetRef        _allRoutesSet;
 static CFMutableDictionaryRef _adapterToAdapteeMap;
+static CFMutableDictionaryRef _destinationToResolvedRouteMap;
+static CFMutableDictionaryRef _destinationAdapterToRouteMap;
+static CFMutableDictionaryRef _moduleAdapterToRouteMap;
 static CFMutableDictionaryRef _destinationProtocolToDestinationMap;
 static CFMutableDictionaryRef _moduleConfigProtocolToDestinationMap;
 static CFMutableSetRef        _runtimeFactoryDestinationClasses;
@@ -42,9 +52,14 @@ static CFMutableDictionaryRef _destinationToDefaultFactoryMap;
 static CFMutableDictionaryRef _moduleConfigProtocolToFactoryMap;
 static CFMutableDictionaryRef _identifierToConfigFactoryMap;
 static CFMutableDictionaryRef _destinationToDefaultConfigFactoryMap;
+static void *_snapshot;
+static CFMutableDictionaryRef _destinationToEasyRouteMap;
+static CFMutableDictionaryRef _destinationProtocolToEasyRouteMap;
+static CFMutableDictionaryRef _moduleConfigProtocolToEasyRouteMap;
+static CFMutableDictionaryRef _identifierToEasyRouteMap;
 #if ZIKROUTER_CHECK
-static CFMutableDictionaryRef _check_routerToDestinationsMap;
-static CFMutableDictionaryRef _check_routerToDestinationProtocolsMap;
+static ZIKRouteEdgeList *_check_routerToDestinationEdges;
+static ZIKRouteEdgeList *_check_routerToDestinationProtocolEdges;
 static NSMutableArray<Class> *_routableDestinations;
 static NSMutableArray<Class> *_routerClasses;
 #endif
@@ -52,12 +67,15 @@ static NSMutableArray<Class> *_routerClasses;
 @implementation ZIKServiceRouteRegistry
 
 + (ZIKRoute *)easyRouteForDestinationClass:(Class)destinationClass factory:(id(^)(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router))factory {
-    return [[ZIKServiceRoute alloc] initWithMakeDestination:^id _Nullable(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
+    ZIKServiceRoute *route = [[ZIKServiceRoute alloc] initWithMakeDestination:^id _Nullable(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router) {
         if (!factory) {
             return nil;
         }
         return factory(config, router);
     }];
+    // Registered factories only use the configuration
+    route.makesDestinationWithoutRouter = YES;
+    return route;
 }
 
 + (ZIKRoute *)easyRouteForDestinationClass:(Class)destinationClass configFactory:(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(^)(void))factory {
@@ -78,6 +96,14 @@ static NSMutableArray<Class> *_routerClasses;
     return [ZIKServiceRouterType class];
 }
 
++ (ZIKRouterCounter)lookupCounter {
+    return ZIKRouterCounterServiceLookup;
+}
+
++ (ZIKRouterCounter)lookupMissCounter {
+    return ZIKRouterCounterServiceLookupMiss;
+}
+
 + (nullable id)routeKeyForRouter:(ZIKRouter *)router {
     if ([router isKindOfClass:[ZIKServiceRouter class]] == NO) {
         return nil;
@@ -151,6 +177,27 @@ static NSMutableArray<Class> *_routerClasses;
     });
     return _identifierToRouterMap;
 }
++ (CFMutableDictionaryRef)routeToRouterTypeMap {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _routeToRouterTypeMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    });
+    return _routeToRouterTypeMap;
+}
++ (CFMutableArrayRef)allRoutes {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _allRoutes = CFArrayCreateMutable(kCFAllocatorDefault, 0, NULL);
+    });
+    return _allRoutes;
+}
++ (CFMutableSetRef)allRoutesSet {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _allRoutesSet = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+    });
+    return _allRoutesSet;
+}
 + (CFMutableDictionaryRef)adapterToAdapteeMap {
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
@@ -158,6 +205,27 @@ static NSMutableArray<Class> *_routerClasses;
     });
     return _adapterToAdapteeMap;
 }
++ (CFMutableDictionaryRef)destinationToResolvedRouteMap {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _destinationToResolvedRouteMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    });
+    return _destinationToResolvedRouteMap;
+}
++ (CFMutableDictionaryRef)destinationAdapterToRouteMap {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _destinationAdapterToRouteMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    });
+    return _destinationAdapterToRouteMap;
+}
++ (CFMutableDictionaryRef)moduleAdapterToRouteMap {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _moduleAdapterToRouteMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    });
+    return _moduleAdapterToRouteMap;
+}
 + (CFMutableDictionaryRef)identifierToDestinationMap {
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
@@ -207,27 +275,69 @@ static NSMutableArray<Class> *_routerClasses;
     });
     return _destinationToDefaultConfigFactoryMap;
 }
-+ (CFMutableDictionaryRef)_check_routerToDestinationsMap {
-#if ZIKROUTER_CHECK
++ (CFMutableDictionaryRef)destinationToEasyRouteMap {
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
-        _check_routerToDestinationsMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+        _destinationToEasyRouteMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
     });
-    return _check_routerToDestinationsMap;
-#else
-    return NULL;
-#endif
+    return _destinationToEasyRouteMap;
+}
++ (CFMutableDictionaryRef)destinationProtocolToEasyRouteMap {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _destinationProtocolToEasyRouteMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    });
+    return _destinationProtocolToEasyRouteMap;
+}
++ (CFMutableDictionaryRef)moduleConfigProtocolToEasyRouteMap {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _moduleConfigProtocolToEasyRouteMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    });
+    return _moduleConfigProtocolToEasyRouteMap;
+}
++ (CFMutableDictionaryRef)identifierToEasyRouteMap {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _identifierToEasyRouteMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, &kCFTypeDictionaryValueCallBacks);
+    });
+    return _identifierToEasyRouteMap;
+}
++ (void **)snapshotStorage {
+    return &_snapshot;
+}
+
++ (void)compactContainers {
+    CFTypeRef *containers[] = {
+        (CFTypeRef *)&_destinationProtocolToRouterMap, (CFTypeRef *)&_moduleConfigProtocolToRouterMap, (CFTypeRef *)&_destinationToRoutersMap, (CFTypeRef *)&_destinationToDefaultRouterMap, (CFTypeRef *)&_destinationToExclusiveRouterMap, (CFTypeRef *)&_identifierToRouterMap, (CFTypeRef *)&_routeToRouterTypeMap, (CFTypeRef *)&_allRoutes, (CFTypeRef *)&_allRoutesSet,
+        (CFTypeRef *)&_destinationProtocolToDestinationMap, (CFTypeRef *)&_moduleConfigProtocolToDestinationMap, (CFTypeRef *)&_identifierToDestinationMap, (CFTypeRef *)&_runtimeFactoryDestinationClasses,
+        (CFTypeRef *)&_destinationProtocolToFactoryMap, (CFTypeRef *)&_identifierToFactoryMap, (CFTypeRef *)&_destinationToDefaultFactoryMap, (CFTypeRef *)&_moduleConfigProtocolToFactoryMap, (CFTypeRef *)&_identifierToConfigFactoryMap, (CFTypeRef *)&_destinationToDefaultConfigFactoryMap,
+        (CFTypeRef *)&_destinationToEasyRouteMap, (CFTypeRef *)&_destinationProtocolToEasyRouteMap, (CFTypeRef *)&_moduleConfigProtocolToEasyRouteMap, (CFTypeRef *)&_identifierToEasyRouteMap, (CFTypeRef *)&_adapterToAdapteeMap
+    };
+    // Resolved route maps are caches filled after registration is finished, they are not compacted
+    for (size_t i = 0; i < sizeof(containers) / sizeof(containers[0]); i++) {
+        zix_compactRegistryContainer(containers[i]);
+    }
 }
-+ (CFMutableDictionaryRef)_check_routerToDestinationProtocolsMap {
 #if ZIKROUTER_CHECK
++ (ZIKRouteEdgeList *)_check_routerToDestinationEdges {
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
-        _check_routerToDestinationProtocolsMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+        _check_routerToDestinationEdges = zix_createRouteEdgeList();
     });
-    return _check_routerToDestinationProtocolsMap;
-#else
-    return NULL;
+    return _check_routerToDestinationEdges;
+}
++ (ZIKRouteEdgeList *)_check_routerToDestinationProtocolEdges {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _check_routerToDestinationProtocolEdges = zix_createRouteEdgeList();
+    });
+    return _check_routerToDestinationProtocolEdges;
+}
 #endif
+
++ (Class)routerBaseClass {
+    return [ZIKServiceRouter class];
 }
 
 + (void)handleEnumerateRouterClass:(Class)class {
@@ -237,11 +347,15 @@ static NSMutableArray<Class> *_routerClasses;
         ZIKServiceRouterClass = [ZIKServiceRouter class];
     });
     if (zix_classIsSubclassOfClass(class, ZIKServiceRouterClass)) {
-        [class registerRoutableDestination];
+        [self registerRouterClass:class];
     }
 }
 
-+ (void)didFinishRegistration {
++ (void)evictCachesInImage:(const void *)header {
+    zix_discardSharedServicesInImage(header);
+}
+
++ (void)validateRegistration {
 #if ZIKROUTER_CHECK
     [self _searchAllRoutersAndDestinations];
     [self _checkAllRouters];
@@ -266,42 +380,27 @@ static NSMutableArray<Class> *_routerClasses;
 }
 
 + (BOOL)isDestinationClassRoutable:(Class)aClass {
-    while (aClass) {
-        if (class_conformsToProtocol(aClass, @protocol(ZIKRoutableService))) {
-            return YES;
-        }
-        aClass = class_getSuperclass(aClass);
-    }
-    return NO;
+    return zix_classConformsToProtocol(aClass, @protocol(ZIKRoutableService));
+}
+
++ (nullable Class)routableRootClassOfDestinationClass:(Class)aClass {
+    return zix_rootClassConformingToProtocol(aClass, @protocol(ZIKRoutableService));
 }
 
 + (void)enumerateAllServiceRouters:(void(NS_NOESCAPE ^)(Class _Nullable routerClass, ZIKServiceRoute * _Nullable route))handler {
-    static NSSet *cachedAllRouters;
-    NSSet *routers;
-    if ([self registrationFinished] && cachedAllRouters && cachedAllRouters.count > 0) {
-        routers = cachedAllRouters;
-    } else {
-        NSMutableSet *allRouters = [NSMutableSet set];
-        NSDictionary *destinationToRoutersMap = (__bridge NSDictionary *)self.destinationToRoutersMap;
-        [destinationToRoutersMap enumerateKeysAndObjectsUsingBlock:^(Class _Nonnull destinationClass, NSSet * _Nonnull routers, BOOL * _Nonnull stop) {
-            [allRouters unionSet:routers];
-        }];
-        NSDictionary *destinationToExclusiveRouterMap = (__bridge NSDictionary *)self.destinationToExclusiveRouterMap;
-        [destinationToExclusiveRouterMap enumerateKeysAndObjectsUsingBlock:^(Class _Nonnull destinationClass, id  _Nonnull router, BOOL * _Nonnull stop) {
-            [allRouters addObject:router];
-        }];
-        cachedAllRouters = allRouters;
-        routers = allRouters;
+    [self registerLazyRouters];
+    if (handler == nil) {
+        return;
     }
-    
-    if (handler) {
-        [routers enumerateObjectsUsingBlock:^(id  _Nonnull route, BOOL * _Nonnull stop) {
-            if ([route class] == route) {
-                handler(route, nil);
-            } else {
-                handler(nil, route);
-            }
-        }];
+    // Routes registered in handler are also enumerated
+    CFArrayRef allRoutes = self.allRoutes;
+    for (CFIndex i = 0; i < CFArrayGetCount(allRoutes); i++) {
+        id route = (__bridge id)CFArrayGetValueAtIndex(allRoutes, i);
+        if ([route class] == route) {
+            handler(route, nil);
+        } else {
+            handler(nil, route);
+        }
     }
 }
 
@@ -329,53 +428,60 @@ static NSMutableArray<Class> *_routerClasses;
                   [class isAdapter])) {
                 [errorDescription appendFormat:@"\n\n❌Router(%@) must override -destinationWithConfiguration: to return destination.",class];
             }
-            CFMutableSetRef services = (CFMutableSetRef)CFDictionaryGetValue(self._check_routerToDestinationsMap, (__bridge const void *)(class));
-            NSSet *serviceSet = (__bridge NSSet *)(services);
-            if (!(serviceSet.count > 0 || [class isAbstractRouter] || [class isAdapter])) {
+            if (!(zix_routeEdgeListContainsRoute(self._check_routerToDestinationEdges, (__bridge const void *)(class)) || [class isAbstractRouter] || [class isAdapter])) {
                 [errorDescription appendFormat:@"\n\n❌Router class(%@) is not resgistered with any service class. Use +registerService: to register service in Router(%@)'s +registerRoutableDestination.", class, class];
             }
             [_routerClasses addObject:class];
         }
     });
     if (errorDescription.length > 0) {
-        NSLog(@"\n❌Found router implementation errors:%@", errorDescription);
+        ZIX_LOG(Registry, Error, @"❌Found router implementation errors:%@", errorDescription);
         NSAssert(NO, errorDescription);
     }
 }
 
 + (void)_checkAllRoutableDestinations {
-    NSMutableString *errorDescription = [NSMutableString string];
-    for (Class destinationClass in _routableDestinations) {
+    NSArray<Class> *routableDestinations = [_routableDestinations copy];
+    NSString *errorDescription = [self validateConcurrentlyWithCount:routableDestinations.count handler:^NSString * _Nullable(NSUInteger index) {
+        Class destinationClass = routableDestinations[index];
         if (!(CFDictionaryGetValue(self.destinationToDefaultRouterMap, (__bridge const void *)(destinationClass)) != NULL ||
               CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass)) != NULL ||
               [self easyRouteForDestinationClass:destinationClass])) {
-            [errorDescription appendFormat:@"\n\n❌Routable service (%@) is not registered with any service router.", destinationClass];
+            return [NSString stringWithFormat:@"\n\n❌Routable service (%@) is not registered with any service router.", destinationClass];
         }
-    }
+        return nil;
+    }];
     if (errorDescription.length > 0) {
-        NSLog(@"\n❌Found router implementation errors:%@", errorDescription);
+        ZIX_LOG(Registry, Error, @"❌Found router implementation errors:%@", errorDescription);
         NSAssert(NO, errorDescription);
     }
 }
 
 + (void)_checkAllRouters {
-    for (Class class in _routerClasses) {
-        [class _didFinishRegistration];
+    if (ZIKRouteRegistry.validatesInBackground) {
+        NSArray<Class> *routerClasses = _routerClasses;
+        dispatch_apply(routerClasses.count, zix_globalQueueWithQOS(QOS_CLASS_UTILITY), ^(size_t idx) {
+            [routerClasses[idx] _didFinishRegistration];
+        });
+    } else {
+        for (Class class in _routerClasses) {
+            [class _didFinishRegistration];
+        }
     }
 }
 
 + (void)_checkAllRoutableProtocols {
-    NSMutableString *errorDescription = [NSMutableString string];
+    NSMutableArray<Protocol *> *protocols = [NSMutableArray array];
     zix_enumerateProtocolList(^(Protocol *protocol) {
         if (protocol) {
-            NSString *error = [self _checkProtocol:protocol];
-            if (error) {
-                [errorDescription appendString:error];
-            }
+            [protocols addObject:protocol];
         }
     });
+    NSString *errorDescription = [self validateConcurrentlyWithCount:protocols.count handler:^NSString * _Nullable(NSUInteger index) {
+        return [self _checkProtocol:protocols[index]];
+    }];
     if (errorDescription.length > 0) {
-        NSLog(@"\n❌Found router implementation errors:%@", errorDescription);
+        ZIX_LOG(Registry, Error, @"❌Found router implementation errors:%@", errorDescription);
         NSAssert(NO, errorDescription);
     }
 }
@@ -392,8 +498,10 @@ static NSMutableArray<Class> *_routerClasses;
             router = routerType.route;
         }
         
-        CFSetRef servicesRef = CFDictionaryGetValue(self._check_routerToDestinationsMap, (__bridge const void *)(router));
-        NSSet *services = (__bridge NSSet *)(servicesRef);
+        NSMutableArray<Class> *services = [NSMutableArray array];
+        zix_routeEdgeListEnumerateTargets(self._check_routerToDestinationEdges, (__bridge const void *)(router), ^(const void * _Nonnull target, BOOL * _Nonnull stop) {
+            [services addObject:(__bridge Class)target];
+        });
         if (!(services.count > 0 ||
               CFDictionaryGetValue(self.destinationProtocolToDestinationMap, (__bridge const void *)(protocol)) ||
               CFDictionaryGetValue(self.destinationProtocolToFactoryMap, (__bridge const void *)(protocol)))) {
@@ -30,6 +30,9 @@ NS_ASSUME_NONNULL_BEGIN
 /// If this route action doesn't need any arguments, perform directly with preparation. The block is an escaping block, use weak self in it.
 - (nullable ZIKServiceRouter<Destination, RouteConfig> *)performWithPreparation:(void(^)(Destination destination))prepare;
 
+/// Return a proxy making the service with preparation on its first message. See `+[ZIKServiceRouter makeLazyDestinationWithPreparation:]`.
+- (nullable Destination)makeLazyDestinationWithPreparation:(void(^ _Nullable)(Destination destination))prepare;
+
 /// Set dependencies required by destination and perform route.
 - (nullable ZIKServiceRouter<Destination, RouteConfig> *)performWithConfiguring:(void(NS_NOESCAPE ^)(RouteConfig config))configBuilder;
 /// Set dependencies required by destination and perform route, and you can remove the route with remove configuration later.
@@ -12,6 +12,7 @@
 #import "ZIKServiceRouterType.h"
 #import "ZIKServiceRouter.h"
 #import "ZIKServiceRoute.h"
+#import "ZIKLazyServiceProxy.h"
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wincomplete-implementation"
@@ -41,6 +42,34 @@
     return self;
 }
 
+#pragma mark Trampolines
+
+- (id)performRoute {
+    return [self.routeObject performRoute];
+}
+
+- (id)performWithPreparation:(void(^)(id destination))prepare {
+    return [self.routeObject performWithPreparation:prepare];
+}
+
+- (id)makeLazyDestinationWithPreparation:(void(^)(id destination))prepare {
+    if (![self canMakeDestinationSynchronously]) {
+        return nil;
+    }
+    id routeObject = self.routeObject;
+    return [[ZIKLazyServiceProxy alloc] initWithMaker:^id _Nullable{
+        return [routeObject makeDestinationWithPreparation:prepare];
+    }];
+}
+
+- (id)performWithConfiguring:(void(NS_NOESCAPE ^)(ZIKPerformRouteConfiguration *config))configBuilder {
+    return [self.routeObject performWithConfiguring:configBuilder];
+}
+
+- (id)performWithConfiguring:(void(NS_NOESCAPE ^)(ZIKPerformRouteConfiguration *config))configBuilder removing:(void(NS_NOESCAPE ^ _Nullable)(ZIKRemoveRouteConfiguration *config))removeConfigBuilder {
+    return [self.routeObject performWithConfiguring:configBuilder removing:removeConfigBuilder];
+}
+
 @end
 
 #pragma clang diagnostic pop
@@ -0,0 +1,32 @@
+//
+//  ZIKLazyServiceProxy.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Proxy making the service on its first message. Later messages are forwarded to the service with `-forwardingTargetForSelector:`, without building invocations. Messages are ignored and return 0 when the service can't be made.
+ 
+ @discussion
+ -isProxy, -hash and -isEqual: don't make the service, so the proxy can be put into collections. Other messages from NSObject protocol, such as -conformsToProtocol: and -respondsToSelector:, make the service and are forwarded. The service is made on the thread sending the first message, and other threads wait for it.
+ */
+@interface ZIKLazyServiceProxy : NSProxy
+
+/// Whether the service was already made. It doesn't make the service.
+@property (nonatomic, readonly, getter=isResolved) BOOL resolved;
+
+/// Create proxy with block making the service. The block is released after it's called.
+- (instancetype)initWithMaker:(id _Nullable(^)(void))maker;
+
+@end
+
+NS_ASSUME_NONNULL_END
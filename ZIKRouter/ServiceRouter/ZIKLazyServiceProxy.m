@@ -0,0 +1,110 @@
+//
+//  ZIKLazyServiceProxy.m
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKLazyServiceProxy.h"
+#import <pthread.h>
+
+@implementation ZIKLazyServiceProxy {
+    id _Nullable(^_maker)(void);
+    id _target;
+    /// Set after _target is made, read without lock.
+    bool _resolved;
+    pthread_mutex_t _lock;
+}
+
+- (instancetype)initWithMaker:(id _Nullable(^)(void))maker {
+    NSParameterAssert(maker);
+    _maker = [maker copy];
+    pthread_mutex_init(&_lock, NULL);
+    return self;
+}
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_lock);
+}
+
+- (BOOL)isResolved {
+    return __atomic_load_n(&_resolved, __ATOMIC_ACQUIRE);
+}
+
+- (nullable id)_target {
+    if (__atomic_load_n(&_resolved, __ATOMIC_ACQUIRE)) {
+        return _target;
+    }
+    pthread_mutex_lock(&_lock);
+    if (!_resolved) {
+        id(^maker)(void) = _maker;
+        _maker = nil;
+        _target = maker ? maker() : nil;
+        __atomic_store_n(&_resolved, true, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&_lock);
+    return _target;
+}
+
+#pragma mark Forwarding
+
+- (id)forwardingTargetForSelector:(SEL)selector {
+    return [self _target];
+}
+
+// Only called when the service is nil
+- (NSMethodSignature *)methodSignatureForSelector:(SEL)selector {
+    return [NSObject instanceMethodSignatureForSelector:@selector(init)];
+}
+
+- (void)forwardInvocation:(NSInvocation *)invocation {
+    void *nilReturn = NULL;
+    [invocation setReturnValue:&nilReturn];
+}
+
+#pragma mark NSObject
+
+- (BOOL)isProxy {
+    return YES;
+}
+
+- (NSUInteger)hash {
+    return (NSUInteger)self;
+}
+
+- (BOOL)isEqual:(id)object {
+    return object == self;
+}
+
+- (BOOL)respondsToSelector:(SEL)selector {
+    return [[self _target] respondsToSelector:selector];
+}
+
+- (BOOL)conformsToProtocol:(Protocol *)protocol {
+    return [[self _target] conformsToProtocol:protocol];
+}
+
+- (BOOL)isKindOfClass:(Class)aClass {
+    return [[self _target] isKindOfClass:aClass];
+}
+
+- (BOOL)isMemberOfClass:(Class)aClass {
+    return [[self _target] isMemberOfClass:aClass];
+}
+
+- (NSString *)description {
+    if (!self.isResolved) {
+        return [NSString stringWithFormat:@"<%@: %p, unresolved>", object_getClass(self), self];
+    }
+    return [_target description];
+}
+
+- (NSString *)debugDescription {
+    return [self description];
+}
+
+@end
@@ -11,6 +11,7 @@
 
 #import "ZIKServiceRouter.h"
 #import "ZIKServiceRouterType.h"
+#import "ZIKRouteHandle.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -20,6 +21,12 @@ NS_ASSUME_NONNULL_BEGIN
 /// Get service router in a type safe way. There will be compile error if the module protocol is not ZIKServiceModuleRoutable.
 #define ZIKRouterToServiceModule(ModuleProtocol) [ZIKServiceRouter<id,ZIKPerformRouteConfiguration<ModuleProtocol> *> toModule](ZIKRoutable(ModuleProtocol))
 
+/// Get a handle caching the service router in a type safe way. Keep the handle and read its `routerType`, it looks up again only when routes are changed.
+#define ZIKRouteHandleToService(ServiceProtocol) [ZIKRouteHandle<ZIKServiceRouterType<id<ServiceProtocol>,ZIKPerformRouteConfiguration *> *> handleWithLookup:^ZIKServiceRouterType<id<ServiceProtocol>,ZIKPerformRouteConfiguration *> *_Nullable{ return ZIKRouterToService(ServiceProtocol); }]
+
+/// Get a handle caching the service module router in a type safe way.
+#define ZIKRouteHandleToServiceModule(ModuleProtocol) [ZIKRouteHandle<ZIKServiceRouterType<id,ZIKPerformRouteConfiguration<ModuleProtocol> *> *> handleWithLookup:^ZIKServiceRouterType<id,ZIKPerformRouteConfiguration<ModuleProtocol> *> *_Nullable{ return ZIKRouterToServiceModule(ModuleProtocol); }]
+
 @interface ZIKServiceRouter<__covariant Destination: id, __covariant RouteConfig: ZIKPerformRouteConfiguration *> (Discover)
 
 /**
@@ -52,6 +59,40 @@ NS_ASSUME_NONNULL_BEGIN
 /// Find service router registered with the unique identifier.
 @property (nonatomic, class, readonly) ZIKAnyServiceRouterType * _Nullable (^toIdentifier)(NSString *identifier);
 
+/// Find service router registered with the identifier of the handle from `+[ZIKRouter handleForIdentifier:]`. It doesn't hash the identifier string.
+@property (nonatomic, class, readonly) ZIKAnyServiceRouterType * _Nullable (^toIdentifierHandle)(ZIKRouteIdentifierHandle handle);
+
+/**
+ Make services for a list of service protocols and module protocols in one call. It's for bootstrapping modules that fetch many services. Routers are looked up first, then services are made with default configurations.
+ 
+ @discussion
+ When concurrently is YES, independent services are made on background queues in parallel, and this method returns after all services are made. Only use it when all those services can be initialized on any thread and don't depend on each other's initialization order.
+ 
+ @param protocols ZIKServiceRoutable protocols or ZIKServiceModuleRoutable protocols.
+ @param concurrently Whether making services concurrently.
+ @return Services in the same order as protocols. NSNull is used for a protocol when its router is not found or the router can't make the service synchronously.
+ */
++ (NSArray *)makeDestinationsForProtocols:(NSArray<Protocol *> *)protocols concurrently:(BOOL)concurrently NS_SWIFT_UNAVAILABLE("Make services with `Router.makeDestination(to:)` in ZRouter instead");
+
+@end
+
+@interface ZIKRouter (ServiceDependencies)
+
+/**
+ Whether performing a router warms services declared in its `+dependencyServiceProtocols` in parallel with the transition. Default is NO.
+ 
+ @discussion
+ The dependency graph of each router class is built once after registration is finished. Services of the graph are made from leaves to roots on background queues, services without dependency between each other are made concurrently. Only services with ZIKServiceLifetimeSingleton or ZIKServiceLifetimeWeakShared are made, so destination gets them from the shared cache later. Warmed weak shared services are kept by the performing router.
+ */
+@property (nonatomic, class) BOOL warmsServiceDependencies;
+
+/**
+ Warm services declared in `+dependencyServiceProtocols` of the router class and their dependencies, before performing the router. Services are made in the same way as `warmsServiceDependencies`.
+ 
+ @param completion Called on main queue with the warmed services. Keep them if there are weak shared services.
+ */
++ (void)warmServiceDependenciesWithCompletion:(void(^ _Nullable)(NSArray *services))completion;
+
 @end
 
 NS_ASSUME_NONNULL_END
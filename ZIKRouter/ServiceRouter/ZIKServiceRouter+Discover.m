@@ -14,6 +14,10 @@
 #import "ZIKRouterPrivate.h"
 #import "ZIKServiceRouteRegistry.h"
 #import "ZIKRouteRegistryInternal.h"
+#import "ZIKServiceRouterInternal.h"
+#import "ZIKServiceRoute.h"
+#import "ZIKRouterRuntime.h"
+#import <objc/runtime.h>
 
 
 ZIKServiceRouterType *_Nullable _ZIKServiceRouterToService(Protocol *serviceProtocol) {
@@ -71,6 +75,42 @@ ZIKAnyServiceRouterType *_Nullable _ZIKServiceRouterToIdentifier(NSString *ident
     return nil;
 }
 
+ZIKAnyServiceRouterType *_Nullable _ZIKServiceRouterToIdentifierHandle(ZIKRouteIdentifierHandle handle) {
+    ZIKRouterType *route = [ZIKServiceRouteRegistry routerToIdentifierHandle:handle];
+    if ([route isKindOfClass:[ZIKServiceRouterType class]]) {
+        return (ZIKServiceRouterType *)route;
+    }
+    return nil;
+}
+
+/// Make services with router types, NSNull is used for routers can't make service synchronously.
+static NSArray *_makeDestinations(NSArray *routerTypes, BOOL concurrently) {
+    NSUInteger count = routerTypes.count;
+    __strong id *destinations = (__strong id *)calloc(count, sizeof(id));
+    void(^makeDestination)(size_t) = ^(size_t idx) {
+        ZIKServiceRouterType *routerType = routerTypes[idx];
+        if ((id)routerType == [NSNull null] || ![routerType canMakeDestination]) {
+            return;
+        }
+        destinations[idx] = [routerType makeDestination];
+    };
+    if (concurrently && count > 1) {
+        dispatch_apply(count, zix_globalQueueWithQOS(QOS_CLASS_USER_INITIATED), makeDestination);
+    } else {
+        for (size_t idx = 0; idx < count; idx++) {
+            makeDestination(idx);
+        }
+    }
+    
+    NSMutableArray *result = [NSMutableArray arrayWithCapacity:count];
+    for (size_t idx = 0; idx < count; idx++) {
+        [result addObject:destinations[idx] ?: [NSNull null]];
+        destinations[idx] = nil;
+    }
+    free(destinations);
+    return result;
+}
+
 @implementation ZIKServiceRouter (Discover)
 
 + (ZIKServiceRouterType<id, ZIKPerformRouteConfiguration *> *(^)(Protocol<ZIKServiceRoutable> *))toService {
@@ -116,4 +156,221 @@ ZIKAnyServiceRouterType *_Nullable _ZIKServiceRouterToIdentifier(NSString *ident
     };
 }
 
++ (ZIKAnyServiceRouterType *(^)(ZIKRouteIdentifierHandle))toIdentifierHandle {
+    return ^(ZIKRouteIdentifierHandle handle) {
+        ZIKAnyServiceRouterType *routerType = _ZIKServiceRouterToIdentifierHandle(handle);
+        if (routerType) {
+            return routerType;
+        }
+        NSString *identifier = zix_routeIdentifierOfHandle(handle);
+        [ZIKServiceRouter notifyError_invalidProtocolWithAction:ZIKRouteActionToService
+                                               errorDescription:@"Didn't find service router for identifier: %@ of handle: %u, this identifier was not registered.",identifier,handle];
+        if (ZIKRouteRegistry.registrationFinished) {
+            NSCAssert2(NO, @"Didn't find service router for identifier: %@ of handle: %u, this identifier was not registered.",identifier,handle);
+        } else {
+            NSCAssert2(NO, @"❌❌❌❌warning: failed to get router for service identifier (%@) of handle (%u), because manually registration is not finished yet! If there're modules running before registration is finished, and modules require some routers before you register them, then you should register those required routers earlier.",identifier,handle);
+        }
+        return routerType;
+    };
+}
+
++ (NSArray *)makeDestinationsForProtocols:(NSArray<Protocol *> *)protocols concurrently:(BOOL)concurrently {
+    NSUInteger count = protocols.count;
+    if (count == 0) {
+        return @[];
+    }
+    // Look up all routers first, so making services doesn't interleave with registry lookups
+    NSMutableArray *routerTypes = [NSMutableArray arrayWithCapacity:count];
+    for (id protocol in protocols) {
+        ZIKServiceRouterType *routerType;
+        if (_routableServiceProtocolFromObject(protocol)) {
+            routerType = _ZIKServiceRouterToService(protocol);
+        } else if (_routableServiceModuleProtocolFromObject(protocol)) {
+            routerType = _ZIKServiceRouterToModule(protocol);
+        } else {
+            [ZIKServiceRouter notifyError_invalidProtocolWithAction:ZIKRouteActionToService errorDescription:@"+makeDestinationsForProtocols: (%@) is not a ZIKServiceRoutable or ZIKServiceModuleRoutable protocol", protocol];
+            NSAssert1(NO, @"+makeDestinationsForProtocols: (%@) is not a ZIKServiceRoutable or ZIKServiceModuleRoutable protocol", protocol);
+        }
+        [routerTypes addObject:routerType ?: [NSNull null]];
+    }
+    
+    return _makeDestinations(routerTypes, concurrently);
+}
+
+@end
+
+#pragma mark Service Dependencies
+
+static BOOL _warmsServiceDependencies = NO;
+/// Warming plan of each router class after registration is finished, guarded by _dependencyPlansSema.
+static NSMapTable<Class, NSArray<NSArray<ZIKServiceRouterType *> *> *> *_dependencyPlans;
+static dispatch_semaphore_t _dependencyPlansSema;
+static char _warmedServicesKey;
+
+static ZIKServiceRouterType *_Nullable _routerTypeForDependency(Protocol *protocol) {
+    if (_routableServiceProtocolFromObject(protocol)) {
+        return _ZIKServiceRouterToService(protocol);
+    }
+    if (_routableServiceModuleProtocolFromObject(protocol)) {
+        return _ZIKServiceRouterToModule(protocol);
+    }
+    NSCAssert1(NO, @"+dependencyServiceProtocols (%@) is not a ZIKServiceRoutable or ZIKServiceModuleRoutable protocol", protocol);
+    return nil;
+}
+
+static NSArray<Protocol *> *_Nullable _dependencyProtocolsOfRoute(id route) {
+    if (object_isClass(route) && [route isSubclassOfClass:[ZIKRouter class]]) {
+        return [route dependencyServiceProtocols];
+    }
+    return nil;
+}
+
+/// Only shared services are worth warming, transient services are made again by destination.
+static BOOL _isSharedServiceRoute(id route) {
+    ZIKServiceLifetime lifetime = ZIKServiceLifetimeTransient;
+    if ([route isKindOfClass:[ZIKServiceRoute class]]) {
+        lifetime = [(ZIKServiceRoute *)route serviceLifetime];
+    } else if (object_isClass(route) && [route isSubclassOfClass:[ZIKServiceRouter class]]) {
+        lifetime = [route serviceLifetime];
+    }
+    return lifetime == ZIKServiceLifetimeSingleton || lifetime == ZIKServiceLifetimeWeakShared;
+}
+
+/// Visit dependencies depth first and return level of the route, leaves are level 0. Levels are stored in `levels` when the route is finished, a route in `visiting` means a cycle.
+static NSInteger _levelOfDependency(ZIKServiceRouterType *routerType, NSMapTable *levels, NSHashTable *visiting, NSMapTable *routerTypes) {
+    id route = routerType.routeObject;
+    NSNumber *level = [levels objectForKey:route];
+    if (level) {
+        return level.integerValue;
+    }
+    [visiting addObject:route];
+    NSInteger maxLevel = -1;
+    for (Protocol *protocol in _dependencyProtocolsOfRoute(route)) {
+        ZIKServiceRouterType *dependency = _routerTypeForDependency(protocol);
+        if (dependency == nil) {
+            continue;
+        }
+        if ([visiting containsObject:dependency.routeObject]) {
+            NSCAssert2(NO, @"Cycle service dependencies between (%@) and (%@), the edge is ignored when warming.", route, dependency.routeObject);
+            continue;
+        }
+        maxLevel = MAX(maxLevel, _levelOfDependency(dependency, levels, visiting, routerTypes));
+    }
+    [visiting removeObject:route];
+    [levels setObject:@(maxLevel + 1) forKey:route];
+    [routerTypes setObject:routerType forKey:route];
+    return maxLevel + 1;
+}
+
+/// Build levels of shared services to warm for a router class. Router types in the same level don't depend on each other.
+static NSArray<NSArray<ZIKServiceRouterType *> *> *_buildDependencyPlan(Class routerClass) {
+    NSArray<Protocol *> *protocols = [routerClass dependencyServiceProtocols];
+    if (protocols.count == 0) {
+        return @[];
+    }
+    NSPointerFunctionsOptions keyOptions = NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality;
+    NSMapTable *levels = [NSMapTable mapTableWithKeyOptions:keyOptions valueOptions:NSPointerFunctionsStrongMemory];
+    NSMapTable *routerTypes = [NSMapTable mapTableWithKeyOptions:keyOptions valueOptions:NSPointerFunctionsStrongMemory];
+    NSHashTable *visiting = [NSHashTable hashTableWithOptions:keyOptions];
+    [visiting addObject:routerClass];
+    NSInteger maxLevel = -1;
+    for (Protocol *protocol in protocols) {
+        ZIKServiceRouterType *routerType = _routerTypeForDependency(protocol);
+        if (routerType) {
+            maxLevel = MAX(maxLevel, _levelOfDependency(routerType, levels, visiting, routerTypes));
+        }
+    }
+    NSMutableArray<NSMutableArray<ZIKServiceRouterType *> *> *levelRouterTypes = [NSMutableArray array];
+    for (NSInteger i = 0; i <= maxLevel; i++) {
+        [levelRouterTypes addObject:[NSMutableArray array]];
+    }
+    for (id route in levels) {
+        if (_isSharedServiceRoute(route)) {
+            [levelRouterTypes[[[levels objectForKey:route] integerValue]] addObject:[routerTypes objectForKey:route]];
+        }
+    }
+    NSMutableArray<NSArray<ZIKServiceRouterType *> *> *plan = [NSMutableArray array];
+    for (NSArray<ZIKServiceRouterType *> *level in levelRouterTypes) {
+        if (level.count > 0) {
+            [plan addObject:level];
+        }
+    }
+    return plan;
+}
+
+static NSArray<NSArray<ZIKServiceRouterType *> *> *_dependencyPlan(Class routerClass) {
+    // Registry may still change before registration is finished, don't cache the plan
+    if (!ZIKRouteRegistry.registrationFinished) {
+        return _buildDependencyPlan(routerClass);
+    }
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _dependencyPlans = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality valueOptions:NSPointerFunctionsStrongMemory];
+        _dependencyPlansSema = dispatch_semaphore_create(1);
+    });
+    dispatch_semaphore_wait(_dependencyPlansSema, DISPATCH_TIME_FOREVER);
+    NSArray *plan = [_dependencyPlans objectForKey:routerClass];
+    dispatch_semaphore_signal(_dependencyPlansSema);
+    if (plan) {
+        return plan;
+    }
+    plan = _buildDependencyPlan(routerClass);
+    dispatch_semaphore_wait(_dependencyPlansSema, DISPATCH_TIME_FOREVER);
+    [_dependencyPlans setObject:plan forKey:routerClass];
+    dispatch_semaphore_signal(_dependencyPlansSema);
+    return plan;
+}
+
+/// Make each level concurrently, so a service is made after all services it depends on.
+static NSArray *_warmDependencyPlan(NSArray<NSArray<ZIKServiceRouterType *> *> *plan) {
+    NSMutableArray *services = [NSMutableArray array];
+    for (NSArray<ZIKServiceRouterType *> *level in plan) {
+        for (id service in _makeDestinations(level, YES)) {
+            if (service != [NSNull null]) {
+                [services addObject:service];
+            }
+        }
+    }
+    return services;
+}
+
+static void _warmServiceDependenciesForRouter(ZIKRouter *router) {
+    NSArray *plan = _dependencyPlan([router class]);
+    if (plan.count == 0) {
+        return;
+    }
+    __weak ZIKRouter *weakRouter = router;
+    dispatch_async(zix_globalQueueWithQOS(QOS_CLASS_USER_INITIATED), ^{
+        NSArray *services = _warmDependencyPlan(plan);
+        ZIKRouter *strongRouter = weakRouter;
+        if (strongRouter && services.count > 0) {
+            // Keep weak shared services alive until destination gets them
+            objc_setAssociatedObject(strongRouter, &_warmedServicesKey, services, OBJC_ASSOCIATION_RETAIN);
+        }
+    });
+}
+
+@implementation ZIKRouter (ServiceDependencies)
+
++ (BOOL)warmsServiceDependencies {
+    return __atomic_load_n(&_warmsServiceDependencies, __ATOMIC_RELAXED);
+}
+
++ (void)setWarmsServiceDependencies:(BOOL)warmsServiceDependencies {
+    __atomic_store_n(&_warmsServiceDependencies, warmsServiceDependencies, __ATOMIC_RELAXED);
+    __atomic_store_n(&zix_serviceDependencyWarmer, warmsServiceDependencies ? &_warmServiceDependenciesForRouter : NULL, __ATOMIC_RELEASE);
+}
+
++ (void)warmServiceDependenciesWithCompletion:(void(^ _Nullable)(NSArray *services))completion {
+    NSArray *plan = _dependencyPlan(self);
+    dispatch_async(zix_globalQueueWithQOS(QOS_CLASS_USER_INITIATED), ^{
+        NSArray *services = _warmDependencyPlan(plan);
+        if (completion) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completion(services);
+            });
+        }
+    });
+}
+
 @end
@@ -65,6 +65,8 @@ NS_ASSUME_NONNULL_BEGIN
                       // Prepare service
                 }];
  @endcode
+ 
+ Thread safety: after registration is finished, performing and making services can be called from any thread. Fetching routers reads the published route index without lock, and a replaced index is only freed after all lookups reading it returned. Shared services, the global error handler and router states are synchronized. Each router instance should still be performed and removed from one thread at a time, and handlers are called on the thread performing the route. Registering routers concurrently with fetching, such as lazy registration from route table, requires `ZIKRouteRegistry.freezesRegistration`.
  */
 @interface ZIKServiceRouter<__covariant Destination, __covariant RouteConfig: ZIKPerformRouteConfiguration *> : ZIKRouter<Destination, RouteConfig, ZIKRemoveRouteConfiguration *>
 
@@ -93,6 +95,50 @@ typedef void(^ZIKServiceRouteGlobalErrorHandler)(__kindof ZIKServiceRouter * _Nu
 
 @end
 
+/// Lifetime of services made by a service router.
+typedef NS_ENUM(NSInteger, ZIKServiceLifetime) {
+    /// Make a new service for each perform. This is the default.
+    ZIKServiceLifetimeTransient,
+    /// Make the service once and keep it until +discardSharedServices is called.
+    ZIKServiceLifetimeSingleton,
+    /// Share the service while it's referenced by others. A new service is made after it's released.
+    ZIKServiceLifetimeWeakShared,
+    /// Share the service in the `serviceScope` of configuration. Services are released with the scope, or when +endServiceScope: is called. Services are not shared when `serviceScope` is nil.
+    ZIKServiceLifetimeScoped
+};
+
+@interface ZIKServiceRouter (Lifetime)
+
+/**
+ Release all services in the scope. It's for bulk teardown, such as logging out.
+ 
+ @discussion
+ Services of a scope are also released when the scope object is deallocated. Routers in the scope still hold their destinations.
+ 
+ @param scope The scope object used as `serviceScope` of configurations.
+ */
++ (void)endServiceScope:(id)scope;
+
+/// Release all singleton and weak shared services, then routers make new services when performing.
++ (void)discardSharedServices;
+
+@end
+
+@interface ZIKServiceRouter<__covariant Destination, __covariant RouteConfig: ZIKPerformRouteConfiguration *> (LazyDestination)
+
+/**
+ Return a proxy of the service, and make the service with `+makeDestinationWithPreparation:` when the proxy receives its first message. Use it for injected services that may never be used in a session.
+ 
+ @discussion
+ The proxy is a ZIKLazyServiceProxy conforming to the service protocol at runtime, and forwards messages to the service after it's made. Preparation and AOP callbacks run when the service is made, not when this returns. Don't compare the proxy with the service by pointer.
+ 
+ @param prepare Preparation for the service. The block is an escaping block, use weak self in it.
+ @return Proxy of the service. Return nil if the router can't make destination synchronously.
+ */
++ (nullable Destination)makeLazyDestinationWithPreparation:(void(^ _Nullable)(Destination destination))prepare;
+
+@end
+
 @interface ZIKServiceRouter (Register)
 
 /**
@@ -164,6 +210,21 @@ typedef void(^ZIKServiceRouteGlobalErrorHandler)(__kindof ZIKServiceRouter * _Nu
  */
 + (void)registerServiceProtocol:(Protocol<ZIKServiceRoutable> *)serviceProtocol forMakingService:(Class)serviceClass factory:(_Nullable Destination(*_Nonnull)(RouteConfig))function;
 
+/**
+ Register entries of a static factory table in one pass, as `registerServiceProtocol:forMakingService:factory:` for each entry. Entries are validated in DEBUG, and no block is created. Entries whose protocol or class doesn't exist at runtime are skipped.
+ 
+ @code
+ static const ZIKDestinationFactoryEntry kServiceFactories[] = {
+    {"LoginServiceInput", "LoginService", makeLoginService},
+ };
+ [ZIKServiceRouter registerServiceFactoryTable:kServiceFactories count:sizeof(kServiceFactories) / sizeof(kServiceFactories[0])];
+ @endcode
+ 
+ @param table Entries of services. The table is only read during this call.
+ @param count Count of entries.
+ */
++ (void)registerServiceFactoryTable:(const ZIKDestinationFactoryEntry *)table count:(NSUInteger)count;
+
 /**
  Register protocol with service class and factory block, without using any router subclass. The service will be created with the `making` block when used. Use this if your service is very easy and don't need a router subclass.
 
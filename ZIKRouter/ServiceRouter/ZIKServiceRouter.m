@@ -11,18 +11,54 @@
 
 #import "ZIKServiceRouter.h"
 #import "ZIKRouterInternal.h"
+#import "ZIKRouterPrivate.h"
 #import "ZIKServiceRouterInternal.h"
 #import "ZIKServiceRouteRegistry.h"
 #import "ZIKRouteRegistryInternal.h"
 #import "ZIKServiceRoute.h"
+#import "ZIKRoutePrivate.h"
+#import "ZIKLazyServiceProxy.h"
 #import <objc/runtime.h>
+#import <pthread.h>
 #import "ZIKRouterRuntime.h"
+#import "ZIKRouterLog.h"
 
 ZIKRouteAction const ZIKRouteActionToService = @"ZIKRouteActionToService";
 ZIKRouteAction const ZIKRouteActionToServiceModule = @"ZIKRouteActionToServiceModule";
 
-static ZIKServiceRouteGlobalErrorHandler g_globalErrorHandler;
-static dispatch_semaphore_t g_globalErrorSema;
+/// Published with zix_publishGlobalErrorHandler, so reporting errors doesn't take lock.
+static const void *g_globalErrorHandler;
+
+/// All shared services are cached here, guarded by _sharedServicesSema. Keys are lifetime owners: router classes or routes.
+static NSMapTable<id, id> *_singletonServices;
+static NSMapTable<id, id> *_weakSharedServices;
+static dispatch_semaphore_t _sharedServicesSema;
+/// Scoped services are associated with the scope object, so they are released with the scope.
+static char _scopedServicesKey;
+/// Makings in progress, guarded by _sharedServicesSema.
+static NSMutableDictionary<NSArray *, id> *_pendingMakings;
+/// Wait-for graph of makings. key: thread waiting for a making, value: the making. Guarded by _sharedServicesSema.
+static NSMutableDictionary<NSValue *, id> *_waitingMakings;
+
+/// A making in progress. Requests with the same key wait for the group and take its destination.
+@interface ZIKPendingServiceMaking : NSObject
+@property (nonatomic, strong, readonly) dispatch_group_t group;
+@property (nonatomic, assign, readonly) pthread_t thread;
+@property (nonatomic, strong, nullable) id destination;
+@end
+
+@implementation ZIKPendingServiceMaking
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _group = dispatch_group_create();
+        _thread = pthread_self();
+        dispatch_group_enter(_group);
+    }
+    return self;
+}
+
+@end
 
 @interface ZIKServiceRouter ()
 
@@ -34,7 +70,11 @@ static dispatch_semaphore_t g_globalErrorSema;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
         [ZIKRouteRegistry addRegistry:[ZIKServiceRouteRegistry class]];
-        g_globalErrorSema = dispatch_semaphore_create(1);
+        _singletonServices = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+        _weakSharedServices = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsWeakMemory];
+        _sharedServicesSema = dispatch_semaphore_create(1);
+        _pendingMakings = [NSMutableDictionary dictionary];
+        _waitingMakings = [NSMutableDictionary dictionary];
     });
 }
 
@@ -90,7 +130,141 @@ static dispatch_semaphore_t g_globalErrorSema;
 }
 
 + (BOOL)canMakeDestinationSynchronously {
-    return YES;
+    return ![self makesDestinationInBackground];
+}
+
+#pragma mark Lifetime
+
++ (ZIKServiceLifetime)serviceLifetime {
+    return ZIKServiceLifetimeTransient;
+}
+
+- (ZIKServiceLifetime)destinationLifetime {
+    return [[self class] serviceLifetime];
+}
+
+- (id)destinationLifetimeOwner {
+    return [self class];
+}
+
+/// Must be called with _sharedServicesSema.
+static NSMapTable<id, id> *_Nullable _sharedServicesTable(ZIKServiceLifetime lifetime, id _Nullable scope, BOOL create) {
+    switch (lifetime) {
+        case ZIKServiceLifetimeSingleton:
+            return _singletonServices;
+        case ZIKServiceLifetimeWeakShared:
+            return _weakSharedServices;
+        case ZIKServiceLifetimeScoped: {
+            NSMapTable *table = objc_getAssociatedObject(scope, &_scopedServicesKey);
+            if (table == nil && create) {
+                table = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+                objc_setAssociatedObject(scope, &_scopedServicesKey, table, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+            }
+            return table;
+        }
+        default:
+            return nil;
+    }
+}
+
+/// Whether the making is on the thread, or waits for a making on the thread through other makings. Must be called with _sharedServicesSema.
+static BOOL _makingWaitsForThread(ZIKPendingServiceMaking *making, pthread_t thread) {
+    // Edges forming a cycle are never added, so the chain always ends
+    while (making) {
+        if (pthread_equal(making.thread, thread)) {
+            return YES;
+        }
+        making = _waitingMakings[[NSValue valueWithPointer:making.thread]];
+    }
+    return NO;
+}
+
+/// Make destination once for concurrent requests with the same key, other requests wait for the first one and get its destination. A request only makes a new destination at once when waiting would deadlock: the making is on the same thread, or waits for a making on this thread, such as services getting each other on two threads. Callers of shared lifetime keep the first destination in the table and drop the others. Must be called without _sharedServicesSema.
+static id _Nullable _makeDestinationCoalescing(NSArray *key, id _Nullable(NS_NOESCAPE ^make)(void)) {
+    dispatch_semaphore_wait(_sharedServicesSema, DISPATCH_TIME_FOREVER);
+    ZIKPendingServiceMaking *pending = _pendingMakings[key];
+    if (pending) {
+        pthread_t thread = pthread_self();
+        if (_makingWaitsForThread(pending, thread)) {
+            dispatch_semaphore_signal(_sharedServicesSema);
+            return make();
+        }
+        NSValue *waitingThread = [NSValue valueWithPointer:thread];
+        _waitingMakings[waitingThread] = pending;
+        dispatch_semaphore_signal(_sharedServicesSema);
+        dispatch_group_wait(pending.group, DISPATCH_TIME_FOREVER);
+        dispatch_semaphore_wait(_sharedServicesSema, DISPATCH_TIME_FOREVER);
+        [_waitingMakings removeObjectForKey:waitingThread];
+        dispatch_semaphore_signal(_sharedServicesSema);
+        id destination = pending.destination;
+        if (destination) {
+            return destination;
+        }
+        // The making failed, try again
+        return make();
+    }
+    pending = [ZIKPendingServiceMaking new];
+    _pendingMakings[key] = pending;
+    dispatch_semaphore_signal(_sharedServicesSema);
+    id destination;
+    @try {
+        destination = make();
+        pending.destination = destination;
+    } @finally {
+        // Leave even when making throws, or the key stays pending
+        dispatch_semaphore_wait(_sharedServicesSema, DISPATCH_TIME_FOREVER);
+        [_pendingMakings removeObjectForKey:key];
+        dispatch_semaphore_signal(_sharedServicesSema);
+        dispatch_group_leave(pending.group);
+    }
+    return destination;
+}
+
+- (nullable id)makeDestinationWithConfiguration:(ZIKPerformRouteConfiguration *)configuration {
+    ZIKServiceLifetime lifetime = [self destinationLifetime];
+    if (lifetime == ZIKServiceLifetimeTransient) {
+        NSString *coalescingKey = configuration.coalescingKey;
+        if (coalescingKey == nil) {
+            return [super makeDestinationWithConfiguration:configuration];
+        }
+        NSArray *key = @[[NSValue valueWithNonretainedObject:[self destinationLifetimeOwner]], coalescingKey];
+        return _makeDestinationCoalescing(key, ^id{
+            return [super makeDestinationWithConfiguration:configuration];
+        });
+    }
+    id scope;
+    if (lifetime == ZIKServiceLifetimeScoped) {
+        scope = configuration.serviceScope;
+        if (scope == nil) {
+            return [super makeDestinationWithConfiguration:configuration];
+        }
+    }
+    id owner = [self destinationLifetimeOwner];
+    dispatch_semaphore_wait(_sharedServicesSema, DISPATCH_TIME_FOREVER);
+    id destination = [_sharedServicesTable(lifetime, scope, NO) objectForKey:owner];
+    dispatch_semaphore_signal(_sharedServicesSema);
+    if (destination) {
+        return destination;
+    }
+    // Make outside the lock, the service may get other services when initializing. Concurrent requests share one making.
+    NSArray *key = @[@(lifetime), [NSValue valueWithNonretainedObject:owner], [NSValue valueWithNonretainedObject:scope]];
+    destination = _makeDestinationCoalescing(key, ^id{
+        return [super makeDestinationWithConfiguration:configuration];
+    });
+    if (destination == nil) {
+        return nil;
+    }
+    dispatch_semaphore_wait(_sharedServicesSema, DISPATCH_TIME_FOREVER);
+    NSMapTable *table = _sharedServicesTable(lifetime, scope, YES);
+    // Another thread may make the service at the same time, the first one wins
+    id existing = [table objectForKey:owner];
+    if (existing) {
+        destination = existing;
+    } else {
+        [table setObject:destination forKey:owner];
+    }
+    dispatch_semaphore_signal(_sharedServicesSema);
+    return destination;
 }
 
 #pragma mark Validate
@@ -106,28 +280,103 @@ static dispatch_semaphore_t g_globalErrorSema;
 #pragma mark Error Handle
 
 + (void)setGlobalErrorHandler:(ZIKServiceRouteGlobalErrorHandler)globalErrorHandler {
-    dispatch_semaphore_wait(g_globalErrorSema, DISPATCH_TIME_FOREVER);
-    g_globalErrorHandler = globalErrorHandler;
-    dispatch_semaphore_signal(g_globalErrorSema);
+    zix_publishGlobalErrorHandler(&g_globalErrorHandler, globalErrorHandler);
 }
 
 + (ZIKServiceRouteGlobalErrorHandler)globalErrorHandler {
-    return g_globalErrorHandler;
+    return zix_loadGlobalErrorHandler(&g_globalErrorHandler);
 }
 
 + (void)notifyGlobalErrorWithRouter:(nullable __kindof ZIKServiceRouter *)router action:(ZIKRouteAction)action error:(NSError *)error {
-    void(^errorHandler)(__kindof ZIKServiceRouter *_Nullable router, ZIKRouteAction action, NSError *error) = self.globalErrorHandler;
+    zix_logRouteErrorEvent(router ? object_getClass(router) : self, action, router ? router.state : ZIKRouterStateUnrouted, error.code);
+    ZIKServiceRouteGlobalErrorHandler errorHandler = zix_loadGlobalErrorHandler(&g_globalErrorHandler);
     if (errorHandler) {
         errorHandler(router, action, error);
     } else {
 #ifdef DEBUG
-        NSLog(@"❌ZIKServiceRouter Error: router's action (%@) catch error: (%@),\nrouter:(%@)", action, error,router);
+        ZIX_LOG(Route, Error, @"❌ZIKServiceRouter Error: router's action (%@) catch error: (%@),\nrouter:(%@)", action, error,router);
 #endif
     }
 }
 
 @end
 
+@implementation ZIKServiceRouter (LazyDestination)
+
++ (nullable id)makeLazyDestinationWithPreparation:(void(^ _Nullable)(id destination))prepare {
+    NSAssert(self != [ZIKServiceRouter class], @"Make lazy destination from router subclass");
+    if (![self canMakeDestinationSynchronously]) {
+        return nil;
+    }
+    Class routerClass = self;
+    return [[ZIKLazyServiceProxy alloc] initWithMaker:^id _Nullable{
+        return [routerClass makeDestinationWithPreparation:prepare];
+    }];
+}
+
+@end
+
+@implementation ZIKServiceRouter (Lifetime)
+
++ (void)endServiceScope:(id)scope {
+    NSParameterAssert(scope);
+    if (scope == nil) {
+        return;
+    }
+    dispatch_semaphore_wait(_sharedServicesSema, DISPATCH_TIME_FOREVER);
+    // Release services outside the lock
+    NSMapTable *table = objc_getAssociatedObject(scope, &_scopedServicesKey);
+    objc_setAssociatedObject(scope, &_scopedServicesKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    dispatch_semaphore_signal(_sharedServicesSema);
+    table = nil;
+}
+
++ (void)discardSharedServices {
+    dispatch_semaphore_wait(_sharedServicesSema, DISPATCH_TIME_FOREVER);
+    // Release services outside the lock
+    NSMapTable *singletons = [_singletonServices copy];
+    [_singletonServices removeAllObjects];
+    [_weakSharedServices removeAllObjects];
+    dispatch_semaphore_signal(_sharedServicesSema);
+    singletons = nil;
+}
+
+@end
+
+/// Owners are router classes or routes.
+static BOOL _lifetimeOwnerIsInImage(id owner, const void *header) {
+    if ([owner isKindOfClass:[ZIKRoute class]]) {
+        return zix_imageHeaderOfBlock(((ZIKRoute *)owner).makeDestinationBlock) == header;
+    }
+    return zix_imageHeaderOfClass(owner) == header;
+}
+
+static void _removeServicesInImage(NSMapTable *table, const void *header, NSMutableArray *discarded) {
+    for (id owner in [[table keyEnumerator] allObjects]) {
+        id service = [table objectForKey:owner];
+        if (_lifetimeOwnerIsInImage(owner, header) || (service && zix_imageHeaderOfClass(object_getClass(service)) == header)) {
+            if (service) {
+                [discarded addObject:service];
+            }
+            [table removeObjectForKey:owner];
+        }
+    }
+}
+
+void zix_discardSharedServicesInImage(const void *header) {
+    if (_sharedServicesSema == nil) {
+        return;
+    }
+    // Scoped services are released with their scopes
+    NSMutableArray *discarded = [NSMutableArray array];
+    dispatch_semaphore_wait(_sharedServicesSema, DISPATCH_TIME_FOREVER);
+    _removeServicesInImage(_singletonServices, header, discarded);
+    _removeServicesInImage(_weakSharedServices, header, discarded);
+    dispatch_semaphore_signal(_sharedServicesSema);
+    // Release services outside the lock
+    discarded = nil;
+}
+
 @implementation ZIKServiceRouter (Register)
 
 + (BOOL)isRegistrationFinished {
@@ -180,6 +429,11 @@ static dispatch_semaphore_t g_globalErrorSema;
     [ZIKServiceRouteRegistry registerDestinationProtocol:serviceProtocol forMakingDestination:serviceClass factoryFunction:function];
 }
 
++ (void)registerServiceFactoryTable:(const ZIKDestinationFactoryEntry *)table count:(NSUInteger)count {
+    NSAssert(!ZIKServiceRouteRegistry.registrationFinished, @"Only register in +registerRoutableDestination.");
+    [ZIKServiceRouteRegistry registerDestinationFactoryTable:table count:count];
+}
+
 + (void)registerServiceProtocol:(Protocol<ZIKServiceRoutable> *)serviceProtocol forMakingService:(Class)serviceClass making:(id  _Nullable (^)(ZIKPerformRouteConfiguration * _Nonnull))makeDestination {
     NSParameterAssert([serviceClass conformsToProtocol:serviceProtocol]);
     NSAssert(!ZIKServiceRouteRegistry.registrationFinished, @"Only register in +registerRoutableDestination.");
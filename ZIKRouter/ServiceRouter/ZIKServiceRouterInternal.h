@@ -33,6 +33,17 @@ NS_ASSUME_NONNULL_BEGIN
 /// Check whether destination is prepared correctly.
 - (void)didFinishPrepareDestination:(Destination)destination configuration:(RouteConfig)configuration;
 
+/// Lifetime of services made by the router. Default is ZIKServiceLifetimeTransient. When it's not transient, -destinationWithConfiguration: is only called when there is no shared service, and the shared service is still prepared in each perform. Services are cached for the router class, not for each service class.
++ (ZIKServiceLifetime)serviceLifetime;
+
+#pragma mark Lifetime
+
+/// Lifetime of the route. Default is +serviceLifetime. Block router returns lifetime of its route.
+- (ZIKServiceLifetime)destinationLifetime;
+
+/// Owner of shared services of the route. Default is the router class. Block router returns its route.
+- (id)destinationLifetimeOwner;
+
 #pragma mark Notify Error
 
 + (void)notifyGlobalErrorWithRouter:(nullable __kindof ZIKServiceRouter *)router action:(ZIKRouteAction)action error:(NSError *)error;
@@ -45,6 +56,8 @@ FOUNDATION_EXTERN ZIKServiceRouterType *_Nullable _ZIKServiceRouterToModule(Prot
 
 FOUNDATION_EXTERN ZIKAnyServiceRouterType *_Nullable _ZIKServiceRouterToIdentifier(NSString *identifier);
 
+FOUNDATION_EXTERN ZIKAnyServiceRouterType *_Nullable _ZIKServiceRouterToIdentifierHandle(ZIKRouteIdentifierHandle handle);
+
 FOUNDATION_EXTERN Protocol<ZIKServiceRoutable> *_Nullable _routableServiceProtocolFromObject(id object);
 
 FOUNDATION_EXTERN Protocol<ZIKServiceModuleRoutable> *_Nullable _routableServiceModuleProtocolFromObject(id object);
@@ -88,6 +88,34 @@ FOUNDATION_EXTERN ZIKURLRouteKey ZIKURLRouteKeyAction;
  */
 + (void)registerURLPattern:(NSString *)pattern;
 
+/**
+ Replace URL patterns of this router with the patterns at once, such as patterns from remote config. Patterns of other routers are kept. Patterns are compiled on current thread and registering patterns waits for it, so call it on a background queue. Resolving urls in progress keeps using the old patterns, and resolving doesn't take lock for the swap.
+ 
+ Patterns must be identifiers of this router, such as patterns registered with +registerURLPattern: at launch, other patterns are ignored.
+ */
++ (void)replaceURLPatterns:(NSArray<NSString *> *)patterns;
+
+/// Max count of urls whose matched results are cached, so `+routeFromURL:` skips matching for repeated urls such as urls from push notifications. Least recently used url is removed when exceeding. Default is 0 and cache is disabled. Cache is cleared when a pattern is registered.
+@property (nonatomic, class) NSUInteger URLResultCacheLimit;
+
+/// Compiled URL patterns in binary format. Write it to a file after all patterns are registered, and load it with +loadURLPatternTableFromFile: at next launch.
++ (nullable NSData *)URLPatternTableData;
+
+/// Load URL patterns from the file written with data from +URLPatternTableData, so only new patterns are compiled in +registerURLPattern:. Call it before registering any URL pattern, such as in main(). Discard the file when routes change.
++ (BOOL)loadURLPatternTableFromFile:(NSString *)path;
+
+/**
+ Resolve router and parameters of the url ahead of time, such as for the url in a push notification before user taps it. Next `+performURL:` with the same url skips matching, router lookup and parameters decoding. Only last 4 prewarmed urls are kept, and each is used once.
+ 
+ @param url The url to perform later.
+ @param prebuildsDestination Also create the destination with `+prewarmDestinationForKey:configuring:`, with the url as the key. Destination of block route is not prebuilt.
+ @return NO when there is no router for the url.
+ */
++ (BOOL)prewarmURL:(NSString *)url prebuildsDestination:(BOOL)prebuildsDestination;
+
+/// Prewarm the url without creating destination.
++ (BOOL)prewarmURL:(NSString *)url;
+
 /// Perform route for the url. It will search router and get parameters with `+routeFromURL:`, then perform route.
 + (nullable ZIKServiceRouter<Destination, RouteConfig> *)performURL:(NSString *)url;
 
@@ -97,6 +125,9 @@ FOUNDATION_EXTERN ZIKURLRouteKey ZIKURLRouteKeyAction;
 /// Get router for identifier from URL.
 + (nullable ZIKServiceRouterType<Destination, RouteConfig> *)routerForURL:(NSString *)url;
 
+/// Get routers for many urls in one pass. Key is the url, urls without router are not in the result.
++ (NSDictionary<NSString *, ZIKServiceRouterType<Destination, RouteConfig> *> *)routersForURLs:(NSArray<NSString *> *)urls;
+
 @end
 
 @interface ZIKServiceRoute<__covariant Destination, __covariant RouteConfig: ZIKPerformRouteConfiguration *> (URLRouter)
@@ -149,6 +180,13 @@ FOUNDATION_EXTERN ZIKURLRouteKey ZIKURLRouteKeyAction;
 
 #pragma mark Interceptor
 
+/**
+ Interceptors of each point form a chain. Interceptors with higher priority are invoked first, and interceptors with same priority are invoked in adding order. Methods without priority replace the interceptor set by themselves previously with priority 0, methods with priority always add a new interceptor.
+ 
+ An interceptor before performing can stop the route by cancelling `configuration.cancellationToken`, then interceptors after it are not invoked, destination is not made, and performing fails with ZIKRouteErrorActionFailed.
+ 
+ Routers check the chain in -performWithConfiguration:, -notifySuccessWithAction: and -endPerformRouteWithError: of ZIKRouter, it costs nothing more than a pointer load when there is no interceptor. Changed chains are published atomically, and old chains are not freed, so add interceptors at launch instead of changing them frequently.
+ */
 @interface ZIKRouter (Interceptor)
 /**
  Inject interceptor for all routers before performing. You can process the configuration when implementing your custom URL router. See +enableDefaultURLRouteRule and +beforePerformWithConfigurationFromURL.
@@ -157,9 +195,15 @@ FOUNDATION_EXTERN ZIKURLRouteKey ZIKURLRouteKeyAction;
  */
 + (void)interceptBeforePerformWithConfiguration:(void(^)(ZIKRouter *router, ZIKPerformRouteConfiguration *configuration))handler;
 
+/// Add interceptor for all routers before performing with priority.
++ (void)interceptBeforePerformWithConfiguration:(void(^)(ZIKRouter *router, ZIKPerformRouteConfiguration *configuration))handler priority:(NSInteger)priority;
+
 /// Inject interceptor for all routers after performing. Use this if you need to add action after the destination is instantiated.
 + (void)interceptAfterPerformWithConfiguration:(void(^)(ZIKRouter *router, ZIKPerformRouteConfiguration *configuration))handler;
 
+/// Add interceptor for all routers after performing with priority.
++ (void)interceptAfterPerformWithConfiguration:(void(^)(ZIKRouter *router, ZIKPerformRouteConfiguration *configuration))handler priority:(NSInteger)priority;
+
 /**
  Inject interceptor for all routers after success performing or removing. You can do some addtion custom actions when implementing your custom URL router. See +enableDefaultURLRouteRule and +afterSuccessActionFromURL.
  
@@ -171,9 +215,15 @@ FOUNDATION_EXTERN ZIKURLRouteKey ZIKURLRouteKeyAction;
  */
 + (void)interceptAfterSuccessAction:(void(^)(ZIKRouter *router, ZIKRouteAction action))handler;
 
+/// Add interceptor for all routers after success performing or removing with priority.
++ (void)interceptAfterSuccessAction:(void(^)(ZIKRouter *router, ZIKRouteAction action))handler priority:(NSInteger)priority;
+
 /// Inject interceptor for all routers after performing failed.
 + (void)interceptAfterEndPerformWithError:(void(^)(ZIKRouter *router, NSError *error))handler;
 
+/// Add interceptor for all routers after performing failed with priority.
++ (void)interceptAfterEndPerformWithError:(void(^)(ZIKRouter *router, NSError *error))handler priority:(NSInteger)priority;
+
 @end
 
 NS_ASSUME_NONNULL_END
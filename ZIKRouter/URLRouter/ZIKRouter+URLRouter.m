@@ -71,7 +71,10 @@ ZIKURLRouteKey ZIKURLRouteKeyAction = @"action";
 @end
 
 #import "ZIKServiceRouterInternal.h"
+#import "ZIKServiceRouteRegistry.h"
+#import "ZIKRouteRegistryInternal.h"
 #import "ZIKURLRouter.h"
+#import "ZIKURLRouteResultInternal.h"
 
 static ZIKURLRouter *_serviceURLRouter;
 
@@ -84,34 +87,121 @@ static void _createURLRouter() {
     });
 }
 
+/// Results from URL router have handle of the matched pattern, results from overridden +routeFromURL: may only have identifier.
+static ZIKServiceRouterType *_Nullable _routerTypeForURLResult(ZIKURLRouteResult *result) {
+    if (result.identifierHandle != 0) {
+        return _ZIKServiceRouterToIdentifierHandle(result.identifierHandle);
+    }
+    return _ZIKServiceRouterToIdentifier(result.identifier);
+}
+
+/// Prewarmed result for the url, nil when it's not prewarmed or routes changed after prewarming.
+static ZIKURLRouteResult *_Nullable _takePrewarmedResult(NSString *url) {
+    ZIKURLRouteResult *result = [_serviceURLRouter takePrewarmedResultForURL:url];
+    if (result && result.prewarmedRoutesGeneration != [ZIKRouteRegistry routesGeneration]) {
+        return nil;
+    }
+    return result;
+}
+
 @implementation ZIKServiceRouter (URLRouter)
 
 + (void)registerURLPattern:(NSString *)pattern {
     _createURLRouter();
     [_serviceURLRouter registerURLPattern:pattern];
+    [ZIKServiceRouteRegistry markDynamicRegistration];
     [self registerIdentifier:pattern];
 }
 
++ (void)replaceURLPatterns:(NSArray<NSString *> *)patterns {
+    _createURLRouter();
+    Class routerClass = self;
+    // Only patterns routing to this router are replaced
+    [_serviceURLRouter replacePatterns:patterns passingTest:^BOOL(NSString *pattern) {
+        return _ZIKServiceRouterToIdentifier(pattern).routeObject == routerClass;
+    }];
+}
+
++ (NSUInteger)URLResultCacheLimit {
+    _createURLRouter();
+    return _serviceURLRouter.resultCacheLimit;
+}
+
++ (void)setURLResultCacheLimit:(NSUInteger)URLResultCacheLimit {
+    _createURLRouter();
+    _serviceURLRouter.resultCacheLimit = URLResultCacheLimit;
+}
+
++ (NSData *)URLPatternTableData {
+    return [_serviceURLRouter patternTableData];
+}
+
++ (BOOL)loadURLPatternTableFromFile:(NSString *)path {
+    _createURLRouter();
+    return [_serviceURLRouter loadPatternTableFromFile:path];
+}
+
 + (ZIKURLRouteResult *)routeFromURL:(NSString *)url {
+    _createURLRouter();
     ZIKURLRouteResult *result = [_serviceURLRouter resultForURL:url];
     if (!result) {
         return nil;
     }
     NSMutableDictionary *userInfo = [NSMutableDictionary dictionary];
     userInfo[ZIKURLRouteKeyOriginURL] = [NSURL URLWithString:url];
-    if (result.parameters) {
-        [userInfo addEntriesFromDictionary:result.parameters];
-    }
-    result.parameters = userInfo;
+    // Parameters are decoded only when they are used
+    result.baseParameters = userInfo;
     return result;
 }
 
 + (ZIKServiceRouterType *)routerForURL:(NSString *)url {
-    NSString *identifier = [self routeFromURL:url].identifier;
-    if (!identifier) {
+    ZIKURLRouteResult *result = [self routeFromURL:url];
+    if (!result.identifier) {
         return nil;
     }
-    return _ZIKServiceRouterToIdentifier(identifier);
+    return _routerTypeForURLResult(result);
+}
+
++ (NSDictionary<NSString *, ZIKServiceRouterType *> *)routersForURLs:(NSArray<NSString *> *)urls {
+    _createURLRouter();
+    NSDictionary<NSString *, ZIKURLRouteResult *> *results = [_serviceURLRouter resultsForURLs:urls];
+    NSMutableDictionary<NSString *, ZIKServiceRouterType *> *routers = [NSMutableDictionary dictionaryWithCapacity:results.count];
+    [results enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull url, ZIKURLRouteResult * _Nonnull result, BOOL * _Nonnull stop) {
+        ZIKServiceRouterType *router = _routerTypeForURLResult(result);
+        if (router) {
+            routers[url] = router;
+        }
+    }];
+    return routers;
+}
+
++ (BOOL)prewarmURL:(NSString *)url {
+    return [self prewarmURL:url prebuildsDestination:NO];
+}
+
++ (BOOL)prewarmURL:(NSString *)url prebuildsDestination:(BOOL)prebuildsDestination {
+    ZIKURLRouteResult *result = [self routeFromURL:url];
+    if (!result.identifier) {
+        return NO;
+    }
+    ZIKServiceRouterType *routerType = _routerTypeForURLResult(result);
+    if (!routerType) {
+        return NO;
+    }
+    // Decode parameters now
+    NSDictionary *userInfo = result.parameters;
+    result.prewarmedRouterType = routerType;
+    result.prewarmedRoutesGeneration = [ZIKRouteRegistry routesGeneration];
+    // Router of block route can't prewarm destination
+    Class routerClass = routerType.routerClass;
+    if (prebuildsDestination && routerClass) {
+        [routerClass prewarmDestinationForKey:url configuring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            [config addUserInfo:userInfo];
+        }];
+        result.prewarmKey = url;
+    }
+    [_serviceURLRouter storePrewarmedResult:result];
+    return YES;
 }
 
 + (ZIKServiceRouter *)performURL:(NSString *)url {
@@ -121,7 +211,7 @@ static void _createURLRouter() {
 }
 
 + (ZIKServiceRouter *)performURL:(NSString *)url completion:(void(^)(BOOL success, id _Nullable destination, ZIKRouteAction routeAction, NSError *_Nullable error))performerCompletion {
-    ZIKURLRouteResult *result = [self routeFromURL:url];
+    ZIKURLRouteResult *result = _takePrewarmedResult(url) ?: [self routeFromURL:url];
     NSString *identifier = result.identifier;
     if (!identifier) {
         if (performerCompletion) {
@@ -130,7 +220,7 @@ static void _createURLRouter() {
         }
         return nil;
     }
-    ZIKServiceRouterType *routerType = _ZIKServiceRouterToIdentifier(identifier);
+    ZIKServiceRouterType *routerType = result.prewarmedRouterType ?: _routerTypeForURLResult(result);
     if (!routerType) {
         if (performerCompletion) {
             NSError *error = [ZIKServiceRouter errorWithCode:ZIKRouteErrorInvalidConfiguration localizedDescriptionFormat:@"Can't find router with identifier (%@) from url: %@", identifier, url];
@@ -140,8 +230,12 @@ static void _createURLRouter() {
         return nil;
     }
     NSDictionary *userInfo = result.parameters;
+    NSString *prewarmKey = result.prewarmKey;
     return [routerType performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
         [config addUserInfo:userInfo];
+        if (prewarmKey) {
+            config.prewarmKey = prewarmKey;
+        }
         if (!performerCompletion) {
             return;
         }
@@ -246,93 +340,48 @@ static void _createURLRouter() {
 
 @implementation ZIKRouter (Interceptor)
 
-+ (void)enableDefaultInterceptor {
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        zix_replaceMethodWithMethod([ZIKRouter class], @selector(performWithConfiguration:), [ZIKRouter class], @selector(interceptor_performWithConfiguration:));
-        zix_replaceMethodWithMethod([ZIKRouter class], @selector(notifySuccessWithAction:), [ZIKRouter class], @selector(interceptor_notifySuccessWithAction:));
-        zix_replaceMethodWithMethod([ZIKRouter class], @selector(endPerformRouteWithError:), [ZIKRouter class], @selector(interceptor_endPerformRouteWithError:));
-    });
-}
-
-- (void)interceptor_performWithConfiguration:(ZIKPerformRouteConfiguration *)configuration {
-    {
-        void(^_Nullable interceptor)(ZIKRouter *, ZIKPerformRouteConfiguration *) = [[self class] interceptorBeforePerformWithConfiguration];
-        if (interceptor) {
-            interceptor(self, configuration);
-        }
-    }
-    
-    [self interceptor_performWithConfiguration:configuration];
-    
-    {
-        void(^_Nullable interceptor)(ZIKRouter *, ZIKPerformRouteConfiguration *) = [[self class] interceptorAfterPerformWithConfiguration];
-        if (interceptor) {
-            interceptor(self, configuration);
-        }
-    }
-}
-
-- (void)interceptor_notifySuccessWithAction:(ZIKRouteAction)routeAction {
-    [self interceptor_notifySuccessWithAction:routeAction];
-    
-    void(^_Nullable interceptor)(ZIKRouter *, ZIKRouteAction) = [[self class] interceptorAfterSuccessAction];
-    if (interceptor) {
-        interceptor(self, routeAction);
-    }
-}
-
-- (void)interceptor_endPerformRouteWithError:(NSError *)error {
-    [self interceptor_endPerformRouteWithError:error];
-    void(^_Nullable interceptor)(ZIKRouter *, NSError *) = [[self class] interceptorAfterEndPerformWithError];
-    if (interceptor) {
-        interceptor(self, error);
-    }
-}
-
-static void(^_Nullable _interceptorBeforePerformWithConfiguration)(ZIKRouter *, ZIKPerformRouteConfiguration *);
-
 + (void)interceptBeforePerformWithConfiguration:(void(^)(ZIKRouter *router, ZIKPerformRouteConfiguration *configuration))handler {
-    [self enableDefaultInterceptor];
-    _interceptorBeforePerformWithConfiguration = handler;
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointBeforePerform, handler, 0, @selector(interceptBeforePerformWithConfiguration:));
 }
 
-+ (void(^_Nullable)(ZIKRouter *, ZIKPerformRouteConfiguration *))interceptorBeforePerformWithConfiguration {
-    return _interceptorBeforePerformWithConfiguration;
++ (void)interceptBeforePerformWithConfiguration:(void(^)(ZIKRouter *router, ZIKPerformRouteConfiguration *configuration))handler priority:(NSInteger)priority {
+    NSParameterAssert(handler);
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointBeforePerform, handler, priority, NULL);
 }
 
-static void(^_Nullable _interceptorAfterPerformWithConfiguration)(ZIKRouter *, ZIKPerformRouteConfiguration *);
-
 + (void)interceptAfterPerformWithConfiguration:(void(^)(ZIKRouter *router, ZIKPerformRouteConfiguration *configuration))handler {
-    [self enableDefaultInterceptor];
-    _interceptorAfterPerformWithConfiguration = handler;
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointAfterPerform, handler, 0, @selector(interceptAfterPerformWithConfiguration:));
 }
 
-+ (void(^_Nullable)(ZIKRouter *, ZIKPerformRouteConfiguration *))interceptorAfterPerformWithConfiguration {
-    [self enableDefaultInterceptor];
-    return _interceptorAfterPerformWithConfiguration;
++ (void)interceptAfterPerformWithConfiguration:(void(^)(ZIKRouter *router, ZIKPerformRouteConfiguration *configuration))handler priority:(NSInteger)priority {
+    NSParameterAssert(handler);
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointAfterPerform, handler, priority, NULL);
 }
 
-static void(^_Nullable _interceptorAfterSuccessAction)(ZIKRouter *, ZIKRouteAction);
-
 + (void)interceptAfterSuccessAction:(void(^)(ZIKRouter *router, ZIKRouteAction action))handler {
-    [self enableDefaultInterceptor];
-    _interceptorAfterSuccessAction = handler;
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointAfterSuccessAction, handler, 0, @selector(interceptAfterSuccessAction:));
 }
 
-+ (void(^_Nullable)(ZIKRouter *, ZIKRouteAction))interceptorAfterSuccessAction {
-    return _interceptorAfterSuccessAction;
++ (void)interceptAfterSuccessAction:(void(^)(ZIKRouter *router, ZIKRouteAction action))handler priority:(NSInteger)priority {
+    NSParameterAssert(handler);
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointAfterSuccessAction, handler, priority, NULL);
 }
 
-static void(^_Nullable _interceptorAfterEndPerformWithError)(ZIKRouter *, NSError *);
++ (void)interceptAfterEndPerformWithError:(void(^)(ZIKRouter *router, NSError *error))handler {
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointAfterEndPerformWithError, handler, 0, @selector(interceptAfterEndPerformWithError:));
+}
 
-+ (void)interceptAfterEndPerformWithError:(void(^)(ZIKRouter *router, NSError *error))handler; {
-    [self enableDefaultInterceptor];
-    _interceptorAfterEndPerformWithError = handler;
++ (void)interceptAfterEndPerformWithError:(void(^)(ZIKRouter *router, NSError *error))handler priority:(NSInteger)priority {
+    NSParameterAssert(handler);
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointAfterEndPerformWithError, handler, priority, NULL);
 }
 
-+ (void(^_Nullable)(ZIKRouter *, NSError *))interceptorAfterEndPerformWithError {
-    return _interceptorAfterEndPerformWithError;
+@end
+
+@implementation ZIKServiceRouteRegistry (URLRouter)
+
++ (nullable NSSet<NSString *> *)registeredURLPatterns {
+    return [_serviceURLRouter allPatterns];
 }
 
 @end
@@ -11,7 +11,11 @@
 NS_ASSUME_NONNULL_BEGIN
 
 @interface ZIKURLRouteResult : NSObject
+/// Url created from `urlString` with percent escapes when it's first accessed.
 @property (nonatomic, strong) NSURL *url;
+/// Origin url string passed to the router.
+@property (nonatomic, copy) NSString *urlString;
+/// Placeholders and query items in the url. They are decoded when it's first accessed.
 @property (nonatomic, strong) NSDictionary *parameters;
 @property (nonatomic, strong) id identifier;
 @end
@@ -6,8 +6,26 @@
 //  Copyright © 2019 zuik. All rights reserved.
 //
 
-#import "ZIKURLRouteResult.h"
+#import "ZIKURLRouteResultInternal.h"
 
 @implementation ZIKURLRouteResult
 
+- (NSDictionary *)parameters {
+    if (!_parameters && (_parameterTemplate || _baseParameters)) {
+        NSMutableDictionary *parameters = _baseParameters ? [_baseParameters mutableCopy] : [NSMutableDictionary dictionary];
+        if (_parameterTemplate && _urlString) {
+            [parameters addEntriesFromDictionary:[_parameterTemplate parametersForURLString:_urlString]];
+        }
+        _parameters = parameters;
+    }
+    return _parameters;
+}
+
+- (NSURL *)url {
+    if (!_url && _urlString) {
+        _url = [NSURL URLWithString:[_urlString stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding]];
+    }
+    return _url;
+}
+
 @end
@@ -0,0 +1,35 @@
+//
+//  ZIKURLRouteResultInternal.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import "ZIKURLRouteResult.h"
+#import "ZIKRouter.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Byte ranges of parameters in a matched url. It's immutable and can be shared by results of the same url string.
+@interface ZIKURLParameterTemplate : NSObject
+- (instancetype)initWithPlaceholderNames:(NSArray<NSString *> *)placeholderNames ranges:(const NSRange *)ranges query:(NSRange)query;
+/// Decode placeholders and query items from UTF-8 bytes of the url string.
+- (NSMutableDictionary<NSString *, NSString *> *)parametersForURLString:(NSString *)urlString;
+@end
+
+@interface ZIKURLRouteResult ()
+/// Handle of the matched pattern interned as route identifier, 0 when the result is not from ZIKURLRouter.
+@property (nonatomic, assign) ZIKRouteIdentifierHandle identifierHandle;
+/// Parameters are decoded from it when `parameters` is first accessed.
+@property (nonatomic, strong, nullable) ZIKURLParameterTemplate *parameterTemplate;
+/// Parameters added before decoded parameters, such as the origin url. Decoded parameters override them.
+@property (nonatomic, copy, nullable) NSDictionary *baseParameters;
+/// Router type resolved when the url is prewarmed. It's ignored when routes changed after `prewarmedRoutesGeneration`.
+@property (nonatomic, strong, nullable) id prewarmedRouterType;
+@property (nonatomic, assign) uint64_t prewarmedRoutesGeneration;
+/// Prewarm key of the destination created when the url is prewarmed.
+@property (nonatomic, copy, nullable) NSString *prewarmKey;
+@end
+
+NS_ASSUME_NONNULL_END
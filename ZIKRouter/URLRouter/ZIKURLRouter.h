@@ -23,11 +23,46 @@ NS_ASSUME_NONNULL_BEGIN
  app://service/path/:id/:number
  app://service/path/:id/:number?k=v&k2&v2
  app://service/path/:id/path/:number
+ app://service/path/:id(int), placeholder only matching integer
+ app://service/path/:slug([a-z-]+), placeholder matching POSIX extended regular expression, the expression can't contain `/`, `?` or `#`
+ app://service/files/ with trailing wildcard `*`, matching one or more path components
+ app://service/files/ with trailing named wildcard `*path`, `path` in parameters is the remaining path
+ 
+ When several patterns match an url, the one with more literal path components wins, such as `app://service/path/:id` over `app://service/:path/:id`. If literal counts are equal, the one with more typed placeholders wins, then the one with literal component at an earlier position, and pattern without wildcard wins at last.
+ 
+ Registration and matching can run on different threads. Matching reads an immutable snapshot of patterns without lock, the snapshot is rebuilt at the first matching after new registrations, so prefer registering patterns in batch.
  */
 @interface ZIKURLRouter : NSObject
 
+/// Max count of urls whose matched results are cached, least recently used url is removed when exceeding. Default is 0 and cache is disabled. Cache is cleared when a pattern is registered.
+@property (nonatomic, assign) NSUInteger resultCacheLimit;
+
 - (void)registerURLPattern:(NSString *)pattern;
+/**
+ Replace registered patterns passing `isReplaced` with the patterns at once, such as patterns from remote config. Other registered patterns are kept. Patterns are compiled on current thread with registration lock, so registrations wait for the swap and are never lost, call it on a background queue. Matching in progress keeps using the old patterns, and matching doesn't take any lock for the swap. Result cache and prewarmed results are cleared.
+ 
+ `isReplaced` is called with registration lock, and it must not register patterns. New patterns not passing it are ignored.
+ */
+- (void)replacePatterns:(NSArray<NSString *> *)patterns passingTest:(BOOL(NS_NOESCAPE ^)(NSString *pattern))isReplaced;
+/// All registered patterns, including patterns loaded from pattern table.
+- (NSSet<NSString *> *)allPatterns;
 - (ZIKURLRouteResult *)resultForURL:(NSString *)url;
+/// Resolve urls in one pass with shared buffers. Key is the url, unmatched urls are not in the result.
+- (NSDictionary<NSString *, ZIKURLRouteResult *> *)resultsForURLs:(NSArray<NSString *> *)urls;
+
+/// Compiled patterns in binary format. Write it to a file, and load it with -loadPatternTableFromFile: at next launch.
+- (NSData *)patternTableData;
+/**
+ Load patterns compiled by -patternTableData. The file is memory mapped, and registering a pattern already in the table is skipped. Call it before registering any pattern. Return NO when the file is missing or invalid, then patterns are compiled when registering.
+ 
+ Patterns in the table are matched even if they are not registered again, so discard the file when your routes change, such as when app version changes.
+ */
+- (BOOL)loadPatternTableFromFile:(NSString *)path;
+
+/// Keep a result resolved ahead of time, until it's taken with -takePrewarmedResultForURL:. Only last 4 results are kept. Results are discarded when a pattern is registered or under memory pressure.
+- (void)storePrewarmedResult:(ZIKURLRouteResult *)result;
+/// Remove and return the prewarmed result for the url.
+- (nullable ZIKURLRouteResult *)takePrewarmedResultForURL:(NSString *)url;
 
 @end
 
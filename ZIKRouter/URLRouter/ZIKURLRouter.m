@@ -7,271 +7,1433 @@
 //
 
 #import "ZIKURLRouter.h"
-#import "ZIKURLRouteResult.h"
+#import "ZIKURLRouteResultInternal.h"
+#import "ZIKRouterPrivate.h"
+#import "ZIKRouteCacheTrimmer.h"
+#import <regex.h>
+#if defined(__ARM_NEON)
+#import <arm_neon.h>
+#elif defined(__SSE2__)
+#import <emmintrin.h>
+#endif
 
-static NSString *kPlaceholderComponent = @"<>";
+/// Check for typed placeholder like `:id(int)` or `:slug([a-z-]+)`. It's immutable and can be shared between snapshots.
+@interface ZIKURLSegmentMatcher : NSObject
+/// `int` or a POSIX extended regular expression.
+@property(nonatomic, copy, readonly) NSString *type;
+@end
+
+@implementation ZIKURLSegmentMatcher {
+    BOOL _matchesInt;
+    BOOL _hasRegex;
+    regex_t _regex;
+}
+
+- (nullable instancetype)initWithType:(NSString *)type {
+    if (self = [super init]) {
+        _type = [type copy];
+        if ([type isEqualToString:@"int"]) {
+            _matchesInt = YES;
+        } else {
+            // Not anchored with `^`, some implementations don't match it at rm_so with REG_STARTEND
+            NSString *expression = [NSString stringWithFormat:@"(%@)", type];
+            if (regcomp(&_regex, expression.UTF8String, REG_EXTENDED) != 0) {
+                NSAssert1(NO, @"Invalid regular expression in url pattern: %@", type);
+                return nil;
+            }
+            _hasRegex = YES;
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_hasRegex) {
+        regfree(&_regex);
+    }
+}
+
+/// Check bytes in range without creating string.
+- (BOOL)matchesBytes:(const char *)bytes range:(NSRange)range {
+    if (_matchesInt) {
+        NSUInteger idx = range.location;
+        NSUInteger end = NSMaxRange(range);
+        if (idx < end && bytes[idx] == '-') {
+            idx++;
+        }
+        if (idx == end) {
+            return NO;
+        }
+        for (; idx < end; idx++) {
+            if (bytes[idx] < '0' || bytes[idx] > '9') {
+                return NO;
+            }
+        }
+        return YES;
+    }
+    regmatch_t match;
+    match.rm_so = (regoff_t)range.location;
+    match.rm_eo = (regoff_t)NSMaxRange(range);
+    if (regexec(&_regex, bytes, 1, &match, REG_STARTEND) != 0) {
+        return NO;
+    }
+    // Leftmost longest match covers whole segment only when whole segment matches
+    return match.rm_so == (regoff_t)range.location && match.rm_eo == (regoff_t)NSMaxRange(range);
+}
+
+@end
+
+/// Node in trie of url path components.
+@interface ZIKURLRouteNode : NSObject
+/// Key: literal path component
+@property(nonatomic, strong, nullable) NSMutableDictionary<NSString *, ZIKURLRouteNode *> *children;
+/// Child for placeholder component like `:id`.
+@property(nonatomic, strong, nullable) ZIKURLRouteNode *placeholderChild;
+/// Children for typed placeholders like `:id(int)`, in order of registration.
+@property(nonatomic, strong, nullable) NSMutableArray<ZIKURLRouteNode *> *typedChildren;
+/// Check of this node when it's a typed child.
+@property(nonatomic, strong, nullable) ZIKURLSegmentMatcher *matcher;
+/// Child for trailing wildcard `*` or `*name`, it matches one or more remaining segments. Pattern always ends at it.
+@property(nonatomic, strong, nullable) ZIKURLRouteNode *wildcardChild;
+/// Whether last placeholder name is for the named wildcard, its value is the remaining path.
+@property(nonatomic, assign) BOOL capturesWildcard;
+/// Origin pattern ending at this node.
+@property(nonatomic, copy, nullable) NSString *pattern;
+/// Handle of the pattern interned as route identifier, routers are found with it without hashing the pattern.
+@property(nonatomic, assign) ZIKRouteIdentifierHandle patternHandle;
+/// Names of placeholders in the pattern without `:`, in order of path components.
+@property(nonatomic, copy, nullable) NSArray<NSString *> *placeholderNames;
+/// Specificity of the pattern ending at this node, from _rankOfPattern.
+@property(nonatomic, assign) uint64_t rank;
+/// Highest rank of patterns in this subtree, for skipping subtrees when matching.
+@property(nonatomic, assign) uint64_t maxRank;
+@end
+
+@implementation ZIKURLRouteNode
+
+- (ZIKURLRouteNode *)deepCopy {
+    ZIKURLRouteNode *node = [ZIKURLRouteNode new];
+    node.pattern = self.pattern;
+    node.patternHandle = self.patternHandle;
+    node.placeholderNames = self.placeholderNames;
+    node.rank = self.rank;
+    node.maxRank = self.maxRank;
+    node.matcher = self.matcher;
+    node.capturesWildcard = self.capturesWildcard;
+    node.placeholderChild = [self.placeholderChild deepCopy];
+    node.wildcardChild = [self.wildcardChild deepCopy];
+    if (self.typedChildren) {
+        NSMutableArray<ZIKURLRouteNode *> *typedChildren = [NSMutableArray arrayWithCapacity:self.typedChildren.count];
+        for (ZIKURLRouteNode *child in self.typedChildren) {
+            [typedChildren addObject:[child deepCopy]];
+        }
+        node.typedChildren = typedChildren;
+    }
+    if (self.children) {
+        NSMutableDictionary<NSString *, ZIKURLRouteNode *> *children = [NSMutableDictionary dictionaryWithCapacity:self.children.count];
+        [self.children enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull key, ZIKURLRouteNode * _Nonnull child, BOOL * _Nonnull stop) {
+            children[key] = [child deepCopy];
+        }];
+        node.children = children;
+    }
+    return node;
+}
+
+@end
+
+/// Node in doubly linked list of cached results, head is the most recently used.
+@interface ZIKURLRouteCacheEntry : NSObject
+@property(nonatomic, copy) NSString *urlString;
+@property(nonatomic, copy) NSString *pattern;
+@property(nonatomic, assign) ZIKRouteIdentifierHandle patternHandle;
+@property(nonatomic, strong) ZIKURLParameterTemplate *parameterTemplate;
+@property(nonatomic, weak, nullable) ZIKURLRouteCacheEntry *previous;
+@property(nonatomic, strong, nullable) ZIKURLRouteCacheEntry *next;
+@end
+
+@implementation ZIKURLRouteCacheEntry
+@end
 
 @interface ZIKURLRouter ()
 
 /**
- Container for static url or url with continuous placeholders like: scheme://host/path/:placeholder/:placeholder2
- Key: fixed pattern Value: origin pattern
+ Trie for all url patterns, like scheme://host/path, scheme://host/path/:placeholder/:placeholder2 and scheme://host/:placeholder/path1/:placeholder2
+ Key: scheme://host Value: root node, its children are the first path components
+ 
+ Only modified with registrationSema. Matching reads the published snapshot of it.
  */
-@property(nonatomic, strong) NSMutableDictionary<NSString *, NSString *> *patternContainer;
+@property(nonatomic, strong) NSMutableDictionary<NSString *, ZIKURLRouteNode *> *patternTrie;
+@property(nonatomic, strong) dispatch_semaphore_t registrationSema;
+/// All patterns in patternTrie, registering them again is skipped.
+@property(nonatomic, strong) NSMutableSet<NSString *> *registeredPatterns;
+
+/// Lock for result cache.
+@property(nonatomic, strong) dispatch_semaphore_t cacheSema;
+/// Increased when cache is cleared, results matched with older trie are not cached.
+@property(nonatomic, assign) NSUInteger cacheGeneration;
+/// Cached results when resultCacheLimit > 0. Key: url string
+@property(nonatomic, strong, nullable) NSMutableDictionary<NSString *, ZIKURLRouteCacheEntry *> *resultCache;
+@property(nonatomic, strong, nullable) ZIKURLRouteCacheEntry *cacheHead;
+@property(nonatomic, weak, nullable) ZIKURLRouteCacheEntry *cacheTail;
+/// Results stored by -storePrewarmedResult:, guarded by cacheSema. Key: url string
+@property(nonatomic, strong, nullable) NSMutableDictionary<NSString *, ZIKURLRouteResult *> *prewarmedResults;
+/// Urls of prewarmedResults, from least recently stored to most recently stored.
+@property(nonatomic, strong, nullable) NSMutableArray<NSString *> *prewarmedURLs;
+/// Result cache is trimmed under memory pressure after it's created.
+@property(nonatomic, assign) BOOL registeredCacheTrimmer;
+@end
+
+/// Max count of prewarmed results, deep links are rarely prewarmed in batch.
+static const NSUInteger ZIKURLPrewarmedResultLimit = 4;
+
+/// Max path segments kept on stack when tokenizing url.
+#define ZIKURLInlineSegmentCount 16
+
+/// Byte ranges of an url in its UTF-8 string. Missing part has location NSNotFound.
+typedef struct ZIKURLTokens {
+    NSRange scheme;
+    NSRange host;
+    NSRange query;
+    /// Whether any path segment contains `%`. Segments are not decoded when there's no escape.
+    BOOL pathEscaped;
+    NSUInteger segmentCount;
+    NSUInteger segmentCapacity;
+    /// Ranges of non-empty path segments. Points to inlineSegments unless there are more than ZIKURLInlineSegmentCount segments.
+    NSRange *segments;
+    /// Indexes of segments matching placeholders when matching, with the same capacity as segments.
+    NSUInteger *captures;
+    /// Captures of the best matched pattern.
+    NSUInteger *bestCaptures;
+    NSRange inlineSegments[ZIKURLInlineSegmentCount];
+    NSUInteger inlineCaptures[ZIKURLInlineSegmentCount];
+    NSUInteger inlineBestCaptures[ZIKURLInlineSegmentCount];
+} ZIKURLTokens;
+
+/// Prepare buffers. Tokens can be reused for many urls, call _freeURLTokens when finished.
+static void _initURLTokens(ZIKURLTokens *tokens) {
+    tokens->segmentCount = 0;
+    tokens->segmentCapacity = ZIKURLInlineSegmentCount;
+    tokens->segments = tokens->inlineSegments;
+    tokens->captures = tokens->inlineCaptures;
+    tokens->bestCaptures = tokens->inlineBestCaptures;
+}
+
+static void _addSegment(ZIKURLTokens *tokens, NSUInteger location, NSUInteger length) {
+    if (length == 0) {
+        return;
+    }
+    if (tokens->segmentCount == tokens->segmentCapacity) {
+        NSUInteger capacity = tokens->segmentCapacity * 2;
+        NSRange *segments = malloc(sizeof(NSRange) * capacity);
+        memcpy(segments, tokens->segments, sizeof(NSRange) * tokens->segmentCount);
+        if (tokens->segments != tokens->inlineSegments) {
+            free(tokens->segments);
+            free(tokens->captures);
+            free(tokens->bestCaptures);
+        }
+        tokens->segments = segments;
+        tokens->captures = malloc(sizeof(NSUInteger) * capacity);
+        tokens->bestCaptures = malloc(sizeof(NSUInteger) * capacity);
+        tokens->segmentCapacity = capacity;
+    }
+    tokens->segments[tokens->segmentCount++] = NSMakeRange(location, length);
+}
 
 /**
- Container for url with discontinuous placeholders like: scheme://host/:placeholder/path1/:placeholder2
- {
-     5 // url component count
-     : [
-        ["scheme", "host", ":placeholder", "path1", ":placeholder2", "scheme://host/:placeholder/path1/:placeholder2", 24 \* placeholder idxs *\],
-     ],
- }
+ Index of the first byte equal to any of the delimiters in [location, end), or end when not found. Compare 16 bytes at once with NEON on device and SSE2 on simulator, so long paths and query strings are scanned in one pass without checking each byte.
+ 
+ Pass the same delimiter more than once when there are less than 4 delimiters.
  */
-@property(nonatomic, strong) NSMutableDictionary<NSNumber *,  NSMutableArray *> *placeholderPatternContainer;
-@end
+static inline NSUInteger _nextDelimiter(const char *bytes, NSUInteger location, NSUInteger end, char d1, char d2, char d3, char d4) {
+    NSUInteger pos = location;
+#if defined(__ARM_NEON)
+    const uint8x16_t v1 = vdupq_n_u8((uint8_t)d1);
+    const uint8x16_t v2 = vdupq_n_u8((uint8_t)d2);
+    const uint8x16_t v3 = vdupq_n_u8((uint8_t)d3);
+    const uint8x16_t v4 = vdupq_n_u8((uint8_t)d4);
+    for (; pos + 16 <= end; pos += 16) {
+        uint8x16_t chunk = vld1q_u8((const uint8_t *)bytes + pos);
+        uint8x16_t matches = vorrq_u8(vorrq_u8(vceqq_u8(chunk, v1), vceqq_u8(chunk, v2)), vorrq_u8(vceqq_u8(chunk, v3), vceqq_u8(chunk, v4)));
+        // Narrow each matched byte to 4 bits of a 64-bit mask
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+        if (mask != 0) {
+            return pos + (__builtin_ctzll(mask) >> 2);
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i v1 = _mm_set1_epi8(d1);
+    const __m128i v2 = _mm_set1_epi8(d2);
+    const __m128i v3 = _mm_set1_epi8(d3);
+    const __m128i v4 = _mm_set1_epi8(d4);
+    for (; pos + 16 <= end; pos += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(bytes + pos));
+        __m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, v1), _mm_cmpeq_epi8(chunk, v2)), _mm_or_si128(_mm_cmpeq_epi8(chunk, v3), _mm_cmpeq_epi8(chunk, v4)));
+        int mask = _mm_movemask_epi8(matches);
+        if (mask != 0) {
+            return pos + __builtin_ctz(mask);
+        }
+    }
+#endif
+    for (; pos < end; pos++) {
+        char c = bytes[pos];
+        if (c == d1 || c == d2 || c == d3 || c == d4) {
+            return pos;
+        }
+    }
+    return end;
+}
+
+/// Scan the url once, like scheme://user@host:port/path1/path2?query#fragment. Tokens must be prepared with _initURLTokens.
+static void _tokenizeURL(const char *bytes, NSUInteger length, ZIKURLTokens *tokens) {
+    tokens->scheme = NSMakeRange(NSNotFound, 0);
+    tokens->host = NSMakeRange(NSNotFound, 0);
+    tokens->query = NSMakeRange(NSNotFound, 0);
+    tokens->pathEscaped = NO;
+    tokens->segmentCount = 0;
+    
+    NSUInteger pos = 0;
+    for (NSUInteger i = 0; i < length; i++) {
+        char c = bytes[i];
+        if (c == ':') {
+            tokens->scheme = NSMakeRange(0, i);
+            pos = i + 1;
+            break;
+        }
+        if (c == '/' || c == '?' || c == '#') {
+            break;
+        }
+    }
+    if (pos + 1 < length && bytes[pos] == '/' && bytes[pos + 1] == '/') {
+        NSUInteger start = pos + 2;
+        NSUInteger end = start;
+        NSUInteger hostStart = start;
+        NSUInteger portStart = NSNotFound;
+        for (; end < length; end++) {
+            char c = bytes[end];
+            if (c == '/' || c == '?' || c == '#') {
+                break;
+            }
+            if (c == '@') {
+                hostStart = end + 1;
+                portStart = NSNotFound;
+            } else if (c == ':') {
+                portStart = end;
+            } else if (c == ']') {
+                // End of IPv6 address
+                portStart = NSNotFound;
+            }
+        }
+        NSUInteger hostEnd = portStart != NSNotFound ? portStart : end;
+        tokens->host = NSMakeRange(hostStart, hostEnd - hostStart);
+        pos = end;
+    }
+    NSUInteger segmentStart = pos;
+    for (; (pos = _nextDelimiter(bytes, pos, length, '/', '?', '#', '%')) < length; pos++) {
+        char c = bytes[pos];
+        if (c == '?' || c == '#') {
+            break;
+        }
+        if (c == '%') {
+            tokens->pathEscaped = YES;
+        } else {
+            _addSegment(tokens, segmentStart, pos - segmentStart);
+            segmentStart = pos + 1;
+        }
+    }
+    _addSegment(tokens, segmentStart, pos - segmentStart);
+    if (pos < length && bytes[pos] == '?') {
+        NSUInteger start = pos + 1;
+        NSUInteger end = _nextDelimiter(bytes, start, length, '#', '#', '#', '#');
+        tokens->query = NSMakeRange(start, end - start);
+    }
+}
+
+static void _freeURLTokens(ZIKURLTokens *tokens) {
+    if (tokens->segments != tokens->inlineSegments) {
+        free(tokens->segments);
+        free(tokens->captures);
+        free(tokens->bestCaptures);
+    }
+    tokens->segments = NULL;
+    tokens->captures = NULL;
+    tokens->bestCaptures = NULL;
+}
+
+static inline int _hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/// Create string from bytes in range, percent escapes are decoded when `escaped` is YES. Invalid escapes are kept as is.
+static NSString *_stringFromBytes(const char *bytes, NSRange range, BOOL escaped) {
+    const char *start = bytes + range.location;
+    if (!escaped) {
+        return [[NSString alloc] initWithBytes:start length:range.length encoding:NSUTF8StringEncoding] ?: @"";
+    }
+    char inlineBuffer[256];
+    char *buffer = range.length <= sizeof(inlineBuffer) ? inlineBuffer : malloc(range.length);
+    NSUInteger length = 0;
+    for (NSUInteger i = 0; i < range.length; i++) {
+        int high, low;
+        if (start[i] == '%' && i + 2 < range.length && (high = _hexValue(start[i + 1])) >= 0 && (low = _hexValue(start[i + 2])) >= 0) {
+            buffer[length++] = (char)(high << 4 | low);
+            i += 2;
+        } else {
+            buffer[length++] = start[i];
+        }
+    }
+    NSString *string = [[NSString alloc] initWithBytes:buffer length:length encoding:NSUTF8StringEncoding];
+    if (buffer != inlineBuffer) {
+        free(buffer);
+    }
+    if (!string) {
+        string = [[NSString alloc] initWithBytes:start length:range.length encoding:NSUTF8StringEncoding];
+    }
+    return string ?: @"";
+}
+
+/// Create string from bytes in range, percent escapes are decoded. Invalid escapes are kept as is.
+static NSString *_decodedString(const char *bytes, NSRange range) {
+    return _stringFromBytes(bytes, range, memchr(bytes + range.location, '%', range.length) != NULL);
+}
+
+/// Key for looking up literal segment in trie. Segment without escapes is wrapped without copying, it's only valid while bytes are alive. `pathEscaped` is from the tokens, segments are not searched for escapes when it's NO.
+static NSString *_lookupKeyForSegment(const char *bytes, NSRange range, BOOL pathEscaped) {
+    if (!pathEscaped || memchr(bytes + range.location, '%', range.length) == NULL) {
+        return [[NSString alloc] initWithBytesNoCopy:(void *)(bytes + range.location) length:range.length encoding:NSUTF8StringEncoding freeWhenDone:NO];
+    }
+    return _decodedString(bytes, range);
+}
+
+static const char *_UTF8BytesOfString(NSString *string, NSUInteger *length) {
+    const char *bytes = CFStringGetCStringPtr((__bridge CFStringRef)string, kCFStringEncodingUTF8);
+    if (!bytes) {
+        bytes = string.UTF8String;
+    }
+    *length = bytes ? strlen(bytes) : 0;
+    return bytes;
+}
+
+typedef NS_ENUM(NSInteger, ZIKURLSegmentKind) {
+    ZIKURLSegmentKindLiteral,
+    /// `:name`
+    ZIKURLSegmentKindPlaceholder,
+    /// `:name(type)`
+    ZIKURLSegmentKindTypedPlaceholder,
+    /// `*` or `*name`
+    ZIKURLSegmentKindWildcard
+};
+
+static ZIKURLSegmentKind _kindOfPatternSegment(const char *bytes, NSRange segment) {
+    char first = bytes[segment.location];
+    if (first == '*') {
+        return ZIKURLSegmentKindWildcard;
+    }
+    if (first != ':') {
+        return ZIKURLSegmentKindLiteral;
+    }
+    if (segment.length > 3 && bytes[NSMaxRange(segment) - 1] == ')' && memchr(bytes + segment.location, '(', segment.length) != NULL) {
+        return ZIKURLSegmentKindTypedPlaceholder;
+    }
+    return ZIKURLSegmentKindPlaceholder;
+}
+
+/**
+ Specificity of a pattern. Pattern with more literal segments has higher rank, then pattern with more typed placeholders, then pattern with literal segment at an earlier position, and pattern without wildcard is preferred at last. Every route has rank >= 1 except routes ending with wildcard. Routes with the same rank are resolved in order of literal, typed placeholder, placeholder and wildcard.
+ 
+ Bits 48-63: count of literal segments. Bits 32-47: count of typed placeholders. Bits 1-31: bit (31 - idx) is set when segment at idx is literal, only the first 31 segments are recorded. Bit 0: set when pattern has no wildcard.
+ */
+static uint64_t _rankOfPattern(const char *bytes, const ZIKURLTokens *tokens) {
+    uint64_t literalCount = 0;
+    uint64_t typedCount = 0;
+    uint64_t literalMask = 0;
+    uint64_t noWildcard = 1;
+    for (NSUInteger idx = 0; idx < tokens->segmentCount; idx++) {
+        switch (_kindOfPatternSegment(bytes, tokens->segments[idx])) {
+            case ZIKURLSegmentKindLiteral:
+                literalCount++;
+                if (idx < 31) {
+                    literalMask |= (uint64_t)1 << (31 - idx);
+                }
+                break;
+            case ZIKURLSegmentKindTypedPlaceholder:
+                typedCount++;
+                break;
+            case ZIKURLSegmentKindWildcard:
+                noWildcard = 0;
+                break;
+            case ZIKURLSegmentKindPlaceholder:
+                break;
+        }
+    }
+    return MIN(literalCount, 0xFFFF) << 48 | MIN(typedCount, 0xFFFF) << 32 | literalMask | noWildcard;
+}
+
+/// Key is `scheme://host`, scheme and host are empty strings when missing.
+static NSString *_rootKeyForBytes(const char *bytes, const ZIKURLTokens *tokens) {
+    NSUInteger schemeLength = tokens->scheme.location != NSNotFound ? tokens->scheme.length : 0;
+    if (tokens->host.location == NSNotFound) {
+        NSString *scheme = schemeLength > 0 ? _decodedString(bytes, tokens->scheme) : @"";
+        return [scheme stringByAppendingString:@"://"];
+    }
+    // Url starts with `scheme://host` or `://host`, and host has no escapes
+    if (tokens->scheme.location != NSNotFound && tokens->host.location == schemeLength + 3 && memchr(bytes, '%', NSMaxRange(tokens->host)) == NULL) {
+        return [[NSString alloc] initWithBytesNoCopy:(void *)bytes length:NSMaxRange(tokens->host) encoding:NSUTF8StringEncoding freeWhenDone:NO];
+    }
+    NSString *scheme = schemeLength > 0 ? _decodedString(bytes, tokens->scheme) : @"";
+    return [NSString stringWithFormat:@"%@://%@", scheme, _decodedString(bytes, tokens->host)];
+}
+
+/// Add the pattern to the trie. Return NO when the pattern is invalid.
+static BOOL _addPatternToTrie(NSMutableDictionary<NSString *, ZIKURLRouteNode *> *trie, NSString *pattern, const char *bytes, NSUInteger length) {
+    ZIKURLTokens tokens;
+    _initURLTokens(&tokens);
+    _tokenizeURL(bytes, length, &tokens);
+    NSString *rootKey = _rootKeyForBytes(bytes, &tokens);
+    ZIKURLRouteNode *node = trie[rootKey];
+    if (!node) {
+        node = [ZIKURLRouteNode new];
+        trie[rootKey] = node;
+    }
+    NSMutableArray<NSString *> *placeholderNames = [NSMutableArray array];
+    uint64_t rank = _rankOfPattern(bytes, &tokens);
+    node.maxRank = MAX(node.maxRank, rank);
+    BOOL capturesWildcard = NO;
+    BOOL invalid = NO;
+    for (NSUInteger idx = 0; idx < tokens.segmentCount; idx++) {
+        NSRange segment = tokens.segments[idx];
+        ZIKURLRouteNode *child;
+        ZIKURLSegmentKind kind = _kindOfPatternSegment(bytes, segment);
+        if (kind == ZIKURLSegmentKindWildcard) {
+            NSCAssert1(idx == tokens.segmentCount - 1, @"Wildcard must be the last path component in url pattern: %@", pattern);
+            if (segment.length > 1) {
+                [placeholderNames addObject:_decodedString(bytes, NSMakeRange(segment.location + 1, segment.length - 1))];
+                capturesWildcard = YES;
+            }
+            child = node.wildcardChild;
+            if (!child) {
+                child = [ZIKURLRouteNode new];
+                node.wildcardChild = child;
+            }
+            node = child;
+            node.maxRank = MAX(node.maxRank, rank);
+            break;
+        } else if (kind == ZIKURLSegmentKindTypedPlaceholder) {
+            const char *open = memchr(bytes + segment.location, '(', segment.length);
+            NSUInteger typeStart = open - bytes + 1;
+            [placeholderNames addObject:_decodedString(bytes, NSMakeRange(segment.location + 1, typeStart - 1 - segment.location - 1))];
+            NSString *type = _decodedString(bytes, NSMakeRange(typeStart, NSMaxRange(segment) - 1 - typeStart));
+            child = nil;
+            for (ZIKURLRouteNode *typedChild in node.typedChildren) {
+                if ([typedChild.matcher.type isEqualToString:type]) {
+                    child = typedChild;
+                    break;
+                }
+            }
+            if (!child) {
+                ZIKURLSegmentMatcher *matcher = [[ZIKURLSegmentMatcher alloc] initWithType:type];
+                if (!matcher) {
+                    invalid = YES;
+                    break;
+                }
+                child = [ZIKURLRouteNode new];
+                child.matcher = matcher;
+                if (!node.typedChildren) {
+                    node.typedChildren = [NSMutableArray array];
+                }
+                [node.typedChildren addObject:child];
+            }
+        } else if (kind == ZIKURLSegmentKindPlaceholder) {
+            [placeholderNames addObject:_decodedString(bytes, NSMakeRange(segment.location + 1, segment.length - 1))];
+            child = node.placeholderChild;
+            if (!child) {
+                child = [ZIKURLRouteNode new];
+                node.placeholderChild = child;
+            }
+        } else {
+            if (!node.children) {
+                node.children = [NSMutableDictionary dictionary];
+            }
+            NSString *pathComponent = _decodedString(bytes, segment);
+            child = node.children[pathComponent];
+            if (!child) {
+                child = [ZIKURLRouteNode new];
+                node.children[pathComponent] = child;
+            }
+        }
+        node = child;
+        node.maxRank = MAX(node.maxRank, rank);
+    }
+    _freeURLTokens(&tokens);
+    if (invalid) {
+        return NO;
+    }
+    node.pattern = pattern;
+    node.patternHandle = zix_internRouteIdentifier(pattern);
+    node.placeholderNames = placeholderNames;
+    node.capturesWildcard = capturesWildcard;
+    node.rank = rank;
+    return YES;
+}
 
-@implementation ZIKURLRouter
+/// Immutable copy of the trie for matching without lock.
+static NSDictionary<NSString *, ZIKURLRouteNode *> *_snapshotOfTrie(NSDictionary<NSString *, ZIKURLRouteNode *> *trie) {
+    NSMutableDictionary<NSString *, ZIKURLRouteNode *> *snapshot = [NSMutableDictionary dictionaryWithCapacity:trie.count];
+    [trie enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull key, ZIKURLRouteNode * _Nonnull node, BOOL * _Nonnull stop) {
+        snapshot[key] = [node deepCopy];
+    }];
+    return [snapshot copy];
+}
+
+@implementation ZIKURLRouter {
+    /// Immutable copy of patternTrie, retained. Read with atomic load.
+    void *_publishedSnapshot;
+    /// patternTrie is modified after publishing.
+    bool _snapshotOutdated;
+    /// Count of prewarmedResults, so taking skips the lock when there is none.
+    NSUInteger _prewarmedCount;
+}
 
 - (instancetype)init {
     if (self = [super init]) {
-        _patternContainer = [NSMutableDictionary dictionary];
-        _placeholderPatternContainer = [NSMutableDictionary dictionary];
+        _patternTrie = [NSMutableDictionary dictionary];
+        _registrationSema = dispatch_semaphore_create(1);
+        _registeredPatterns = [NSMutableSet set];
+        _cacheSema = dispatch_semaphore_create(1);
     }
     return self;
 }
 
+- (void)dealloc {
+    if (_publishedSnapshot) {
+        CFRelease(_publishedSnapshot);
+    }
+}
+
+static void _releaseSnapshot(void *snapshot) {
+    CFRelease(snapshot);
+}
+
+/// Return immutable trie for matching. In common case there is no registration after last publishing, and this doesn't take lock. Published snapshot is retained before leaving snapshot reading, so a replaced snapshot is only released after all threads loading it retained it.
+- (NSDictionary<NSString *, ZIKURLRouteNode *> *)_snapshot {
+    zix_beginSnapshotReading();
+    if (!__atomic_load_n(&_snapshotOutdated, __ATOMIC_ACQUIRE)) {
+        void *snapshot = __atomic_load_n(&_publishedSnapshot, __ATOMIC_ACQUIRE);
+        if (snapshot) {
+            NSDictionary<NSString *, ZIKURLRouteNode *> *published = (__bridge NSDictionary *)snapshot;
+            zix_endSnapshotReading();
+            return published;
+        }
+    }
+    dispatch_semaphore_wait(_registrationSema, DISPATCH_TIME_FOREVER);
+    void *snapshot = __atomic_load_n(&_publishedSnapshot, __ATOMIC_ACQUIRE);
+    if (!snapshot || __atomic_load_n(&_snapshotOutdated, __ATOMIC_ACQUIRE)) {
+        void *newSnapshot = (void *)CFBridgingRetain(_snapshotOfTrie(_patternTrie));
+        __atomic_store_n(&_publishedSnapshot, newSnapshot, __ATOMIC_RELEASE);
+        __atomic_store_n(&_snapshotOutdated, false, __ATOMIC_RELEASE);
+        if (snapshot) {
+            zix_retireSnapshot(snapshot, _releaseSnapshot);
+        }
+        snapshot = newSnapshot;
+    }
+    NSDictionary<NSString *, ZIKURLRouteNode *> *published = (__bridge NSDictionary *)snapshot;
+    dispatch_semaphore_signal(_registrationSema);
+    zix_endSnapshotReading();
+    return published;
+}
+
 - (void)registerURLPattern:(NSString *)pattern {
     NSParameterAssert(pattern);
-    NSURL *url = [NSURL URLWithString:pattern];
-    NSAssert1(url, @"Invalid url pattern: %@", pattern);
-    if (!url) {
+    if (!pattern) {
         return;
     }
-    NSString *path = url.path;
-    if (!path || [path rangeOfString:@":"].location == NSNotFound) {
-        _patternContainer[pattern] = pattern;
+    NSUInteger length;
+    const char *bytes = _UTF8BytesOfString(pattern, &length);
+    if (!bytes) {
         return;
     }
-    NSMutableString *key = [NSMutableString string];
-    NSString *scheme = url.scheme;
-    if (scheme) {
-        [key appendString:scheme];
+    dispatch_semaphore_wait(_registrationSema, DISPATCH_TIME_FOREVER);
+    if ([_registeredPatterns containsObject:pattern]) {
+        // Already loaded from pattern table
+        dispatch_semaphore_signal(_registrationSema);
+        return;
     }
-    [key appendString:@"://"];
-    NSString *host = url.host;
-    if (host) {
-        [key appendString:host];
+    if (!_addPatternToTrie(_patternTrie, pattern, bytes, length)) {
+        dispatch_semaphore_signal(_registrationSema);
+        return;
     }
-    
-    BOOL hasPlaceHolder = NO;
-    BOOL hasDiscontinuousPlaceHolders = NO;
-    NSArray *pathComponents = url.pathComponents;
-    if (pathComponents.count > 0) {
-        for (NSString *pathComponent in pathComponents) {
-            if ([pathComponent isEqualToString:@"/"]) {
-                continue;
-            }
-            [key appendString:@"/"];
-            // Replace placeholder with kPlaceholderComponent
-            if ([pathComponent hasPrefix:@":"]) {
-                [key appendString:kPlaceholderComponent];
-                hasPlaceHolder = YES;
-            } else {
-                [key appendString:pathComponent];
-                if (hasPlaceHolder) {
-                    hasDiscontinuousPlaceHolders = YES;
-                    break;
-                }
-            }
+    [_registeredPatterns addObject:pattern];
+    __atomic_store_n(&_snapshotOutdated, true, __ATOMIC_RELEASE);
+    dispatch_semaphore_signal(_registrationSema);
+    // Clear after trie is changed, so results matched with old snapshot won't be cached again
+    dispatch_semaphore_wait(_cacheSema, DISPATCH_TIME_FOREVER);
+    [self _clearResultCache];
+    [self _clearPrewarmedResults];
+    dispatch_semaphore_signal(_cacheSema);
+}
+
+static void _addPatternsToTrie(NSMutableDictionary<NSString *, ZIKURLRouteNode *> *trie, NSMutableSet<NSString *> *registeredPatterns, id<NSFastEnumeration> patterns, BOOL(NS_NOESCAPE ^isIncluded)(NSString *pattern)) {
+    for (NSString *pattern in patterns) {
+        if ([registeredPatterns containsObject:pattern] || !isIncluded(pattern)) {
+            continue;
+        }
+        NSUInteger length;
+        const char *bytes = _UTF8BytesOfString(pattern, &length);
+        if (bytes && _addPatternToTrie(trie, pattern, bytes, length)) {
+            [registeredPatterns addObject:pattern];
         }
     }
-    if (!hasDiscontinuousPlaceHolders) {
-        _patternContainer[key] = pattern;
-    } else {
-        [self _addPlaceholderPattern:pattern scheme:scheme host:host url:url];
+}
+
+- (void)replacePatterns:(NSArray<NSString *> *)patterns passingTest:(BOOL(NS_NOESCAPE ^)(NSString *pattern))isReplaced {
+    NSParameterAssert(isReplaced);
+    // Compile with lock, so patterns registered meanwhile are not discarded by the swap
+    dispatch_semaphore_wait(_registrationSema, DISPATCH_TIME_FOREVER);
+    NSMutableDictionary<NSString *, ZIKURLRouteNode *> *trie = [NSMutableDictionary dictionary];
+    NSMutableSet<NSString *> *registeredPatterns = [NSMutableSet setWithCapacity:_registeredPatterns.count + patterns.count];
+    _addPatternsToTrie(trie, registeredPatterns, _registeredPatterns, ^BOOL(NSString *pattern) {
+        return !isReplaced(pattern);
+    });
+    _addPatternsToTrie(trie, registeredPatterns, patterns, isReplaced);
+    void *newSnapshot = (void *)CFBridgingRetain(_snapshotOfTrie(trie));
+    _patternTrie = trie;
+    _registeredPatterns = registeredPatterns;
+    void *snapshot = __atomic_exchange_n(&_publishedSnapshot, newSnapshot, __ATOMIC_ACQ_REL);
+    __atomic_store_n(&_snapshotOutdated, false, __ATOMIC_RELEASE);
+    if (snapshot) {
+        // Matching in progress may still be loading it
+        zix_retireSnapshot(snapshot, _releaseSnapshot);
     }
+    dispatch_semaphore_signal(_registrationSema);
+    dispatch_semaphore_wait(_cacheSema, DISPATCH_TIME_FOREVER);
+    [self _clearResultCache];
+    [self _clearPrewarmedResults];
+    dispatch_semaphore_signal(_cacheSema);
 }
 
-- (void)_addPlaceholderPattern:(NSString *)pattern scheme:(NSString *)scheme host:(NSString *)host url:(NSURL *)url {
-    if (!scheme) {
-        scheme = @"";
+/**
+ Walk path segments from the node and return the matched pattern with highest rank. Subtrees whose maxRank is not higher than current best are skipped, and literal child is tried before placeholder child, so the best match is usually the first one found.
+ 
+ Indexes of segments matching placeholders of the best pattern are written into `tokens->bestCaptures`.
+ */
+- (nullable ZIKURLRouteNode *)_matchNode:(ZIKURLRouteNode *)node bytes:(const char *)bytes tokens:(ZIKURLTokens *)tokens index:(NSUInteger)index capturedCount:(NSUInteger)capturedCount best:(nullable ZIKURLRouteNode *)best {
+    if (best && node.maxRank <= best.rank) {
+        return best;
     }
-    if (!host) {
-        host = @"";
+    if (index == tokens->segmentCount) {
+        if (node.pattern && (!best || node.rank > best.rank)) {
+            memcpy(tokens->bestCaptures, tokens->captures, sizeof(NSUInteger) * capturedCount);
+            return node;
+        }
+        return best;
     }
-    NSMutableArray *components = [self pathComponetsForURL:url];
-    [components insertObject:host atIndex:0];
-    [components insertObject:scheme atIndex:0];
-    
-    NSNumber *count = @(components.count);
-    NSMutableArray *countedRoutes = _placeholderPatternContainer[count];
-    if (!countedRoutes) {
-        countedRoutes = [NSMutableArray array];
-        _placeholderPatternContainer[count] = countedRoutes;
+    if (node.children) {
+        ZIKURLRouteNode *child = node.children[_lookupKeyForSegment(bytes, tokens->segments[index], tokens->pathEscaped)];
+        if (child) {
+            best = [self _matchNode:child bytes:bytes tokens:tokens index:index + 1 capturedCount:capturedCount best:best];
+        }
     }
-    
-    int idxsToCheck = 0;
-    for (int idx = 0; idx < components.count; idx++) {
-        NSString *component = components[idx];
-        if (![component hasPrefix:@":"]) {
-            idxsToCheck = idxsToCheck * 10 + idx;
+    NSRange segment = tokens->segments[index];
+    for (ZIKURLRouteNode *child in node.typedChildren) {
+        if ([child.matcher matchesBytes:bytes range:segment]) {
+            tokens->captures[capturedCount] = index;
+            best = [self _matchNode:child bytes:bytes tokens:tokens index:index + 1 capturedCount:capturedCount + 1 best:best];
         }
     }
-    [components addObject:pattern];
-    [components addObject:@(idxsToCheck)];
-    [countedRoutes addObject:components];
+    ZIKURLRouteNode *child = node.placeholderChild;
+    if (child) {
+        tokens->captures[capturedCount] = index;
+        best = [self _matchNode:child bytes:bytes tokens:tokens index:index + 1 capturedCount:capturedCount + 1 best:best];
+    }
+    // Wildcard consumes all remaining segments
+    child = node.wildcardChild;
+    if (child && child.pattern && (!best || child.rank > best.rank)) {
+        tokens->captures[capturedCount] = index;
+        memcpy(tokens->bestCaptures, tokens->captures, sizeof(NSUInteger) * (capturedCount + 1));
+        best = child;
+    }
+    return best;
 }
 
-- (ZIKURLRouteResult *)resultForURLWithDiscontinuousPlaceHolders:(NSURL *)url {
-    ZIKURLRouteResult *result;
-    NSString *scheme = url.scheme ?: @"";
-    NSString *host = url.host ?: @"";
-    NSMutableArray<NSString *> *components = [self pathComponetsForURL:url];
-    [components insertObject:host atIndex:0];
-    [components insertObject:scheme atIndex:0];
-    
-    NSMutableArray *countedRoutes = _placeholderPatternContainer[@(components.count)];
-    if (!countedRoutes) {
+- (ZIKURLRouteResult *)resultForURL:(NSString *)urlString {
+    NSParameterAssert(urlString);
+    if (!urlString) {
         return nil;
     }
-    NSArray *matchedComponents;
-    for (NSArray *registeredComponents in countedRoutes) {
-        if (![[components firstObject] isEqualToString:[registeredComponents firstObject]]) {
+    NSUInteger generation = [self _currentCacheGeneration];
+    NSDictionary<NSString *, ZIKURLRouteNode *> *snapshot = [self _snapshot];
+    ZIKURLTokens tokens;
+    _initURLTokens(&tokens);
+    ZIKURLRouteResult *result = [self _resultForURL:urlString snapshot:snapshot cacheGeneration:generation tokens:&tokens];
+    _freeURLTokens(&tokens);
+    return result;
+}
+
+- (NSDictionary<NSString *, ZIKURLRouteResult *> *)resultsForURLs:(NSArray<NSString *> *)urls {
+    NSMutableDictionary<NSString *, ZIKURLRouteResult *> *results = [NSMutableDictionary dictionaryWithCapacity:urls.count];
+    NSUInteger generation = [self _currentCacheGeneration];
+    NSDictionary<NSString *, ZIKURLRouteNode *> *snapshot = [self _snapshot];
+    // Share buffers for all urls
+    ZIKURLTokens tokens;
+    _initURLTokens(&tokens);
+    for (NSString *urlString in urls) {
+        if (results[urlString]) {
             continue;
         }
-        int idxsToCheck = [[registeredComponents lastObject] intValue];
-        int idx;
-        BOOL match = YES;
-        while (idxsToCheck > 0) {
-            idx = idxsToCheck % 10;
-            NSString *component = components[idx];
-            NSString *registeredComponent = registeredComponents[idx];
-            if (![component isEqualToString:registeredComponent]) {
-                match = NO;
-                break;
-            }
-            idxsToCheck = idxsToCheck / 10;
+        ZIKURLRouteResult *result = [self _resultForURL:urlString snapshot:snapshot cacheGeneration:generation tokens:&tokens];
+        if (result) {
+            results[urlString] = result;
         }
-        if (match) {
-            matchedComponents = registeredComponents;
-            break;
+    }
+    _freeURLTokens(&tokens);
+    return results;
+}
+
+/// Generation must be read before getting snapshot, then result matched with snapshot older than a registration won't be cached.
+- (nullable ZIKURLRouteResult *)_resultForURL:(NSString *)urlString snapshot:(NSDictionary<NSString *, ZIKURLRouteNode *> *)snapshot cacheGeneration:(NSUInteger)generation tokens:(ZIKURLTokens *)tokens {
+    uint64_t startTime = zix_routeMetricsTime();
+    zix_incrementRouterCounter(ZIKRouterCounterURLMatch);
+    ZIKURLRouteResult *result = [self _matchResultForURL:urlString snapshot:snapshot cacheGeneration:generation tokens:tokens];
+    if (result == nil) {
+        zix_incrementRouterCounter(ZIKRouterCounterURLMatchMiss);
+    }
+    zix_recordRouterTiming(ZIKRouterTimingURLMatch, startTime);
+    return result;
+}
+
+- (nullable ZIKURLRouteResult *)_matchResultForURL:(NSString *)urlString snapshot:(NSDictionary<NSString *, ZIKURLRouteNode *> *)snapshot cacheGeneration:(NSUInteger)generation tokens:(ZIKURLTokens *)tokens {
+    BOOL usesCache = __atomic_load_n(&_resultCacheLimit, __ATOMIC_RELAXED) > 0;
+    if (usesCache) {
+        ZIKURLRouteResult *result = [self _cachedResultForURL:urlString];
+        if (result) {
+            zix_incrementRouterCounter(ZIKRouterCounterURLResultCacheHit);
+            return result;
         }
+        zix_incrementRouterCounter(ZIKRouterCounterURLResultCacheMiss);
     }
-    
-    if (!matchedComponents) {
+    NSUInteger length;
+    const char *bytes = _UTF8BytesOfString(urlString, &length);
+    if (!bytes) {
+        return nil;
+    }
+    _tokenizeURL(bytes, length, tokens);
+    ZIKURLRouteNode *matched;
+    ZIKURLRouteNode *root = snapshot[_rootKeyForBytes(bytes, tokens)];
+    if (root) {
+        matched = [self _matchNode:root bytes:bytes tokens:tokens index:0 capturedCount:0 best:nil];
+    }
+    if (!matched) {
         return nil;
     }
-    NSMutableDictionary *parameters = [NSMutableDictionary dictionary];
-    for (int idx = 0; idx < components.count; idx++) {
-        NSString *key = matchedComponents[idx];
-        if ([key hasPrefix:@":"]) {
-            key = [key substringFromIndex:1];
-            NSString *value = components[idx];
-            parameters[key] = value;
+    // Keep ranges of parameters, they are decoded when accessed
+    NSArray<NSString *> *placeholderNames = matched.placeholderNames;
+    NSRange inlineRanges[ZIKURLInlineSegmentCount];
+    NSRange *ranges = placeholderNames.count <= ZIKURLInlineSegmentCount ? inlineRanges : malloc(sizeof(NSRange) * placeholderNames.count);
+    for (NSUInteger idx = 0; idx < placeholderNames.count; idx++) {
+        NSRange segment = tokens->segments[tokens->bestCaptures[idx]];
+        if (matched.capturesWildcard && idx == placeholderNames.count - 1) {
+            // Remaining path from the segment
+            NSRange lastSegment = tokens->segments[tokens->segmentCount - 1];
+            segment = NSMakeRange(segment.location, NSMaxRange(lastSegment) - segment.location);
         }
+        ranges[idx] = segment;
+    }
+    ZIKURLParameterTemplate *parameterTemplate = [[ZIKURLParameterTemplate alloc] initWithPlaceholderNames:placeholderNames ranges:ranges query:tokens->query];
+    if (ranges != inlineRanges) {
+        free(ranges);
+    }
+    ZIKURLRouteResult *result = [ZIKURLRouteResult new];
+    result.urlString = urlString;
+    result.identifier = matched.pattern;
+    result.identifierHandle = matched.patternHandle;
+    result.parameterTemplate = parameterTemplate;
+    if (usesCache) {
+        [self _cacheResultForURL:urlString pattern:matched.pattern patternHandle:matched.patternHandle parameterTemplate:parameterTemplate generation:generation];
     }
-    NSString *pattern = matchedComponents[matchedComponents.count - 2];
-    
-    result = [ZIKURLRouteResult new];
-    result.url = url;
-    result.parameters = parameters;
-    result.identifier = pattern;
     return result;
 }
 
-- (ZIKURLRouteResult *)resultForURL:(NSString *)urlString {
-    NSParameterAssert(urlString);
-    if (!urlString) {
-        return nil;
+#pragma mark Pattern Table
+
+/*
+ Layout of pattern table, all integers are in host byte order:
+ 
+ ZIKURLPatternTableHeader
+ ZIKURLPatternTableNode[nodeCount]
+ ZIKURLPatternTableEdge[edgeCount], children and typed children of nodes, and roots at rootStart with key `scheme://host`. Key of typed child is its type
+ uint32_t[nameCount], string indexes of placeholder names
+ ZIKURLPatternTableString[stringCount]
+ char[stringBytesLength], UTF-8 bytes of strings
+ */
+
+static const uint32_t ZIKURLPatternTableMagic = 0x5A4B5550; // ZKUP
+static const uint32_t ZIKURLPatternTableVersion = 2;
+static const uint32_t ZIKURLPatternTableNone = UINT32_MAX;
+
+typedef struct ZIKURLPatternTableHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t nodeCount;
+    uint32_t edgeCount;
+    uint32_t rootStart;
+    uint32_t rootCount;
+    uint32_t nameCount;
+    uint32_t stringCount;
+    uint32_t stringBytesLength;
+    /// Keep nodes 8-byte aligned.
+    uint32_t reserved;
+} ZIKURLPatternTableHeader;
+
+typedef struct ZIKURLPatternTableNode {
+    uint64_t rank;
+    uint64_t maxRank;
+    uint32_t pattern;
+    uint32_t placeholderChild;
+    uint32_t childStart;
+    uint32_t childCount;
+    uint32_t nameStart;
+    uint32_t nameCount;
+    uint32_t typedChildStart;
+    uint32_t typedChildCount;
+    uint32_t wildcardChild;
+    uint32_t capturesWildcard;
+} ZIKURLPatternTableNode;
+
+typedef struct ZIKURLPatternTableEdge {
+    uint32_t key;
+    uint32_t node;
+} ZIKURLPatternTableEdge;
+
+typedef struct ZIKURLPatternTableString {
+    uint32_t offset;
+    uint32_t length;
+} ZIKURLPatternTableString;
+
+/// Collects strings, nodes and edges when exporting.
+@interface ZIKURLPatternTableWriter : NSObject
+@property(nonatomic, strong) NSMutableData *nodes;
+@property(nonatomic, strong) NSMutableData *edges;
+@property(nonatomic, strong) NSMutableData *names;
+@property(nonatomic, strong) NSMutableData *strings;
+@property(nonatomic, strong) NSMutableData *stringBytes;
+@property(nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *stringIndexes;
+@end
+
+@implementation ZIKURLPatternTableWriter
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _nodes = [NSMutableData data];
+        _edges = [NSMutableData data];
+        _names = [NSMutableData data];
+        _strings = [NSMutableData data];
+        _stringBytes = [NSMutableData data];
+        _stringIndexes = [NSMutableDictionary dictionary];
     }
-    urlString = [urlString stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
-    ZIKURLRouteResult *result;
-    NSURL *url = [NSURL URLWithString:urlString];
-    NSAssert1(url, @"Invalid url: %@", urlString);
-    if (!url) {
-        return nil;
+    return self;
+}
+
+- (uint32_t)indexOfString:(nullable NSString *)string {
+    if (!string) {
+        return ZIKURLPatternTableNone;
     }
-    NSString *identifier;
-    NSInteger placeholderLevel = 0;
-    NSArray<NSString *> *pathComponents = [self pathComponetsForURL:url];
-    NSInteger maxPlaceholderLevel = pathComponents.count;
-    for (placeholderLevel = 0; placeholderLevel <= maxPlaceholderLevel; placeholderLevel++) {
-        identifier = [self _identifierForURL:url placeholderLevel:placeholderLevel];
-        if (identifier) {
-            break;
+    NSNumber *index = _stringIndexes[string];
+    if (index) {
+        return index.unsignedIntValue;
+    }
+    NSData *bytes = [string dataUsingEncoding:NSUTF8StringEncoding];
+    ZIKURLPatternTableString entry = {(uint32_t)_stringBytes.length, (uint32_t)bytes.length};
+    [_stringBytes appendData:bytes];
+    uint32_t newIndex = (uint32_t)(_strings.length / sizeof(ZIKURLPatternTableString));
+    [_strings appendBytes:&entry length:sizeof(entry)];
+    _stringIndexes[string] = @(newIndex);
+    return newIndex;
+}
+
+/// Write node and its subtree, return index of the node.
+- (uint32_t)writeNode:(ZIKURLRouteNode *)node {
+    uint32_t index = (uint32_t)(_nodes.length / sizeof(ZIKURLPatternTableNode));
+    [_nodes increaseLengthBy:sizeof(ZIKURLPatternTableNode)];
+    ZIKURLPatternTableNode entry = {0};
+    entry.rank = node.rank;
+    entry.maxRank = node.maxRank;
+    entry.pattern = [self indexOfString:node.pattern];
+    entry.nameStart = (uint32_t)(_names.length / sizeof(uint32_t));
+    entry.nameCount = (uint32_t)node.placeholderNames.count;
+    for (NSString *name in node.placeholderNames) {
+        uint32_t nameIndex = [self indexOfString:name];
+        [_names appendBytes:&nameIndex length:sizeof(nameIndex)];
+    }
+    entry.capturesWildcard = node.capturesWildcard;
+    entry.placeholderChild = node.placeholderChild ? [self writeNode:node.placeholderChild] : ZIKURLPatternTableNone;
+    entry.wildcardChild = node.wildcardChild ? [self writeNode:node.wildcardChild] : ZIKURLPatternTableNone;
+    entry.childStart = [self writeEdges:node.children];
+    entry.childCount = (uint32_t)node.children.count;
+    entry.typedChildStart = [self writeTypedEdges:node.typedChildren];
+    entry.typedChildCount = (uint32_t)node.typedChildren.count;
+    [_nodes replaceBytesInRange:NSMakeRange(index * sizeof(ZIKURLPatternTableNode), sizeof(entry)) withBytes:&entry];
+    return index;
+}
+
+/// Reserve edges first so edges of a node are continuous, then write subtrees. Return start index of the edges.
+- (uint32_t)writeEdges:(nullable NSDictionary<NSString *, ZIKURLRouteNode *> *)nodes {
+    uint32_t start = (uint32_t)(_edges.length / sizeof(ZIKURLPatternTableEdge));
+    if (nodes.count == 0) {
+        return start;
+    }
+    [_edges increaseLengthBy:sizeof(ZIKURLPatternTableEdge) * nodes.count];
+    __block uint32_t idx = start;
+    [nodes enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull key, ZIKURLRouteNode * _Nonnull node, BOOL * _Nonnull stop) {
+        ZIKURLPatternTableEdge edge = {[self indexOfString:key], [self writeNode:node]};
+        [self.edges replaceBytesInRange:NSMakeRange(idx * sizeof(ZIKURLPatternTableEdge), sizeof(edge)) withBytes:&edge];
+        idx++;
+    }];
+    return start;
+}
+
+- (uint32_t)writeTypedEdges:(nullable NSArray<ZIKURLRouteNode *> *)nodes {
+    uint32_t start = (uint32_t)(_edges.length / sizeof(ZIKURLPatternTableEdge));
+    if (nodes.count == 0) {
+        return start;
+    }
+    [_edges increaseLengthBy:sizeof(ZIKURLPatternTableEdge) * nodes.count];
+    uint32_t idx = start;
+    for (ZIKURLRouteNode *node in nodes) {
+        ZIKURLPatternTableEdge edge = {[self indexOfString:node.matcher.type], [self writeNode:node]};
+        [_edges replaceBytesInRange:NSMakeRange(idx * sizeof(ZIKURLPatternTableEdge), sizeof(edge)) withBytes:&edge];
+        idx++;
+    }
+    return start;
+}
+
+@end
+
+- (NSSet<NSString *> *)allPatterns {
+    dispatch_semaphore_wait(_registrationSema, DISPATCH_TIME_FOREVER);
+    NSSet<NSString *> *patterns = [_registeredPatterns copy];
+    dispatch_semaphore_signal(_registrationSema);
+    return patterns;
+}
+
+- (NSData *)patternTableData {
+    NSDictionary<NSString *, ZIKURLRouteNode *> *snapshot = [self _snapshot];
+    ZIKURLPatternTableWriter *writer = [ZIKURLPatternTableWriter new];
+    uint32_t rootStart = [writer writeEdges:snapshot];
+    
+    ZIKURLPatternTableHeader header = {0};
+    header.magic = ZIKURLPatternTableMagic;
+    header.version = ZIKURLPatternTableVersion;
+    header.nodeCount = (uint32_t)(writer.nodes.length / sizeof(ZIKURLPatternTableNode));
+    header.edgeCount = (uint32_t)(writer.edges.length / sizeof(ZIKURLPatternTableEdge));
+    header.rootStart = rootStart;
+    header.rootCount = (uint32_t)snapshot.count;
+    header.nameCount = (uint32_t)(writer.names.length / sizeof(uint32_t));
+    header.stringCount = (uint32_t)(writer.strings.length / sizeof(ZIKURLPatternTableString));
+    header.stringBytesLength = (uint32_t)writer.stringBytes.length;
+    
+    NSMutableData *data = [NSMutableData dataWithBytes:&header length:sizeof(header)];
+    [data appendData:writer.nodes];
+    [data appendData:writer.edges];
+    [data appendData:writer.names];
+    [data appendData:writer.strings];
+    [data appendData:writer.stringBytes];
+    return data;
+}
+
+- (BOOL)loadPatternTableFromFile:(NSString *)path {
+    NSParameterAssert(path);
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedAlways error:NULL];
+    if (data.length < sizeof(ZIKURLPatternTableHeader)) {
+        return NO;
+    }
+    const uint8_t *bytes = data.bytes;
+    ZIKURLPatternTableHeader header;
+    memcpy(&header, bytes, sizeof(header));
+    if (header.magic != ZIKURLPatternTableMagic || header.version != ZIKURLPatternTableVersion) {
+        return NO;
+    }
+    uint64_t expectedLength = sizeof(header) + (uint64_t)header.nodeCount * sizeof(ZIKURLPatternTableNode) + (uint64_t)header.edgeCount * sizeof(ZIKURLPatternTableEdge) + (uint64_t)header.nameCount * sizeof(uint32_t) + (uint64_t)header.stringCount * sizeof(ZIKURLPatternTableString) + header.stringBytesLength;
+    if (expectedLength != data.length || (uint64_t)header.rootStart + header.rootCount > header.edgeCount) {
+        return NO;
+    }
+    const ZIKURLPatternTableNode *nodes = (const ZIKURLPatternTableNode *)(bytes + sizeof(header));
+    const ZIKURLPatternTableEdge *edges = (const ZIKURLPatternTableEdge *)(nodes + header.nodeCount);
+    const uint32_t *names = (const uint32_t *)(edges + header.edgeCount);
+    const ZIKURLPatternTableString *stringEntries = (const ZIKURLPatternTableString *)(names + header.nameCount);
+    const char *stringBytes = (const char *)(stringEntries + header.stringCount);
+    
+    // Create strings and nodes in table order, children are validated before being linked
+    NSMutableArray<NSString *> *strings = [NSMutableArray arrayWithCapacity:header.stringCount];
+    for (uint32_t idx = 0; idx < header.stringCount; idx++) {
+        ZIKURLPatternTableString entry = stringEntries[idx];
+        if ((uint64_t)entry.offset + entry.length > header.stringBytesLength) {
+            return NO;
+        }
+        NSString *string = [[NSString alloc] initWithBytes:stringBytes + entry.offset length:entry.length encoding:NSUTF8StringEncoding];
+        if (!string) {
+            return NO;
         }
+        [strings addObject:string];
     }
-    if (!identifier) {
-        return [self resultForURLWithDiscontinuousPlaceHolders:url];
-    }
-    result = [ZIKURLRouteResult new];
-    result.url = url;
-    result.identifier = identifier;
-    NSMutableDictionary *parameters = [NSMutableDictionary dictionary];
-    if (placeholderLevel > 0) {
-        NSArray<NSString *> *patternPathComponents = [self pathComponetsForURL:[NSURL URLWithString:identifier]];
-        if (pathComponents && patternPathComponents && pathComponents.count == patternPathComponents.count && patternPathComponents.count >= placeholderLevel) {
-            NSInteger idx = patternPathComponents.count - 1;
-            NSInteger parameterCount = placeholderLevel;
-            while (parameterCount-- > 0) {
-                NSString *key = [patternPathComponents[idx] stringByReplacingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
-                if ([key hasPrefix:@":"]) {
-                    key = [key substringFromIndex:1];
+    NSMutableArray<ZIKURLRouteNode *> *routeNodes = [NSMutableArray arrayWithCapacity:header.nodeCount];
+    for (uint32_t idx = 0; idx < header.nodeCount; idx++) {
+        [routeNodes addObject:[ZIKURLRouteNode new]];
+    }
+    NSMutableSet<NSString *> *patterns = [NSMutableSet set];
+    for (uint32_t idx = 0; idx < header.nodeCount; idx++) {
+        ZIKURLPatternTableNode entry = nodes[idx];
+        ZIKURLRouteNode *node = routeNodes[idx];
+        node.rank = entry.rank;
+        node.maxRank = entry.maxRank;
+        node.capturesWildcard = entry.capturesWildcard != 0;
+        if (entry.pattern != ZIKURLPatternTableNone) {
+            if (entry.pattern >= header.stringCount || (uint64_t)entry.nameStart + entry.nameCount > header.nameCount) {
+                return NO;
+            }
+            node.pattern = strings[entry.pattern];
+            node.patternHandle = zix_internRouteIdentifier(node.pattern);
+            [patterns addObject:node.pattern];
+            NSMutableArray<NSString *> *placeholderNames = [NSMutableArray arrayWithCapacity:entry.nameCount];
+            for (uint32_t nameIdx = entry.nameStart; nameIdx < entry.nameStart + entry.nameCount; nameIdx++) {
+                if (names[nameIdx] >= header.stringCount) {
+                    return NO;
                 }
-                parameters[key] = [pathComponents[idx] stringByReplacingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
-                idx--;
+                [placeholderNames addObject:strings[names[nameIdx]]];
             }
+            node.placeholderNames = placeholderNames;
+        }
+        // Nodes are written before their subtrees, so a valid child always has a larger index, and there is no cycle
+        if (entry.placeholderChild != ZIKURLPatternTableNone) {
+            if (entry.placeholderChild <= idx || entry.placeholderChild >= header.nodeCount) {
+                return NO;
+            }
+            node.placeholderChild = routeNodes[entry.placeholderChild];
+        }
+        if (entry.wildcardChild != ZIKURLPatternTableNone) {
+            if (entry.wildcardChild <= idx || entry.wildcardChild >= header.nodeCount) {
+                return NO;
+            }
+            node.wildcardChild = routeNodes[entry.wildcardChild];
+        }
+        if (entry.typedChildCount > 0) {
+            if ((uint64_t)entry.typedChildStart + entry.typedChildCount > header.edgeCount) {
+                return NO;
+            }
+            NSMutableArray<ZIKURLRouteNode *> *typedChildren = [NSMutableArray arrayWithCapacity:entry.typedChildCount];
+            for (uint32_t edgeIdx = entry.typedChildStart; edgeIdx < entry.typedChildStart + entry.typedChildCount; edgeIdx++) {
+                ZIKURLPatternTableEdge edge = edges[edgeIdx];
+                if (edge.key >= header.stringCount || edge.node <= idx || edge.node >= header.nodeCount) {
+                    return NO;
+                }
+                ZIKURLSegmentMatcher *matcher = [[ZIKURLSegmentMatcher alloc] initWithType:strings[edge.key]];
+                if (!matcher) {
+                    return NO;
+                }
+                routeNodes[edge.node].matcher = matcher;
+                [typedChildren addObject:routeNodes[edge.node]];
+            }
+            node.typedChildren = typedChildren;
+        }
+        if (entry.childCount > 0) {
+            if ((uint64_t)entry.childStart + entry.childCount > header.edgeCount) {
+                return NO;
+            }
+            NSMutableDictionary<NSString *, ZIKURLRouteNode *> *children = [NSMutableDictionary dictionaryWithCapacity:entry.childCount];
+            for (uint32_t edgeIdx = entry.childStart; edgeIdx < entry.childStart + entry.childCount; edgeIdx++) {
+                ZIKURLPatternTableEdge edge = edges[edgeIdx];
+                if (edge.key >= header.stringCount || edge.node <= idx || edge.node >= header.nodeCount) {
+                    return NO;
+                }
+                children[strings[edge.key]] = routeNodes[edge.node];
+            }
+            node.children = children;
         }
-        result.parameters = parameters;
     }
-    NSString *query = url.query;
-    if (query) {
-        [[NSURLComponents componentsWithURL:url resolvingAgainstBaseURL:NO].queryItems
-         enumerateObjectsUsingBlock:^(NSURLQueryItem * _Nonnull item, NSUInteger idx, BOOL * _Nonnull stop) {
-            parameters[[item.name stringByReplacingPercentEscapesUsingEncoding:NSUTF8StringEncoding]] = [item.value stringByReplacingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
-        }];
+    NSMutableDictionary<NSString *, ZIKURLRouteNode *> *trie = [NSMutableDictionary dictionaryWithCapacity:header.rootCount];
+    for (uint32_t edgeIdx = header.rootStart; edgeIdx < header.rootStart + header.rootCount; edgeIdx++) {
+        ZIKURLPatternTableEdge edge = edges[edgeIdx];
+        if (edge.key >= header.stringCount || edge.node >= header.nodeCount) {
+            return NO;
+        }
+        trie[strings[edge.key]] = routeNodes[edge.node];
     }
-    result.parameters = parameters;
-    return result;
+    
+    dispatch_semaphore_wait(_registrationSema, DISPATCH_TIME_FOREVER);
+    if (_patternTrie.count > 0) {
+        dispatch_semaphore_signal(_registrationSema);
+        NSAssert(NO, @"Pattern table should be loaded before registering any pattern.");
+        return NO;
+    }
+    _patternTrie = trie;
+    [_registeredPatterns unionSet:patterns];
+    __atomic_store_n(&_snapshotOutdated, true, __ATOMIC_RELEASE);
+    dispatch_semaphore_signal(_registrationSema);
+    dispatch_semaphore_wait(_cacheSema, DISPATCH_TIME_FOREVER);
+    [self _clearResultCache];
+    [self _clearPrewarmedResults];
+    dispatch_semaphore_signal(_cacheSema);
+    return YES;
 }
 
-- (NSString *)_identifierForURL:(NSURL *)url placeholderLevel:(NSInteger)level {
-    NSInteger placeholderLevel = level;
-    while (level > 0) {
-        url = url.URLByDeletingLastPathComponent;
-        level--;
+#pragma mark Result Cache
+
+- (void)setResultCacheLimit:(NSUInteger)resultCacheLimit {
+    dispatch_semaphore_wait(_cacheSema, DISPATCH_TIME_FOREVER);
+    __atomic_store_n(&_resultCacheLimit, resultCacheLimit, __ATOMIC_RELAXED);
+    if (resultCacheLimit == 0) {
+        [self _clearResultCache];
     }
-    NSMutableArray *components = [@[(url.scheme ?: @""), @"://", (url.host ?: @"")] mutableCopy];
-    for (NSString *pathComponent in [self pathComponetsForURL:url]) {
-        [components addObject:@"/"];
-        [components addObject:pathComponent];
+    while (_resultCache.count > resultCacheLimit) {
+        [self _removeCacheEntry:_cacheTail];
     }
-    for (int i = 0; i < placeholderLevel; i++) {
-        [components addObject:@"/"];
-        [components addObject:kPlaceholderComponent];
+    dispatch_semaphore_signal(_cacheSema);
+}
+
+- (NSUInteger)_currentCacheGeneration {
+    if (__atomic_load_n(&_resultCacheLimit, __ATOMIC_RELAXED) == 0) {
+        return 0;
     }
-    NSString *key = [components componentsJoinedByString:@""];
-    return _patternContainer[key];
+    dispatch_semaphore_wait(_cacheSema, DISPATCH_TIME_FOREVER);
+    NSUInteger generation = _cacheGeneration;
+    dispatch_semaphore_signal(_cacheSema);
+    return generation;
 }
 
-- (NSMutableArray<NSString *> *)pathComponetsForURL:(NSURL *)url {
-    NSString *path = url.path;
-    if (!path || path.length == 0) {
+/// Must be called with cacheSema.
+- (void)_registerCacheTrimmerIfNeeded {
+    if (_registeredCacheTrimmer) {
+        return;
+    }
+    _registeredCacheTrimmer = YES;
+    __weak typeof(self) weakSelf = self;
+    zix_registerCacheTrimmer(ZIKRouteCachePriorityLow, ^{
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf) {
+            return;
+        }
+        dispatch_semaphore_wait(strongSelf.cacheSema, DISPATCH_TIME_FOREVER);
+        [strongSelf _clearResultCache];
+        [strongSelf _clearPrewarmedResults];
+        dispatch_semaphore_signal(strongSelf.cacheSema);
+    });
+}
+
+/// Must be called with cacheSema.
+- (void)_clearResultCache {
+    _resultCache = nil;
+    _cacheHead = nil;
+    _cacheTail = nil;
+    _cacheGeneration++;
+}
+
+/// Must be called with cacheSema.
+- (void)_clearPrewarmedResults {
+    _prewarmedResults = nil;
+    _prewarmedURLs = nil;
+    __atomic_store_n(&_prewarmedCount, 0, __ATOMIC_RELEASE);
+}
+
+- (void)storePrewarmedResult:(ZIKURLRouteResult *)result {
+    NSString *urlString = result.urlString;
+    NSParameterAssert(urlString);
+    if (!urlString) {
+        return;
+    }
+    dispatch_semaphore_wait(_cacheSema, DISPATCH_TIME_FOREVER);
+    if (!_prewarmedResults) {
+        _prewarmedResults = [NSMutableDictionary dictionary];
+        _prewarmedURLs = [NSMutableArray array];
+        [self _registerCacheTrimmerIfNeeded];
+    }
+    [_prewarmedURLs removeObject:urlString];
+    [_prewarmedURLs addObject:urlString];
+    _prewarmedResults[urlString] = result;
+    while (_prewarmedURLs.count > ZIKURLPrewarmedResultLimit) {
+        [_prewarmedResults removeObjectForKey:_prewarmedURLs.firstObject];
+        [_prewarmedURLs removeObjectAtIndex:0];
+    }
+    __atomic_store_n(&_prewarmedCount, _prewarmedURLs.count, __ATOMIC_RELEASE);
+    dispatch_semaphore_signal(_cacheSema);
+}
+
+- (nullable ZIKURLRouteResult *)takePrewarmedResultForURL:(NSString *)urlString {
+    if (!urlString || __atomic_load_n(&_prewarmedCount, __ATOMIC_ACQUIRE) == 0) {
         return nil;
     }
-    NSArray *pathComponents = url.pathComponents;
-    NSMutableArray *components;
-    if (pathComponents.count > 0) {
-        components = [NSMutableArray array];
-        for (NSString *pathComponent in pathComponents) {
-            if ([pathComponent isEqualToString:@"/"]) {
-                continue;
+    dispatch_semaphore_wait(_cacheSema, DISPATCH_TIME_FOREVER);
+    ZIKURLRouteResult *result = _prewarmedResults[urlString];
+    if (result) {
+        [_prewarmedResults removeObjectForKey:urlString];
+        [_prewarmedURLs removeObject:urlString];
+        __atomic_store_n(&_prewarmedCount, _prewarmedURLs.count, __ATOMIC_RELEASE);
+    }
+    dispatch_semaphore_signal(_cacheSema);
+    return result;
+}
+
+- (nullable ZIKURLRouteResult *)_cachedResultForURL:(NSString *)urlString {
+    ZIKURLRouteResult *result;
+    dispatch_semaphore_wait(_cacheSema, DISPATCH_TIME_FOREVER);
+    ZIKURLRouteCacheEntry *entry = _resultCache[urlString];
+    if (entry) {
+        [self _moveCacheEntryToHead:entry];
+        result = [ZIKURLRouteResult new];
+        result.urlString = urlString;
+        result.identifier = entry.pattern;
+        result.identifierHandle = entry.patternHandle;
+        result.parameterTemplate = entry.parameterTemplate;
+    }
+    dispatch_semaphore_signal(_cacheSema);
+    return result;
+}
+
+- (void)_cacheResultForURL:(NSString *)urlString pattern:(NSString *)pattern patternHandle:(ZIKRouteIdentifierHandle)patternHandle parameterTemplate:(ZIKURLParameterTemplate *)parameterTemplate generation:(NSUInteger)generation {
+    dispatch_semaphore_wait(_cacheSema, DISPATCH_TIME_FOREVER);
+    if (generation != _cacheGeneration || _resultCacheLimit == 0) {
+        dispatch_semaphore_signal(_cacheSema);
+        return;
+    }
+    if (!_resultCache) {
+        _resultCache = [NSMutableDictionary dictionary];
+        [self _registerCacheTrimmerIfNeeded];
+    }
+    // Another thread may cache the same url
+    [self _removeCacheEntry:_resultCache[urlString]];
+    ZIKURLRouteCacheEntry *entry = [ZIKURLRouteCacheEntry new];
+    entry.urlString = urlString;
+    entry.pattern = pattern;
+    entry.patternHandle = patternHandle;
+    entry.parameterTemplate = parameterTemplate;
+    _resultCache[entry.urlString] = entry;
+    [self _insertCacheEntryAtHead:entry];
+    if (_resultCache.count > _resultCacheLimit) {
+        [self _removeCacheEntry:_cacheTail];
+    }
+    dispatch_semaphore_signal(_cacheSema);
+}
+
+- (void)_insertCacheEntryAtHead:(ZIKURLRouteCacheEntry *)entry {
+    entry.previous = nil;
+    entry.next = _cacheHead;
+    _cacheHead.previous = entry;
+    _cacheHead = entry;
+    if (!_cacheTail) {
+        _cacheTail = entry;
+    }
+}
+
+- (void)_unlinkCacheEntry:(ZIKURLRouteCacheEntry *)entry {
+    ZIKURLRouteCacheEntry *previous = entry.previous;
+    ZIKURLRouteCacheEntry *next = entry.next;
+    // Clear links before relinking, entry may be released by previous.next
+    entry.previous = nil;
+    entry.next = nil;
+    if (previous) {
+        previous.next = next;
+    } else {
+        _cacheHead = next;
+    }
+    if (next) {
+        next.previous = previous;
+    } else {
+        _cacheTail = previous;
+    }
+}
+
+- (void)_moveCacheEntryToHead:(ZIKURLRouteCacheEntry *)entry {
+    if (entry == _cacheHead) {
+        return;
+    }
+    [self _unlinkCacheEntry:entry];
+    [self _insertCacheEntryAtHead:entry];
+}
+
+- (void)_removeCacheEntry:(ZIKURLRouteCacheEntry *)entry {
+    if (!entry) {
+        return;
+    }
+    [self _unlinkCacheEntry:entry];
+    [_resultCache removeObjectForKey:entry.urlString];
+}
+
+@end
+
+@implementation ZIKURLParameterTemplate {
+    NSArray<NSString *> *_placeholderNames;
+    NSRange *_ranges;
+    NSRange _query;
+}
+
+- (instancetype)initWithPlaceholderNames:(NSArray<NSString *> *)placeholderNames ranges:(const NSRange *)ranges query:(NSRange)query {
+    if (self = [super init]) {
+        _placeholderNames = [placeholderNames copy];
+        if (placeholderNames.count > 0) {
+            _ranges = malloc(sizeof(NSRange) * placeholderNames.count);
+            memcpy(_ranges, ranges, sizeof(NSRange) * placeholderNames.count);
+        }
+        _query = query;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_ranges);
+}
+
+- (NSMutableDictionary<NSString *, NSString *> *)parametersForURLString:(NSString *)urlString {
+    NSMutableDictionary<NSString *, NSString *> *parameters = [NSMutableDictionary dictionary];
+    NSUInteger length;
+    const char *bytes = _UTF8BytesOfString(urlString, &length);
+    if (!bytes) {
+        return parameters;
+    }
+    for (NSUInteger idx = 0; idx < _placeholderNames.count; idx++) {
+        if (NSMaxRange(_ranges[idx]) <= length) {
+            parameters[_placeholderNames[idx]] = _decodedString(bytes, _ranges[idx]);
+        }
+    }
+    if (_query.location != NSNotFound && NSMaxRange(_query) <= length) {
+        [self _addQueryItemsFromBytes:bytes range:_query toParameters:parameters];
+    }
+    return parameters;
+}
+
+/// Parse `k=v&k2=v2`. Item without `=` has no value and is ignored. Delimiters and escapes are found in one pass, so names and values without escapes are not searched again when decoding.
+- (void)_addQueryItemsFromBytes:(const char *)bytes range:(NSRange)range toParameters:(NSMutableDictionary *)parameters {
+    NSUInteger end = NSMaxRange(range);
+    NSUInteger itemStart = range.location;
+    NSUInteger separator = NSNotFound;
+    BOOL nameEscaped = NO;
+    BOOL valueEscaped = NO;
+    for (NSUInteger pos = range.location; pos <= end; pos++) {
+        pos = _nextDelimiter(bytes, pos, end, '&', '=', '%', '%');
+        if (pos == end || bytes[pos] == '&') {
+            if (separator != NSNotFound) {
+                NSString *name = _stringFromBytes(bytes, NSMakeRange(itemStart, separator - itemStart), nameEscaped);
+                parameters[name] = _stringFromBytes(bytes, NSMakeRange(separator + 1, pos - separator - 1), valueEscaped);
+            }
+            itemStart = pos + 1;
+            separator = NSNotFound;
+            nameEscaped = NO;
+            valueEscaped = NO;
+        } else if (bytes[pos] == '%') {
+            if (separator == NSNotFound) {
+                nameEscaped = YES;
+            } else {
+                valueEscaped = YES;
             }
-            [components addObject:pathComponent];
+        } else if (separator == NSNotFound) {
+            separator = pos;
         }
     }
-    return components;
 }
 
 @end
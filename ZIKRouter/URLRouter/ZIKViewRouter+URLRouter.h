@@ -50,6 +50,22 @@ FOUNDATION_EXTERN ZIKURLRouteKey ZIKURLRouteKeyTransitionTypeAddAsSubview;
  */
 + (void)registerURLPattern:(NSString *)pattern;
 
+/**
+ Replace URL patterns of this router with the patterns at once, such as patterns from remote config. Patterns of other routers are kept. Patterns are compiled on current thread and registering patterns waits for it, so call it on a background queue. Resolving urls in progress keeps using the old patterns, and resolving doesn't take lock for the swap.
+ 
+ Patterns must be identifiers of this router, such as patterns registered with +registerURLPattern: at launch, other patterns are ignored.
+ */
++ (void)replaceURLPatterns:(NSArray<NSString *> *)patterns;
+
+/// Max count of urls whose matched results are cached, so `+routeFromURL:` skips matching for repeated urls such as urls from push notifications. Least recently used url is removed when exceeding. Default is 0 and cache is disabled. Cache is cleared when a pattern is registered.
+@property (nonatomic, class) NSUInteger URLResultCacheLimit;
+
+/// Compiled URL patterns in binary format. Write it to a file after all patterns are registered, and load it with +loadURLPatternTableFromFile: at next launch.
++ (nullable NSData *)URLPatternTableData;
+
+/// Load URL patterns from the file written with data from +URLPatternTableData, so only new patterns are compiled in +registerURLPattern:. Call it before registering any URL pattern, such as in main(). Discard the file when routes change.
++ (BOOL)loadURLPatternTableFromFile:(NSString *)path;
+
 /// Perform route for the url. It will search router and get parameters with `+routeFromURL:`, then perform route with the path.
 + (nullable ZIKViewRouter<Destination, RouteConfig> *)performURL:(NSString *)url path:(ZIKViewRoutePath *)path;
 
@@ -59,6 +75,21 @@ FOUNDATION_EXTERN ZIKURLRouteKey ZIKURLRouteKeyTransitionTypeAddAsSubview;
 /// Get router for identifier from URL.
 + (nullable ZIKViewRouterType<Destination, RouteConfig> *)routerForURL:(NSString *)url;
 
+/// Get routers for many urls in one pass. Key is the url, urls without router are not in the result.
++ (NSDictionary<NSString *, ZIKViewRouterType<Destination, RouteConfig> *> *)routersForURLs:(NSArray<NSString *> *)urls;
+
+/**
+ Resolve router and parameters of the url ahead of time, such as for the url in a push notification before user taps it. Next `+performURL:fromSource:` or `+performURL:path:` with the same url skips matching, router lookup and parameters decoding. Only last 4 prewarmed urls are kept, and each is used once.
+ 
+ @param url The url to perform later.
+ @param prebuildsDestination Also create the destination with `+prewarmDestinationForKey:configuring:`, with the url as the key. It must be on main thread when it's YES. Destination of block route is not prebuilt.
+ @return NO when there is no router for the url.
+ */
++ (BOOL)prewarmURL:(NSString *)url prebuildsDestination:(BOOL)prebuildsDestination;
+
+/// Prewarm the url without creating destination.
++ (BOOL)prewarmURL:(NSString *)url;
+
 /// Perform route for the url. It will search router and get userInfo with `+routeFromURL:`, then perform route with path from `+pathForTransitionType:source:`.
 #if ZIK_HAS_UIKIT
 + (nullable ZIKViewRouter<Destination, RouteConfig> *)performURL:(NSString *)url fromSource:(UIViewController *)source;
@@ -73,6 +104,38 @@ FOUNDATION_EXTERN ZIKURLRouteKey ZIKURLRouteKeyTransitionTypeAddAsSubview;
 + (nullable ZIKViewRouter<Destination, RouteConfig> *)performURL:(NSString *)url fromSource:(NSViewController *)source completion:(void(^)(BOOL success, Destination _Nullable destination, ZIKRouteAction routeAction, NSError *_Nullable error))performerCompletion;
 #endif
 
+/**
+ Perform route for the url without blocking main thread for resolving. The url is matched and its parameters are decoded on a background queue, then route is performed with path from `+pathForTransitionType:source:` on main thread.
+ 
+ @discussion
+ Router is also fetched on the background queue when `ZIKRouteRegistry.freezesRegistration` is YES and registration is finished, otherwise it's fetched on main thread. Configuration is still built on main thread, because routers may use UI in their configuring. Completion is called on main thread, with ZIKViewRouteErrorInvalidSource if source is released before performing.
+ */
+#if ZIK_HAS_UIKIT
++ (void)performURLResolvingInBackground:(NSString *)url fromSource:(UIViewController *)source completion:(void(^ _Nullable)(BOOL success, Destination _Nullable destination, ZIKRouteAction routeAction, NSError *_Nullable error))performerCompletion;
+#else
++ (void)performURLResolvingInBackground:(NSString *)url fromSource:(NSViewController *)source completion:(void(^ _Nullable)(BOOL success, Destination _Nullable destination, ZIKRouteAction routeAction, NSError *_Nullable error))performerCompletion;
+#endif
+
+/**
+ Enqueue the url and perform it with `+performURL:fromSource:completion:` on main thread later. Use it for urls arriving in a burst, such as opening app from a notification while another link is still performing.
+ 
+ @discussion
+ Queued urls are coalesced:
+ 
+ 1. A pending url resolving to the same router identifier is replaced by the newer one.
+ 
+ 2. A pending url whose source is already released is dropped.
+ 
+ 3. At most one url is performed in a runloop turn, and the next url is performed after the previous transition finished.
+ 
+ Completion of a dropped url is called with ZIKRouteErrorActionFailed.
+ */
+#if ZIK_HAS_UIKIT
++ (void)enqueueURL:(NSString *)url fromSource:(UIViewController *)source completion:(void(^ _Nullable)(BOOL success, Destination _Nullable destination, ZIKRouteAction routeAction, NSError *_Nullable error))performerCompletion;
+#else
++ (void)enqueueURL:(NSString *)url fromSource:(NSViewController *)source completion:(void(^ _Nullable)(BOOL success, Destination _Nullable destination, ZIKRouteAction routeAction, NSError *_Nullable error))performerCompletion;
+#endif
+
 /// Generate view route path from URL.
 #if ZIK_HAS_UIKIT
 + (ZIKViewRoutePath *)pathForTransitionType:(NSString *)type source:(UIViewController *)source;
@@ -8,8 +8,12 @@
 
 #import "ZIKViewRouter+URLRouter.h"
 #import "ZIKViewRouterInternal.h"
+#import "ZIKViewRouteRegistry.h"
+#import "ZIKRouteRegistryInternal.h"
 #import "ZIKURLRouter.h"
+#import "ZIKURLRouteResultInternal.h"
 #import "ZIKClassCapabilities.h"
+#import "ZIKRouterRuntime.h"
 
 ZIKURLRouteKey ZIKURLRouteKeyTransitionType = @"transition";
 static ZIKURLRouter *_viewURLRouter;
@@ -23,34 +27,183 @@ static void _createURLRouter() {
     });
 }
 
+/// Url waiting in the performing queue.
+@interface ZIKQueuedURL : NSObject
+@property (nonatomic, copy) NSString *url;
+@property (nonatomic, copy) NSString *identifier;
+@property (nonatomic, weak) XXViewController *source;
+@property (nonatomic, strong) Class routerClass;
+@property (nonatomic, copy, nullable) void(^completion)(BOOL success, id _Nullable destination, ZIKRouteAction routeAction, NSError *_Nullable error);
+@end
+
+@implementation ZIKQueuedURL
+@end
+
+// States of the performing queue, only accessed on main thread
+static NSMutableArray<ZIKQueuedURL *> *_queuedURLs;
+static BOOL _performingQueuedURL = NO;
+static BOOL _queuedURLPerformingScheduled = NO;
+
+static void _performNextQueuedURL(void);
+
+static void _failQueuedURL(ZIKQueuedURL *queuedURL, NSString *reason) {
+    if (queuedURL.completion) {
+        NSError *error = [ZIKViewRouter errorWithCode:ZIKRouteErrorActionFailed localizedDescriptionFormat:@"Queued url (%@) is dropped: %@", queuedURL.url, reason];
+        queuedURL.completion(NO, nil, ZIKRouteActionPerformRoute, error);
+    }
+}
+
+/// Perform in next runloop turn, so only one transition begins in a frame.
+static void _schedulePerformingQueuedURL(void) {
+    if (_queuedURLPerformingScheduled || _performingQueuedURL || _queuedURLs.count == 0) {
+        return;
+    }
+    _queuedURLPerformingScheduled = YES;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        _queuedURLPerformingScheduled = NO;
+        _performNextQueuedURL();
+    });
+}
+
+static void _performNextQueuedURL(void) {
+    while (_queuedURLs.count > 0 && !_performingQueuedURL) {
+        ZIKQueuedURL *queuedURL = _queuedURLs.firstObject;
+        [_queuedURLs removeObjectAtIndex:0];
+        XXViewController *source = queuedURL.source;
+        if (!source) {
+            _failQueuedURL(queuedURL, @"source is released.");
+            continue;
+        }
+        _performingQueuedURL = YES;
+        [queuedURL.routerClass performURL:queuedURL.url fromSource:source completion:^(BOOL success, id  _Nullable destination, ZIKRouteAction  _Nonnull routeAction, NSError * _Nullable error) {
+            _performingQueuedURL = NO;
+            if (queuedURL.completion) {
+                queuedURL.completion(success, destination, routeAction, error);
+            }
+            _schedulePerformingQueuedURL();
+        }];
+    }
+}
+
+/// Results from URL router have handle of the matched pattern, results from overridden +routeFromURL: may only have identifier.
+static ZIKViewRouterType *_Nullable _routerTypeForURLResult(ZIKURLRouteResult *result) {
+    if (result.identifierHandle != 0) {
+        return _ZIKViewRouterToIdentifierHandle(result.identifierHandle);
+    }
+    return _ZIKViewRouterToIdentifier(result.identifier);
+}
+
+/// Prewarmed result for the url, nil when it's not prewarmed or routes changed after prewarming.
+static ZIKURLRouteResult *_Nullable _takePrewarmedResult(NSString *url) {
+    ZIKURLRouteResult *result = [_viewURLRouter takePrewarmedResultForURL:url];
+    if (result && result.prewarmedRoutesGeneration != [ZIKRouteRegistry routesGeneration]) {
+        return nil;
+    }
+    return result;
+}
+
 @implementation ZIKViewRouter (URLRouter)
 
++ (void)enqueueURL:(NSString *)url fromSource:(XXViewController *)source completion:(void(^)(BOOL success, id _Nullable destination, ZIKRouteAction routeAction, NSError *_Nullable error))performerCompletion {
+    NSParameterAssert(url);
+    if (!url) {
+        return;
+    }
+    if (![NSThread isMainThread]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self enqueueURL:url fromSource:source completion:performerCompletion];
+        });
+        return;
+    }
+    ZIKQueuedURL *queuedURL = [ZIKQueuedURL new];
+    queuedURL.url = url;
+    queuedURL.identifier = [self routeFromURL:url].identifier ?: url;
+    queuedURL.source = source;
+    queuedURL.routerClass = self;
+    queuedURL.completion = performerCompletion;
+    if (!_queuedURLs) {
+        _queuedURLs = [NSMutableArray array];
+    }
+    NSUInteger idx = [_queuedURLs indexOfObjectPassingTest:^BOOL(ZIKQueuedURL * _Nonnull obj, NSUInteger idx, BOOL * _Nonnull stop) {
+        return [obj.identifier isEqualToString:queuedURL.identifier];
+    }];
+    if (idx != NSNotFound) {
+        ZIKQueuedURL *replaced = _queuedURLs[idx];
+        [_queuedURLs replaceObjectAtIndex:idx withObject:queuedURL];
+        _failQueuedURL(replaced, [NSString stringWithFormat:@"replaced by newer url (%@) with same router.", url]);
+    } else {
+        [_queuedURLs addObject:queuedURL];
+    }
+    _schedulePerformingQueuedURL();
+}
+
 + (void)registerURLPattern:(NSString *)pattern {
     _createURLRouter();
     [_viewURLRouter registerURLPattern:pattern];
+    [ZIKViewRouteRegistry markDynamicRegistration];
     [self registerIdentifier:pattern];
 }
 
++ (void)replaceURLPatterns:(NSArray<NSString *> *)patterns {
+    _createURLRouter();
+    Class routerClass = self;
+    // Only patterns routing to this router are replaced
+    [_viewURLRouter replacePatterns:patterns passingTest:^BOOL(NSString *pattern) {
+        return _ZIKViewRouterToIdentifier(pattern).routeObject == routerClass;
+    }];
+}
+
++ (NSUInteger)URLResultCacheLimit {
+    _createURLRouter();
+    return _viewURLRouter.resultCacheLimit;
+}
+
++ (void)setURLResultCacheLimit:(NSUInteger)URLResultCacheLimit {
+    _createURLRouter();
+    _viewURLRouter.resultCacheLimit = URLResultCacheLimit;
+}
+
++ (NSData *)URLPatternTableData {
+    return [_viewURLRouter patternTableData];
+}
+
++ (BOOL)loadURLPatternTableFromFile:(NSString *)path {
+    _createURLRouter();
+    return [_viewURLRouter loadPatternTableFromFile:path];
+}
+
 + (ZIKURLRouteResult *)routeFromURL:(NSString *)url {
+    _createURLRouter();
     ZIKURLRouteResult *result = [_viewURLRouter resultForURL:url];
     if (!result) {
         return nil;
     }
     NSMutableDictionary *userInfo = [NSMutableDictionary dictionary];
     userInfo[ZIKURLRouteKeyOriginURL] = [NSURL URLWithString:url];
-    if (result.parameters) {
-        [userInfo addEntriesFromDictionary:result.parameters];
-    }
-    result.parameters = userInfo;
+    // Parameters are decoded only when they are used
+    result.baseParameters = userInfo;
     return result;
 }
 
 + (ZIKViewRouterType *)routerForURL:(NSString *)url {
-    NSString *identifier = [self routeFromURL:url].identifier;
-    if (!identifier) {
+    ZIKURLRouteResult *result = [self routeFromURL:url];
+    if (!result.identifier) {
         return nil;
     }
-    return _ZIKViewRouterToIdentifier(identifier);
+    return _routerTypeForURLResult(result);
+}
+
++ (NSDictionary<NSString *, ZIKViewRouterType *> *)routersForURLs:(NSArray<NSString *> *)urls {
+    _createURLRouter();
+    NSDictionary<NSString *, ZIKURLRouteResult *> *results = [_viewURLRouter resultsForURLs:urls];
+    NSMutableDictionary<NSString *, ZIKViewRouterType *> *routers = [NSMutableDictionary dictionaryWithCapacity:results.count];
+    [results enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull url, ZIKURLRouteResult * _Nonnull result, BOOL * _Nonnull stop) {
+        ZIKViewRouterType *router = _routerTypeForURLResult(result);
+        if (router) {
+            routers[url] = router;
+        }
+    }];
+    return routers;
 }
 
 + (ZIKViewRoutePath *)pathForTransitionType:(NSString *)type source:(XXViewController *)source {
@@ -90,6 +243,36 @@ static void _createURLRouter() {
     return path;
 }
 
++ (BOOL)prewarmURL:(NSString *)url {
+    return [self prewarmURL:url prebuildsDestination:NO];
+}
+
++ (BOOL)prewarmURL:(NSString *)url prebuildsDestination:(BOOL)prebuildsDestination {
+    ZIKURLRouteResult *result = [self routeFromURL:url];
+    if (!result.identifier) {
+        return NO;
+    }
+    ZIKViewRouterType *routerType = _routerTypeForURLResult(result);
+    if (!routerType) {
+        return NO;
+    }
+    // Decode parameters now
+    NSDictionary *userInfo = result.parameters;
+    result.prewarmedRouterType = routerType;
+    result.prewarmedRoutesGeneration = [ZIKRouteRegistry routesGeneration];
+    // Router of block route can't prewarm destination
+    Class routerClass = routerType.routerClass;
+    if (prebuildsDestination && routerClass) {
+        NSAssert([NSThread isMainThread], @"Destination of view router should be prebuilt on main thread.");
+        [routerClass prewarmDestinationForKey:url configuring:^(ZIKViewRouteConfiguration * _Nonnull config) {
+            [config addUserInfo:userInfo];
+        }];
+        result.prewarmKey = url;
+    }
+    [_viewURLRouter storePrewarmedResult:result];
+    return YES;
+}
+
 + (ZIKViewRouter *)performURL:(NSString *)url fromSource:(XXViewController *)source {
     return [self performURL:url fromSource:source completion:^(BOOL success, id  _Nullable destination, ZIKRouteAction routeAction, NSError * _Nullable error) {
         
@@ -97,7 +280,7 @@ static void _createURLRouter() {
 }
 
 + (ZIKViewRouter *)performURL:(NSString *)url fromSource:(XXViewController *)source completion:(void(^)(BOOL success, id _Nullable destination, ZIKRouteAction routeAction, NSError *_Nullable error))performerCompletion {
-    ZIKURLRouteResult *result = [self routeFromURL:url];
+    ZIKURLRouteResult *result = _takePrewarmedResult(url) ?: [self routeFromURL:url];
     NSString *identifier = result.identifier;
     if (!identifier) {
         if (performerCompletion) {
@@ -106,7 +289,7 @@ static void _createURLRouter() {
         }
         return nil;
     }
-    ZIKViewRouterType *routerType = _ZIKViewRouterToIdentifier(identifier);
+    ZIKViewRouterType *routerType = result.prewarmedRouterType ?: _routerTypeForURLResult(result);
     if (!routerType) {
         if (performerCompletion) {
             NSError *error = [ZIKViewRouter errorWithCode:ZIKRouteErrorInvalidConfiguration localizedDescriptionFormat:@"Can't find router with identifier (%@) from url: %@", identifier, url];
@@ -115,7 +298,57 @@ static void _createURLRouter() {
         }
         return nil;
     }
-    NSDictionary *userInfo = result.parameters;
+    return [self performRouterType:routerType userInfo:result.parameters prewarmKey:result.prewarmKey fromSource:source completion:performerCompletion];
+}
+
++ (void)performURLResolvingInBackground:(NSString *)url fromSource:(XXViewController *)source completion:(void(^)(BOOL success, id _Nullable destination, ZIKRouteAction routeAction, NSError *_Nullable error))performerCompletion {
+    NSParameterAssert(url);
+    if (!url) {
+        return;
+    }
+    // Registry lookups are only lock free after registration is frozen, otherwise router is fetched on main thread
+    BOOL fetchesRouterInBackground = ZIKRouteRegistry.freezesRegistration && ZIKRouteRegistry.registrationFinished;
+    __weak XXViewController *weakSource = source;
+    dispatch_async(zix_globalQueueWithQOS(QOS_CLASS_USER_INITIATED), ^{
+        ZIKURLRouteResult *result = [self routeFromURL:url];
+        NSString *identifier = result.identifier;
+        // Decode parameters in background
+        NSDictionary *userInfo = identifier ? result.parameters : nil;
+        ZIKViewRouterType *routerType = (identifier && fetchesRouterInBackground) ? _routerTypeForURLResult(result) : nil;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (!identifier) {
+                if (performerCompletion) {
+                    NSError *error = [ZIKViewRouter errorWithCode:ZIKRouteErrorInvalidConfiguration localizedDescriptionFormat:@"Can't find router from url: %@", url];
+                    performerCompletion(NO, nil, ZIKRouteActionToService, error);
+                }
+                return;
+            }
+            ZIKViewRouterType *resolvedRouterType = routerType;
+            if (!resolvedRouterType && !fetchesRouterInBackground) {
+                resolvedRouterType = _routerTypeForURLResult(result);
+            }
+            if (!resolvedRouterType) {
+                if (performerCompletion) {
+                    NSError *error = [ZIKViewRouter errorWithCode:ZIKRouteErrorInvalidConfiguration localizedDescriptionFormat:@"Can't find router with identifier (%@) from url: %@", identifier, url];
+                    performerCompletion(NO, nil, ZIKRouteActionToService, error);
+                    [ZIKViewRouter notifyGlobalErrorWithRouter:nil action:ZIKRouteActionToView error:error];
+                }
+                return;
+            }
+            XXViewController *source = weakSource;
+            if (!source) {
+                if (performerCompletion) {
+                    NSError *error = [ZIKViewRouter errorWithCode:ZIKViewRouteErrorInvalidSource localizedDescriptionFormat:@"Source was released before performing url: %@", url];
+                    performerCompletion(NO, nil, ZIKRouteActionPerformRoute, error);
+                }
+                return;
+            }
+            [self performRouterType:resolvedRouterType userInfo:userInfo prewarmKey:nil fromSource:source completion:performerCompletion];
+        });
+    });
+}
+
++ (ZIKViewRouter *)performRouterType:(ZIKViewRouterType *)routerType userInfo:(NSDictionary *)userInfo prewarmKey:(nullable NSString *)prewarmKey fromSource:(XXViewController *)source completion:(void(^)(BOOL success, id _Nullable destination, ZIKRouteAction routeAction, NSError *_Nullable error))performerCompletion {
     ZIKViewRoutePath *path;
     if ([routerType respondsToSelector:@selector(pathForTransitionType:source:)]) {
         path = [(id)routerType pathForTransitionType:userInfo[ZIKURLRouteKeyTransitionType] source:source];
@@ -124,6 +357,9 @@ static void _createURLRouter() {
     }
     return [routerType performPath:path configuring:^(ZIKViewRouteConfiguration * _Nonnull config) {
         [config addUserInfo:userInfo];
+        if (prewarmKey) {
+            config.prewarmKey = prewarmKey;
+        }
         if (!performerCompletion) {
             return;
         }
@@ -143,7 +379,7 @@ static void _createURLRouter() {
 }
 
 + (ZIKViewRouter *)performURL:(NSString *)url path:(ZIKViewRoutePath *)path completion:(void(^)(BOOL success, id _Nullable destination, ZIKRouteAction routeAction, NSError *_Nullable error))performerCompletion {
-    ZIKURLRouteResult *result = [self routeFromURL:url];
+    ZIKURLRouteResult *result = _takePrewarmedResult(url) ?: [self routeFromURL:url];
     NSString *identifier = result.identifier;
     if (!identifier) {
         if (performerCompletion) {
@@ -152,7 +388,7 @@ static void _createURLRouter() {
         }
         return nil;
     }
-    ZIKViewRouterType *routerType = _ZIKViewRouterToIdentifier(identifier);
+    ZIKViewRouterType *routerType = result.prewarmedRouterType ?: _routerTypeForURLResult(result);
     if (!routerType) {
         if (performerCompletion) {
             NSError *error = [ZIKViewRouter errorWithCode:ZIKRouteErrorInvalidConfiguration localizedDescriptionFormat:@"Can't find router with identifier (%@) from url: %@", identifier, url];
@@ -162,8 +398,12 @@ static void _createURLRouter() {
         return nil;
     }
     NSDictionary *userInfo = result.parameters;
+    NSString *prewarmKey = result.prewarmKey;
     return [routerType performPath:path configuring:^(ZIKViewRouteConfiguration * _Nonnull config) {
         [config addUserInfo:userInfo];
+        if (prewarmKey) {
+            config.prewarmKey = prewarmKey;
+        }
         if (!performerCompletion) {
             return;
         }
@@ -273,3 +513,11 @@ static void _createURLRouter() {
 }
 
 @end
+
+@implementation ZIKViewRouteRegistry (URLRouter)
+
++ (nullable NSSet<NSString *> *)registeredURLPatterns {
+    return [_viewURLRouter allPatterns];
+}
+
+@end
@@ -16,7 +16,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 #if DEBUG
 
-/** Demangles symbols for various languages. Only available in DEBUG mode.
+/// Whether the raw symbol name is mangled by Swift, checked with its prefix without demangling. The leading `_` added by linker is allowed.
+FOUNDATION_EXTERN bool zix_isSwiftMangledName(const char *name);
+
+/** Demangles symbols for various languages. Demangled names are cached, and it's thread safe. Only available in DEBUG mode.
  */
 @interface NSString (Demangle)
 
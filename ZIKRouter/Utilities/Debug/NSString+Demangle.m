@@ -15,7 +15,22 @@
 
 #import <dlfcn.h>
 
-static const char *demangleAsSwiftString(const char *name) {
+bool zix_isSwiftMangledName(const char *name) {
+    if (name == NULL) {
+        return false;
+    }
+    if (name[0] == '_' && name[1] != 'T') {
+        name++;
+    }
+    // Swift 5 and later: $s, Swift 4.2: $S, Swift 4 and earlier: _T0, embedded Swift: $e
+    if (name[0] == '$') {
+        return name[1] == 's' || name[1] == 'S' || name[1] == 'e';
+    }
+    return name[0] == '_' && name[1] == 'T' && name[2] == '0';
+}
+
+/// Return malloced string, or NULL when it can't be demangled.
+static char *demangleAsSwiftString(const char *name) {
     typedef char *(*swift_demangle_ft)(const char *mangledName, size_t mangledNameLength, char *outputBuffer, size_t *outputBufferSize, uint32_t flags);
     static swift_demangle_ft swift_demangle_f;
     static dispatch_once_t onceToken;
@@ -23,28 +38,49 @@ static const char *demangleAsSwiftString(const char *name) {
         swift_demangle_f = (swift_demangle_ft) dlsym(RTLD_DEFAULT, "swift_demangle");
     });
     
-    if (swift_demangle_f) {
+    if (swift_demangle_f && zix_isSwiftMangledName(name)) {
         return swift_demangle_f(name, strlen(name), 0, 0, 0);
     }
-    return name;
+    return NULL;
 }
 
-@implementation NSString (Demangle)
+/// Same names are demangled many times when enumerating symbols in images. key: mangled name, value: demangled name or NSNull.
+static NSMutableDictionary<NSString *, id> *_demangledNames;
+static dispatch_semaphore_t _demangledNamesSema;
 
-- (NSString *)demangledAsSwift {
-    const char *demangledString = demangleAsSwiftString(self.UTF8String);
+static NSString *demangledSwiftName(NSString *name) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _demangledNames = [NSMutableDictionary dictionary];
+        _demangledNamesSema = dispatch_semaphore_create(1);
+    });
+    dispatch_semaphore_wait(_demangledNamesSema, DISPATCH_TIME_FOREVER);
+    id cached = _demangledNames[name];
+    dispatch_semaphore_signal(_demangledNamesSema);
+    if (cached) {
+        return cached == [NSNull null] ? name : cached;
+    }
+    
+    NSString *demangled;
+    char *demangledString = demangleAsSwiftString(name.UTF8String);
     if (demangledString) {
-        return @(demangledString);
+        demangled = @(demangledString);
+        free(demangledString);
     }
-    return self;
+    dispatch_semaphore_wait(_demangledNamesSema, DISPATCH_TIME_FOREVER);
+    _demangledNames[[name copy]] = demangled ?: [NSNull null];
+    dispatch_semaphore_signal(_demangledNamesSema);
+    return demangled ?: name;
+}
+
+@implementation NSString (Demangle)
+
+- (NSString *)demangledAsSwift {
+    return demangledSwiftName(self);
 }
 
 - (NSString *)demangledAsSimplifiedSwift {
-    const char *demangledString = demangleAsSwiftString(self.UTF8String);
-    if (demangledString) {
-        return @(demangledString);
-    }
-    return self;
+    return demangledSwiftName(self);
 }
 
 @end
@@ -38,6 +38,8 @@ extern "C" {
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
 
 #include <dlfcn.h>
 
@@ -70,7 +72,8 @@ static const uint32_t LC_SEGMENT_XX = LC_SEGMENT;
 static const uint32_t MH_MAGIC_XX = MH_MAGIC;
 #endif
 
-static ssize_t MSMachONameList_(const void *stuff, struct MSSymbolData *list, size_t nreq, bool(^matching)(const char *)) {
+/// Find symbol table and string table of a loaded image.
+static bool MSMachOSymbolTable_(const void *stuff, size_t *slideOut, const nlist_xx **symbolsOut, const char **stringsOut, size_t *countOut) {
     //get slide
     size_t slide(0);
     for (uint32_t image(0), images(_dyld_image_count()); image != images; ++image)
@@ -79,7 +82,7 @@ static ssize_t MSMachONameList_(const void *stuff, struct MSSymbolData *list, si
             goto fat;
         }
     
-    return -1;
+    return false;
     
 fat:
     //find corresponding arch in fat binary
@@ -93,7 +96,7 @@ fat:
             host_t host(mach_host_self());
             mach_msg_type_number_t count(HOST_BASIC_INFO_COUNT);
             if (host_info(host, HOST_BASIC_INFO, reinterpret_cast<host_info_t>(&hbi), &count) != KERN_SUCCESS)
-                return -1;
+                return false;
             mach_port_deallocate(mach_task_self(), host);
             cpu_type = hbi.cpu_type;
         }
@@ -113,7 +116,7 @@ fat:
                 goto thin;
             }
         
-        return -1;
+        return false;
     }
     
 thin:
@@ -141,11 +144,11 @@ thin:
                 lcp->cmdsize % sizeof(long) != 0 || lcp->cmdsize <= 0 ||
                 reinterpret_cast<const uint8_t *>(lcp) + lcp->cmdsize > reinterpret_cast<const uint8_t *>(load_commands) + mh->sizeofcmds
                 )
-                return -1;
+                return false;
             
             if (lcp->cmd == LC_SYMTAB) {
                 if (lcp->cmdsize != sizeof(struct symtab_command))
-                    return -1;
+                    return false;
                 stp = reinterpret_cast<const struct symtab_command *>(lcp);
                 goto found;
             }
@@ -153,7 +156,7 @@ thin:
             lcp = reinterpret_cast<const struct load_command *>(reinterpret_cast<const uint8_t *>(lcp) + lcp->cmdsize);
         }
         
-        return -1;
+        return false;
         
     found:
         n = stp->nsyms;
@@ -173,11 +176,11 @@ thin:
                 lcp->cmdsize % sizeof(long) != 0 || lcp->cmdsize <= 0 ||
                 reinterpret_cast<const uint8_t *>(lcp) + lcp->cmdsize > reinterpret_cast<const uint8_t *>(load_commands) + mh->sizeofcmds
                 )
-                return -1;
+                return false;
             
             if (lcp->cmd == LC_SEGMENT_XX) {
                 if (lcp->cmdsize < sizeof(segment_command_xx))
-                    return -1;
+                    return false;
                 const segment_command_xx *segment(reinterpret_cast<const segment_command_xx *>(lcp));
                 if (strcmp(segment->segname, SEG_LINKEDIT) == 0) {
                     if (stp->symoff >= segment->fileoff && stp->symoff < segment->fileoff + segment->filesize)
@@ -192,18 +195,311 @@ thin:
         }
         
         if (symbols == NULL || strings == NULL)
-            return -1;
+            return false;
         // XXX: detect a.out somehow?
     } else if (false) {
         /* XXX: is this right anymore?!? */
 //        symbols = reinterpret_cast<const nlist_xx *>(base + N_SYMOFF(*buf));
 //        strings = reinterpret_cast<const char *>(reinterpret_cast<const uint8_t *>(symbols) + buf->a_syms);
 //        n = buf->a_syms / sizeof(nlist_xx);
-    } else return -1;
+    } else return false;
+    
+    *slideOut = slide;
+    *symbolsOut = symbols;
+    *stringsOut = strings;
+    *countOut = n;
+    return true;
+}
+
+#ifndef LC_DYLD_EXPORTS_TRIE
+#define LC_DYLD_EXPORTS_TRIE (0x33 | LC_REQ_DYLD)
+#endif
+
+/// Find export trie of a loaded image from LC_DYLD_INFO(_ONLY) or LC_DYLD_EXPORTS_TRIE.
+static bool MSMachOExportTrie_(const void *stuff, const uint8_t **trieOut, size_t *sizeOut) {
+    size_t slide(0);
+    bool loaded(false);
+    for (uint32_t image(0), images(_dyld_image_count()); image != images; ++image)
+        if (_dyld_get_image_header(image) == stuff) {
+            slide = _dyld_get_image_vmaddr_slide(image);
+            loaded = true;
+            break;
+        }
+    if (!loaded)
+        return false;
+    
+    const mach_header_xx *mh(reinterpret_cast<const mach_header_xx *>(stuff));
+    if (mh->magic != MH_MAGIC_XX)
+        return false;
+    const struct load_command *load_commands(reinterpret_cast<const struct load_command *>(mh + 1));
+    const segment_command_xx *linkedit(NULL);
+    uint32_t exportOffset(0);
+    uint32_t exportSize(0);
+    
+    const struct load_command *lcp(load_commands);
+    for (uint32_t i(0); i != mh->ncmds; ++i) {
+        if (
+            lcp->cmdsize % sizeof(long) != 0 || lcp->cmdsize <= 0 ||
+            reinterpret_cast<const uint8_t *>(lcp) + lcp->cmdsize > reinterpret_cast<const uint8_t *>(load_commands) + mh->sizeofcmds
+            )
+            return false;
+        
+        if (lcp->cmd == LC_SEGMENT_XX) {
+            const segment_command_xx *segment(reinterpret_cast<const segment_command_xx *>(lcp));
+            if (strcmp(segment->segname, SEG_LINKEDIT) == 0)
+                linkedit = segment;
+        } else if (lcp->cmd == LC_DYLD_INFO || lcp->cmd == LC_DYLD_INFO_ONLY) {
+            const struct dyld_info_command *info(reinterpret_cast<const struct dyld_info_command *>(lcp));
+            exportOffset = info->export_off;
+            exportSize = info->export_size;
+        } else if (lcp->cmd == LC_DYLD_EXPORTS_TRIE) {
+            const struct linkedit_data_command *data(reinterpret_cast<const struct linkedit_data_command *>(lcp));
+            exportOffset = data->dataoff;
+            exportSize = data->datasize;
+        }
+        lcp = reinterpret_cast<const struct load_command *>(reinterpret_cast<const uint8_t *>(lcp) + lcp->cmdsize);
+    }
+    
+    if (linkedit == NULL || exportSize == 0 ||
+        exportOffset < linkedit->fileoff || exportOffset + exportSize > linkedit->fileoff + linkedit->filesize)
+        return false;
+    *trieOut = reinterpret_cast<const uint8_t *>(exportOffset - linkedit->fileoff + linkedit->vmaddr + slide);
+    *sizeOut = exportSize;
+    return true;
+}
+
+static bool MSReadULEB128_(const uint8_t **p, const uint8_t *end, uint64_t *value) {
+    uint64_t result(0);
+    unsigned shift(0);
+    while (*p < end) {
+        uint8_t byte(**p);
+        ++*p;
+        if (shift < 64)
+            result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        shift += 7;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Look up an exported symbol in export trie in O(length of name). Return false when the symbol is not exported, or is re-exported from another image or thread local.
+static bool MSExportTrieLookup_(const void *stuff, const uint8_t *trie, size_t size, const char *name, uintptr_t *value) {
+    const uint8_t *end(trie + size);
+    const uint8_t *p(trie);
+    const char *s(name);
+    // Nodes can't be visited more times than trie size, so malformed loops stop
+    for (size_t visited(0); visited != size; ++visited) {
+        uint64_t terminalSize;
+        if (!MSReadULEB128_(&p, end, &terminalSize))
+            return false;
+        if (*s == '\0') {
+            if (terminalSize == 0)
+                return false;
+            uint64_t flags;
+            uint64_t offset;
+            if (!MSReadULEB128_(&p, end, &flags))
+                return false;
+            if ((flags & EXPORT_SYMBOL_FLAGS_REEXPORT) != 0 ||
+                (flags & EXPORT_SYMBOL_FLAGS_KIND_MASK) == EXPORT_SYMBOL_FLAGS_KIND_THREAD_LOCAL)
+                return false;
+            // For stub and resolver, first offset is the stub
+            if (!MSReadULEB128_(&p, end, &offset))
+                return false;
+            if ((flags & EXPORT_SYMBOL_FLAGS_KIND_MASK) == EXPORT_SYMBOL_FLAGS_KIND_ABSOLUTE)
+                *value = static_cast<uintptr_t>(offset);
+            else
+                *value = reinterpret_cast<uintptr_t>(stuff) + static_cast<uintptr_t>(offset);
+            return true;
+        }
+        if (terminalSize > static_cast<uint64_t>(end - p))
+            return false;
+        p += terminalSize;
+        if (p >= end)
+            return false;
+        uint8_t childCount(*p++);
+        const uint8_t *next(NULL);
+        for (uint8_t child(0); child != childCount; ++child) {
+            const char *edge(reinterpret_cast<const char *>(p));
+            size_t length(strnlen(edge, end - p));
+            if (p + length >= end)
+                return false;
+            p += length + 1;
+            uint64_t nodeOffset;
+            if (!MSReadULEB128_(&p, end, &nodeOffset))
+                return false;
+            if (next == NULL && strncmp(s, edge, length) == 0) {
+                if (nodeOffset >= size)
+                    return false;
+                s += length;
+                next = trie + nodeOffset;
+                break;
+            }
+        }
+        if (next == NULL)
+            return false;
+        p = next;
+    }
+    return false;
+}
+
+static void MSFillSymbolData_(struct MSSymbolData *p, const nlist_xx *q, size_t slide) {
+    p->name_ = NULL;
+    
+    p->value_ = q->n_value;
+    if (p->value_ != 0)
+        p->value_ += slide;
+    
+    p->type_ = q->n_type;
+    p->desc_ = q->n_desc;
+    p->sect_ = q->n_sect;
+}
+
+/// Hash index of symbol names in an image, so finding a symbol by name doesn't scan the whole symbol table. Built on first access and never freed.
+struct ZIKSymbolIndex {
+    const void *image;
+    size_t slide;
+    const nlist_xx *symbols;
+    const char *strings;
+    /// Capacity - 1. Capacity is power of 2.
+    size_t mask;
+    /// Slot is index of symbol + 1, 0 for empty slot.
+    uint32_t *slots;
+    /// Hash of symbol name in each slot, for skipping strcmp of different names.
+    uint32_t *hashes;
+    struct ZIKSymbolIndex *next;
+};
+
+static pthread_mutex_t ZIKSymbolIndexesLock = PTHREAD_MUTEX_INITIALIZER;
+static struct ZIKSymbolIndex *ZIKSymbolIndexes = NULL;
+
+/// FNV-1a
+static uint32_t ZIKSymbolNameHash(const char *name) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *c = reinterpret_cast<const unsigned char *>(name); *c != '\0'; ++c) {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static const nlist_xx *ZIKSymbolIndexLookup(const struct ZIKSymbolIndex *index, const char *name, uint32_t hash) {
+    for (size_t slot(hash & index->mask); index->slots[slot] != 0; slot = (slot + 1) & index->mask) {
+        if (index->hashes[slot] != hash)
+            continue;
+        const nlist_xx *q(&index->symbols[index->slots[slot] - 1]);
+        if (strcmp(index->strings + q->n_un.n_strx, name) == 0)
+            return q;
+    }
+    return NULL;
+}
+
+static struct ZIKSymbolIndex *ZIKSymbolIndexCreate(const void *image) {
+    size_t slide;
+    const nlist_xx *symbols;
+    const char *strings;
+    size_t n;
+    if (!MSMachOSymbolTable_(image, &slide, &symbols, &strings, &n) || n >= UINT32_MAX)
+        return NULL;
     
-    //find symbols with names
+    // Keep load factor under 0.5
+    size_t capacity(16);
+    while (capacity < n * 2)
+        capacity <<= 1;
+    struct ZIKSymbolIndex *index(static_cast<struct ZIKSymbolIndex *>(calloc(1, sizeof(struct ZIKSymbolIndex))));
+    index->image = image;
+    index->slide = slide;
+    index->symbols = symbols;
+    index->strings = strings;
+    index->mask = capacity - 1;
+    index->slots = static_cast<uint32_t *>(calloc(capacity, sizeof(uint32_t)));
+    index->hashes = static_cast<uint32_t *>(malloc(capacity * sizeof(uint32_t)));
+    
+    for (size_t m(0); m != n; ++m) {
+        const nlist_xx *q(&symbols[m]);
+        if (q->n_un.n_strx == 0 || (q->n_type & N_STAB) != 0)
+            continue;
+        const char *nambuf(strings + q->n_un.n_strx);
+        uint32_t hash(ZIKSymbolNameHash(nambuf));
+        // Same as scanning the table, the first symbol with the name is used
+        if (ZIKSymbolIndexLookup(index, nambuf, hash) != NULL)
+            continue;
+        size_t slot(hash & index->mask);
+        while (index->slots[slot] != 0)
+            slot = (slot + 1) & index->mask;
+        index->slots[slot] = static_cast<uint32_t>(m + 1);
+        index->hashes[slot] = hash;
+    }
+    return index;
+}
+
+static const struct ZIKSymbolIndex *ZIKSymbolIndexForImage(const void *image) {
+    pthread_mutex_lock(&ZIKSymbolIndexesLock);
+    struct ZIKSymbolIndex *index(ZIKSymbolIndexes);
+    while (index != NULL && index->image != image)
+        index = index->next;
+    if (index == NULL) {
+        index = ZIKSymbolIndexCreate(image);
+        if (index != NULL) {
+            index->next = ZIKSymbolIndexes;
+            ZIKSymbolIndexes = index;
+        }
+    }
+    pthread_mutex_unlock(&ZIKSymbolIndexesLock);
+    return index;
+}
+
+static ssize_t MSMachONameList_(const void *stuff, struct MSSymbolData *list, size_t nreq, bool(^matching)(const char *)) {
     size_t result(nreq);
     
+    if (matching == NULL) {
+        //find exported symbols in export trie, without reading symbol table and string table
+        const uint8_t *trie;
+        size_t trieSize;
+        if (MSMachOExportTrie_(stuff, &trie, &trieSize)) {
+            for (size_t item(0); item != nreq; ++item) {
+                struct MSSymbolData *p(list + item);
+                uintptr_t value;
+                if (p->name_ == NULL || !MSExportTrieLookup_(stuff, trie, trieSize, p->name_, &value))
+                    continue;
+                p->name_ = NULL;
+                p->value_ = value;
+                p->type_ = N_SECT | N_EXT;
+                p->desc_ = 0;
+                p->sect_ = 0;
+                if (--result == 0)
+                    return 0;
+            }
+        }
+        
+        //find other symbols with names in hash index
+        const struct ZIKSymbolIndex *index(ZIKSymbolIndexForImage(stuff));
+        if (index == NULL)
+            return result == nreq ? -1 : result;
+        for (size_t item(0); item != nreq; ++item) {
+            struct MSSymbolData *p(list + item);
+            if (p->name_ == NULL)
+                continue;
+            const nlist_xx *q(ZIKSymbolIndexLookup(index, p->name_, ZIKSymbolNameHash(p->name_)));
+            if (q == NULL)
+                continue;
+            MSFillSymbolData_(p, q, index->slide);
+            if (--result == 0)
+                return 0;
+        }
+        return result;
+    }
+    
+    size_t slide;
+    const nlist_xx *symbols;
+    const char *strings;
+    size_t n;
+    if (!MSMachOSymbolTable_(stuff, &slide, &symbols, &strings, &n))
+        return -1;
+    
+    //find symbols with matching block
     for (size_t m(0); m != n; ++m) {
         const nlist_xx *q(&symbols[m]);
         if (q->n_un.n_strx == 0 || (q->n_type & N_STAB) != 0)
@@ -215,28 +511,11 @@ thin:
         
         for (size_t item(0); item != nreq; ++item) {
             struct MSSymbolData *p(list + item);
-            if (matching) {
-                if (!matching(nambuf)) {
-                    continue;
-                }
-            } else {
-                if (p->name_ == NULL) {
-                    continue;
-                }
-                if (strcmp(p->name_, nambuf) != 0) {
-                    continue;
-                }
+            if (!matching(nambuf)) {
+                continue;
             }
             
-            p->name_ = NULL;
-            
-            p->value_ = q->n_value;
-            if (p->value_ != 0)
-                p->value_ += slide;
-            
-            p->type_ = q->n_type;
-            p->desc_ = q->n_desc;
-            p->sect_ = q->n_sect;
+            MSFillSymbolData_(p, q, slide);
             
             if (--result == 0)
                 return 0;
@@ -268,7 +547,7 @@ static bool string_ends_with(const char * str, const char * suffix) {
     return NULL;
 }
 
-static void ZIKFindSymbols(ZIKImageRef image, size_t count, const char *names[], void *values[], bool(^matching)(const char *)) {
+static void ZIKFindSymbols(ZIKImageRef image, size_t count, const char *const names[], void *values[], bool(^matching)(const char *)) {
     MSSymbolData items[count];
     
     for (size_t index(0); index != count; ++index) {
@@ -335,6 +614,12 @@ void *ZIKFindSymbol(ZIKImageRef image, bool(^matchingBlock)(const char *)) {
     return value;
 }
 
+void ZIKFindSymbols(ZIKImageRef image, size_t count, const char *const names[], void *values[]) {
+    if (count == 0)
+        return;
+    ZIKFindSymbols(image, count, names, values, NULL);
+}
+
 const char *ZIKSymbolNameForAddress(void *address) {
     Dl_info dlinfo;
     dladdr(address, &dlinfo);
@@ -26,6 +26,8 @@ extern ZIKImageRef ZIKGetImageByName(const char *file);
  @note
  Not all static functions can be found, because its symbol may be striped in the binary file, e.g. those `<redacted>` in system frameworks.
  
+ Exported symbols are found in export trie of the image, other symbols are found in its symbol table.
+ 
  @param image The image to search in, pass NULL to search in all images.
  @param name The symbol to completely match. Need to add `_` when finding a C function name.
  @return Address of the symbol, NULL when symbol was not found.
@@ -43,6 +45,16 @@ extern void *ZIKFindSymbol(ZIKImageRef image, const char *name);
  */
 extern void *ZIKFindSymbol(ZIKImageRef image, bool(^matchingBlock)(const char *));
 
+/**
+ Find function pointer addresses of multiple symbols in one pass. Symbol names of an image are indexed on first access, so later lookups in the same image don't scan its symbol table again.
+ 
+ @param image The image to search in, pass NULL to search in all images.
+ @param count Count of names.
+ @param names The symbols to completely match.
+ @param values Addresses of the symbols, NULL for symbol not found.
+ */
+extern void ZIKFindSymbols(ZIKImageRef image, size_t count, const char *const names[], void *values[]);
+
 /// Get symbol of a address.
 extern const char *ZIKSymbolNameForAddress(void *address);
 
@@ -30,6 +30,8 @@ typedef const void *ZIKImageRef;
  @note
  Not all static functions can be found, because its symbol may be striped in the binary file, e.g. those `<redacted>` in system frameworks.
  
+ Exported symbols are found in export trie of the image without reading its symbol table, so finding them doesn't page in the whole symbol table and string table.
+ 
  @param image The image to search in, pass NULL to search in all images.
  @param symbolName The symbol to find. Need to add `_` when finding a C function name.
  @return Address of the symbol, NULL when symbol was not found.
@@ -47,6 +49,16 @@ typedef const void *ZIKImageRef;
  */
 + (void *)findSymbolInImage:(_Nullable ZIKImageRef)image matching:(BOOL(^)(const char *symbolName))matchingBlock;
 
+/**
+ Find function pointer addresses of multiple symbols in one pass.
+ 
+ @param image The image to search in, pass NULL to search in all images.
+ @param symbolNames The symbols to find.
+ @param count Count of symbol names.
+ @param values Addresses of the symbols, NULL for symbol not found.
+ */
++ (void)findSymbolsInImage:(_Nullable ZIKImageRef)image names:(const char *_Nonnull const *_Nonnull)symbolNames count:(size_t)count values:(void *_Nullable *_Nonnull)values;
+
 /// Get symbol of a address.
 + (nullable NSString *)symbolNameForAddress:(void *)address;
 
@@ -50,6 +50,12 @@
     return symbol;
 }
 
++ (void)findSymbolsInImage:(ZIKImageRef)image names:(const char *const *)symbolNames count:(size_t)count values:(void **)values {
+    NSParameterAssert(symbolNames);
+    NSParameterAssert(values);
+    ZIKFindSymbols(image, count, symbolNames, values);
+}
+
 + (nullable NSString *)symbolNameForAddress:(void *)address {
     if (address == NULL) {
         return nil;
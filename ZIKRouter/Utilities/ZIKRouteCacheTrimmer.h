@@ -0,0 +1,40 @@
+//
+//  ZIKRouteCacheTrimmer.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Priority of a cache when trimming. Caches with lower priority are trimmed first.
+typedef NS_ENUM(NSInteger, ZIKRouteCachePriority) {
+    /// Cache cheap to fill again, such as url matching results.
+    ZIKRouteCachePriorityLow,
+    /// Pool of idle objects, such as reusable routers and navigation containers.
+    ZIKRouteCachePriorityDefault,
+    /// Objects expensive to create again, such as prewarmed and preloaded destinations. Only trimmed for critical memory pressure.
+    ZIKRouteCachePriorityHigh
+};
+
+/**
+ Register a block trimming a cache when app is under memory pressure. Can be called on any thread. Trimmers are never unregistered, so a trimmer of an object should hold it weakly.
+ 
+ @discussion
+ Trimmers are called on main thread, from lower priority to higher priority. Receiving UIApplicationDidReceiveMemoryWarningNotification trims all caches. Without UIKit, memory pressure warning from dispatch source trims caches below ZIKRouteCachePriorityHigh, and critical memory pressure trims all caches. Lookup paths don't check memory pressure, so caches cost nothing until they are trimmed.
+ 
+ @param priority Priority of the cache.
+ @param trimmer Block releasing objects in the cache.
+ */
+FOUNDATION_EXTERN void zix_registerCacheTrimmer(ZIKRouteCachePriority priority, dispatch_block_t trimmer);
+
+/// Call registered trimmers with priority not higher than maxPriority, from lower priority to higher priority. Must be called on main thread.
+FOUNDATION_EXTERN void zix_trimCaches(ZIKRouteCachePriority maxPriority);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,74 @@
+//
+//  ZIKRouteCacheTrimmer.m
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKRouteCacheTrimmer.h"
+#import "ZIKPlatformCapabilities.h"
+#if ZIK_HAS_UIKIT
+#import <UIKit/UIKit.h>
+#endif
+
+#define ZIX_CACHE_PRIORITY_COUNT (ZIKRouteCachePriorityHigh + 1)
+
+/// Trimmers of each priority, guarded by _trimmersSema.
+static NSMutableArray<dispatch_block_t> *_trimmers[ZIX_CACHE_PRIORITY_COUNT];
+static dispatch_semaphore_t _trimmersSema;
+
+static void _observeMemoryPressure(void) {
+#if ZIK_HAS_UIKIT
+    [[NSNotificationCenter defaultCenter] addObserverForName:UIApplicationDidReceiveMemoryWarningNotification object:nil queue:nil usingBlock:^(NSNotification * _Nonnull note) {
+        zix_trimCaches(ZIKRouteCachePriorityHigh);
+    }];
+#else
+    static dispatch_source_t source;
+    source = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0, DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL, dispatch_get_main_queue());
+    dispatch_source_set_event_handler(source, ^{
+        dispatch_source_memorypressure_flags_t flags = dispatch_source_get_data(source);
+        zix_trimCaches((flags & DISPATCH_MEMORYPRESSURE_CRITICAL) ? ZIKRouteCachePriorityHigh : ZIKRouteCachePriorityDefault);
+    });
+    dispatch_resume(source);
+#endif
+}
+
+void zix_registerCacheTrimmer(ZIKRouteCachePriority priority, dispatch_block_t trimmer) {
+    NSCParameterAssert(trimmer);
+    NSCParameterAssert(priority >= ZIKRouteCachePriorityLow && priority <= ZIKRouteCachePriorityHigh);
+    if (!trimmer || priority < ZIKRouteCachePriorityLow || priority > ZIKRouteCachePriorityHigh) {
+        return;
+    }
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (NSInteger i = 0; i < ZIX_CACHE_PRIORITY_COUNT; i++) {
+            _trimmers[i] = [NSMutableArray array];
+        }
+        _trimmersSema = dispatch_semaphore_create(1);
+        // Notification center and dispatch source can be used on any thread
+        _observeMemoryPressure();
+    });
+    dispatch_semaphore_wait(_trimmersSema, DISPATCH_TIME_FOREVER);
+    [_trimmers[priority] addObject:[trimmer copy]];
+    dispatch_semaphore_signal(_trimmersSema);
+}
+
+void zix_trimCaches(ZIKRouteCachePriority maxPriority) {
+    NSCAssert([NSThread isMainThread], @"Caches should be trimmed on main thread");
+    if (_trimmersSema == nil) {
+        return;
+    }
+    for (NSInteger priority = ZIKRouteCachePriorityLow; priority <= maxPriority && priority < ZIX_CACHE_PRIORITY_COUNT; priority++) {
+        // Call trimmers outside the lock, they may register other trimmers
+        dispatch_semaphore_wait(_trimmersSema, DISPATCH_TIME_FOREVER);
+        NSArray<dispatch_block_t> *trimmers = [_trimmers[priority] copy];
+        dispatch_semaphore_signal(_trimmersSema);
+        for (dispatch_block_t trimmer in trimmers) {
+            trimmer();
+        }
+    }
+}
@@ -0,0 +1,31 @@
+//
+//  ZIKRouteScheduler.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import <Foundation/Foundation.h>
+#import "ZIKRouteConfiguration.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Run work on main thread after all waiting work with higher priority. Can be called on any thread.
+ 
+ @discussion
+ ZIKRoutePriorityUserInitiated work runs when main run loop finishes current pass, in any mode. ZIKRoutePriorityUtility and ZIKRoutePriorityBackground work only runs before main run loop is going to sleep in default mode, so it doesn't run when user is scrolling. Utility work runs in a short time slice in each pass, and one background work runs in a pass only when no utility work is waiting. Work with the same priority runs in FIFO order.
+ 
+ @param priority Priority of the work, must not be ZIKRoutePriorityImmediate.
+ @param work The work to run.
+ */
+FOUNDATION_EXTERN void zix_scheduleMainThreadWork(ZIKRoutePriority priority, dispatch_block_t work);
+
+/// Count of waiting work with the priority.
+FOUNDATION_EXTERN NSUInteger zix_scheduledWorkCount(ZIKRoutePriority priority);
+
+NS_ASSUME_NONNULL_END
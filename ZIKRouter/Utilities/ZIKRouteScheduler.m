@@ -0,0 +1,120 @@
+//
+//  ZIKRouteScheduler.m
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKRouteScheduler.h"
+
+/// Seconds of utility work in one run loop pass, so the run loop can still handle events in time.
+static const CFAbsoluteTime kUtilityWorkTimeSlice = 0.004;
+
+#define ZIX_SCHEDULED_PRIORITY_COUNT (ZIKRoutePriorityBackground + 1)
+
+/// Waiting work of each priority, guarded by _schedulerSema.
+static NSMutableArray<dispatch_block_t> *_scheduledWorks[ZIX_SCHEDULED_PRIORITY_COUNT];
+static dispatch_semaphore_t _schedulerSema;
+/// Observer of main run loop, only exists when there is waiting work. Guarded by _schedulerSema.
+static CFRunLoopObserverRef _schedulerObserver;
+
+static void _initScheduler(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (NSInteger priority = ZIKRoutePriorityUserInitiated; priority < ZIX_SCHEDULED_PRIORITY_COUNT; priority++) {
+            _scheduledWorks[priority] = [NSMutableArray array];
+        }
+        _schedulerSema = dispatch_semaphore_create(1);
+    });
+}
+
+static dispatch_block_t _Nullable _dequeueWork(ZIKRoutePriority priority) {
+    dispatch_semaphore_wait(_schedulerSema, DISPATCH_TIME_FOREVER);
+    NSMutableArray<dispatch_block_t> *works = _scheduledWorks[priority];
+    dispatch_block_t work = works.firstObject;
+    if (work) {
+        [works removeObjectAtIndex:0];
+    }
+    dispatch_semaphore_signal(_schedulerSema);
+    return work;
+}
+
+/// Run work until the queue is empty or the deadline is passed. At least one work runs if there is any.
+static void _runWorks(ZIKRoutePriority priority, CFAbsoluteTime deadline) {
+    dispatch_block_t work;
+    while ((work = _dequeueWork(priority))) {
+        @autoreleasepool {
+            work();
+        }
+        if (CFAbsoluteTimeGetCurrent() >= deadline) {
+            break;
+        }
+    }
+}
+
+static void _handleRunLoopBeforeWaiting(void) {
+    _runWorks(ZIKRoutePriorityUserInitiated, DBL_MAX);
+    CFStringRef mode = CFRunLoopCopyCurrentMode(CFRunLoopGetMain());
+    BOOL isDefaultMode = mode && CFEqual(mode, kCFRunLoopDefaultMode);
+    if (mode) {
+        CFRelease(mode);
+    }
+    if (isDefaultMode) {
+        if (zix_scheduledWorkCount(ZIKRoutePriorityUtility) > 0) {
+            _runWorks(ZIKRoutePriorityUtility, CFAbsoluteTimeGetCurrent() + kUtilityWorkTimeSlice);
+        } else {
+            // One background work in each idle pass
+            _runWorks(ZIKRoutePriorityBackground, 0);
+        }
+    }
+    
+    dispatch_semaphore_wait(_schedulerSema, DISPATCH_TIME_FOREVER);
+    BOOL hasUserInitiatedWork = _scheduledWorks[ZIKRoutePriorityUserInitiated].count > 0;
+    BOOL hasIdleWork = _scheduledWorks[ZIKRoutePriorityUtility].count > 0 || _scheduledWorks[ZIKRoutePriorityBackground].count > 0;
+    if (!hasUserInitiatedWork && !hasIdleWork) {
+        CFRunLoopObserverInvalidate(_schedulerObserver);
+        CFRelease(_schedulerObserver);
+        _schedulerObserver = NULL;
+    }
+    dispatch_semaphore_signal(_schedulerSema);
+    // Run loop won't wake up again if there is no other event. Idle work waits in other modes, or it would keep main thread busy when user is scrolling.
+    if (hasUserInitiatedWork || (hasIdleWork && isDefaultMode)) {
+        CFRunLoopWakeUp(CFRunLoopGetMain());
+    }
+}
+
+void zix_scheduleMainThreadWork(ZIKRoutePriority priority, dispatch_block_t work) {
+    NSCParameterAssert(work);
+    NSCParameterAssert(priority > ZIKRoutePriorityImmediate && priority < ZIX_SCHEDULED_PRIORITY_COUNT);
+    if (work == nil) {
+        return;
+    }
+    if (priority <= ZIKRoutePriorityImmediate || priority >= ZIX_SCHEDULED_PRIORITY_COUNT) {
+        priority = ZIKRoutePriorityUserInitiated;
+    }
+    _initScheduler();
+    dispatch_semaphore_wait(_schedulerSema, DISPATCH_TIME_FOREVER);
+    [_scheduledWorks[priority] addObject:[work copy]];
+    if (_schedulerObserver == NULL) {
+        _schedulerObserver = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault, kCFRunLoopBeforeWaiting, true, INT_MAX, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+            _handleRunLoopBeforeWaiting();
+        });
+        CFRunLoopAddObserver(CFRunLoopGetMain(), _schedulerObserver, kCFRunLoopCommonModes);
+    }
+    dispatch_semaphore_signal(_schedulerSema);
+    CFRunLoopWakeUp(CFRunLoopGetMain());
+}
+
+NSUInteger zix_scheduledWorkCount(ZIKRoutePriority priority) {
+    if (priority <= ZIKRoutePriorityImmediate || priority >= ZIX_SCHEDULED_PRIORITY_COUNT || _schedulerSema == NULL) {
+        return 0;
+    }
+    dispatch_semaphore_wait(_schedulerSema, DISPATCH_TIME_FOREVER);
+    NSUInteger count = _scheduledWorks[priority].count;
+    dispatch_semaphore_signal(_schedulerSema);
+    return count;
+}
@@ -0,0 +1,52 @@
+//
+//  ZIKRouteSignpost.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ZIKRouter;
+
+/// Stages of route lifecycle emitted as os_signpost intervals with subsystem `ZIKRouter` and category `Route`.
+typedef NS_ENUM(uint8_t, ZIKRouteSignpostStage) {
+    /// Finding router with protocol or identifier.
+    ZIKRouteSignpostStageLookup,
+    /// Building configurations and initializing router.
+    ZIKRouteSignpostStageRouterInit,
+    /// -destinationWithConfiguration:.
+    ZIKRouteSignpostStageMakeDestination,
+    /// Preparing callbacks of configuration and -prepareDestination:configuration:.
+    ZIKRouteSignpostStagePrepareDestination,
+    /// -performRouteOnDestination:configuration:.
+    ZIKRouteSignpostStagePerformRoute,
+    /// View transition, from beginning to perform until perform is finished.
+    ZIKRouteSignpostStageTransition,
+    /// Success handlers of the route.
+    ZIKRouteSignpostStageNotifySuccess
+};
+
+/**
+ Begin an interval of the stage. The subject, such as router class name or protocol name, is the metadata of the beginning.
+ 
+ @return Signpost id for ending the interval. 0 when signposts are not recorded, such as Instruments is not recording or below iOS 12, tvOS 12 and macOS 10.14.
+ */
+FOUNDATION_EXTERN uint64_t zix_beginRouteSignpost(ZIKRouteSignpostStage stage, const char *subject);
+
+/// End an interval of the stage. The detail, such as route type or found router, is the metadata of the ending. Do nothing when signpostID is 0.
+FOUNDATION_EXTERN void zix_endRouteSignpost(ZIKRouteSignpostStage stage, uint64_t signpostID, const char *_Nullable detail);
+
+/// Begin an interval of the stage with router class name.
+FOUNDATION_EXTERN uint64_t zix_beginRouterSignpost(ZIKRouteSignpostStage stage, ZIKRouter *router);
+
+/// End an interval of the stage with router's route type.
+FOUNDATION_EXTERN void zix_endRouterSignpost(ZIKRouteSignpostStage stage, uint64_t signpostID, ZIKRouter *_Nullable router);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,83 @@
+//
+//  ZIKRouteSignpost.m
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKRouteSignpost.h"
+#import "ZIKRouterPrivate.h"
+#import <objc/runtime.h>
+#if __has_include(<os/signpost.h>)
+#import <os/signpost.h>
+#endif
+
+#if __has_include(<os/signpost.h>)
+static os_log_t _routeLog(void) API_AVAILABLE(ios(12.0), tvos(12.0), macos(10.14)) {
+    static os_log_t log;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        log = os_log_create("ZIKRouter", "Route");
+    });
+    return log;
+}
+#endif
+
+// Name of os_signpost must be a string literal
+#define ZIX_ROUTE_SIGNPOST_SWITCH(stage, SIGNPOST) \
+switch (stage) { \
+    case ZIKRouteSignpostStageLookup: SIGNPOST("Lookup"); break; \
+    case ZIKRouteSignpostStageRouterInit: SIGNPOST("RouterInit"); break; \
+    case ZIKRouteSignpostStageMakeDestination: SIGNPOST("MakeDestination"); break; \
+    case ZIKRouteSignpostStagePrepareDestination: SIGNPOST("PrepareDestination"); break; \
+    case ZIKRouteSignpostStagePerformRoute: SIGNPOST("PerformRoute"); break; \
+    case ZIKRouteSignpostStageTransition: SIGNPOST("Transition"); break; \
+    case ZIKRouteSignpostStageNotifySuccess: SIGNPOST("NotifySuccess"); break; \
+}
+
+uint64_t zix_beginRouteSignpost(ZIKRouteSignpostStage stage, const char *subject) {
+#if __has_include(<os/signpost.h>)
+    if (@available(iOS 12.0, tvOS 12.0, macOS 10.14, *)) {
+        os_log_t log = _routeLog();
+        if (!os_signpost_enabled(log)) {
+            return 0;
+        }
+        os_signpost_id_t signpostID = os_signpost_id_generate(log);
+#define ZIX_BEGIN_SIGNPOST(name) os_signpost_interval_begin(log, signpostID, name, "%{public}s", subject)
+        ZIX_ROUTE_SIGNPOST_SWITCH(stage, ZIX_BEGIN_SIGNPOST)
+#undef ZIX_BEGIN_SIGNPOST
+        return signpostID;
+    }
+#endif
+    return 0;
+}
+
+void zix_endRouteSignpost(ZIKRouteSignpostStage stage, uint64_t signpostID, const char *detail) {
+    if (signpostID == 0) {
+        return;
+    }
+#if __has_include(<os/signpost.h>)
+    if (@available(iOS 12.0, tvOS 12.0, macOS 10.14, *)) {
+        os_log_t log = _routeLog();
+        const char *text = detail ?: "";
+#define ZIX_END_SIGNPOST(name) os_signpost_interval_end(log, signpostID, name, "%{public}s", text)
+        ZIX_ROUTE_SIGNPOST_SWITCH(stage, ZIX_END_SIGNPOST)
+#undef ZIX_END_SIGNPOST
+    }
+#endif
+}
+
+uint64_t zix_beginRouterSignpost(ZIKRouteSignpostStage stage, ZIKRouter *router) {
+    return zix_beginRouteSignpost(stage, object_getClassName(router));
+}
+
+void zix_endRouterSignpost(ZIKRouteSignpostStage stage, uint64_t signpostID, ZIKRouter *router) {
+    if (signpostID == 0) {
+        return;
+    }
+    zix_endRouteSignpost(stage, signpostID, [router signpostRouteType].UTF8String);
+}
@@ -0,0 +1,66 @@
+//
+//  ZIKRouterLog.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Categories of framework diagnostics, logged with subsystem `ZIKRouter`.
+typedef NS_ENUM(uint8_t, ZIKRouterLogCategory) {
+    /// Method swizzling and runtime utilities.
+    ZIKRouterLogCategoryRuntime,
+    /// Registration, validation and route tables.
+    ZIKRouterLogCategoryRegistry,
+    /// Errors and warnings when performing and removing routes.
+    ZIKRouterLogCategoryRoute,
+    /// Memory leak checker.
+    ZIKRouterLogCategoryMemoryLeak
+};
+
+/// Levels of framework diagnostics, mapped to os_log types.
+typedef NS_ENUM(uint8_t, ZIKRouterLogLevel) {
+    ZIKRouterLogLevelDebug,
+    ZIKRouterLogLevelInfo,
+    ZIKRouterLogLevelWarning,
+    ZIKRouterLogLevelError
+};
+
+/// Logs below this level are ignored before formatting. Default is ZIKRouterLogLevelDebug.
+FOUNDATION_EXTERN ZIKRouterLogLevel zix_minimumLogLevel;
+
+/// Whether the log would be written. It's false when the level is below `zix_minimumLogLevel`, or when os_log disables the type for the category.
+FOUNDATION_EXTERN bool zix_logEnabled(ZIKRouterLogCategory category, ZIKRouterLogLevel level);
+
+/// Write a formatted message with os_log, or NSLog below iOS 10, tvOS 10 and macOS 10.12. Use ZIX_LOG instead, it checks the level before formatting.
+FOUNDATION_EXTERN void zix_logMessage(ZIKRouterLogCategory category, ZIKRouterLogLevel level, NSString *message);
+
+/// Logs are compiled only in DEBUG. Define ZIKROUTER_LOG_ENABLED=1 to keep them in release builds.
+#ifndef ZIKROUTER_LOG_ENABLED
+#ifdef DEBUG
+#define ZIKROUTER_LOG_ENABLED 1
+#else
+#define ZIKROUTER_LOG_ENABLED 0
+#endif
+#endif
+
+#if ZIKROUTER_LOG_ENABLED
+/// Log a diagnostic. Arguments are only evaluated and formatted when the level and category are enabled.
+#define ZIX_LOG(CATEGORY, LEVEL, FORMAT, ...) \
+do { \
+    if (zix_logEnabled(ZIKRouterLogCategory##CATEGORY, ZIKRouterLogLevel##LEVEL)) { \
+        zix_logMessage(ZIKRouterLogCategory##CATEGORY, ZIKRouterLogLevel##LEVEL, [NSString stringWithFormat:FORMAT, ##__VA_ARGS__]); \
+    } \
+} while (0)
+#else
+#define ZIX_LOG(CATEGORY, LEVEL, FORMAT, ...) do {} while (0)
+#endif
+
+NS_ASSUME_NONNULL_END
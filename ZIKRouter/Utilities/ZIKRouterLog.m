@@ -0,0 +1,75 @@
+//
+//  ZIKRouterLog.m
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKRouterLog.h"
+#if __has_include(<os/log.h>)
+#import <os/log.h>
+#endif
+
+ZIKRouterLogLevel zix_minimumLogLevel = ZIKRouterLogLevelDebug;
+
+static const NSUInteger kLogCategoryCount = ZIKRouterLogCategoryMemoryLeak + 1;
+
+static const char *_categoryName(ZIKRouterLogCategory category) {
+    switch (category) {
+        case ZIKRouterLogCategoryRuntime: return "Runtime";
+        case ZIKRouterLogCategoryRegistry: return "Registry";
+        case ZIKRouterLogCategoryRoute: return "Route";
+        case ZIKRouterLogCategoryMemoryLeak: return "MemoryLeak";
+    }
+    return "Route";
+}
+
+#if __has_include(<os/log.h>)
+static os_log_t _logOfCategory(ZIKRouterLogCategory category) API_AVAILABLE(ios(10.0), tvos(10.0), macos(10.12)) {
+    static os_log_t logs[kLogCategoryCount];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (NSUInteger i = 0; i < kLogCategoryCount; i++) {
+            logs[i] = os_log_create("ZIKRouter", _categoryName((ZIKRouterLogCategory)i));
+        }
+    });
+    return logs[category < kLogCategoryCount ? category : ZIKRouterLogCategoryRoute];
+}
+
+static os_log_type_t _logType(ZIKRouterLogLevel level) API_AVAILABLE(ios(10.0), tvos(10.0), macos(10.12)) {
+    switch (level) {
+        case ZIKRouterLogLevelDebug: return OS_LOG_TYPE_DEBUG;
+        case ZIKRouterLogLevelInfo: return OS_LOG_TYPE_INFO;
+        case ZIKRouterLogLevelWarning: return OS_LOG_TYPE_DEFAULT;
+        case ZIKRouterLogLevelError: return OS_LOG_TYPE_ERROR;
+    }
+    return OS_LOG_TYPE_DEFAULT;
+}
+#endif
+
+bool zix_logEnabled(ZIKRouterLogCategory category, ZIKRouterLogLevel level) {
+    if (level < zix_minimumLogLevel) {
+        return false;
+    }
+#if __has_include(<os/log.h>)
+    if (@available(iOS 10.0, tvOS 10.0, macOS 10.12, *)) {
+        // Debug and info logs are disabled by os_log unless they are enabled for the subsystem, or a debugger is attached
+        return os_log_type_enabled(_logOfCategory(category), _logType(level));
+    }
+#endif
+    return true;
+}
+
+void zix_logMessage(ZIKRouterLogCategory category, ZIKRouterLogLevel level, NSString *message) {
+#if __has_include(<os/log.h>)
+    if (@available(iOS 10.0, tvOS 10.0, macOS 10.12, *)) {
+        os_log_with_type(_logOfCategory(category), _logType(level), "%{public}@", message);
+        return;
+    }
+#endif
+    NSLog(@"[ZIKRouter:%s] %@", _categoryName(category), message);
+}
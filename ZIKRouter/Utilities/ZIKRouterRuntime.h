@@ -62,21 +62,59 @@ FOUNDATION_EXTERN bool zix_classIsSubclassOfClass(Class aClass, Class parentClas
 /// Check whether a class is from Apple's system framework, or from your project.
 FOUNDATION_EXTERN bool zix_classIsCustomClass(Class aClass);
 
-/// Check whether a class self implementing a method.
+/// Check whether a class is written in Swift. It reads flags from class data, so it won't realize the class.
+FOUNDATION_EXTERN bool zix_classIsSwiftClass(Class aClass);
+
+/// Check whether a class self implementing a method. Results are cached for each class and selector, safe to call from any thread, so methods added or replaced after the first check are not noticed.
 FOUNDATION_EXTERN bool zix_classSelfImplementingMethod(Class aClass, SEL method, bool isClassMethod);
 
+/// Check whether a class or any of its superclasses below baseClass implements the method, so it doesn't use the implementation of baseClass. Use it to skip callbacks which are not overridden. Return false when aClass is not a subclass of baseClass. Results are cached like `zix_classSelfImplementingMethod`.
+FOUNDATION_EXTERN bool zix_classOverridesMethodOfClass(Class aClass, Class baseClass, SEL method, bool isClassMethod);
+
 /// Check whether an object is an objc protocol.
 FOUNDATION_EXTERN bool zix_isObjcProtocol(id protocol);
 
-/// Check whether a protocol has a parent protocol.
+/// Check whether a protocol has a parent protocol. Results are cached for each pair, safe to call from any thread.
 FOUNDATION_EXTERN bool zix_protocolConformsToProtocol(Protocol *protocol, Protocol *parentProtocol);
 
+/// Check whether a class or its superclass conforms to the protocol with `class_conformsToProtocol`. Results are cached for each pair, safe to call from any thread, so protocols added with `class_addProtocol` after the first check are not found.
+FOUNDATION_EXTERN bool zix_classConformsToProtocol(Class aClass, Protocol *protocol);
+
+/// The ancestor closest to root class that conforms to the protocol, aClass itself included. aClass and its superclasses up to the result all conform to the protocol, the superclass of the result doesn't. Return nil when aClass doesn't conform. Results are cached for each pair, safe to call from any thread.
+FOUNDATION_EXTERN Class _Nullable zix_rootClassConformingToProtocol(Class aClass, Protocol *protocol);
+
+/// Set of classes with fixed capacity. Lookup and insertion are lock-free and never allocate, safe to call from any thread. Slots of removed classes are not reused, so only remove classes of unloaded images.
+typedef struct ZIKClassSet ZIKClassSet;
+
+/// Create a class set. Capacity is rounded up to a power of 2.
+FOUNDATION_EXTERN ZIKClassSet *zix_createClassSet(size_t capacity);
+
+/// Check whether the class was added to the set.
+FOUNDATION_EXTERN bool zix_classSetContainsClass(ZIKClassSet *set, Class aClass);
+
+/// Add the class to the set. Return false when the set is full, then the caller should treat the class as not added.
+FOUNDATION_EXTERN bool zix_classSetAddClass(ZIKClassSet *set, Class aClass);
+
+/// Remove classes in the image from the set. Call it before the image is unloaded, a new class may be allocated at the same address later.
+FOUNDATION_EXTERN void zix_classSetRemoveClassesInImage(ZIKClassSet *set, const void *header);
+
 /// Return objc protocol if object is Protocol.
 FOUNDATION_EXTERN Protocol *_Nullable zix_objcProtocol(id protocol);
 
-// Test whether can use `zix_enumerateClassesInMainBundleForParentClass`. It should always be true unless layout of OC class and Mach-O is changed.
+// Test whether can use `zix_enumerateClassesInMainBundleForParentClass`. It should always be true unless layout of OC class and Mach-O is changed. Result is computed once per process.
 FOUNDATION_EXTERN BOOL zix_canEnumerateClassesInImage(void);
 
+// Test whether `__objc_classlist` of the image can be read. Result of each image is cached, safe to call from any thread.
+FOUNDATION_EXTERN BOOL zix_canEnumerateClassesInImageWithHeader(const void *header);
+
+/**
+ Whether the image may contain subclasses of the parent class, checked with the image's load commands before reading its classes. Enumeration functions below skip images returning false.
+ 
+ @discussion
+ A subclass in another image binds its superclass from a dylib it links, so an image can only contain subclasses when it's the image of parent class, or it links that image or an umbrella re-exporting it. Large SDK frameworks never linking the router framework are skipped. When parent class is in main executable or a bundle, or the image uses flat namespace, it returns true.
+ */
+FOUNDATION_EXTERN bool zix_imageMayContainSubclassOfClass(const void *header, Class parentClass);
+
 /**
  Enumerate all subclasses of the parent class in app read from section `__objc_classlist`. It's much faster than `objc_copyClassList` because it won't realize these subclasses.
  @warning
@@ -87,4 +125,64 @@ FOUNDATION_EXTERN BOOL zix_canEnumerateClassesInImage(void);
  */
 FOUNDATION_EXTERN void zix_enumerateClassesInMainBundleForParentClass(Class parentClass, void(^handler)(__unsafe_unretained Class aClass));
 
+/// Same as `zix_enumerateClassesInMainBundleForParentClass`, but scan images concurrently. Found classes are collected in per-image buffers, then handler is called on current thread in the same order as serial enumeration.
+FOUNDATION_EXTERN void zix_enumerateClassesInMainBundleForParentClassConcurrently(Class parentClass, void(^handler)(__unsafe_unretained Class aClass));
+
+/**
+ Enumerate all subclasses of the parent class in app with `objc_copyClassNamesForImage`. It's the fallback when `zix_canEnumerateClassesInImage` is false. It's slower than reading `__objc_classlist`, but still only walks images of app, not all classes in system frameworks like `objc_copyClassList`.
+ 
+ @param parentClass Parent class for enumeration
+ @param handler Handler for subclasses
+ @return Whether class names of main executable can be listed. If it's false, use `zix_enumerateClassList` instead.
+ */
+FOUNDATION_EXTERN BOOL zix_enumerateClassesInCustomImagesForParentClass(Class parentClass, void(^handler)(__unsafe_unretained Class aClass));
+
+/**
+ Enumerate classes whose names are written in section `__DATA,sectionName` of each image in app. It only reads the section, won't walk the class list.
+
+ @param sectionName Section name in `__DATA` segment, storing `const char *` class names.
+ @param handler Handler for found classes.
+ */
+FOUNDATION_EXTERN void zix_enumerateClassesInSection(const char *sectionName, void(^handler)(__unsafe_unretained Class aClass));
+
+/// Same as `zix_enumerateClassesInMainBundleForParentClass`, but only read `__objc_classlist` of the image. When `zix_canEnumerateClassesInImageWithHeader` is false, it uses class names of the image instead.
+FOUNDATION_EXTERN void zix_enumerateClassesInImageForParentClass(const void *header, Class parentClass, void(^handler)(__unsafe_unretained Class aClass));
+
+/// Same as `zix_enumerateClassesInSection`, but only read the section of the image.
+FOUNDATION_EXTERN void zix_enumerateClassesInImageSection(const void *header, const char *sectionName, void(^handler)(__unsafe_unretained Class aClass));
+
+/// Whether the image has a non-empty section in `__DATA` segment.
+FOUNDATION_EXTERN bool zix_imageHasSection(const void *header, const char *sectionName);
+
+/// Enumerate mach headers of loaded images in app, images of system frameworks and dynamic libraries are ignored.
+FOUNDATION_EXTERN void zix_enumerateCustomImages(void(^handler)(const void *header));
+
+/// Mach header of the image containing the class. Return NULL for classes created at runtime.
+FOUNDATION_EXTERN const void *_Nullable zix_imageHeaderOfClass(Class aClass);
+
+/// Mach header of the image containing the address. Return NULL for heap memory and addresses not in any image.
+FOUNDATION_EXTERN const void *_Nullable zix_imageHeaderOfAddress(const void *_Nullable address);
+
+/// Mach header of the image containing the code of the block. Heap blocks copied from a block literal still point to the code in its image.
+FOUNDATION_EXTERN const void *_Nullable zix_imageHeaderOfBlock(id block);
+
+/// Remove classes and protocols in the image from caches of `zix_classIsCustomClass`, `zix_classSelfImplementingMethod` and conformance checking functions. Call it before the image is unloaded.
+FOUNDATION_EXTERN void zix_evictRuntimeCachesInImage(const void *header);
+
+/// UUID in `LC_UUID` load command of the image. It changes whenever the binary is rebuilt with different content.
+FOUNDATION_EXTERN NSString *_Nullable zix_imageUUIDString(const void *header);
+
+/**
+ Observe images loaded after this call with `_dyld_register_func_for_add_image`, such as frameworks loaded by `dlopen`. Images of system frameworks and dynamic libraries are ignored. Only call it once.
+ 
+ @param handler Handler for mach header of the added image, called on the thread loading the image.
+ */
+FOUNDATION_EXTERN void zix_observeAddedImages(void(^handler)(const void *header));
+
+/// Global concurrent queue of the QoS class. Before iOS 8, where QoS classes are not supported, return the global queue of the closest priority.
+FOUNDATION_EXTERN dispatch_queue_t zix_globalQueueWithQOS(qos_class_t qos);
+
+/// Create a serial queue of the QoS class. Before iOS 8, the queue targets the global queue of the closest priority.
+FOUNDATION_EXTERN dispatch_queue_t zix_createSerialQueueWithQOS(const char *label, qos_class_t qos);
+
 NS_ASSUME_NONNULL_END
@@ -10,8 +10,12 @@
 //
 
 #import "ZIKRouterRuntime.h"
+#import "ZIKRouterLog.h"
 #import <objc/runtime.h>
 #import <dlfcn.h>
+#if __has_feature(ptrauth_calls)
+#include <ptrauth.h>
+#endif
 #include <mach-o/dyld.h>
 
 bool zix_replaceMethodWithMethod(Class originalClass, SEL originalSelector, Class swizzledClass, SEL swizzledSelector) {
@@ -30,7 +34,7 @@ bool zix_replaceMethodWithMethod(Class originalClass, SEL originalSelector, Clas
         //        originalClass = objc_getMetaClass(object_getClassName(originalClass));
     }
     if (!originalMethod) {
-        NSLog(@"replace failed, can't find original method:%@",NSStringFromSelector(originalSelector));
+        ZIX_LOG(Runtime, Error, @"replace failed, can't find original method:%@",NSStringFromSelector(originalSelector));
         return false;
     }
     
@@ -38,7 +42,7 @@ bool zix_replaceMethodWithMethod(Class originalClass, SEL originalSelector, Clas
         swizzledMethod = class_getClassMethod(swizzledClass, swizzledSelector);
     }
     if (!swizzledMethod) {
-        NSLog(@"replace failed, can't find swizzled method:%@",NSStringFromSelector(swizzledSelector));
+        ZIX_LOG(Runtime, Error, @"replace failed, can't find swizzled method:%@",NSStringFromSelector(swizzledSelector));
         return false;
     }
     
@@ -55,7 +59,7 @@ bool zix_replaceMethodWithMethod(Class originalClass, SEL originalSelector, Clas
     const char *originalType = method_getTypeEncoding(originalMethod);
     const char *swizzledType = method_getTypeEncoding(swizzledMethod);
     if (strcmp(originalType, swizzledType) != 0) {
-        NSLog(@"warning：method signature not match, please confirm！original method:%@\n signature:%s\nswizzled method:%@\nsignature:%s",NSStringFromSelector(originalSelector),originalType,NSStringFromSelector(swizzledSelector),swizzledType);
+        ZIX_LOG(Runtime, Warning, @"warning：method signature not match, please confirm！original method:%@\n signature:%s\nswizzled method:%@\nsignature:%s",NSStringFromSelector(originalSelector),originalType,NSStringFromSelector(swizzledSelector),swizzledType);
         swizzledType = originalType;
     }
     class_replaceMethod(originalClass,swizzledSelector,originalIMP,originalType);
@@ -84,11 +88,11 @@ bool zix_replaceMethodWithMethodType(Class originalClass, SEL originalSelector,
         swizzledMethod = class_getInstanceMethod(swizzledClass, swizzledSelector);
     }
     if (!originalMethod) {
-        NSLog(@"replace failed, can't find original method:%@",NSStringFromSelector(originalSelector));
+        ZIX_LOG(Runtime, Error, @"replace failed, can't find original method:%@",NSStringFromSelector(originalSelector));
         return false;
     }
     if (!swizzledMethod) {
-        NSLog(@"replace failed, can't find swizzled method:%@",NSStringFromSelector(swizzledSelector));
+        ZIX_LOG(Runtime, Error, @"replace failed, can't find swizzled method:%@",NSStringFromSelector(swizzledSelector));
         return false;
     }
     
@@ -103,7 +107,7 @@ bool zix_replaceMethodWithMethodType(Class originalClass, SEL originalSelector,
     const char *originalType = method_getTypeEncoding(originalMethod);
     const char *swizzledType = method_getTypeEncoding(swizzledMethod);
     if (strcmp(originalType, swizzledType) != 0) {
-        NSLog(@"warning：method signature not match, please confirm！original method:%@\n signature:%s\nswizzled method:%@\nsignature:%s",NSStringFromSelector(originalSelector),originalType,NSStringFromSelector(swizzledSelector),swizzledType);
+        ZIX_LOG(Runtime, Warning, @"warning：method signature not match, please confirm！original method:%@\n signature:%s\nswizzled method:%@\nsignature:%s",NSStringFromSelector(originalSelector),originalType,NSStringFromSelector(swizzledSelector),swizzledType);
         swizzledType = originalType;
     }
     class_replaceMethod(originalClass,swizzledSelector,originalIMP,originalType);
@@ -164,30 +168,155 @@ bool zix_classIsSubclassOfClass(Class aClass, Class parentClass) {
     return true;
 }
 
+static bool _pathIsSystemPath(const char *path) {
+    return strstr(path, "/System/Library/") != NULL || strstr(path, "/usr/") != NULL;
+}
+
+static bool _checkClassIsCustomClass(Class aClass) {
+    // Image of the class is its bundle's executable, dladdr only reads loaded images without creating NSBundle
+    Dl_info info;
+    if (dladdr((__bridge const void *)aClass, &info) && info.dli_fname) {
+        return !_pathIsSystemPath(info.dli_fname);
+    }
+    // Classes created at runtime are not in any image
+    NSString *bundlePath = [[NSBundle bundleForClass:aClass] bundlePath];
+    return !_pathIsSystemPath(bundlePath.UTF8String ?: "");
+}
+
+/// Values are 1 for custom class and 2 for system class, guarded by _customClassesSema. Classes of an unloaded image are removed in zix_evictRuntimeCachesInImage.
+static CFMutableDictionaryRef _customClasses;
+static dispatch_semaphore_t _customClassesSema;
+
+static void _initCustomClasses(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _customClasses = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+        _customClassesSema = dispatch_semaphore_create(1);
+    });
+}
+
 bool zix_classIsCustomClass(Class aClass) {
     NSCParameterAssert(aClass);
     if (!aClass) {
         return false;
     }
-    NSString *bundlePath = [[NSBundle bundleForClass:aClass] bundlePath];
-    if ([bundlePath rangeOfString:@"/System/Library/"].length != 0) {
-        return false;
+    _initCustomClasses();
+    const void *key = (__bridge const void *)aClass;
+    dispatch_semaphore_wait(_customClassesSema, DISPATCH_TIME_FOREVER);
+    uintptr_t value = (uintptr_t)CFDictionaryGetValue(_customClasses, key);
+    dispatch_semaphore_signal(_customClassesSema);
+    if (value != 0) {
+        return value == 1;
     }
-    if ([bundlePath rangeOfString:@"/usr/"].length != 0) {
-        return false;
+    bool isCustom = _checkClassIsCustomClass(aClass);
+    dispatch_semaphore_wait(_customClassesSema, DISPATCH_TIME_FOREVER);
+    CFDictionarySetValue(_customClasses, key, (const void *)(uintptr_t)(isCustom ? 1 : 2));
+    dispatch_semaphore_signal(_customClassesSema);
+    return isCustom;
+}
+
+/// Cache of conformance results. Key is the type, value is a dictionary from protocol to 1 for conforming and 2 for not conforming, or other values defined by the caller. Types and protocols of an unloaded image are removed in zix_evictRuntimeCachesInImage.
+typedef struct {
+    CFMutableDictionaryRef results;
+    dispatch_semaphore_t sema;
+} ZIKConformanceCache;
+
+/// All created conformance caches, so they can be evicted together. Caches are created once and never freed.
+static const size_t ZIKConformanceCacheCapacity = 8;
+static ZIKConformanceCache *_conformanceCaches[ZIKConformanceCacheCapacity];
+static size_t _conformanceCacheCount = 0;
+
+static uintptr_t _conformanceCacheGetValue(ZIKConformanceCache *cache, const void *type, const void *protocol) {
+    uintptr_t value = 0;
+    dispatch_semaphore_wait(cache->sema, DISPATCH_TIME_FOREVER);
+    CFDictionaryRef protocolResults = CFDictionaryGetValue(cache->results, type);
+    if (protocolResults) {
+        value = (uintptr_t)CFDictionaryGetValue(protocolResults, protocol);
     }
-    return true;
+    dispatch_semaphore_signal(cache->sema);
+    return value;
 }
 
-bool zix_classSelfImplementingMethod(Class aClass, SEL method, bool isClassMethod) {
-    NSCParameterAssert(aClass);
-    NSCParameterAssert(method);
-    if (!aClass) {
-        return false;
+static void _conformanceCacheSetRawValue(ZIKConformanceCache *cache, const void *type, const void *protocol, uintptr_t value) {
+    dispatch_semaphore_wait(cache->sema, DISPATCH_TIME_FOREVER);
+    CFMutableDictionaryRef protocolResults = (CFMutableDictionaryRef)CFDictionaryGetValue(cache->results, type);
+    if (protocolResults == NULL) {
+        protocolResults = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+        CFDictionarySetValue(cache->results, type, protocolResults);
+        CFRelease(protocolResults);
     }
-    if (!method) {
-        return false;
+    CFDictionarySetValue(protocolResults, protocol, (const void *)value);
+    dispatch_semaphore_signal(cache->sema);
+}
+
+static void _conformanceCacheSetValue(ZIKConformanceCache *cache, const void *type, const void *protocol, bool conforms) {
+    _conformanceCacheSetRawValue(cache, type, protocol, conforms ? 1 : 2);
+}
+
+static ZIKConformanceCache *_createConformanceCache(void) {
+    ZIKConformanceCache *cache = malloc(sizeof(ZIKConformanceCache));
+    cache->results = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    cache->sema = dispatch_semaphore_create(1);
+    size_t index = __atomic_fetch_add(&_conformanceCacheCount, 1, __ATOMIC_RELAXED);
+    NSCAssert(index < ZIKConformanceCacheCapacity, @"Too many conformance caches");
+    if (index < ZIKConformanceCacheCapacity) {
+        __atomic_store_n(&_conformanceCaches[index], cache, __ATOMIC_RELEASE);
+    }
+    return cache;
+}
+
+static inline bool _addressIsInImage(uintptr_t address, const void *header) {
+    // Small values are results, not types
+    return address > 2 && zix_imageHeaderOfAddress((const void *)address) == header;
+}
+
+static void _removeKeysInImage(CFMutableDictionaryRef map, const void *header, bool checksValues) {
+    CFIndex count = CFDictionaryGetCount(map);
+    if (count == 0) {
+        return;
+    }
+    const void **keys = malloc(sizeof(void *) * count * 2);
+    if (keys == NULL) {
+        return;
+    }
+    const void **values = keys + count;
+    CFDictionaryGetKeysAndValues(map, keys, values);
+    for (CFIndex i = 0; i < count; i++) {
+        if (_addressIsInImage((uintptr_t)keys[i], header) || (checksValues && _addressIsInImage((uintptr_t)values[i], header))) {
+            CFDictionaryRemoveValue(map, keys[i]);
+        }
+    }
+    free(keys);
+}
+
+static void _applyEvictConformanceResults(const void *type, const void *protocolResults, void *header) {
+    _removeKeysInImage((CFMutableDictionaryRef)protocolResults, header, true);
+}
+
+void zix_evictRuntimeCachesInImage(const void *header) {
+    if (header == NULL) {
+        return;
+    }
+    if (_customClasses) {
+        dispatch_semaphore_wait(_customClassesSema, DISPATCH_TIME_FOREVER);
+        _removeKeysInImage(_customClasses, header, false);
+        dispatch_semaphore_signal(_customClassesSema);
+    }
+    size_t count = MIN(__atomic_load_n(&_conformanceCacheCount, __ATOMIC_RELAXED), ZIKConformanceCacheCapacity);
+    for (size_t i = 0; i < count; i++) {
+        ZIKConformanceCache *cache = __atomic_load_n(&_conformanceCaches[i], __ATOMIC_ACQUIRE);
+        if (cache == NULL) {
+            continue;
+        }
+        dispatch_semaphore_wait(cache->sema, DISPATCH_TIME_FOREVER);
+        _removeKeysInImage(cache->results, header, false);
+        // Protocols and results, such as root classes, may also be in the image
+        CFDictionaryApplyFunction(cache->results, _applyEvictConformanceResults, (void *)header);
+        dispatch_semaphore_signal(cache->sema);
     }
+}
+
+static bool _classSelfImplementingMethod(Class aClass, SEL method, bool isClassMethod) {
     Method selfMethod;
     if (!isClassMethod) {
         selfMethod = class_getInstanceMethod(aClass, method);
@@ -213,6 +342,48 @@ bool zix_classSelfImplementingMethod(Class aClass, SEL method, bool isClassMetho
     return method_getImplementation(selfMethod) != method_getImplementation(superMethod);
 }
 
+bool zix_classSelfImplementingMethod(Class aClass, SEL method, bool isClassMethod) {
+    NSCParameterAssert(aClass);
+    NSCParameterAssert(method);
+    if (!aClass) {
+        return false;
+    }
+    if (!method) {
+        return false;
+    }
+    static ZIKConformanceCache *instanceMethodCache;
+    static ZIKConformanceCache *classMethodCache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instanceMethodCache = _createConformanceCache();
+        classMethodCache = _createConformanceCache();
+    });
+    ZIKConformanceCache *cache = isClassMethod ? classMethodCache : instanceMethodCache;
+    const void *key = (__bridge const void *)aClass;
+    uintptr_t value = _conformanceCacheGetValue(cache, key, method);
+    if (value != 0) {
+        return value == 1;
+    }
+    bool implementing = _classSelfImplementingMethod(aClass, method, isClassMethod);
+    _conformanceCacheSetValue(cache, key, method, implementing);
+    return implementing;
+}
+
+bool zix_classOverridesMethodOfClass(Class aClass, Class baseClass, SEL method, bool isClassMethod) {
+    if (aClass == nil || baseClass == nil || method == nil) {
+        return false;
+    }
+    // Walk until baseClass with cached results, instead of comparing IMPs every time
+    bool overrides = false;
+    while (aClass && aClass != baseClass) {
+        if (!overrides && zix_classSelfImplementingMethod(aClass, method, isClassMethod)) {
+            overrides = true;
+        }
+        aClass = class_getSuperclass(aClass);
+    }
+    return overrides && aClass == baseClass;
+}
+
 bool zix_isObjcProtocol(id protocol) {
     static Class ProtocolClass;
     static dispatch_once_t onceToken;
@@ -222,7 +393,7 @@ bool zix_isObjcProtocol(id protocol) {
     return [protocol isKindOfClass:ProtocolClass];
 }
 
-bool zix_protocolConformsToProtocol(Protocol *protocol, Protocol *parentProtocol) {
+static bool _protocolConformsToProtocol(Protocol *protocol, Protocol *parentProtocol) {
     unsigned int count;
     Protocol * __unsafe_unretained _Nonnull *list = protocol_copyProtocolList(protocol, &count);
     if (list == NULL) {
@@ -243,6 +414,165 @@ bool zix_protocolConformsToProtocol(Protocol *protocol, Protocol *parentProtocol
     return result;
 }
 
+static bool _classConformsToProtocol(Class aClass, Protocol *protocol) {
+    while (aClass) {
+        if (class_conformsToProtocol(aClass, protocol)) {
+            return true;
+        }
+        aClass = class_getSuperclass(aClass);
+    }
+    return false;
+}
+
+bool zix_protocolConformsToProtocol(Protocol *protocol, Protocol *parentProtocol) {
+    if (protocol == nil || parentProtocol == nil) {
+        return false;
+    }
+    static ZIKConformanceCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = _createConformanceCache();
+    });
+    const void *key = (__bridge const void *)protocol;
+    const void *parentKey = (__bridge const void *)parentProtocol;
+    uintptr_t value = _conformanceCacheGetValue(cache, key, parentKey);
+    if (value != 0) {
+        return value == 1;
+    }
+    // Recursion for parent protocols is not inside the lock, and fills the cache for them too
+    bool conforms = _protocolConformsToProtocol(protocol, parentProtocol);
+    _conformanceCacheSetValue(cache, key, parentKey, conforms);
+    return conforms;
+}
+
+bool zix_classConformsToProtocol(Class aClass, Protocol *protocol) {
+    if (aClass == nil || protocol == nil) {
+        return false;
+    }
+    static ZIKConformanceCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = _createConformanceCache();
+    });
+    const void *key = (__bridge const void *)aClass;
+    const void *protocolKey = (__bridge const void *)protocol;
+    uintptr_t value = _conformanceCacheGetValue(cache, key, protocolKey);
+    if (value != 0) {
+        return value == 1;
+    }
+    bool conforms = _classConformsToProtocol(aClass, protocol);
+    _conformanceCacheSetValue(cache, key, protocolKey, conforms);
+    return conforms;
+}
+
+static Class _rootClassConformingToProtocol(Class aClass, Protocol *protocol) {
+    Class root = nil;
+    while (aClass) {
+        if (class_conformsToProtocol(aClass, protocol)) {
+            root = aClass;
+        }
+        aClass = class_getSuperclass(aClass);
+    }
+    return root;
+}
+
+Class _Nullable zix_rootClassConformingToProtocol(Class aClass, Protocol *protocol) {
+    if (aClass == nil || protocol == nil) {
+        return nil;
+    }
+    static ZIKConformanceCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = _createConformanceCache();
+    });
+    const void *key = (__bridge const void *)aClass;
+    const void *protocolKey = (__bridge const void *)protocol;
+    // Value is the root class, or 1 when no class conforms. Classes are aligned, so 1 is never a class.
+    uintptr_t value = _conformanceCacheGetValue(cache, key, protocolKey);
+    if (value != 0) {
+        return value == 1 ? nil : (__bridge Class)(void *)value;
+    }
+    Class root = _rootClassConformingToProtocol(aClass, protocol);
+    _conformanceCacheSetRawValue(cache, key, protocolKey, root ? (uintptr_t)(__bridge void *)root : 1);
+    return root;
+}
+
+struct ZIKClassSet {
+    size_t mask;
+    uintptr_t slots[];
+};
+
+/// Slot of a removed class. Probing continues through it, and it's never reused.
+static const uintptr_t ZIKClassSetRemovedSlot = 1;
+
+ZIKClassSet *zix_createClassSet(size_t capacity) {
+    size_t size = 16;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    ZIKClassSet *set = calloc(1, sizeof(ZIKClassSet) + size * sizeof(uintptr_t));
+    set->mask = size - 1;
+    return set;
+}
+
+static inline size_t _classSetIndex(ZIKClassSet *set, uintptr_t key) {
+    // Classes are 8 or 16 bytes aligned, mix high bits into the low bits
+    return (size_t)((key >> 4) * 0x9E3779B97F4A7C15ULL >> 32) & set->mask;
+}
+
+bool zix_classSetContainsClass(ZIKClassSet *set, Class aClass) {
+    uintptr_t key = (uintptr_t)(__bridge void *)aClass;
+    if (key == 0) {
+        return false;
+    }
+    size_t index = _classSetIndex(set, key);
+    for (size_t probe = 0; probe <= set->mask; probe++) {
+        uintptr_t slot = __atomic_load_n(&set->slots[index], __ATOMIC_ACQUIRE);
+        if (slot == key) {
+            return true;
+        }
+        if (slot == 0) {
+            return false;
+        }
+        index = (index + 1) & set->mask;
+    }
+    return false;
+}
+
+void zix_classSetRemoveClassesInImage(ZIKClassSet *set, const void *header) {
+    if (set == NULL || header == NULL) {
+        return;
+    }
+    for (size_t index = 0; index <= set->mask; index++) {
+        uintptr_t slot = __atomic_load_n(&set->slots[index], __ATOMIC_ACQUIRE);
+        if (slot > ZIKClassSetRemovedSlot && zix_imageHeaderOfAddress((const void *)slot) == header) {
+            __atomic_compare_exchange_n(&set->slots[index], &slot, ZIKClassSetRemovedSlot, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+        }
+    }
+}
+
+bool zix_classSetAddClass(ZIKClassSet *set, Class aClass) {
+    uintptr_t key = (uintptr_t)(__bridge void *)aClass;
+    if (key == 0) {
+        return false;
+    }
+    size_t index = _classSetIndex(set, key);
+    for (size_t probe = 0; probe <= set->mask; probe++) {
+        uintptr_t slot = __atomic_load_n(&set->slots[index], __ATOMIC_ACQUIRE);
+        if (slot == 0) {
+            if (__atomic_compare_exchange_n(&set->slots[index], &slot, key, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                return true;
+            }
+            // Another thread took the slot, check what it inserted
+        }
+        if (slot == key) {
+            return true;
+        }
+        index = (index + 1) & set->mask;
+    }
+    return false;
+}
+
 Protocol *_Nullable zix_objcProtocol(id protocol) {
     if (zix_isObjcProtocol(protocol)) {
         return (Protocol *)protocol;
@@ -333,6 +663,17 @@ class_ro_t *ro_of_class(class_t *cls) {
     return (class_ro_t *)(cls->data_NEVER_USE & FAST_DATA_MASK);
 }
 
+// class is a Swift class from stable Swift ABI
+#define FAST_IS_SWIFT_STABLE    (1UL<<1)
+
+bool zix_classIsSwiftClass(Class aClass) {
+    if (aClass == nil) {
+        return false;
+    }
+    class_t *cls = (__bridge class_t *)aClass;
+    return (cls->data_NEVER_USE & (FAST_IS_SWIFT | FAST_IS_SWIFT_STABLE)) != 0;
+}
+
 #import <mach-o/getsect.h>
 #include <mach-o/dyld.h>
 
@@ -351,6 +692,13 @@ static void enumerateImages(void(^handler)(const mach_header_xx *mh, const char
     }
 }
 
+// Skip images of system frameworks and dynamic libraries
+static bool imageIsCustomImage(const char *path) {
+    return strstr(path, "/System/Library/") == NULL &&
+    strstr(path, "/usr/") == NULL &&
+    strstr(path, ".dylib") == NULL;
+}
+
 // Check that objc class layout is not changed
 static BOOL canReadSuperclassOfClass(Class aClass) {
     class_t *cls = (__bridge class_t *)aClass;
@@ -365,42 +713,77 @@ static BOOL canReadSuperclassOfClass(Class aClass) {
     return YES;
 }
 
-BOOL zix_canEnumerateClassesInImage() {
-    if (canReadSuperclassOfClass([NSObject class]) == NO) {
+// Check that the first class in `__objc_classlist` of the image is readable
+static BOOL canEnumerateClassesInImageHeader(const mach_header_xx *mh) {
+#ifndef __LP64__
+    const struct section *section = getsectbynamefromheader(mh, "__DATA", "__objc_classlist");
+    if (section == NULL) {
         return NO;
     }
-    NSString *mainBundlePath = [NSBundle mainBundle].executablePath;
-    for (uint32_t i = 0, count = _dyld_image_count(); i < count; i++) {
-        const char *path = _dyld_get_image_name(i);
-        if (strcmp(path, mainBundlePath.UTF8String) == 0) {
-            const mach_header_xx *mh = (const mach_header_xx *)_dyld_get_image_header(i);
-#ifndef __LP64__
-            const struct section *section = getsectbynamefromheader(mh, "__DATA", "__objc_classlist");
-            if (section == NULL) {
-                return NO;
-            }
-            uint32_t size = section->size;
+    uint32_t size = section->size;
 #else
-            const struct section_64 *section = getsectbynamefromheader_64(mh, "__DATA", "__objc_classlist");
-            if (section == NULL) {
-                return NO;
-            }
-            uint64_t size = section->size;
+    const struct section_64 *section = getsectbynamefromheader_64(mh, "__DATA", "__objc_classlist");
+    if (section == NULL) {
+        return NO;
+    }
+    uint64_t size = section->size;
 #endif
-            if (size > 0) {
-                char *imageBaseAddress = (char *)mh;
-                Class *classReferences = (Class *)(void *)(imageBaseAddress + ((uintptr_t)section->offset&0xffffffff));
-                Class firstClass = classReferences[0];
-                if (canReadSuperclassOfClass(firstClass) == NO) {
-                    return NO;
-                }
-            }
-            break;
+    if (size > 0) {
+        char *imageBaseAddress = (char *)mh;
+        Class *classReferences = (Class *)(void *)(imageBaseAddress + ((uintptr_t)section->offset&0xffffffff));
+        Class firstClass = classReferences[0];
+        if (canReadSuperclassOfClass(firstClass) == NO) {
+            return NO;
         }
     }
     return YES;
 }
 
+static BOOL _canReadObjcClassLayout;
+/// key: mach header, value: kCFBooleanTrue or kCFBooleanFalse.
+static CFMutableDictionaryRef _imageEnumerationCapabilities;
+static dispatch_semaphore_t _imageEnumerationCapabilitiesSema;
+
+static void initImageEnumerationCapabilities(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _canReadObjcClassLayout = canReadSuperclassOfClass([NSObject class]);
+        _imageEnumerationCapabilities = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+        _imageEnumerationCapabilitiesSema = dispatch_semaphore_create(1);
+    });
+}
+
+BOOL zix_canEnumerateClassesInImageWithHeader(const void *header) {
+    if (header == NULL) {
+        return NO;
+    }
+    initImageEnumerationCapabilities();
+    if (_canReadObjcClassLayout == NO) {
+        return NO;
+    }
+    dispatch_semaphore_wait(_imageEnumerationCapabilitiesSema, DISPATCH_TIME_FOREVER);
+    const void *capability = CFDictionaryGetValue(_imageEnumerationCapabilities, header);
+    dispatch_semaphore_signal(_imageEnumerationCapabilitiesSema);
+    if (capability == NULL) {
+        // Probing twice in a race is harmless, the result is the same
+        capability = canEnumerateClassesInImageHeader((const mach_header_xx *)header) ? kCFBooleanTrue : kCFBooleanFalse;
+        dispatch_semaphore_wait(_imageEnumerationCapabilitiesSema, DISPATCH_TIME_FOREVER);
+        CFDictionarySetValue(_imageEnumerationCapabilities, header, capability);
+        dispatch_semaphore_signal(_imageEnumerationCapabilitiesSema);
+    }
+    return capability == kCFBooleanTrue;
+}
+
+BOOL zix_canEnumerateClassesInImage() {
+    static BOOL canEnumerate;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        // dyld always puts main executable at index 0
+        canEnumerate = _dyld_image_count() > 0 && zix_canEnumerateClassesInImageWithHeader(_dyld_get_image_header(0));
+    });
+    return canEnumerate;
+}
+
 static void enumerateClassesInImage(const mach_header_xx *mh, void(^handler)(Class __unsafe_unretained aClass)) {
     if (handler == nil) {
         return;
@@ -428,6 +811,153 @@ static void enumerateClassesInImage(const mach_header_xx *mh, void(^handler)(Cla
     }
 }
 
+static void enumerateLoadCommands(const mach_header_xx *mh, void(^handler)(const struct load_command *command, bool *stop)) {
+    const struct load_command *command = (const struct load_command *)(const void *)((const char *)mh + sizeof(mach_header_xx));
+    bool stop = false;
+    for (uint32_t i = 0; i < mh->ncmds && !stop; i++) {
+        handler(command, &stop);
+        command = (const struct load_command *)(const void *)((const char *)command + command->cmdsize);
+    }
+}
+
+static const char *dylibNameOfCommand(const struct load_command *command) {
+    const struct dylib_command *dylibCommand = (const struct dylib_command *)(const void *)command;
+    return (const char *)command + dylibCommand->dylib.name.offset;
+}
+
+static const char *installNameOfImage(const mach_header_xx *mh) {
+    __block const char *installName = NULL;
+    enumerateLoadCommands(mh, ^(const struct load_command *command, bool *stop) {
+        if (command->cmd == LC_ID_DYLIB) {
+            installName = dylibNameOfCommand(command);
+            *stop = true;
+        }
+    });
+    return installName;
+}
+
+static Boolean cStringEqual(const void *value1, const void *value2) {
+    return strcmp((const char *)value1, (const char *)value2) == 0;
+}
+
+static CFHashCode cStringHash(const void *value) {
+    // FNV-1a
+    CFHashCode hash = 2166136261u;
+    for (const unsigned char *c = (const unsigned char *)value; *c; c++) {
+        hash = (hash ^ *c) * 16777619u;
+    }
+    return hash;
+}
+
+/// Whether the image links any dylib in the set, directly or as an upward or weak dependency.
+static bool imageLinksAnyDylib(const mach_header_xx *mh, CFSetRef installNames) {
+    __block bool links = false;
+    enumerateLoadCommands(mh, ^(const struct load_command *command, bool *stop) {
+        switch (command->cmd) {
+            case LC_LOAD_DYLIB:
+            case LC_LOAD_WEAK_DYLIB:
+            case LC_REEXPORT_DYLIB:
+            case LC_LAZY_LOAD_DYLIB:
+            case LC_LOAD_UPWARD_DYLIB:
+                if (CFSetContainsValue(installNames, dylibNameOfCommand(command))) {
+                    links = true;
+                    *stop = true;
+                }
+                break;
+            default:
+                break;
+        }
+    });
+    return links;
+}
+
+/// Dylibs whose classes may be subclasses of the parent class. A subclass in another image binds its superclass from a dylib it links, so the set is the image of parent class and custom dylibs linking any dylib in the set, transitively, such as a framework of base routers.
+typedef struct {
+    const mach_header_xx *parentImage;
+    /// Install names of those dylibs. NULL when parent class is not in a dylib, then all images are scanned.
+    CFMutableSetRef installNames;
+} ZIKImagePrefilter;
+
+static ZIKImagePrefilter makeImagePrefilter(Class parentClass) {
+    ZIKImagePrefilter filter = {NULL, NULL};
+    Dl_info info;
+    if (dladdr((__bridge const void *)parentClass, &info) == 0 || info.dli_fbase == NULL) {
+        return filter;
+    }
+    filter.parentImage = (const mach_header_xx *)info.dli_fbase;
+    if (filter.parentImage->filetype != MH_DYLIB) {
+        return filter;
+    }
+    const char *parentInstallName = installNameOfImage(filter.parentImage);
+    if (parentInstallName == NULL) {
+        return filter;
+    }
+    CFSetCallBacks callbacks = {0, NULL, NULL, NULL, cStringEqual, cStringHash};
+    CFMutableSetRef installNames = CFSetCreateMutable(kCFAllocatorDefault, 0, &callbacks);
+    CFSetAddValue(installNames, parentInstallName);
+    
+    NSMutableArray<NSValue *> *dylibs = [NSMutableArray array];
+    enumerateImages(^(const mach_header_xx *mh, const char *path) {
+        if (mh->filetype == MH_DYLIB && mh != filter.parentImage && imageIsCustomImage(path)) {
+            [dylibs addObject:[NSValue valueWithPointer:mh]];
+        }
+    });
+    // Dependencies are usually shallow, this ends in a few passes
+    BOOL changed = YES;
+    while (changed) {
+        changed = NO;
+        for (NSInteger i = dylibs.count - 1; i >= 0; i--) {
+            const mach_header_xx *mh = (const mach_header_xx *)dylibs[i].pointerValue;
+            if (!imageLinksAnyDylib(mh, installNames)) {
+                continue;
+            }
+            const char *installName = installNameOfImage(mh);
+            if (installName) {
+                CFSetAddValue(installNames, installName);
+            }
+            [dylibs removeObjectAtIndex:i];
+            changed = YES;
+        }
+    }
+    filter.installNames = installNames;
+    return filter;
+}
+
+static void releaseImagePrefilter(ZIKImagePrefilter *filter) {
+    if (filter->installNames) {
+        CFRelease(filter->installNames);
+        filter->installNames = NULL;
+    }
+}
+
+/// Whether the image may contain subclasses of the parent class, only checking the image's load commands. False positive is possible, false negative is not.
+static bool imageMayContainSubclass(const mach_header_xx *mh, const ZIKImagePrefilter *filter) {
+    if (filter->installNames == NULL || mh == filter->parentImage) {
+        return true;
+    }
+    if (mh->filetype == MH_BUNDLE || (mh->flags & MH_TWOLEVEL) == 0) {
+        // Bundles can bind symbols from the bundle loader without linking it, and flat namespace images can bind symbols from any image
+        return true;
+    }
+    if (mh->filetype == MH_DYLIB) {
+        const char *installName = installNameOfImage(mh);
+        if (installName && CFSetContainsValue(filter->installNames, installName)) {
+            return true;
+        }
+    }
+    return imageLinksAnyDylib(mh, filter->installNames);
+}
+
+bool zix_imageMayContainSubclassOfClass(const void *header, Class parentClass) {
+    if (header == NULL || parentClass == nil) {
+        return false;
+    }
+    ZIKImagePrefilter filter = makeImagePrefilter(parentClass);
+    bool mayContain = imageMayContainSubclass((const mach_header_xx *)header, &filter);
+    releaseImagePrefilter(&filter);
+    return mayContain;
+}
+
 static bool classIsSubclassOfClass(class_t *cls, class_t *parentClass) {
     if (cls == NULL || parentClass == NULL) {
         return false;
@@ -447,10 +977,9 @@ void zix_enumerateClassesInMainBundleForParentClass(Class parentClass, void(^han
         return;
     }
     struct class_t *parent = (__bridge struct class_t *)(parentClass);
+    ZIKImagePrefilter filter = makeImagePrefilter(parentClass);
     enumerateImages(^(const mach_header_xx *mh, const char *path) {
-        if (strstr(path, "/System/Library/") != NULL ||
-            strstr(path, "/usr/") != NULL ||
-            strstr(path, ".dylib") != NULL) {
+        if (!imageIsCustomImage(path) || !imageMayContainSubclass(mh, &filter)) {
             return;
         }
         enumerateClassesInImage(mh, ^(__unsafe_unretained Class aClass) {
@@ -459,4 +988,277 @@ void zix_enumerateClassesInMainBundleForParentClass(Class parentClass, void(^han
             }
         });
     });
+    releaseImagePrefilter(&filter);
+}
+
+void zix_enumerateClassesInMainBundleForParentClassConcurrently(Class parentClass, void(^handler)(__unsafe_unretained Class aClass)) {
+    if (handler == nil) {
+        return;
+    }
+    struct class_t *parent = (__bridge struct class_t *)(parentClass);
+    ZIKImagePrefilter filter = makeImagePrefilter(parentClass);
+    NSMutableArray<NSValue *> *images = [NSMutableArray array];
+    enumerateImages(^(const mach_header_xx *mh, const char *path) {
+        if (imageIsCustomImage(path) && imageMayContainSubclass(mh, &filter)) {
+            [images addObject:[NSValue valueWithPointer:mh]];
+        }
+    });
+    releaseImagePrefilter(&filter);
+    size_t count = images.count;
+    if (count == 0) {
+        return;
+    }
+    // One buffer for each image, so workers don't share any mutable state. Classes are never released, buffers don't retain them.
+    CFMutableArrayRef *buffers = calloc(count, sizeof(CFMutableArrayRef));
+    if (buffers == NULL) {
+        zix_enumerateClassesInMainBundleForParentClass(parentClass, handler);
+        return;
+    }
+    dispatch_apply(count, zix_globalQueueWithQOS(QOS_CLASS_USER_INTERACTIVE), ^(size_t idx) {
+        const mach_header_xx *mh = (const mach_header_xx *)[images[idx] pointerValue];
+        CFMutableArrayRef buffer = CFArrayCreateMutable(kCFAllocatorDefault, 0, NULL);
+        enumerateClassesInImage(mh, ^(__unsafe_unretained Class aClass) {
+            if (classIsSubclassOfClass((__bridge class_t *)(aClass), parent)) {
+                CFArrayAppendValue(buffer, (__bridge const void *)(aClass));
+            }
+        });
+        buffers[idx] = buffer;
+    });
+    for (size_t i = 0; i < count; i++) {
+        CFMutableArrayRef buffer = buffers[i];
+        for (CFIndex j = 0, classCount = CFArrayGetCount(buffer); j < classCount; j++) {
+            handler((__bridge Class)CFArrayGetValueAtIndex(buffer, j));
+        }
+        CFRelease(buffer);
+    }
+    free(buffers);
+}
+
+static void enumerateClassNames(const char **classNames, unsigned int count, Class parentClass, void(^handler)(__unsafe_unretained Class aClass)) {
+    for (unsigned int i = 0; i < count; i++) {
+        Class aClass = objc_getClass(classNames[i]);
+        if (aClass && zix_classIsSubclassOfClass(aClass, parentClass)) {
+            handler(aClass);
+        }
+    }
+}
+
+BOOL zix_enumerateClassesInCustomImagesForParentClass(Class parentClass, void(^handler)(__unsafe_unretained Class aClass)) {
+    if (handler == nil) {
+        return NO;
+    }
+    // Test with main executable before calling handler, so caller can fallback without handling any class twice
+    // dyld always puts main executable at index 0
+    const char *mainExecutablePath = _dyld_image_count() > 0 ? _dyld_get_image_name(0) : NULL;
+    unsigned int mainClassCount = 0;
+    const char **mainClassNames = mainExecutablePath ? objc_copyClassNamesForImage(mainExecutablePath, &mainClassCount) : NULL;
+    if (mainClassNames == NULL) {
+        return NO;
+    }
+    ZIKImagePrefilter filter = makeImagePrefilter(parentClass);
+    enumerateImages(^(const mach_header_xx *mh, const char *path) {
+        if (path == NULL || !imageIsCustomImage(path) || !imageMayContainSubclass(mh, &filter)) {
+            return;
+        }
+        BOOL isMainExecutable = path == mainExecutablePath || strcmp(path, mainExecutablePath) == 0;
+        unsigned int count = mainClassCount;
+        const char **classNames = isMainExecutable ? mainClassNames : objc_copyClassNamesForImage(path, &count);
+        if (classNames == NULL) {
+            return;
+        }
+        enumerateClassNames(classNames, count, parentClass, handler);
+        if (!isMainExecutable) {
+            free(classNames);
+        }
+    });
+    releaseImagePrefilter(&filter);
+    free(mainClassNames);
+    return YES;
+}
+
+static void enumerateClassesInImageSection(const mach_header_xx *mh, const char *sectionName, void(^handler)(__unsafe_unretained Class aClass)) {
+    unsigned long size = 0;
+    const char *const *classNames = (const char *const *)(void *)getsectiondata(mh, "__DATA", sectionName, &size);
+    if (classNames == NULL) {
+        return;
+    }
+    for (unsigned long i = 0; i < size / sizeof(const char *); i++) {
+        Class aClass = (Class)objc_getClass(classNames[i]);
+        if (aClass) {
+            handler(aClass);
+        }
+    }
+}
+
+void zix_enumerateClassesInSection(const char *sectionName, void(^handler)(__unsafe_unretained Class aClass)) {
+    if (handler == nil || sectionName == NULL) {
+        return;
+    }
+    enumerateImages(^(const mach_header_xx *mh, const char *path) {
+        if (!imageIsCustomImage(path)) {
+            return;
+        }
+        enumerateClassesInImageSection(mh, sectionName, handler);
+    });
+}
+
+void zix_enumerateClassesInImageForParentClass(const void *header, Class parentClass, void(^handler)(__unsafe_unretained Class aClass)) {
+    if (handler == nil || header == NULL) {
+        return;
+    }
+    if (!zix_imageMayContainSubclassOfClass(header, parentClass)) {
+        return;
+    }
+    if (!zix_canEnumerateClassesInImageWithHeader(header)) {
+        // Fallback to class names of the image
+        Dl_info info;
+        if (dladdr(header, &info) == 0 || info.dli_fname == NULL) {
+            return;
+        }
+        unsigned int count = 0;
+        const char **classNames = objc_copyClassNamesForImage(info.dli_fname, &count);
+        if (classNames) {
+            enumerateClassNames(classNames, count, parentClass, handler);
+            free(classNames);
+        }
+        return;
+    }
+    struct class_t *parent = (__bridge struct class_t *)(parentClass);
+    enumerateClassesInImage((const mach_header_xx *)header, ^(__unsafe_unretained Class aClass) {
+        if (classIsSubclassOfClass((__bridge class_t *)(aClass), parent)) {
+            handler(aClass);
+        }
+    });
+}
+
+void zix_enumerateClassesInImageSection(const void *header, const char *sectionName, void(^handler)(__unsafe_unretained Class aClass)) {
+    if (handler == nil || header == NULL || sectionName == NULL) {
+        return;
+    }
+    enumerateClassesInImageSection((const mach_header_xx *)header, sectionName, handler);
+}
+
+bool zix_imageHasSection(const void *header, const char *sectionName) {
+    if (header == NULL || sectionName == NULL) {
+        return false;
+    }
+    unsigned long size = 0;
+    return getsectiondata((const mach_header_xx *)header, "__DATA", sectionName, &size) != NULL && size > 0;
+}
+
+void zix_enumerateCustomImages(void(^handler)(const void *header)) {
+    if (handler == nil) {
+        return;
+    }
+    enumerateImages(^(const mach_header_xx *mh, const char *path) {
+        if (path && imageIsCustomImage(path)) {
+            handler(mh);
+        }
+    });
+}
+
+const void *zix_imageHeaderOfClass(Class aClass) {
+    return zix_imageHeaderOfAddress((__bridge const void *)aClass);
+}
+
+const void *zix_imageHeaderOfAddress(const void *address) {
+    Dl_info info;
+    if (address == NULL || dladdr(address, &info) == 0) {
+        return NULL;
+    }
+    return info.dli_fbase;
+}
+
+/// Leading fields of a block object in the block ABI.
+typedef struct ZIKBlockLayout {
+    void *isa;
+    int flags;
+    int reserved;
+    void (*invoke)(void);
+} ZIKBlockLayout;
+
+const void *zix_imageHeaderOfBlock(id block) {
+    if (block == nil) {
+        return NULL;
+    }
+    const void *invoke = (const void *)((__bridge ZIKBlockLayout *)block)->invoke;
+#if __has_feature(ptrauth_calls)
+    invoke = ptrauth_strip(invoke, ptrauth_key_function_pointer);
+#endif
+    return zix_imageHeaderOfAddress(invoke);
+}
+
+NSString *zix_imageUUIDString(const void *header) {
+    if (header == NULL) {
+        return nil;
+    }
+    const mach_header_xx *mh = (const mach_header_xx *)header;
+    uintptr_t command = (uintptr_t)mh + sizeof(mach_header_xx);
+    for (uint32_t i = 0; i < mh->ncmds; i++) {
+        const struct load_command *loadCommand = (const struct load_command *)command;
+        if (loadCommand->cmd == LC_UUID) {
+            const struct uuid_command *uuidCommand = (const struct uuid_command *)loadCommand;
+            return [[NSUUID alloc] initWithUUIDBytes:uuidCommand->uuid].UUIDString;
+        }
+        command += loadCommand->cmdsize;
+    }
+    return nil;
+}
+
+static void(^_addedImageHandler)(const void *header);
+static bool _observingExistingImages;
+
+static void addedImageCallback(const struct mach_header *mh, intptr_t vmaddr_slide) {
+    if (_observingExistingImages) {
+        // dyld calls back for images already loaded when registering
+        return;
+    }
+    Dl_info info;
+    if (dladdr(mh, &info) == 0 || info.dli_fname == NULL || !imageIsCustomImage(info.dli_fname)) {
+        return;
+    }
+    _addedImageHandler(mh);
+}
+
+void zix_observeAddedImages(void(^handler)(const void *header)) {
+    NSCParameterAssert(handler);
+    NSCAssert(_addedImageHandler == nil, @"Added images are already observed.");
+    if (handler == nil || _addedImageHandler) {
+        return;
+    }
+    _addedImageHandler = [handler copy];
+    _observingExistingImages = true;
+    _dyld_register_func_for_add_image(addedImageCallback);
+    _observingExistingImages = false;
+}
+
+/// Global queue priority closest to the QoS class, used before QoS classes are supported.
+static long _dispatchPriorityOfQOS(qos_class_t qos) {
+    switch (qos) {
+        case QOS_CLASS_USER_INTERACTIVE:
+        case QOS_CLASS_USER_INITIATED:
+            return DISPATCH_QUEUE_PRIORITY_HIGH;
+        case QOS_CLASS_UTILITY:
+            return DISPATCH_QUEUE_PRIORITY_LOW;
+        case QOS_CLASS_BACKGROUND:
+            return DISPATCH_QUEUE_PRIORITY_BACKGROUND;
+        default:
+            return DISPATCH_QUEUE_PRIORITY_DEFAULT;
+    }
+}
+
+dispatch_queue_t zix_globalQueueWithQOS(qos_class_t qos) {
+    if (@available(iOS 8.0, *)) {
+        return dispatch_get_global_queue(qos, 0);
+    }
+    return dispatch_get_global_queue(_dispatchPriorityOfQOS(qos), 0);
+}
+
+dispatch_queue_t zix_createSerialQueueWithQOS(const char *label, qos_class_t qos) {
+    if (@available(iOS 8.0, *)) {
+        return dispatch_queue_create(label, dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, qos, 0));
+    }
+    dispatch_queue_t queue = dispatch_queue_create(label, DISPATCH_QUEUE_SERIAL);
+    dispatch_set_target_queue(queue, dispatch_get_global_queue(_dispatchPriorityOfQOS(qos), 0));
+    return queue;
 }
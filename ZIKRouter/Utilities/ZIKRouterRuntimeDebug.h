@@ -37,6 +37,7 @@ NS_ASSUME_NONNULL_BEGIN
  @param sourceType Any type of swift class, objc class, swift struct, swift enum, swift function, swift tuple, objc protocol, swift protocol.
  @param targetType The target type to check, can be swift protocol, objc protocol, swift class, objc class, swift struct, swift enum, swift function, swift tuple.
  @return True if the sourceType is the targetType.
+ @note Results are cached for each pair of types, and it's thread safe. Conformances added by images loaded after checking are not found.
  */
 FOUNDATION_EXTERN bool _swift_typeIsTargetType(id sourceType, id targetType);
 
@@ -51,6 +52,16 @@ FOUNDATION_EXTERN bool _swift_typeIsTargetType(id sourceType, id targetType);
  */
 FOUNDATION_EXTERN void zix_enumerateSymbolName(bool(^handler)(const char *name, NSString *(^demangledAsSwift)(const char *mangledName, bool simplified)));
 
+/**
+ Enumerate demangled symbols containing the keyword in images from app's bundle. Only available in DEBUG mode.
+ @discussion
+ Matched symbols of each image are saved in caches directory with the image's LC_UUID, so images not changed since last launch don't scan their symbol table and demangle symbols again. Files of images that are not loaded any more are removed when a new file is saved.
+ 
+ @param keyword Keyword in mangled symbol name.
+ @param handler Handler for each matched symbol, return false to stop. `symbolName` is the demangled swift symbol, `simplifiedSymbolName` strips module name, extension name and `where` clauses. `imagePath` is the path of the image containing the symbol.
+ */
+FOUNDATION_EXTERN void zix_enumerateSymbolNameContainingKeyword(const char *keyword, bool(^handler)(NSString *symbolName, NSString *simplifiedSymbolName, NSString *imagePath));
+
 FOUNDATION_EXTERN bool zix_hasDynamicLibrary(NSString *libName);
 
 /// Generate code for importing routers when manually registering routers.
@@ -59,8 +70,19 @@ FOUNDATION_EXTERN NSString *codeForImportingRouters(void);
 /// Generate code for manually registering routers.
 FOUNDATION_EXTERN NSString *codeForRegisteringRouters(void);
 
-/// Check whether the object is dealloced after delay second.
-FOUNDATION_EXTERN void zix_checkMemoryLeak(id object, NSTimeInterval delaySecond, void(^_Nullable handler)(id leakedObject));
+/**
+ Generate registration source files for each module into the directory. Only available in DEBUG mode.
+ @discussion
+ Objective-C routers of a module are registered in `ZIKRouterRegistration+<Module>.m` with function `ZIKRouterRegister<Module>Routers()`, and `ZIKRouterRegisterAllModules()` in `ZIKRouterRegistration.m` calls all of them. Swift routers of a module are registered in `ZIKRouterRegistration+<Module>.swift` with function `zix_register<Module>SwiftRouters()`, add it into that module. Routers and files are sorted by name, and unchanged files are not rewritten, so output is stable between runs.
+ 
+ +registerAll calls this when environment variable `ZIKROUTER_REGISTRATION_CODE_OUTPUT` is set to the directory. `Templates/generate_registration_code.sh` runs unit tests with the variable, so it can be used as a build step to keep generated code up to date, then release builds can set `ZIKRouteRegistry.autoRegister` to NO and call the generated functions.
+ 
+ @return Whether all files are written.
+ */
+FOUNDATION_EXTERN BOOL zix_writeRegistrationCode(NSString *directory);
 #endif
 
+/// Check whether the object is dealloced after delay second. Objects are checked in batch by one timer on main thread, so it's cheap enough for release builds.
+FOUNDATION_EXTERN void zix_checkMemoryLeak(id object, NSTimeInterval delaySecond, void(^_Nullable handler)(id leakedObject));
+
 NS_ASSUME_NONNULL_END
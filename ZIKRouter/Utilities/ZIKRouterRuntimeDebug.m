@@ -17,6 +17,8 @@
 #import "ZIKImageSymbol.h"
 #import <objc/runtime.h>
 #import "NSString+Demangle.h"
+#import "ZIKRouterLog.h"
+#import <mach-o/loader.h>
 
 @interface NSString (ZIXContainsString)
 - (BOOL)zix_containsString:(NSString *)str;
@@ -168,13 +170,30 @@ typedef struct {
     TargetMetadata *metadata;
 } SwiftValueHeader;
 
-static TargetMetadata *swift_dynamicCastMetatype(TargetMetadata *sourceType, TargetMetadata *targetType) {
-    static TargetMetadata*(*_swift_dynamicCastMetatype)(TargetMetadata *, TargetMetadata *) = NULL;
+/// Functions in libswiftCore.dylib, found in one pass.
+typedef struct {
+    TargetMetadata*(*swift_dynamicCastMetatype)(TargetMetadata *, TargetMetadata *);
+    uintptr_t(*swift_conformsToProtocol)(TargetMetadata *, uintptr_t);
+    TargetMetadata*(*swift_getObjCClassMetadata)(void *);
+} ZIKSwiftCoreFunctions;
+
+static const ZIKSwiftCoreFunctions *_swiftCoreFunctions(void) {
+    static ZIKSwiftCoreFunctions functions;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
+        const char *names[] = {"_swift_dynamicCastMetatype", "_swift_conformsToProtocol", "_swift_getObjCClassMetadata"};
+        void *values[3] = {NULL};
         ZIKImageRef libswiftCoreImage = [ZIKImageSymbol imageByName:"libswiftCore.dylib"];
-        _swift_dynamicCastMetatype = (TargetMetadata*(*)(TargetMetadata *, TargetMetadata *))[ZIKImageSymbol findSymbolInImage:libswiftCoreImage name:"_swift_dynamicCastMetatype"];
+        [ZIKImageSymbol findSymbolsInImage:libswiftCoreImage names:names count:3 values:values];
+        functions.swift_dynamicCastMetatype = (TargetMetadata*(*)(TargetMetadata *, TargetMetadata *))values[0];
+        functions.swift_conformsToProtocol = (uintptr_t(*)(TargetMetadata *, uintptr_t))values[1];
+        functions.swift_getObjCClassMetadata = (TargetMetadata*(*)(void *))values[2];
     });
+    return &functions;
+}
+
+static TargetMetadata *swift_dynamicCastMetatype(TargetMetadata *sourceType, TargetMetadata *targetType) {
+    TargetMetadata*(*_swift_dynamicCastMetatype)(TargetMetadata *, TargetMetadata *) = _swiftCoreFunctions()->swift_dynamicCastMetatype;
     if (!_swift_dynamicCastMetatype) {
         return NULL;
     }
@@ -182,12 +201,7 @@ static TargetMetadata *swift_dynamicCastMetatype(TargetMetadata *sourceType, Tar
 }
 
 static bool swift_conformsToProtocols(bool isSourceClassPointer, TargetMetadata *type, ExistentialTypeMetadata *existentialType) {
-    static uintptr_t(*_swift_conformsToProtocol)(TargetMetadata *, uintptr_t) = NULL;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        ZIKImageRef libswiftCoreImage = [ZIKImageSymbol imageByName:"libswiftCore.dylib"];
-        _swift_conformsToProtocol = (uintptr_t(*)(TargetMetadata *, uintptr_t))[ZIKImageSymbol findSymbolInImage:libswiftCoreImage name:"_swift_conformsToProtocol"];
-    });
+    uintptr_t(*_swift_conformsToProtocol)(TargetMetadata *, uintptr_t) = _swiftCoreFunctions()->swift_conformsToProtocol;
     if (_swift_conformsToProtocol == NULL) {
         return false;
     }
@@ -393,33 +407,59 @@ static BOOL object_is_class(id obj) {
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Warc-performSelector-leaks"
 
-bool _swift_typeIsTargetType(id sourceType, id targetType) {
+/// Runtime classes for identifying type parameters, resolved once.
+typedef struct {
+    __unsafe_unretained Class SwiftObject;
+    __unsafe_unretained Class Swift_SwiftObject;
+    __unsafe_unretained Class _SwiftValue;
+    __unsafe_unretained Class __SwiftValue;
+    __unsafe_unretained Class ProtocolClass;
+} ZIKSwiftRuntimeClasses;
+
+static const ZIKSwiftRuntimeClasses *_swiftRuntimeClasses(void) {
+    static ZIKSwiftRuntimeClasses classes;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        classes.SwiftObject = NSClassFromString(@"SwiftObject");
+        classes.Swift_SwiftObject = NSClassFromString(@"Swift._SwiftObject");
+        classes._SwiftValue = NSClassFromString(@"_SwiftValue");
+        classes.__SwiftValue = NSClassFromString(@"__SwiftValue");
+        classes.ProtocolClass = NSClassFromString(@"Protocol");
+    });
+    return &classes;
+}
+
+static inline BOOL _isSwiftValue(id type, const ZIKSwiftRuntimeClasses *classes) {
+    return [type isKindOfClass:classes->_SwiftValue] || [type isKindOfClass:classes->__SwiftValue];
+}
+
+static bool _swift_uncachedTypeIsTargetType(id sourceType, id targetType, const ZIKSwiftRuntimeClasses *classes) {
     //swift class or swift object
-    BOOL isSourceSwiftObjectType = [sourceType isKindOfClass:NSClassFromString(@"SwiftObject")] || [sourceType isKindOfClass:NSClassFromString(@"Swift._SwiftObject")];
-    BOOL isTargetSwiftObjectType = [targetType isKindOfClass:NSClassFromString(@"SwiftObject")] || [targetType isKindOfClass:NSClassFromString(@"Swift._SwiftObject")];
+    BOOL isSourceSwiftObjectType = [sourceType isKindOfClass:classes->SwiftObject] || [sourceType isKindOfClass:classes->Swift_SwiftObject];
+    BOOL isTargetSwiftObjectType = [targetType isKindOfClass:classes->SwiftObject] || [targetType isKindOfClass:classes->Swift_SwiftObject];
     //swift struct or swift enum or swift protocol
-    BOOL isSourceSwiftValueType = [sourceType isKindOfClass:NSClassFromString(@"_SwiftValue")] || [sourceType isKindOfClass:NSClassFromString(@"__SwiftValue")];
-    BOOL isTargetSwiftValueType = [targetType isKindOfClass:NSClassFromString(@"_SwiftValue")] || [targetType isKindOfClass:NSClassFromString(@"__SwiftValue")];
+    BOOL isSourceSwiftValueType = _isSwiftValue(sourceType, classes);
+    BOOL isTargetSwiftValueType = _isSwiftValue(targetType, classes);
     BOOL isSourceSwiftType = isSourceSwiftObjectType || isSourceSwiftValueType;
     BOOL isTargetSwiftType = isTargetSwiftObjectType || isTargetSwiftValueType;
     
     if (isSourceSwiftValueType && isTargetSwiftValueType == NO) {
         return false;
     }
-    if ([sourceType isKindOfClass:NSClassFromString(@"Protocol")]) {
+    if ([sourceType isKindOfClass:classes->ProtocolClass]) {
         if (isTargetSwiftType) {
             return false;
         }
-        if ([targetType isKindOfClass:NSClassFromString(@"Protocol")]) {
+        if ([targetType isKindOfClass:classes->ProtocolClass]) {
             return protocol_conformsToProtocol(sourceType, targetType);
         } else {
-            if (targetType == NSClassFromString(@"Protocol")) {
+            if (targetType == classes->ProtocolClass) {
                 return true;
             }
             return false;
         }
     }
-    if ([targetType isKindOfClass:NSClassFromString(@"Protocol")]) {
+    if ([targetType isKindOfClass:classes->ProtocolClass]) {
         if (object_is_class(sourceType)) {
             return [sourceType conformsToProtocol:targetType];
         }
@@ -496,12 +536,7 @@ bool _swift_typeIsTargetType(id sourceType, id targetType) {
             //For pure objc class, can't check conformance with swift_conformsToProtocols, need to use swift type metadata of this class as sourceTypeMetadata, or just search protocol witness table for this class
             if (object_is_class(sourceType) && isSourceSwiftObjectType == NO &&
                 [[NSStringFromClass(sourceType) demangledAsSwift] zix_containsString:@"."] == NO) {
-                static TargetMetadata *(*swift_getObjCClassMetadata)(void*);
-                static dispatch_once_t onceToken;
-                dispatch_once(&onceToken, ^{
-                    ZIKImageRef libswiftCoreImage = [ZIKImageSymbol imageByName:"libswiftCore.dylib"];
-                    swift_getObjCClassMetadata = (TargetMetadata*(*)(void*))[ZIKImageSymbol findSymbolInImage:libswiftCoreImage name:"_swift_getObjCClassMetadata"];
-                });
+                TargetMetadata *(*swift_getObjCClassMetadata)(void*) = _swiftCoreFunctions()->swift_getObjCClassMetadata;
                 if (swift_getObjCClassMetadata) {
                     // type is MetadataKindObjCClassWrapper
                     sourceTypeMetadata = swift_getObjCClassMetadata((__bridge void *)(sourceType));
@@ -511,7 +546,7 @@ bool _swift_typeIsTargetType(id sourceType, id targetType) {
         }
     } else {
         //objc protocol
-        if ([targetType isKindOfClass:NSClassFromString(@"Protocol")] == NO) {
+        if ([targetType isKindOfClass:classes->ProtocolClass] == NO) {
             return false;
         }
         targetTypeMetadata = (__bridge TargetMetadata *)targetType;
@@ -522,6 +557,46 @@ bool _swift_typeIsTargetType(id sourceType, id targetType) {
     return result;
 }
 
+/// Pointer identifying a type parameter. Swift struct, enum and protocol are boxed in a new _SwiftValue each time, so their type metadata is used.
+static const void *_typeIdentity(id type, const ZIKSwiftRuntimeClasses *classes) {
+    if (_isSwiftValue(type, classes) && [type respondsToSelector:NSSelectorFromString(@"_swiftTypeMetadata")]) {
+        return (__bridge const void *)[type performSelector:NSSelectorFromString(@"_swiftTypeMetadata")];
+    }
+    return (__bridge const void *)type;
+}
+
+typedef struct {
+    const void *sourceType;
+    const void *targetType;
+} ZIKTypeCheckKey;
+
+bool _swift_typeIsTargetType(id sourceType, id targetType) {
+    static NSMutableDictionary<NSValue *, NSNumber *> *results;
+    static dispatch_semaphore_t resultsSema;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        results = [NSMutableDictionary dictionary];
+        resultsSema = dispatch_semaphore_create(1);
+    });
+    const ZIKSwiftRuntimeClasses *classes = _swiftRuntimeClasses();
+    if (sourceType == nil || targetType == nil) {
+        return _swift_uncachedTypeIsTargetType(sourceType, targetType, classes);
+    }
+    ZIKTypeCheckKey keyValue = {_typeIdentity(sourceType, classes), _typeIdentity(targetType, classes)};
+    NSValue *key = [NSValue valueWithBytes:&keyValue objCType:@encode(ZIKTypeCheckKey)];
+    dispatch_semaphore_wait(resultsSema, DISPATCH_TIME_FOREVER);
+    NSNumber *cached = results[key];
+    dispatch_semaphore_signal(resultsSema);
+    if (cached) {
+        return cached.boolValue;
+    }
+    bool result = _swift_uncachedTypeIsTargetType(sourceType, targetType, classes);
+    dispatch_semaphore_wait(resultsSema, DISPATCH_TIME_FOREVER);
+    results[key] = @(result);
+    dispatch_semaphore_signal(resultsSema);
+    return result;
+}
+
 #pragma clang diagnostic pop
 
 bool zix_hasDynamicLibrary(NSString *libName) {
@@ -570,6 +645,117 @@ void zix_enumerateSymbolName(bool(^handler)(const char *name, NSString *(^demang
     }];
 }
 
+/// Get LC_UUID of the image, nil when the image doesn't have one.
+static NSString *_Nullable _uuidOfImage(ZIKImageRef image) {
+    const struct mach_header *header = (const struct mach_header *)image;
+    uintptr_t command = (uintptr_t)header;
+    if (header->magic == MH_MAGIC_64 || header->magic == MH_CIGAM_64) {
+        command += sizeof(struct mach_header_64);
+    } else {
+        command += sizeof(struct mach_header);
+    }
+    for (uint32_t i = 0; i < header->ncmds; i++) {
+        const struct load_command *loadCommand = (const struct load_command *)command;
+        if (loadCommand->cmd == LC_UUID) {
+            const struct uuid_command *uuidCommand = (const struct uuid_command *)loadCommand;
+            return [[NSUUID alloc] initWithUUIDBytes:uuidCommand->uuid].UUIDString;
+        }
+        command += loadCommand->cmdsize;
+    }
+    return nil;
+}
+
+static NSString *_symbolIndexDirectory(void) {
+    NSString *cachesDirectory = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+    return [cachesDirectory stringByAppendingPathComponent:@"ZIKRouter/SymbolIndex"];
+}
+
+/// Remove index files of images that are not loaded any more, such as images before relinking.
+static void _pruneSymbolIndexes(NSString *directory) {
+    NSMutableSet<NSString *> *loadedUUIDs = [NSMutableSet set];
+    [ZIKImageSymbol enumerateImages:^BOOL(ZIKImageRef  _Nonnull image, NSString * _Nonnull path) {
+        NSString *uuid = _uuidOfImage(image);
+        if (uuid) {
+            [loadedUUIDs addObject:uuid];
+        }
+        return YES;
+    }];
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    for (NSString *fileName in [fileManager contentsOfDirectoryAtPath:directory error:nil]) {
+        // File name is <keyword>-<UUID>.plist
+        NSString *name = [fileName stringByDeletingPathExtension];
+        NSUInteger uuidLength = 36;
+        if (![fileName.pathExtension isEqualToString:@"plist"] || name.length <= uuidLength) {
+            continue;
+        }
+        NSString *uuid = [name substringFromIndex:name.length - uuidLength];
+        if (![loadedUUIDs containsObject:uuid]) {
+            [fileManager removeItemAtPath:[directory stringByAppendingPathComponent:fileName] error:nil];
+        }
+    }
+}
+
+void zix_enumerateSymbolNameContainingKeyword(const char *keyword, bool(^handler)(NSString *symbolName, NSString *simplifiedSymbolName, NSString *imagePath)) {
+    NSCParameterAssert(keyword);
+    if (handler == nil || keyword == NULL) {
+        return;
+    }
+    NSString *directory = _symbolIndexDirectory();
+    NSString *keywordString = [NSString stringWithUTF8String:keyword];
+    [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+    __block BOOL wroteIndex = NO;
+    
+    [ZIKImageSymbol enumerateImages:^BOOL(ZIKImageRef  _Nonnull image, NSString * _Nonnull path) {
+        if ([path zix_containsString:@"/System/Library/"] == YES ||
+            [path zix_containsString:@"/usr/"] == YES ||
+            ([path zix_containsString:@"libswift"] && [path zix_containsString:@".dylib"])) {
+            return YES;
+        }
+        NSString *uuid = _uuidOfImage(image);
+        NSString *indexPath = nil;
+        NSArray<NSArray<NSString *> *> *symbols = nil;
+        if (uuid) {
+            indexPath = [directory stringByAppendingPathComponent:[NSString stringWithFormat:@"%@-%@.plist", keywordString, uuid]];
+            symbols = [NSArray arrayWithContentsOfFile:indexPath];
+        }
+        if (symbols == nil) {
+            // Image is changed, scan its symbol table and demangle matched symbols
+            NSMutableArray<NSArray<NSString *> *> *matchedSymbols = [NSMutableArray array];
+            [ZIKImageSymbol findSymbolInImage:image matching:^BOOL(const char * _Nonnull symbolName) {
+                // Only Swift declarations are handled, check raw bytes before demangling
+                if (!zix_isSwiftMangledName(symbolName) || strstr(symbolName, keyword) == NULL) {
+                    return NO;
+                }
+                NSString *name = [NSString stringWithUTF8String:symbolName];
+                if ([name hasPrefix:@"_"]) {
+                    name = [name substringFromIndex:1];
+                }
+                NSString *demangled = [name demangledAsSwift] ?: name;
+                NSString *simplified = [name demangledAsSimplifiedSwift] ?: name;
+                [matchedSymbols addObject:@[demangled, simplified]];
+                return NO;
+            }];
+            symbols = matchedSymbols;
+            if (indexPath) {
+                wroteIndex = [symbols writeToFile:indexPath atomically:YES] || wroteIndex;
+            }
+        }
+        for (NSArray<NSString *> *symbol in symbols) {
+            if (symbol.count != 2) {
+                continue;
+            }
+            if (!handler(symbol[0], symbol[1], path)) {
+                return NO;
+            }
+        }
+        return YES;
+    }];
+    // Index files are only added when images change, prune outdated ones at the same time
+    if (wroteIndex) {
+        _pruneSymbolIndexes(directory);
+    }
+}
+
 #import "ZIKRouterInternal.h"
 #import "ZIKRouteRegistryInternal.h"
 #if __has_include("ZIKViewRouter.h")
@@ -577,6 +763,21 @@ void zix_enumerateSymbolName(bool(^handler)(const char *name, NSString *(^demang
 #endif
 #import "ZIKServiceRouteRegistry.h"
 
+static NSString *_codeForImportingRouter(Class aClass, NSBundle *mainBundle) {
+    NSBundle *bundle = [NSBundle bundleForClass:aClass];
+    NSCAssert1(bundle, @"Failed to get bundle for class %@",NSStringFromClass(aClass));
+    if ([bundle isEqual:mainBundle]) {
+        return [NSString stringWithFormat:@"\n#import \"%@.h\"",NSStringFromClass(aClass)];
+    }
+    NSString *bundleName = [bundle.infoDictionary objectForKey:(__bridge NSString *)kCFBundleNameKey];
+    NSCAssert2(bundle, @"Failed to get bundle name for class %@, bundle:%@",NSStringFromClass(aClass), bundle);
+    NSString *headerPath = [bundle.bundlePath stringByAppendingPathComponent:[NSString stringWithFormat:@"Headers/%@.h",NSStringFromClass(aClass)]];
+    if ([[NSFileManager defaultManager] fileExistsAtPath:headerPath]) {
+        return [NSString stringWithFormat:@"\n#import <%@/%@.h>",bundleName,NSStringFromClass(aClass)];
+    }
+    return [NSString stringWithFormat:@"\n#import <%@/%@.h>",bundleName,bundleName];
+}
+
 NSString *codeForImportingRouters() {
     NSMutableArray<Class> *objcViewRouters = [NSMutableArray array];
     NSMutableArray<Class> *objcViewAdapters = [NSMutableArray array];
@@ -615,20 +816,7 @@ NSString *codeForImportingRouters() {
     
     void(^generateCodeForImportingRouters)(NSArray<Class> *) = ^(NSArray<Class> *routers) {
         for (Class aClass in routers) {
-            NSBundle *bundle = [NSBundle bundleForClass:aClass];
-            NSCAssert1(bundle, @"Failed to get bundle for class %@",NSStringFromClass(aClass));
-            if ([bundle isEqual:mainBundle]) {
-                [code appendFormat:@"\n#import \"%@.h\"",NSStringFromClass(aClass)];
-            } else {
-                NSString *bundleName = [bundle.infoDictionary objectForKey:(__bridge NSString *)kCFBundleNameKey];
-                NSCAssert2(bundle, @"Failed to get bundle name for class %@, bundle:%@",NSStringFromClass(aClass), bundle);
-                NSString *headerPath = [bundle.bundlePath stringByAppendingPathComponent:[NSString stringWithFormat:@"Headers/%@.h",NSStringFromClass(aClass)]];
-                if ([[NSFileManager defaultManager] fileExistsAtPath:headerPath]) {
-                    [code appendFormat:@"\n#import <%@/%@.h>",bundleName,NSStringFromClass(aClass)];
-                } else {
-                    [code appendFormat:@"\n#import <%@/%@.h>",bundleName,bundleName];
-                }
-            }
+            [code appendString:_codeForImportingRouter(aClass, mainBundle)];
         }
     };
     
@@ -752,12 +940,262 @@ NSString *codeForRegisteringRouters() {
     return code;
 }
 
+#pragma mark Registration Code Generation
+
+/// Routers of one module, grouped like codeForRegisteringRouters().
+@interface ZIKModuleRegistrationCode : NSObject {
+    @package
+    NSString *_moduleName;
+    NSMutableArray<Class> *_objcRouters;
+    NSMutableArray<Class> *_objcAdapters;
+    NSMutableArray<Class> *_swiftRouters;
+    NSMutableArray<Class> *_swiftAdapters;
+}
+@end
+@implementation ZIKModuleRegistrationCode
+@end
+
+/// Name of the module containing the class, as an identifier. Swift class names start with their module name, other classes use name of their image.
+static NSString *_moduleNameOfClass(Class aClass) {
+    NSString *className = NSStringFromClass(aClass);
+    NSString *moduleName;
+    NSRange dotRange = [className rangeOfString:@"."];
+    if (dotRange.location != NSNotFound) {
+        moduleName = [className substringToIndex:dotRange.location];
+    } else {
+        const char *imageName = class_getImageName(aClass);
+        moduleName = imageName ? [[NSString stringWithUTF8String:imageName] lastPathComponent] : nil;
+    }
+    if (moduleName.length == 0) {
+        moduleName = @"Main";
+    }
+    NSMutableString *identifier = [NSMutableString stringWithCapacity:moduleName.length];
+    NSCharacterSet *allowedCharacters = [NSCharacterSet alphanumericCharacterSet];
+    for (NSUInteger i = 0; i < moduleName.length; i++) {
+        unichar c = [moduleName characterAtIndex:i];
+        [identifier appendFormat:@"%C", (unichar)([allowedCharacters characterIsMember:c] && c < 128 ? c : '_')];
+    }
+    return identifier;
+}
+
+static NSArray<Class> *_sortedClasses(NSArray<Class> *classes) {
+    return [classes sortedArrayUsingComparator:^NSComparisonResult(Class class1, Class class2) {
+        return [NSStringFromClass(class1) compare:NSStringFromClass(class2)];
+    }];
+}
+
+static BOOL _writeCode(NSString *code, NSString *directory, NSString *fileName) {
+    NSString *path = [directory stringByAppendingPathComponent:fileName];
+    NSData *data = [code dataUsingEncoding:NSUTF8StringEncoding];
+    // Keep files unchanged when code is the same, so build system won't recompile them
+    if ([[NSData dataWithContentsOfFile:path] isEqualToData:data]) {
+        return YES;
+    }
+    NSError *error;
+    if (![data writeToFile:path options:NSDataWritingAtomic error:&error]) {
+        ZIX_LOG(Registry, Error, @"❌ZIKRouter: failed to write registration code to %@, error: %@", path, error);
+        return NO;
+    }
+    return YES;
+}
+
+BOOL zix_writeRegistrationCode(NSString *directory) {
+    NSMutableDictionary<NSString *, ZIKModuleRegistrationCode *> *modules = [NSMutableDictionary dictionary];
+    ZIKModuleRegistrationCode *(^moduleOfClass)(Class) = ^(Class aClass) {
+        NSString *moduleName = _moduleNameOfClass(aClass);
+        ZIKModuleRegistrationCode *module = modules[moduleName];
+        if (module == nil) {
+            module = [ZIKModuleRegistrationCode new];
+            module->_moduleName = moduleName;
+            module->_objcRouters = [NSMutableArray array];
+            module->_objcAdapters = [NSMutableArray array];
+            module->_swiftRouters = [NSMutableArray array];
+            module->_swiftAdapters = [NSMutableArray array];
+            modules[moduleName] = module;
+        }
+        return module;
+    };
+    zix_enumerateClassList(^(__unsafe_unretained Class aClass) {
+        BOOL registerable = [ZIKServiceRouteRegistry isRegisterableRouterClass:aClass];
+#if __has_include("ZIKViewRouter.h")
+        registerable = registerable || [ZIKViewRouteRegistry isRegisterableRouterClass:aClass];
+#endif
+        if (!registerable) {
+            return;
+        }
+        ZIKModuleRegistrationCode *module = moduleOfClass(aClass);
+        BOOL isSwift = [NSStringFromClass(aClass) zix_containsString:@"."];
+        if ([aClass isAdapter]) {
+            [isSwift ? module->_swiftAdapters : module->_objcAdapters addObject:aClass];
+        } else {
+            [isSwift ? module->_swiftRouters : module->_objcRouters addObject:aClass];
+        }
+    });
+    
+    NSError *error;
+    if (![[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:&error]) {
+        ZIX_LOG(Registry, Error, @"❌ZIKRouter: failed to create directory %@ for registration code, error: %@", directory, error);
+        return NO;
+    }
+    NSBundle *mainBundle = [NSBundle mainBundle];
+    NSArray<NSString *> *moduleNames = [modules.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    NSString *header = @"// Generated by ZIKRouter, don't edit this file.\n";
+    NSMutableString *declarations = [NSMutableString stringWithFormat:@"%@\n#import <Foundation/Foundation.h>\n\nNS_ASSUME_NONNULL_BEGIN\n", header];
+    NSMutableString *registerAll = [NSMutableString stringWithFormat:@"%@\n#import \"ZIKRouterRegistration.h\"\n\nvoid ZIKRouterRegisterAllModules(void) {\n", header];
+    BOOL success = YES;
+    for (NSString *moduleName in moduleNames) {
+        ZIKModuleRegistrationCode *module = modules[moduleName];
+        // Routers are registered before adapters, same as codeForRegisteringRouters()
+        NSArray<Class> *objcRouters = [_sortedClasses(module->_objcRouters) arrayByAddingObjectsFromArray:_sortedClasses(module->_objcAdapters)];
+        NSArray<Class> *swiftRouters = [_sortedClasses(module->_swiftRouters) arrayByAddingObjectsFromArray:_sortedClasses(module->_swiftAdapters)];
+        if (objcRouters.count > 0) {
+            NSString *functionName = [NSString stringWithFormat:@"ZIKRouterRegister%@Routers", moduleName];
+            NSMutableString *code = [NSMutableString stringWithFormat:@"%@\n#import \"ZIKRouterRegistration.h\"\n@import ZIKRouter.Internal;", header];
+            for (Class aClass in objcRouters) {
+                [code appendString:_codeForImportingRouter(aClass, mainBundle)];
+            }
+            [code appendFormat:@"\n\nvoid %@(void) {\n", functionName];
+            for (Class aClass in objcRouters) {
+                [code appendFormat:@"    [%@ registerRoutableDestination];\n", NSStringFromClass(aClass)];
+            }
+            [code appendString:@"}\n"];
+            success = _writeCode(code, directory, [NSString stringWithFormat:@"ZIKRouterRegistration+%@.m", moduleName]) && success;
+            [declarations appendFormat:@"\n/// Register Objective-C routers and adapters in %@.\nFOUNDATION_EXTERN void %@(void);\n", moduleName, functionName];
+            [registerAll appendFormat:@"    %@();\n", functionName];
+        }
+        if (swiftRouters.count > 0) {
+            NSMutableString *code = [NSMutableString stringWithFormat:@"%@\nimport ZRouter\n\n/// Register Swift routers and adapters in %@. Add this file into module %@.\nfunc zix_register%@SwiftRouters() {\n", header, moduleName, moduleName, moduleName];
+            for (Class aClass in swiftRouters) {
+                // Classes are in the module of this file, so drop the module name
+                NSString *className = NSStringFromClass(aClass);
+                [code appendFormat:@"    %@.registerRoutableDestination()\n", [className substringFromIndex:[className rangeOfString:@"."].location + 1]];
+            }
+            [code appendString:@"}\n"];
+            success = _writeCode(code, directory, [NSString stringWithFormat:@"ZIKRouterRegistration+%@.swift", moduleName]) && success;
+        }
+    }
+    [declarations appendString:@"\n/// Register Objective-C routers and adapters in all modules. Register Swift routers with generated `zix_register<Module>SwiftRouters()`, then call +[ZIKRouteRegistry notifyRegistrationFinished].\nFOUNDATION_EXTERN void ZIKRouterRegisterAllModules(void);\n\nNS_ASSUME_NONNULL_END\n"];
+    [registerAll appendString:@"}\n"];
+    success = _writeCode(declarations, directory, @"ZIKRouterRegistration.h") && success;
+    success = _writeCode(registerAll, directory, @"ZIKRouterRegistration.m") && success;
+    if (success) {
+        ZIX_LOG(Registry, Info, @"ZIKRouter: registration code of %@ modules is written to %@", @(moduleNames.count), directory);
+    }
+    return success;
+}
+
+#endif
+
+#pragma mark Memory Leak
+
+#import <objc/runtime.h>
 #import "ZIKClassCapabilities.h"
 #if __has_include("ZIKViewRouter.h")
 #import "UIViewController+ZIKViewRouter.h"
 #import "UIView+ZIKViewRouter.h"
 #endif
 
+/// Removed object waiting for its deadline.
+@interface ZIKLeakCheckEntry : NSObject {
+    @package
+    __weak id _object;
+    CFAbsoluteTime _deadline;
+    void(^_handler)(id leakedObject);
+}
+@end
+@implementation ZIKLeakCheckEntry
+@end
+
+/// Associated with a leaked object, so reclaiming is reported when the object is dealloced, without scanning leaked objects.
+@interface ZIKLeakReclaimSentinel : NSObject {
+    @package
+    const void *_address;
+    NSString *_objectDescription;
+}
+@end
+@implementation ZIKLeakReclaimSentinel
+- (void)dealloc {
+    ZIX_LOG(MemoryLeak, Info, @"ZIKRouter memory leak checker:♻️ last leaked object was dealloced already:\ndestination(%p):%@", _address, _objectDescription);
+}
+@end
+
+/// Interval of the sweeper. Objects are checked in the first sweep after their deadlines.
+static const NSTimeInterval ZIKLeakSweepInterval = 1;
+/// Entries in order of adding. Entries before head are checked. Only used on main thread.
+static NSMutableArray<ZIKLeakCheckEntry *> *_leakCheckEntries;
+static NSUInteger _leakCheckHead = 0;
+static dispatch_source_t _leakSweeper;
+static BOOL _leakSweeperRunning = NO;
+static char _leakReclaimSentinelKey;
+
+static void _reportLeakedObject(id object, void(^_Nullable handler)(id leakedObject)) {
+#if __has_include("ZIKViewRouter.h")
+    if ([object respondsToSelector:@selector(zix_routed)] && [object zix_routed]) {
+        return;
+    }
+    if ([object isKindOfClass:[XXView class]]) {
+        XXViewController *viewController = [object zix_firstAvailableViewController];
+        if ([viewController zix_routed]) {
+            return;
+        }
+    }
+#endif
+    if (objc_getAssociatedObject(object, &_leakReclaimSentinelKey) == nil) {
+        ZIKLeakReclaimSentinel *sentinel = [ZIKLeakReclaimSentinel new];
+        sentinel->_address = (__bridge const void *)object;
+        sentinel->_objectDescription = [object description];
+        objc_setAssociatedObject(object, &_leakReclaimSentinelKey, sentinel, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    if (handler) {
+        handler(object);
+        return;
+    }
+    if ([object isKindOfClass:[XXViewController class]]) {
+        XXViewController *parent = [object parentViewController];
+        if (parent) {
+            ZIX_LOG(MemoryLeak, Warning, @"ZIKRouter memory leak checker:⚠️ destination is not dealloced after removed, make sure there is no retain cycle:\n%@\nIts parentViewController: %@\nThe UIKit system may hold the object, if the view is still in view hierarchy, you can ignore this.", object, parent);
+        } else {
+            ZIX_LOG(MemoryLeak, Warning, @"ZIKRouter memory leak checker:⚠️ destination is not dealloced after removed, make sure there is no retain cycle:\n%@\nThe UIKit system may hold the object, if the view is still in view hierarchy, you can ignore this.", object);
+        }
+        return;
+    } else if ([object isKindOfClass:[XXView class]]) {
+        XXView *superview = [object superview];
+        if (superview) {
+            ZIX_LOG(MemoryLeak, Warning, @"ZIKRouter memory leak checker:⚠️ destination is not dealloced after removed, make sure there is no retain cycle:\n%@\nIts superview: %@\nThe UIKit system may hold the object, if the view is still in view hierarchy, you can ignore this.", object, superview);
+        } else {
+            ZIX_LOG(MemoryLeak, Warning, @"ZIKRouter memory leak checker:⚠️ destination is not dealloced after removed, make sure there is no retain cycle:\n%@\nThe UIKit system may hold the object, if the view is still in view hierarchy, you can ignore this.", object);
+        }
+        return;
+    }
+    ZIX_LOG(MemoryLeak, Warning, @"ZIKRouter memory leak checker:⚠️ destination is not dealloced after removed, make sure there is no retain cycle:\n%@", object);
+}
+
+static void _sweepLeakCheckEntries(void) {
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    NSUInteger count = _leakCheckEntries.count;
+    // Delay is the same for most entries, so entries are nearly sorted by deadline, stop at the first pending one
+    while (_leakCheckHead < count) {
+        ZIKLeakCheckEntry *entry = _leakCheckEntries[_leakCheckHead];
+        if (entry->_deadline > now) {
+            break;
+        }
+        _leakCheckHead++;
+        id object = entry->_object;
+        if (object) {
+            _reportLeakedObject(object, entry->_handler);
+        }
+    }
+    if (_leakCheckHead == count) {
+        [_leakCheckEntries removeAllObjects];
+        _leakCheckHead = 0;
+        dispatch_suspend(_leakSweeper);
+        _leakSweeperRunning = NO;
+    } else if (_leakCheckHead > 64 && _leakCheckHead * 2 > count) {
+        [_leakCheckEntries removeObjectsInRange:NSMakeRange(0, _leakCheckHead)];
+        _leakCheckHead = 0;
+    }
+}
+
 void zix_checkMemoryLeak(id object, NSTimeInterval delaySecond, void(^handler)(id leakedObject)) {
     if (!object) {
         return;
@@ -765,13 +1203,12 @@ void zix_checkMemoryLeak(id object, NSTimeInterval delaySecond, void(^handler)(i
     if (delaySecond <= 0) {
         return;
     }
-    static NSMutableDictionary<NSString *, NSString *> *_leakedObjects;
-    static NSHashTable *_existingObjects;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        _leakedObjects = [NSMutableDictionary dictionary];
-        _existingObjects = [NSHashTable weakObjectsHashTable];
-    });
+    if (![NSThread isMainThread]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            zix_checkMemoryLeak(object, delaySecond, handler);
+        });
+        return;
+    }
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wundeclared-selector"
     
@@ -779,63 +1216,22 @@ void zix_checkMemoryLeak(id object, NSTimeInterval delaySecond, void(^handler)(i
         return;
     }
 #pragma clang diagnostic pop
-    __weak id weakObject = object;
-    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delaySecond * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
-        if (_leakedObjects.count > 0) {
-            // Check reclaimed objects since last checking
-            NSMutableSet<NSString *> *reclaimedObjects = [NSMutableSet setWithArray:_leakedObjects.allKeys];
-            [[_existingObjects setRepresentation] enumerateObjectsUsingBlock:^(id  _Nonnull obj, BOOL * _Nonnull stop) {
-                [reclaimedObjects removeObject:[NSString stringWithFormat:@"%p", (void *)obj]];
-            }];
-            if (reclaimedObjects.count > 0) {
-                NSMutableString *reclaimedDescription = [NSMutableString string];
-                [reclaimedObjects enumerateObjectsUsingBlock:^(NSString * _Nonnull address, BOOL * _Nonnull stop) {
-                    NSString *description = _leakedObjects[address];
-                    _leakedObjects[address] = nil;
-                    [reclaimedDescription appendFormat:@"destination(%@):%@\n", address, description];
-                }];
-                NSLog(@"\n\nZIKRouter memory leak checker:♻️ last leaked objects were dealloced already:\n%@\n\n", reclaimedDescription);
-            }
-        }
-        
-        if (weakObject) {
-#if __has_include("ZIKViewRouter.h")
-            if ([weakObject respondsToSelector:@selector(zix_routed)] && [weakObject zix_routed]) {
-                return;
-            }
-#endif
-            [_existingObjects addObject:weakObject];
-            _leakedObjects[[NSString stringWithFormat:@"%p", (void *)weakObject]] = [weakObject description];
-            if (handler) {
-                handler(weakObject);
-                return;
-            }
-            if ([weakObject isKindOfClass:[XXViewController class]]) {
-                XXViewController *parent = [weakObject parentViewController];
-                if (parent) {
-                    NSLog(@"\n\nZIKRouter memory leak checker:⚠️ destination is not dealloced after removed, make sure there is no retain cycle:\n%@\nIts parentViewController: %@\nThe UIKit system may hold the object, if the view is still in view hierarchy, you can ignore this.\n\n", weakObject, parent);
-                } else {
-                    NSLog(@"\n\nZIKRouter memory leak checker:⚠️ destination is not dealloced after removed, make sure there is no retain cycle:\n%@\nThe UIKit system may hold the object, if the view is still in view hierarchy, you can ignore this.\n\n", weakObject);
-                }
-                return;
-            } else if ([weakObject isKindOfClass:[XXView class]]) {
-#if __has_include("ZIKViewRouter.h")
-                XXViewController *viewController = [weakObject zix_firstAvailableViewController];
-                if ([viewController zix_routed]) {
-                    return;
-                }
-#endif
-                XXView *superview = [weakObject superview];
-                if (superview) {
-                    NSLog(@"\n\nZIKRouter memory leak checker:⚠️ destination is not dealloced after removed, make sure there is no retain cycle:\n%@\nIts superview: %@\nThe UIKit system may hold the object, if the view is still in view hierarchy, you can ignore this.\n\n", weakObject, superview);
-                } else {
-                    NSLog(@"\n\nZIKRouter memory leak checker:⚠️ destination is not dealloced after removed, make sure there is no retain cycle:\n%@\nThe UIKit system may hold the object, if the view is still in view hierarchy, you can ignore this.\n\n", weakObject);
-                }
-                return;
-            }
-            NSLog(@"\n\nZIKRouter memory leak checker:⚠️ destination is not dealloced after removed, make sure there is no retain cycle:\n%@\n\n", weakObject);
-        }
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _leakCheckEntries = [NSMutableArray array];
+        _leakSweeper = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_main_queue());
+        dispatch_source_set_timer(_leakSweeper, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(ZIKLeakSweepInterval * NSEC_PER_SEC)), (uint64_t)(ZIKLeakSweepInterval * NSEC_PER_SEC), (uint64_t)(ZIKLeakSweepInterval * 0.5 * NSEC_PER_SEC));
+        dispatch_source_set_event_handler(_leakSweeper, ^{
+            _sweepLeakCheckEntries();
+        });
     });
+    ZIKLeakCheckEntry *entry = [ZIKLeakCheckEntry new];
+    entry->_object = object;
+    entry->_deadline = CFAbsoluteTimeGetCurrent() + delaySecond;
+    entry->_handler = handler;
+    [_leakCheckEntries addObject:entry];
+    if (!_leakSweeperRunning) {
+        _leakSweeperRunning = YES;
+        dispatch_resume(_leakSweeper);
+    }
 }
-
-#endif
@@ -19,6 +19,8 @@ NS_ASSUME_NONNULL_BEGIN
  About module adapter, read https://github.com/Zuikyo/ZIKRouter/blob/master/Documentation/English/ModuleAdapter.md
  
  Why you need an adapter to decouple? There is a situation: module A need to use a file log module inside it, and A use the log module with a required interface (ModuleALogProtocol). The app context provides the log module as module B, and module B uses a provided interface (ModuleBLogProtocol). So in the app context, you need to adapt required interface(ModuleALogProtocol) and provided interface(ModuleBLogProtocol). Use category, swift extension, NSProxy or custom mediator to forward ModuleALogProtocol to ModuleBLogProtocol. Then module A is totally decoupled with module B.
+ 
+ Adapted view protocols and module config protocols are resolved by ZIKViewRouteRegistry when registration is finished, so `ZIKRouterToView()` and `ZIKRouterToViewModule()` with an adapted protocol find the view router as fast as with the protocol registered by the view router itself. When that view router is registered lazily from a route table or registered in Swift, the registry follows adapters one by one at the first lookup and caches the result.
  */
 @interface ZIKViewRouteAdapter : ZIKViewRouter
 
@@ -17,19 +17,61 @@
 #import "ZIKViewRouterInternal.h"
 #import "ZIKRouteConfigurationPrivate.h"
 
-@interface ZIKBlockViewRouter()
+@interface ZIKBlockViewRouter() {
+    /// Route and its callbacks resolved from configuration once.
+    ZIKViewRoute *_route;
+    const ZIKRouteCallbacks *_callbacks;
+    const ZIKViewRouteCallbacks *_viewCallbacks;
+}
 @end
 
+static const ZIKRouteCallbacks _emptyCallbacks;
+static const ZIKViewRouteCallbacks _emptyViewCallbacks;
+
 @implementation ZIKBlockViewRouter
 
 + (BOOL)isAbstractRouter {
     return YES;
 }
 
+- (instancetype)initWithConfiguration:(ZIKViewRouteConfiguration *)configuration removeConfiguration:(nullable ZIKViewRemoveConfiguration *)removeConfiguration {
+    if (self = [super initWithConfiguration:configuration removeConfiguration:removeConfiguration]) {
+        [self _attachRoute:(ZIKViewRoute *)configuration.route];
+    }
+    return self;
+}
+
+- (void)_attachRoute:(nullable ZIKViewRoute *)route {
+    _route = route;
+    _callbacks = route ? route.callbacks : NULL;
+    _viewCallbacks = route ? route.viewCallbacks : NULL;
+}
+
+- (void)prepareForReuse {
+    [super prepareForReuse];
+    [self _attachRoute:nil];
+}
+
 - (ZIKViewRoute *)route {
-    ZIKViewRoute *route = (ZIKViewRoute *)self.original_configuration.route;
-    NSAssert1(route, @"Can't find ZIKViewRoute for block router (%@). If you add new class method in ZIKRouter or ZIKViewRouter to create router, you must check your class method in ZIKRoute or ZIKViewRoute to inject route to router.",self);
-    return route;
+    if (_route == nil) {
+        [self _attachRoute:(ZIKViewRoute *)self.original_configuration.route];
+        NSAssert1(_route, @"Can't find ZIKViewRoute for block router (%@). If you add new class method in ZIKRouter or ZIKViewRouter to create router, you must check your class method in ZIKRoute or ZIKViewRoute to inject route to router.",self);
+    }
+    return _route;
+}
+
+static inline const ZIKRouteCallbacks *_callbacksOfRouter(ZIKBlockViewRouter *router) {
+    if (router->_callbacks == NULL) {
+        [router route];
+    }
+    return router->_callbacks ?: &_emptyCallbacks;
+}
+
+static inline const ZIKViewRouteCallbacks *_viewCallbacksOfRouter(ZIKBlockViewRouter *router) {
+    if (router->_viewCallbacks == NULL) {
+        [router route];
+    }
+    return router->_viewCallbacks ?: &_emptyViewCallbacks;
 }
 
 + (ZIKViewRouteTypeMask)supportedRouteTypes {
@@ -37,7 +79,7 @@
 }
 
 - (nullable id)destinationWithConfiguration:(ZIKViewRouteConfiguration *)configuration {
-    id(^makeDestinationBlock)(ZIKViewRouteConfiguration *config, ZIKRouter *router) = self.route.makeDestinationBlock;
+    id(^makeDestinationBlock)(ZIKViewRouteConfiguration *config, ZIKRouter *router) = _callbacksOfRouter(self)->makeDestination;
     if (makeDestinationBlock) {
         return makeDestinationBlock(configuration, self);
     }
@@ -45,7 +87,7 @@
 }
 
 - (BOOL)destinationFromExternalPrepared:(id)destination {
-    BOOL(^destinationFromExternalPreparedBlock)(id destination, ZIKViewRouter *router) = self.route.destinationFromExternalPreparedBlock;
+    BOOL(^destinationFromExternalPreparedBlock)(id destination, ZIKViewRouter *router) = _viewCallbacksOfRouter(self)->destinationFromExternalPrepared;
     if (destinationFromExternalPreparedBlock) {
         return destinationFromExternalPreparedBlock(destination, self);
     }
@@ -53,7 +95,7 @@
 }
 
 - (void)prepareDestination:(id)destination configuration:(ZIKViewRouteConfiguration *)configuration {
-    void(^prepareDestinationBlock)(id destination, ZIKPerformRouteConfiguration *config, ZIKRouter *router) = self.route.prepareDestinationBlock;
+    void(^prepareDestinationBlock)(id destination, ZIKPerformRouteConfiguration *config, ZIKRouter *router) = _callbacksOfRouter(self)->prepareDestination;
     if (prepareDestinationBlock) {
         prepareDestinationBlock(destination, configuration, self);
         return;
@@ -62,7 +104,7 @@
 }
 
 - (void)didFinishPrepareDestination:(id)destination configuration:(ZIKViewRouteConfiguration *)configuration {
-    void(^didFinishPrepareDestinationBlock)(id destination, ZIKPerformRouteConfiguration *config, ZIKRouter *router) = self.route.didFinishPrepareDestinationBlock;
+    void(^didFinishPrepareDestinationBlock)(id destination, ZIKPerformRouteConfiguration *config, ZIKRouter *router) = _callbacksOfRouter(self)->didFinishPrepareDestination;
     if (didFinishPrepareDestinationBlock) {
         didFinishPrepareDestinationBlock(destination, configuration, self);
         return;
@@ -71,7 +113,7 @@
 }
 
 - (BOOL)canPerformCustomRoute {
-    BOOL(^canPerformCustomRouteBlock)(ZIKViewRouter *router) = self.route.canPerformCustomRouteBlock;
+    BOOL(^canPerformCustomRouteBlock)(ZIKViewRouter *router) = _viewCallbacksOfRouter(self)->canPerformCustomRoute;
     if (canPerformCustomRouteBlock) {
         return canPerformCustomRouteBlock(self);
     }
@@ -79,7 +121,7 @@
 }
 
 - (BOOL)canRemoveCustomRoute {
-    BOOL(^canRemoveCustomRouteBlock)(ZIKViewRouter *router) = self.route.canRemoveCustomRouteBlock;
+    BOOL(^canRemoveCustomRouteBlock)(ZIKViewRouter *router) = _viewCallbacksOfRouter(self)->canRemoveCustomRoute;
     if (canRemoveCustomRouteBlock) {
         return canRemoveCustomRouteBlock(self);
     }
@@ -87,7 +129,7 @@
 }
 
 - (void)performCustomRouteOnDestination:(id)destination fromSource:(nullable id)source configuration:(ZIKViewRouteConfiguration *)configuration {
-    void(^performCustomRouteBlock)(id destination, _Nullable id source, ZIKViewRouteConfiguration *config, ZIKViewRouter *router) = self.route.performCustomRouteBlock;
+    void(^performCustomRouteBlock)(id destination, _Nullable id source, ZIKViewRouteConfiguration *config, ZIKViewRouter *router) = _viewCallbacksOfRouter(self)->performCustomRoute;
     if (performCustomRouteBlock) {
         performCustomRouteBlock(destination, source, configuration, self);
         return;
@@ -96,7 +138,7 @@
     [self endPerformRouteWithError:[ZIKViewRouter viewRouteErrorWithCode:ZIKViewRouteErrorUnsupportType localizedDescriptionFormat:@"The route (%@) supports ZIKBlockViewRouteTypeMaskCustom, but it didn't implement the custom perform route logic with -performCustomRoute.", self]];
 }
 - (void)removeCustomRouteOnDestination:(id)destination fromSource:(nullable id)source removeConfiguration:(ZIKViewRemoveConfiguration *)removeConfiguration configuration:(ZIKViewRouteConfiguration *)configuration {
-    void(^removeCustomRouteBlock)(id destination, _Nullable id source, ZIKViewRemoveConfiguration *removeConfig, ZIKViewRouteConfiguration *config, ZIKViewRouter *router) = self.route.removeCustomRouteBlock;
+    void(^removeCustomRouteBlock)(id destination, _Nullable id source, ZIKViewRemoveConfiguration *removeConfig, ZIKViewRouteConfiguration *config, ZIKViewRouter *router) = _viewCallbacksOfRouter(self)->removeCustomRoute;
     if (removeCustomRouteBlock) {
         removeCustomRouteBlock(destination, source, removeConfiguration, configuration,self);
         return;
@@ -108,9 +150,9 @@
 - (ZIKRemoveRouteConfiguration *)original_removeConfiguration {
     if (_removeConfiguration == nil) {
         NSAssert(self.original_configuration, @"Configuration shouldn't be nil when lazy get removeConfiguration");
-        ZIKRoute *route = self.original_configuration.route;
-        if (route && route.makeDefaultRemoveConfigurationBlock) {
-            _removeConfiguration = route.makeDefaultRemoveConfigurationBlock();
+        ZIKRemoveRouteConfiguration *(^makeDefaultRemoveConfiguration)(void) = _callbacksOfRouter(self)->makeDefaultRemoveConfiguration;
+        if (makeDefaultRemoveConfiguration) {
+            _removeConfiguration = makeDefaultRemoveConfiguration();
         } else {
             _removeConfiguration = [[self class] defaultRemoveConfiguration];
         }
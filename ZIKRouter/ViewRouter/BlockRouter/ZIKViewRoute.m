@@ -13,6 +13,8 @@
 
 #import "ZIKViewRoute.h"
 #import "ZIKRoutePrivate.h"
+#import "ZIKRouterPrivate.h"
+#import "ZIKRouteCallbacks.h"
 #import "ZIKViewRouteRegistry.h"
 #import "ZIKViewRouterInternal.h"
 #import "ZIKViewRouterPrivate.h"
@@ -20,7 +22,12 @@
 #import "ZIKBlockViewRouter.h"
 #import "ZIKClassCapabilities.h"
 
-@interface ZIKViewRoute()
+@interface ZIKViewRoute() {
+    ZIKViewRouteCallbacks _viewCallbacks;
+    /// Result of makeSupportedRouteTypesBlock, valid when _supportedRouteTypesResolved is true.
+    ZIKViewRouteTypeMask _supportedRouteTypes;
+    bool _supportedRouteTypesResolved;
+}
 @property (nonatomic, copy, nullable) BOOL(^shouldAutoCreateForDestinationBlock)(id destination, id source);
 @property (nonatomic, copy, nullable) BOOL(^destinationFromExternalPreparedBlock)(id destination, ZIKViewRouter *router);
 @property (nonatomic, copy, nullable) ZIKBlockViewRouteTypeMask(^makeSupportedRouteTypesBlock)(void);
@@ -42,6 +49,35 @@
 @dynamic prepareDestination;
 @dynamic didFinishPrepareDestination;
 
+- (const ZIKViewRouteCallbacks *)viewCallbacks {
+    return &_viewCallbacks;
+}
+
+- (void)setDestinationFromExternalPreparedBlock:(BOOL (^)(id, ZIKViewRouter *))destinationFromExternalPreparedBlock {
+    _destinationFromExternalPreparedBlock = [destinationFromExternalPreparedBlock copy];
+    _viewCallbacks.destinationFromExternalPrepared = _destinationFromExternalPreparedBlock;
+}
+
+- (void)setCanPerformCustomRouteBlock:(BOOL (^)(ZIKViewRouter *))canPerformCustomRouteBlock {
+    _canPerformCustomRouteBlock = [canPerformCustomRouteBlock copy];
+    _viewCallbacks.canPerformCustomRoute = _canPerformCustomRouteBlock;
+}
+
+- (void)setCanRemoveCustomRouteBlock:(BOOL (^)(ZIKViewRouter *))canRemoveCustomRouteBlock {
+    _canRemoveCustomRouteBlock = [canRemoveCustomRouteBlock copy];
+    _viewCallbacks.canRemoveCustomRoute = _canRemoveCustomRouteBlock;
+}
+
+- (void)setPerformCustomRouteBlock:(void (^)(id, id, ZIKViewRouteConfiguration *, ZIKViewRouter *))performCustomRouteBlock {
+    _performCustomRouteBlock = [performCustomRouteBlock copy];
+    _viewCallbacks.performCustomRoute = _performCustomRouteBlock;
+}
+
+- (void)setRemoveCustomRouteBlock:(void (^)(id, id, ZIKViewRemoveConfiguration *, ZIKViewRouteConfiguration *, ZIKViewRouter *))removeCustomRouteBlock {
+    _removeCustomRouteBlock = [removeCustomRouteBlock copy];
+    _viewCallbacks.removeCustomRoute = _removeCustomRouteBlock;
+}
+
 - (ZIKViewRoute<id, ZIKViewRouteConfiguration *> *(^)(BOOL(^)(id destination, id source)))shouldAutoCreateForDestination {
     return ^(BOOL(^block)(id destination, id source)) {
         self.shouldAutoCreateForDestinationBlock = block;
@@ -59,6 +95,7 @@
 - (ZIKViewRoute<id, ZIKViewRouteConfiguration *> *(^)(ZIKBlockViewRouteTypeMask(^)(void)))makeSupportedRouteTypes {
     return ^(ZIKBlockViewRouteTypeMask(^block)(void)) {
         self.makeSupportedRouteTypesBlock = block;
+        __atomic_store_n(&self->_supportedRouteTypesResolved, false, __ATOMIC_RELEASE);
         return self;
     };
 }
@@ -104,12 +141,15 @@
 
 #pragma mark Inject
 
-#define INJECT_CONFIG_BUILDER configBuilder = ^(ZIKViewRouteConfiguration *configuration) {\
-    configuration.route = self;\
-    ZIKViewRouteConfiguration *injected = [self defaultRouteConfigurationFromBlock];\
-    if (injected) {\
-        configuration.injected = injected;\
-        configuration = injected;\
+#define INJECT_CONFIG_BUILDER ZIX_INJECTING_ROUTE_SCOPE(self);\
+configBuilder = ^(ZIKViewRouteConfiguration *configuration) {\
+    if (configuration.route != self) {\
+        configuration.route = self;\
+        ZIKViewRouteConfiguration *injected = [self defaultRouteConfigurationFromBlock];\
+        if (injected) {\
+            configuration.injected = injected;\
+            configuration = injected;\
+        }\
     }\
     if (configBuilder) {\
         configBuilder(configuration);\
@@ -130,17 +170,6 @@
     };
 }
 
-#define INJECT_REMOVE_BUILDER removeConfigBuilder = ^(ZIKViewRemoveConfiguration *configuration) {\
-    ZIKViewRemoveConfiguration *injected = [self defaultRemoveRouteConfigurationFromBlock];\
-    if (injected) {\
-        configuration.injected = injected;\
-        configuration = injected;\
-    }\
-    if (removeConfigBuilder) {\
-        removeConfigBuilder(configuration);\
-    }\
-};\
-
 - (void(^)(ZIKViewRemoveConfiguration *config))_injectedRemoveConfigBuilder:(void(^)(ZIKViewRemoveConfiguration *config))builder {
     return ^(ZIKViewRemoveConfiguration *configuration) {
         ZIKViewRemoveConfiguration *injected = [self defaultRemoveRouteConfigurationFromBlock];
@@ -154,13 +183,16 @@
     };
 }
 
-#define INJECT_STRICT_CONFIG_BUILDER configBuilder = ^(ZIKPerformRouteStrictConfiguration<id> *strictConfig, ZIKViewRouteConfiguration *configuration) {\
-    configuration.route = self;\
-    ZIKViewRouteConfiguration *injected = [self defaultRouteConfigurationFromBlock];\
-    if (injected) {\
-        configuration.injected = injected;\
-        configuration = injected;\
-        strictConfig.configuration = injected;\
+#define INJECT_STRICT_CONFIG_BUILDER ZIX_INJECTING_ROUTE_SCOPE(self);\
+configBuilder = ^(ZIKPerformRouteStrictConfiguration<id> *strictConfig, ZIKViewRouteConfiguration *configuration) {\
+    if (configuration.route != self) {\
+        configuration.route = self;\
+        ZIKViewRouteConfiguration *injected = [self defaultRouteConfigurationFromBlock];\
+        if (injected) {\
+            configuration.injected = injected;\
+            configuration = injected;\
+            strictConfig.configuration = injected;\
+        }\
     }\
     if (configBuilder) {\
         configBuilder(strictConfig, configuration);\
@@ -185,18 +217,6 @@ _injectedStrictConfigBuilder:
     };
 }
 
-#define INJECT_STRICT_REMOVE_BUILDER removeConfigBuilder = ^(ZIKRemoveRouteStrictConfiguration<id> *strictConfig) {\
-    ZIKViewRemoveConfiguration *injected = [self defaultRemoveRouteConfigurationFromBlock];\
-    if (injected) {\
-        ZIKRemoveRouteConfiguration *configuration = strictConfig.configuration;\
-        configuration.injected = injected;\
-        strictConfig.configuration = injected;\
-    }\
-    if (removeConfigBuilder) {\
-        removeConfigBuilder(strictConfig);\
-    }\
-};\
-
 - (void (^)(ZIKRemoveRouteStrictConfiguration<id> * _Nonnull))
 _injectedStrictRemoveConfigBuilder:
 (void (^)(ZIKRemoveRouteStrictConfiguration<id> * _Nonnull)
@@ -284,7 +304,6 @@ _injectedStrictRemoveConfigBuilder:
       configuring:(void(NS_NOESCAPE ^)(ZIKViewRouteConfiguration *config))configBuilder
          removing:(void(NS_NOESCAPE ^ _Nullable)(ZIKViewRemoveConfiguration *config))removeConfigBuilder {
     INJECT_CONFIG_BUILDER;
-    INJECT_REMOVE_BUILDER;
     return [[self routerClass] performPath:path configuring:configBuilder removing:removeConfigBuilder];
 }
 
@@ -297,7 +316,6 @@ strictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, Z
 strictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, ZIKViewRouteConfiguration * _Nonnull))configBuilder
    strictRemoving:(void (^)(ZIKRemoveRouteStrictConfiguration<id> * _Nonnull))removeConfigBuilder {
     INJECT_STRICT_CONFIG_BUILDER;
-    INJECT_STRICT_REMOVE_BUILDER;
     return [[self routerClass] performPath:path strictConfiguring:configBuilder strictRemoving:removeConfigBuilder];
 }
 
@@ -312,7 +330,6 @@ strictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, Z
                configuring:(void(NS_NOESCAPE ^)(ZIKViewRouteConfiguration *config))configBuilder
                   removing:(void(NS_NOESCAPE ^ _Nullable)(ZIKViewRemoveConfiguration *config))removeConfigBuilder {
     INJECT_CONFIG_BUILDER;
-    INJECT_REMOVE_BUILDER;
     return [[self routerClass] performOnDestination:destination path:path configuring:configBuilder removing:removeConfigBuilder];
 }
 
@@ -334,7 +351,6 @@ strictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, Z
          strictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, ZIKViewRouteConfiguration * _Nonnull))configBuilder
             strictRemoving:(void (^)(ZIKRemoveRouteStrictConfiguration<id> * _Nonnull))removeConfigBuilder {
     INJECT_STRICT_CONFIG_BUILDER;
-    INJECT_STRICT_REMOVE_BUILDER;
     return [[self routerClass] performOnDestination:destination path:path strictConfiguring:configBuilder strictRemoving:removeConfigBuilder];
 }
 
@@ -347,7 +363,6 @@ strictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, Z
              configuring:(void(NS_NOESCAPE ^)(ZIKViewRouteConfiguration *config))configBuilder
                 removing:(void(NS_NOESCAPE ^ _Nullable)(ZIKViewRemoveConfiguration *config))removeConfigBuilder {
     INJECT_CONFIG_BUILDER;
-    INJECT_REMOVE_BUILDER;
     return [[self routerClass] prepareDestination:destination configuring:configBuilder removing:removeConfigBuilder];
 }
 
@@ -359,7 +374,6 @@ strictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, Z
        strictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, ZIKViewRouteConfiguration * _Nonnull))configBuilder
           strictRemoving:(void (^ _Nullable)(ZIKRemoveRouteStrictConfiguration<id> * _Nonnull))removeConfigBuilder {
     INJECT_STRICT_CONFIG_BUILDER;
-    INJECT_STRICT_REMOVE_BUILDER;
     return [[self routerClass] prepareDestination:destination strictConfiguring:configBuilder strictRemoving:removeConfigBuilder];
 }
 
@@ -393,10 +407,17 @@ strictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, Z
 }
 
 - (ZIKViewRouteTypeMask)supportedRouteTypes {
-    if (self.makeSupportedRouteTypesBlock) {
-        return (ZIKViewRouteTypeMask)self.makeSupportedRouteTypesBlock();
+    if (__atomic_load_n(&_supportedRouteTypesResolved, __ATOMIC_ACQUIRE)) {
+        return _supportedRouteTypes;
+    }
+    ZIKBlockViewRouteTypeMask(^makeSupportedRouteTypesBlock)(void) = self.makeSupportedRouteTypesBlock;
+    if (makeSupportedRouteTypesBlock == nil) {
+        return [[self routerClass] resolvedSupportedRouteTypes];
     }
-    return [[self routerClass] supportedRouteTypes];
+    // Racing threads get the same result from the block
+    _supportedRouteTypes = (ZIKViewRouteTypeMask)makeSupportedRouteTypesBlock();
+    __atomic_store_n(&_supportedRouteTypesResolved, true, __ATOMIC_RELEASE);
+    return _supportedRouteTypes;
 }
 
 - (BOOL)supportRouteType:(ZIKViewRouteType)type {
@@ -463,7 +484,6 @@ strictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, Z
             configuring:(void(NS_NOESCAPE ^)(ZIKViewRouteConfiguration *config))configBuilder
                removing:(void(NS_NOESCAPE ^ _Nullable)(ZIKViewRemoveConfiguration *config))removeConfigBuilder {
     INJECT_CONFIG_BUILDER;
-    INJECT_REMOVE_BUILDER;
     return [[self routerClass] performFromSource:source configuring:configBuilder removing:removeConfigBuilder];
 }
 
@@ -476,7 +496,6 @@ strictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, Z
       strictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, ZIKViewRouteConfiguration * _Nonnull))configBuilder
          strictRemoving:(void (^)(ZIKRemoveRouteStrictConfiguration<id> * _Nonnull))removeConfigBuilder {
     INJECT_STRICT_CONFIG_BUILDER;
-    INJECT_STRICT_REMOVE_BUILDER;
     return [[self routerClass] performFromSource:source strictConfiguring:configBuilder strictRemoving:removeConfigBuilder];
 }
 
@@ -491,7 +510,6 @@ strictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, Z
                configuring:(void(NS_NOESCAPE ^)(ZIKViewRouteConfiguration *config))configBuilder
                   removing:(void(NS_NOESCAPE ^ _Nullable)(ZIKViewRemoveConfiguration *config))removeConfigBuilder {
     INJECT_CONFIG_BUILDER;
-    INJECT_REMOVE_BUILDER;
     return [[self routerClass] performOnDestination:destination fromSource:source configuring:configBuilder removing:removeConfigBuilder];
 }
 
@@ -513,7 +531,6 @@ strictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, Z
          strictConfiguring:(void (^)(ZIKPerformRouteStrictConfiguration<id> * _Nonnull, ZIKViewRouteConfiguration * _Nonnull))configBuilder
             strictRemoving:(void (^)(ZIKRemoveRouteStrictConfiguration<id> * _Nonnull))removeConfigBuilder {
     INJECT_STRICT_CONFIG_BUILDER;
-    INJECT_STRICT_REMOVE_BUILDER;
     return [[self routerClass] performOnDestination:destination fromSource:source strictConfiguring:configBuilder strictRemoving:removeConfigBuilder];
 }
 
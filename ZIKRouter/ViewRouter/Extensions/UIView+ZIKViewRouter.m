@@ -10,30 +10,44 @@
 //
 
 #import "UIView+ZIKViewRouter.h"
+#import "UIView+ZIKViewRouterPrivate.h"
 #import "UIViewController+ZIKViewRouter.h"
-#import <objc/runtime.h>
+#import "ZIKViewRouteObjectState.h"
 #import "ZIKRouterRuntime.h"
 #import "ZIKClassCapabilities.h"
 
+/// Increased when any view moves or view controller changes parent. Only used on main thread. Performers and nearest view controllers cached in views are valid only in the same generation.
+static NSUInteger g_viewHierarchyGeneration = 1;
+
+void zix_invalidateRoutePerformers(void) {
+    g_viewHierarchyGeneration++;
+}
+
 #if ZIK_HAS_UIKIT
 @implementation UIView (ZIKViewRouter)
 #else
 @implementation NSView (ZIKViewRouter)
 #endif
 - (BOOL)zix_routed {
-    NSNumber *result = objc_getAssociatedObject(self, @selector(zix_routed));
-    return [result boolValue];
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    return state ? state->_routed : NO;
 }
 - (void)setZix_routed:(BOOL)routed {
-    objc_setAssociatedObject(self, @selector(zix_routed), @(routed), OBJC_ASSOCIATION_RETAIN);
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, routed);
+    if (state) {
+        state->_routed = routed;
+    }
 }
 
 - (BOOL)zix_removing {
-    NSNumber *result = objc_getAssociatedObject(self, @selector(zix_removing));
-    return [result boolValue];
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    return state ? state->_removing : NO;
 }
 - (void)setZix_removing:(BOOL)removing {
-    objc_setAssociatedObject(self, @selector(zix_removing), @(removing), OBJC_ASSOCIATION_RETAIN);
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, removing);
+    if (state) {
+        state->_removing = removing;
+    }
 }
 
 ///https://stackoverflow.com/a/3732812/6380485
@@ -41,6 +55,24 @@
     return [self zix_firstAvailableViewController];
 }
 - (nullable XXViewController *)zix_firstAvailableViewController {
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    if (state && state->_viewControllerGeneration == g_viewHierarchyGeneration) {
+        XXViewController *viewController = state->_viewController;
+        if (viewController) {
+            return viewController;
+        }
+    }
+    XXViewController *viewController = [self _zix_searchFirstAvailableViewController];
+    // Not found is not cached, view controller's root view gets its next responder without moving to superview
+    if (viewController) {
+        state = state ?: zix_viewRouteObjectState(self, YES);
+        state->_viewController = viewController;
+        state->_viewControllerGeneration = g_viewHierarchyGeneration;
+    }
+    return viewController;
+}
+
+- (nullable XXViewController *)_zix_searchFirstAvailableViewController {
     id nextResponder = [self nextResponder];
     if ([nextResponder isKindOfClass:[XXViewController class]]) {
         return nextResponder;
@@ -78,6 +110,22 @@
 - (nullable id)zix_routePerformer {
     NSAssert(self.nextResponder || [self isKindOfClass:[XXWindow class]] || [self window], @"View is not in any view hierarchy.");
     
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, YES);
+    if (state->_performerGeneration == g_viewHierarchyGeneration) {
+        id performer = state->_performer;
+        // Performer may be released without changing hierarchy
+        if (performer || state->_performerIsNil) {
+            return performer;
+        }
+    }
+    id performer = [self _zix_searchRoutePerformer];
+    state->_performer = performer;
+    state->_performerIsNil = (performer == nil);
+    state->_performerGeneration = g_viewHierarchyGeneration;
+    return performer;
+}
+
+- (nullable id)_zix_searchRoutePerformer {
     if ([self isKindOfClass:[XXWindow class]]) {
         XXViewController *performer;
         XXWindow *window = (XXWindow *)self;
@@ -13,7 +13,7 @@
 #import "UIView+ZIKViewRouter.h"
 #import "ZIKPresentationState.h"
 #import "ZIKRouterInternal.h"
-#import <objc/runtime.h>
+#import "ZIKViewRouteObjectState.h"
 #import "ZIKClassCapabilities.h"
 
 #if ZIK_HAS_UIKIT
@@ -23,21 +23,27 @@
 #endif
 
 - (BOOL)zix_routed {
-    NSNumber *result = objc_getAssociatedObject(self, @selector(zix_routed));
-    return [result boolValue];
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    return state ? state->_routed : NO;
 }
 
 - (void)setZix_routed:(BOOL)routed {
-    objc_setAssociatedObject(self, @selector(zix_routed), @(routed), OBJC_ASSOCIATION_RETAIN);
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, routed);
+    if (state) {
+        state->_routed = routed;
+    }
 }
 
 - (BOOL)zix_removing {
-    NSNumber *result = objc_getAssociatedObject(self, @selector(zix_removing));
-    return [result boolValue];
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    return state ? state->_removing : NO;
 }
 
 - (void)setZix_removing:(BOOL)removing {
-    objc_setAssociatedObject(self, @selector(zix_removing), @(removing), OBJC_ASSOCIATION_RETAIN);
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, removing);
+    if (state) {
+        state->_removing = removing;
+    }
 }
 
 #if ZIK_HAS_UIKIT
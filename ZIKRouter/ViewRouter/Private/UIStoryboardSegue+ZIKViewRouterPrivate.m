@@ -10,7 +10,7 @@
 //
 
 #import "UIStoryboardSegue+ZIKViewRouterPrivate.h"
-#import <objc/runtime.h>
+#import "ZIKViewRouteObjectState.h"
 
 #if ZIK_HAS_UIKIT
 @implementation UIStoryboardSegue (ZIKViewRouterPrivate)
@@ -18,9 +18,13 @@
 @implementation NSStoryboardSegue (ZIKViewRouterPrivate)
 #endif
 - (nullable Class)zix_currentClassCallingPerform {
-    return objc_getAssociatedObject(self, @selector(zix_currentClassCallingPerform));
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    return state ? state->_currentClassCallingPerform : nil;
 }
 - (void)setZix_currentClassCallingPerform:(nullable Class)vcClass {
-    objc_setAssociatedObject(self, @selector(zix_currentClassCallingPerform), vcClass, OBJC_ASSOCIATION_RETAIN);
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, vcClass != nil);
+    if (state) {
+        state->_currentClassCallingPerform = vcClass;
+    }
 }
 @end
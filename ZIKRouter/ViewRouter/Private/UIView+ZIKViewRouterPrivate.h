@@ -39,6 +39,12 @@ NS_ASSUME_NONNULL_BEGIN
 /// Route type when view is routed from a router, will reset to nil when finish routing.
 - (nullable NSNumber *)zix_routeTypeFromRouter;
 - (void)setZix_routeTypeFromRouter:(nullable NSNumber *)routeType;
+/// Router bound to the reusable view by +bindToReusableView:configuring:.
+- (nullable __kindof ZIKViewRouter *)zix_boundViewRouterOfClass:(Class)routerClass;
+- (void)setZix_boundViewRouter:(nullable ZIKViewRouter *)viewRouter ofClass:(Class)routerClass;
 @end
 
+/// Invalidate performers cached by -zix_routePerformer. Hooks call it when view hierarchy changes.
+FOUNDATION_EXTERN void zix_invalidateRoutePerformers(void);
+
 NS_ASSUME_NONNULL_END
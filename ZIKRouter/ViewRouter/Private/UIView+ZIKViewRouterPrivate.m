@@ -11,7 +11,7 @@
 
 #import "UIView+ZIKViewRouterPrivate.h"
 #import "ZIKViewRouter.h"
-#import <objc/runtime.h>
+#import "ZIKViewRouteObjectState.h"
 
 #if ZIK_HAS_UIKIT
 @implementation UIView (ZIKViewRouterPrivate)
@@ -21,20 +21,49 @@
 
 ///Temporary bind auto created router to an UIView when it's not addSubView: by router. Reset to nil when view is routed or removed.
 - (__kindof ZIKViewRouter *)zix_destinationViewRouter {
-    return objc_getAssociatedObject(self, @selector(zix_destinationViewRouter));
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    return state ? state->_destinationViewRouter : nil;
 }
 - (void)setZix_destinationViewRouter:(nullable ZIKViewRouter *)viewRouter {
-    objc_setAssociatedObject(self, @selector(zix_destinationViewRouter), viewRouter, OBJC_ASSOCIATION_RETAIN);
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, viewRouter != nil);
+    if (state) {
+        state->_destinationViewRouter = viewRouter;
+    }
 }
 ///Route type when view is routed from a router, will reset to nil when view is routed or removed.
 - (nullable NSNumber *)zix_routeTypeFromRouter {
-    NSNumber *result = objc_getAssociatedObject(self, @selector(zix_routeTypeFromRouter));
-    return result;
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    if (state == nil || !state->_hasRouteTypeFromRouter) {
+        return nil;
+    }
+    return @(state->_routeTypeFromRouter);
 }
 - (void)setZix_routeTypeFromRouter:(nullable NSNumber *)routeType {
     NSParameterAssert(!routeType ||
                       [routeType integerValue] <= ZIKViewRouteTypeMakeDestination);
-    objc_setAssociatedObject(self, @selector(zix_routeTypeFromRouter), routeType, OBJC_ASSOCIATION_RETAIN);
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, routeType != nil);
+    if (state) {
+        state->_hasRouteTypeFromRouter = (routeType != nil);
+        state->_routeTypeFromRouter = [routeType integerValue];
+    }
+}
+- (nullable __kindof ZIKViewRouter *)zix_boundViewRouterOfClass:(Class)routerClass {
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    return state ? state->_boundViewRouters[(id<NSCopying>)routerClass] : nil;
+}
+- (void)setZix_boundViewRouter:(nullable ZIKViewRouter *)viewRouter ofClass:(Class)routerClass {
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, viewRouter != nil);
+    if (state == nil) {
+        return;
+    }
+    if (viewRouter) {
+        if (state->_boundViewRouters == nil) {
+            state->_boundViewRouters = [NSMutableDictionary dictionary];
+        }
+        state->_boundViewRouters[(id<NSCopying>)routerClass] = viewRouter;
+    } else {
+        [state->_boundViewRouters removeObjectForKey:routerClass];
+    }
 }
 
 @end
@@ -12,7 +12,7 @@
 #import "UIViewController+ZIKViewRouterPrivate.h"
 #import "ZIKViewRouter.h"
 #import "ZIKClassCapabilities.h"
-#import <objc/runtime.h>
+#import "ZIKViewRouteObjectState.h"
 
 #if ZIK_HAS_UIKIT
 @implementation UIViewController (ZIKViewRouterPrivate)
@@ -20,39 +20,55 @@
 @implementation NSViewController (ZIKViewRouterPrivate)
 #endif
 - (nullable NSNumber *)zix_routeTypeFromRouter {
-    NSNumber *result = objc_getAssociatedObject(self, @selector(zix_routeTypeFromRouter));
-    return result;
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    if (state == nil || !state->_hasRouteTypeFromRouter) {
+        return nil;
+    }
+    return @(state->_routeTypeFromRouter);
 }
 - (void)setZix_routeTypeFromRouter:(nullable NSNumber *)routeType {
     NSParameterAssert(!routeType ||
                       [routeType integerValue] <= ZIKViewRouteTypeMakeDestination);
-    objc_setAssociatedObject(self, @selector(zix_routeTypeFromRouter), routeType, OBJC_ASSOCIATION_RETAIN);
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, routeType != nil);
+    if (state) {
+        state->_hasRouteTypeFromRouter = (routeType != nil);
+        state->_routeTypeFromRouter = [routeType integerValue];
+    }
 }
 - (nullable NSArray<ZIKViewRouter *> *)zix_destinationViewRouters {
-    return objc_getAssociatedObject(self, @selector(zix_destinationViewRouters));
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    return state ? state->_destinationViewRouters : nil;
 }
 - (void)setZix_destinationViewRouters:(nullable NSArray<ZIKViewRouter *> *)viewRouters {
     NSParameterAssert(!viewRouters || [viewRouters isKindOfClass:[NSArray class]]);
-    objc_setAssociatedObject(self, @selector(zix_destinationViewRouters), viewRouters, OBJC_ASSOCIATION_RETAIN);
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, viewRouters != nil);
+    if (state) {
+        state->_destinationViewRouters = viewRouters;
+    }
 }
 - (__kindof ZIKViewRouter *)zix_sourceViewRouter {
-    return objc_getAssociatedObject(self, @selector(zix_sourceViewRouter));
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    return state ? state->_sourceViewRouter : nil;
 }
 - (void)setZix_sourceViewRouter:(nullable __kindof ZIKViewRouter *)viewRouter {
-    objc_setAssociatedObject(self, @selector(zix_sourceViewRouter), viewRouter, OBJC_ASSOCIATION_RETAIN);
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, viewRouter != nil);
+    if (state) {
+        state->_sourceViewRouter = viewRouter;
+    }
 }
 - (nullable Class)zix_currentClassCallingPrepareForSegue {
-    return objc_getAssociatedObject(self, @selector(zix_currentClassCallingPrepareForSegue));
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    return state ? state->_currentClassCallingPrepareForSegue : nil;
 }
 - (void)setZix_currentClassCallingPrepareForSegue:(nullable Class)vcClass {
-    objc_setAssociatedObject(self, @selector(zix_currentClassCallingPrepareForSegue), vcClass, OBJC_ASSOCIATION_RETAIN);
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, vcClass != nil);
+    if (state) {
+        state->_currentClassCallingPrepareForSegue = vcClass;
+    }
 }
 - (nullable XXViewController *)zix_parentMovingTo {
-    XXViewController *(^weakContainer)(void) = objc_getAssociatedObject(self, @selector(zix_parentMovingTo));
-    if (weakContainer) {
-        return weakContainer();
-    }
-    return nil;
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    return state ? state->_parentMovingTo : nil;
 }
 - (void)setZix_parentMovingTo:(nullable XXViewController *)parentMovingTo {
     NSParameterAssert(!parentMovingTo
@@ -62,22 +78,14 @@
                       || [parentMovingTo isKindOfClass:[NSWindow class]]
 #endif
                       );
-    id object = nil;
-    if (parentMovingTo) {
-        __weak typeof(XXViewController *)weakParent = parentMovingTo;
-        XXViewController *(^weakContainer)(void) = ^ {
-            return weakParent;
-        };
-        object = weakContainer;
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, parentMovingTo != nil);
+    if (state) {
+        state->_parentMovingTo = parentMovingTo;
     }
-    objc_setAssociatedObject(self, @selector(zix_parentMovingTo), object, OBJC_ASSOCIATION_RETAIN);
 }
 - (nullable XXViewController *)zix_parentRemovingFrom {
-    XXViewController *(^weakContainer)(void) = objc_getAssociatedObject(self, @selector(zix_parentRemovingFrom));
-    if (weakContainer) {
-        return weakContainer();
-    }
-    return nil;
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    return state ? state->_parentRemovingFrom : nil;
 }
 - (void)setZix_parentRemovingFrom:(nullable XXViewController *)parentRemovingFrom {
     NSParameterAssert(!parentRemovingFrom
@@ -87,15 +95,10 @@
                       || [parentRemovingFrom isKindOfClass:[NSWindow class]]
 #endif
                       );
-    id object;
-    if (parentRemovingFrom) {
-        __weak typeof(XXViewController *)weakParent = parentRemovingFrom;
-        XXViewController *(^weakContainer)(void) = ^ {
-            return weakParent;
-        };
-        object = weakContainer;
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, parentRemovingFrom != nil);
+    if (state) {
+        state->_parentRemovingFrom = parentRemovingFrom;
     }
-    objc_setAssociatedObject(self, @selector(zix_parentRemovingFrom), object, OBJC_ASSOCIATION_RETAIN);
 }
 
 #if ZIK_HAS_UIKIT
@@ -120,23 +123,35 @@
 @implementation NSWindowController (ZIKViewRouterPrivate)
 
 - (nullable NSArray<ZIKViewRouter *> *)zix_destinationViewRouters {
-    return objc_getAssociatedObject(self, @selector(zix_destinationViewRouters));
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    return state ? state->_destinationViewRouters : nil;
 }
 - (void)setZix_destinationViewRouters:(nullable NSArray<ZIKViewRouter *> *)viewRouters {
     NSParameterAssert(!viewRouters || [viewRouters isKindOfClass:[NSArray class]]);
-    objc_setAssociatedObject(self, @selector(zix_destinationViewRouters), viewRouters, OBJC_ASSOCIATION_RETAIN);
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, viewRouters != nil);
+    if (state) {
+        state->_destinationViewRouters = viewRouters;
+    }
 }
 - (__kindof ZIKViewRouter *)zix_sourceViewRouter {
-    return objc_getAssociatedObject(self, @selector(zix_sourceViewRouter));
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    return state ? state->_sourceViewRouter : nil;
 }
 - (void)setZix_sourceViewRouter:(nullable __kindof ZIKViewRouter *)viewRouter {
-    objc_setAssociatedObject(self, @selector(zix_sourceViewRouter), viewRouter, OBJC_ASSOCIATION_RETAIN);
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, viewRouter != nil);
+    if (state) {
+        state->_sourceViewRouter = viewRouter;
+    }
 }
 - (nullable Class)zix_currentClassCallingPrepareForSegue {
-    return objc_getAssociatedObject(self, @selector(zix_currentClassCallingPrepareForSegue));
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, NO);
+    return state ? state->_currentClassCallingPrepareForSegue : nil;
 }
 - (void)setZix_currentClassCallingPrepareForSegue:(nullable Class)vcClass {
-    objc_setAssociatedObject(self, @selector(zix_currentClassCallingPrepareForSegue), vcClass, OBJC_ASSOCIATION_RETAIN);
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(self, vcClass != nil);
+    if (state) {
+        state->_currentClassCallingPrepareForSegue = vcClass;
+    }
 }
 
 @end
@@ -0,0 +1,60 @@
+//
+//  ZIKPresentationSnapshot.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKPlatformCapabilities.h"
+#if ZIK_HAS_UIKIT
+#import <UIKit/UIKit.h>
+#import "ZIKPresentationState.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_OPTIONS(uint32_t, ZIKPresentationFlags) {
+    ZIKPresentationFlagModalPresentationPopover = 1 << 0,
+    ZIKPresentationFlagViewLoaded = 1 << 1,
+    ZIKPresentationFlagNavigationModalPresentationPopover = 1 << 2,
+    ZIKPresentationFlagNavigationViewLoaded = 1 << 3
+};
+
+/// Value type version of ZIKPresentationState. View controllers are stored by address, and stacks are stored as count, hash and index of the view controller, so snapshots are compared without allocation.
+typedef struct ZIKPresentationSnapshot {
+    uintptr_t viewController;
+    uintptr_t presentingViewController;
+    uintptr_t navigationController;
+    uintptr_t splitController;
+    uintptr_t parentViewController;
+    uint64_t navigationStackHash;
+    NSUInteger navigationStackCount;
+    /// NSNotFound when the view controller is not in navigation stack.
+    NSUInteger indexInNavigationStack;
+    uint64_t splitStackHash;
+    NSUInteger splitStackCount;
+    /// NSNotFound when the view controller is not in split view controllers.
+    NSUInteger indexInSplitStack;
+    /// States of navigationController.
+    uintptr_t navigationPresentingViewController;
+    uintptr_t navigationSplitController;
+    uintptr_t navigationParentViewController;
+    uint64_t navigationSplitStackHash;
+    NSUInteger navigationSplitStackCount;
+    NSUInteger navigationIndexInSplitStack;
+    ZIKPresentationFlags flags;
+} ZIKPresentationSnapshot;
+
+/// Capture presentation state of the view controller. Must be called on main thread.
+FOUNDATION_EXTERN ZIKPresentationSnapshot zix_presentationSnapshot(UIViewController *viewController);
+
+FOUNDATION_EXTERN BOOL zix_presentationSnapshotsEqual(const ZIKPresentationSnapshot *before, const ZIKPresentationSnapshot *after);
+
+/// Same as +[ZIKPresentationState detailRouteTypeFromStateBeforeRoute:stateAfterRoute:].
+FOUNDATION_EXTERN ZIKViewRouteDetailType zix_detailRouteTypeFromSnapshots(const ZIKPresentationSnapshot *before, const ZIKPresentationSnapshot *after);
+
+NS_ASSUME_NONNULL_END
+#endif
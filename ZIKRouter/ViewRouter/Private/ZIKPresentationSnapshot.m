@@ -0,0 +1,313 @@
+//
+//  ZIKPresentationSnapshot.m
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKPresentationSnapshot.h"
+
+#if ZIK_HAS_UIKIT
+
+/// Hash addresses in order, and find index of target at the same time.
+static uint64_t _hashOfViewControllers(NSArray<UIViewController *> *viewControllers, uintptr_t target, NSUInteger *count, NSUInteger *index) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    NSUInteger i = 0;
+    *index = NSNotFound;
+    for (UIViewController *vc in viewControllers) {
+        uintptr_t address = (uintptr_t)vc;
+        if (address == target && *index == NSNotFound) {
+            *index = i;
+        }
+        hash = (hash ^ (uint64_t)address) * 0x100000001b3ULL;
+        i++;
+    }
+    *count = i;
+    return hash;
+}
+
+ZIKPresentationSnapshot zix_presentationSnapshot(UIViewController *viewController) {
+    NSCAssert([NSThread isMainThread], @"ZIKPresentationSnapshot must be created in main thread.");
+    ZIKPresentationSnapshot snapshot = {0};
+    snapshot.indexInNavigationStack = NSNotFound;
+    snapshot.indexInSplitStack = NSNotFound;
+    snapshot.navigationIndexInSplitStack = NSNotFound;
+    snapshot.viewController = (uintptr_t)viewController;
+
+    UIViewController *presentingViewController = viewController.presentingViewController;
+    if (presentingViewController) {
+        snapshot.presentingViewController = (uintptr_t)presentingViewController;
+#if !TARGET_OS_TV
+        if (viewController.modalPresentationStyle == UIModalPresentationPopover) {
+            snapshot.flags |= ZIKPresentationFlagModalPresentationPopover;
+        }
+#endif
+    }
+
+    UINavigationController *navigationController = viewController.navigationController;
+    if (navigationController) {
+        uintptr_t navigation = (uintptr_t)navigationController;
+        snapshot.navigationController = navigation;
+        snapshot.navigationStackHash = _hashOfViewControllers(navigationController.viewControllers, snapshot.viewController, &snapshot.navigationStackCount, &snapshot.indexInNavigationStack);
+
+        UIViewController *navigationPresenting = navigationController.presentingViewController;
+        if (navigationPresenting) {
+            snapshot.navigationPresentingViewController = (uintptr_t)navigationPresenting;
+#if !TARGET_OS_TV
+            if (navigationController.modalPresentationStyle == UIModalPresentationPopover) {
+                snapshot.flags |= ZIKPresentationFlagNavigationModalPresentationPopover;
+            }
+#endif
+        }
+        UISplitViewController *navigationSplit = navigationController.splitViewController;
+        if (navigationSplit) {
+            snapshot.navigationSplitController = (uintptr_t)navigationSplit;
+            snapshot.navigationSplitStackHash = _hashOfViewControllers(navigationSplit.viewControllers, navigation, &snapshot.navigationSplitStackCount, &snapshot.navigationIndexInSplitStack);
+        }
+        snapshot.navigationParentViewController = (uintptr_t)navigationController.parentViewController;
+        if (navigationController.isViewLoaded) {
+            snapshot.flags |= ZIKPresentationFlagNavigationViewLoaded;
+        }
+    }
+
+    UISplitViewController *splitViewController = viewController.splitViewController;
+    if (splitViewController) {
+        snapshot.splitController = (uintptr_t)splitViewController;
+        snapshot.splitStackHash = _hashOfViewControllers(splitViewController.viewControllers, snapshot.viewController, &snapshot.splitStackCount, &snapshot.indexInSplitStack);
+    }
+
+    snapshot.parentViewController = (uintptr_t)viewController.parentViewController;
+    if (viewController.isViewLoaded) {
+        snapshot.flags |= ZIKPresentationFlagViewLoaded;
+    }
+    return snapshot;
+}
+
+BOOL zix_presentationSnapshotsEqual(const ZIKPresentationSnapshot *before, const ZIKPresentationSnapshot *after) {
+    // Unused fields are always zero, so compare field by field
+    return before->viewController == after->viewController &&
+    before->presentingViewController == after->presentingViewController &&
+    before->navigationController == after->navigationController &&
+    before->navigationStackCount == after->navigationStackCount &&
+    before->navigationStackHash == after->navigationStackHash &&
+    before->navigationPresentingViewController == after->navigationPresentingViewController &&
+    before->navigationSplitController == after->navigationSplitController &&
+    before->navigationSplitStackCount == after->navigationSplitStackCount &&
+    before->navigationSplitStackHash == after->navigationSplitStackHash &&
+    before->navigationParentViewController == after->navigationParentViewController &&
+    before->splitController == after->splitController &&
+    before->splitStackCount == after->splitStackCount &&
+    before->splitStackHash == after->splitStackHash &&
+    before->parentViewController == after->parentViewController &&
+    before->flags == after->flags;
+}
+
+/// Snapshot of the navigation controller recorded in snapshot.
+static ZIKPresentationSnapshot _navigationSnapshot(const ZIKPresentationSnapshot *snapshot) {
+    ZIKPresentationSnapshot navigation = {0};
+    navigation.indexInNavigationStack = NSNotFound;
+    navigation.navigationIndexInSplitStack = NSNotFound;
+    navigation.viewController = snapshot->navigationController;
+    navigation.presentingViewController = snapshot->navigationPresentingViewController;
+    navigation.splitController = snapshot->navigationSplitController;
+    navigation.splitStackHash = snapshot->navigationSplitStackHash;
+    navigation.splitStackCount = snapshot->navigationSplitStackCount;
+    navigation.indexInSplitStack = snapshot->navigationIndexInSplitStack;
+    navigation.parentViewController = snapshot->navigationParentViewController;
+    if (snapshot->flags & ZIKPresentationFlagNavigationModalPresentationPopover) {
+        navigation.flags |= ZIKPresentationFlagModalPresentationPopover;
+    }
+    if (snapshot->flags & ZIKPresentationFlagNavigationViewLoaded) {
+        navigation.flags |= ZIKPresentationFlagViewLoaded;
+    }
+    return navigation;
+}
+
+static inline BOOL _navigationStatesEqual(const ZIKPresentationSnapshot *before, const ZIKPresentationSnapshot *after) {
+    return before->navigationPresentingViewController == after->navigationPresentingViewController &&
+    before->navigationSplitController == after->navigationSplitController &&
+    before->navigationSplitStackCount == after->navigationSplitStackCount &&
+    before->navigationSplitStackHash == after->navigationSplitStackHash &&
+    before->navigationParentViewController == after->navigationParentViewController &&
+    (before->flags & (ZIKPresentationFlagNavigationModalPresentationPopover | ZIKPresentationFlagNavigationViewLoaded)) == (after->flags & (ZIKPresentationFlagNavigationModalPresentationPopover | ZIKPresentationFlagNavigationViewLoaded));
+}
+
+ZIKViewRouteDetailType zix_detailRouteTypeFromSnapshots(const ZIKPresentationSnapshot *before, const ZIKPresentationSnapshot *after) {
+    NSCAssert(before->viewController == after->viewController, @"Analyze route type from before state and after state must created from same view controller !");
+
+    if (before->viewController != after->viewController) {
+        return ZIKViewRouteDetailTypeCustom;
+    }
+
+    uintptr_t navBefore = before->navigationController;
+    uintptr_t navAfter = after->navigationController;
+    uintptr_t parentViewControllerBefore = before->parentViewController;
+    uintptr_t parentViewControllerAfter = after->parentViewController;
+    uintptr_t splitBefore = before->splitController;
+    uintptr_t splitAfter = after->splitController;
+    BOOL inNavigationStackBefore = before->indexInNavigationStack != NSNotFound;
+    BOOL inNavigationStackAfter = after->indexInNavigationStack != NSNotFound;
+
+    //check navigation
+    if (!navBefore && navAfter) {
+        NSCAssert(parentViewControllerAfter, @"if a view controller has navigationController, it should have a parent");
+
+        NSUInteger indexInStack = after->indexInNavigationStack;
+        if (indexInStack == 0) {//is root of navigationController
+            NSCAssert(parentViewControllerAfter == navAfter, @"UINavigationController's rootViewController's parentViewController should be it self.");
+
+            if (after->navigationParentViewController) {
+                if (after->navigationParentViewController != after->navigationSplitController) {//the navigationController was added to a parent
+                    if (parentViewControllerBefore != parentViewControllerAfter) {
+                        if (!parentViewControllerBefore) {
+                            return ZIKViewRouteDetailTypeAddAsChildViewController;
+                        }
+                        return ZIKViewRouteDetailTypeChangeParentViewController;
+                    }
+                }
+            } else if (after->navigationPresentingViewController) {//the navigationController was presented
+                if ([UIDevice currentDevice].userInterfaceIdiom != UIUserInterfaceIdiomPad) {
+                    return ZIKViewRouteDetailTypePresentModally;
+                }
+                if (after->flags & ZIKPresentationFlagNavigationModalPresentationPopover) {
+                    return ZIKViewRouteDetailTypePresentAsPopover;
+                }
+                return ZIKViewRouteDetailTypePresentModally;
+            }
+        } else if (indexInStack == NSNotFound) {//is child of a view controller in navigation stack
+            NSCAssert(parentViewControllerAfter, @"logically, this view controller should be a child of a view controller in navigation stack");
+
+            if (!parentViewControllerBefore) {
+                return ZIKViewRouteDetailTypeAddAsChildViewController;
+            }
+            if (parentViewControllerBefore == parentViewControllerAfter) {
+                return ZIKViewRouteDetailTypeParentPushed;
+            }
+            return ZIKViewRouteDetailTypeChangeParentViewController;
+        } else {//in navigation stack
+            return ZIKViewRouteDetailTypePush;
+        }
+    } else if (navBefore && navAfter) {
+        NSCAssert(parentViewControllerBefore, @"if a view controller has navigationController, it should have a parent");
+        NSCAssert(parentViewControllerAfter, @"if a view controller has navigationController, it should have a parent");
+
+        if (navBefore != navAfter) {//navigationController was changed
+            if (parentViewControllerBefore != parentViewControllerAfter) {//parent was changed
+                if (parentViewControllerBefore == navBefore &&
+                    parentViewControllerAfter == navAfter) {//this view controller changed navigationController
+                    return ZIKViewRouteDetailTypeChangeNavigationController;
+                }
+                return ZIKViewRouteDetailTypeChangeParentViewController;//removed from navigation stack or parent in a navigation stack, then pushed into another navigation stack or added to a parent in another navigation stack
+            } else {
+                return ZIKViewRouteDetailTypeParentChangeNavigationController;//its parent changed navigationController
+            }
+        }
+
+        if (inNavigationStackBefore && inNavigationStackAfter) {//still in the same navigationController
+            NSCAssert(navBefore == parentViewControllerBefore, @"UINavigationController's viewControllers' parent should be the UINavigationController");
+            NSCAssert(navAfter == parentViewControllerAfter, @"UINavigationController's viewControllers' parent should be the UINavigationController");
+
+            if (before->indexInNavigationStack != after->indexInNavigationStack) {
+                return ZIKViewRouteDetailTypeChangeOrderInNavigationStack;
+            }
+            if (before->navigationStackCount > after->navigationStackCount) {
+                return ZIKViewRouteDetailTypeNavigationPopOthers;
+            } else if (before->navigationStackCount < after->navigationStackCount) {
+                return ZIKViewRouteDetailTypeNavigationPushOthers;
+            } else if (!_navigationStatesEqual(before, after)) {//its navigationController changed presentation
+                ZIKPresentationSnapshot navigationBefore = _navigationSnapshot(before);
+                ZIKPresentationSnapshot navigationAfter = _navigationSnapshot(after);
+                return zix_detailRouteTypeFromSnapshots(&navigationBefore, &navigationAfter);
+            }
+        } else if (inNavigationStackBefore && !inNavigationStackAfter) {//before:in navigation stack, after:added to a parent in a  navigation stack
+            NSCAssert(navBefore == parentViewControllerBefore, @"UINavigationController's viewControllers' parent should be the UINavigationController");
+            NSCAssert(navAfter != parentViewControllerAfter, @"If a view controller is not in its UINavigationController's viewControllers, it should be in child of a vc in those viewControllers");
+            NSCAssert(parentViewControllerBefore != parentViewControllerAfter, @"View controller was removed from its navigation stack, so its parent should be different");
+
+            return ZIKViewRouteDetailTypeChangeParentViewController;//removed from navigation stack, then  added to a parent in same navigation stack
+        } else if (!inNavigationStackBefore && inNavigationStackAfter) {//before:child of a parent in a navigation stack, after: pushed in same navigation stack
+            NSCAssert(navBefore != parentViewControllerBefore, @"If a view controller is not in its UINavigationController's viewControllers, it should be in child of a vc in those viewControllers");
+            NSCAssert(navAfter == parentViewControllerAfter, @"UINavigationController's viewControllers' parent should be the UINavigationController");
+            NSCAssert(parentViewControllerBefore != parentViewControllerAfter, @"View controller was pushed into navigation stack, so its parent should be different");
+
+            return ZIKViewRouteDetailTypeChangeParentViewController;
+        }
+    } else if (navBefore && !navAfter) {
+        if (inNavigationStackBefore) {
+            return ZIKViewRouteDetailTypeRemoveFromNavigationStack;
+        }
+    }
+
+    ///check present style
+    uintptr_t presentingBefore = before->presentingViewController;
+    uintptr_t presentingAfter = after->presentingViewController;
+    if (!presentingBefore && presentingAfter) {//before: not presented, after: be presented
+        if (after->flags & ZIKPresentationFlagModalPresentationPopover) {
+            return ZIKViewRouteDetailTypePresentAsPopover;
+        }
+        return ZIKViewRouteDetailTypePresentModally;
+    } else if (presentingBefore && !presentingAfter) {
+        return ZIKViewRouteDetailTypeDismissed;
+    }
+
+    //check split
+    if (splitBefore && splitAfter) {
+        if (before->indexInSplitStack != after->indexInSplitStack) {
+            return ZIKViewRouteDetailTypeCustom;
+        }
+    } else if (!splitBefore && splitAfter) {
+        NSUInteger index = after->indexInSplitStack;
+        if (index == 0) {
+            return ZIKViewRouteDetailTypeBecomeSplitMaster;
+        } else if (index == 1) {
+            return ZIKViewRouteDetailTypeBecomeSplitDetail;
+        } else {
+            NSCAssert(parentViewControllerAfter, @"view controller should be a child of a view controller in master/detail");
+
+            if (parentViewControllerBefore == parentViewControllerAfter) {//parent is same, but parent was added into a split
+                return ZIKViewRouteDetailTypeParentChangeSplitController;
+            } else if (!parentViewControllerBefore) {//added as a child of a view controller in master/detail
+                return ZIKViewRouteDetailTypeAddAsChildViewController;
+            }
+        }
+    } else if (splitBefore && !splitAfter) {
+        NSUInteger index = before->indexInSplitStack;
+        if (index == 0) {
+            return ZIKViewRouteDetailTypeRemoveAsSplitMaster;
+        } else if (index == 1) {
+            return ZIKViewRouteDetailTypeRemoveAsSplitDetail;
+        } else {
+            if (parentViewControllerBefore == parentViewControllerAfter) {//parent is same, but parent was removed from a split
+                return ZIKViewRouteDetailTypeParentChangeSplitController;
+            } else if (parentViewControllerBefore) {//view controller was removed from a parent in a split
+                return ZIKViewRouteDetailTypeRemoveFromParentViewController;
+            }
+
+            if (!parentViewControllerAfter) {
+                return ZIKViewRouteDetailTypeRemoveFromParentViewController;
+            } else {
+                return ZIKViewRouteDetailTypeCustom;
+            }
+        }
+    }
+
+    //check parent
+    if (parentViewControllerBefore == parentViewControllerAfter) {
+        return ZIKViewRouteDetailTypeCustom;
+    }
+    if (!parentViewControllerBefore && parentViewControllerAfter) {
+        return ZIKViewRouteDetailTypeAddAsChildViewController;
+    }
+    if (parentViewControllerBefore && parentViewControllerAfter &&
+        parentViewControllerBefore != parentViewControllerAfter) {
+        return ZIKViewRouteDetailTypeChangeParentViewController;
+    }
+
+    return ZIKViewRouteDetailTypeCustom;
+}
+
+#endif
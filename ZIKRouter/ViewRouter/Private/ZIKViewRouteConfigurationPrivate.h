@@ -11,6 +11,7 @@
 
 #import "ZIKViewRouteConfiguration.h"
 #import "ZIKClassCapabilities.h"
+#import "ZIKPresentationSnapshot.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -25,14 +26,20 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, assign) BOOL popoverLayoutMarginsConfiged;
 @end
 
-@class ZIKPresentationState;
 @interface ZIKViewRouteSegueConfiguration ()
 
 @property (nonatomic, weak, nullable) XXViewController *segueSource;
 @property (nonatomic, weak, nullable) XXViewController *segueDestination;
 #if ZIK_HAS_UIKIT
-@property (nonatomic, strong, nullable) ZIKPresentationState *destinationStateBeforeRoute;
+@property (nonatomic, assign) ZIKPresentationSnapshot destinationStateBeforeRoute;
+@property (nonatomic, assign) BOOL hasDestinationStateBeforeRoute;
 #endif
 @end
 
+@interface ZIKViewRouteConfigurationTemplate ()
+- (instancetype)initWithConfiguration:(ZIKViewRouteConfiguration *)configuration routerClass:(Class)routerClass;
+/// New configuration for one performing. Fields are copied from the template, user info is copied when it's changed.
+- (ZIKViewRouteConfiguration *)makeConfiguration;
+@end
+
 NS_ASSUME_NONNULL_END
@@ -0,0 +1,51 @@
+//
+//  ZIKViewRouteObjectState.h
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ZIKViewRouter;
+
+/// Route state of a view, view controller, window controller or segue. All states of an object are stored in one associated object, so each access is one lookup without boxing.
+@interface ZIKViewRouteObjectState : NSObject {
+    @package
+    BOOL _routed;
+    BOOL _removing;
+    /// Whether `_routeTypeFromRouter` is set.
+    BOOL _hasRouteTypeFromRouter;
+    /// Whether the performer was nil when `_performerGeneration` was recorded.
+    BOOL _performerIsNil;
+    NSInteger _routeTypeFromRouter;
+    NSUInteger _performerGeneration;
+    __weak id _performer;
+    /// View hierarchy generation when `_viewController` was recorded.
+    NSUInteger _viewControllerGeneration;
+    /// Nearest view controller of the view, cached by -zix_firstAvailableViewController.
+    __weak id _viewController;
+    __weak id _parentMovingTo;
+    __weak id _parentRemovingFrom;
+    ZIKViewRouter *_destinationViewRouter;
+    NSArray<ZIKViewRouter *> *_destinationViewRouters;
+    ZIKViewRouter *_sourceViewRouter;
+    Class _currentClassCallingPrepareForSegue;
+    Class _currentClassCallingPerform;
+    /// Routers attached to the destination, weakly held.
+    NSHashTable<ZIKViewRouter *> *_attachedRouters;
+    /// Routers bound to the reusable view, keyed by router class.
+    NSMutableDictionary<Class, ZIKViewRouter *> *_boundViewRouters;
+}
+@end
+
+/// Get state of the object. When `create` is NO, return nil if no state was stored, so reading state doesn't allocate.
+FOUNDATION_EXTERN ZIKViewRouteObjectState *_Nullable zix_viewRouteObjectState(id object, BOOL create);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,38 @@
+//
+//  ZIKViewRouteObjectState.m
+//  ZIKRouter
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#import "ZIKViewRouteObjectState.h"
+#import <objc/runtime.h>
+
+static const char kZIKViewRouteObjectStateKey = 0;
+
+@implementation ZIKViewRouteObjectState
+@end
+
+ZIKViewRouteObjectState *zix_viewRouteObjectState(id object, BOOL create) {
+    ZIKViewRouteObjectState *state = objc_getAssociatedObject(object, &kZIKViewRouteObjectStateKey);
+    if (state == nil && create) {
+        // Routers may attach destination on other threads, don't let two states replace each other
+        static dispatch_semaphore_t lock;
+        static dispatch_once_t onceToken;
+        dispatch_once(&onceToken, ^{
+            lock = dispatch_semaphore_create(1);
+        });
+        dispatch_semaphore_wait(lock, DISPATCH_TIME_FOREVER);
+        state = objc_getAssociatedObject(object, &kZIKViewRouteObjectStateKey);
+        if (state == nil) {
+            state = [ZIKViewRouteObjectState new];
+            objc_setAssociatedObject(object, &kZIKViewRouteObjectStateKey, state, OBJC_ASSOCIATION_RETAIN);
+        }
+        dispatch_semaphore_signal(lock);
+    }
+    return state;
+}
@@ -10,6 +10,7 @@
 //
 
 #import "ZIKViewRoute.h"
+#import "ZIKRouteCallbacks.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -21,6 +22,8 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, copy, readonly, nullable) BOOL(^canRemoveCustomRouteBlock)(ZIKViewRouter *router);
 @property (nonatomic, copy, readonly, nullable) void(^performCustomRouteBlock)(Destination destination, _Nullable id source, RouteConfig config, ZIKViewRouter *router);
 @property (nonatomic, copy, readonly, nullable) void(^removeCustomRouteBlock)(Destination destination, _Nullable id source, ZIKViewRemoveConfiguration *removeConfig, RouteConfig config, ZIKViewRouter *router);
+/// View callbacks resolved from blocks. The pointer is valid while the route is alive.
+@property (nonatomic, readonly) const ZIKViewRouteCallbacks *viewCallbacks;
 
 - (BOOL)supportRouteType:(ZIKViewRouteType)type;
 
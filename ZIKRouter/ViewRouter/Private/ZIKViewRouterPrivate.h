@@ -24,6 +24,33 @@ NS_ASSUME_NONNULL_BEGIN
 + (instancetype)routerFromView:(XXView *)destination source:(XXView *)source;
 + (instancetype)routerFromView:(XXView *)destination source:(XXView *)source configuring:(void(^ _Nullable)(__kindof ZIKViewRouteConfiguration *config))configBuilder;
 
+#pragma mark Route Types
+
+/// `+supportedRouteTypes` of the router class, resolved once and cached. Safe to call from any thread.
++ (ZIKViewRouteTypeMask)resolvedSupportedRouteTypes;
+
 @end
 
+/// Clear cached routers overriding AOP callbacks. Called when registry invalidates resolved routes.
+FOUNDATION_EXTERN void zix_invalidateViewRouteAOPSubscribers(void);
+/// Outdate cached routers of storyboard scenes. Called when registry invalidates resolved routes.
+FOUNDATION_EXTERN void zix_invalidateStoryboardScenePlans(void);
+/// Remove supported route types and preloaded destinations of router classes in the image. Preloaded destinations are discarded on main thread. Called when routes in the image are unregistered.
+FOUNDATION_EXTERN void zix_evictViewRouterCachesInImage(const void *header);
+
+/// Groups of hooks installed by ZIKViewRouter.
+typedef NS_OPTIONS(NSUInteger, ZIKViewRouterHooks) {
+    /// Appearance and parent hooks of view controller.
+    ZIKViewRouterHooksViewController = 1 << 0,
+    /// Superview and window hooks of UIView/NSView.
+    ZIKViewRouterHooksView = 1 << 1,
+    /// Segue and storyboard hooks.
+    ZIKViewRouterHooksStoryboard = 1 << 2
+};
+
+/// Install hooks not installed yet. It's thread safe.
+FOUNDATION_EXTERN void zix_installViewRouterHooks(ZIKViewRouterHooks hooks);
+/// Hooks already installed.
+FOUNDATION_EXTERN ZIKViewRouterHooks zix_installedViewRouterHooks(void);
+
 NS_ASSUME_NONNULL_END
@@ -14,6 +14,7 @@
 #import "ZIKViewRouteRegistry.h"
 #import "ZIKRouterInternal.h"
 #import "ZIKRouteRegistryInternal.h"
+#import "ZIKRouteEdgeList.h"
 #import "ZIKRouterRuntime.h"
 #import <objc/runtime.h>
 #import "ZIKClassCapabilities.h"
@@ -26,6 +27,8 @@
 #import "ZIKBlockViewRouter.h"
 #import "ZIKViewRoutePrivate.h"
 #import "ZIKViewRouterType.h"
+#import "ZIKViewRouterPrivate.h"
+#import "ZIKRouterLog.h"
 
 static CFMutableDictionaryRef _destinationProtocolToRouterMap;
 static CFMutableDictionaryRef _moduleConfigProtocolToRouterMap;
@@ -33,7 +36,13 @@ static CFMutableDictionaryRef _destinationToRoutersMap;
 static CFMutableDictionaryRef _destinationToDefaultRouterMap;
 static CFMutableDictionaryRef _destinationToExclusiveRouterMap;
 static CFMutableDictionaryRef _identifierToRouterMap;
+static CFMutableDictionaryRef _routeToRouterTypeMap;
+static CFMutableArrayRef      _allRoutes;
+static CFMutableSetRef        _allRoutesSet;
 static CFMutableDictionaryRef _adapterToAdapteeMap;
+static CFMutableDictionaryRef _destinationToResolvedRouteMap;
+static CFMutableDictionaryRef _destinationAdapterToRouteMap;
+static CFMutableDictionaryRef _moduleAdapterToRouteMap;
 static CFMutableDictionaryRef _destinationProtocolToDestinationMap;
 static CFMutableDictionaryRef _moduleConfigProtocolToDestinationMap;
 static CFMutableSetRef        _runtimeFactoryDestinationClasses;
@@ -44,9 +53,20 @@ static CFMutableDictionaryRef _destinationToDefaultFactoryMap;
 static CFMutableDictionaryRef _moduleConfigProtocolToFactoryMap;
 static CFMutableDictionaryRef _identifierToConfigFactoryMap;
 static CFMutableDictionaryRef _destinationToDefaultConfigFactoryMap;
+static void *_snapshot;
+static CFMutableDictionaryRef _destinationToEasyRouteMap;
+static CFMutableDictionaryRef _destinationProtocolToEasyRouteMap;
+static CFMutableDictionaryRef _moduleConfigProtocolToEasyRouteMap;
+static CFMutableDictionaryRef _identifierToEasyRouteMap;
+/// Capacity of hooked view controller and segue classes. When it's full, classes are hooked for every instance as before.
+static const size_t kHookedClassSetCapacity = 2048;
+/// View controller classes with hooked -prepareForSegue:sender:.
+static ZIKClassSet *_hookedViewControllerClasses;
+/// Segue classes with hooked -perform.
+static ZIKClassSet *_hookedSegueClasses;
 #if ZIKROUTER_CHECK
-static CFMutableDictionaryRef _check_routerToDestinationsMap;
-static CFMutableDictionaryRef _check_routerToDestinationProtocolsMap;
+static ZIKRouteEdgeList *_check_routerToDestinationEdges;
+static ZIKRouteEdgeList *_check_routerToDestinationProtocolEdges;
 static NSMutableArray<Class> *_routableDestinations;
 static NSMutableArray<Class> *_routerClasses;
 #endif
@@ -62,7 +82,13 @@ static NSMutableArray<Class> *_routerClasses;
     _destinationToDefaultRouterMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
     _destinationToExclusiveRouterMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
     _identifierToRouterMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+    _routeToRouterTypeMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    _allRoutes = CFArrayCreateMutable(kCFAllocatorDefault, 0, NULL);
+    _allRoutesSet = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
     _adapterToAdapteeMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+    _destinationToResolvedRouteMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    _destinationAdapterToRouteMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    _moduleAdapterToRouteMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
     _identifierToDestinationMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
     _destinationProtocolToFactoryMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
     _identifierToFactoryMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
@@ -70,9 +96,13 @@ static NSMutableArray<Class> *_routerClasses;
     _moduleConfigProtocolToFactoryMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
     _identifierToConfigFactoryMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
     _destinationToDefaultConfigFactoryMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+    _destinationToEasyRouteMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    _destinationProtocolToEasyRouteMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    _moduleConfigProtocolToEasyRouteMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    _identifierToEasyRouteMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, &kCFTypeDictionaryValueCallBacks);
 #if ZIKROUTER_CHECK
-    _check_routerToDestinationsMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
-    _check_routerToDestinationProtocolsMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    _check_routerToDestinationEdges = zix_createRouteEdgeList();
+    _check_routerToDestinationProtocolEdges = zix_createRouteEdgeList();
 #endif
     zix_replaceMethodWithMethod([XXViewController class], @selector(initWithCoder:), self, @selector(ZIKViewRouteRegistry_hook_initWithCoder:));
     zix_replaceMethodWithMethod([XXStoryboardSegue class], @selector(initWithIdentifier:source:destination:), self, @selector(ZIKViewRouteRegistry_hook_initWithIdentifier:source:destination:));
@@ -101,13 +131,21 @@ static NSMutableArray<Class> *_routerClasses;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
         ZIKViewRouterClass = [ZIKViewRouter class];
+        __atomic_store_n(&_hookedViewControllerClasses, zix_createClassSet(kHookedClassSetCapacity), __ATOMIC_RELEASE);
     });
+    ZIKClassSet *hookedClasses = _hookedViewControllerClasses;
+    // Replacing method flushes method caches, only hook once for each class
+    if (zix_classSetContainsClass(hookedClasses, aClass)) {
+        return;
+    }
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wundeclared-selector"
     //hook all XXViewController's -prepareForSegue:sender:
     zix_replaceMethodWithMethod(aClass, @selector(prepareForSegue:sender:),
                                 ZIKViewRouterClass, @selector(ZIKViewRouter_hook_prepareForSegue:sender:));
 #pragma clang diagnostic pop
+    // Add after hooking, so other threads never skip a class that is not hooked yet. Hooking twice is harmless.
+    zix_classSetAddClass(hookedClasses, aClass);
 }
 
 + (void)hookPerformForStoryboardSegueClass:(Class)aClass {
@@ -118,13 +156,19 @@ static NSMutableArray<Class> *_routerClasses;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
         ZIKViewRouterClass = [ZIKViewRouter class];
+        __atomic_store_n(&_hookedSegueClasses, zix_createClassSet(kHookedClassSetCapacity), __ATOMIC_RELEASE);
     });
+    ZIKClassSet *hookedClasses = _hookedSegueClasses;
+    if (zix_classSetContainsClass(hookedClasses, aClass)) {
+        return;
+    }
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wundeclared-selector"
     //hook all XXStoryboardSegue's -perform
     zix_replaceMethodWithMethod(aClass, @selector(perform),
                                 ZIKViewRouterClass, @selector(ZIKViewRouter_hook_seguePerform));
 #pragma clang diagnostic pop
+    zix_classSetAddClass(hookedClasses, aClass);
 }
 
 + (ZIKRoute *)easyRouteForDestinationClass:(Class)destinationClass factory:(id(^)(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router))factory {
@@ -160,6 +204,74 @@ static NSMutableArray<Class> *_routerClasses;
     return [ZIKViewRouterType class];
 }
 
++ (ZIKRouterCounter)lookupCounter {
+    return ZIKRouterCounterViewLookup;
+}
+
++ (ZIKRouterCounter)lookupMissCounter {
+    return ZIKRouterCounterViewLookupMiss;
+}
+
++ (void)evictCachesInImage:(const void *)header {
+    ZIKClassSet *hookedViewControllerClasses = __atomic_load_n(&_hookedViewControllerClasses, __ATOMIC_ACQUIRE);
+    if (hookedViewControllerClasses) {
+        zix_classSetRemoveClassesInImage(hookedViewControllerClasses, header);
+    }
+    ZIKClassSet *hookedSegueClasses = __atomic_load_n(&_hookedSegueClasses, __ATOMIC_ACQUIRE);
+    if (hookedSegueClasses) {
+        zix_classSetRemoveClassesInImage(hookedSegueClasses, header);
+    }
+    zix_evictViewRouterCachesInImage(header);
+}
+
++ (void)invalidateResolvedRoutes {
+    [super invalidateResolvedRoutes];
+    zix_invalidateViewRouteAOPSubscribers();
+    zix_invalidateStoryboardScenePlans();
+#if ZIKROUTER_SELECTIVE_HOOKS
+    // Destinations registered after finishing may need more hooks
+    if (self.registrationFinished) {
+        [self _installHooksForRegisteredDestinations];
+    }
+#endif
+}
+
+#if ZIKROUTER_SELECTIVE_HOOKS
+static void _addHooksForDestinationClass(const void *value, void *context) {
+    Class destinationClass = (__bridge Class)value;
+    ZIKViewRouterHooks *hooks = context;
+    if (destinationClass == [XXView class] || zix_classIsSubclassOfClass(destinationClass, [XXView class])) {
+        *hooks |= ZIKViewRouterHooksView;
+    } else {
+        *hooks |= ZIKViewRouterHooksViewController;
+    }
+}
+
+static void _addHooksForDestinationKey(const void *key, const void *value, void *context) {
+    _addHooksForDestinationClass(key, context);
+}
+
+/// Install hooks needed by registered destinations. Hooks of UIView/NSView are only installed when there is any UIView/NSView destination.
++ (void)_installHooksForRegisteredDestinations {
+    ZIKViewRouterHooks allHooks = ZIKViewRouterHooksViewController | ZIKViewRouterHooksView;
+    if ((zix_installedViewRouterHooks() & allHooks) == allHooks) {
+        return;
+    }
+    ZIKViewRouterHooks hooks = 0;
+    if ([self hasLazyRegistrations]) {
+        // Lazy routers are registered when their destinations are found in hooks
+        hooks = allHooks;
+    } else {
+        CFDictionaryApplyFunction(_destinationToRoutersMap, _addHooksForDestinationKey, &hooks);
+        CFDictionaryApplyFunction(_destinationToEasyRouteMap, _addHooksForDestinationKey, &hooks);
+        CFSetApplyFunction(_runtimeFactoryDestinationClasses, _addHooksForDestinationClass, &hooks);
+    }
+    if (hooks != 0) {
+        zix_installViewRouterHooks(hooks);
+    }
+}
+#endif
+
 + (nullable id)routeKeyForRouter:(ZIKRouter *)router {
     if ([router isKindOfClass:[ZIKViewRouter class]] == NO) {
         return nil;
@@ -197,9 +309,27 @@ static NSMutableArray<Class> *_routerClasses;
 + (CFMutableDictionaryRef)identifierToRouterMap {
     return _identifierToRouterMap;
 }
++ (CFMutableDictionaryRef)routeToRouterTypeMap {
+    return _routeToRouterTypeMap;
+}
++ (CFMutableArrayRef)allRoutes {
+    return _allRoutes;
+}
++ (CFMutableSetRef)allRoutesSet {
+    return _allRoutesSet;
+}
 + (CFMutableDictionaryRef)adapterToAdapteeMap {
     return _adapterToAdapteeMap;
 }
++ (CFMutableDictionaryRef)destinationToResolvedRouteMap {
+    return _destinationToResolvedRouteMap;
+}
++ (CFMutableDictionaryRef)destinationAdapterToRouteMap {
+    return _destinationAdapterToRouteMap;
+}
++ (CFMutableDictionaryRef)moduleAdapterToRouteMap {
+    return _moduleAdapterToRouteMap;
+}
 + (CFMutableDictionaryRef)identifierToDestinationMap {
     return _identifierToDestinationMap;
 }
@@ -221,19 +351,45 @@ static NSMutableArray<Class> *_routerClasses;
 + (CFMutableDictionaryRef)destinationToDefaultConfigFactoryMap {
     return _destinationToDefaultConfigFactoryMap;
 }
-+ (CFMutableDictionaryRef)_check_routerToDestinationsMap {
-#if ZIKROUTER_CHECK
-    return _check_routerToDestinationsMap;
-#else
-    return NULL;
-#endif
++ (CFMutableDictionaryRef)destinationToEasyRouteMap {
+    return _destinationToEasyRouteMap;
+}
++ (CFMutableDictionaryRef)destinationProtocolToEasyRouteMap {
+    return _destinationProtocolToEasyRouteMap;
+}
++ (CFMutableDictionaryRef)moduleConfigProtocolToEasyRouteMap {
+    return _moduleConfigProtocolToEasyRouteMap;
+}
++ (CFMutableDictionaryRef)identifierToEasyRouteMap {
+    return _identifierToEasyRouteMap;
+}
++ (void **)snapshotStorage {
+    return &_snapshot;
+}
+
++ (void)compactContainers {
+    CFTypeRef *containers[] = {
+        (CFTypeRef *)&_destinationProtocolToRouterMap, (CFTypeRef *)&_moduleConfigProtocolToRouterMap, (CFTypeRef *)&_destinationToRoutersMap, (CFTypeRef *)&_destinationToDefaultRouterMap, (CFTypeRef *)&_destinationToExclusiveRouterMap, (CFTypeRef *)&_identifierToRouterMap, (CFTypeRef *)&_routeToRouterTypeMap, (CFTypeRef *)&_allRoutes, (CFTypeRef *)&_allRoutesSet,
+        (CFTypeRef *)&_destinationProtocolToDestinationMap, (CFTypeRef *)&_moduleConfigProtocolToDestinationMap, (CFTypeRef *)&_identifierToDestinationMap, (CFTypeRef *)&_runtimeFactoryDestinationClasses,
+        (CFTypeRef *)&_destinationProtocolToFactoryMap, (CFTypeRef *)&_identifierToFactoryMap, (CFTypeRef *)&_destinationToDefaultFactoryMap, (CFTypeRef *)&_moduleConfigProtocolToFactoryMap, (CFTypeRef *)&_identifierToConfigFactoryMap, (CFTypeRef *)&_destinationToDefaultConfigFactoryMap,
+        (CFTypeRef *)&_destinationToEasyRouteMap, (CFTypeRef *)&_destinationProtocolToEasyRouteMap, (CFTypeRef *)&_moduleConfigProtocolToEasyRouteMap, (CFTypeRef *)&_identifierToEasyRouteMap, (CFTypeRef *)&_adapterToAdapteeMap
+    };
+    // Resolved route maps are caches filled after registration is finished, they are not compacted
+    for (size_t i = 0; i < sizeof(containers) / sizeof(containers[0]); i++) {
+        zix_compactRegistryContainer(containers[i]);
+    }
 }
-+ (CFMutableDictionaryRef)_check_routerToDestinationProtocolsMap {
 #if ZIKROUTER_CHECK
-    return _check_routerToDestinationProtocolsMap;
-#else
-    return NULL;
++ (ZIKRouteEdgeList *)_check_routerToDestinationEdges {
+    return _check_routerToDestinationEdges;
+}
++ (ZIKRouteEdgeList *)_check_routerToDestinationProtocolEdges {
+    return _check_routerToDestinationProtocolEdges;
+}
 #endif
+
++ (Class)routerBaseClass {
+    return [ZIKViewRouter class];
 }
 
 + (void)handleEnumerateRouterClass:(Class)class {
@@ -243,11 +399,17 @@ static NSMutableArray<Class> *_routerClasses;
         ZIKViewRouterClass = [ZIKViewRouter class];
     });
     if (zix_classIsSubclassOfClass(class, ZIKViewRouterClass)) {
-        [class registerRoutableDestination];
+        [self registerRouterClass:class];
     }
 }
 
 + (void)didFinishRegistration {
+#if ZIKROUTER_SELECTIVE_HOOKS
+    [self _installHooksForRegisteredDestinations];
+#endif
+}
+
++ (void)validateRegistration {
 #if ZIKROUTER_CHECK
     [self _searchAllRoutersAndDestinations];
     [self _checkAllRouters];
@@ -272,22 +434,21 @@ static NSMutableArray<Class> *_routerClasses;
 }
 
 + (BOOL)isDestinationClassRoutable:(Class)aClass {
-    Class XXResponderClass = [XXResponder class];
-    while (aClass && aClass != XXResponderClass) {
-        if (class_conformsToProtocol(aClass, @protocol(ZIKRoutableView))) {
-            return YES;
-        }
-        aClass = class_getSuperclass(aClass);
-    }
-    return NO;
+    return zix_classConformsToProtocol(aClass, @protocol(ZIKRoutableView));
+}
+
++ (nullable Class)routableRootClassOfDestinationClass:(Class)aClass {
+    return zix_rootClassConformingToProtocol(aClass, @protocol(ZIKRoutableView));
 }
 
 + (BOOL)isDestinationClass:(Class)destinationClass registeredWithRouter:(Class)routerClass {
     NSParameterAssert([routerClass isSubclassOfClass:[ZIKViewRouter class]]);
     CFDictionaryRef destinationToExclusiveRouterMap = ZIKViewRouteRegistry.destinationToExclusiveRouterMap;
     CFDictionaryRef destinationToRoutersMap = ZIKViewRouteRegistry.destinationToRoutersMap;
-    Class XXResponderClass = [XXResponder class];
-    while (destinationClass && destinationClass != XXResponderClass) {
+    // Classes above the routable root class can't be registered
+    Class rootClass = [self routableRootClassOfDestinationClass:destinationClass];
+    while (destinationClass && rootClass) {
+        [self registerLazyRoutersForDestinationClass:destinationClass];
         Class exclusiveRouter = (Class)CFDictionaryGetValue(destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass));
         if (exclusiveRouter == routerClass) {
             return YES;
@@ -299,38 +460,28 @@ static NSMutableArray<Class> *_routerClasses;
                 return YES;
             }
         }
+        if (destinationClass == rootClass) {
+            break;
+        }
         destinationClass = class_getSuperclass(destinationClass);
     }
     return NO;
 }
 
 + (void)enumerateAllViewRouters:(void(NS_NOESCAPE ^)(Class _Nullable routerClass, ZIKViewRoute * _Nullable route))handler {
-    static NSSet *cachedAllRouters;
-    NSSet *routers;
-    if ([self registrationFinished] && cachedAllRouters && cachedAllRouters.count > 0) {
-        routers = cachedAllRouters;
-    } else {
-        NSMutableSet *allRouters = [NSMutableSet set];
-        NSDictionary *destinationToRoutersMap = (__bridge NSDictionary *)self.destinationToRoutersMap;
-        [destinationToRoutersMap enumerateKeysAndObjectsUsingBlock:^(Class _Nonnull destinationClass, NSSet * _Nonnull routers, BOOL * _Nonnull stop) {
-            [allRouters unionSet:routers];
-        }];
-        NSDictionary *destinationToExclusiveRouterMap = (__bridge NSDictionary *)self.destinationToExclusiveRouterMap;
-        [destinationToExclusiveRouterMap enumerateKeysAndObjectsUsingBlock:^(Class _Nonnull destinationClass, id  _Nonnull router, BOOL * _Nonnull stop) {
-            [allRouters addObject:router];
-        }];
-        cachedAllRouters = allRouters;
-        routers = allRouters;
+    [self registerLazyRouters];
+    if (handler == nil) {
+        return;
     }
-    
-    if (handler) {
-        [routers enumerateObjectsUsingBlock:^(id  _Nonnull route, BOOL * _Nonnull stop) {
-            if ([route class] == route) {
-                handler(route, nil);
-            } else {
-                handler(nil, route);
-            }
-        }];
+    // Routes registered in handler are also enumerated
+    CFArrayRef allRoutes = self.allRoutes;
+    for (CFIndex i = 0; i < CFArrayGetCount(allRoutes); i++) {
+        id route = (__bridge id)CFArrayGetValueAtIndex(allRoutes, i);
+        if ([route class] == route) {
+            handler(route, nil);
+        } else {
+            handler(nil, route);
+        }
     }
 }
 
@@ -363,40 +514,49 @@ static NSMutableArray<Class> *_routerClasses;
                   [class isAdapter])) {
                 [errorDescription appendFormat:@"\n\n❌Router(%@) must override -destinationWithConfiguration: to return destination.", class];
             }
-            CFMutableSetRef views = (CFMutableSetRef)CFDictionaryGetValue(self._check_routerToDestinationsMap, (__bridge const void *)(class));
-            NSSet *viewSet = (__bridge NSSet *)(views);
-            if (!(viewSet.count > 0 || [class isAbstractRouter] || [class isAdapter])) {
+            if (!(zix_routeEdgeListContainsRoute(self._check_routerToDestinationEdges, (__bridge const void *)(class)) || [class isAbstractRouter] || [class isAdapter])) {
                 [errorDescription appendFormat:@"\n\n❌Router class(%@) is not resgistered with any view class. Use +[%@ registerView:] to register view in Router(%@)'s +registerRoutableDestination.", class, class, class];
             }
             [_routerClasses addObject:class];
         }
     });
     if (errorDescription.length > 0) {
-        NSLog(@"\n❌Found router implementation errors:%@", errorDescription);
+        ZIX_LOG(Registry, Error, @"❌Found router implementation errors:%@", errorDescription);
         NSAssert(NO, errorDescription);
     }
 }
 
 + (void)_checkAllRoutableDestinations {
-    NSMutableString *errorDescription = [NSMutableString string];
-    for (Class destinationClass in _routableDestinations) {
+    NSArray<Class> *routableDestinations = [_routableDestinations copy];
+    NSString *errorDescription = [self validateConcurrentlyWithCount:routableDestinations.count handler:^NSString * _Nullable(NSUInteger index) {
+        Class destinationClass = routableDestinations[index];
         if (!(CFDictionaryGetValue(self.destinationToDefaultRouterMap, (__bridge const void *)(destinationClass)) != NULL ||
               CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass)) != NULL ||
               [self easyRouteForDestinationClass:destinationClass])) {
-            [errorDescription appendFormat:@"\n\n❌Routable view(%@) is not registered with any view router.", destinationClass];
+            return [NSString stringWithFormat:@"\n\n❌Routable view(%@) is not registered with any view router.", destinationClass];
         }
-    }
+        return nil;
+    }];
     if (errorDescription.length > 0) {
-        NSLog(@"\n❌Found router implementation errors:%@", errorDescription);
+        ZIX_LOG(Registry, Error, @"❌Found router implementation errors:%@", errorDescription);
         NSAssert(NO, errorDescription);
     }
 }
 
 + (void)_checkAllRouters {
-    for (Class class in _routerClasses) {
-        [class _didFinishRegistration];
+    if (ZIKRouteRegistry.validatesInBackground) {
+        NSArray<Class> *routerClasses = _routerClasses;
+        dispatch_apply(routerClasses.count, zix_globalQueueWithQOS(QOS_CLASS_UTILITY), ^(size_t idx) {
+            [routerClasses[idx] _didFinishRegistration];
+        });
+    } else {
+        for (Class class in _routerClasses) {
+            [class _didFinishRegistration];
+        }
     }
-    NSMutableString *errorDescription = [NSMutableString string];
+    // Collect ZIKViewRoutes first, then check them concurrently
+    NSMutableArray<Class> *destinationClasses = [NSMutableArray array];
+    NSMutableArray<ZIKViewRoute *> *routes = [NSMutableArray array];
     NSDictionary<Class, NSSet *> *destinationToRoutersMap = (__bridge NSDictionary *)self.destinationToRoutersMap;
     [destinationToRoutersMap enumerateKeysAndObjectsUsingBlock:^(Class  _Nonnull key, NSSet * _Nonnull obj, BOOL * _Nonnull stop) {
         [obj enumerateObjectsUsingBlock:^(id  _Nonnull obj, BOOL * _Nonnull stop) {
@@ -404,40 +564,47 @@ static NSMutableArray<Class> *_routerClasses;
                 return;
             }
             NSAssert([obj isKindOfClass:[ZIKViewRoute class]], @"The object is either a ZIKViewRouter class or a ZIKViewRoute");
-            ZIKViewRoute *route = obj;
-            if (zix_classIsSubclassOfClass(key, [XXView class])) {
-                if (!([route supportRouteType:ZIKViewRouteTypeAddAsSubview] || [route supportRouteType:ZIKViewRouteTypeCustom])) {
-                    [errorDescription appendFormat:@"\n\n❌If the destination is UIView/NSView type, the router (%@) must set supportedRouteTypes and support ZIKViewRouteTypeAddAsSubview or ZIKViewRouteTypeCustom.", route];
-                }
+            [destinationClasses addObject:key];
+            [routes addObject:obj];
+        }];
+    }];
+    NSString *errorDescription = [self validateConcurrentlyWithCount:routes.count handler:^NSString * _Nullable(NSUInteger index) {
+        Class destinationClass = destinationClasses[index];
+        ZIKViewRoute *route = routes[index];
+        NSMutableString *error = [NSMutableString string];
+        if (zix_classIsSubclassOfClass(destinationClass, [XXView class])) {
+            if (!([route supportRouteType:ZIKViewRouteTypeAddAsSubview] || [route supportRouteType:ZIKViewRouteTypeCustom])) {
+                [error appendFormat:@"\n\n❌If the destination is UIView/NSView type, the router (%@) must set supportedRouteTypes and support ZIKViewRouteTypeAddAsSubview or ZIKViewRouteTypeCustom.", route];
             }
-            if ([route supportRouteType:ZIKViewRouteTypeCustom]) {
-                if (route.canPerformCustomRouteBlock == nil) {
-                    [errorDescription appendFormat:@"\n\n❌The route (%@) supports ZIKViewRouteTypeCustom, but missing  -canPerformCustomRoute.", route];
-                }
-                if (route.performCustomRouteBlock == nil) {
-                    [errorDescription appendFormat:@"\n\n❌The route (%@) supports ZIKViewRouteTypeCustom, but missing  -performCustomRoute.", route];
-                }
+        }
+        if ([route supportRouteType:ZIKViewRouteTypeCustom]) {
+            if (route.canPerformCustomRouteBlock == nil) {
+                [error appendFormat:@"\n\n❌The route (%@) supports ZIKViewRouteTypeCustom, but missing  -canPerformCustomRoute.", route];
             }
-        }];
+            if (route.performCustomRouteBlock == nil) {
+                [error appendFormat:@"\n\n❌The route (%@) supports ZIKViewRouteTypeCustom, but missing  -performCustomRoute.", route];
+            }
+        }
+        return error;
     }];
     if (errorDescription.length > 0) {
-        NSLog(@"\n❌Found router implementation errors:%@", errorDescription);
+        ZIX_LOG(Registry, Error, @"❌Found router implementation errors:%@", errorDescription);
         NSAssert(NO, errorDescription);
     }
 }
 
 + (void)_checkAllRoutableProtocols {
-    NSMutableString *errorDescription = [NSMutableString string];
+    NSMutableArray<Protocol *> *protocols = [NSMutableArray array];
     zix_enumerateProtocolList(^(Protocol *protocol) {
         if (protocol) {
-            NSString *error = [self _checkProtocol:protocol];
-            if (error) {
-                [errorDescription appendString:error];
-            }
+            [protocols addObject:protocol];
         }
     });
+    NSString *errorDescription = [self validateConcurrentlyWithCount:protocols.count handler:^NSString * _Nullable(NSUInteger index) {
+        return [self _checkProtocol:protocols[index]];
+    }];
     if (errorDescription.length > 0) {
-        NSLog(@"\n❌Found router implementation errors:%@", errorDescription);
+        ZIX_LOG(Registry, Error, @"❌Found router implementation errors:%@", errorDescription);
         NSAssert(NO, errorDescription);
     }
 }
@@ -453,8 +620,10 @@ static NSMutableArray<Class> *_routerClasses;
         if (router == nil) {
             router = routerType.route;
         }
-        CFSetRef viewsRef = CFDictionaryGetValue(self._check_routerToDestinationsMap, (__bridge const void *)(router));
-        NSSet *views = (__bridge NSSet *)(viewsRef);
+        NSMutableArray<Class> *views = [NSMutableArray array];
+        zix_routeEdgeListEnumerateTargets(self._check_routerToDestinationEdges, (__bridge const void *)(router), ^(const void * _Nonnull target, BOOL * _Nonnull stop) {
+            [views addObject:(__bridge Class)target];
+        });
         if (!(views.count > 0 ||
               CFDictionaryGetValue(self.destinationProtocolToDestinationMap, (__bridge const void *)(protocol)) ||
               CFDictionaryGetValue(self.destinationProtocolToFactoryMap, (__bridge const void *)(protocol)))) {
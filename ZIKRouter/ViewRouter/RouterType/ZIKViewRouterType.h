@@ -49,6 +49,21 @@ NS_ASSUME_NONNULL_BEGIN
 /// If this destination doesn't need any variable to initialize, just pass source and perform route.
 - (nullable ZIKViewRouter<Destination, RouteConfig> *)performPath:(ZIKViewRoutePath *)path;
 
+/// Build a configuration template once for performing the same route many times. See +[ZIKViewRouter configurationTemplate:]. Return nil for routes registered with ZIKViewRoute.
+- (nullable ZIKViewRouteConfigurationTemplate<RouteConfig> *)configurationTemplate:(void(NS_NOESCAPE ^)(RouteConfig config))configBuilder;
+
+/// Perform route with a configuration template. See +[ZIKViewRouter performPath:template:configuring:].
+- (nullable ZIKViewRouter<Destination, RouteConfig> *)performPath:(ZIKViewRoutePath *)path
+                                                         template:(ZIKViewRouteConfigurationTemplate<RouteConfig> *)configTemplate
+                                                      configuring:(void(NS_NOESCAPE ^ _Nullable)(RouteConfig config))configBuilder;
+
+/// Display destination in a reusable view and keep the router for next reuse of the view. See +[ZIKViewRouter bindToReusableView:configuring:]. Routes registered with ZIKViewRoute are performed each time without reusing.
+#if ZIK_HAS_UIKIT
+- (nullable ZIKViewRouter<Destination, RouteConfig> *)bindToReusableView:(UIView *)reusableView configuring:(void(NS_NOESCAPE ^)(RouteConfig config))configBuilder;
+#else
+- (nullable ZIKViewRouter<Destination, RouteConfig> *)bindToReusableView:(NSView *)reusableView configuring:(void(NS_NOESCAPE ^)(RouteConfig config))configBuilder;
+#endif
+
 /// If this destination doesn't need any variable to initialize, just pass source and perform route. The successHandler and errorHandler are for current performing.
 - (nullable ZIKViewRouter<Destination, RouteConfig> *)performPath:(ZIKViewRoutePath *)path
                                                    successHandler:(void(^ _Nullable)(Destination destination))performerSuccessHandler
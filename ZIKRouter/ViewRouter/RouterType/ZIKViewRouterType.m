@@ -10,7 +10,9 @@
 //
 
 #import "ZIKViewRouterType.h"
+#import "ZIKViewRouterTypePrivate.h"
 #import "ZIKViewRoute.h"
+#import <objc/runtime.h>
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wincomplete-implementation"
@@ -41,6 +43,73 @@
     return self;
 }
 
+#pragma mark Trampolines
+
+- (BOOL)supportRouteType:(ZIKViewRouteType)type {
+    return [self.routeObject supportRouteType:type];
+}
+
+- (id)performPath:(ZIKViewRoutePath *)path {
+    return [self.routeObject performPath:path];
+}
+
+- (id)performPath:(ZIKViewRoutePath *)path configuring:(void(NS_NOESCAPE ^)(ZIKViewRouteConfiguration *config))configBuilder {
+    return [self.routeObject performPath:path configuring:configBuilder];
+}
+
+- (id)performPath:(ZIKViewRoutePath *)path
+      configuring:(void(NS_NOESCAPE ^)(ZIKViewRouteConfiguration *config))configBuilder
+         removing:(void(NS_NOESCAPE ^ _Nullable)(ZIKViewRemoveConfiguration *config))removeConfigBuilder {
+    return [self.routeObject performPath:path configuring:configBuilder removing:removeConfigBuilder];
+}
+
+- (nullable ZIKViewRouteConfigurationTemplate *)configurationTemplate:(void(NS_NOESCAPE ^)(ZIKViewRouteConfiguration *config))configBuilder {
+    id routeObject = self.routeObject;
+    if (!object_isClass(routeObject)) {
+        NSAssert(NO, @"Configuration template is not supported for ZIKViewRoute (%@).", routeObject);
+        return nil;
+    }
+    return [routeObject configurationTemplate:configBuilder];
+}
+
+- (id)performPath:(ZIKViewRoutePath *)path template:(ZIKViewRouteConfigurationTemplate *)configTemplate configuring:(void(NS_NOESCAPE ^ _Nullable)(ZIKViewRouteConfiguration *config))configBuilder {
+    return [self.routeObject performPath:path template:configTemplate configuring:configBuilder];
+}
+
+- (id)bindToReusableView:(XXView *)reusableView configuring:(void(NS_NOESCAPE ^)(ZIKViewRouteConfiguration *config))configBuilder {
+    id routeObject = self.routeObject;
+    if (object_isClass(routeObject)) {
+        return [routeObject bindToReusableView:reusableView configuring:configBuilder];
+    }
+    return [routeObject performPath:ZIKViewRoutePath.addAsSubviewFrom(reusableView) configuring:configBuilder];
+}
+
+- (id)performOnDestination:(id)destination path:(ZIKViewRoutePath *)path {
+    return [self.routeObject performOnDestination:destination path:path];
+}
+
+- (BOOL)shouldAutoCreateForDestination:(id)destination fromSource:(nullable id)source {
+    return [self.routeObject shouldAutoCreateForDestination:destination fromSource:source];
+}
+
+// AOP methods are called for every router registered with the destination class in each transition
+
+- (void)router:(nullable ZIKViewRouter *)router willPerformRouteOnDestination:(id)destination fromSource:(nullable id)source {
+    [self.routeObject router:router willPerformRouteOnDestination:destination fromSource:source];
+}
+
+- (void)router:(nullable ZIKViewRouter *)router didPerformRouteOnDestination:(id)destination fromSource:(nullable id)source {
+    [self.routeObject router:router didPerformRouteOnDestination:destination fromSource:source];
+}
+
+- (void)router:(nullable ZIKViewRouter *)router willRemoveRouteOnDestination:(id)destination fromSource:(nullable id)source {
+    [self.routeObject router:router willRemoveRouteOnDestination:destination fromSource:source];
+}
+
+- (void)router:(nullable ZIKViewRouter *)router didRemoveRouteOnDestination:(id)destination fromSource:(nullable id)source {
+    [self.routeObject router:router didRemoveRouteOnDestination:destination fromSource:source];
+}
+
 @end
 
 #pragma clang diagnostic pop
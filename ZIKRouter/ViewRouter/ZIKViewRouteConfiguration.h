@@ -161,6 +161,8 @@ typedef void(^ZIKViewRoutePopoverConfigure)(ZIKViewRoutePopoverConfiguration *po
 typedef void(^ZIKViewRouteSegueConfigure)(ZIKViewRouteSegueConfiguration *segueConfig);
 typedef void(^ZIKViewRoutePopoverConfiger)(NS_NOESCAPE ZIKViewRoutePopoverConfigure);
 typedef void(^ZIKViewRouteSegueConfiger)(NS_NOESCAPE ZIKViewRouteSegueConfigure);
+/// Deliver the result of asynchronous preparation with a block updating destination. It can be called from any thread, `update` is called on main thread, and not called if destination is already dealloced.
+typedef void(^ZIKViewRoutePreparationDelivery)(void(^update)(id destination));
 
 /// Configuration for view module. You can use a subclass or use category to add complex dependencies for destination module.
 @interface ZIKViewRouteConfiguration : ZIKPerformRouteConfiguration <NSCopying>
@@ -180,7 +182,7 @@ typedef void(^ZIKViewRouteSegueConfiger)(NS_NOESCAPE ZIKViewRouteSegueConfigure)
 @property (nonatomic, weak, nullable) id<ZIKViewRouteSource> source;
 /// The style of route, default is ZIKViewRouteTypePresentModally. Subclass router may return other default value.
 @property (nonatomic, assign) ZIKViewRouteType routeType;
-/// For push/present, default is YES
+/// For push/present, default is YES. Non-animated push completes inline, successHandler is called before perform returns.
 @property (nonatomic, assign) BOOL animated;
 
 /**
@@ -201,6 +203,15 @@ typedef void(^ZIKViewRouteSegueConfiger)(NS_NOESCAPE ZIKViewRouteSegueConfigure)
  Use weakSelf in containerWrapper to avoid retain cycle.
  */
 @property (nonatomic, copy, nullable) ZIKViewRouteContainerWrapper containerWrapper;
+#if ZIK_HAS_UIKIT
+/**
+ Identifier of the pool reusing containers made by containerWrapper. Default is nil, and containerWrapper makes a new container for each performing.
+ 
+ @discussion
+ When it's set, an UINavigationController made by containerWrapper is put into the pool after the router removes the route. Later performing with the same identifier takes a container from the pool and sets destination as its only view controller, without calling containerWrapper, so modal flows don't build the same navigation bar and view hierarchy again. Only use it when containerWrapper doesn't configure the container for the specific destination. Other kinds of containers are not reused. Pooled containers are released when receiving memory warning.
+ */
+@property (nonatomic, copy, nullable) NSString *containerReuseIdentifier;
+#endif
 
 /**
  Prepare for performRoute, and config other dependencies for destination here.
@@ -217,6 +228,19 @@ typedef void(^ZIKViewRouteSegueConfiger)(NS_NOESCAPE ZIKViewRouteSegueConfigure)
  */
 @property (nonatomic, copy, nullable) void(^prepareDestination)(id destination);
 
+/**
+ Asynchronous part of preparation, started when the transition begins. Fetching data here runs alongside the transition animation instead of delaying it. Keep the preparation required before presentation in prepareDestination.
+ 
+ @discussion
+ It's called on main thread after prepareDestination and -prepareDestination:configuration:, right before the router shows the destination. When the data is ready, call `delivery` with a block updating destination.
+ 
+ It's not called for ZIKViewRouteTypeMakeDestination and ZIKViewRouteTypePerformSegue, or when destination is displayed from external, because the transition is not started by router.
+ 
+ @note
+ Use weakSelf in prepareDestinationAlongsideTransition to avoid retain cycle.
+ */
+@property (nonatomic, copy, nullable) void(^prepareDestinationAlongsideTransition)(id destination, ZIKViewRoutePreparationDelivery delivery);
+
 /**
  Success handler for performRoute. Each time the router was performed, success handler will be called when the operation succeed.
  
@@ -302,7 +326,7 @@ typedef void(^ZIKViewRouteSegueConfiger)(NS_NOESCAPE ZIKViewRouteSegueConfigure)
 @end
 
 @interface ZIKViewRemoveConfiguration : ZIKRemoveRouteConfiguration <NSCopying>
-/// For pop/dismiss, default is YES
+/// For pop/dismiss, default is YES. Non-animated pop completes inline, successHandler is called before remove returns.
 @property (nonatomic, assign) BOOL animated;
 
 /*
@@ -414,6 +438,21 @@ typedef void(^ZIKViewRouteSegueConfiger)(NS_NOESCAPE ZIKViewRouteSegueConfigure)
  */
 @property (nonatomic, strong, nullable) Destination makedDestination;
 
+/**
+ Make destination with a non-escaping factory and set it as `makedDestination`, then return it. Call it in `makeDestinationWith` to pass parameters to the destination's initializer directly. The factory is not copied to heap, and scalar or struct parameters are captured by value instead of being kept in a `makeDestination` block.
+ 
+ @code
+ config.makeDestinationWith = id^(NSString *account, NSInteger level) {
+     return [weakConfig makeDestinationUsing:^LoginViewController * _Nullable{
+         return [[LoginViewController alloc] initWithAccount:account level:level];
+     }];
+ };
+ @endcode
+ 
+ @note `makeDestination` is not set, so the configuration doesn't make destination again after `makedDestination` is used. Set `makeDestination` when the router may make destination again with this configuration.
+ */
+- (nullable Destination)makeDestinationUsing:(Destination _Nullable(NS_NOESCAPE ^)(void))factory;
+
 /**
  Pass required parameters for initializing destination module, and get destination in `didMakeDestination`.
  
@@ -770,7 +809,7 @@ typedef void(^ZIKViewRouteSegueConfiger)(NS_NOESCAPE ZIKViewRouteSegueConfigure)
 @property (nonatomic, weak, nullable) id<ZIKViewRouteSource> source;
 /// The style of route, default is ZIKViewRouteTypePresentModally. Subclass router may return other default value.
 @property (nonatomic, assign) ZIKViewRouteType routeType;
-/// For push/present, default is YES
+/// For push/present, default is YES. Non-animated push completes inline, successHandler is called before perform returns.
 @property (nonatomic, assign) BOOL animated;
 
 /**
@@ -791,6 +830,15 @@ typedef void(^ZIKViewRouteSegueConfiger)(NS_NOESCAPE ZIKViewRouteSegueConfigure)
  Use weakSelf in containerWrapper to avoid retain cycle.
  */
 @property (nonatomic, copy, nullable) ZIKViewRouteContainerWrapper containerWrapper;
+#if ZIK_HAS_UIKIT
+/**
+ Identifier of the pool reusing containers made by containerWrapper. Default is nil, and containerWrapper makes a new container for each performing.
+ 
+ @discussion
+ When it's set, an UINavigationController made by containerWrapper is put into the pool after the router removes the route. Later performing with the same identifier takes a container from the pool and sets destination as its only view controller, without calling containerWrapper, so modal flows don't build the same navigation bar and view hierarchy again. Only use it when containerWrapper doesn't configure the container for the specific destination. Other kinds of containers are not reused. Pooled containers are released when receiving memory warning.
+ */
+@property (nonatomic, copy, nullable) NSString *containerReuseIdentifier;
+#endif
 
 /**
  Prepare for performRoute, and config other dependencies for destination here.
@@ -807,6 +855,19 @@ typedef void(^ZIKViewRouteSegueConfiger)(NS_NOESCAPE ZIKViewRouteSegueConfigure)
  */
 @property (nonatomic, copy, nullable) void(^prepareDestination)(Destination destination);
 
+/**
+ Asynchronous part of preparation, started when the transition begins. Fetching data here runs alongside the transition animation instead of delaying it. Keep the preparation required before presentation in prepareDestination.
+ 
+ @discussion
+ It's called on main thread after prepareDestination and -prepareDestination:configuration:, right before the router shows the destination. When the data is ready, call `delivery` with a block updating destination.
+ 
+ It's not called for ZIKViewRouteTypeMakeDestination and ZIKViewRouteTypePerformSegue, or when destination is displayed from external, because the transition is not started by router.
+ 
+ @note
+ Use weakSelf in prepareDestinationAlongsideTransition to avoid retain cycle.
+ */
+@property (nonatomic, copy, nullable) void(^prepareDestinationAlongsideTransition)(Destination destination, ZIKViewRoutePreparationDelivery delivery);
+
 /**
  Success handler for performRoute. Each time the router was performed, success handler will be called when the operation succeed.
  
@@ -858,7 +919,7 @@ typedef void(^ZIKViewRouteSegueConfiger)(NS_NOESCAPE ZIKViewRouteSegueConfigure)
 @property (nonatomic, strong, readonly) ZIKViewRemoveConfiguration *configuration;
 - (instancetype)initWithConfiguration:(ZIKViewRemoveConfiguration *)configuration;
 
-/// For pop/dismiss, default is YES
+/// For pop/dismiss, default is YES. Non-animated pop completes inline, successHandler is called before remove returns.
 @property (nonatomic, assign) BOOL animated;
 
 /*
@@ -877,4 +938,12 @@ typedef void(^ZIKViewRouteSegueConfiger)(NS_NOESCAPE ZIKViewRouteSegueConfigure)
 @property (nonatomic, assign) BOOL handleExternalRoute;
 @end
 
+/// Immutable route configuration built once with +[ZIKViewRouter configurationTemplate:], for performing the same route many times with +[ZIKViewRouter performPath:template:configuring:].
+@interface ZIKViewRouteConfigurationTemplate<__covariant RouteConfig: ZIKViewRouteConfiguration *> : NSObject
+/// The router class building the template.
+@property (nonatomic, readonly, unsafe_unretained) Class routerClass;
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+@end
+
 NS_ASSUME_NONNULL_END
@@ -11,10 +11,11 @@
 
 #import "ZIKViewRouteConfiguration.h"
 #import "ZIKViewRouterInternal.h"
-#import "ZIKPresentationState.h"
+#import "ZIKPresentationSnapshot.h"
 #import "ZIKRouterInternal.h"
 #import "ZIKViewRouteError.h"
 #import "ZIKClassCapabilities.h"
+#import "ZIKRouteConfigurationPrivate.h"
 
 ZIKRouteAction const ZIKRouteActionToView = @"ZIKRouteActionToView";
 ZIKRouteAction const ZIKRouteActionToViewModule = @"ZIKRouteActionToViewModule";
@@ -201,7 +202,44 @@ ZIKRouteAction const ZIKRouteActionPerformOnDestination = @"ZIKRouteActionPerfor
 + (NSString *)descriptionOfRouteType:(ZIKViewRouteType)routeType;
 @end
 
-@interface ZIKViewRouteConfiguration ()
+/// Options of ZIKViewRouteConfiguration used by few routes. It's only allocated when any of them is set, so simple routes don't carry and copy them.
+@interface ZIKViewRouteOptionalConfiguration : NSObject <NSCopying> {
+    @public
+    ZIKViewRouteContainerWrapper _containerWrapper;
+#if ZIK_HAS_UIKIT
+    NSString *_containerReuseIdentifier;
+#else
+    id<NSViewControllerPresentationAnimator> _animator;
+#endif
+    void(^_prepareDestinationAlongsideTransition)(id destination, ZIKViewRoutePreparationDelivery delivery);
+    void(^_addingChildViewHandler)(XXViewController *destination, void(^completion)(void));
+    __weak id _sender;
+}
+@end
+
+@implementation ZIKViewRouteOptionalConfiguration
+
+- (id)copyWithZone:(nullable NSZone *)zone {
+    ZIKViewRouteOptionalConfiguration *options = [[ZIKViewRouteOptionalConfiguration allocWithZone:zone] init];
+    options->_containerWrapper = _containerWrapper;
+#if ZIK_HAS_UIKIT
+    options->_containerReuseIdentifier = _containerReuseIdentifier;
+#else
+    options->_animator = _animator;
+#endif
+    options->_prepareDestinationAlongsideTransition = _prepareDestinationAlongsideTransition;
+    options->_addingChildViewHandler = _addingChildViewHandler;
+    options->_sender = _sender;
+    return options;
+}
+
+@end
+
+@interface ZIKViewRouteConfiguration () {
+    ZIKViewRouteOptionalConfiguration *_options;
+    /// Whether `_options` is shared with a copy of the configuration, and must be copied before changing.
+    BOOL _optionsBorrowed;
+}
 @property (nonatomic, assign) BOOL autoCreated;
 @property (nonatomic, strong, nullable) ZIKViewRouteSegueConfiguration *segueConfiguration;
 @property (nonatomic, strong, nullable) ZIKViewRoutePopoverConfiguration *popoverConfiguration;
@@ -216,7 +254,8 @@ ZIKRouteAction const ZIKRouteActionPerformOnDestination = @"ZIKRouteActionPerfor
 @property (nonatomic, weak, nullable) XXViewController *segueSource;
 @property (nonatomic, weak, nullable) XXViewController *segueDestination;
 #if ZIK_HAS_UIKIT
-@property (nonatomic, strong) ZIKPresentationState *destinationStateBeforeRoute;
+@property (nonatomic, assign) ZIKPresentationSnapshot destinationStateBeforeRoute;
+@property (nonatomic, assign) BOOL hasDestinationStateBeforeRoute;
 #endif
 @end
 
@@ -292,6 +331,87 @@ ZIKRouteAction const ZIKRouteActionPerformOnDestination = @"ZIKRouteActionPerfor
     _animated = YES;
 }
 
+#pragma mark Optional Configuration
+
+/// Options to change, allocated when it's nil, and copied when it's borrowed.
+static inline ZIKViewRouteOptionalConfiguration *_writableOptions(ZIKViewRouteConfiguration *configuration) {
+    if (configuration->_options == nil) {
+        configuration->_options = [ZIKViewRouteOptionalConfiguration new];
+    } else if (configuration->_optionsBorrowed) {
+        configuration->_options = [configuration->_options copy];
+    }
+    configuration->_optionsBorrowed = NO;
+    return configuration->_options;
+}
+
+- (nullable ZIKViewRouteContainerWrapper)containerWrapper {
+    return _options ? _options->_containerWrapper : nil;
+}
+
+- (void)setContainerWrapper:(nullable ZIKViewRouteContainerWrapper)containerWrapper {
+    if (containerWrapper == nil && _options == nil) {
+        return;
+    }
+    _writableOptions(self)->_containerWrapper = [containerWrapper copy];
+}
+
+#if ZIK_HAS_UIKIT
+- (nullable NSString *)containerReuseIdentifier {
+    return _options ? _options->_containerReuseIdentifier : nil;
+}
+
+- (void)setContainerReuseIdentifier:(nullable NSString *)containerReuseIdentifier {
+    if (containerReuseIdentifier == nil && _options == nil) {
+        return;
+    }
+    _writableOptions(self)->_containerReuseIdentifier = [containerReuseIdentifier copy];
+}
+#else
+- (nullable id<NSViewControllerPresentationAnimator>)animator {
+    return _options ? _options->_animator : nil;
+}
+
+- (void)setAnimator:(nullable id<NSViewControllerPresentationAnimator>)animator {
+    if (animator == nil && _options == nil) {
+        return;
+    }
+    _writableOptions(self)->_animator = animator;
+}
+#endif
+
+- (nullable void (^)(id _Nonnull, ZIKViewRoutePreparationDelivery _Nonnull))prepareDestinationAlongsideTransition {
+    return _options ? _options->_prepareDestinationAlongsideTransition : nil;
+}
+
+- (void)setPrepareDestinationAlongsideTransition:(nullable void (^)(id _Nonnull, ZIKViewRoutePreparationDelivery _Nonnull))prepareDestinationAlongsideTransition {
+    if (prepareDestinationAlongsideTransition == nil && _options == nil) {
+        return;
+    }
+    _writableOptions(self)->_prepareDestinationAlongsideTransition = [prepareDestinationAlongsideTransition copy];
+}
+
+- (nullable void (^)(XXViewController * _Nonnull, void (^ _Nonnull)(void)))addingChildViewHandler {
+    return _options ? _options->_addingChildViewHandler : nil;
+}
+
+- (void)setAddingChildViewHandler:(nullable void (^)(XXViewController * _Nonnull, void (^ _Nonnull)(void)))addingChildViewHandler {
+    if (addingChildViewHandler == nil && _options == nil) {
+        return;
+    }
+    _writableOptions(self)->_addingChildViewHandler = [addingChildViewHandler copy];
+}
+
+- (nullable id)sender {
+    return _options ? _options->_sender : nil;
+}
+
+- (void)setSender:(nullable id)sender {
+    if (sender == nil && _options == nil) {
+        return;
+    }
+    _writableOptions(self)->_sender = sender;
+}
+
 - (void)configureSegue:(ZIKViewRouteSegueConfigure)configure {
     NSParameterAssert(configure);
     NSAssert(!self.segueConfiguration, @"should only configure once");
@@ -362,12 +482,12 @@ ZIKRouteAction const ZIKRouteActionPerformOnDestination = @"ZIKRouteActionPerfor
     config.routeType = self.routeType;
     config.animated = self.animated;
     config.autoCreated = self.autoCreated;
-    config.containerWrapper = self.containerWrapper;
-    config.sender = self.sender;
-#if !ZIK_HAS_UIKIT
-    config.animator = self.animator;
-#endif
-    config.addingChildViewHandler = self.addingChildViewHandler;
+    if (_options) {
+        // Share options until one of them changes
+        config->_options = _options;
+        config->_optionsBorrowed = YES;
+        _optionsBorrowed = YES;
+    }
     config.popoverConfiguration = self.popoverConfiguration;
     config.segueConfiguration = self.segueConfiguration;
     config.handleExternalRoute = self.handleExternalRoute;
@@ -403,6 +523,13 @@ ZIKRouteAction const ZIKRouteActionPerformOnDestination = @"ZIKRouteActionPerfor
     return _makeDestinationWith;
 }
 
+- (nullable id)makeDestinationUsing:(id _Nullable(NS_NOESCAPE ^)(void))factory {
+    NSParameterAssert(factory);
+    id destination = factory();
+    self.makedDestination = destination;
+    return destination;
+}
+
 - (ZIKConstructBlock)constructDestination {
     if (!_constructDestination) {
         return ^{ NSAssert(NO, @"constructDestination is not set"); };
@@ -619,6 +746,20 @@ ZIKRouteAction const ZIKRouteActionPerformOnDestination = @"ZIKRouteActionPerfor
 - (void)setContainerWrapper:(ZIKViewRouteContainerWrapper)containerWrapper {
     self.configuration.containerWrapper = containerWrapper;
 }
+#if ZIK_HAS_UIKIT
+- (NSString *)containerReuseIdentifier {
+    return self.configuration.containerReuseIdentifier;
+}
+- (void)setContainerReuseIdentifier:(NSString *)containerReuseIdentifier {
+    self.configuration.containerReuseIdentifier = containerReuseIdentifier;
+}
+#endif
+- (void(^)(id, ZIKViewRoutePreparationDelivery))prepareDestinationAlongsideTransition {
+    return self.configuration.prepareDestinationAlongsideTransition;
+}
+- (void)setPrepareDestinationAlongsideTransition:(void (^)(id _Nonnull, ZIKViewRoutePreparationDelivery _Nonnull))prepareDestinationAlongsideTransition {
+    self.configuration.prepareDestinationAlongsideTransition = prepareDestinationAlongsideTransition;
+}
 - (id)sender {
     return self.configuration.sender;
 }
@@ -678,3 +819,32 @@ ZIKRouteAction const ZIKRouteActionPerformOnDestination = @"ZIKRouteActionPerfor
     self.configuration.handleExternalRoute = handleExternalRoute;
 }
 @end
+
+@interface ZIKViewRouteConfigurationTemplate ()
+- (instancetype)initWithConfiguration:(ZIKViewRouteConfiguration *)configuration routerClass:(Class)routerClass;
+- (ZIKViewRouteConfiguration *)makeConfiguration;
+@end
+
+@implementation ZIKViewRouteConfigurationTemplate {
+    ZIKViewRouteConfiguration *_configuration;
+}
+
+- (instancetype)initWithConfiguration:(ZIKViewRouteConfiguration *)configuration routerClass:(Class)routerClass {
+    NSParameterAssert(configuration);
+    NSParameterAssert(routerClass);
+    if (self = [super init]) {
+        _configuration = configuration;
+        _routerClass = routerClass;
+    }
+    return self;
+}
+
+- (ZIKViewRouteConfiguration *)makeConfiguration {
+    return [_configuration templateCopy];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%@, routerClass:%@, configuration:%@",super.description,_routerClass,_configuration];
+}
+
+@end
@@ -11,6 +11,7 @@
 
 #import "ZIKViewRouter.h"
 #import "ZIKViewRouterType.h"
+#import "ZIKRouteHandle.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -18,6 +19,12 @@ NS_ASSUME_NONNULL_BEGIN
 #define ZIKRouterToView(ViewProtocol) [ZIKViewRouter<id<ViewProtocol>,ZIKViewRouteConfiguration *> toView](ZIKRoutable(ViewProtocol))
 
 #define ZIKRouterToViewModule(ModuleProtocol) [ZIKViewRouter<id,ZIKViewRouteConfiguration<ModuleProtocol> *> toModule](ZIKRoutable(ModuleProtocol))
+
+/// Get a handle caching the view router in a type safe way. Keep the handle and read its `routerType`, it looks up again only when routes are changed.
+#define ZIKRouteHandleToView(ViewProtocol) [ZIKRouteHandle<ZIKViewRouterType<id<ViewProtocol>,ZIKViewRouteConfiguration *> *> handleWithLookup:^ZIKViewRouterType<id<ViewProtocol>,ZIKViewRouteConfiguration *> *_Nullable{ return ZIKRouterToView(ViewProtocol); }]
+
+/// Get a handle caching the view module router in a type safe way.
+#define ZIKRouteHandleToViewModule(ModuleProtocol) [ZIKRouteHandle<ZIKViewRouterType<id,ZIKViewRouteConfiguration<ModuleProtocol> *> *> handleWithLookup:^ZIKViewRouterType<id,ZIKViewRouteConfiguration<ModuleProtocol> *> *_Nullable{ return ZIKRouterToViewModule(ModuleProtocol); }]
 /// Get view router in a type safe way. There will be compile error if the module protocol is not ZIKViewModuleRoutable.
 
 @interface ZIKViewRouter<__covariant Destination: id, __covariant RouteConfig: ZIKViewRouteConfiguration *> (Discover)
@@ -135,6 +142,9 @@ NS_ASSUME_NONNULL_BEGIN
 /// Find view router registered with the unique identifier.
 @property (nonatomic, class, readonly) ZIKAnyViewRouterType * _Nullable (^toIdentifier)(NSString *identifier);
 
+/// Find view router registered with the identifier of the handle from `+[ZIKRouter handleForIdentifier:]`. It doesn't hash the identifier string.
+@property (nonatomic, class, readonly) ZIKAnyViewRouterType * _Nullable (^toIdentifierHandle)(ZIKRouteIdentifierHandle handle);
+
 @end
 
 NS_ASSUME_NONNULL_END
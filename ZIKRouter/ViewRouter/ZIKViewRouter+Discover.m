@@ -70,6 +70,14 @@ ZIKAnyViewRouterType *_Nullable _ZIKViewRouterToIdentifier(NSString *identifier)
     return nil;
 }
 
+ZIKAnyViewRouterType *_Nullable _ZIKViewRouterToIdentifierHandle(ZIKRouteIdentifierHandle handle) {
+    ZIKRouterType *route = [ZIKViewRouteRegistry routerToIdentifierHandle:handle];
+    if ([route isKindOfClass:[ZIKViewRouterType class]]) {
+        return (ZIKViewRouterType *)route;
+    }
+    return nil;
+}
+
 @implementation ZIKViewRouter (Discover)
 
 + (ZIKViewRouterType<id, ZIKViewRouteConfiguration *> *(^)(Protocol<ZIKViewRoutable> *))toView {
@@ -115,4 +123,22 @@ ZIKAnyViewRouterType *_Nullable _ZIKViewRouterToIdentifier(NSString *identifier)
     };
 }
 
++ (ZIKAnyViewRouterType *(^)(ZIKRouteIdentifierHandle))toIdentifierHandle {
+    return ^(ZIKRouteIdentifierHandle handle) {
+        ZIKAnyViewRouterType *routerType = _ZIKViewRouterToIdentifierHandle(handle);
+        if (routerType) {
+            return routerType;
+        }
+        NSString *identifier = zix_routeIdentifierOfHandle(handle);
+        [ZIKViewRouter notifyError_invalidProtocolWithAction:ZIKRouteActionToView
+                                            errorDescription:@"Didn't find view router for identifier: %@ of handle: %u, this identifier was not registered.",identifier,handle];
+        if (ZIKRouteRegistry.registrationFinished) {
+            NSCAssert2(NO, @"Didn't find view router for identifier: %@ of handle: %u, this identifier was not registered.",identifier,handle);
+        } else {
+            NSCAssert2(NO, @"❌❌❌❌warning: failed to get router for view identifier (%@) of handle (%u), because manually registration is not finished yet! If there're modules running before registration is finished, and modules require some routers before you register them, then you should register those required routers earlier.",identifier,handle);
+        }
+        return routerType;
+    };
+}
+
 @end
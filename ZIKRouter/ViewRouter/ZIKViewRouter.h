@@ -100,6 +100,22 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (BOOL)canPerform;
 
+/**
+ Check `canPerform` of many routers at once, such as when enabling items of a menu or toolbar. Navigation stack and presentation state of each source are checked only once, and shared by all routers with the same source. Main thread only.
+
+ @param routers Routers to check, at most 64 routers.
+ @return Bit mask of performable routers. Bit `i` is set when `routers[i]` can perform route now.
+ */
++ (uint64_t)performableMaskOfRouters:(NSArray<ZIKViewRouter *> *)routers;
+
+/**
+ Route types in `+supportedRouteTypes` that the source can perform now, checking the source in the same way as `canPerform`. Custom route type is not included, it's checked by each router in `-canPerformCustomRoute`. Main thread only.
+
+ @param source The source view controller or view. When it's nil, only ZIKViewRouteTypeMaskMakeDestination is returned.
+ @return Mask of performable route types.
+ */
++ (ZIKViewRouteTypeMask)performableRouteTypesFromSource:(nullable id)source;
+
 /// Check whether the router supports a route type.
 + (BOOL)supportRouteType:(ZIKViewRouteType)type;
 
@@ -629,13 +645,178 @@ typedef void(^ZIKViewRouteGlobalErrorHandler)(__kindof ZIKViewRouter * _Nullable
 + (void)enumerateAllViewRouters:(void(NS_NOESCAPE ^)(Class routerClass))handler;
 @end
 
+#if ZIK_HAS_UIKIT
+@interface ZIKViewRouter (BatchPush)
+
+/**
+ Push all destinations of push routes performed in `routes` with one `-setViewControllers:animated:` transition for each navigation controller. It's for restoring a deep navigation stack without animating each push.
+ @code
+ [ZIKViewRouter performBatchPushAnimated:YES routes:^{
+    id<ListViewInput> list = [ZIKRouterToView(ListViewInput) performPath:ZIKViewRoutePath.pushFrom(self)].destination;
+    id<DetailViewInput> detail = [ZIKRouterToView(DetailViewInput) performPath:ZIKViewRoutePath.pushFrom(list)].destination;
+    [ZIKRouterToView(CommentViewInput) performPath:ZIKViewRoutePath.pushFrom(detail)];
+ }];
+ @endcode
+ @discussion
+ Destinations are prepared and AOP callbacks are called when each route is performed, and each router's success handlers and completion are called after the single transition finishes. A source can be a destination pushed earlier in the same batch. `animated` in route configurations is ignored. Other route types and routes making destination asynchronously are performed as usual. Calling it inside `routes` just joins the outer batch. Must be called on main thread.
+ 
+ @param animated Whether to animate the transition.
+ @param routes Block performing push routes.
+ */
++ (void)performBatchPushAnimated:(BOOL)animated routes:(void(NS_NOESCAPE ^)(void))routes;
+@end
+
+/// Routable view controllers in a navigation stack and their restoration states, archived with NSKeyedArchiver for restoring the stack on next launch. Created by +[ZIKViewRouter snapshotOfNavigationController:].
+@interface ZIKViewRouteStackSnapshot : NSObject <NSSecureCoding>
+/// Class names of view controllers above the root view controller, from bottom to top.
+@property (nonatomic, copy, readonly) NSArray<NSString *> *destinationClassNames;
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+@end
+
+@interface ZIKViewRouter (StackRestoration)
+
+/**
+ Record view controllers above the root view controller of the navigation controller, and their restoration states from +restorationStateOfDestination: of their routers.
+ @code
+ // Save
+ ZIKViewRouteStackSnapshot *snapshot = [ZIKViewRouter snapshotOfNavigationController:self.navigationController];
+ NSData *data = [NSKeyedArchiver archivedDataWithRootObject:snapshot requiringSecureCoding:YES error:nil];
+ 
+ // Restore on next launch
+ ZIKViewRouteStackSnapshot *snapshot = [NSKeyedUnarchiver unarchivedObjectOfClass:[ZIKViewRouteStackSnapshot class] fromData:data error:nil];
+ [ZIKViewRouter restoreNavigationController:navigationController fromSnapshot:snapshot configuring:nil];
+ @endcode
+ @discussion
+ Recording stops at the first view controller whose class is not registered with any view router, because the stack can't be restored above it. Must be called on main thread.
+ 
+ @param navigationController The navigation controller to record.
+ @return The snapshot.
+ */
++ (ZIKViewRouteStackSnapshot *)snapshotOfNavigationController:(UINavigationController *)navigationController;
+
+/**
+ Push view controllers recorded in the snapshot onto the navigation controller with one non-animated transition, with +performBatchPushAnimated:routes:. All destinations are prepared before the transition, and each router's success handlers are called once after it.
+ 
+ @discussion
+ Each route is performed by the router registered with the recorded class, and its restoration state is added to user info of the configuration, so the router can read it in -prepareDestination:configuration:. Restoring stops at the first class that doesn't exist or isn't registered, and at the first route that fails or makes destination asynchronously. Must be called on main thread.
+ 
+ @param navigationController The navigation controller to push into. It should have a root view controller.
+ @param snapshot The snapshot from +snapshotOfNavigationController:.
+ @param configBuilder Configure each route with the restoration state, such as setting prepareDestination.
+ @return Routers of restored destinations, from bottom to top.
+ */
++ (NSArray<ZIKViewRouter *> *)restoreNavigationController:(UINavigationController *)navigationController
+                                             fromSnapshot:(ZIKViewRouteStackSnapshot *)snapshot
+                                              configuring:(void(NS_NOESCAPE ^ _Nullable)(ZIKViewRouteConfiguration *config, NSDictionary<NSString *, id> *state))configBuilder;
+
+/**
+ Override to record the destination's state for restoring the navigation stack. The state is added to user info of the configuration when restoring. Values must be property list objects. Default is nil.
+ 
+ @param destination The view controller in the navigation stack.
+ @return The restoration state.
+ */
++ (nullable NSDictionary<NSString *, id> *)restorationStateOfDestination:(id)destination;
+@end
+#endif
+
+@interface ZIKViewRouter (Preload)
+
+/**
+ Create a destination and load its view when main run loop is idle, then keep it in the pool of this router class. Next performing of this router class takes the preloaded destination instead of calling -destinationWithConfiguration:, so -loadView and -viewDidLoad don't run after user's action.
+ 
+ @discussion
+ Destination is created with the default route configuration, and it's still prepared and AOP callbacks are still called when performing. The pool is only used when performing configuration has the same class as the default configuration and the same values of properties declared by its module config subclasses, otherwise a new destination is made. Performing with `prewarmKey` or with a configuration conforming to ZIKConfigurationMakeable doesn't use the pool. The pool keeps at most `+maxPreloadedDestinationCount` destinations, call this again after performing to fill it. Pools of all routers are discarded when receiving memory warning. Must be called on main thread.
+ */
++ (void)preloadDestination;
+
+/// Max count of preloaded destinations kept for this router class. Default is 1.
++ (NSUInteger)maxPreloadedDestinationCount;
+
+/// Discard preloaded destinations of this router class.
++ (void)discardPreloadedDestinations;
+
+@end
+
+@interface ZIKViewRouter<__covariant Destination: id, __covariant RouteConfig: ZIKViewRouteConfiguration *> (Template)
+
+/**
+ Build a configuration template once, for performing the same route many times.
+ @code
+ // Build once
+ self.detailTemplate = [ZIKRouterToView(DetailViewInput) configurationTemplate:^(ZIKViewRouteConfiguration *config) {
+    config.successHandler = ^(id<DetailViewInput> destination) {
+        ...
+    };
+ }];
+ 
+ // Perform many times
+ [ZIKRouterToView(DetailViewInput) performPath:ZIKViewRoutePath.pushFrom(self) template:self.detailTemplate configuring:^(ZIKViewRouteConfiguration *config) {
+    config.prepareDestination = ^(id<DetailViewInput> destination) {
+        destination.item = item;
+    };
+ }];
+ @endcode
+ @discussion
+ The template can't be changed after it's built. Performing with it doesn't call +defaultRouteConfiguration and the template builder again, it copies fields of the template into a new configuration, and user info of the template is only copied when it's changed for that performing.
+ 
+ @param configBuilder Build the template configuration in the block.
+ @return The immutable template.
+ */
++ (ZIKViewRouteConfigurationTemplate<RouteConfig> *)configurationTemplate:(void(NS_NOESCAPE ^)(RouteConfig config))configBuilder;
+
+/**
+ Perform route with a configuration template.
+ 
+ @param path The route path with source and route type.
+ @param configTemplate The template from +configurationTemplate: of this router class.
+ @param configBuilder Set fields for current performing, such as prepareDestination. Changes don't affect the template.
+ @return The view router for this route.
+ */
++ (nullable instancetype)performPath:(ZIKViewRoutePath *)path
+                            template:(ZIKViewRouteConfigurationTemplate<RouteConfig> *)configTemplate
+                         configuring:(void(NS_NOESCAPE ^ _Nullable)(RouteConfig config))configBuilder;
+
+@end
+
+@interface ZIKViewRouter<__covariant Destination: id, __covariant RouteConfig: ZIKViewRouteConfiguration *> (ReusableView)
+
+/**
+ Display destination in a reusable view, such as contentView of UITableViewCell or UICollectionViewCell, and keep the router and destination for next reuse of the view.
+ @code
+ - (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath {
+    UITableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:@"cell" forIndexPath:indexPath];
+    User *user = self.users[indexPath.row];
+    [ZIKRouterToView(AvatarViewInput) bindToReusableView:cell.contentView configuring:^(ZIKViewRouteConfiguration *config) {
+        config.prepareDestination = ^(id<AvatarViewInput> destination) {
+            destination.user = user;
+        };
+    }];
+    return cell;
+ }
+ @endcode
+ @discussion
+ The first binding of a reusable view performs ZIKViewRouteTypeAddAsSubview from it, and the reusable view keeps the router. Later bindings with the same router class rebind the destination: configuration is rebuilt with `configBuilder`, then destination is prepared with it and success handlers are called, without adding subview, AOP callbacks and waiting for the destination to appear. If the destination was removed from the reusable view, it performs again. Must be called on main thread.
+ 
+ @param reusableView The reusable view as source of ZIKViewRouteTypeAddAsSubview.
+ @param configBuilder Build the configuration in the block. Source and route type are already set.
+ @return The bound router, or nil when performing failed.
+ */
+#if ZIK_HAS_UIKIT
++ (nullable instancetype)bindToReusableView:(UIView *)reusableView configuring:(void(NS_NOESCAPE ^)(RouteConfig config))configBuilder;
+#else
++ (nullable instancetype)bindToReusableView:(NSView *)reusableView configuring:(void(NS_NOESCAPE ^)(RouteConfig config))configBuilder;
+#endif
+
+@end
+
 @interface ZIKViewRouter (Debug)
 
 /// Default is YES. You can override this to disable memory leak detecting for current router.
 + (BOOL)shouldDetectMemoryLeak;
 
 /**
- Check whether the destination is dealloced after delay second when it's removed. Only works in DEBUG mode. Default is 2 second. You can set a negative number to disable it. Memory leak information will be print to console. It will also check whether leaked objects are reclaimed.
+ Check whether the destination is dealloced after delay second when it's removed. Default is 2 second in DEBUG mode, and 0 in release mode. You can set a negative number to disable it, or set a positive number in release mode to check beta builds. Set it before any destination is removed, because routers cache whether to check. Memory leak information will be print to console. It will also check whether leaked objects are reclaimed.
  @note
  Destination may not be dealloced for these situations:
  
@@ -651,6 +832,9 @@ typedef void(^ZIKViewRouteGlobalErrorHandler)(__kindof ZIKViewRouter * _Nullable
  */
 @property (nonatomic, class) NSTimeInterval detectMemoryLeakDelay;
 
+/// Fraction of removed destinations to check, from 0 to 1. Default is 1. Use a small rate to check release builds with little cost.
+@property (nonatomic, class) double memoryLeakSampleRate;
+
 /// Handler when destination still exists after removed and delay second. You can use other tools like FBRetainCycleDetector to check whether there is a real leaking.
 @property (nonatomic, class, copy) void(^didDetectLeakingHandler)(id leakedDestination);
 
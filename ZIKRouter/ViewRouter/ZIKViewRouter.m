@@ -19,40 +19,589 @@
 #import "ZIKViewRouteRegistryPrivate.h"
 #import "ZIKViewRoute.h"
 #import "ZIKViewRouteError.h"
+#import "ZIKRouteCacheTrimmer.h"
 #import <objc/runtime.h>
 #import "ZIKRouterRuntime.h"
 #import "ZIKRouterRuntimeDebug.h"
 #import "UIViewController+ZIKViewRouter.h"
 #import "UIView+ZIKViewRouter.h"
 #import "ZIKPresentationState.h"
+#import "ZIKPresentationSnapshot.h"
 #import "UIView+ZIKViewRouterPrivate.h"
 #import "UIViewController+ZIKViewRouterPrivate.h"
 #import "UIStoryboardSegue+ZIKViewRouterPrivate.h"
 #import "ZIKRouteConfigurationPrivate.h"
 #import "ZIKViewRouteConfigurationPrivate.h"
 #import "ZIKViewRouterTypePrivate.h"
+#import "ZIKViewRoutePrivate.h"
+#import "ZIKRouteSignpost.h"
+#import "ZIKViewRouteObjectState.h"
+#import "ZIKRouterLog.h"
+
+/// Events to notify routers that state of their destination is changed
+typedef NS_ENUM(NSInteger, ZIKViewRouteEvent) {
+    ZIKViewRouteEventWillPerformRoute,
+    ZIKViewRouteEventDidPerformRoute,
+    ZIKViewRouteEventWillRemoveRoute,
+    ZIKViewRouteEventDidRemoveRoute,
+    ZIKViewRouteEventRemoveRouteCancelled
+};
+
+/// Guards hash tables of destinations. Routers may attach destination on any thread.
+static dispatch_semaphore_t g_destinationRoutersSema;
+
+static id _Nullable _takePreloadedDestination(Class routerClass, ZIKPerformRouteConfiguration *configuration);
+static void _discardPreloadedDestinationsInImage(const void *header);
+static BOOL _shouldSampleMemoryLeak(void);
+
+@interface ZIKViewRouter (DestinationEvents)
+- (void)_handleWillPerformRouteOnDestination:(id)destination;
+- (void)_handleDidPerformRouteOnDestination:(id)destination;
+- (void)_handleWillRemoveRouteOnDestination:(id)destination;
+- (void)_handleDidRemoveRouteOnDestination:(id)destination;
+- (void)_handleRemoveRouteCancelledOnDestination:(id)destination;
+@end
+
+/// Routers observe their destination in its route state instead of notification center, so hooks reach them with one associated object lookup. Routers are not removed when they change destination, handlers check destination again.
+static void _addRouterToDestination(ZIKViewRouter *router, id destination) {
+    dispatch_semaphore_wait(g_destinationRoutersSema, DISPATCH_TIME_FOREVER);
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(destination, YES);
+    if (state->_attachedRouters == nil) {
+        state->_attachedRouters = [NSHashTable weakObjectsHashTable];
+    }
+    [state->_attachedRouters addObject:router];
+    dispatch_semaphore_signal(g_destinationRoutersSema);
+}
+
+static void _notifyRoutersOfDestination(id destination, ZIKViewRouteEvent event) {
+    ZIKViewRouteObjectState *state = zix_viewRouteObjectState(destination, NO);
+    if (state == nil || state->_attachedRouters == nil) {
+        return;
+    }
+    dispatch_semaphore_wait(g_destinationRoutersSema, DISPATCH_TIME_FOREVER);
+    NSArray<ZIKViewRouter *> *observers = state->_attachedRouters.allObjects;
+    dispatch_semaphore_signal(g_destinationRoutersSema);
+    for (ZIKViewRouter *router in observers) {
+        switch (event) {
+            case ZIKViewRouteEventWillPerformRoute:
+                [router _handleWillPerformRouteOnDestination:destination];
+                break;
+            case ZIKViewRouteEventDidPerformRoute:
+                [router _handleDidPerformRouteOnDestination:destination];
+                break;
+            case ZIKViewRouteEventWillRemoveRoute:
+                [router _handleWillRemoveRouteOnDestination:destination];
+                break;
+            case ZIKViewRouteEventDidRemoveRoute:
+                [router _handleDidRemoveRouteOnDestination:destination];
+                break;
+            case ZIKViewRouteEventRemoveRouteCancelled:
+                [router _handleRemoveRouteCancelledOnDestination:destination];
+                break;
+        }
+    }
+}
+
+/// Published with zix_publishGlobalErrorHandler, so reporting errors doesn't take lock.
+static const void *g_globalErrorHandler;
+/// Hooks of UIKit and AppKit, installed in +load, or only when they're needed if ZIKROUTER_SELECTIVE_HOOKS is enabled.
+static ZIKViewRouterHooks g_installedHooks;
+static dispatch_semaphore_t g_installedHooksSema;
+
+/// Routable view controllers found in a storyboard's initial scene and their router types, so scenes instantiated repeatedly skip resolving routers, and skip searching child view controllers when there is no routable child. Only used on main thread.
+@interface ZIKStoryboardScenePlan : NSObject {
+    @package
+    NSUInteger _generation;
+    /// Class of the initial view controller.
+    Class _initialClass;
+    BOOL _hasRoutableChildren;
+    /// Classes of routable view controllers in searching order.
+    NSArray<Class> *_destinationClasses;
+    /// Router type of each class, or NSNull when there is no router.
+    NSArray *_routerTypes;
+}
+@end
+@implementation ZIKStoryboardScenePlan
+@end
+
+static char kStoryboardKey;
+/// key: bundle path and name of storyboard, value: ZIKStoryboardScenePlan of initial scene. Only used on main thread.
+static NSMutableDictionary<NSString *, ZIKStoryboardScenePlan *> *g_storyboardScenePlans;
+/// Increased when routes change, plans made before are outdated.
+static NSUInteger g_storyboardScenePlansGeneration;
+
+void zix_invalidateStoryboardScenePlans(void) {
+    __atomic_add_fetch(&g_storyboardScenePlansGeneration, 1, __ATOMIC_RELAXED);
+}
+
+/// Count invocation of the hooked method, and trace it until the method returns.
+#define ZIX_RECORD_HOOK(hook) \
+    zix_incrementRouterCounter(ZIKRouterCounterHook##hook); \
+    ZIX_TRACE_SCOPE("hook" #hook, "hook", object_getClassName(self))
+
+/// Record the hook and profile it with ZIX_HOOK_PROFILE_SCOPE. Call the original implementation with ZIX_HOOK_CALL_ORIGINAL.
+#define ZIX_RECORD_PROFILED_HOOK(hook) \
+    ZIX_RECORD_HOOK(hook); \
+    ZIX_HOOK_PROFILE_SCOPE(ZIKRouterCounterHook##hook)
+
+/// Auto created UIView routers waiting to find performer and prepare. key: destination, value: router. Only used on main thread.
+static CFMutableDictionaryRef g_preparingXXViewRouters;
+/// Auto created UIView routers waiting to finish. key: destination, value: router. Only used on main thread.
+static CFMutableDictionaryRef g_finishingXXViewRouters;
+/// Groups of g_finishingXXViewRouters by root view of destination's hierarchy. key: root view, value: ZIKWaitingViewRouterGroup. Only used on main thread.
+static CFMutableDictionaryRef g_waitingViewRouterGroups;
+/// Group of each destination in g_finishingXXViewRouters. key: destination, value: unretained ZIKWaitingViewRouterGroup. Only used on main thread.
+static CFMutableDictionaryRef g_waitingViewRouterGroupOfDestination;
+/// Routers in g_finishingXXViewRouters whose root view was dealloced. Routers with living destination are moved to the group of destination's current root when they are checked, the others are checked for any view. key: destination, value: router. Only used on main thread.
+static CFMutableDictionaryRef g_orphanedWaitingViewRouters;
+#if !ZIK_HAS_UIKIT
+/// Windows with content view controller, set after view controller hooks are installed or indexed when installing, weakly held. Other windows are ignored when closing. Only used on main thread.
+static NSHashTable<NSWindow *> *g_routedWindows;
+#else
+/// Idle navigation controllers made by containerWrapper. key: containerReuseIdentifier, value: containers. Only used on main thread.
+static NSMutableDictionary<NSString *, NSMutableArray<UINavigationController *> *> *g_reusableContainers;
+/// Containers kept for each reuse identifier.
+static const NSUInteger kMaxReusableContainerCount = 2;
+
+static UINavigationController *_Nullable _dequeueReusableContainer(NSString *identifier) {
+    NSMutableArray<UINavigationController *> *containers = g_reusableContainers[identifier];
+    UINavigationController *container = containers.lastObject;
+    if (container) {
+        [containers removeLastObject];
+    }
+    return container;
+}
+
+static void _enqueueReusableContainer(UINavigationController *container, NSString *identifier) {
+    if (g_reusableContainers == nil) {
+        g_reusableContainers = [NSMutableDictionary dictionary];
+        zix_registerCacheTrimmer(ZIKRouteCachePriorityDefault, ^{
+            [g_reusableContainers removeAllObjects];
+        });
+    }
+    NSMutableArray<UINavigationController *> *containers = g_reusableContainers[identifier];
+    if (containers == nil) {
+        containers = [NSMutableArray array];
+        g_reusableContainers[identifier] = containers;
+    }
+    if (containers.count >= kMaxReusableContainerCount || [containers indexOfObjectIdenticalTo:container] != NSNotFound) {
+        return;
+    }
+    // Release destination, the container keeps its navigation bar and view
+    [container setViewControllers:@[] animated:NO];
+    [containers addObject:container];
+}
+#endif
+
+/// Error for destination appearing again after it's removed. Hooks of -viewDidDisappear: call it, so call stack is symbolicated only when the error is read.
+static NSError *_reappearedDestinationError(id destination) {
+    NSArray<NSNumber *> *callStack = [NSThread callStackReturnAddresses];
+    __weak id weakDestination = destination;
+    return [ZIKViewRouter errorWithCode:ZIKViewRouteErrorUnbalancedTransition localizedDescriptionProvider:^NSString *{
+        return [NSString stringWithFormat:@"Unbalanced calls to begin/end appearance transitions for %@. This error occurs when you try and display a view controller before the current view controller is finished displaying. This may cause the UIViewController skips or messes up the order calling -viewWillAppear:, -viewDidAppear:, -viewWillDisAppear: and -viewDidDisappear:, and messes up the route state. Current error reason is already removed destination but destination appears again before -viewDidDisappear:, callStack:%@",weakDestination,zix_symbolicateCallStack(callStack)];
+    }];
+}
+
+/// Routes of a destination class overriding AOP callbacks. Most routers use the empty default callbacks, so notifying only calls these routes.
+@interface ZIKViewRouteAOPSubscribers : NSObject
+@property (nonatomic, copy) NSArray *willPerformSubscribers;
+@property (nonatomic, copy) NSArray *didPerformSubscribers;
+@property (nonatomic, copy) NSArray *willRemoveSubscribers;
+@property (nonatomic, copy) NSArray *didRemoveSubscribers;
+@property (nonatomic, assign) BOOL detectsMemoryLeak;
+@end
+@implementation ZIKViewRouteAOPSubscribers
+@end
+
+/// key: destination class, value: ZIKViewRouteAOPSubscribers. Guarded by g_AOPSubscribersSema, cleared when registry invalidates resolved routes.
+static CFMutableDictionaryRef g_AOPSubscribers;
+static dispatch_semaphore_t g_AOPSubscribersSema;
+/// Increased in each invalidation, so subscribers computed before invalidation are not cached.
+static NSUInteger g_AOPSubscribersGeneration;
+
+void zix_invalidateViewRouteAOPSubscribers(void) {
+    if (g_AOPSubscribersSema == nil) {
+        return;
+    }
+    dispatch_semaphore_wait(g_AOPSubscribersSema, DISPATCH_TIME_FOREVER);
+    CFDictionaryRemoveAllValues(g_AOPSubscribers);
+    g_AOPSubscribersGeneration++;
+    dispatch_semaphore_signal(g_AOPSubscribersSema);
+}
+
+#if ZIK_HAS_UIKIT
+/// Pushes collected in +performBatchPushAnimated:routes:.
+@interface ZIKViewRoutePushBatch : NSObject
+@property (nonatomic, assign) BOOL animated;
+/// Navigation controllers in order of their first push.
+@property (nonatomic, strong) NSMutableArray<UINavigationController *> *navigationControllers;
+/// key: navigation controller, value: routers pushing into it.
+@property (nonatomic, strong) NSMapTable<UINavigationController *, NSMutableArray<ZIKViewRouter *> *> *routers;
+/// key: navigation controller, value: destinations or their containers pushing into it, in the same order of routers.
+@property (nonatomic, strong) NSMapTable<UINavigationController *, NSMutableArray<UIViewController *> *> *viewControllers;
+/// key: destination or its container, value: navigation controller it's pushing into.
+@property (nonatomic, strong) NSMapTable<UIViewController *, UINavigationController *> *pushingViewControllers;
+@end
+@implementation ZIKViewRoutePushBatch
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _navigationControllers = [NSMutableArray array];
+        _routers = [NSMapTable strongToStrongObjectsMapTable];
+        _viewControllers = [NSMapTable strongToStrongObjectsMapTable];
+        _pushingViewControllers = [NSMapTable strongToStrongObjectsMapTable];
+    }
+    return self;
+}
+
+- (void)addRouter:(ZIKViewRouter *)router viewController:(UIViewController *)viewController navigationController:(UINavigationController *)navigationController {
+    NSMutableArray<ZIKViewRouter *> *routers = [_routers objectForKey:navigationController];
+    NSMutableArray<UIViewController *> *viewControllers = [_viewControllers objectForKey:navigationController];
+    if (routers == nil) {
+        routers = [NSMutableArray array];
+        viewControllers = [NSMutableArray array];
+        [_routers setObject:routers forKey:navigationController];
+        [_viewControllers setObject:viewControllers forKey:navigationController];
+        [_navigationControllers addObject:navigationController];
+    }
+    [routers addObject:router];
+    [viewControllers addObject:viewController];
+    [_pushingViewControllers setObject:navigationController forKey:viewController];
+}
+
+@end
 
-/// Notifications to notify all routers that state of its destination is changed
-NSNotificationName kZIKViewRouteWillPerformRouteNotification = @"kZIKViewRouteWillPerformRouteNotification";
-NSNotificationName kZIKViewRouteDidPerformRouteNotification = @"kZIKViewRouteDidPerformRouteNotification";
-NSNotificationName kZIKViewRouteWillRemoveRouteNotification = @"kZIKViewRouteWillRemoveRouteNotification";
-NSNotificationName kZIKViewRouteDidRemoveRouteNotification = @"kZIKViewRouteDidRemoveRouteNotification";
-NSNotificationName kZIKViewRouteRemoveRouteCancelledNotification = @"kZIKViewRouteRemoveRouteCancelledNotification";
+/// Current batch of +performBatchPushAnimated:routes:. Only used on main thread.
+static ZIKViewRoutePushBatch *g_pushBatch;
 
-static ZIKViewRouteGlobalErrorHandler g_globalErrorHandler;
-static dispatch_semaphore_t g_globalErrorSema;
-/// Auto created UIView routers waiting to find performer and prepare
-static NSMutableSet *g_preparingXXViewRouters;
-/// Auto created UIView routers waiting to finish
-static NSMutableSet *g_finishingXXViewRouters;
+/// Navigation controller that source pushes into. Destinations in current batch are not in navigation stack yet, so their navigation controllers are from the batch.
+static UINavigationController *_navigationControllerForPushFromSource(UIViewController *source) {
+    if (g_pushBatch) {
+        UIViewController *node = source;
+        while (node) {
+            UINavigationController *navigationController = [g_pushBatch.pushingViewControllers objectForKey:node];
+            if (navigationController) {
+                return navigationController;
+            }
+            node = node.parentViewController;
+        }
+    }
+    return source.navigationController;
+}
+
+/// Whether destination is neither in the navigation stack nor pushing into a navigation controller in current batch.
+static BOOL _destinationNotInNavigationStack(UIViewController *destination, UINavigationController *_Nullable navigationController) {
+    if ([navigationController.viewControllers containsObject:destination]) {
+        return NO;
+    }
+    if (g_pushBatch && [g_pushBatch.pushingViewControllers objectForKey:destination]) {
+        return NO;
+    }
+    return YES;
+}
+#endif
+
+/// Presentation state of a source, resolved at the first use and shared by routers checked in one batch with +performableMaskOfRouters:. Only used on main thread.
+@interface ZIKViewRouteSourceState : NSObject {
+    @package
+    __weak id _source;
+#if ZIK_HAS_UIKIT
+    BOOL _navigationControllerResolved;
+    BOOL _presentedViewResolved;
+    BOOL _presentedAnyView;
+    UINavigationController *_navigationController;
+#endif
+}
+@end
+@implementation ZIKViewRouteSourceState
+#if ZIK_HAS_UIKIT
+- (nullable UINavigationController *)navigationController {
+    if (!_navigationControllerResolved) {
+        _navigationControllerResolved = YES;
+        id source = _source;
+        if ([source respondsToSelector:@selector(navigationController)]) {
+            _navigationController = _navigationControllerForPushFromSource(source);
+        }
+    }
+    return _navigationController;
+}
+- (BOOL)presentedAnyView {
+    if (!_presentedViewResolved) {
+        _presentedViewResolved = YES;
+        id source = _source;
+        _presentedAnyView = [source isKindOfClass:[UIViewController class]] && [(UIViewController *)source presentedViewController] != nil;
+    }
+    return _presentedAnyView;
+}
+#endif
+@end
+
+@interface ZIKViewRouter (WaitingRouters)
++ (void)tryToPrepareWaitingViewRoutersInView:(XXView *)view;
++ (void)tryToFinishWaitingViewRoutersInView:(XXView *)view finishWhenHasWindow:(BOOL)finishWhenHasWindow;
+@end
+
+/// Waiting routers with destinations in the same view hierarchy. Root view is the window when hierarchy is on screen, so routers are partitioned by window and by scene, and hooks only check routers in their own hierarchy. Only used on main thread.
+@interface ZIKWaitingViewRouterGroup : NSObject {
+    @package
+    /// Key of the group in g_waitingViewRouterGroups.
+    const void *_rootKey;
+    __weak XXView *_root;
+    /// key: destination, value: router.
+    CFMutableDictionaryRef _routers;
+}
+@end
+
+@implementation ZIKWaitingViewRouterGroup
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _routers = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    CFRelease(_routers);
+}
+
+@end
+
+/// Associated with root view of a group. When root view is dealloced, routers in the group become orphaned, because pointer of the root may be reused by another view.
+@interface ZIKWaitingViewRouterGroupSentinel : NSObject
+@property (nonatomic, strong, nullable) ZIKWaitingViewRouterGroup *group;
+@end
+
+@implementation ZIKWaitingViewRouterGroupSentinel
+
+- (void)dealloc {
+    ZIKWaitingViewRouterGroup *group = _group;
+    if (group == nil) {
+        return;
+    }
+    CFIndex count = CFDictionaryGetCount(group->_routers);
+    const void **keys = malloc(sizeof(void *) * count);
+    const void **values = malloc(sizeof(void *) * count);
+    CFDictionaryGetKeysAndValues(group->_routers, keys, values);
+    for (CFIndex i = 0; i < count; i++) {
+        CFDictionarySetValue(g_orphanedWaitingViewRouters, keys[i], values[i]);
+        CFDictionaryRemoveValue(g_waitingViewRouterGroupOfDestination, keys[i]);
+    }
+    free(keys);
+    free(values);
+    CFDictionaryRemoveValue(g_waitingViewRouterGroups, group->_rootKey);
+}
+
+@end
+
+static char kWaitingViewRouterGroupSentinelKey;
+
+static XXView *_rootViewOfView(XXView *view) {
+    XXView *root = view;
+    while (root.superview) {
+        root = root.superview;
+    }
+    return root;
+}
+
+static ZIKWaitingViewRouterGroup *_waitingViewRouterGroupOfRoot(XXView *root, BOOL createIfNeeded) {
+    ZIKWaitingViewRouterGroup *group = (__bridge ZIKWaitingViewRouterGroup *)CFDictionaryGetValue(g_waitingViewRouterGroups, (__bridge const void *)root);
+    if (group || !createIfNeeded) {
+        return group;
+    }
+    group = [ZIKWaitingViewRouterGroup new];
+    group->_rootKey = (__bridge const void *)root;
+    group->_root = root;
+    CFDictionarySetValue(g_waitingViewRouterGroups, group->_rootKey, (__bridge const void *)group);
+    ZIKWaitingViewRouterGroupSentinel *sentinel = [ZIKWaitingViewRouterGroupSentinel new];
+    sentinel.group = group;
+    objc_setAssociatedObject(root, &kWaitingViewRouterGroupSentinelKey, sentinel, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    return group;
+}
+
+static void _removeWaitingViewRouterGroupIfEmpty(ZIKWaitingViewRouterGroup *group) {
+    if (CFDictionaryGetCount(group->_routers) > 0) {
+        return;
+    }
+    XXView *root = group->_root;
+    if (root) {
+        ZIKWaitingViewRouterGroupSentinel *sentinel = objc_getAssociatedObject(root, &kWaitingViewRouterGroupSentinelKey);
+        sentinel.group = nil;
+        objc_setAssociatedObject(root, &kWaitingViewRouterGroupSentinelKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    CFDictionaryRemoveValue(g_waitingViewRouterGroups, group->_rootKey);
+}
+
+static void _groupWaitingViewRouter(ZIKWaitingViewRouterGroup *group, ZIKViewRouter *router, const void *key) {
+    CFDictionarySetValue(group->_routers, key, (__bridge const void *)router);
+    CFDictionarySetValue(g_waitingViewRouterGroupOfDestination, key, (__bridge const void *)group);
+}
+
+static void _ungroupWaitingViewRouter(const void *key) {
+    ZIKWaitingViewRouterGroup *group = (__bridge ZIKWaitingViewRouterGroup *)CFDictionaryGetValue(g_waitingViewRouterGroupOfDestination, key);
+    if (group == nil) {
+        CFDictionaryRemoveValue(g_orphanedWaitingViewRouters, key);
+        return;
+    }
+    CFDictionaryRemoveValue(g_waitingViewRouterGroupOfDestination, key);
+    CFDictionaryRemoveValue(group->_routers, key);
+    _removeWaitingViewRouterGroupIfEmpty(group);
+}
+
+/// Move routers to the group of the new root when a view is moving to another hierarchy. Called in -willMoveToSuperview: of all views.
+static void _regroupWaitingViewRoutersForMovingView(XXView *view, XXView *newSuperview) {
+    XXView *oldRoot = _rootViewOfView(view);
+    ZIKWaitingViewRouterGroup *oldGroup = _waitingViewRouterGroupOfRoot(oldRoot, NO);
+    if (oldGroup == nil) {
+        return;
+    }
+    XXView *newRoot = newSuperview ? _rootViewOfView(newSuperview) : view;
+    if (newRoot == oldRoot) {
+        return;
+    }
+    CFIndex count = CFDictionaryGetCount(oldGroup->_routers);
+    const void **keys = malloc(sizeof(void *) * count);
+    const void **values = malloc(sizeof(void *) * count);
+    CFDictionaryGetKeysAndValues(oldGroup->_routers, keys, values);
+    // Retain routers, they are released when removed from old group
+    NSMutableArray<ZIKViewRouter *> *routers = [NSMutableArray arrayWithCapacity:count];
+    for (CFIndex i = 0; i < count; i++) {
+        [routers addObject:(__bridge ZIKViewRouter *)values[i]];
+    }
+    ZIKWaitingViewRouterGroup *newGroup;
+    for (CFIndex i = 0; i < count; i++) {
+        ZIKViewRouter *router = routers[i];
+        if (oldRoot != view) {
+            // Only destinations in the moving view change their root
+            XXView *destination = router.destination;
+            if (destination == nil || ![destination isDescendantOfView:view]) {
+                continue;
+            }
+        }
+        if (newGroup == nil) {
+            newGroup = _waitingViewRouterGroupOfRoot(newRoot, YES);
+        }
+        CFDictionaryRemoveValue(oldGroup->_routers, keys[i]);
+        _groupWaitingViewRouter(newGroup, router, keys[i]);
+    }
+    free(keys);
+    free(values);
+    _removeWaitingViewRouterGroupIfEmpty(oldGroup);
+}
+
+/**
+ Destination's key is only used as pointer. When a destination is dealloced without leaving its superview, another view may reuse the address, so the router of the dealloced destination is ended before it's replaced.
+ 
+ Routers in g_finishingXXViewRouters are also grouped by root view of `superview`, the superview destination is in or moving to.
+ */
+static void _addWaitingViewRouter(CFMutableDictionaryRef routers, ZIKViewRouter *router, XXView *destination, XXView *superview) {
+    NSCParameterAssert(router);
+    NSCParameterAssert(destination);
+    ZIKViewRouter *oldRouter = (__bridge ZIKViewRouter *)CFDictionaryGetValue(routers, (__bridge const void *)destination);
+    if (oldRouter == router) {
+        return;
+    }
+    CFDictionarySetValue(routers, (__bridge const void *)destination, (__bridge const void *)router);
+    if (routers == g_finishingXXViewRouters) {
+        if (oldRouter) {
+            _ungroupWaitingViewRouter((__bridge const void *)destination);
+        }
+        _groupWaitingViewRouter(_waitingViewRouterGroupOfRoot(_rootViewOfView(superview ?: destination), YES), router, (__bridge const void *)destination);
+    }
+    if (oldRouter && oldRouter.destination == nil && oldRouter.state == ZIKRouterStateRouting) {
+        [oldRouter endPerformRouteWithError:[ZIKViewRouter routeErrorWithCode:ZIKRouteErrorActionFailed localizedDescription:@"Destination was dealloced when performing route."]];
+    }
+}
+
+static void _removeWaitingViewRouter(CFMutableDictionaryRef routers, ZIKViewRouter *router, XXView *destination) {
+    if (router && CFDictionaryGetValue(routers, (__bridge const void *)destination) == (__bridge const void *)router) {
+        CFDictionaryRemoveValue(routers, (__bridge const void *)destination);
+        if (routers == g_finishingXXViewRouters) {
+            _ungroupWaitingViewRouter((__bridge const void *)destination);
+        }
+    }
+}
+
+/// Routers are resolved in hooks of their destinations. Appearance of a view controller only checks routers waiting in its view, for private system views not calling -willMoveToWindow: and -didMoveToWindow.
+static inline void _finishWaitingViewRoutersIfNeeded(XXViewController *viewController, BOOL finishWhenHasWindow) {
+    if (CFDictionaryGetCount(g_finishingXXViewRouters) > 0) {
+        [ZIKViewRouter tryToFinishWaitingViewRoutersInView:viewController.view finishWhenHasWindow:finishWhenHasWindow];
+    }
+}
+
+/// Cached conformance to ZIKRoutableView of each view and view controller class, so hooks of non-routable views and view controllers return after one lookup. Only used on main thread.
+static BOOL _isRoutableViewClass(Class aClass) {
+    // Values are 1 for routable class and 2 for other classes
+    static CFMutableDictionaryRef routableClasses;
+    if (routableClasses == NULL) {
+        routableClasses = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+    }
+    uintptr_t value = (uintptr_t)CFDictionaryGetValue(routableClasses, (__bridge const void *)aClass);
+    if (value == 0) {
+        value = [aClass conformsToProtocol:@protocol(ZIKRoutableView)] ? 1 : 2;
+        CFDictionarySetValue(routableClasses, (__bridge const void *)aClass, (const void *)value);
+    }
+    return value == 1;
+}
+
+/// Plist in main bundle generated by Scripts/generate_segue_route_manifest.py. Key: segue identifier  value: names of all view controller classes in the destination of the segue.
+static NSString *const ZIKSegueRouteManifestName = @"ZIKSegueRoutes";
+
+/// Whether the destination of the segue never contains routable views according to the segue route manifest, so searching routable views can be skipped. Return NO when the segue is not in the manifest. Main thread only.
+static BOOL _segueHasNoRoutableView(NSString *_Nullable identifier) {
+    if (identifier == nil) {
+        return NO;
+    }
+    // Values are 1 for segue without routable view and 2 for other segues
+    static CFMutableDictionaryRef segueValues;
+    static NSDictionary<NSString *, NSArray<NSString *> *> *manifest;
+    if (segueValues == NULL) {
+        segueValues = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+        NSURL *manifestURL = [[NSBundle mainBundle] URLForResource:ZIKSegueRouteManifestName withExtension:@"plist"];
+        if (manifestURL) {
+            manifest = [NSDictionary dictionaryWithContentsOfURL:manifestURL];
+        }
+    }
+    uintptr_t value = (uintptr_t)CFDictionaryGetValue(segueValues, (__bridge const void *)identifier);
+    if (value == 0) {
+        NSArray<NSString *> *classNames = manifest[identifier];
+        value = classNames ? 1 : 2;
+        for (NSString *className in classNames) {
+            Class aClass = NSClassFromString(className);
+            // Class not found may be a routable class with different name
+            if (aClass == Nil || _isRoutableViewClass(aClass)) {
+                value = 2;
+                break;
+            }
+        }
+        CFDictionarySetValue(segueValues, (__bridge const void *)[identifier copy], (const void *)value);
+    }
+    return value == 1;
+}
+
+/// Action to remove the routed destination, recorded when the route is completed.
+typedef NS_ENUM(NSInteger, ZIKViewRemovalStrategy) {
+    ZIKViewRemovalStrategyNone,
+    ZIKViewRemovalStrategyPop,
+    ZIKViewRemovalStrategyDismiss,
+    ZIKViewRemovalStrategyDismissPopover,
+    ZIKViewRemovalStrategyCloseWindow,
+    ZIKViewRemovalStrategyRemoveFromParentViewController,
+    ZIKViewRemovalStrategyRemoveFromSuperview
+};
 
 @interface ZIKViewRouter ()
 @property (nonatomic, assign) BOOL routingFromInternal;
 @property (nonatomic, assign) ZIKViewRouteRealType realRouteType;
+/// Removal action recorded when route is completed, so removing doesn't inspect the hierarchy again.
+@property (nonatomic, assign) ZIKViewRemovalStrategy removalStrategy;
+/// Navigation controller, presenting view controller, window, parent view controller or superview of destination when route is completed. Removal strategy is only used when destination is still in the anchor.
+@property (nonatomic, weak, nullable) id removalAnchor;
 /// Destination prepared. Only for UIView destination
 @property (nonatomic, assign) BOOL prepared;
 #if ZIK_HAS_UIKIT
-@property (nonatomic, strong, nullable) ZIKPresentationState *stateBeforeRoute;
+@property (nonatomic, assign) ZIKPresentationSnapshot stateBeforeRoute;
+@property (nonatomic, assign) BOOL hasStateBeforeRoute;
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wdeprecated"
 @property (nonatomic, strong, nullable) UIPopoverController *popover;
@@ -60,6 +609,10 @@ static NSMutableSet *g_finishingXXViewRouters;
 #endif
 @property (nonatomic, weak, nullable) XXViewController<ZIKViewRouteContainer> *container;
 @property (nonatomic, strong, nullable) ZIKViewRouter *retainedSelf;
+/// Signpost of the transition interval, 0 when not recording.
+@property (nonatomic, assign) uint64_t transitionSignpost;
+/// Start time of ZIKRouteMetricAppear, 0 when not recording or destination already appeared.
+@property (nonatomic, assign) uint64_t appearStartTime;
 @end
 
 @implementation ZIKViewRouter
@@ -69,14 +622,57 @@ static NSMutableSet *g_finishingXXViewRouters;
 
 + (void)load {
     [ZIKRouteRegistry addRegistry:[ZIKViewRouteRegistry class]];
-    g_globalErrorSema = dispatch_semaphore_create(1);
-    g_preparingXXViewRouters = [NSMutableSet set];
-    g_finishingXXViewRouters = [NSMutableSet set];
+    g_destinationRoutersSema = dispatch_semaphore_create(1);
+    g_preparingXXViewRouters = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    g_finishingXXViewRouters = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    g_waitingViewRouterGroups = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    g_waitingViewRouterGroupOfDestination = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+    g_orphanedWaitingViewRouters = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    g_AOPSubscribers = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    g_AOPSubscribersSema = dispatch_semaphore_create(1);
+    g_installedHooksSema = dispatch_semaphore_create(1);
+    g_storyboardScenePlans = [NSMutableDictionary dictionary];
     
+    zix_replaceMethodWithMethodType([XXStoryboard class], @selector(storyboardWithName:bundle:), true,
+                                    self, @selector(ZIKViewRouter_hook_storyboardWithName:bundle:), true);
+#if !ZIKROUTER_SELECTIVE_HOOKS
+    zix_installViewRouterHooks(ZIKViewRouterHooksViewController | ZIKViewRouterHooksView | ZIKViewRouterHooksStoryboard);
+#endif
+}
+
+/// Record storyboard's bundle and name as key of its scene plans. Segue hooks are installed here if ZIKROUTER_SELECTIVE_HOOKS is enabled.
+#if ZIK_HAS_UIKIT
++ (UIStoryboard *)ZIKViewRouter_hook_storyboardWithName:(NSString *)name bundle:(nullable NSBundle *)storyboardBundleOrNil
+#else
++ (NSStoryboard *)ZIKViewRouter_hook_storyboardWithName:(NSString *)name bundle:(nullable NSBundle *)storyboardBundleOrNil
+#endif
+{
+#if ZIKROUTER_SELECTIVE_HOOKS
+    zix_installViewRouterHooks(ZIKViewRouterHooksStoryboard);
+#endif
+    XXStoryboard *storyboard = [self ZIKViewRouter_hook_storyboardWithName:name bundle:storyboardBundleOrNil];
+    if (storyboard && name) {
+        NSString *bundlePath = (storyboardBundleOrNil ?: [NSBundle mainBundle]).bundlePath ?: @"";
+        NSString *storyboardKey = [NSString stringWithFormat:@"%@/%@", bundlePath, name];
+        objc_setAssociatedObject(storyboard, &kStoryboardKey, storyboardKey, OBJC_ASSOCIATION_COPY_NONATOMIC);
+    }
+    return storyboard;
+}
+
+#if !ZIK_HAS_UIKIT
+/// Index windows whose content view controller was set before -setContentViewController: is hooked, so closing them is still routed. NSApp is nil when hooks are installed before the app is created, then there is no window yet.
+static void _indexExistingWindows(void) {
+    for (NSWindow *window in NSApp.windows) {
+        if (window.contentViewController) {
+            [g_routedWindows addObject:window];
+        }
+    }
+}
+#endif
+
+static void _installViewControllerHooks(void) {
     Class ZIKViewRouterClass = [ZIKViewRouter class];
     Class XXViewControllerClass = [XXViewController class];
-    Class XXStoryboardSegueClass = [XXStoryboardSegue class];
-    
 #if ZIK_HAS_UIKIT
     zix_replaceMethodWithMethod(XXViewControllerClass, @selector(willMoveToParentViewController:),
                                 ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToParentViewController:));
@@ -95,16 +691,8 @@ static NSMutableSet *g_finishingXXViewRouters;
     }
     zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewDidDisappear:),
                                 ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewDidDisappear:));
-    
-    zix_replaceMethodWithMethod([XXView class], @selector(willMoveToSuperview:),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToSuperview:));
-    zix_replaceMethodWithMethod([XXView class], @selector(didMoveToSuperview),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_didMoveToSuperview));
-    zix_replaceMethodWithMethod([XXView class], @selector(willMoveToWindow:),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToWindow:));
-    zix_replaceMethodWithMethod([XXView class], @selector(didMoveToWindow),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_didMoveToWindow));
 #else
+    g_routedWindows = [NSHashTable hashTableWithOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality];
     [[NSNotificationCenter defaultCenter] addObserverForName:NSWindowWillCloseNotification object:nil queue:nil usingBlock:^(NSNotification * _Nonnull note) {
         [ZIKViewRouter handleWindowWillCloseNotification:note];
     }];
@@ -112,6 +700,13 @@ static NSMutableSet *g_finishingXXViewRouters;
                                 ZIKViewRouterClass, @selector(ZIKViewRouter_hook_presentViewController:animator:));
     zix_replaceMethodWithMethod([NSWindow class], @selector(setContentViewController:),
                                 ZIKViewRouterClass, @selector(ZIKViewRouter_hook_setContentViewController:));
+    if ([NSThread isMainThread]) {
+        _indexExistingWindows();
+    } else {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            _indexExistingWindows();
+        });
+    }
     zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewWillAppear),
                                 ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewWillAppear));
     zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewDidAppear),
@@ -120,7 +715,23 @@ static NSMutableSet *g_finishingXXViewRouters;
                                 ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewWillDisappear));
     zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewDidDisappear),
                                 ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewDidDisappear));
-    
+#endif
+    zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewDidLoad),
+                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewDidLoad));
+}
+
+static void _installViewHooks(void) {
+    Class ZIKViewRouterClass = [ZIKViewRouter class];
+#if ZIK_HAS_UIKIT
+    zix_replaceMethodWithMethod([XXView class], @selector(willMoveToSuperview:),
+                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToSuperview:));
+    zix_replaceMethodWithMethod([XXView class], @selector(didMoveToSuperview),
+                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_didMoveToSuperview));
+    zix_replaceMethodWithMethod([XXView class], @selector(willMoveToWindow:),
+                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToWindow:));
+    zix_replaceMethodWithMethod([XXView class], @selector(didMoveToWindow),
+                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_didMoveToWindow));
+#else
     zix_replaceMethodWithMethod([XXView class], @selector(viewWillMoveToSuperview:),
                                 ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToSuperview:));
     zix_replaceMethodWithMethod([XXView class], @selector(viewDidMoveToSuperview),
@@ -130,8 +741,12 @@ static NSMutableSet *g_finishingXXViewRouters;
     zix_replaceMethodWithMethod([XXView class], @selector(viewDidMoveToWindow),
                                 ZIKViewRouterClass, @selector(ZIKViewRouter_hook_didMoveToWindow));
 #endif
-    zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewDidLoad),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewDidLoad));
+}
+
+static void _installStoryboardHooks(void) {
+    Class ZIKViewRouterClass = [ZIKViewRouter class];
+    Class XXViewControllerClass = [XXViewController class];
+    Class XXStoryboardSegueClass = [XXStoryboardSegue class];
     zix_replaceMethodWithMethod(XXViewControllerClass, @selector(prepareForSegue:sender:),
                                 ZIKViewRouterClass, @selector(ZIKViewRouter_hook_prepareForSegue:sender:));
     zix_replaceMethodWithMethod(XXStoryboardSegueClass, @selector(perform),
@@ -145,6 +760,29 @@ static NSMutableSet *g_finishingXXViewRouters;
 #endif
 }
 
+ZIKViewRouterHooks zix_installedViewRouterHooks(void) {
+    return g_installedHooks;
+}
+
+void zix_installViewRouterHooks(ZIKViewRouterHooks hooks) {
+    if ((g_installedHooks & hooks) == hooks) {
+        return;
+    }
+    dispatch_semaphore_wait(g_installedHooksSema, DISPATCH_TIME_FOREVER);
+    ZIKViewRouterHooks newHooks = hooks & ~g_installedHooks;
+    if (newHooks & ZIKViewRouterHooksViewController) {
+        _installViewControllerHooks();
+    }
+    if (newHooks & ZIKViewRouterHooksView) {
+        _installViewHooks();
+    }
+    if (newHooks & ZIKViewRouterHooksStoryboard) {
+        _installStoryboardHooks();
+    }
+    g_installedHooks |= newHooks;
+    dispatch_semaphore_signal(g_installedHooksSema);
+}
+
 + (void)_didFinishRegistration {
     
 }
@@ -155,17 +793,22 @@ static NSMutableSet *g_finishingXXViewRouters;
     NSParameterAssert([configuration isKindOfClass:[ZIKViewRouteConfiguration class]]);
     
     if (self = [super initWithConfiguration:configuration removeConfiguration:removeConfiguration]) {
+#if ZIKROUTER_VALIDATE_CONFIGURATION
         if (![[self class] _validateRouteTypeInConfiguration:configuration]) {
             [self notifyError_unsupportTypeWithAction:ZIKRouteActionInit
-                                     errorDescription:@"%@ doesn't support routeType:%ld, supported types: %ld",[self class],configuration.routeType,[[self class] supportedRouteTypes]];
+                                     errorDescription:@"%@ doesn't support routeType:%ld, supported types: %ld",[self class],configuration.routeType,[[self class] resolvedSupportedRouteTypes]];
             return nil;
         } else if (![[self class] _validateRouteSourceNotMissedInConfiguration:configuration] ||
                    ![[self class] _validateRouteSourceClassInConfiguration:configuration]) {
+#else
+        if (![[self class] _validateRouteSourceNotMissedInConfiguration:configuration]) {
+#endif
             [self notifyError_invalidSourceWithAction:ZIKRouteActionInit
                                      errorDescription:@"Source: (%@) is invalid for configuration: (%@)",configuration.source,configuration];
             return nil;
         } else {
             ZIKViewRouteType type = configuration.routeType;
+#if ZIKROUTER_VALIDATE_CONFIGURATION
             if (type == ZIKViewRouteTypePerformSegue) {
                 if (![[self class] _validateSegueInConfiguration:configuration]) {
                     [self notifyError_invalidConfigurationWithAction:ZIKRouteActionInit
@@ -178,7 +821,9 @@ static NSMutableSet *g_finishingXXViewRouters;
                                                     errorDescription:@"PopoverConfiguration : (%@) was invalid",configuration.popoverConfiguration];
                     return nil;
                 }
-            } else if (type == ZIKViewRouteTypeCustom) {
+            } else
+#endif
+            if (type == ZIKViewRouteTypeCustom) {
                 if (![[self class] validateCustomRouteConfiguration:configuration removeConfiguration:self.original_removeConfiguration]) {
                     [self notifyError_invalidConfigurationWithAction:ZIKRouteActionInit
                                                     errorDescription:@"Configuration : (%@) was invalid for ZIKViewRouteTypeCustom",configuration];
@@ -186,28 +831,25 @@ static NSMutableSet *g_finishingXXViewRouters;
                 }
             }
         }
-        
-        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(_handleWillPerformRouteNotification:) name:kZIKViewRouteWillPerformRouteNotification object:nil];
-        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(_handleDidPerformRouteNotification:) name:kZIKViewRouteDidPerformRouteNotification object:nil];
-        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(_handleWillRemoveRouteNotification:) name:kZIKViewRouteWillRemoveRouteNotification object:nil];
-        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(_handleDidRemoveRouteNotification:) name:kZIKViewRouteDidRemoveRouteNotification object:nil];
-        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(_handleRemoveRouteCancelledNotification:) name:kZIKViewRouteRemoveRouteCancelledNotification object:nil];
     }
     return self;
 }
 
-- (void)dealloc {
-    [[NSNotificationCenter defaultCenter] removeObserver:self];
-}
-
 #pragma mark Override
 
 - (void)notifyRouteState:(ZIKRouterState)state {
     if (state == ZIKRouterStateRemoved) {
         self.realRouteType = ZIKViewRouteRealTypeUnknown;
         self.prepared = NO;
+        [self _clearRemovalStrategy];
+    } else if (state == ZIKRouterStateRouting && self.state != ZIKRouterStateRouting) {
+        self.appearStartTime = zix_routeMetricsTime();
+        [self _clearRemovalStrategy];
     }
     [super notifyRouteState:state];
+    if (state == ZIKRouterStateRouted) {
+        [self _recordRemovalStrategy];
+    }
 }
 
 
@@ -231,6 +873,19 @@ static NSMutableSet *g_finishingXXViewRouters;
     return YES;
 }
 
+- (nullable id)makeDestinationWithConfiguration:(ZIKPerformRouteConfiguration *)configuration {
+    // Preloaded destinations are made with default configuration, they're only taken when configuration matches it
+    if (configuration.prewarmKey == nil &&
+        [configuration conformsToProtocol:@protocol(ZIKConfigurationMakeable)] == NO &&
+        [NSThread isMainThread]) {
+        id destination = _takePreloadedDestination([self class], configuration);
+        if (destination) {
+            return destination;
+        }
+    }
+    return [super makeDestinationWithConfiguration:configuration];
+}
+
 - (void)performWithConfiguration:(__kindof ZIKViewRouteConfiguration *)configuration {
     NSParameterAssert(configuration);
     if (configuration.routeType == ZIKViewRouteTypePerformSegue) {
@@ -255,6 +910,9 @@ static NSMutableSet *g_finishingXXViewRouters;
         [self _validateDestinationConformance:destination];
     }
 #endif
+    if (destination && !_makingDestinationOnly) {
+        _addRouterToDestination(self, destination);
+    }
     [super attachDestination:destination];
 }
 
@@ -385,6 +1043,41 @@ static NSMutableSet *g_finishingXXViewRouters;
              @"Only ZIKViewRouteTypePerformSegue can use ZIKViewRouter class to perform route, otherwise, use a subclass of ZIKViewRouter for destination.");
 }
 
+- (void)prepareDestinationAlongsideTransition:(id)destination configuration:(__kindof ZIKViewRouteConfiguration *)configuration delivery:(ZIKViewRoutePreparationDelivery)delivery {
+    
+}
+
+/// Start asynchronous preparation when the transition begins. Destination is held weakly until the result is delivered.
+- (void)_prepareDestinationAlongsideTransition {
+    id destination = self.destination;
+    if (destination == nil) {
+        return;
+    }
+    ZIKViewRouteConfiguration *configuration = self.original_configuration;
+    __weak id weakDestination = destination;
+    ZIKViewRoutePreparationDelivery delivery = ^(void(^update)(id destination)) {
+        NSCParameterAssert(update);
+        if (update == nil) {
+            return;
+        }
+        void(^deliver)(void) = ^{
+            id destination = weakDestination;
+            if (destination) {
+                update(destination);
+            }
+        };
+        if ([NSThread isMainThread]) {
+            deliver();
+        } else {
+            dispatch_async(dispatch_get_main_queue(), deliver);
+        }
+    };
+    if (configuration.prepareDestinationAlongsideTransition) {
+        configuration.prepareDestinationAlongsideTransition(destination, delivery);
+    }
+    [self prepareDestinationAlongsideTransition:destination configuration:configuration delivery:delivery];
+}
+
 #pragma mark Perform Route
 
 - (BOOL)canPerformCustomRoute {
@@ -429,6 +1122,11 @@ static NSMutableSet *g_finishingXXViewRouters;
 }
 
 - (BOOL)_canPerformWithErrorMessage:(NSString **)message {
+    return [self _canPerformWithErrorMessage:message sourceState:nil];
+}
+
+/// When sourceState is not nil, state of the source is read from it instead of checking the source again.
+- (BOOL)_canPerformWithErrorMessage:(NSString **)message sourceState:(nullable ZIKViewRouteSourceState *)sourceState {
     ZIKRouterState state = self.state;
     if (state == ZIKRouterStateRouting) {
         if (message) {
@@ -470,13 +1168,18 @@ static NSMutableSet *g_finishingXXViewRouters;
 #if ZIK_HAS_UIKIT
         case ZIKViewRouteTypePush: {
             id destination = self.destination;
-            if (![[self class] _validateSourceInNavigationStack:source]) {
+            BOOL inNavigationStack = sourceState ? (sourceState.navigationController != nil) : [[self class] _validateSourceInNavigationStack:source];
+            if (!inNavigationStack) {
                 if (message) {
                     *message = [NSString stringWithFormat:@"Source (%@) is not in any navigation stack now, can't push.",source];
                 }
                 return NO;
             }
-            if (destination && ![[self class] _validateDestination:destination notInNavigationStackOfSource:source]) {
+            BOOL destinationNotInStack = YES;
+            if (destination) {
+                destinationNotInStack = sourceState ? _destinationNotInNavigationStack(destination, sourceState.navigationController) : [[self class] _validateDestination:destination notInNavigationStackOfSource:source];
+            }
+            if (!destinationNotInStack) {
                 if (message) {
                     *message = [NSString stringWithFormat:@"Destination (%@) is already in source (%@)'s navigation stack, can't push.",destination,source];
                 }
@@ -489,7 +1192,8 @@ static NSMutableSet *g_finishingXXViewRouters;
         case ZIKViewRouteTypePresentModally:
 #if ZIK_HAS_UIKIT
         case ZIKViewRouteTypePresentAsPopover: {
-            if (![[self class] _validateSourceNotPresentedAnyView:source]) {
+            BOOL presentedAnyView = sourceState ? sourceState.presentedAnyView : ![[self class] _validateSourceNotPresentedAnyView:source];
+            if (presentedAnyView) {
                 if (message) {
                     *message = [NSString stringWithFormat:@"Source (%@) presented another view controller (%@), can't present destination now.",source,[source presentedViewController]];
                 }
@@ -513,11 +1217,14 @@ static NSMutableSet *g_finishingXXViewRouters;
         [self notifyRouteState:self.preState];
         [self notifyError_actionFailedWithAction:ZIKRouteActionPerformRoute errorDescription:@"-destinationWithConfiguration: of router: %@ return nil when performRoute, configuration may be invalid or router has bad impletmentation in -destinationWithConfiguration. Configuration: %@",[self class],configuration];
         return;
-    } else if (![[self class] _validateDestinationClass:destination inConfiguration:configuration]) {
+    }
+#if ZIKROUTER_VALIDATE_CONFIGURATION
+    if (![[self class] _validateDestinationClass:destination inConfiguration:configuration]) {
         [self notifyRouteState:self.preState];
         [self notifyError_actionFailedWithAction:ZIKRouteActionPerformRoute errorDescription:@"Bad impletment in destinationWithConfiguration: of router: %@, invalid destination (%@) for configuration (%@) !",[self class],destination,configuration];
         return;
     }
+#endif
 #if ZIKROUTER_CHECK
     if ([[self class] _validateDestinationShouldExistInConfiguration:configuration]) {
         [self _validateDestinationConformance:destination];
@@ -607,12 +1314,18 @@ static NSMutableSet *g_finishingXXViewRouters;
                              errorDescription:@"Pushing the same view controller instance more than once is not supported. Source: (%@), destination: (%@), viewControllers in navigation stack: (%@)",source,destination,source.navigationController.viewControllers];
         return;
     }
+    UINavigationController *navigationController = _navigationControllerForPushFromSource(source);
     XXViewController *wrappedDestination = [self _wrappedDestination:destination];
     [self beginPerformRoute];
     [destination setZix_routeTypeFromRouter:@(ZIKViewRouteTypePush)];
     self.realRouteType = ZIKViewRouteRealTypePush;
-    [source.navigationController pushViewController:wrappedDestination animated:self.original_configuration.animated];
-    [ZIKViewRouter _completeWithtransitionCoordinator:source.navigationController.transitionCoordinator
+    if (g_pushBatch) {
+        [g_pushBatch addRouter:self viewController:wrappedDestination navigationController:navigationController];
+        return;
+    }
+    [navigationController pushViewController:wrappedDestination animated:self.original_configuration.animated];
+    [ZIKViewRouter _completeWithtransitionCoordinator:navigationController.transitionCoordinator
+                                             animated:self.original_configuration.animated
                                  transitionCompletion:^{
         [self endPerformRouteWithSuccess];
     }];
@@ -802,6 +1515,7 @@ static NSMutableSet *g_finishingXXViewRouters;
         }
         
         [ZIKViewRouter _completeWithtransitionCoordinator:popover.contentViewController.transitionCoordinator
+                                                 animated:configuration.animated
                                      transitionCompletion:^{
             [self endPerformRouteWithSuccess];
         }];
@@ -894,7 +1608,7 @@ static NSMutableSet *g_finishingXXViewRouters;
     segueConfig.segueSource = nil;
     segueConfig.segueDestination = nil;
 #if ZIK_HAS_UIKIT
-    segueConfig.destinationStateBeforeRoute = nil;
+    segueConfig.hasDestinationStateBeforeRoute = NO;
 #endif
     
     self.routingFromInternal = YES;
@@ -964,7 +1678,7 @@ static NSMutableSet *g_finishingXXViewRouters;
     [destination setZix_routeTypeFromRouter:@(ZIKViewRouteTypeShow)];
     XXViewController *wrappedDestination = [self _wrappedDestination:destination];
 #if ZIK_HAS_UIKIT
-    ZIKPresentationState *destinationStateBeforeRoute = [destination zix_presentationState];
+    ZIKPresentationSnapshot destinationStateBeforeRoute = zix_presentationSnapshot(destination);
 #endif
     [self beginPerformRoute];
 #if ZIK_HAS_UIKIT
@@ -1006,7 +1720,7 @@ static NSMutableSet *g_finishingXXViewRouters;
 #pragma clang diagnostic ignored "-Wunguarded-availability"
     [destination setZix_routeTypeFromRouter:@(ZIKViewRouteTypeShowDetail)];
     XXViewController *wrappedDestination = [self _wrappedDestination:destination];
-    ZIKPresentationState *destinationStateBeforeRoute = [destination zix_presentationState];
+    ZIKPresentationSnapshot destinationStateBeforeRoute = zix_presentationSnapshot(destination);
     [self beginPerformRoute];
     
     [source showDetailViewController:wrappedDestination sender:self.original_configuration.sender];
@@ -1035,6 +1749,7 @@ static NSMutableSet *g_finishingXXViewRouters;
     /// Call AOP in -viewWillAppear: and -viewDidAppear:
     self.routingFromInternal = YES;
     [self prepareDestinationForPerforming];
+    [self _prepareDestinationAlongsideTransition];
     [destination setZix_routeTypeFromRouter:@(ZIKViewRouteTypeAddAsChildViewController)];
     [source addChildViewController:wrappedDestination];
     
@@ -1090,7 +1805,8 @@ static NSMutableSet *g_finishingXXViewRouters;
     [self prepareDestinationForPerforming];
 #if ZIK_HAS_UIKIT
     if ([destination respondsToSelector:@selector(zix_presentationState)]) {
-        self.stateBeforeRoute = [destination zix_presentationState];
+        self.stateBeforeRoute = zix_presentationSnapshot(destination);
+        self.hasStateBeforeRoute = YES;
     }
 #endif
     self.realRouteType = ZIKViewRouteRealTypeUnknown;
@@ -1109,7 +1825,16 @@ static NSMutableSet *g_finishingXXViewRouters;
     if (!configuration.containerWrapper) {
         return destination;
     }
+#if ZIK_HAS_UIKIT
+    NSString *reuseIdentifier = configuration.containerReuseIdentifier;
+    UINavigationController *reusedContainer = reuseIdentifier ? _dequeueReusableContainer(reuseIdentifier) : nil;
+    if (reusedContainer) {
+        [reusedContainer setViewControllers:@[destination] animated:NO];
+    }
+    XXViewController<ZIKViewRouteContainer> *container = reusedContainer ?: configuration.containerWrapper(destination);
+#else
     XXViewController<ZIKViewRouteContainer> *container = configuration.containerWrapper(destination);
+#endif
     
     NSString *errorDescription;
     if (!container) {
@@ -1171,8 +1896,12 @@ static NSMutableSet *g_finishingXXViewRouters;
     
     if (![router destinationFromExternalPrepared:destination]) {
         if (!performer) {
-            NSString *description = [NSString stringWithFormat:@"Can't find which custom UIView or UIViewController added destination:(%@) as subview, so we can't notify the performer to config the destination. You may add destination to a superview in code directly, and the superview is not a custom class. Please change your code and add subview by a custom view router with ZIKViewRouteTypeAddAsSubview. CallStack: %@",destination, [NSThread callStackSymbols]];
-            [self notifyError_invalidPerformerWithAction:ZIKRouteActionPerformRoute errorDescription:description];
+            NSArray<NSNumber *> *callStack = [NSThread callStackReturnAddresses];
+            __weak id weakDestination = destination;
+            NSError *error = [ZIKViewRouter errorWithCode:ZIKViewRouteErrorInvalidPerformer localizedDescriptionProvider:^NSString *{
+                return [NSString stringWithFormat:@"Can't find which custom UIView or UIViewController added destination:(%@) as subview, so we can't notify the performer to config the destination. You may add destination to a superview in code directly, and the superview is not a custom class. Please change your code and add subview by a custom view router with ZIKViewRouteTypeAddAsSubview. CallStack: %@",weakDestination, zix_symbolicateCallStack(callStack)];
+            }];
+            [self notifyGlobalErrorWithRouter:nil action:ZIKRouteActionPerformRoute error:error];
         }
         
         if ([performer respondsToSelector:@selector(prepareDestinationFromExternal:configuration:)]) {
@@ -1206,18 +1935,18 @@ static NSMutableSet *g_finishingXXViewRouters;
 + (void)_completeRouter:(ZIKViewRouter *)router
 analyzeRouteTypeForDestination:(UIViewController *)destination
                    source:(UIViewController *)source
-destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
+destinationStateBeforeRoute:(ZIKPresentationSnapshot)destinationStateBeforeRoute
     transitionCoordinator:(nullable id <UIViewControllerTransitionCoordinator>)transitionCoordinator
                completion:(void(^)(void))completion {
     [ZIKViewRouter _completeWithtransitionCoordinator:transitionCoordinator transitionCompletion:^{
-        ZIKPresentationState *destinationStateAfterRoute = [destination zix_presentationState];
-        if ([destinationStateBeforeRoute isEqual:destinationStateAfterRoute]) {
+        ZIKPresentationSnapshot destinationStateAfterRoute = zix_presentationSnapshot(destination);
+        if (zix_presentationSnapshotsEqual(&destinationStateBeforeRoute, &destinationStateAfterRoute)) {
             router.realRouteType = ZIKViewRouteRealTypeCustom;//maybe ZIKViewRouteRealTypeUnwind, but we just need to know this route can't be remove
 #if DEBUG
-            NSLog(@"⚠️Warning: destination(%@)'s state was not changed after perform route from source: (%@). current state: (%@).\nYou may begin another transition without animation when the source is still in a transition without animation, or you may override source's -showViewController:sender:/-showDetailViewController:sender:/-presentViewController:animated:completion:/-pushViewController:animated: or use a custom segue, but didn't perform real presentation, or your presentation was async.",destination,source,destinationStateAfterRoute);
+            ZIX_LOG(Route, Warning, @"⚠️Warning: destination(%@)'s state was not changed after perform route from source: (%@). current state: (%@).\nYou may begin another transition without animation when the source is still in a transition without animation, or you may override source's -showViewController:sender:/-showDetailViewController:sender:/-presentViewController:animated:completion:/-pushViewController:animated: or use a custom segue, but didn't perform real presentation, or your presentation was async.",destination,source,[destination zix_presentationState]);
 #endif
         } else {
-            ZIKViewRouteDetailType routeType = [ZIKPresentationState detailRouteTypeFromStateBeforeRoute:destinationStateBeforeRoute stateAfterRoute:destinationStateAfterRoute];
+            ZIKViewRouteDetailType routeType = zix_detailRouteTypeFromSnapshots(&destinationStateBeforeRoute, &destinationStateAfterRoute);
             router.realRouteType = [[router class] _realRouteTypeFromDetailType:routeType];
         }
         if (completion) {
@@ -1227,7 +1956,16 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
 }
 
 + (void)_completeWithtransitionCoordinator:(nullable id <UIViewControllerTransitionCoordinator>)transitionCoordinator transitionCompletion:(void(^)(void))completion {
+    [self _completeWithtransitionCoordinator:transitionCoordinator animated:YES transitionCompletion:completion];
+}
+
+/// Non-animated transition without coordinator is already applied when UIKit returns, so complete inline instead of waiting for next runloop. Tests and state restoration perform many non-animated routes in a row.
++ (void)_completeWithtransitionCoordinator:(nullable id <UIViewControllerTransitionCoordinator>)transitionCoordinator animated:(BOOL)animated transitionCompletion:(void(^)(void))completion {
     NSParameterAssert(completion);
+    if (!transitionCoordinator && !animated) {
+        completion();
+        return;
+    }
     //If user use a custom transition from source to destination, such as methods in UIView(UIViewAnimationWithBlocks) or UIView (UIViewKeyframeAnimations), the transitionCoordinator will be nil, route will complete before animation complete
     if (!transitionCoordinator) {
         //If the source view controlelr is still in transition, begin another transition in completion may fail. So complete in next runloop (or next viewDidAppear: / viewDidDisappear:).
@@ -1266,10 +2004,12 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
     NSAssert(self.state == ZIKRouterStateRouting, @"state should be routing when begin to route.");
     self.retainedSelf = self;
     self.routingFromInternal = YES;
+    self.transitionSignpost = zix_beginRouterSignpost(ZIKRouteSignpostStageTransition, self);
     id destination = self.destination;
     id source = self.original_configuration.source;
     [self prepareDestinationForPerforming];
     [ZIKViewRouter AOP_notifyAll_router:self willPerformRouteOnDestination:destination fromSource:source];
+    [self _prepareDestinationAlongsideTransition];
 }
 
 - (void)endPerformRouteWithSuccess {
@@ -1279,6 +2019,7 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
 }
 
 - (void)endPerformRouteWithSuccessWithAOP:(BOOL)notifyAOP {
+    [self endTransitionSignpost];
     [self notifyRouteState:ZIKRouterStateRouted];
     if (notifyAOP) {
         id destination = self.destination;
@@ -1295,7 +2036,7 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
         XXView *view = self.destination;
         if ([view zix_isRootView]) {
             if (!zix_classSelfImplementingMethod([self class], @selector(shouldAutoCreateForDestination:fromSource:), YES)) {
-                NSLog(@"\nZIKViewRouter Warning:⚠️ the routable UIView (%@) is the root view of a view controller (%@), the UIKit system may implicitly remove and add the UIView during some animation. You should check and avoid those unnecessary auto creating in +shouldAutoCreateForDestination:fromSource:.", view, [view nextResponder]);
+                ZIX_LOG(Route, Warning, @"ZIKViewRouter Warning:⚠️ the routable UIView (%@) is the root view of a view controller (%@), the UIKit system may implicitly remove and add the UIView during some animation. You should check and avoid those unnecessary auto creating in +shouldAutoCreateForDestination:fromSource:.", view, [view nextResponder]);
             }
         }
     }
@@ -1306,6 +2047,8 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
     NSParameterAssert(error);
     NSAssert(self.state == ZIKRouterStateRouting, @"state should be routing when end route.");
     ZIKRouterState preState = self.preState;
+    [self endTransitionSignpost];
+    self.appearStartTime = 0;
     [super endPerformRouteWithError:error];
     if (self.state == preState) {
         self.routingFromInternal = NO;
@@ -1313,6 +2056,14 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
     }
 }
 
+- (void)endTransitionSignpost {
+    uint64_t signpost = self.transitionSignpost;
+    if (signpost) {
+        self.transitionSignpost = 0;
+        zix_endRouterSignpost(ZIKRouteSignpostStageTransition, signpost, self);
+    }
+}
+
 #if ZIK_HAS_UIKIT
 + (ZIKViewRouteRealType)_realRouteTypeFromDetailType:(ZIKViewRouteDetailType)detailType {
     ZIKViewRouteRealType realType;
@@ -1365,13 +2116,26 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
 
 - (BOOL)canRemove {
     NSAssert([NSThread isMainThread], @"Always check state in main thread, bacause state may change in main thread after you check the state in child thread.");
-    return [self checkCanRemove] == nil;
+    return [super canRemove];
 }
 
 - (BOOL)canRemoveCustomRoute {
     return NO;
 }
 
+/// Format reason of -checkCanRemove, or return the constant message when it's only probing in -canRemove.
+static NSString *_canNotRemoveMessage(NSString *format, ...) NS_FORMAT_FUNCTION(1,2);
+static NSString *_canNotRemoveMessage(NSString *format, ...) {
+    if (zix_isProbingCanRemove()) {
+        return ZIKRouterCanNotRemoveMessage;
+    }
+    va_list argList;
+    va_start(argList, format);
+    NSString *message = [[NSString alloc] initWithFormat:format arguments:argList];
+    va_end(argList);
+    return message;
+}
+
 - (NSString *)checkCanRemove {
     NSString *errorMessage = [super checkCanRemove];
     if (errorMessage) {
@@ -1391,23 +2155,26 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
             return nil;
         }
     }
+    if ([self _hasValidRemovalStrategy]) {
+        return nil;
+    }
     
     switch (realRouteType) {
         case ZIKViewRouteRealTypeUnknown:
             if ([self _guessCanRemove]) {
                 return nil;
             }
-            return [NSString stringWithFormat:@"Router can't remove, realRouteType is ZIKViewRouteRealTypeUnknown, doesn't support remove, router:%@",self];
+            return _canNotRemoveMessage(@"Router can't remove, realRouteType is ZIKViewRouteRealTypeUnknown, doesn't support remove, router:%@",self);
             break;
         case ZIKViewRouteRealTypeUnwind:
         case ZIKViewRouteRealTypeCustom: {
-            return [NSString stringWithFormat:@"Router can't remove, realRouteType is %ld, doesn't support remove, router:%@",(long)realRouteType,self];
+            return _canNotRemoveMessage(@"Router can't remove, realRouteType is %ld, doesn't support remove, router:%@",(long)realRouteType,self);
             break;
         }
 #if ZIK_HAS_UIKIT
         case ZIKViewRouteRealTypePush: {
             if (![self _canPop]) {
-                return [NSString stringWithFormat:@"Router can't remove, destination doesn't have navigationController when pop, router:%@",self];
+                return _canNotRemoveMessage(@"Router can't remove, destination doesn't have navigationController when pop, router:%@",self);
             }
             break;
         }
@@ -1421,27 +2188,27 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
 #endif
         {
             if (![self _canDismiss]) {
-                return [NSString stringWithFormat:@"Router can't remove, destination is not presented when dismiss. router:%@", self];
+                return _canNotRemoveMessage(@"Router can't remove, destination is not presented when dismiss. router:%@", self);
             }
             break;
         }
 #if !ZIK_HAS_UIKIT
         case ZIKViewRouteRealTypeShowWindow:
             if (![self _canCloseWindow]) {
-                return [NSString stringWithFormat:@"Router can't remove, destination is not in any window, router:%@", self];
+                return _canNotRemoveMessage(@"Router can't remove, destination is not in any window, router:%@", self);
             }
             break;
 #endif
         case ZIKViewRouteRealTypeAddAsChildViewController: {
             if (![self _canRemoveFromParentViewController]) {
-                return [NSString stringWithFormat:@"Router can't remove, doesn't have parent view controller when remove from parent. router:%@", self];
+                return _canNotRemoveMessage(@"Router can't remove, doesn't have parent view controller when remove from parent. router:%@", self);
             }
             break;
         }
             
         case ZIKViewRouteRealTypeAddAsSubview: {
             if (![self _canRemoveFromSuperview]) {
-                return [NSString stringWithFormat:@"Router can't remove, destination doesn't have superview when remove from superview. router:%@",self];
+                return _canNotRemoveMessage(@"Router can't remove, destination doesn't have superview when remove from superview. router:%@",self);
             }
             break;
         }
@@ -1505,47 +2272,242 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
     if (destination.view.window == nil) {
         return NO;
     }
-    return YES;
+    return YES;
+}
+#endif
+
+- (BOOL)_canRemoveFromParentViewController {
+    XXViewController *destination = self.destination;
+    if ([destination isKindOfClass:[XXViewController class]] == NO) {
+        return NO;
+    }
+    if (!destination.parentViewController) {
+        return NO;
+    }
+    return YES;
+}
+
+- (BOOL)_canRemoveFromSuperview {
+    XXView *destination = self.destination;
+    if ([destination isKindOfClass:[XXView class]] == NO) {
+        return NO;
+    }
+    if (!destination.superview) {
+        return NO;
+    }
+    return YES;
+}
+
+- (BOOL)_guessCanRemove {
+#if ZIK_HAS_UIKIT
+    if ([self _canPop]) {
+        return YES;
+    }
+#endif
+    if ([self _canDismiss]) {
+        return YES;
+    }
+    if (self.original_configuration.routeType == ZIKViewRouteTypeAddAsChildViewController &&
+        [self _canRemoveFromParentViewController]) {
+        return YES;
+    }
+    if ([self _canRemoveFromSuperview]) {
+        return YES;
+    }
+    return NO;
+}
+
+#pragma mark Removal Strategy
+
+/// Record how to remove destination and where destination is when route is completed. Routers with unknown real route type, such as auto created routers, guess only once here.
+- (void)_recordRemovalStrategy {
+    [self _clearRemovalStrategy];
+    if (self.original_configuration.routeType == ZIKViewRouteTypeCustom) {
+        return;
+    }
+    ZIKViewRemovalStrategy strategy = ZIKViewRemovalStrategyNone;
+    switch (self.realRouteType) {
+#if ZIK_HAS_UIKIT
+        case ZIKViewRouteRealTypePush:
+            strategy = ZIKViewRemovalStrategyPop;
+            break;
+#endif
+        case ZIKViewRouteRealTypePresentModally:
+#if !ZIK_HAS_UIKIT
+        case ZIKViewRouteRealTypePresentAsSheet:
+        case ZIKViewRouteRealTypePresentWithAnimator:
+#endif
+            strategy = ZIKViewRemovalStrategyDismiss;
+            break;
+        case ZIKViewRouteRealTypePresentAsPopover:
+            strategy = ZIKViewRemovalStrategyDismissPopover;
+            break;
+#if !ZIK_HAS_UIKIT
+        case ZIKViewRouteRealTypeShowWindow:
+            strategy = ZIKViewRemovalStrategyCloseWindow;
+            break;
+#endif
+        case ZIKViewRouteRealTypeAddAsChildViewController:
+            strategy = ZIKViewRemovalStrategyRemoveFromParentViewController;
+            break;
+        case ZIKViewRouteRealTypeAddAsSubview:
+            strategy = ZIKViewRemovalStrategyRemoveFromSuperview;
+            break;
+        case ZIKViewRouteRealTypeUnknown:
+            strategy = [self _guessRemovalStrategy];
+            break;
+        default:
+            break;
+    }
+    id anchor = [self _removalAnchorForStrategy:strategy];
+    if (anchor == nil) {
+        return;
+    }
+    self.removalStrategy = strategy;
+    self.removalAnchor = anchor;
+}
+
+- (void)_clearRemovalStrategy {
+    self.removalStrategy = ZIKViewRemovalStrategyNone;
+    self.removalAnchor = nil;
+}
+
+/// Same order as guessing when removing.
+- (ZIKViewRemovalStrategy)_guessRemovalStrategy {
+    id destination = self.destination;
+    if ([destination isKindOfClass:[XXViewController class]]) {
+#if ZIK_HAS_UIKIT
+        ZIKViewRouteType routeType = self.original_configuration.routeType;
+        BOOL preferDismiss = YES;
+        if (routeType == ZIKViewRouteTypePush) {
+            preferDismiss = NO;
+        }
+        if (@available(iOS 8, *)) {
+            if (routeType == ZIKViewRouteTypeShow) {
+                preferDismiss = NO;
+            }
+        }
+        if (preferDismiss == NO && [self _canPop]) {
+            return ZIKViewRemovalStrategyPop;
+        }
+#endif
+        if ([self _canDismiss]) {
+            return ZIKViewRemovalStrategyDismiss;
+        }
+#if ZIK_HAS_UIKIT
+        if (preferDismiss == YES && [self _canPop]) {
+            return ZIKViewRemovalStrategyPop;
+        }
+#endif
+        if (self.original_configuration.routeType == ZIKViewRouteTypeAddAsChildViewController &&
+            [self _canRemoveFromParentViewController]) {
+            return ZIKViewRemovalStrategyRemoveFromParentViewController;
+        }
+    } else if ([destination isKindOfClass:[XXView class]]) {
+        if ([self _canRemoveFromSuperview]) {
+            return ZIKViewRemovalStrategyRemoveFromSuperview;
+        }
+    }
+    return ZIKViewRemovalStrategyNone;
 }
-#endif
 
-- (BOOL)_canRemoveFromParentViewController {
-    XXViewController *destination = self.destination;
-    if ([destination isKindOfClass:[XXViewController class]] == NO) {
-        return NO;
-    }
-    if (!destination.parentViewController) {
-        return NO;
+- (nullable id)_removalAnchorForStrategy:(ZIKViewRemovalStrategy)strategy {
+    id destination = self.destination;
+    switch (strategy) {
+        case ZIKViewRemovalStrategyNone:
+            return nil;
+#if ZIK_HAS_UIKIT
+        case ZIKViewRemovalStrategyPop:
+            return [self _canPop] ? [(XXViewController *)destination navigationController] : nil;
+#else
+        case ZIKViewRemovalStrategyPop:
+            return nil;
+#endif
+        case ZIKViewRemovalStrategyDismiss:
+        case ZIKViewRemovalStrategyDismissPopover:
+            return [self _canDismiss] ? [(XXViewController *)destination presentingViewController] : nil;
+#if ZIK_HAS_UIKIT
+        case ZIKViewRemovalStrategyCloseWindow:
+            return nil;
+#else
+        case ZIKViewRemovalStrategyCloseWindow:
+            return [self _canCloseWindow] ? [(XXViewController *)destination view].window : nil;
+#endif
+        case ZIKViewRemovalStrategyRemoveFromParentViewController:
+            return [self _canRemoveFromParentViewController] ? [(XXViewController *)destination parentViewController] : nil;
+        case ZIKViewRemovalStrategyRemoveFromSuperview:
+            return [self _canRemoveFromSuperview] ? [(XXView *)destination superview] : nil;
     }
-    return YES;
+    return nil;
 }
 
-- (BOOL)_canRemoveFromSuperview {
-    XXView *destination = self.destination;
-    if ([destination isKindOfClass:[XXView class]] == NO) {
+/// Whether destination is still in the recorded anchor. It only compares pointers, without inspecting the hierarchy.
+- (BOOL)_hasValidRemovalStrategy {
+    ZIKViewRemovalStrategy strategy = self.removalStrategy;
+    if (strategy == ZIKViewRemovalStrategyNone) {
         return NO;
     }
-    if (!destination.superview) {
+    id anchor = self.removalAnchor;
+    if (anchor == nil) {
         return NO;
     }
-    return YES;
+    id destination = self.destination;
+    switch (strategy) {
+        case ZIKViewRemovalStrategyNone:
+            return NO;
+#if ZIK_HAS_UIKIT
+        case ZIKViewRemovalStrategyPop: {
+            UINavigationController *navigationController = anchor;
+            return [(XXViewController *)destination navigationController] == navigationController && navigationController.viewControllers.firstObject != destination;
+        }
+        case ZIKViewRemovalStrategyCloseWindow:
+            return NO;
+#else
+        case ZIKViewRemovalStrategyPop:
+            return NO;
+        case ZIKViewRemovalStrategyCloseWindow:
+            return [(XXViewController *)destination isViewLoaded] && [(XXViewController *)destination view].window == anchor;
+#endif
+        case ZIKViewRemovalStrategyDismiss:
+        case ZIKViewRemovalStrategyDismissPopover:
+            return [(XXViewController *)destination presentingViewController] == anchor;
+        case ZIKViewRemovalStrategyRemoveFromParentViewController:
+            return [(XXViewController *)destination parentViewController] == anchor;
+        case ZIKViewRemovalStrategyRemoveFromSuperview:
+            return [(XXView *)destination superview] == anchor;
+    }
+    return NO;
 }
 
-- (BOOL)_guessCanRemove {
+- (BOOL)_performRemovalStrategy:(ZIKViewRemovalStrategy)strategy onDestination:(id)destination {
+    switch (strategy) {
+        case ZIKViewRemovalStrategyNone:
+            return NO;
 #if ZIK_HAS_UIKIT
-    if ([self _canPop]) {
-        return YES;
-    }
+        case ZIKViewRemovalStrategyPop:
+            [self _popOnDestination:destination];
+            return YES;
+        case ZIKViewRemovalStrategyCloseWindow:
+            return NO;
+#else
+        case ZIKViewRemovalStrategyPop:
+            return NO;
+        case ZIKViewRemovalStrategyCloseWindow:
+            [self _closeWindowOnDestination:destination];
+            return YES;
 #endif
-    if ([self _canDismiss]) {
-        return YES;
-    }
-    if (self.original_configuration.routeType == ZIKViewRouteTypeAddAsChildViewController &&
-        [self _canRemoveFromParentViewController]) {
-        return YES;
-    }
-    if ([self _canRemoveFromSuperview]) {
-        return YES;
+        case ZIKViewRemovalStrategyDismiss:
+            [self _dismissOnDestination:destination];
+            return YES;
+        case ZIKViewRemovalStrategyDismissPopover:
+            [self _dismissPopoverOnDestination:destination];
+            return YES;
+        case ZIKViewRemovalStrategyRemoveFromParentViewController:
+            [self _removeFromParentViewControllerOnDestination:destination];
+            return YES;
+        case ZIKViewRemovalStrategyRemoveFromSuperview:
+            [self _removeFromSuperviewOnDestination:destination];
+            return YES;
     }
     return NO;
 }
@@ -1563,6 +2525,10 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
         [self _removeCustomOnDestination:destination fromSource:configuration.source];
         return;
     }
+    if ([self _hasValidRemovalStrategy]) {
+        [self _performRemovalStrategy:self.removalStrategy onDestination:destination];
+        return;
+    }
     ZIKViewRouteRealType realRouteType = self.realRouteType;
     NSString *errorDescription;
     
@@ -1621,46 +2587,7 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
 }
 
 - (BOOL)_guessToRemoveDestination:(id)destination {
-    if ([destination isKindOfClass:[XXViewController class]]) {
-#if ZIK_HAS_UIKIT
-        ZIKViewRouteType routeType = self.original_configuration.routeType;
-        BOOL preferDismiss = YES;
-        if (routeType == ZIKViewRouteTypePush) {
-            preferDismiss = NO;
-        }
-        if (@available(iOS 8, *)) {
-            if (routeType == ZIKViewRouteTypeShow) {
-                preferDismiss = NO;
-            }
-        }
-        if (preferDismiss == NO && [self _canPop]) {
-            [self _popOnDestination:destination];
-            return YES;
-        }
-#endif
-        if ([self _canDismiss]) {
-            [self _dismissOnDestination:destination];
-            return YES;
-        }
-#if ZIK_HAS_UIKIT
-        if (preferDismiss == YES && [self _canPop]) {
-            [self _popOnDestination:destination];
-            return YES;
-        }
-#endif
-        if (self.original_configuration.routeType == ZIKViewRouteTypeAddAsChildViewController) {
-            if ([self _canRemoveFromParentViewController]) {
-                [self _removeFromParentViewControllerOnDestination:destination];
-                return YES;
-            }
-        }
-    } else if ([destination isKindOfClass:[XXView class]]) {
-        if ([self _canRemoveFromSuperview]) {
-            [self _removeFromSuperviewOnDestination:destination];
-            return YES;
-        }
-    }
-    return NO;
+    return [self _performRemovalStrategy:[self _guessRemovalStrategy] onDestination:destination];
 }
 
 #if ZIK_HAS_UIKIT
@@ -1684,6 +2611,7 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
         [destination.navigationController popViewControllerAnimated:self.original_removeConfiguration.animated];
     }
     [ZIKViewRouter _completeWithtransitionCoordinator:destination.navigationController.transitionCoordinator
+                                             animated:self.original_removeConfiguration.animated
                                  transitionCompletion:^{
         [self endRemoveRouteWithSuccessOnDestination:destination fromSource:source];
     }];
@@ -1748,6 +2676,7 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
     [popover dismissPopoverAnimated:self.original_removeConfiguration.animated];
     self.popover = nil;
     [ZIKViewRouter _completeWithtransitionCoordinator:destination.transitionCoordinator
+                                             animated:self.original_removeConfiguration.animated
                                  transitionCompletion:^{
         [self endRemoveRouteWithSuccessOnDestination:destination fromSource:source];
     }];
@@ -1865,11 +2794,29 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
     [self notifySuccessWithAction:ZIKRouteActionRemoveRoute];
     if (self.state == ZIKRouterStateRemoved) {
         self.routingFromInternal = NO;
+#if ZIK_HAS_UIKIT
+        [self _recycleContainer];
+#endif
         self.container = nil;
         self.retainedSelf = nil;
     }
 }
 
+#if ZIK_HAS_UIKIT
+/// Put the navigation controller made by containerWrapper into reuse pool when it's not in any hierarchy.
+- (void)_recycleContainer {
+    NSString *reuseIdentifier = self.original_configuration.containerReuseIdentifier;
+    XXViewController *container = self.container;
+    if (reuseIdentifier == nil || ![container isKindOfClass:[UINavigationController class]]) {
+        return;
+    }
+    if (container.presentingViewController || container.parentViewController || (container.isViewLoaded && container.view.window)) {
+        return;
+    }
+    _enqueueReusableContainer((UINavigationController *)container, reuseIdentifier);
+}
+#endif
+
 - (void)endRemoveRouteWithError:(NSError *)error {
     NSParameterAssert(error);
     NSAssert(self.state == ZIKRouterStateRemoving, @"state should be removing when end remove.");
@@ -1883,51 +2830,215 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
 
 #pragma mark AOP
 
-+ (void)AOP_notifyAll_router:(nullable ZIKViewRouter *)router willPerformRouteOnDestination:(id)destination fromSource:(nullable id)source {
-    NSParameterAssert([destination conformsToProtocol:@protocol(ZIKRoutableView)]);
-    [ZIKViewRouteRegistry enumerateRoutersForDestinationClass:[destination class] handler:^(ZIKRouterType * _Nonnull route) {
+/// Route object overriding the AOP callback, or nil when it uses the default empty callback.
+static id _Nullable _AOPSubscriberOfRoute(ZIKViewRouterType *routerType, SEL selector) {
+    id route = routerType.routeObject;
+    Class routerClass = routerType.routerClass;
+    if (routerClass == nil) {
+        // Route subclass may implement the callback itself, otherwise it forwards to its router class
+        if (class_getInstanceMethod(object_getClass(route), selector)) {
+            return route;
+        }
+        routerClass = [(ZIKViewRoute *)route routerClass];
+    }
+    if (routerClass && zix_classOverridesMethodOfClass(routerClass, [ZIKViewRouter class], selector, true)) {
+        return route;
+    }
+    return nil;
+}
+
+static ZIKViewRouteAOPSubscribers *_computeAOPSubscribers(Class destinationClass) {
+    static SEL selectors[4];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        selectors[0] = @selector(router:willPerformRouteOnDestination:fromSource:);
+        selectors[1] = @selector(router:didPerformRouteOnDestination:fromSource:);
+        selectors[2] = @selector(router:willRemoveRouteOnDestination:fromSource:);
+        selectors[3] = @selector(router:didRemoveRouteOnDestination:fromSource:);
+    });
+    NSMutableArray *subscribers[4];
+    for (int i = 0; i < 4; i++) {
+        subscribers[i] = [NSMutableArray array];
+    }
+    __block BOOL detectsMemoryLeak = NO;
+    [ZIKViewRouteRegistry enumerateRoutersForDestinationClass:destinationClass handler:^(ZIKRouterType * _Nonnull route) {
         ZIKViewRouterType *r = (ZIKViewRouterType *)route;
-        [r router:router willPerformRouteOnDestination:destination fromSource:source];
+        for (int i = 0; i < 4; i++) {
+            id subscriber = _AOPSubscriberOfRoute(r, selectors[i]);
+            if (subscriber) {
+                [subscribers[i] addObject:subscriber];
+            }
+        }
+        if (!r.routerClass || [r.routerClass shouldDetectMemoryLeak]) {
+            detectsMemoryLeak = YES;
+        }
     }];
+    ZIKViewRouteAOPSubscribers *result = [ZIKViewRouteAOPSubscribers new];
+    result.willPerformSubscribers = subscribers[0];
+    result.didPerformSubscribers = subscribers[1];
+    result.willRemoveSubscribers = subscribers[2];
+    result.didRemoveSubscribers = subscribers[3];
+    result.detectsMemoryLeak = detectsMemoryLeak;
+    return result;
+}
+
+static ZIKViewRouteAOPSubscribers *_AOPSubscribersForDestinationClass(Class destinationClass) {
+    // Routers may still be registered before registration is finished
+    if (!ZIKRouteRegistry.registrationFinished) {
+        return _computeAOPSubscribers(destinationClass);
+    }
+    const void *key = (__bridge const void *)destinationClass;
+    dispatch_semaphore_wait(g_AOPSubscribersSema, DISPATCH_TIME_FOREVER);
+    ZIKViewRouteAOPSubscribers *subscribers = (__bridge ZIKViewRouteAOPSubscribers *)CFDictionaryGetValue(g_AOPSubscribers, key);
+    NSUInteger generation = g_AOPSubscribersGeneration;
+    dispatch_semaphore_signal(g_AOPSubscribersSema);
+    if (subscribers) {
+        return subscribers;
+    }
+    subscribers = _computeAOPSubscribers(destinationClass);
+    dispatch_semaphore_wait(g_AOPSubscribersSema, DISPATCH_TIME_FOREVER);
+    if (generation == g_AOPSubscribersGeneration) {
+        CFDictionarySetValue(g_AOPSubscribers, key, (__bridge const void *)subscribers);
+    }
+    dispatch_semaphore_signal(g_AOPSubscribersSema);
+    return subscribers;
+}
+
++ (void)AOP_notifyAll_router:(nullable ZIKViewRouter *)router willPerformRouteOnDestination:(id)destination fromSource:(nullable id)source {
+    NSParameterAssert([destination conformsToProtocol:@protocol(ZIKRoutableView)]);
+    for (id subscriber in _AOPSubscribersForDestinationClass([destination class]).willPerformSubscribers) {
+        [subscriber router:router willPerformRouteOnDestination:destination fromSource:source];
+    }
 }
 
 + (void)AOP_notifyAll_router:(nullable ZIKViewRouter *)router didPerformRouteOnDestination:(id)destination fromSource:(nullable id)source {
     NSParameterAssert([destination conformsToProtocol:@protocol(ZIKRoutableView)]);
-    [ZIKViewRouteRegistry enumerateRoutersForDestinationClass:[destination class] handler:^(ZIKRouterType * _Nonnull route) {
-        ZIKViewRouterType *r = (ZIKViewRouterType *)route;
-        [r router:router didPerformRouteOnDestination:destination fromSource:source];
-    }];
+    for (id subscriber in _AOPSubscribersForDestinationClass([destination class]).didPerformSubscribers) {
+        [subscriber router:router didPerformRouteOnDestination:destination fromSource:source];
+    }
 }
 
 + (void)AOP_notifyAll_router:(nullable ZIKViewRouter *)router willRemoveRouteOnDestination:(id)destination fromSource:(nullable id)source {
     NSParameterAssert([destination conformsToProtocol:@protocol(ZIKRoutableView)]);
-    [ZIKViewRouteRegistry enumerateRoutersForDestinationClass:[destination class] handler:^(ZIKRouterType * _Nonnull route) {
-        ZIKViewRouterType *r = (ZIKViewRouterType *)route;
-        [r router:router willRemoveRouteOnDestination:destination fromSource:(id)source];
-    }];
+    for (id subscriber in _AOPSubscribersForDestinationClass([destination class]).willRemoveSubscribers) {
+        [subscriber router:router willRemoveRouteOnDestination:destination fromSource:(id)source];
+    }
 }
 
 + (void)AOP_notifyAll_router:(nullable ZIKViewRouter *)router didRemoveRouteOnDestination:(id)destination fromSource:(nullable id)source {
     NSParameterAssert([destination conformsToProtocol:@protocol(ZIKRoutableView)]);
-#if DEBUG
-    __block BOOL shouldDetectMemoryLeak = NO;
-#endif
-    [ZIKViewRouteRegistry enumerateRoutersForDestinationClass:[destination class] handler:^(ZIKRouterType * _Nonnull route) {
-        ZIKViewRouterType *r = (ZIKViewRouterType *)route;
-        [r router:router didRemoveRouteOnDestination:destination fromSource:(id)source];
-#if DEBUG
-        if (!r.routerClass || [r.routerClass shouldDetectMemoryLeak]) {
-            if (!shouldDetectMemoryLeak) {
-                shouldDetectMemoryLeak = YES;
+    ZIKViewRouteAOPSubscribers *subscribers = _AOPSubscribersForDestinationClass([destination class]);
+    for (id subscriber in subscribers.didRemoveSubscribers) {
+        [subscriber router:router didRemoveRouteOnDestination:destination fromSource:(id)source];
+    }
+    if (subscribers.detectsMemoryLeak && _shouldSampleMemoryLeak()) {
+        zix_checkMemoryLeak(destination, [self detectMemoryLeakDelay], [self didDetectLeakingHandler]);
+    }
+}
+
+#pragma mark Coalesced AOP
+
+/// AOP perform callback of subview collected when `coalescesSubviewAOPCallbacks` is YES.
+@interface ZIKViewRouteSubviewAOPEvent : NSObject {
+    @public
+    ZIKViewRouter *_router;
+    XXView *_destination;
+    id _source;
+    BOOL _didPerform;
+}
+@end
+@implementation ZIKViewRouteSubviewAOPEvent
+@end
+
+static BOOL g_coalescesSubviewAOPCallbacks;
+/// Only used on main thread.
+static NSMutableArray<ZIKViewRouteSubviewAOPEvent *> *g_pendingSubviewAOPEvents;
+static CFRunLoopObserverRef g_subviewAOPObserver;
+
+static void _deliverSubviewAOPEvents(void) {
+    NSArray<ZIKViewRouteSubviewAOPEvent *> *events = g_pendingSubviewAOPEvents;
+    g_pendingSubviewAOPEvents = nil;
+    // Group by destination class in order of their first event, so subscribers of each class are resolved once
+    NSMutableArray<Class> *destinationClasses = [NSMutableArray array];
+    NSMapTable<Class, NSMutableArray<ZIKViewRouteSubviewAOPEvent *> *> *eventsOfClass = [NSMapTable strongToStrongObjectsMapTable];
+    for (ZIKViewRouteSubviewAOPEvent *event in events) {
+        Class destinationClass = [event->_destination class];
+        NSMutableArray<ZIKViewRouteSubviewAOPEvent *> *classEvents = [eventsOfClass objectForKey:destinationClass];
+        if (classEvents == nil) {
+            classEvents = [NSMutableArray array];
+            [eventsOfClass setObject:classEvents forKey:destinationClass];
+            [destinationClasses addObject:destinationClass];
+        }
+        [classEvents addObject:event];
+    }
+    for (Class destinationClass in destinationClasses) {
+        ZIKViewRouteAOPSubscribers *subscribers = _AOPSubscribersForDestinationClass(destinationClass);
+        if (subscribers.willPerformSubscribers.count == 0 && subscribers.didPerformSubscribers.count == 0) {
+            continue;
+        }
+        for (ZIKViewRouteSubviewAOPEvent *event in [eventsOfClass objectForKey:destinationClass]) {
+            if (event->_didPerform) {
+                for (id subscriber in subscribers.didPerformSubscribers) {
+                    [subscriber router:event->_router didPerformRouteOnDestination:event->_destination fromSource:event->_source];
+                }
+            } else {
+                for (id subscriber in subscribers.willPerformSubscribers) {
+                    [subscriber router:event->_router willPerformRouteOnDestination:event->_destination fromSource:event->_source];
+                }
             }
         }
-#endif
-    }];
-#if DEBUG
-    if (shouldDetectMemoryLeak) {
-        zix_checkMemoryLeak(destination, [self detectMemoryLeakDelay], [self didDetectLeakingHandler]);
-    }    
-#endif
+    }
+}
+
+static void _enqueueSubviewAOPEvent(ZIKViewRouter *_Nullable router, XXView *destination, id _Nullable source, BOOL didPerform) {
+    ZIKViewRouteSubviewAOPEvent *event = [ZIKViewRouteSubviewAOPEvent new];
+    event->_router = router;
+    event->_destination = destination;
+    event->_source = source;
+    event->_didPerform = didPerform;
+    if (g_pendingSubviewAOPEvents == nil) {
+        g_pendingSubviewAOPEvents = [NSMutableArray array];
+    }
+    [g_pendingSubviewAOPEvents addObject:event];
+    if (g_subviewAOPObserver == NULL) {
+        // After Core Animation commits the layout pass
+        g_subviewAOPObserver = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault, kCFRunLoopBeforeWaiting | kCFRunLoopExit, true, INT_MAX, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+            if (g_pendingSubviewAOPEvents.count > 0) {
+                _deliverSubviewAOPEvents();
+            }
+        });
+        CFRunLoopAddObserver(CFRunLoopGetMain(), g_subviewAOPObserver, kCFRunLoopCommonModes);
+    }
+}
+
+/// Will perform AOP callback of subview added without router.
+static void _notifySubviewAOPWillPerform(ZIKViewRouter *_Nullable router, XXView *destination, id _Nullable source) {
+    if (g_coalescesSubviewAOPCallbacks) {
+        _enqueueSubviewAOPEvent(router, destination, source, NO);
+        return;
+    }
+    [ZIKViewRouter AOP_notifyAll_router:router willPerformRouteOnDestination:destination fromSource:source];
+}
+
+/// Did perform AOP callback of subview added without router.
+static void _notifySubviewAOPDidPerform(ZIKViewRouter *_Nullable router, XXView *destination, id _Nullable source) {
+    if (g_coalescesSubviewAOPCallbacks) {
+        _enqueueSubviewAOPEvent(router, destination, source, YES);
+        return;
+    }
+    [ZIKViewRouter AOP_notifyAll_router:router didPerformRouteOnDestination:destination fromSource:source];
+}
+
++ (BOOL)coalescesSubviewAOPCallbacks {
+    return g_coalescesSubviewAOPCallbacks;
+}
+
++ (void)setCoalescesSubviewAOPCallbacks:(BOOL)coalescesSubviewAOPCallbacks {
+    NSAssert([NSThread isMainThread], @"Set coalescesSubviewAOPCallbacks on main thread.");
+    if (g_coalescesSubviewAOPCallbacks && !coalescesSubviewAOPCallbacks && g_pendingSubviewAOPEvents.count > 0) {
+        _deliverSubviewAOPEvents();
+    }
+    g_coalescesSubviewAOPCallbacks = coalescesSubviewAOPCallbacks;
 }
 
 + (void)router:(nullable ZIKViewRouter *)router willPerformRouteOnDestination:(id)destination fromSource:(nullable id)source {
@@ -1968,8 +3079,7 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
  */
 
 /// Update state when route action is not performed from router
-- (void)_handleWillPerformRouteNotification:(NSNotification *)note {
-    id destination = note.object;
+- (void)_handleWillPerformRouteOnDestination:(id)destination {
     if (!self.destination || self.destination != destination) {
         return;
     }
@@ -1983,7 +3093,7 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
         }
         if (state != ZIKRouterStateRouted || (
 #if ZIK_HAS_UIKIT
-                self.stateBeforeRoute &&
+                self.hasStateBeforeRoute &&
 #endif
                 configuration.routeType == ZIKViewRouteTypeMakeDestination
                 )) {
@@ -2001,20 +3111,25 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
     }
 }
 
-- (void)_handleDidPerformRouteNotification:(NSNotification *)note {
-    id destination = note.object;
+- (void)_handleDidPerformRouteOnDestination:(id)destination {
     if (!self.destination || self.destination != destination) {
         return;
     }
+    uint64_t appearStartTime = self.appearStartTime;
+    if (appearStartTime) {
+        self.appearStartTime = 0;
+        zix_recordRouteMetric([self class], ZIKRouteMetricAppear, appearStartTime);
+    }
 #if ZIK_HAS_UIKIT
-    if (self.stateBeforeRoute &&
+    if (self.hasStateBeforeRoute &&
         self.original_configuration.routeType == ZIKViewRouteTypeMakeDestination) {
         NSAssert(self.realRouteType == ZIKViewRouteRealTypeUnknown, @"real route type is unknown before destination is real routed");
-        ZIKPresentationState *stateBeforeRoute = self.stateBeforeRoute;
-        if (stateBeforeRoute && [destination respondsToSelector:@selector(zix_presentationState)]) {
-            ZIKViewRouteDetailType detailRouteType = [ZIKPresentationState detailRouteTypeFromStateBeforeRoute:stateBeforeRoute stateAfterRoute:[destination zix_presentationState]];
+        if ([destination respondsToSelector:@selector(zix_presentationState)]) {
+            ZIKPresentationSnapshot stateBeforeRoute = self.stateBeforeRoute;
+            ZIKPresentationSnapshot stateAfterRoute = zix_presentationSnapshot(destination);
+            ZIKViewRouteDetailType detailRouteType = zix_detailRouteTypeFromSnapshots(&stateBeforeRoute, &stateAfterRoute);
             self.realRouteType = [ZIKViewRouter _realRouteTypeFromDetailType:detailRouteType];
-            self.stateBeforeRoute = nil;
+            self.hasStateBeforeRoute = NO;
         }
     }
 #endif
@@ -2027,8 +3142,7 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
     }
 }
 
-- (void)_handleWillRemoveRouteNotification:(NSNotification *)note {
-    id destination = note.object;
+- (void)_handleWillRemoveRouteOnDestination:(id)destination {
     if (!self.destination || self.destination != destination) {
         return;
     }
@@ -2036,31 +3150,38 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
     if (!self.routingFromInternal && state != ZIKRouterStateRemoving) {
         if (state != ZIKRouterStateRemoved || (
 #if ZIK_HAS_UIKIT
-                self.stateBeforeRoute &&
+                self.hasStateBeforeRoute &&
 #endif
                 self.original_configuration.routeType == ZIKViewRouteTypeMakeDestination)) {
                 [self notifyRouteState:ZIKRouterStateRemoving];//not performed from router (dealed by system, or your code)
             }
     }
     if (state == ZIKRouterStateRouting) {
-        [self notifyError_unbalancedTransitionWithAction:ZIKRouteActionPerformRoute errorDescription:@"Unbalanced calls to begin/end appearance transitions for destination. This error occurs when you try and display a view controller before the current view controller is finished displaying. This may cause the UIViewController skips or messes up the order calling -viewWillAppear:, -viewDidAppear:, -viewWillDisAppear: and -viewDidDisappear:, and messes up the route state. Current error reason is trying to remove route on destination when destination is routing, router:(%@), callStack:%@",self,[NSThread callStackSymbols]];
+        NSArray<NSNumber *> *callStack = [NSThread callStackReturnAddresses];
+        __weak ZIKViewRouter *weakSelf = self;
+        Class routerClass = [self class];
+        const void *address = (__bridge const void *)self;
+        NSError *error = [ZIKViewRouter errorWithCode:ZIKViewRouteErrorUnbalancedTransition localizedDescriptionProvider:^NSString *{
+            return [NSString stringWithFormat:@"Unbalanced calls to begin/end appearance transitions for destination. This error occurs when you try and display a view controller before the current view controller is finished displaying. This may cause the UIViewController skips or messes up the order calling -viewWillAppear:, -viewDidAppear:, -viewWillDisAppear: and -viewDidDisappear:, and messes up the route state. Current error reason is trying to remove route on destination when destination is routing, router:(%@), callStack:%@",zix_routerDescription(weakSelf, routerClass, address),zix_symbolicateCallStack(callStack)];
+        }];
+        [[self class] notifyGlobalErrorWithRouter:self action:ZIKRouteActionPerformRoute error:error];
     }
 }
 
-- (void)_handleDidRemoveRouteNotification:(NSNotification *)note {
-    id destination = note.object;
+- (void)_handleDidRemoveRouteOnDestination:(id)destination {
     if (!self.destination || self.destination != destination) {
         return;
     }
 #if ZIK_HAS_UIKIT
-    if (self.stateBeforeRoute &&
+    if (self.hasStateBeforeRoute &&
         self.original_configuration.routeType == ZIKViewRouteTypeMakeDestination) {
         NSAssert(self.realRouteType == ZIKViewRouteRealTypeUnknown, @"real route type is unknown before destination is real routed");
-        ZIKPresentationState *stateBeforeRoute = self.stateBeforeRoute;
-        if (stateBeforeRoute && [destination respondsToSelector:@selector(zix_presentationState)]) {
-            ZIKViewRouteDetailType detailRouteType = [ZIKPresentationState detailRouteTypeFromStateBeforeRoute:stateBeforeRoute stateAfterRoute:[destination zix_presentationState]];
+        if ([destination respondsToSelector:@selector(zix_presentationState)]) {
+            ZIKPresentationSnapshot stateBeforeRoute = self.stateBeforeRoute;
+            ZIKPresentationSnapshot stateAfterRoute = zix_presentationSnapshot(destination);
+            ZIKViewRouteDetailType detailRouteType = zix_detailRouteTypeFromSnapshots(&stateBeforeRoute, &stateAfterRoute);
             self.realRouteType = [ZIKViewRouter _realRouteTypeFromDetailType:detailRouteType];
-            self.stateBeforeRoute = nil;
+            self.hasStateBeforeRoute = NO;
         }
     }
 #endif
@@ -2073,8 +3194,7 @@ destinationStateBeforeRoute:(ZIKPresentationState *)destinationStateBeforeRoute
     }
 }
 
-- (void)_handleRemoveRouteCancelledNotification:(NSNotification *)note {
-    id destination = note.object;
+- (void)_handleRemoveRouteCancelledOnDestination:(id)destination {
     if (!self.destination || self.destination != destination) {
         return;
     }
@@ -2101,10 +3221,33 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
     return nil;
 }
 
+/// Same as `-[ZIKViewRouterType shouldAutoCreateForDestination:fromSource:]`, but returns YES without sending it when the router uses the default implementation. Override checks are cached per class by `zix_classOverridesMethodOfClass`, so views moving in and out of the hierarchy don't send it again and again.
+static BOOL _routerTypeShouldAutoCreate(ZIKViewRouterType *routerType, id destination, id _Nullable source) {
+    SEL selector = @selector(shouldAutoCreateForDestination:fromSource:);
+    Class routerClass = routerType.routerClass;
+    if (routerClass == nil) {
+        ZIKViewRoute *route = routerType.routeObject;
+        if (![route isKindOfClass:[ZIKViewRoute class]] ||
+            route.shouldAutoCreateForDestinationBlock ||
+            zix_classOverridesMethodOfClass(object_getClass(route), [ZIKViewRoute class], selector, false)) {
+            return [routerType shouldAutoCreateForDestination:destination fromSource:source];
+        }
+        routerClass = route.routerClass;
+    }
+    if (routerClass && !zix_classOverridesMethodOfClass(routerClass, [ZIKViewRouter class], selector, true)) {
+        return YES;
+    }
+    return [routerType shouldAutoCreateForDestination:destination fromSource:source];
+}
+
 #if ZIK_HAS_UIKIT
 
 - (void)ZIKViewRouter_hook_willMoveToParentViewController:(UIViewController *)parent {
-    [self ZIKViewRouter_hook_willMoveToParentViewController:parent];
+    ZIX_RECORD_PROFILED_HOOK(WillMoveToParentViewController);
+    // Parent is always tracked
+    ZIX_HOOK_PROCESSED();
+    zix_invalidateRoutePerformers();
+    ZIX_HOOK_CALL_ORIGINAL([self ZIKViewRouter_hook_willMoveToParentViewController:parent]);
     if (parent) {
         [(XXViewController *)self setZix_parentMovingTo:parent];
     } else {
@@ -2115,7 +3258,10 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
 }
 
 - (void)ZIKViewRouter_hook_didMoveToParentViewController:(UIViewController *)parent {
-    [self ZIKViewRouter_hook_didMoveToParentViewController:parent];
+    ZIX_RECORD_PROFILED_HOOK(DidMoveToParentViewController);
+    ZIX_HOOK_PROCESSED();
+    zix_invalidateRoutePerformers();
+    ZIX_HOOK_CALL_ORIGINAL([self ZIKViewRouter_hook_didMoveToParentViewController:parent]);
     if (parent) {
         [(XXViewController *)self setZix_parentMovingTo:nil];
     } else {
@@ -2125,21 +3271,24 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
 }
 
 - (void)ZIKViewRouter_hook_viewWillAppear:(BOOL)animated {
-    [ZIKViewRouter tryToFinishWaitingViewRouters:NO];
+    ZIX_RECORD_PROFILED_HOOK(ViewWillAppear);
+    _finishWaitingViewRoutersIfNeeded((XXViewController *)self, NO);
     UIViewController *destination = (UIViewController *)self;
     BOOL removing = destination.zix_removing;
-    BOOL isRoutableView = ([self conformsToProtocol:@protocol(ZIKRoutableView)] == YES);
+    BOOL isRoutableView = _isRoutableViewClass([self class]);
     if (removing) {
+        ZIX_HOOK_PROCESSED();
         [destination setZix_removing:NO];
         if (isRoutableView) {
-            [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteRemoveRouteCancelledNotification object:destination];
+            _notifyRoutersOfDestination(destination, ZIKViewRouteEventRemoveRouteCancelled);
         }
     }
     if (isRoutableView) {
         BOOL routed = [(UIViewController *)self zix_routed];
         if (!routed) {
+            ZIX_HOOK_PROCESSED();
             UIViewController *parentMovingTo = [(UIViewController *)self zix_parentMovingTo];
-            [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteWillPerformRouteNotification object:destination];
+            _notifyRoutersOfDestination(destination, ZIKViewRouteEventWillPerformRoute);
             NSNumber *routeTypeFromRouter = [destination zix_routeTypeFromRouter];
             if (!routeTypeFromRouter ||
                 [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination ||
@@ -2161,17 +3310,19 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
         }
     }
     
-    [self ZIKViewRouter_hook_viewWillAppear:animated];
+    ZIX_HOOK_CALL_ORIGINAL([self ZIKViewRouter_hook_viewWillAppear:animated]);
 }
 
 - (void)ZIKViewRouter_hook_viewDidAppear:(BOOL)animated {
-    [ZIKViewRouter tryToFinishWaitingViewRouters:YES];
+    ZIX_RECORD_PROFILED_HOOK(ViewDidAppear);
+    _finishWaitingViewRoutersIfNeeded((XXViewController *)self, YES);
     BOOL routed = [(UIViewController *)self zix_routed];
     UIViewController *parentMovingTo = [(UIViewController *)self zix_parentMovingTo];
     if (!routed &&
-        [self conformsToProtocol:@protocol(ZIKRoutableView)]) {
+        _isRoutableViewClass([self class])) {
         UIViewController *destination = (UIViewController *)self;
-        [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteDidPerformRouteNotification object:destination];
+        ZIX_HOOK_PROCESSED();
+        _notifyRoutersOfDestination(destination, ZIKViewRouteEventDidPerformRoute);
         NSNumber *routeTypeFromRouter = [destination zix_routeTypeFromRouter];//This destination is routing from router
         if (!routeTypeFromRouter ||
             [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination ||
@@ -2198,13 +3349,14 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
         }
     }
     
-    [self ZIKViewRouter_hook_viewDidAppear:animated];
+    ZIX_HOOK_CALL_ORIGINAL([self ZIKViewRouter_hook_viewDidAppear:animated]);
     if (!routed) {
         [(UIViewController *)self setZix_routed:YES];
     }
 }
 
 - (void)ZIKViewRouter_hook_viewWillDisappear:(BOOL)animated {
+    ZIX_RECORD_PROFILED_HOOK(ViewWillDisappear);
     UIViewController *destination = (UIViewController *)self;
     if (destination.zix_removing == NO) {
         UIViewController *node = destination;
@@ -2221,30 +3373,32 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
                 node = node.parentViewController;
                 continue;
             }
-            if ([self conformsToProtocol:@protocol(ZIKRoutableView)]) {
-                [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteWillRemoveRouteNotification object:destination];
+            if (_isRoutableViewClass([self class])) {
+                _notifyRoutersOfDestination(destination, ZIKViewRouteEventWillRemoveRoute);
                 NSNumber *routeTypeFromRouter = [destination zix_routeTypeFromRouter];
                 if (!routeTypeFromRouter ||
                     [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination) {
                     [ZIKViewRouter AOP_notifyAll_router:nil willRemoveRouteOnDestination:destination fromSource:source];
                 }
             }
+            ZIX_HOOK_PROCESSED();
             [destination setZix_parentRemovingFrom:source];
             [destination setZix_removing:YES];
             break;
         }
     }
     
-    [self ZIKViewRouter_hook_viewWillDisappear:animated];
+    ZIX_HOOK_CALL_ORIGINAL([self ZIKViewRouter_hook_viewWillDisappear:animated]);
 }
 
 - (void)ZIKViewRouter_hook_viewDidDisappear:(BOOL)animated {
+    ZIX_RECORD_PROFILED_HOOK(ViewDidDisappear);
     UIViewController *destination = (UIViewController *)self;
     BOOL removing = destination.zix_removing;
-    if ([self conformsToProtocol:@protocol(ZIKRoutableView)]) {
+    if (_isRoutableViewClass([self class])) {
         if (removing) {
             UIViewController *source = destination.zix_parentRemovingFrom;
-            [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteDidRemoveRouteNotification object:destination];
+            _notifyRoutersOfDestination(destination, ZIKViewRouteEventDidRemoveRoute);
             NSNumber *routeTypeFromRouter = [destination zix_routeTypeFromRouter];
             if (!routeTypeFromRouter ||
                 [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination) {
@@ -2256,6 +3410,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
         }
     }
     if (removing) {
+        ZIX_HOOK_PROCESSED();
         [destination setZix_removing:NO];
         [destination setZix_routed:NO];
     } else if (zix_classIsCustomClass([destination class])) {
@@ -2276,12 +3431,12 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
             }
             
             [destination setZix_parentRemovingFrom:source];
-            [ZIKViewRouter notifyGlobalErrorWithRouter:nil action:ZIKRouteActionPerformRoute error:[ZIKViewRouter errorWithCode:ZIKViewRouteErrorUnbalancedTransition localizedDescriptionFormat:@"Unbalanced calls to begin/end appearance transitions for %@. This error occurs when you try and display a view controller before the current view controller is finished displaying. This may cause the UIViewController skips or messes up the order calling -viewWillAppear:, -viewDidAppear:, -viewWillDisAppear: and -viewDidDisappear:, and messes up the route state. Current error reason is already removed destination but destination appears again before -viewDidDisappear:, callStack:%@",self,[NSThread callStackSymbols]]];
+            [ZIKViewRouter notifyGlobalErrorWithRouter:nil action:ZIKRouteActionPerformRoute error:_reappearedDestinationError(self)];
             break;
         }
     }
     
-    [self ZIKViewRouter_hook_viewDidDisappear:animated];
+    ZIX_HOOK_CALL_ORIGINAL([self ZIKViewRouter_hook_viewDidDisappear:animated]);
 }
 
 #else
@@ -2289,12 +3444,14 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
 // Transition methods for Mac OS
 
 - (void)ZIKViewRouter_hook_presentViewController:(NSViewController *)viewController animator:(id <NSViewControllerPresentationAnimator>)animator {
+    ZIX_RECORD_HOOK(PresentViewController);
     zix_replaceMethodWithMethod([animator class], @selector(animatePresentationOfViewController:fromViewController:), [ZIKViewRouter class], @selector(ZIKViewRouter_hook_animatePresentationOfViewController:fromViewController:));
     zix_replaceMethodWithMethod([animator class], @selector(animateDismissalOfViewController:fromViewController:), [ZIKViewRouter class], @selector(ZIKViewRouter_hook_animateDismissalOfViewController:fromViewController:));
     [self ZIKViewRouter_hook_presentViewController:viewController animator:animator];
 }
 
 - (void)ZIKViewRouter_hook_animatePresentationOfViewController:(NSViewController *)viewController fromViewController:(NSViewController *)fromViewController {
+    ZIX_RECORD_HOOK(AnimatePresentation);
     NSArray<ZIKViewRouter *> *destinationViewRouters = viewController.zix_destinationViewRouters;
     if (destinationViewRouters) {
         //Auto created routers
@@ -2308,11 +3465,13 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
     [self ZIKViewRouter_hook_animatePresentationOfViewController:viewController fromViewController:fromViewController];
 }
 - (void)ZIKViewRouter_hook_animateDismissalOfViewController:(NSViewController *)viewController fromViewController:(NSViewController *)fromViewController {
+    ZIX_RECORD_HOOK(AnimateDismissal);
     [viewController setZix_parentRemovingFrom:fromViewController];
     [self ZIKViewRouter_hook_animateDismissalOfViewController:viewController fromViewController:fromViewController];
 }
 
 - (void)ZIKViewRouter_hook_setContentViewController:(NSViewController *)contentViewController {
+    ZIX_RECORD_HOOK(SetContentViewController);
     if (contentViewController) {
         NSArray<ZIKViewRouter *> *destinationViewRouters = contentViewController.zix_destinationViewRouters;
         if (destinationViewRouters) {
@@ -2325,6 +3484,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
         }
         
         NSWindow *window = (NSWindow *)self;
+        [g_routedWindows addObject:window];
         id parent = window.windowController;
         if (parent == nil) {
             parent = window;
@@ -2332,12 +3492,18 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
         if (contentViewController.zix_parentMovingTo == nil) {
             [contentViewController setZix_parentMovingTo:parent];
         }
+    } else {
+        [g_routedWindows removeObject:self];
     }
     [self ZIKViewRouter_hook_setContentViewController:contentViewController];
 }
 
 + (void)handleWindowWillCloseNotification:(NSNotification *)notification {
     NSWindow *window = (NSWindow *)notification.object;
+    // Skip panels, alerts and other windows whose content view controller was never set through the hook
+    if (![g_routedWindows containsObject:window]) {
+        return;
+    }
     NSViewController *contentViewController = window.contentViewController;
     if (contentViewController == nil) {
         return;
@@ -2352,21 +3518,24 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
 }
 
 - (void)ZIKViewRouter_hook_viewWillAppear {
-    [ZIKViewRouter tryToFinishWaitingViewRouters:NO];
+    ZIX_RECORD_PROFILED_HOOK(ViewWillAppear);
+    _finishWaitingViewRoutersIfNeeded((XXViewController *)self, NO);
     XXViewController *destination = (XXViewController *)self;
     BOOL removing = destination.zix_removing;
-    BOOL isRoutableView = ([self conformsToProtocol:@protocol(ZIKRoutableView)] == YES);
+    BOOL isRoutableView = _isRoutableViewClass([self class]);
     if (removing) {
+        ZIX_HOOK_PROCESSED();
         [destination setZix_removing:NO];
         if (isRoutableView) {
-            [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteRemoveRouteCancelledNotification object:destination];
+            _notifyRoutersOfDestination(destination, ZIKViewRouteEventRemoveRouteCancelled);
         }
     }
     if (isRoutableView) {
         BOOL routed = [(XXViewController *)self zix_routed];
         if (!routed) {
+            ZIX_HOOK_PROCESSED();
             id parentMovingTo = [(XXViewController *)self zix_parentMovingTo];
-            [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteWillPerformRouteNotification object:destination];
+            _notifyRoutersOfDestination(destination, ZIKViewRouteEventWillPerformRoute);
             NSNumber *routeTypeFromRouter = [destination zix_routeTypeFromRouter];
             if (!routeTypeFromRouter ||
                 [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination ||
@@ -2377,17 +3546,19 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
         }
     }
     
-    [self ZIKViewRouter_hook_viewWillAppear];
+    ZIX_HOOK_CALL_ORIGINAL([self ZIKViewRouter_hook_viewWillAppear]);
 }
 
 - (void)ZIKViewRouter_hook_viewDidAppear {
-    [ZIKViewRouter tryToFinishWaitingViewRouters:YES];
+    ZIX_RECORD_PROFILED_HOOK(ViewDidAppear);
+    _finishWaitingViewRoutersIfNeeded((XXViewController *)self, YES);
     BOOL routed = [(XXViewController *)self zix_routed];
     id parentMovingTo = [(XXViewController *)self zix_parentMovingTo];
     if (!routed &&
-        [self conformsToProtocol:@protocol(ZIKRoutableView)]) {
+        _isRoutableViewClass([self class])) {
         XXViewController *destination = (XXViewController *)self;
-        [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteDidPerformRouteNotification object:destination];
+        ZIX_HOOK_PROCESSED();
+        _notifyRoutersOfDestination(destination, ZIKViewRouteEventDidPerformRoute);
         NSNumber *routeTypeFromRouter = [destination zix_routeTypeFromRouter];//This destination is routing from router
         if (!routeTypeFromRouter ||
             [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination ||
@@ -2400,7 +3571,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
         }
     }
     
-    [self ZIKViewRouter_hook_viewDidAppear];
+    ZIX_HOOK_CALL_ORIGINAL([self ZIKViewRouter_hook_viewDidAppear]);
     if (!routed) {
         [(XXViewController *)self setZix_parentMovingTo:nil];
         [(XXViewController *)self setZix_routed:YES];
@@ -2408,6 +3579,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
 }
 
 - (void)ZIKViewRouter_hook_viewWillDisappear {
+    ZIX_RECORD_PROFILED_HOOK(ViewWillDisappear);
     XXViewController *destination = (XXViewController *)self;
     if (destination.zix_removing == NO) {
         XXViewController *node = destination;
@@ -2421,30 +3593,32 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
                 node = node.parentViewController;
                 continue;
             }
-            if ([self conformsToProtocol:@protocol(ZIKRoutableView)]) {
-                [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteWillRemoveRouteNotification object:destination];
+            if (_isRoutableViewClass([self class])) {
+                _notifyRoutersOfDestination(destination, ZIKViewRouteEventWillRemoveRoute);
                 NSNumber *routeTypeFromRouter = [destination zix_routeTypeFromRouter];
                 if (!routeTypeFromRouter ||
                     [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination) {
                     [ZIKViewRouter AOP_notifyAll_router:nil willRemoveRouteOnDestination:destination fromSource:source];
                 }
             }
+            ZIX_HOOK_PROCESSED();
             [destination setZix_parentRemovingFrom:source];
             [destination setZix_removing:YES];
             break;
         }
     }
     
-    [self ZIKViewRouter_hook_viewWillDisappear];
+    ZIX_HOOK_CALL_ORIGINAL([self ZIKViewRouter_hook_viewWillDisappear]);
 }
 
 - (void)ZIKViewRouter_hook_viewDidDisappear {
+    ZIX_RECORD_PROFILED_HOOK(ViewDidDisappear);
     XXViewController *destination = (XXViewController *)self;
     BOOL removing = destination.zix_removing;
-    if ([self conformsToProtocol:@protocol(ZIKRoutableView)]) {
+    if (_isRoutableViewClass([self class])) {
         if (removing) {
             id source = destination.zix_parentRemovingFrom;
-            [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteDidRemoveRouteNotification object:destination];
+            _notifyRoutersOfDestination(destination, ZIKViewRouteEventDidRemoveRoute);
             NSNumber *routeTypeFromRouter = [destination zix_routeTypeFromRouter];
             if (!routeTypeFromRouter ||
                 [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination) {
@@ -2456,6 +3630,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
         }
     }
     if (removing) {
+        ZIX_HOOK_PROCESSED();
         [destination setZix_parentRemovingFrom:nil];
         [destination setZix_removing:NO];
         [destination setZix_routed:NO];
@@ -2474,12 +3649,12 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
             }
             
             [destination setZix_parentRemovingFrom:source];
-            [ZIKViewRouter notifyGlobalErrorWithRouter:nil action:ZIKRouteActionPerformRoute error:[ZIKViewRouter errorWithCode:ZIKViewRouteErrorUnbalancedTransition localizedDescriptionFormat:@"Unbalanced calls to begin/end appearance transitions for %@. This error occurs when you try and display a view controller before the current view controller is finished displaying. This may cause the UIViewController skips or messes up the order calling -viewWillAppear:, -viewDidAppear:, -viewWillDisAppear: and -viewDidDisappear:, and messes up the route state. Current error reason is already removed destination but destination appears again before -viewDidDisappear:, callStack:%@",self,[NSThread callStackSymbols]]];
+            [ZIKViewRouter notifyGlobalErrorWithRouter:nil action:ZIKRouteActionPerformRoute error:_reappearedDestinationError(self)];
             break;
         }
     }
     
-    [self ZIKViewRouter_hook_viewDidDisappear];
+    ZIX_HOOK_CALL_ORIGINAL([self ZIKViewRouter_hook_viewDidDisappear]);
 }
 
 #endif
@@ -2489,98 +3664,166 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
  So we have to make sure routable UIView is prepared before -viewDidLoad if it's added to the superview when superview is not on screen yet.
  */
 - (void)ZIKViewRouter_hook_viewDidLoad {
+    ZIX_RECORD_PROFILED_HOOK(ViewDidLoad);
     NSAssert([NSThread isMainThread], @"UI thread must be main thread.");
-    [self ZIKViewRouter_hook_viewDidLoad];
+    ZIX_HOOK_CALL_ORIGINAL([self ZIKViewRouter_hook_viewDidLoad]);
     
-    [ZIKViewRouter tryToPrepareWaitingViewRouters];
+    if (CFDictionaryGetCount(g_preparingXXViewRouters) > 0) {
+        ZIX_HOOK_PROCESSED();
+        [ZIKViewRouter tryToPrepareWaitingViewRoutersInView:[(XXViewController *)self view]];
+    }
 }
 
-+ (void)tryToPrepareWaitingViewRouters {
-    //Find performer and prepare for destination added to a superview not on screen in -ZIKViewRouter_hook_willMoveToSuperview
-    NSMutableSet *preparingRouters = g_preparingXXViewRouters;
-    
-    __block NSMutableSet *preparedRouters;
-    if (preparingRouters.count > 0) {
-        [preparingRouters enumerateObjectsUsingBlock:^(ZIKViewRouter *router, BOOL * _Nonnull stop) {
-            XXView *destination = router.destination;
-            NSAssert([destination isKindOfClass:[XXView class]], @"Only UIView destination need fix.");
-            id performer = [destination zix_routePerformer];
-            if (performer) {
-                [ZIKViewRouter _prepareDestinationFromExternal:destination router:router performer:performer];
-                router.prepared = YES;
-                if ([destination respondsToSelector:@selector(zix_routeTypeFromRouter)]) {
-                    NSNumber *routeTypeFromRouter = destination.zix_routeTypeFromRouter;
-                    [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteWillPerformRouteNotification object:destination];
-                    if (!routeTypeFromRouter ||
-                        [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination) {
-                        [ZIKViewRouter AOP_notifyAll_router:router willPerformRouteOnDestination:destination fromSource:router.original_configuration.source];
-                    }
-                }
-                
-                if (!preparedRouters) {
-                    preparedRouters = [NSMutableSet set];
-                }
-                [preparedRouters addObject:router];
-            }
-        }];
-        if (preparedRouters.count > 0) {
-            [preparingRouters minusSet:preparedRouters];
+static void _appendWaitingViewRouters(CFDictionaryRef routers, NSMutableArray<ZIKViewRouter *> *waitingRouters, NSPointerArray *keyPointers) {
+    CFIndex count = CFDictionaryGetCount(routers);
+    const void **keys = malloc(sizeof(void *) * count);
+    const void **values = malloc(sizeof(void *) * count);
+    CFDictionaryGetKeysAndValues(routers, keys, values);
+    for (CFIndex i = 0; i < count; i++) {
+        [waitingRouters addObject:(__bridge ZIKViewRouter *)values[i]];
+        [keyPointers addPointer:(void *)keys[i]];
+    }
+    free(keys);
+    free(values);
+}
+
+/// Copy waiting routers, so they can be removed when enumerating. Keys are returned in `destinations`, only for comparing pointers.
+static NSArray<ZIKViewRouter *> *_waitingViewRouters(CFDictionaryRef routers, NSPointerArray **destinations) {
+    NSMutableArray<ZIKViewRouter *> *waitingRouters = [NSMutableArray arrayWithCapacity:CFDictionaryGetCount(routers)];
+    NSPointerArray *keyPointers = [NSPointerArray pointerArrayWithOptions:NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality];
+    _appendWaitingViewRouters(routers, waitingRouters, keyPointers);
+    *destinations = keyPointers;
+    return waitingRouters;
+}
+
+/// Move orphaned routers with living destination to the group of destination's current root, so hierarchies in other windows and scenes don't check them again. Only routers whose destination was dealloced stay orphaned.
+static void _adoptOrphanedWaitingViewRouters(void) {
+    CFIndex count = CFDictionaryGetCount(g_orphanedWaitingViewRouters);
+    const void **keys = malloc(sizeof(void *) * count);
+    const void **values = malloc(sizeof(void *) * count);
+    CFDictionaryGetKeysAndValues(g_orphanedWaitingViewRouters, keys, values);
+    for (CFIndex i = 0; i < count; i++) {
+        ZIKViewRouter *router = (__bridge ZIKViewRouter *)values[i];
+        XXView *destination = router.destination;
+        if (destination == nil) {
+            continue;
         }
+        // router is retained by the local variable when it's removed from orphans
+        CFDictionaryRemoveValue(g_orphanedWaitingViewRouters, keys[i]);
+        _groupWaitingViewRouter(_waitingViewRouterGroupOfRoot(_rootViewOfView(destination), YES), router, keys[i]);
     }
+    free(keys);
+    free(values);
 }
 
-// Some private system view won't call -willMoveToWindow: and -didMoveToWindow. Finish them with this.
-+ (void)tryToFinishWaitingViewRouters:(BOOL)finishWhenHasWindow {
-    NSMutableSet *finishingRouters = g_finishingXXViewRouters;
-    __block NSMutableSet *finishedRouters;
-    if (finishingRouters.count > 0) {
-        [finishingRouters enumerateObjectsUsingBlock:^(ZIKViewRouter *router, BOOL * _Nonnull stop) {
-            XXView *destination = router.destination;
-            if (router.prepared == NO) {
-                return;
-            }
-            if (!destination.window) {
-                if (!finishWhenHasWindow) {
-                    return;
+/// Copy finishing routers may have destination in `view`: routers in the same hierarchy, and orphaned routers. Return all finishing routers when `view` is nil.
+static NSArray<ZIKViewRouter *> *_finishingViewRoutersInView(XXView *view, NSPointerArray **destinations) {
+    if (view == nil) {
+        return _waitingViewRouters(g_finishingXXViewRouters, destinations);
+    }
+    if (CFDictionaryGetCount(g_orphanedWaitingViewRouters) > 0) {
+        _adoptOrphanedWaitingViewRouters();
+    }
+    ZIKWaitingViewRouterGroup *group = _waitingViewRouterGroupOfRoot(_rootViewOfView(view), NO);
+    NSMutableArray<ZIKViewRouter *> *waitingRouters = [NSMutableArray array];
+    NSPointerArray *keyPointers = [NSPointerArray pointerArrayWithOptions:NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality];
+    if (group) {
+        _appendWaitingViewRouters(group->_routers, waitingRouters, keyPointers);
+    }
+    if (CFDictionaryGetCount(g_orphanedWaitingViewRouters) > 0) {
+        _appendWaitingViewRouters(g_orphanedWaitingViewRouters, waitingRouters, keyPointers);
+    }
+    *destinations = keyPointers;
+    return waitingRouters;
+}
+
+static void _removeWaitingViewRouterForKey(CFMutableDictionaryRef routers, ZIKViewRouter *router, const void *key) {
+    if (CFDictionaryGetValue(routers, key) == (__bridge const void *)router) {
+        zix_incrementRouterCounter(ZIKRouterCounterWaitingRouterDrained);
+        CFDictionaryRemoveValue(routers, key);
+        if (routers == g_finishingXXViewRouters) {
+            _ungroupWaitingViewRouter(key);
+        }
+    }
+}
+
++ (void)tryToPrepareWaitingViewRoutersInView:(XXView *)view {
+    //Find performer and prepare for destination added to a superview not on screen in -ZIKViewRouter_hook_willMoveToSuperview
+    zix_incrementRouterCounter(ZIKRouterCounterWaitingRouterDrain);
+    NSPointerArray *destinations;
+    NSArray<ZIKViewRouter *> *preparingRouters = _waitingViewRouters(g_preparingXXViewRouters, &destinations);
+    [preparingRouters enumerateObjectsUsingBlock:^(ZIKViewRouter *router, NSUInteger idx, BOOL * _Nonnull stop) {
+        const void *key = [destinations pointerAtIndex:idx];
+        XXView *destination = router.destination;
+        if (destination == nil) {
+            _removeWaitingViewRouterForKey(g_preparingXXViewRouters, router, key);
+            return;
+        }
+        NSAssert([destination isKindOfClass:[XXView class]], @"Only UIView destination need fix.");
+        if (view == nil || ![destination isDescendantOfView:view]) {
+            return;
+        }
+        id performer = [destination zix_routePerformer];
+        if (performer) {
+            _removeWaitingViewRouterForKey(g_preparingXXViewRouters, router, key);
+            [ZIKViewRouter _prepareDestinationFromExternal:destination router:router performer:performer];
+            router.prepared = YES;
+            if ([destination respondsToSelector:@selector(zix_routeTypeFromRouter)]) {
+                NSNumber *routeTypeFromRouter = destination.zix_routeTypeFromRouter;
+                _notifyRoutersOfDestination(destination, ZIKViewRouteEventWillPerformRoute);
+                if (!routeTypeFromRouter ||
+                    [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination) {
+                    [ZIKViewRouter AOP_notifyAll_router:router willPerformRouteOnDestination:destination fromSource:router.original_configuration.source];
                 }
             }
-            ZIKViewRouter *destinationViewRouter = destination.zix_destinationViewRouter;
-            if (destinationViewRouter == router) {
-                destination.zix_destinationViewRouter = nil;
-            }
-            if (!finishedRouters) {
-                finishedRouters = [NSMutableSet set];
-            }
-            ZIKRouterState state = router.state;
-            if (state == ZIKRouterStateRouted || state == ZIKRouterStateRemoved) {
-                [finishedRouters addObject:router];
+        }
+    }];
+}
+
+// Some private system view won't call -willMoveToWindow: and -didMoveToWindow. Finish them with this when view controller containing them appears.
++ (void)tryToFinishWaitingViewRoutersInView:(XXView *)view finishWhenHasWindow:(BOOL)finishWhenHasWindow {
+    zix_incrementRouterCounter(ZIKRouterCounterWaitingRouterDrain);
+    NSPointerArray *destinations;
+    NSArray<ZIKViewRouter *> *finishingRouters = _finishingViewRoutersInView(view, &destinations);
+    [finishingRouters enumerateObjectsUsingBlock:^(ZIKViewRouter *router, NSUInteger idx, BOOL * _Nonnull stop) {
+        const void *key = [destinations pointerAtIndex:idx];
+        XXView *destination = router.destination;
+        if (destination && (view == nil || ![destination isDescendantOfView:view])) {
+            return;
+        }
+        if (router.prepared == NO && destination) {
+            return;
+        }
+        if (!destination.window) {
+            if (!finishWhenHasWindow && destination) {
                 return;
             }
-            if (state == ZIKRouterStateRouting) {
-                [finishedRouters addObject:router];
-                if (destination == nil) {
-                    [router endPerformRouteWithError:[ZIKViewRouter routeErrorWithCode:ZIKRouteErrorActionFailed localizedDescription:@"Destination was dealloced when performing route."]];
-                    return;
-                }
-                [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteDidPerformRouteNotification object:destination];
-                [router endPerformRouteWithSuccess];
+        }
+        ZIKViewRouter *destinationViewRouter = destination.zix_destinationViewRouter;
+        if (destinationViewRouter == router) {
+            destination.zix_destinationViewRouter = nil;
+        }
+        _removeWaitingViewRouterForKey(g_finishingXXViewRouters, router, key);
+        ZIKRouterState state = router.state;
+        if (state == ZIKRouterStateRouting) {
+            if (destination == nil) {
+                [router endPerformRouteWithError:[ZIKViewRouter routeErrorWithCode:ZIKRouteErrorActionFailed localizedDescription:@"Destination was dealloced when performing route."]];
                 return;
             }
-            if (state == ZIKRouterStateRemoving) {
-                [finishedRouters addObject:router];
-                if (destination == nil) {
-                    [router endRemoveRouteWithError:[ZIKViewRouter routeErrorWithCode:ZIKRouteErrorActionFailed localizedDescription:@"Destination was dealloced when removing route."]];
-                    return;
-                }
-                [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteDidRemoveRouteNotification object:destination];
-                [router endRemoveRouteWithSuccessOnDestination:destination fromSource:destination.superview];
+            _notifyRoutersOfDestination(destination, ZIKViewRouteEventDidPerformRoute);
+            [router endPerformRouteWithSuccess];
+            return;
+        }
+        if (state == ZIKRouterStateRemoving) {
+            if (destination == nil) {
+                [router endRemoveRouteWithError:[ZIKViewRouter routeErrorWithCode:ZIKRouteErrorActionFailed localizedDescription:@"Destination was dealloced when removing route."]];
                 return;
             }
-        }];
-        if (finishedRouters.count > 0) {
-            [finishingRouters minusSet:finishedRouters];
+            _notifyRoutersOfDestination(destination, ZIKViewRouteEventDidRemoveRoute);
+            [router endRemoveRouteWithSuccessOnDestination:destination fromSource:destination.superview];
+            return;
         }
-    }
+    }];
 }
 
 /// Add subview by code or storyboard will auto create a corresponding router. We assume its superview's view controller is the performer. If your custom class view uses a routable view as its part, the custom view should use a router to add and prepare the routable view, then the routable view doesn't need to search performer.
@@ -2702,13 +3945,20 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
 - (void)ZIKViewRouter_hook_willMoveToSuperview:(nullable NSView *)newSuperview
 #endif
 {
+    ZIX_RECORD_PROFILED_HOOK(WillMoveToSuperview);
+    zix_invalidateRoutePerformers();
     XXView *destination = (XXView *)self;
     if (!newSuperview) {
         destination.zix_removing = YES;
     }
-    if ([self conformsToProtocol:@protocol(ZIKRoutableView)]) {
+    if (CFDictionaryGetCount(g_waitingViewRouterGroups) > 0) {
+        ZIX_HOOK_PROCESSED();
+        _regroupWaitingViewRoutersForMovingView(destination, newSuperview);
+    }
+    if (_isRoutableViewClass([self class])) {
         if (!newSuperview) {
             //Removing from superview
+            ZIX_HOOK_PROCESSED();
             NSNumber *routeTypeFromRouter = [destination zix_routeTypeFromRouter];
             ZIKViewRouter *destinationRouter = [destination zix_destinationViewRouter];
             BOOL alreadyRemoved = NO;
@@ -2716,7 +3966,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
             if (!routeTypeFromRouter && destinationRouter) {
                 //Destination's superview never be added to a view controller, so destination is never on a window
                 if (destinationRouter.state == ZIKRouterStateRouting) {
-                    [g_finishingXXViewRouters removeObject:destinationRouter];
+                    _removeWaitingViewRouter(g_finishingXXViewRouters, destinationRouter, destination);
                     if (destinationRouter.prepared == NO) {
                         shouldNotifyWillRemove = NO;
                         [destinationRouter prepareDestinationForPerforming];
@@ -2724,20 +3974,20 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
                         //Didn't find the performer of UIView until it's removing from superview, maybe its superview was never added to any view controller
                         NSString *description = [NSString stringWithFormat:@"Didn't find the performer of UIView until it's removing from superview, maybe its superview was never added to any view controller. Can't find which custom UIView or UIViewController added destination:(%@) as subview, so we can't notify the performer to config the destination. You may add destination to an UIWindow in code directly, and the UIWindow is not a custom class. Please change your code and add subview by a custom view router with ZIKViewRouteTypeAddAsSubview. Destination superview: (%@).",destination, newSuperview];
                         [destinationRouter endPerformRouteWithError:[ZIKViewRouter errorWithCode:ZIKViewRouteErrorInvalidPerformer localizedDescription:description]];
-                        [g_preparingXXViewRouters removeObject:destinationRouter];
+                        _removeWaitingViewRouter(g_preparingXXViewRouters, destinationRouter, destination);
                     } else {
                         //end perform
-                        [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteDidPerformRouteNotification object:destination];
+                        _notifyRoutersOfDestination(destination, ZIKViewRouteEventDidPerformRoute);
                         [destinationRouter endPerformRouteWithSuccess];
                     }
                 } else if (destinationRouter.state == ZIKRouterStateRemoved) {
-                    // Already finish removing in +tryToFinishWaitingViewRouters
+                    // Already finish removing in +tryToFinishWaitingViewRoutersInView:finishWhenHasWindow:
                     alreadyRemoved = YES;
                     destination.zix_destinationViewRouter = nil;
                 }
             }
             if (!alreadyRemoved && (routeTypeFromRouter || shouldNotifyWillRemove)) {
-                [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteWillRemoveRouteNotification object:destination];
+                _notifyRoutersOfDestination(destination, ZIKViewRouteEventWillRemoveRoute);
                 if (!routeTypeFromRouter ||
                     [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination) {
                     [ZIKViewRouter AOP_notifyAll_router:destinationRouter willRemoveRouteOnDestination:destination fromSource:destination.superview];
@@ -2746,6 +3996,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
             
         } else if (!destination.zix_routed) {
             // First time adding to a superview
+            ZIX_HOOK_PROCESSED();
             ZIKViewRouter *router;
             BOOL alreadyPerformed = NO;
             BOOL shouldNotifyWillPerform = NO;
@@ -2754,7 +4005,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
                 //Not routing from router
                 ZIKViewRouter *destinationRouter = [destination zix_destinationViewRouter];
                 if (destinationRouter && destinationRouter.state == ZIKRouterStateRouted) {
-                    // Already finish performing in +tryToFinishWaitingViewRouters
+                    // Already finish performing in +tryToFinishWaitingViewRoutersInView:finishWhenHasWindow:
                     alreadyPerformed = YES;
                 }
                 if (!destinationRouter) {
@@ -2762,13 +4013,13 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
                     ZIKViewRouterType *routerType = _routerTypeToRegisteredView([destination class]);
                     NSAssert([routerType _validateSupportedRouteTypesForXXView], @"Router for UIView only supports ZIKViewRouteTypeAddAsSubview, ZIKViewRouteTypeMakeDestination and ZIKViewRouteTypeCustom, override +supportedRouteTypes in your router.");
                     shouldNotifyWillPerform = YES;
-                    if ([routerType shouldAutoCreateForDestination:destination fromSource:newSuperview]) {
+                    if (_routerTypeShouldAutoCreate(routerType, destination, newSuperview)) {
                         destinationRouter = [routerType routerFromView:destination source:newSuperview];
                         if (destinationRouter) {
                             destinationRouter.routingFromInternal = YES;
                             [destinationRouter notifyRouteState:ZIKRouterStateRouting];
                             [destination setZix_destinationViewRouter:destinationRouter];
-                            [g_finishingXXViewRouters addObject:destinationRouter];// Finish in didMoveToWindow or view did appear
+                            _addWaitingViewRouter(g_finishingXXViewRouters, destinationRouter, destination, newSuperview);// Finish in didMoveToWindow or view did appear
                         }
                     }
                 }
@@ -2803,11 +4054,11 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
             }
             
             if (!alreadyPerformed && (routeTypeFromRouter || shouldNotifyWillPerform)) {
-                [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteWillPerformRouteNotification object:destination];
+                _notifyRoutersOfDestination(destination, ZIKViewRouteEventWillPerformRoute);
                 NSNumber *routeTypeFromRouter = [destination zix_routeTypeFromRouter];
                 if (!routeTypeFromRouter ||
                     [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination) {
-                    [ZIKViewRouter AOP_notifyAll_router:router willPerformRouteOnDestination:destination fromSource:newSuperview];
+                    _notifySubviewAOPWillPerform(router, destination, newSuperview);
                 }
             }
         }
@@ -2817,22 +4068,25 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
         destination.zix_routed = NO;
     }
     
-    [self ZIKViewRouter_hook_willMoveToSuperview:newSuperview];
+    ZIX_HOOK_CALL_ORIGINAL([self ZIKViewRouter_hook_willMoveToSuperview:newSuperview]);
 }
 
 - (void)ZIKViewRouter_hook_didMoveToSuperview {
+    ZIX_RECORD_PROFILED_HOOK(DidMoveToSuperview);
+    zix_invalidateRoutePerformers();
     XXView *destination = (XXView *)self;
     XXView *superview = destination.superview;
-    if ([self conformsToProtocol:@protocol(ZIKRoutableView)]) {
+    if (_isRoutableViewClass([self class])) {
         NSNumber *routeTypeFromRouter = [destination zix_routeTypeFromRouter];
         if (!superview) {
+            ZIX_HOOK_PROCESSED();
             BOOL alreadyRemoved = NO;
             ZIKViewRouter *destinationRouter = destination.zix_destinationViewRouter;
             if (destinationRouter) {
-                [g_finishingXXViewRouters removeObject:destinationRouter];
+                _removeWaitingViewRouter(g_finishingXXViewRouters, destinationRouter, destination);
                 destination.zix_destinationViewRouter = nil;
                 if (destinationRouter.state == ZIKRouterStateRemoved) {
-                    // Already finish removing in +tryToFinishWaitingViewRouters
+                    // Already finish removing in +tryToFinishWaitingViewRoutersInView:finishWhenHasWindow:
                     alreadyRemoved = YES;
                 }
             }
@@ -2843,7 +4097,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
             }
 #endif
             if (!alreadyRemoved) {
-                [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteDidRemoveRouteNotification object:destination];
+                _notifyRoutersOfDestination(destination, ZIKViewRouteEventDidRemoveRoute);
                 if (!routeTypeFromRouter ||
                     [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination) {
                     
@@ -2871,7 +4125,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
         destination.zix_removing = NO;
     }
     
-    [self ZIKViewRouter_hook_didMoveToSuperview];
+    ZIX_HOOK_CALL_ORIGINAL([self ZIKViewRouter_hook_didMoveToSuperview]);
 }
 
 #if ZIK_HAS_UIKIT
@@ -2880,11 +4134,14 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
 - (void)ZIKViewRouter_hook_willMoveToWindow:(nullable NSWindow *)newWindow
 #endif
 {
+    ZIX_RECORD_PROFILED_HOOK(WillMoveToWindow);
+    zix_invalidateRoutePerformers();
     XXView *destination = (XXView *)self;
-    BOOL routed = destination.zix_routed;
-    BOOL removing = destination.zix_removing;
-    if ([self conformsToProtocol:@protocol(ZIKRoutableView)]) {
+    if (_isRoutableViewClass([self class])) {
+        BOOL routed = destination.zix_routed;
+        BOOL removing = destination.zix_removing;
         if (!routed && !removing) {
+            ZIX_HOOK_PROCESSED();
             ZIKViewRouter *router;
             XXView *source;
             NSNumber *routeTypeFromRouter = [destination zix_routeTypeFromRouter];
@@ -2894,7 +4151,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
                 // Not performed from router
                 ZIKViewRouter *destinationRouter = [destination zix_destinationViewRouter];
                 if (destinationRouter && destinationRouter.state == ZIKRouterStateRouted) {
-                    // Already finish performing in +tryToFinishWaitingViewRouters
+                    // Already finish performing in +tryToFinishWaitingViewRoutersInView:finishWhenHasWindow:
                     alreadyPerformed = YES;
                 }
                 // Was added to a superview when superview was not on screen, and it's displayed now.
@@ -2906,14 +4163,14 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
                         ZIKViewRouterType *routerType = _routerTypeToRegisteredView([destination class]);
                         if (routerType) {
                             NSAssert([routerType _validateSupportedRouteTypesForXXView], @"Router for UIView only supports ZIKViewRouteTypeAddAsSubview, ZIKViewRouteTypeMakeDestination and ZIKViewRouteTypeCustom, override +supportedRouteTypes in your router.");
-                            if ([routerType shouldAutoCreateForDestination:destination fromSource:source]) {
+                            if (_routerTypeShouldAutoCreate(routerType, destination, source)) {
                                 shouldNotifyWillPerform = YES;
                                 destinationRouter = [routerType routerFromView:destination source:source];
                                 if (destinationRouter) {
                                     destinationRouter.routingFromInternal = YES;
                                     [destinationRouter notifyRouteState:ZIKRouterStateRouting];
                                     [destination setZix_destinationViewRouter:destinationRouter];
-                                    [g_finishingXXViewRouters addObject:destinationRouter];// Finish in didMoveToWindow or view did appear
+                                    _addWaitingViewRouter(g_finishingXXViewRouters, destinationRouter, destination, destination.superview);// Finish in didMoveToWindow or view did appear
                                 }
                             }
                         }
@@ -2929,7 +4186,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
                                     NSAssert(zix_classIsCustomClass(performer), @"performer should be a subclass of UIViewController in your project.");
                                     [ZIKViewRouter _prepareDestinationFromExternal:destination router:destinationRouter performer:performer];
                                     destinationRouter.prepared = YES;
-                                    [g_preparingXXViewRouters removeObject:destinationRouter];
+                                    _removeWaitingViewRouter(g_preparingXXViewRouters, destinationRouter, destination);
                                 } else {
                                     shouldNotifyWillPerform = NO;
                                 }
@@ -2940,7 +4197,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
                             [destinationRouter prepareDestinationForPerforming];
                             destinationRouter.prepared = YES;
                             shouldNotifyWillPerform = YES;
-                            [g_preparingXXViewRouters removeObject:destinationRouter];
+                            _removeWaitingViewRouter(g_preparingXXViewRouters, destinationRouter, destination);
                         }
                     }
                     router = destinationRouter;
@@ -2949,25 +4206,28 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
             
             //Was added to a superview when superview was not on screen, and it's displayed now.
             if (!routed && source && !alreadyPerformed && shouldNotifyWillPerform) {
-                [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteWillPerformRouteNotification object:destination];
+                _notifyRoutersOfDestination(destination, ZIKViewRouteEventWillPerformRoute);
                 if (!routeTypeFromRouter ||
                     [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination) {
-                    [ZIKViewRouter AOP_notifyAll_router:router willPerformRouteOnDestination:destination fromSource:source];
+                    _notifySubviewAOPWillPerform(router, destination, source);
                 }
             }
         }
     }
     
-    [self ZIKViewRouter_hook_willMoveToWindow:newWindow];
+    ZIX_HOOK_CALL_ORIGINAL([self ZIKViewRouter_hook_willMoveToWindow:newWindow]);
 }
 
 - (void)ZIKViewRouter_hook_didMoveToWindow {
+    ZIX_RECORD_PROFILED_HOOK(DidMoveToWindow);
+    zix_invalidateRoutePerformers();
     XXView *destination = (XXView *)self;
     XXWindow *window = destination.window;
     BOOL routed = destination.zix_routed;
-    BOOL removing = destination.zix_removing;
-    if ([self conformsToProtocol:@protocol(ZIKRoutableView)]) {
+    if (_isRoutableViewClass([self class])) {
+        BOOL removing = destination.zix_removing;
         if (!routed && !removing) {
+            ZIX_HOOK_PROCESSED();
             ZIKViewRouter *router;
             BOOL alreadyPerformed = NO;
             NSNumber *routeTypeFromRouter = [destination zix_routeTypeFromRouter];
@@ -2986,7 +4246,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
                 }
                 ZIKViewRouter *destinationRouter = destination.zix_destinationViewRouter;
                 if (destinationRouter && destinationRouter.state == ZIKRouterStateRouted) {
-                    // Already finish performing in +tryToFinishWaitingViewRouters
+                    // Already finish performing in +tryToFinishWaitingViewRoutersInView:finishWhenHasWindow:
                     alreadyPerformed = YES;
                 }
                 if (!destinationRouter) {
@@ -2996,14 +4256,14 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
                         ZIKViewRouterType *routerType = _routerTypeToRegisteredView([destination class]);
                         if (routerType) {
                             NSAssert([routerType _validateSupportedRouteTypesForXXView], @"Router for UIView only supports ZIKViewRouteTypeAddAsSubview, ZIKViewRouteTypeMakeDestination and ZIKViewRouteTypeCustom, override +supportedRouteTypes in your router.");
-                            if ([routerType shouldAutoCreateForDestination:destination fromSource:source]) {
+                            if (_routerTypeShouldAutoCreate(routerType, destination, source)) {
                                 shouldNotifyWillPerform = YES;
                                 destinationRouter = [routerType routerFromView:destination source:source];
                                 if (destinationRouter) {
                                     destinationRouter.routingFromInternal = YES;
                                     [destinationRouter notifyRouteState:ZIKRouterStateRouting];
                                     [destination setZix_destinationViewRouter:destinationRouter];
-                                    [g_finishingXXViewRouters addObject:destinationRouter];
+                                    _addWaitingViewRouter(g_finishingXXViewRouters, destinationRouter, destination, destination.superview);
                                 }
                             }
                         }
@@ -3034,23 +4294,23 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
                         [destinationRouter prepareDestinationForPerforming];
                         destinationRouter.prepared = YES;
                     }
-                    [g_preparingXXViewRouters removeObject:destinationRouter];
+                    _removeWaitingViewRouter(g_preparingXXViewRouters, destinationRouter, destination);
                 }
                 
                 if (!alreadyPerformed && shouldNotifyWillPerform) {
-                    [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteWillPerformRouteNotification object:destination];
+                    _notifyRoutersOfDestination(destination, ZIKViewRouteEventWillPerformRoute);
                     if (!routeTypeFromRouter ||
                         [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination) {
-                        [ZIKViewRouter AOP_notifyAll_router:router willPerformRouteOnDestination:destination fromSource:source];
+                        _notifySubviewAOPWillPerform(router, destination, source);
                     }
                 }
             }
             
             if (router) {
-                [g_finishingXXViewRouters removeObject:router];
+                _removeWaitingViewRouter(g_finishingXXViewRouters, router, destination);
             }
             if (!alreadyPerformed) {
-                [[NSNotificationCenter defaultCenter] postNotificationName:kZIKViewRouteDidPerformRouteNotification object:destination];
+                _notifyRoutersOfDestination(destination, ZIKViewRouteEventDidPerformRoute);
                 BOOL notifyAOP = NO;
                 if (!routeTypeFromRouter ||
                     [routeTypeFromRouter integerValue] == ZIKViewRouteTypeMakeDestination) {
@@ -3058,14 +4318,17 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
                 }
                 //end perform
                 if (router) {
-                    if (notifyAOP) {
+                    if (notifyAOP && !g_coalescesSubviewAOPCallbacks) {
                         [router endPerformRouteWithSuccess];
                     } else {
                         [router endPerformRouteWithSuccessWithAOP:NO];
+                        if (notifyAOP) {
+                            _notifySubviewAOPDidPerform(router, destination, router.original_configuration.source);
+                        }
                     }
                     destination.zix_destinationViewRouter = nil;
                 } else if (notifyAOP) {
-                    [ZIKViewRouter AOP_notifyAll_router:nil didPerformRouteOnDestination:destination fromSource:destination.superview];
+                    _notifySubviewAOPDidPerform(nil, destination, destination.superview);
                 }
             }
             
@@ -3077,7 +4340,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
         }
     }
     
-    [self ZIKViewRouter_hook_didMoveToWindow];
+    ZIX_HOOK_CALL_ORIGINAL([self ZIKViewRouter_hook_didMoveToWindow]);
     if (!routed && window) {
         destination.zix_routed = YES;
     }
@@ -3090,6 +4353,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
 - (nullable __kindof NSViewController *)ZIKViewRouter_hook_instantiateInitialViewController
 #endif
 {
+    ZIX_RECORD_HOOK(InstantiateInitialViewController);
     id initialViewController = [self ZIKViewRouter_hook_instantiateInitialViewController];
     XXViewController *parentViewController = initialViewController;
     NSMutableArray<XXViewController *> *routableViews;
@@ -3098,27 +4362,65 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
         parentViewController = [(NSWindowController *)parentViewController contentViewController];
     }
 #endif
+    if (parentViewController == nil) {
+        return initialViewController;
+    }
+    NSString *storyboardKey = objc_getAssociatedObject(self, &kStoryboardKey);
+    ZIKStoryboardScenePlan *plan = storyboardKey ? g_storyboardScenePlans[storyboardKey] : nil;
+    if (plan && (plan->_initialClass != [parentViewController class] ||
+                 plan->_generation != __atomic_load_n(&g_storyboardScenePlansGeneration, __ATOMIC_RELAXED))) {
+        plan = nil;
+    }
     if ([parentViewController conformsToProtocol:@protocol(ZIKRoutableView)]) {
         routableViews = [NSMutableArray arrayWithObject:parentViewController];
     }
-    NSArray<XXViewController *> *childViews = [ZIKViewRouter routableViewsInParentViewController:parentViewController];
-    if (childViews.count > 0) {
-        if (routableViews == nil) {
-            routableViews = [NSMutableArray array];
+    if (plan == nil || plan->_hasRoutableChildren) {
+        NSArray<XXViewController *> *childViews = [ZIKViewRouter routableViewsInParentViewController:parentViewController];
+        if (childViews.count > 0) {
+            if (routableViews == nil) {
+                routableViews = [NSMutableArray array];
+            }
+            [routableViews addObjectsFromArray:childViews];
         }
-        [routableViews addObjectsFromArray:childViews];
     }
-    for (XXViewController *destination in routableViews) {
-        ZIKViewRouterType *routerType = _routerTypeToRegisteredView([destination class]);
-        if (routerType) {
-            if (destination != parentViewController && ![routerType shouldAutoCreateForDestination:destination fromSource:parentViewController]) {
-                continue;
+    NSArray *routerTypes = plan ? plan->_routerTypes : nil;
+    if (plan && plan->_destinationClasses.count != routableViews.count) {
+        routerTypes = nil;
+    }
+    for (NSUInteger i = 0; routerTypes && i < routableViews.count; i++) {
+        if ([routableViews[i] class] != plan->_destinationClasses[i]) {
+            routerTypes = nil;
+        }
+    }
+    if (routerTypes == nil) {
+        NSMutableArray *resolvedRouterTypes = [NSMutableArray arrayWithCapacity:routableViews.count];
+        NSMutableArray<Class> *destinationClasses = [NSMutableArray arrayWithCapacity:routableViews.count];
+        for (XXViewController *destination in routableViews) {
+            [destinationClasses addObject:[destination class]];
+            [resolvedRouterTypes addObject:_routerTypeToRegisteredView([destination class]) ?: [NSNull null]];
+        }
+        routerTypes = resolvedRouterTypes;
+        if (storyboardKey) {
+            plan = [ZIKStoryboardScenePlan new];
+            plan->_generation = __atomic_load_n(&g_storyboardScenePlansGeneration, __ATOMIC_RELAXED);
+            plan->_initialClass = [parentViewController class];
+            plan->_hasRoutableChildren = routableViews.count > 0 && (routableViews.firstObject != parentViewController || routableViews.count > 1);
+            plan->_destinationClasses = destinationClasses;
+            plan->_routerTypes = routerTypes;
+            g_storyboardScenePlans[storyboardKey] = plan;
+        }
+    }
+    [routableViews enumerateObjectsUsingBlock:^(XXViewController *destination, NSUInteger idx, BOOL * _Nonnull stop) {
+        ZIKViewRouterType *routerType = routerTypes[idx];
+        if (routerType != (id)[NSNull null]) {
+            if (destination != parentViewController && !_routerTypeShouldAutoCreate(routerType, destination, parentViewController)) {
+                return;
             }
             [routerType prepareDestination:destination configuring:^(ZIKViewRouteConfiguration * _Nonnull config) {
                 
             }];
         }
-    }
+    }];
     return initialViewController;
 }
 
@@ -3128,6 +4430,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
 - (void)ZIKViewRouter_hook_prepareForSegue:(NSStoryboardSegue *)segue sender:(id)sender
 #endif
 {
+    ZIX_RECORD_HOOK(PrepareForSegue);
     /**
      We hooked every UIViewController and subclasses in +load, because a vc may override -prepareForSegue:sender: and not call [super prepareForSegue:sender:].
      If subclass vc call [super prepareForSegue:sender:] in its -prepareForSegue:sender:, because its superclass's -prepareForSegue:sender: was alse hooked, we will enter -ZIKViewRouter_hook_prepareForSegue:sender: for superclass. But we can't invoke superclass's original implementation by [self ZIKViewRouter_hook_prepareForSegue:sender:], it will call current class's original implementation, then there is an endless loop.
@@ -3190,7 +4493,8 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
             configuration.segueSource = source;
             configuration.segueDestination = destination;
 #if ZIK_HAS_UIKIT
-            configuration.destinationStateBeforeRoute = [destination zix_presentationState];
+            configuration.destinationStateBeforeRoute = zix_presentationSnapshot(destination);
+            configuration.hasDestinationStateBeforeRoute = YES;
             if (isUnwindSegue) {
                 sourceRouter.realRouteType = ZIKViewRouteRealTypeUnwind;
             }
@@ -3214,7 +4518,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
             parentViewController = [(NSWindowController *)parentViewController contentViewController];
         }
 #endif
-        if ([parentViewController conformsToProtocol:@protocol(ZIKRoutableView)]) {//if destination is ZIKRoutableView, create router for it
+        if (_isRoutableViewClass([parentViewController class])) {//if destination is ZIKRoutableView, create router for it
             if (sourceRouter && [(ZIKViewRouteConfiguration *)sourceRouter.original_configuration segueConfiguration].segueDestination == parentViewController) {
                 [destinationRouters addObject:sourceRouter];//If this segue is performed from router, don't auto create router again
             } else {
@@ -3223,7 +4527,10 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
             }
         }
 
-        NSArray<XXViewController *> *subRoutableViews = [ZIKViewRouter routableViewsInParentViewController:parentViewController];//Search child view controllers conform to ZIKRoutableView in destination
+        NSArray<XXViewController *> *subRoutableViews;
+        if (!_segueHasNoRoutableView(segue.identifier)) {
+            subRoutableViews = [ZIKViewRouter routableViewsInParentViewController:parentViewController];//Search child view controllers conform to ZIKRoutableView in destination
+        }
         if (subRoutableViews.count > 0) {
             if (!routableViews) {
                 routableViews = [NSMutableArray array];
@@ -3244,7 +4551,8 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
                 ZIKViewRouteSegueConfiguration *segueConfig = [(ZIKViewRouteConfiguration *)destinationRouter.original_configuration segueConfiguration];
                 NSAssert(destinationRouter && segueConfig, @"Failed to create router.");
 
-                segueConfig.destinationStateBeforeRoute = [routableView zix_presentationState];
+                segueConfig.destinationStateBeforeRoute = zix_presentationSnapshot(routableView);
+                segueConfig.hasDestinationStateBeforeRoute = YES;
 #endif
                 if (destinationRouter) {
                     [destinationRouters addObject:destinationRouter];
@@ -3299,6 +4607,7 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
 }
 
 - (void)ZIKViewRouter_hook_seguePerform {
+    ZIX_RECORD_HOOK(SeguePerform);
     Class currentClassCalling = [(XXStoryboardSegue *)self zix_currentClassCallingPerform];
     if (!currentClassCalling) {
         currentClassCalling = [self class];
@@ -3370,8 +4679,9 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
             [router endPerformRouteWithSuccess];
         };
 #if ZIK_HAS_UIKIT
-        ZIKPresentationState *destinationStateBeforeRoute = [(ZIKViewRouteConfiguration *)router.original_configuration segueConfiguration].destinationStateBeforeRoute;
-        NSAssert(destinationStateBeforeRoute, @"Didn't set state in -ZIKViewRouter_hook_prepareForSegue:sender:");
+        ZIKViewRouteSegueConfiguration *segueConfiguration = [(ZIKViewRouteConfiguration *)router.original_configuration segueConfiguration];
+        NSAssert(segueConfiguration.hasDestinationStateBeforeRoute, @"Didn't set state in -ZIKViewRouter_hook_prepareForSegue:sender:");
+        ZIKPresentationSnapshot destinationStateBeforeRoute = segueConfiguration.destinationStateBeforeRoute;
         [ZIKViewRouter _completeRouter:router
         analyzeRouteTypeForDestination:routableView
                                 source:source
@@ -3388,8 +4698,9 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
             [sourceRouter endPerformRouteWithSuccessWithAOP:NO];
         };
 #if ZIK_HAS_UIKIT
-        ZIKPresentationState *destinationStateBeforeRoute = [(ZIKViewRouteConfiguration *)sourceRouter.original_configuration segueConfiguration].destinationStateBeforeRoute;
-        NSAssert(destinationStateBeforeRoute, @"Didn't set state in -ZIKViewRouter_hook_prepareForSegue:sender:");
+        ZIKViewRouteSegueConfiguration *segueConfiguration = [(ZIKViewRouteConfiguration *)sourceRouter.original_configuration segueConfiguration];
+        NSAssert(segueConfiguration.hasDestinationStateBeforeRoute, @"Didn't set state in -ZIKViewRouter_hook_prepareForSegue:sender:");
+        ZIKPresentationSnapshot destinationStateBeforeRoute = segueConfiguration.destinationStateBeforeRoute;
         [ZIKViewRouter _completeRouter:sourceRouter
         analyzeRouteTypeForDestination:destination
                                 source:source
@@ -3402,78 +4713,130 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
     }
 }
 
+/// Kind of view controller class for searching routable child view controllers.
+typedef NS_ENUM(uintptr_t, ZIKViewControllerContainerKind) {
+    ZIKViewControllerContainerKindUnknown = 0,
+    /// Custom view controller, manages its children itself.
+    ZIKViewControllerContainerKindCustom,
+    /// System view controller which is not a container
+    ZIKViewControllerContainerKindSystem,
+    ZIKViewControllerContainerKindNavigation,
+    ZIKViewControllerContainerKindTabBar,
+    ZIKViewControllerContainerKindSplit,
+    ZIKViewControllerContainerKindPage
+};
+
+/// Class checks of a view controller class never change, so each class is checked once. Only used on main thread.
+static ZIKViewControllerContainerKind _containerKindOfClass(Class vcClass) {
+    static CFMutableDictionaryRef containerKinds;
+    if (containerKinds == NULL) {
+        containerKinds = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+    }
+    ZIKViewControllerContainerKind kind = (ZIKViewControllerContainerKind)CFDictionaryGetValue(containerKinds, (__bridge const void *)vcClass);
+    if (kind != ZIKViewControllerContainerKindUnknown) {
+        return kind;
+    }
+#if ZIK_HAS_UIKIT
+    if ([vcClass isSubclassOfClass:[UINavigationController class]]) {
+        kind = ZIKViewControllerContainerKindNavigation;
+    } else
+#endif
+    if ([vcClass isSubclassOfClass:[XXTabBarController class]]) {
+        kind = ZIKViewControllerContainerKindTabBar;
+    } else if ([vcClass isSubclassOfClass:[XXSplitViewController class]]) {
+        kind = ZIKViewControllerContainerKindSplit;
+    } else if ([vcClass isSubclassOfClass:[XXPageViewController class]]) {
+        kind = ZIKViewControllerContainerKindPage;
+    } else if (zix_classIsCustomClass(vcClass)) {
+        kind = ZIKViewControllerContainerKindCustom;
+    } else {
+        kind = ZIKViewControllerContainerKindSystem;
+    }
+    CFDictionarySetValue(containerKinds, (__bridge const void *)vcClass, (const void *)kind);
+    return kind;
+}
+
 /// Search child view controllers conforming to ZIKRoutableView in vc
 + (nullable NSArray<XXViewController *> *)routableViewsInParentViewController:(XXViewController *)vc {
     NSMutableArray *routableViews;
+    Class vcClass = [vc class];
+    ZIKViewControllerContainerKind kind = _containerKindOfClass(vcClass);
+    // Custom view controller is not searched, don't need to get its children
+    if (kind == ZIKViewControllerContainerKindCustom) {
+        return routableViews;
+    }
     NSArray<__kindof XXViewController *> *childViewControllers = vc.childViewControllers;
     if (childViewControllers.count == 0) {
         return routableViews;
     }
     
-    BOOL isContainerVC = NO;
-    BOOL isSystemViewController = NO;
+    BOOL isContainerVC = YES;
+    BOOL isSystemViewController = (zix_classIsCustomClass(vcClass) == NO);
     NSArray<XXViewController *> *containedVCs;
+    switch (kind) {
 #if ZIK_HAS_UIKIT
-    if ([vc isKindOfClass:[UINavigationController class]]) {
-        isContainerVC = YES;
-        if ([(UINavigationController *)vc viewControllers].count > 0) {
-            XXViewController *rootViewController = [[(UINavigationController *)vc viewControllers] firstObject];
-            if (rootViewController) {
-                containedVCs = @[rootViewController];
-            } else {
-                containedVCs = @[];
+        case ZIKViewControllerContainerKindNavigation:
+            if ([(UINavigationController *)vc viewControllers].count > 0) {
+                XXViewController *rootViewController = [[(UINavigationController *)vc viewControllers] firstObject];
+                if (rootViewController) {
+                    containedVCs = @[rootViewController];
+                } else {
+                    containedVCs = @[];
+                }
             }
-        }
-    } else
+            break;
 #endif
-    if ([vc isKindOfClass:[XXTabBarController class]]) {
-        isContainerVC = YES;
+        case ZIKViewControllerContainerKindTabBar: {
 #if ZIK_HAS_UIKIT
-        containedVCs = [(XXTabBarController *)vc viewControllers];
+            containedVCs = [(XXTabBarController *)vc viewControllers];
 #else
-        NSMutableArray<XXViewController *> *VCs = [NSMutableArray array];
-        for (NSTabViewItem *item in [(XXTabBarController *)vc tabViewItems]) {
-            if (item.viewController) {
-                [VCs addObject:item.viewController];
+            NSMutableArray<XXViewController *> *VCs = [NSMutableArray array];
+            for (NSTabViewItem *item in [(XXTabBarController *)vc tabViewItems]) {
+                if (item.viewController) {
+                    [VCs addObject:item.viewController];
+                }
             }
-        }
-        containedVCs = VCs;
+            containedVCs = VCs;
 #endif
-    } else if ([vc isKindOfClass:[XXSplitViewController class]]) {
-        isContainerVC = YES;
+            break;
+        }
+        case ZIKViewControllerContainerKindSplit: {
 #if ZIK_HAS_UIKIT
-        containedVCs = [(XXSplitViewController *)vc viewControllers];
+            containedVCs = [(XXSplitViewController *)vc viewControllers];
 #else
-        NSMutableArray<XXViewController *> *VCs = [NSMutableArray array];
-        for (NSSplitViewItem *item in [(XXSplitViewController *)vc splitViewItems]) {
-            if (item.viewController) {
-                [VCs addObject:item.viewController];
+            NSMutableArray<XXViewController *> *VCs = [NSMutableArray array];
+            for (NSSplitViewItem *item in [(XXSplitViewController *)vc splitViewItems]) {
+                if (item.viewController) {
+                    [VCs addObject:item.viewController];
+                }
             }
-        }
-        containedVCs = VCs;
+            containedVCs = VCs;
 #endif
-    } else if ([vc isKindOfClass:[XXPageViewController class]]) {
-        isContainerVC = YES;
+            break;
+        }
+        case ZIKViewControllerContainerKindPage: {
 #if ZIK_HAS_UIKIT
-        containedVCs = [(XXPageViewController *)vc viewControllers];
+            containedVCs = [(XXPageViewController *)vc viewControllers];
 #else
-        NSViewController *selectedViewController = [(XXPageViewController *)vc selectedViewController];
-        if (selectedViewController) {
-            containedVCs = @[selectedViewController];
-        }
+            NSViewController *selectedViewController = [(XXPageViewController *)vc selectedViewController];
+            if (selectedViewController) {
+                containedVCs = @[selectedViewController];
+            }
 #endif
+            break;
+        }
+        default:
+            isContainerVC = NO;
+            break;
     }
     
-    if (zix_classIsCustomClass([vc class]) == NO) {
-        isSystemViewController = YES;
-    }
     // Find in container's childs
     if (isContainerVC) {
         if (!routableViews) {
             routableViews = [NSMutableArray array];
         }
         for (XXViewController *child in containedVCs) {
-            if ([child conformsToProtocol:@protocol(ZIKRoutableView)]) {
+            if (_isRoutableViewClass([child class])) {
                 [routableViews addObject:child];
             }
             NSArray<XXViewController *> *routableViewsInChild = [self routableViewsInParentViewController:child];
@@ -3487,11 +4850,11 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
         if (!routableViews) {
             routableViews = [NSMutableArray array];
         }
-        for (XXViewController *child in vc.childViewControllers) {
+        for (XXViewController *child in childViewControllers) {
             if (containedVCs && [containedVCs containsObject:child]) {
                 continue;
             }
-            if ([child conformsToProtocol:@protocol(ZIKRoutableView)]) {
+            if (_isRoutableViewClass([child class])) {
                 [routableViews addObject:child];
             }
             NSArray<XXViewController *> *routableViewsInChild = [self routableViewsInParentViewController:child];
@@ -3646,18 +5009,14 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
 + (BOOL)_validateSourceInNavigationStack:(XXViewController *)source {
     BOOL canPerformPush = [source respondsToSelector:@selector(navigationController)];
     if (!canPerformPush ||
-        (canPerformPush && !source.navigationController)) {
+        (canPerformPush && !_navigationControllerForPushFromSource(source))) {
         return NO;
     }
     return YES;
 }
 
 + (BOOL)_validateDestination:(XXViewController *)destination notInNavigationStackOfSource:(XXViewController *)source {
-    NSArray<XXViewController *> *viewControllersInStack = source.navigationController.viewControllers;
-    if ([viewControllersInStack containsObject:destination]) {
-        return NO;
-    }
-    return YES;
+    return _destinationNotInNavigationStack(destination, _navigationControllerForPushFromSource(source));
 }
 
 
@@ -3688,22 +5047,20 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
 }
 
 + (BOOL)_validateSupportedRouteTypesForXXView {
-    ZIKViewRouteTypeMask supportedRouteTypes = [self supportedRouteTypes];
+    ZIKViewRouteTypeMask supportedRouteTypes = [self resolvedSupportedRouteTypes];
     if ((supportedRouteTypes & ZIKViewRouteTypeMaskCustom) == ZIKViewRouteTypeMaskCustom) {
         if (![self instancesRespondToSelector:@selector(performCustomRouteOnDestination:fromSource:configuration:)]) {
             return NO;
         }
     }
-    if ([self supportRouteType:ZIKViewRouteTypeAddAsSubview] == NO &&
-        [self supportRouteType:ZIKViewRouteTypeMakeDestination] == NO &&
-        [self supportRouteType:ZIKViewRouteTypeCustom] == NO) {
+    if ((supportedRouteTypes & (ZIKViewRouteTypeMaskAddAsSubview | ZIKViewRouteTypeMaskMakeDestination | ZIKViewRouteTypeMaskCustom)) == 0) {
         return NO;
     }
     return YES;
 }
 
 + (BOOL)_validateSupportedRouteTypesForXXViewController {
-    ZIKViewRouteTypeMask supportedRouteTypes = [self supportedRouteTypes];
+    ZIKViewRouteTypeMask supportedRouteTypes = [self resolvedSupportedRouteTypes];
     if ((supportedRouteTypes & ZIKViewRouteTypeMaskCustom) == ZIKViewRouteTypeMaskCustom) {
         if (![self instancesRespondToSelector:@selector(performCustomRouteOnDestination:fromSource:configuration:)]) {
             return NO;
@@ -3737,22 +5094,21 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
 }
 
 + (void)setGlobalErrorHandler:(ZIKViewRouteGlobalErrorHandler)globalErrorHandler {
-    dispatch_semaphore_wait(g_globalErrorSema, DISPATCH_TIME_FOREVER);
-    g_globalErrorHandler = globalErrorHandler;
-    dispatch_semaphore_signal(g_globalErrorSema);
+    zix_publishGlobalErrorHandler(&g_globalErrorHandler, globalErrorHandler);
 }
 
 + (ZIKViewRouteGlobalErrorHandler)globalErrorHandler {
-    return g_globalErrorHandler;
+    return zix_loadGlobalErrorHandler(&g_globalErrorHandler);
 }
 
 + (void)notifyGlobalErrorWithRouter:(nullable __kindof ZIKViewRouter *)router action:(ZIKRouteAction)action error:(NSError *)error {
-    void(^errorHandler)(__kindof ZIKViewRouter *_Nullable router, ZIKRouteAction action, NSError *error) = self.globalErrorHandler;
+    zix_logRouteErrorEvent(router ? object_getClass(router) : self, action, router ? router.state : ZIKRouterStateUnrouted, error.code);
+    ZIKViewRouteGlobalErrorHandler errorHandler = zix_loadGlobalErrorHandler(&g_globalErrorHandler);
     if (errorHandler) {
         errorHandler(router, action, error);
     } else {
 #ifdef DEBUG
-        NSLog(@"❌ZIKViewRouter Error: router's action (%@) catch error: (%@),\nrouter:(%@)", action, error,router);
+        ZIX_LOG(Route, Error, @"❌ZIKViewRouter Error: router's action (%@) catch error: (%@),\nrouter:(%@)", action, error,router);
 #endif
     }
 }
@@ -3829,6 +5185,26 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
 
 #pragma mark Debug
 
+- (nullable NSString *)signpostRouteType {
+    return [ZIKViewRouter descriptionOfRouteType:self.original_configuration.routeType];
+}
+
+- (NSInteger)eventLogRouteType {
+    return self.original_configuration.routeType;
+}
+
+- (void)releasePerformHandlers {
+    ZIKViewRouteConfiguration *configuration = self.original_configuration;
+    // Destination displayed from external is prepared with these blocks again
+    if (configuration.handleExternalRoute || configuration.routeType == ZIKViewRouteTypeMakeDestination) {
+        return;
+    }
+    [super releasePerformHandlers];
+    configuration.prepareDestinationAlongsideTransition = nil;
+    configuration.containerWrapper = nil;
+    configuration.addingChildViewHandler = nil;
+}
+
 + (NSString *)descriptionOfRouteType:(ZIKViewRouteType)routeType {
     NSString *description;
     switch (routeType) {
@@ -3934,13 +5310,103 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
     return [self _canPerformWithErrorMessage:NULL];
 }
 
-+ (BOOL)supportRouteType:(ZIKViewRouteType)type {
++ (uint64_t)performableMaskOfRouters:(NSArray<ZIKViewRouter *> *)routers {
+    NSAssert(routers.count <= 64, @"Can't check more than 64 routers at once.");
+    NSMapTable<id, ZIKViewRouteSourceState *> *sourceStates = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+    uint64_t mask = 0;
+    NSUInteger count = MIN(routers.count, 64);
+    for (NSUInteger idx = 0; idx < count; idx++) {
+        ZIKViewRouter *router = routers[idx];
+        id source = router.original_configuration.source;
+        ZIKViewRouteSourceState *sourceState;
+        if (source) {
+            sourceState = [sourceStates objectForKey:source];
+            if (!sourceState) {
+                sourceState = [ZIKViewRouteSourceState new];
+                sourceState->_source = source;
+                [sourceStates setObject:sourceState forKey:source];
+            }
+        }
+        if ([router _canPerformWithErrorMessage:NULL sourceState:sourceState]) {
+            mask |= (uint64_t)1 << idx;
+        }
+    }
+    return mask;
+}
+
++ (ZIKViewRouteTypeMask)performableRouteTypesFromSource:(nullable id)source {
+    ZIKViewRouteTypeMask supportedRouteTypes = [self resolvedSupportedRouteTypes];
+    if (!source) {
+        return supportedRouteTypes & ZIKViewRouteTypeMaskMakeDestination;
+    }
+    ZIKViewRouteTypeMask mask = supportedRouteTypes & ~ZIKViewRouteTypeMaskCustom;
+#if ZIK_HAS_UIKIT
+    ZIKViewRouteSourceState *sourceState = [ZIKViewRouteSourceState new];
+    sourceState->_source = source;
+    if ((mask & ZIKViewRouteTypeMaskPush) && sourceState.navigationController == nil) {
+        mask &= ~ZIKViewRouteTypeMaskPush;
+    }
+    if ((mask & (ZIKViewRouteTypeMaskPresentModally | ZIKViewRouteTypeMaskPresentAsPopover)) && sourceState.presentedAnyView) {
+        mask &= ~(ZIKViewRouteTypeMaskPresentModally | ZIKViewRouteTypeMaskPresentAsPopover);
+    }
+#endif
+    return mask;
+}
+
+/// key: router class, value: its supported route types. Guarded by g_supportedRouteTypesSema. Supported route types of a router class never change, values are only removed when its image is unloaded.
+static CFMutableDictionaryRef g_supportedRouteTypes;
+static dispatch_semaphore_t g_supportedRouteTypesSema;
+
++ (ZIKViewRouteTypeMask)resolvedSupportedRouteTypes {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        g_supportedRouteTypes = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+        g_supportedRouteTypesSema = dispatch_semaphore_create(1);
+    });
+    const void *value;
+    dispatch_semaphore_wait(g_supportedRouteTypesSema, DISPATCH_TIME_FOREVER);
+    Boolean resolved = CFDictionaryGetValueIfPresent(g_supportedRouteTypes, (__bridge const void *)self, &value);
+    dispatch_semaphore_signal(g_supportedRouteTypesSema);
+    if (resolved) {
+        return (ZIKViewRouteTypeMask)(uintptr_t)value;
+    }
+    // Call it without lock, it may use other routers
     ZIKViewRouteTypeMask supportedRouteTypes = [self supportedRouteTypes];
-    ZIKViewRouteTypeMask mask = 1 << type;
-    if ((supportedRouteTypes & mask) == mask) {
-        return YES;
+    dispatch_semaphore_wait(g_supportedRouteTypesSema, DISPATCH_TIME_FOREVER);
+    CFDictionarySetValue(g_supportedRouteTypes, (__bridge const void *)self, (const void *)(uintptr_t)supportedRouteTypes);
+    dispatch_semaphore_signal(g_supportedRouteTypesSema);
+    return supportedRouteTypes;
+}
+
+void zix_evictViewRouterCachesInImage(const void *header) {
+    if (g_supportedRouteTypesSema) {
+        dispatch_semaphore_wait(g_supportedRouteTypesSema, DISPATCH_TIME_FOREVER);
+        CFIndex count = CFDictionaryGetCount(g_supportedRouteTypes);
+        const void **routerClasses = count > 0 ? malloc(sizeof(void *) * count) : NULL;
+        if (routerClasses) {
+            CFDictionaryGetKeysAndValues(g_supportedRouteTypes, routerClasses, NULL);
+            for (CFIndex i = 0; i < count; i++) {
+                if (zix_imageHeaderOfAddress(routerClasses[i]) == header) {
+                    CFDictionaryRemoveValue(g_supportedRouteTypes, routerClasses[i]);
+                }
+            }
+            free(routerClasses);
+        }
+        dispatch_semaphore_signal(g_supportedRouteTypesSema);
     }
-    return NO;
+    // Preloaded destinations are only used on main thread
+    if ([NSThread isMainThread]) {
+        _discardPreloadedDestinationsInImage(header);
+    } else {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            _discardPreloadedDestinationsInImage(header);
+        });
+    }
+}
+
++ (BOOL)supportRouteType:(ZIKViewRouteType)type {
+    ZIKViewRouteTypeMask mask = 1 << type;
+    return ([self resolvedSupportedRouteTypes] & mask) == mask;
 }
 
 + (nullable instancetype)performPath:(ZIKViewRoutePath *)path configuring:(void(NS_NOESCAPE ^)(ZIKViewRouteConfiguration *config))configBuilder {
@@ -4450,9 +5916,415 @@ Protocol<ZIKViewModuleRoutable> *_Nullable _routableViewModuleProtocolFromObject
 
 @end
 
+#pragma mark Preload
+
+/// key: router class, value: NSMutableArray of preloaded destinations. Only used on main thread.
+static CFMutableDictionaryRef g_preloadedDestinations;
+/// Router classes waiting for idle run loop to preload a destination, in order of calling +preloadDestination.
+static NSMutableArray<Class> *g_pendingPreloadRouterClasses;
+static CFRunLoopObserverRef g_preloadObserver;
+
+/// Preloaded destination and the configuration it's made with.
+@interface ZIKPreloadedDestination : NSObject {
+    @package
+    id _destination;
+    ZIKPerformRouteConfiguration *_configuration;
+}
+@end
+@implementation ZIKPreloadedDestination
+@end
+
+/// Whether destination made with preloadConfiguration can be used for configuration. Properties of ZIKViewRouteConfiguration only affect the transition, so only properties declared by module config subclasses are compared. Configuration of ZIKViewRouteConfiguration itself has no customization for making destination.
+static BOOL _configurationMatchesPreloadConfiguration(ZIKPerformRouteConfiguration *configuration, ZIKPerformRouteConfiguration *preloadConfiguration) {
+    Class configClass = [configuration class];
+    if (configClass != [preloadConfiguration class]) {
+        return NO;
+    }
+    for (Class aClass = configClass; aClass && aClass != [ZIKViewRouteConfiguration class] && aClass != [ZIKPerformRouteConfiguration class]; aClass = class_getSuperclass(aClass)) {
+        unsigned int count = 0;
+        objc_property_t *properties = class_copyPropertyList(aClass, &count);
+        BOOL matches = YES;
+        for (unsigned int i = 0; i < count && matches; i++) {
+            NSString *key = [NSString stringWithUTF8String:property_getName(properties[i])];
+            id value = [configuration valueForKey:key];
+            id preloadValue = [preloadConfiguration valueForKey:key];
+            matches = value == preloadValue || [value isEqual:preloadValue];
+        }
+        free(properties);
+        if (!matches) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+static id _Nullable _takePreloadedDestination(Class routerClass, ZIKPerformRouteConfiguration *configuration) {
+    if (g_preloadedDestinations == NULL) {
+        return nil;
+    }
+    NSMutableArray<ZIKPreloadedDestination *> *pool = (__bridge NSMutableArray *)CFDictionaryGetValue(g_preloadedDestinations, (__bridge const void *)routerClass);
+    ZIKPreloadedDestination *preloaded = pool.lastObject;
+    if (preloaded == nil || !_configurationMatchesPreloadConfiguration(configuration, preloaded->_configuration)) {
+        // Keep it for performing with matched configuration
+        return nil;
+    }
+    [pool removeLastObject];
+    return preloaded->_destination;
+}
+
+static void _discardAllPreloadedDestinations(void) {
+    if (g_preloadedDestinations) {
+        CFDictionaryRemoveAllValues(g_preloadedDestinations);
+    }
+    [g_pendingPreloadRouterClasses removeAllObjects];
+}
+
+static void _preloadDestinationOfRouterClass(Class routerClass) {
+    NSMutableArray *pool = (__bridge NSMutableArray *)CFDictionaryGetValue(g_preloadedDestinations, (__bridge const void *)routerClass);
+    if (pool.count >= [routerClass maxPreloadedDestinationCount]) {
+        return;
+    }
+    ZIKViewRouteConfiguration *configuration = [routerClass defaultRouteConfiguration];
+    ZIKViewRouter *router = [[routerClass alloc] initWithConfiguration:configuration removeConfiguration:nil];
+    id destination = [router destinationWithConfiguration:configuration];
+    if (destination == nil) {
+        return;
+    }
+    if ([destination isKindOfClass:[XXViewController class]]) {
+        // Run -loadView and -viewDidLoad now
+        (void)[(XXViewController *)destination view];
+    }
+    if (pool == nil) {
+        pool = [NSMutableArray array];
+        CFDictionarySetValue(g_preloadedDestinations, (__bridge const void *)routerClass, (__bridge const void *)pool);
+    }
+    ZIKPreloadedDestination *preloaded = [ZIKPreloadedDestination new];
+    preloaded->_destination = destination;
+    preloaded->_configuration = configuration;
+    [pool addObject:preloaded];
+}
+
+/// Preload one destination each time main run loop is going to sleep, so a long queue doesn't block a frame.
+static void _schedulePreloading(void) {
+    if (g_preloadObserver) {
+        return;
+    }
+    g_preloadObserver = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault, kCFRunLoopBeforeWaiting, true, INT_MAX, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+        Class routerClass = g_pendingPreloadRouterClasses.firstObject;
+        if (routerClass) {
+            [g_pendingPreloadRouterClasses removeObjectAtIndex:0];
+            _preloadDestinationOfRouterClass(routerClass);
+        }
+        if (g_pendingPreloadRouterClasses.count > 0) {
+            // Run loop won't wake up again if there is no other event
+            CFRunLoopWakeUp(CFRunLoopGetMain());
+            return;
+        }
+        CFRunLoopObserverInvalidate(g_preloadObserver);
+        CFRelease(g_preloadObserver);
+        g_preloadObserver = NULL;
+    });
+    // Only default mode, so preloading doesn't run when user is scrolling
+    CFRunLoopAddObserver(CFRunLoopGetMain(), g_preloadObserver, kCFRunLoopDefaultMode);
+}
+
+@implementation ZIKViewRouter (Preload)
+
++ (void)preloadDestination {
+    NSAssert([NSThread isMainThread], @"Preload destination should only be called in main thread!");
+    NSAssert(self != [ZIKViewRouter class], @"Only preload destination from router subclass");
+    if ([self isAbstractRouter]) {
+        return;
+    }
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        g_preloadedDestinations = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+        g_pendingPreloadRouterClasses = [NSMutableArray array];
+        zix_registerCacheTrimmer(ZIKRouteCachePriorityHigh, ^{
+            _discardAllPreloadedDestinations();
+        });
+    });
+    [g_pendingPreloadRouterClasses addObject:self];
+    _schedulePreloading();
+}
+
++ (NSUInteger)maxPreloadedDestinationCount {
+    return 1;
+}
+
+static void _discardPreloadedDestinationsInImage(const void *header) {
+    if (g_preloadedDestinations == NULL) {
+        return;
+    }
+    NSDictionary<Class, NSMutableArray *> *pools = [(__bridge NSDictionary *)g_preloadedDestinations copy];
+    for (Class routerClass in pools) {
+        if (zix_imageHeaderOfClass(routerClass) == header) {
+            CFDictionaryRemoveValue(g_preloadedDestinations, (__bridge const void *)routerClass);
+            continue;
+        }
+        NSMutableArray *pool = pools[routerClass];
+        [pool filterUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(ZIKPreloadedDestination *preloaded, NSDictionary *bindings) {
+            return zix_imageHeaderOfClass(object_getClass(preloaded->_destination)) != header;
+        }]];
+    }
+    [g_pendingPreloadRouterClasses filterUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(Class routerClass, NSDictionary *bindings) {
+        return zix_imageHeaderOfClass(routerClass) != header;
+    }]];
+}
+
++ (void)discardPreloadedDestinations {
+    NSAssert([NSThread isMainThread], @"Discard preloaded destinations should only be called in main thread!");
+    if (g_preloadedDestinations == NULL) {
+        return;
+    }
+    CFDictionaryRemoveValue(g_preloadedDestinations, (__bridge const void *)self);
+    [g_pendingPreloadRouterClasses removeObject:self];
+}
+
+@end
+
+#if ZIK_HAS_UIKIT
+@implementation ZIKViewRouter (BatchPush)
+
++ (void)performBatchPushAnimated:(BOOL)animated routes:(void(NS_NOESCAPE ^)(void))routes {
+    NSParameterAssert(routes);
+    NSAssert([NSThread isMainThread], @"Batch push should only be performed in main thread!");
+    if (routes == nil) {
+        return;
+    }
+    if (g_pushBatch) {
+        routes();
+        return;
+    }
+    ZIKViewRoutePushBatch *batch = [ZIKViewRoutePushBatch new];
+    batch.animated = animated;
+    g_pushBatch = batch;
+    routes();
+    g_pushBatch = nil;
+    
+    for (UINavigationController *navigationController in batch.navigationControllers) {
+        NSArray<ZIKViewRouter *> *routers = [batch.routers objectForKey:navigationController];
+        NSArray<UIViewController *> *viewControllers = [batch.viewControllers objectForKey:navigationController];
+        [navigationController setViewControllers:[navigationController.viewControllers arrayByAddingObjectsFromArray:viewControllers] animated:batch.animated];
+        [ZIKViewRouter _completeWithtransitionCoordinator:navigationController.transitionCoordinator
+                                                 animated:batch.animated
+                                     transitionCompletion:^{
+            for (ZIKViewRouter *router in routers) {
+                // Router may be ended by error or removed during transition
+                if (router.state == ZIKRouterStateRouting) {
+                    [router endPerformRouteWithSuccess];
+                }
+            }
+        }];
+    }
+}
+
+@end
+
+static NSString *const kStackSnapshotDestinationClassNamesKey = @"destinationClassNames";
+static NSString *const kStackSnapshotStatesKey = @"states";
+
+@interface ZIKViewRouteStackSnapshot ()
+/// Restoration states in the same order of destinationClassNames, empty dictionary when there's no state.
+@property (nonatomic, copy, readonly) NSArray<NSDictionary<NSString *, id> *> *states;
+@end
+
+@implementation ZIKViewRouteStackSnapshot
+
+- (instancetype)initWithDestinationClassNames:(NSArray<NSString *> *)destinationClassNames states:(NSArray<NSDictionary<NSString *, id> *> *)states {
+    NSParameterAssert(destinationClassNames.count == states.count);
+    if (self = [super init]) {
+        _destinationClassNames = [destinationClassNames copy];
+        _states = [states copy];
+    }
+    return self;
+}
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder {
+    [coder encodeObject:_destinationClassNames forKey:kStackSnapshotDestinationClassNamesKey];
+    [coder encodeObject:_states forKey:kStackSnapshotStatesKey];
+}
+
+- (nullable instancetype)initWithCoder:(NSCoder *)coder {
+    NSSet<Class> *propertyListClasses = [NSSet setWithObjects:[NSArray class], [NSDictionary class], [NSString class], [NSNumber class], [NSDate class], [NSData class], nil];
+    NSArray<NSString *> *destinationClassNames = [coder decodeObjectOfClasses:[NSSet setWithObjects:[NSArray class], [NSString class], nil] forKey:kStackSnapshotDestinationClassNamesKey];
+    NSArray<NSDictionary<NSString *, id> *> *states = [coder decodeObjectOfClasses:propertyListClasses forKey:kStackSnapshotStatesKey];
+    if (![destinationClassNames isKindOfClass:[NSArray class]] || ![states isKindOfClass:[NSArray class]] || destinationClassNames.count != states.count) {
+        return nil;
+    }
+    return [self initWithDestinationClassNames:destinationClassNames states:states];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%@, destinationClassNames:%@", [super description], _destinationClassNames];
+}
+
+@end
+
+@implementation ZIKViewRouter (StackRestoration)
+
++ (ZIKViewRouteStackSnapshot *)snapshotOfNavigationController:(UINavigationController *)navigationController {
+    NSParameterAssert(navigationController);
+    NSAssert([NSThread isMainThread], @"Navigation stack should only be recorded in main thread!");
+    NSMutableArray<NSString *> *destinationClassNames = [NSMutableArray array];
+    NSMutableArray<NSDictionary<NSString *, id> *> *states = [NSMutableArray array];
+    NSArray<UIViewController *> *viewControllers = navigationController.viewControllers;
+    for (NSUInteger i = 1; i < viewControllers.count; i++) {
+        UIViewController *viewController = viewControllers[i];
+        ZIKRouterType *routerType = [ZIKViewRouteRegistry routerToRegisteredDestinationClass:[viewController class]];
+        if (![routerType isKindOfClass:[ZIKViewRouterType class]]) {
+            ZIX_LOG(Route, Warning, @"⚠️Warning: view controller (%@) is not registered with any view router, navigation stack above it is not recorded.", viewController);
+            break;
+        }
+        NSDictionary<NSString *, id> *state = [routerType.routerClass restorationStateOfDestination:viewController];
+        if (state && ![NSPropertyListSerialization propertyList:state isValidForFormat:NSPropertyListBinaryFormat_v1_0]) {
+            NSAssert2(NO, @"Restoration state (%@) of view controller (%@) must only contain property list objects.", state, viewController);
+            state = nil;
+        }
+        [destinationClassNames addObject:NSStringFromClass([viewController class])];
+        [states addObject:state ?: @{}];
+    }
+    return [[ZIKViewRouteStackSnapshot alloc] initWithDestinationClassNames:destinationClassNames states:states];
+}
+
++ (NSArray<ZIKViewRouter *> *)restoreNavigationController:(UINavigationController *)navigationController
+                                             fromSnapshot:(ZIKViewRouteStackSnapshot *)snapshot
+                                              configuring:(void(NS_NOESCAPE ^ _Nullable)(ZIKViewRouteConfiguration *config, NSDictionary<NSString *, id> *state))configBuilder {
+    NSParameterAssert(navigationController);
+    NSParameterAssert(snapshot);
+    NSAssert([NSThread isMainThread], @"Navigation stack should only be restored in main thread!");
+    NSMutableArray<ZIKViewRouter *> *routers = [NSMutableArray arrayWithCapacity:snapshot.destinationClassNames.count];
+    if (navigationController.topViewController == nil || snapshot == nil) {
+        return routers;
+    }
+    [self performBatchPushAnimated:NO routes:^{
+        UIViewController *source = navigationController.topViewController;
+        NSArray<NSString *> *destinationClassNames = snapshot.destinationClassNames;
+        NSArray<NSDictionary<NSString *, id> *> *states = snapshot.states;
+        for (NSUInteger i = 0; i < destinationClassNames.count; i++) {
+            Class destinationClass = NSClassFromString(destinationClassNames[i]);
+            ZIKRouterType *routerType = destinationClass ? [ZIKViewRouteRegistry routerToRegisteredDestinationClass:destinationClass] : nil;
+            if (![routerType isKindOfClass:[ZIKViewRouterType class]]) {
+                ZIX_LOG(Route, Warning, @"⚠️Warning: no view router for restoring (%@), navigation stack above it is not restored.", destinationClassNames[i]);
+                break;
+            }
+            NSDictionary<NSString *, id> *state = states[i];
+            ZIKViewRouter *router = [(ZIKViewRouterType *)routerType performPath:ZIKViewRoutePath.pushFrom(source) configuring:^(ZIKViewRouteConfiguration * _Nonnull config) {
+                if (state.count > 0) {
+                    [config addUserInfo:state];
+                }
+                if (configBuilder) {
+                    configBuilder(config, state);
+                }
+            }];
+            // Destination made asynchronously is not in the batch, so the next one has no source
+            UIViewController *destination = router.destination;
+            if (router.state != ZIKRouterStateRouting || ![destination isKindOfClass:[UIViewController class]]) {
+                break;
+            }
+            [routers addObject:router];
+            source = destination;
+        }
+    }];
+    return routers;
+}
+
++ (nullable NSDictionary<NSString *, id> *)restorationStateOfDestination:(id)destination {
+    return nil;
+}
+
+@end
+#endif
+
+@implementation ZIKViewRouter (Template)
+
++ (ZIKViewRouteConfigurationTemplate *)configurationTemplate:(void(NS_NOESCAPE ^)(ZIKViewRouteConfiguration *config))configBuilder {
+    NSParameterAssert(configBuilder);
+    ZIKViewRouteConfiguration *configuration = [self defaultRouteConfiguration];
+    if (configBuilder) {
+        configBuilder(configuration);
+        if (configuration.injected) {
+            configuration = (ZIKViewRouteConfiguration *)configuration.injected;
+        }
+    }
+    return [[ZIKViewRouteConfigurationTemplate alloc] initWithConfiguration:configuration routerClass:self];
+}
+
++ (nullable instancetype)performPath:(ZIKViewRoutePath *)path
+                            template:(ZIKViewRouteConfigurationTemplate *)configTemplate
+                         configuring:(void(NS_NOESCAPE ^ _Nullable)(ZIKViewRouteConfiguration *config))configBuilder {
+    NSParameterAssert(configTemplate);
+    NSAssert([self isSubclassOfClass:configTemplate.routerClass], @"Template (%@) is not built by router (%@).", configTemplate, self);
+    ZIKViewRouteConfiguration *configuration = [configTemplate makeConfiguration];
+    if (configBuilder) {
+        configBuilder(configuration);
+    }
+    [configuration configurePath:path];
+    ZIKViewRouter *router = [[self alloc] initWithConfiguration:configuration removeConfiguration:nil];
+    [router performRoute];
+    return router;
+}
+
+@end
+
+@implementation ZIKViewRouter (ReusableView)
+
++ (nullable instancetype)bindToReusableView:(XXView *)reusableView configuring:(void(NS_NOESCAPE ^)(ZIKViewRouteConfiguration *config))configBuilder {
+    NSParameterAssert(reusableView);
+    NSAssert([NSThread isMainThread], @"Bind destination should only be called in main thread!");
+    ZIKViewRouter *router = [reusableView zix_boundViewRouterOfClass:self];
+    if (router) {
+        XXView *destination = router.destination;
+        if (router.state == ZIKRouterStateRouted && destination.superview == reusableView) {
+            // Destination stays in reusable view, only prepare it with new configuration
+            ZIKViewRouteConfiguration *configuration = [self defaultRouteConfiguration];
+            configuration.source = reusableView;
+            configuration.routeType = ZIKViewRouteTypeAddAsSubview;
+            if (configBuilder) {
+                configBuilder(configuration);
+                if (configuration.injected) {
+                    configuration = (ZIKViewRouteConfiguration *)configuration.injected;
+                }
+            }
+            [router rebindConfiguration:configuration];
+            [router prepareDestinationForPerforming];
+            [router notifySuccessWithAction:ZIKRouteActionPerformRoute];
+            return router;
+        }
+        [reusableView setZix_boundViewRouter:nil ofClass:self];
+        if (destination.superview == reusableView && [router canRemove]) {
+            [router removeRoute];
+        }
+    }
+    router = [self performPath:ZIKViewRoutePath.addAsSubviewFrom(reusableView) configuring:configBuilder];
+    if (router.state == ZIKRouterStateRouted) {
+        [reusableView setZix_boundViewRouter:router ofClass:self];
+    }
+    return router;
+}
+
+@end
+
 @implementation ZIKViewRouter (Debug)
 
+#if DEBUG
 static NSTimeInterval _detectMemoryLeakDelay = 2;
+#else
+static NSTimeInterval _detectMemoryLeakDelay = 0;
+#endif
+static double _memoryLeakSampleRate = 1;
+
+static BOOL _shouldSampleMemoryLeak(void) {
+    double rate = _memoryLeakSampleRate;
+    if (rate >= 1) {
+        return YES;
+    }
+    return arc4random_uniform(1000000) < rate * 1000000;
+}
 
 + (BOOL)shouldDetectMemoryLeak {
     return _detectMemoryLeakDelay > 0;
@@ -4466,6 +6338,14 @@ static NSTimeInterval _detectMemoryLeakDelay = 2;
     _detectMemoryLeakDelay = detectMemoryLeakDelay;
 }
 
++ (double)memoryLeakSampleRate {
+    return _memoryLeakSampleRate;
+}
+
++ (void)setMemoryLeakSampleRate:(double)memoryLeakSampleRate {
+    _memoryLeakSampleRate = MAX(0, MIN(memoryLeakSampleRate, 1));
+}
+
 static void(^_didDetectLeakingHandler)(id);
 
 + (void(^)(id))didDetectLeakingHandler {
@@ -142,6 +142,17 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)didFinishPrepareDestination:(Destination)destination configuration:(RouteConfig)configuration;
 
+/**
+ Asynchronous part of preparation, started when the transition begins, after -prepareDestination:configuration: and -didFinishPrepareDestination:configuration:. Start loading data that destination can display later here, so it runs alongside the transition animation instead of delaying it. Call `delivery` with a block updating destination when the data is ready, the block is called on main thread. Default does nothing.
+ 
+ It's not called for ZIKViewRouteTypeMakeDestination and ZIKViewRouteTypePerformSegue, or when destination is displayed from external.
+ 
+ @param destination The view to perform route.
+ @param configuration The configuration for route.
+ @param delivery Deliver the result to destination.
+ */
+- (void)prepareDestinationAlongsideTransition:(Destination)destination configuration:(RouteConfig)configuration delivery:(ZIKViewRoutePreparationDelivery)delivery;
+
 #pragma mark Custom Route Required Override
 
 /// Custom route for ZIKViewRouteTypeCustom. The router must override +supportedRouteTypes to add ZIKViewRouteTypeMaskCustom.
@@ -307,6 +318,16 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (void)router:(nullable ZIKViewRouter *)router didRemoveRouteOnDestination:(Destination)destination fromSource:(nullable id)source;
 
+/**
+ Coalesce AOP perform callbacks of UIView / NSView added to superview without router. Default is NO. Main thread only.
+ 
+ @discussion
+ When a table view or stack view adds many routable subviews in one layout pass, each subview sends will perform and did perform callbacks to all routers of its class. When it's YES, these callbacks are collected and delivered when main run loop is about to sleep, after the layout pass is committed. Callbacks are grouped by destination class, and keep their order in each class. Callbacks of routes performed by router, and callbacks for removing, are not delayed.
+ 
+ So `+router:willPerformRouteOnDestination:fromSource:` of these subviews is called after the views are displayed, and `+router:didPerformRouteOnDestination:fromSource:` is called after success handlers of auto created routers.
+ */
+@property (class, nonatomic) BOOL coalescesSubviewAOPCallbacks;
+
 @end
 
 FOUNDATION_EXTERN ZIKAnyViewRouterType *_Nullable _ZIKViewRouterToView(Protocol *viewProtocol);
@@ -315,6 +336,8 @@ FOUNDATION_EXTERN ZIKAnyViewRouterType *_Nullable _ZIKViewRouterToModule(Protoco
 
 FOUNDATION_EXTERN ZIKAnyViewRouterType *_Nullable _ZIKViewRouterToIdentifier(NSString *identifier);
 
+FOUNDATION_EXTERN ZIKAnyViewRouterType *_Nullable _ZIKViewRouterToIdentifierHandle(ZIKRouteIdentifierHandle handle);
+
 FOUNDATION_EXTERN Protocol<ZIKViewRoutable> *_Nullable _routableViewProtocolFromObject(id object);
 
 FOUNDATION_EXTERN Protocol<ZIKViewModuleRoutable> *_Nullable _routableViewModuleProtocolFromObject(id object);
@@ -10,7 +10,7 @@
 #import "AServiceInput.h"
 #import "EasyServiceInput.h"
 
-@interface AService : NSObject <AServiceInput, EasyServiceInput>
+@interface AService : NSObject <AServiceInput, EasyServiceInput, TableServiceInput>
 
 @property (nonatomic, copy, nullable) NSString *title;
 @property (nonatomic, strong) id router;
@@ -32,3 +32,5 @@ DeclareRoutableService(AService, AServiceRouter)
 }
 
 @end
+
+ZIKROUTER_REGISTER_ROUTER(AServiceRouter)
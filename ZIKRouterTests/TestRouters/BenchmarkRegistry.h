@@ -0,0 +1,30 @@
+//
+//  BenchmarkRegistry.h
+//  ZIKRouterTests
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+@import ZIKRouter;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Registers synthetic services generated at runtime, so benchmarks run against a registry as big as a large app.
+@interface BenchmarkRegistry : ZIKServiceRouteAdapter
+
+/// Number of synthetic service protocols registered.
+@property (nonatomic, class, readonly) NSUInteger serviceCount;
+/// Time in seconds spent in +registerRoutableDestination.
+@property (nonatomic, class, readonly) NSTimeInterval registrationDuration;
+
+/// Registered service protocol at index.
++ (Protocol *)serviceProtocolAtIndex:(NSUInteger)index;
+/// Protocol at index that is not registered.
++ (Protocol *)unregisteredProtocolAtIndex:(NSUInteger)index;
+/// Head of an adapter chain ending at the service protocol at index 0.
++ (Protocol *)adapterProtocol;
+
+@end
+
+NS_ASSUME_NONNULL_END
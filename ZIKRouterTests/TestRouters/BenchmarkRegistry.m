@@ -0,0 +1,94 @@
+//
+//  BenchmarkRegistry.m
+//  ZIKRouterTests
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import "BenchmarkRegistry.h"
+#import <objc/runtime.h>
+@import ZIKRouter.Internal;
+
+static const NSUInteger kServiceCount = 5000;
+static const NSUInteger kAdapterChainLength = 4;
+
+static NSArray<Protocol *> *_serviceProtocols;
+static NSArray<Protocol *> *_unregisteredProtocols;
+static NSArray<Protocol *> *_adapterProtocols;
+static NSTimeInterval _registrationDuration;
+
+static Protocol *makeProtocol(NSString *name, Protocol *_Nullable parentProtocol) {
+    Protocol *protocol = objc_allocateProtocol(name.UTF8String);
+    if (parentProtocol) {
+        protocol_addProtocol(protocol, parentProtocol);
+    }
+    objc_registerProtocol(protocol);
+    return protocol;
+}
+
+static Protocol *makeServiceProtocol(NSString *name) {
+    return makeProtocol(name, @protocol(ZIKServiceRoutable));
+}
+
+@implementation BenchmarkRegistry
+
++ (void)registerRoutableDestination {
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    NSMutableArray<Protocol *> *adapterProtocols = [NSMutableArray arrayWithCapacity:kAdapterChainLength];
+    for (NSUInteger i = 0; i < kAdapterChainLength; i++) {
+        [adapterProtocols addObject:makeServiceProtocol([NSString stringWithFormat:@"BenchmarkServiceAdapter%@", @(i)])];
+    }
+    NSMutableArray<Protocol *> *serviceProtocols = [NSMutableArray arrayWithCapacity:kServiceCount];
+    NSMutableArray<Protocol *> *unregisteredProtocols = [NSMutableArray arrayWithCapacity:kServiceCount];
+    for (NSUInteger i = 0; i < kServiceCount; i++) {
+        Protocol *protocol = makeServiceProtocol([NSString stringWithFormat:@"BenchmarkServiceInput%@", @(i)]);
+        // Not inheriting ZIKServiceRoutable, or validation will report them
+        [unregisteredProtocols addObject:makeProtocol([NSString stringWithFormat:@"BenchmarkUnregisteredServiceInput%@", @(i)], nil)];
+        
+        Class serviceClass = objc_allocateClassPair([NSObject class], [NSString stringWithFormat:@"BenchmarkService%@", @(i)].UTF8String, 0);
+        class_addProtocol(serviceClass, @protocol(ZIKRoutableService));
+        class_addProtocol(serviceClass, protocol);
+        if (i == 0) {
+            // Destination must conform to all adapters
+            for (Protocol *adapter in adapterProtocols) {
+                class_addProtocol(serviceClass, adapter);
+            }
+        }
+        objc_registerClassPair(serviceClass);
+        
+        [ZIKServiceRouter registerServiceProtocol:(Protocol<ZIKServiceRoutable> *)protocol forMakingService:serviceClass];
+        [serviceProtocols addObject:protocol];
+    }
+    // adapter0 -> adapter1 -> ... -> service0
+    for (NSUInteger i = 0; i < kAdapterChainLength; i++) {
+        Protocol *adaptee = i + 1 < kAdapterChainLength ? adapterProtocols[i + 1] : serviceProtocols[0];
+        [self registerDestinationAdapter:(Protocol<ZIKServiceRoutable> *)adapterProtocols[i] forAdaptee:(Protocol<ZIKServiceRoutable> *)adaptee];
+    }
+    _serviceProtocols = serviceProtocols;
+    _unregisteredProtocols = unregisteredProtocols;
+    _adapterProtocols = adapterProtocols;
+    _registrationDuration = CFAbsoluteTimeGetCurrent() - start;
+}
+
++ (NSUInteger)serviceCount {
+    return kServiceCount;
+}
+
++ (NSTimeInterval)registrationDuration {
+    return _registrationDuration;
+}
+
++ (Protocol *)serviceProtocolAtIndex:(NSUInteger)index {
+    return _serviceProtocols[index];
+}
+
++ (Protocol *)unregisteredProtocolAtIndex:(NSUInteger)index {
+    return _unregisteredProtocols[index];
+}
+
++ (Protocol *)adapterProtocol {
+    return _adapterProtocols.firstObject;
+}
+
+@end
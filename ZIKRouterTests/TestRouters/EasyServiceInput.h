@@ -17,4 +17,11 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+/// Registered with a static factory table.
+@protocol TableServiceInput <ZIKServiceRoutable>
+
+@property (nonatomic, copy, nullable) NSString *title;
+
+@end
+
 NS_ASSUME_NONNULL_END
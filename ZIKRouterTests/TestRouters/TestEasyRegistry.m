@@ -13,10 +13,19 @@
 #import "EasyAViewInput.h"
 #import "AViewController.h"
 
+static id _makeTableService(ZIKPerformRouteConfiguration *config) {
+    return [AService new];
+}
+
+static const ZIKDestinationFactoryEntry kServiceFactories[] = {
+    {"TableServiceInput", "AService", _makeTableService},
+};
+
 @implementation TestEasyRegistry
 
 + (void)registerRoutableDestination {
     [ZIKServiceRouter registerServiceProtocol:ZIKRoutable(EasyServiceInput) forMakingService:[AService class]];
+    [ZIKServiceRouter registerServiceFactoryTable:kServiceFactories count:sizeof(kServiceFactories) / sizeof(kServiceFactories[0])];
     [ZIKViewRouter registerViewProtocol:ZIKRoutable(EasyAViewInput) forMakingView:[AViewController class]];
 }
 
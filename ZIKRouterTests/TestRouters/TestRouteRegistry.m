@@ -27,6 +27,7 @@
 #import "BSubviewModuleRouter.h"
 
 #import "TestEasyRegistry.h"
+#import "BenchmarkRegistry.h"
 
 @import ZIKRouter.Internal;
 
@@ -41,6 +42,7 @@
     [self registerSubViewRouter];
     [self registerSubviewModuleRouter];
     [TestEasyRegistry registerRoutableDestination];
+    [BenchmarkRegistry registerRoutableDestination];
     [ZIKRouteRegistry notifyRegistrationFinished];
 }
 
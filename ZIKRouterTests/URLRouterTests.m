@@ -196,4 +196,102 @@
     XCTAssertEqualObjects(result.url.absoluteString, @"://host/path");
 }
 
+- (void)testResultCache {
+    _router.resultCacheLimit = 1;
+    [_router registerURLPattern:@"app://host/:key"];
+    ZIKURLRouteResult *result = [_router resultForURL:@"app://host/value?k=1"];
+    XCTAssert([result.identifier isEqualToString:@"app://host/:key"]);
+    result = [_router resultForURL:@"app://host/value?k=1"];
+    XCTAssert([result.identifier isEqualToString:@"app://host/:key"]);
+    XCTAssertEqualObjects(result.parameters[@"key"], @"value");
+    XCTAssertEqualObjects(result.parameters[@"k"], @"1");
+    
+    result = [_router resultForURL:@"app://host/value2"];
+    XCTAssertEqualObjects(result.parameters[@"key"], @"value2");
+    
+    [_router registerURLPattern:@"app://host/value"];
+    result = [_router resultForURL:@"app://host/value?k=1"];
+    XCTAssert([result.identifier isEqualToString:@"app://host/value"]);
+    XCTAssertNil(result.parameters[@"key"]);
+}
+
+- (void)testPatternTable {
+    [_router registerURLPattern:@"app://host/path"];
+    [_router registerURLPattern:@"app://host/:key1/path/:key2"];
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"URLRouterTestsPatternTable"];
+    XCTAssert([[_router patternTableData] writeToFile:path atomically:YES]);
+    
+    ZIKURLRouter *router = [ZIKURLRouter new];
+    XCTAssert([router loadPatternTableFromFile:path]);
+    ZIKURLRouteResult *result = [router resultForURL:@"app://host/path"];
+    XCTAssert([result.identifier isEqualToString:@"app://host/path"]);
+    result = [router resultForURL:@"app://host/value1/path/value2"];
+    XCTAssert([result.identifier isEqualToString:@"app://host/:key1/path/:key2"]);
+    XCTAssertEqualObjects(result.parameters[@"key1"], @"value1");
+    XCTAssertEqualObjects(result.parameters[@"key2"], @"value2");
+    
+    [router registerURLPattern:@"app://host/path2"];
+    result = [router resultForURL:@"app://host/path2"];
+    XCTAssert([result.identifier isEqualToString:@"app://host/path2"]);
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+}
+
+- (void)testTypedPlaceholderAndWildcard {
+    [_router registerURLPattern:@"app://host/user/:id(int)"];
+    [_router registerURLPattern:@"app://host/user/:name([a-z]+)"];
+    [_router registerURLPattern:@"app://host/user/:key"];
+    [_router registerURLPattern:@"app://host/files/*path"];
+    
+    ZIKURLRouteResult *result = [_router resultForURL:@"app://host/user/123"];
+    XCTAssert([result.identifier isEqualToString:@"app://host/user/:id(int)"]);
+    XCTAssertEqualObjects(result.parameters[@"id"], @"123");
+    
+    result = [_router resultForURL:@"app://host/user/abc"];
+    XCTAssert([result.identifier isEqualToString:@"app://host/user/:name([a-z]+)"]);
+    XCTAssertEqualObjects(result.parameters[@"name"], @"abc");
+    
+    result = [_router resultForURL:@"app://host/user/Abc1"];
+    XCTAssert([result.identifier isEqualToString:@"app://host/user/:key"]);
+    
+    result = [_router resultForURL:@"app://host/files/a/b/c.txt"];
+    XCTAssert([result.identifier isEqualToString:@"app://host/files/*path"]);
+    XCTAssertEqualObjects(result.parameters[@"path"], @"a/b/c.txt");
+    XCTAssertNil([_router resultForURL:@"app://host/files"]);
+}
+
+- (void)testPrewarmedResult {
+    [_router registerURLPattern:@"app://host/item/:id"];
+    for (NSInteger i = 0; i < 5; i++) {
+        NSString *url = [NSString stringWithFormat:@"app://host/item/%ld", (long)i];
+        [_router storePrewarmedResult:[_router resultForURL:url]];
+    }
+    // Least recently stored result is discarded
+    XCTAssertNil([_router takePrewarmedResultForURL:@"app://host/item/0"]);
+    ZIKURLRouteResult *result = [_router takePrewarmedResultForURL:@"app://host/item/4"];
+    XCTAssertEqualObjects(result.parameters[@"id"], @"4");
+    // Each result is taken once
+    XCTAssertNil([_router takePrewarmedResultForURL:@"app://host/item/4"]);
+    
+    // Registering pattern discards prewarmed results
+    [_router registerURLPattern:@"app://host/other"];
+    XCTAssertNil([_router takePrewarmedResultForURL:@"app://host/item/3"]);
+}
+
+- (void)testLongURLWithEscapes {
+    [_router registerURLPattern:@"app://host/item list/:id"];
+    // Delimiters and escapes across 16-byte boundaries and in the tail
+    NSString *url = @"app://host/item%20list/a%2Fb?utm_source=newsletter_campaign_2019&utm_medium=email&name=%E4%BA%8C%20x&empty=&flag&k=a=b&last=%zz";
+    ZIKURLRouteResult *result = [_router resultForURL:url];
+    XCTAssertEqualObjects(result.identifier, @"app://host/item list/:id");
+    XCTAssertEqualObjects(result.parameters[@"id"], @"a/b");
+    XCTAssertEqualObjects(result.parameters[@"utm_source"], @"newsletter_campaign_2019");
+    XCTAssertEqualObjects(result.parameters[@"utm_medium"], @"email");
+    XCTAssertEqualObjects(result.parameters[@"name"], @"二 x");
+    XCTAssertEqualObjects(result.parameters[@"empty"], @"");
+    XCTAssertNil(result.parameters[@"flag"]);
+    XCTAssertEqualObjects(result.parameters[@"k"], @"a=b");
+    // Invalid escape is kept as is
+    XCTAssertEqualObjects(result.parameters[@"last"], @"%zz");
+}
+
 @end
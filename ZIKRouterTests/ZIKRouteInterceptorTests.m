@@ -0,0 +1,123 @@
+//
+//  ZIKRouteInterceptorTests.m
+//  ZIKRouterTests
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import "ZIKRouterTestCase.h"
+@import ZIKRouter;
+@import ZIKRouter.Internal;
+#import "AServiceInput.h"
+
+static char kHighPriorityInterceptorKey;
+static char kFirstInterceptorKey;
+static char kSecondInterceptorKey;
+
+@interface ZIKRouteInterceptorTests : ZIKRouterTestCase
+@property (nonatomic, strong) NSMutableArray<NSString *> *invokedInterceptors;
+@end
+
+@implementation ZIKRouteInterceptorTests
+
+- (void)setUp {
+    [super setUp];
+    self.invokedInterceptors = [NSMutableArray array];
+}
+
+- (void)tearDown {
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointBeforePerform, nil, 0, &kHighPriorityInterceptorKey);
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointBeforePerform, nil, 0, &kFirstInterceptorKey);
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointBeforePerform, nil, 0, &kSecondInterceptorKey);
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointAfterPerform, nil, 0, &kFirstInterceptorKey);
+    [super tearDown];
+}
+
+- (void(^)(ZIKRouter *, ZIKPerformRouteConfiguration *))interceptorWithName:(NSString *)name {
+    __weak typeof(self) weakSelf = self;
+    return ^(ZIKRouter *router, ZIKPerformRouteConfiguration *configuration) {
+        [weakSelf.invokedInterceptors addObject:name];
+    };
+}
+
+- (void)testInterceptorsAreInvokedInPriorityOrder {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completionHandler"];
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointBeforePerform, [self interceptorWithName:@"first"], 0, &kFirstInterceptorKey);
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointBeforePerform, [self interceptorWithName:@"high"], 10, &kHighPriorityInterceptorKey);
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointBeforePerform, [self interceptorWithName:@"second"], 0, &kSecondInterceptorKey);
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointAfterPerform, [self interceptorWithName:@"after"], 0, &kFirstInterceptorKey);
+    @autoreleasepool {
+        [self enterTest];
+        self.router = [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.completionHandler = ^(BOOL success, id  _Nullable destination, ZIKRouteAction  _Nonnull routeAction, NSError * _Nullable error) {
+                self.destination = destination;
+                XCTAssertTrue(success);
+                [expectation fulfill];
+                [self handle:^{
+                    // Higher priority first, then adding order, and interceptors after performing are invoked last
+                    NSArray *expected = @[@"high", @"first", @"second", @"after"];
+                    XCTAssertEqualObjects(self.invokedInterceptors, expected);
+                    [self leaveTest];
+                }];
+            };
+        }];
+    }
+
+    [self waitForExpectationsWithTimeout:5 handler:^(NSError * _Nullable error) {
+        !error? : NSLog(@"%@", error);
+    }];
+}
+
+- (void)testInterceptorWithSameKeyIsReplacedAndRemoved {
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointBeforePerform, [self interceptorWithName:@"replaced"], 0, &kFirstInterceptorKey);
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointBeforePerform, [self interceptorWithName:@"first"], 0, &kFirstInterceptorKey);
+    [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+
+    }];
+    XCTAssertEqualObjects(self.invokedInterceptors, @[@"first"]);
+
+    [self.invokedInterceptors removeAllObjects];
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointBeforePerform, nil, 0, &kFirstInterceptorKey);
+    [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+
+    }];
+    XCTAssertEqual(self.invokedInterceptors.count, 0);
+}
+
+- (void)testCancellingInInterceptorSkipsRestOfChain {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completionHandler"];
+    __weak typeof(self) weakSelf = self;
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointBeforePerform, ^(ZIKRouter *router, ZIKPerformRouteConfiguration *configuration) {
+        [weakSelf.invokedInterceptors addObject:@"high"];
+        [configuration.cancellationToken cancel];
+    }, 10, &kHighPriorityInterceptorKey);
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointBeforePerform, [self interceptorWithName:@"first"], 0, &kFirstInterceptorKey);
+    zix_setRouteInterceptor(ZIKRouteInterceptionPointAfterPerform, [self interceptorWithName:@"after"], 0, &kFirstInterceptorKey);
+    @autoreleasepool {
+        [self enterTest];
+        self.router = [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.cancellationToken = [[ZIKRouteCancellationToken alloc] init];
+            config.prepareDestination = ^(id  _Nonnull destination) {
+                XCTFail(@"Destination should not be made after interceptor cancelled performing");
+            };
+            config.completionHandler = ^(BOOL success, id  _Nullable destination, ZIKRouteAction  _Nonnull routeAction, NSError * _Nullable error) {
+                XCTAssertFalse(success);
+                XCTAssertNil(destination);
+                XCTAssertEqual(error.code, ZIKRouteErrorActionFailed);
+                [expectation fulfill];
+                [self handle:^{
+                    XCTAssertEqualObjects(self.invokedInterceptors, @[@"high"]);
+                    XCTAssert(self.router == nil || self.router.state == ZIKRouterStateUnrouted);
+                    [self leaveTest];
+                }];
+            };
+        }];
+    }
+
+    [self waitForExpectationsWithTimeout:5 handler:^(NSError * _Nullable error) {
+        !error? : NSLog(@"%@", error);
+    }];
+}
+
+@end
@@ -0,0 +1,317 @@
+//
+//  ZIKRouteRegistryTests.m
+//  ZIKRouterTests
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "AServiceRouter.h"
+#import "AServiceInput.h"
+#import "BenchmarkRegistry.h"
+#import "AService.h"
+#import <objc/runtime.h>
+#import <dlfcn.h>
+#import <mach-o/loader.h>
+@import ZIKRouter;
+@import ZIKRouter.Internal;
+
+@interface ZIKRouteRegistryTests : XCTestCase
+
+@end
+
+/// Names of default routers of each destination class. Routes are named with their class and name, because they are created again when registering.
+static NSDictionary<NSString *, NSString *> *_defaultRouterNames(Class registry) {
+    CFDictionaryRef map = [registry destinationToDefaultRouterMap];
+    CFIndex count = CFDictionaryGetCount(map);
+    const void **keys = malloc(sizeof(void *) * count);
+    const void **values = malloc(sizeof(void *) * count);
+    CFDictionaryGetKeysAndValues(map, keys, values);
+    NSMutableDictionary<NSString *, NSString *> *names = [NSMutableDictionary dictionaryWithCapacity:count];
+    for (CFIndex i = 0; i < count; i++) {
+        id route = (__bridge id)values[i];
+        NSString *name = object_isClass(route) ? NSStringFromClass(route) : [NSString stringWithFormat:@"%@(%@)", [route class], [(ZIKRoute *)route name]];
+        names[NSStringFromClass((__bridge Class)keys[i])] = name;
+    }
+    free(keys);
+    free(values);
+    return names;
+}
+
+@implementation ZIKRouteRegistryTests
+
+- (void)testRouterInSection {
+    NSMutableArray<Class> *routers = [NSMutableArray array];
+    zix_enumerateClassesInSection(ZIKROUTER_ROUTES_SECTION, ^(__unsafe_unretained Class  _Nonnull aClass) {
+        [routers addObject:aClass];
+    });
+    XCTAssertTrue([routers containsObject:[AServiceRouter class]]);
+    XCTAssertFalse([routers containsObject:[ZIKServiceRouter class]]);
+}
+
+- (void)testConcurrentClassEnumeration {
+    NSMutableArray<Class> *serialRouters = [NSMutableArray array];
+    zix_enumerateClassesInMainBundleForParentClass([ZIKRouter class], ^(__unsafe_unretained Class  _Nonnull aClass) {
+        [serialRouters addObject:aClass];
+    });
+    NSMutableArray<Class> *concurrentRouters = [NSMutableArray array];
+    zix_enumerateClassesInMainBundleForParentClassConcurrently([ZIKRouter class], ^(__unsafe_unretained Class  _Nonnull aClass) {
+        XCTAssertTrue([NSThread isMainThread]);
+        [concurrentRouters addObject:aClass];
+    });
+    XCTAssertTrue(serialRouters.count > 0);
+    XCTAssertEqualObjects(serialRouters, concurrentRouters);
+}
+
+- (void)testRouterBaseClass {
+    XCTAssertEqual([ZIKViewRouteRegistry routerBaseClass], [ZIKViewRouter class]);
+    XCTAssertEqual([ZIKServiceRouteRegistry routerBaseClass], [ZIKServiceRouter class]);
+    XCTAssertFalse(ZIKRouteRegistry.registersRegistriesConcurrently);
+    NSMutableArray<Class> *serviceRouters = [NSMutableArray array];
+    zix_enumerateClassesInMainBundleForParentClass([ZIKRouter class], ^(__unsafe_unretained Class  _Nonnull aClass) {
+        if (zix_classIsSubclassOfClass(aClass, [ZIKServiceRouteRegistry routerBaseClass])) {
+            [serviceRouters addObject:aClass];
+        }
+    });
+    XCTAssertTrue([serviceRouters containsObject:[AServiceRouter class]]);
+    XCTAssertFalse([serviceRouters containsObject:[ZIKServiceRouter class]]);
+}
+
+- (void)testImageUUID {
+    const void *header = zix_imageHeaderOfClass([AServiceRouter class]);
+    XCTAssertTrue(header != NULL);
+    __block BOOL enumerated = NO;
+    zix_enumerateCustomImages(^(const void * _Nonnull image) {
+        enumerated = enumerated || image == header;
+    });
+    XCTAssertTrue(enumerated);
+    NSString *uuid = zix_imageUUIDString(header);
+    XCTAssertNotNil([[NSUUID alloc] initWithUUIDString:uuid]);
+    XCTAssertEqualObjects(uuid, zix_imageUUIDString(header));
+}
+
+- (void)testClassSet {
+    ZIKClassSet *set = zix_createClassSet(4);
+    XCTAssertFalse(zix_classSetContainsClass(set, [NSObject class]));
+    XCTAssertTrue(zix_classSetAddClass(set, [NSObject class]));
+    XCTAssertTrue(zix_classSetAddClass(set, [NSObject class]));
+    XCTAssertTrue(zix_classSetContainsClass(set, [NSObject class]));
+    XCTAssertFalse(zix_classSetContainsClass(set, [NSString class]));
+    
+    // Minimum capacity is 16, further classes are rejected
+    NSArray<Class> *classes = @[[NSString class], [NSArray class], [NSDictionary class], [NSSet class], [NSNumber class], [NSData class], [NSDate class], [NSURL class], [NSUUID class], [NSValue class], [NSError class], [NSThread class], [NSLock class], [NSTimer class], [NSBundle class], [NSProxy class]];
+    for (Class aClass in classes) {
+        zix_classSetAddClass(set, aClass);
+    }
+    XCTAssertFalse(zix_classSetAddClass(set, [NSIndexSet class]));
+    XCTAssertFalse(zix_classSetContainsClass(set, [NSIndexSet class]));
+    XCTAssertTrue(zix_classSetContainsClass(set, [NSObject class]));
+}
+
+- (void)testRoutableRootClass {
+    XCTAssertEqual([ZIKServiceRouteRegistry routableRootClassOfDestinationClass:[AService class]], [AService class]);
+    XCTAssertNil([ZIKServiceRouteRegistry routableRootClassOfDestinationClass:[NSObject class]]);
+    
+    Class subclass = objc_allocateClassPair([AService class], "ZIKRouteRegistryTestsAServiceSubclass", 0);
+    objc_registerClassPair(subclass);
+    XCTAssertEqual([ZIKServiceRouteRegistry routableRootClassOfDestinationClass:subclass], [AService class]);
+    XCTAssertEqualObjects([ZIKServiceRouteRegistry routerToRegisteredDestinationClass:subclass].routeObject, [ZIKServiceRouteRegistry routerToRegisteredDestinationClass:[AService class]].routeObject);
+}
+
+- (void)testImagePrefilter {
+    Dl_info info;
+    XCTAssertNotEqual(dladdr((__bridge const void *)[ZIKRouter class], &info), 0);
+    const struct mach_header *routerImage = info.dli_fbase;
+    XCTAssertTrue(zix_imageMayContainSubclassOfClass(routerImage, [ZIKRouter class]));
+    XCTAssertNotEqual(dladdr((__bridge const void *)[AServiceRouter class], &info), 0);
+    XCTAssertTrue(zix_imageMayContainSubclassOfClass(info.dli_fbase, [ZIKRouter class]));
+    if (routerImage->filetype == MH_DYLIB) {
+        // libobjc never links the router framework
+        XCTAssertNotEqual(dladdr((__bridge const void *)[NSObject class], &info), 0);
+        XCTAssertFalse(zix_imageMayContainSubclassOfClass(info.dli_fbase, [ZIKRouter class]));
+    }
+}
+
+- (void)testClassOverridesMethod {
+    SEL selector = @selector(destinationWithConfiguration:);
+    XCTAssertTrue(zix_classSelfImplementingMethod([AServiceRouter class], selector, false));
+    XCTAssertTrue(zix_classSelfImplementingMethod([AServiceRouter class], selector, false));
+    XCTAssertTrue(zix_classOverridesMethodOfClass([AServiceRouter class], [ZIKServiceRouter class], selector, false));
+    XCTAssertFalse(zix_classOverridesMethodOfClass([AServiceRouter class], [ZIKServiceRouter class], @selector(performRoute), false));
+    XCTAssertFalse(zix_classOverridesMethodOfClass([AService class], [ZIKServiceRouter class], @selector(description), false));
+}
+
+- (void)testIdentifierHandle {
+    ZIKRouteIdentifierHandle handle = [ZIKRouter handleForIdentifier:@"ZIKRouteRegistryTests.identifier"];
+    XCTAssertNotEqual(handle, 0);
+    XCTAssertEqual(handle, [ZIKRouter handleForIdentifier:[@"ZIKRouteRegistryTests." stringByAppendingString:@"identifier"]]);
+    XCTAssertNotEqual(handle, [ZIKRouter handleForIdentifier:@"ZIKRouteRegistryTests.identifier2"]);
+    XCTAssertNil([ZIKServiceRouteRegistry routerToIdentifierHandle:handle]);
+    XCTAssertNil([ZIKServiceRouteRegistry routerToIdentifierHandle:0]);
+}
+
+- (void)testLookupCounters {
+    ZIKRouterMetrics *before = [ZIKRouterMetrics currentMetrics];
+    XCTAssertNotNil([ZIKServiceRouteRegistry routerToDestination:@protocol(AServiceInput)]);
+    XCTAssertNil([ZIKServiceRouteRegistry routerToDestination:[BenchmarkRegistry unregisteredProtocolAtIndex:0]]);
+    ZIKRouterMetrics *metrics = [[ZIKRouterMetrics currentMetrics] metricsBySubtractingMetrics:before];
+    XCTAssertGreaterThanOrEqual([metrics valueForCounter:ZIKRouterCounterServiceLookup], 2);
+    XCTAssertGreaterThanOrEqual([metrics valueForCounter:ZIKRouterCounterServiceLookupMiss], 1);
+    XCTAssertEqualObjects(metrics.dictionaryRepresentation[@"serviceLookup"], @([metrics valueForCounter:ZIKRouterCounterServiceLookup]));
+}
+
+- (void)testFlattenedAdapterChain {
+    Protocol *adapter = [BenchmarkRegistry adapterProtocol];
+    ZIKRouterMetrics *before = [ZIKRouterMetrics currentMetrics];
+    ZIKRouterType *routerType = [ZIKServiceRouteRegistry routerToDestination:adapter];
+    ZIKRouterMetrics *metrics = [[ZIKRouterMetrics currentMetrics] metricsBySubtractingMetrics:before];
+    XCTAssertEqualObjects(routerType.routeObject, [ZIKServiceRouteRegistry routerToDestination:[BenchmarkRegistry serviceProtocolAtIndex:0]].routeObject);
+    XCTAssertEqual([metrics valueForCounter:ZIKRouterCounterAdapterHop], 0);
+}
+
+- (void)testRouteHandle {
+    ZIKRouteHandle<ZIKServiceRouterType<id<AServiceInput>, ZIKPerformRouteConfiguration *> *> *handle = ZIKRouteHandleToService(AServiceInput);
+    XCTAssertFalse(handle.isValid);
+    ZIKServiceRouterType *routerType = handle.routerType;
+    XCTAssertNotNil(routerType);
+    XCTAssertTrue(handle.isValid);
+    XCTAssertEqual(handle.generation, ZIKRouteRegistry.routesGeneration);
+    XCTAssertEqual(handle.routerType, routerType);
+    
+    [ZIKRouteRegistry invalidateResolvedRoutes];
+    XCTAssertFalse(handle.isValid);
+    XCTAssertEqualObjects(handle.routerType.routeObject, routerType.routeObject);
+    XCTAssertTrue(handle.isValid);
+}
+
+- (void)testRouteTrace {
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"ZIKRouteTraceTests.json"];
+    XCTAssertTrue([ZIKRouter startTracingToFile:path]);
+    XCTAssertFalse([ZIKRouter startTracingToFile:path]);
+    XCTAssertTrue(ZIKRouter.isTracing);
+    ZIKServiceRouter *router = [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+        
+    }];
+    [ZIKRouter stopTracing];
+    XCTAssertFalse(ZIKRouter.isTracing);
+    
+    NSData *data = [NSData dataWithContentsOfFile:path];
+    XCTAssertNotNil(data);
+    NSArray<NSDictionary *> *events = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+    XCTAssertTrue([events isKindOfClass:[NSArray class]]);
+    NSUInteger index = [events indexOfObjectPassingTest:^BOOL(NSDictionary * _Nonnull event, NSUInteger idx, BOOL * _Nonnull stop) {
+        return [event[@"cat"] isEqualToString:@"route"] && [event[@"name"] isEqualToString:NSStringFromClass([router class])];
+    }];
+    XCTAssertNotEqual(index, NSNotFound);
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+}
+
+- (void)testUnregisterRoute {
+    NSString *identifier = @"ZIKRouteRegistryTests.unregisterRoute";
+    __weak ZIKServiceRoute *weakRoute;
+    @autoreleasepool {
+        ZIKServiceRoute *route = [ZIKServiceRoute makeRouteWithDestination:[AService class] makeDestination:^id _Nullable(ZIKPerformRouteConfig * _Nonnull config, ZIKRouter * _Nonnull router) {
+            return [[AService alloc] init];
+        }];
+        route.registerIdentifier(identifier);
+        weakRoute = route;
+        XCTAssertEqual([ZIKServiceRouteRegistry routerToIdentifier:identifier].routeObject, route);
+        
+        uint64_t generation = ZIKRouteRegistry.routesGeneration;
+        [ZIKServiceRouteRegistry unregisterRoute:route];
+        XCTAssertNil([ZIKServiceRouteRegistry routerToIdentifier:identifier]);
+        XCTAssertGreaterThan(ZIKRouteRegistry.routesGeneration, generation);
+    }
+    XCTAssertNil(weakRoute);
+    // Other routers of the destination class are still registered
+    XCTAssertNotNil([ZIKServiceRouteRegistry routerToDestination:@protocol(AServiceInput)]);
+}
+
+- (void)testMemoryFootprint {
+    NSDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *footprint = ZIKServiceRouteRegistry.memoryFootprint;
+    XCTAssertGreaterThan([footprint[@"destinationProtocolToRouterMap"][@"count"] unsignedIntegerValue], 0);
+    XCTAssertGreaterThan([footprint[@"destinationProtocolToRouterMap"][@"bytes"] unsignedIntegerValue], 0);
+    
+    NSDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *allFootprint = ZIKRouteRegistry.memoryFootprint;
+    XCTAssertNotNil(allFootprint[@"ZIKServiceRouteRegistry.destinationProtocolToRouterMap"]);
+    XCTAssertNotNil(allFootprint[@"factoryBlocks"]);
+}
+
+- (void)testRouteTableKeepsDefaultRouters {
+    const void *header = zix_imageHeaderOfClass([AServiceRouter class]);
+    NSDictionary *table = [ZIKRouteRegistry reregisterRoutersInImageRecordingRouteTable:header];
+    NSDictionary *enumeratedViewRouters = _defaultRouterNames([ZIKViewRouteRegistry class]);
+    NSDictionary *enumeratedServiceRouters = _defaultRouterNames([ZIKServiceRouteRegistry class]);
+    XCTAssertGreaterThan(enumeratedServiceRouters.count, 0);
+    
+    NSString *registryName = NSStringFromClass([ZIKServiceRouteRegistry class]);
+    NSString *routerName = NSStringFromClass([AServiceRouter class]);
+    XCTAssertNotNil(table[@"registries"][registryName][routerName]);
+    XCTAssertTrue([table[@"order"][registryName] containsObject:routerName]);
+    XCTAssertEqual([table[@"order"][registryName] count], [table[@"registries"][registryName] count]);
+    XCTAssertTrue([table[@"images"] containsObject:zix_imageUUIDString(header)]);
+    
+    // Plist keeps the order of routers
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:table format:NSPropertyListBinaryFormat_v1_0 options:0 error:nil];
+    NSDictionary *loadedTable = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:NULL];
+    XCTAssertEqualObjects(loadedTable[@"order"], table[@"order"]);
+    XCTAssertTrue([ZIKRouteRegistry reregisterRoutersInImage:header withRouteTable:loadedTable]);
+    XCTAssertEqualObjects(_defaultRouterNames([ZIKViewRouteRegistry class]), enumeratedViewRouters);
+    XCTAssertEqualObjects(_defaultRouterNames([ZIKServiceRouteRegistry class]), enumeratedServiceRouters);
+    XCTAssertNotNil([ZIKServiceRouteRegistry routerToDestination:@protocol(AServiceInput)]);
+}
+
+- (void)testStaleRouteTable {
+    const void *header = zix_imageHeaderOfClass([AServiceRouter class]);
+    NSDictionary *table = [ZIKRouteRegistry reregisterRoutersInImageRecordingRouteTable:header];
+    
+    // Table recorded from another build of the image
+    NSMutableDictionary *rebuiltImageTable = [table mutableCopy];
+    rebuiltImageTable[@"images"] = @[[NSUUID UUID].UUIDString];
+    XCTAssertFalse([ZIKRouteRegistry reregisterRoutersInImage:header withRouteTable:rebuiltImageTable]);
+    
+    NSMutableDictionary *otherVersionTable = [table mutableCopy];
+    otherVersionTable[@"version"] = [ZIKRouteRegistry.routeTableVersion stringByAppendingString:@".1"];
+    XCTAssertFalse([ZIKRouteRegistry reregisterRoutersInImage:header withRouteTable:otherVersionTable]);
+    
+    // Table written without order of routers
+    NSMutableDictionary *unorderedTable = [table mutableCopy];
+    [unorderedTable removeObjectForKey:@"order"];
+    XCTAssertFalse([ZIKRouteRegistry reregisterRoutersInImage:header withRouteTable:unorderedTable]);
+    
+    NSMutableDictionary *missingRouterTable = [table mutableCopy];
+    NSString *registryName = NSStringFromClass([ZIKServiceRouteRegistry class]);
+    NSMutableDictionary *orders = [table[@"order"] mutableCopy];
+    orders[registryName] = [table[@"order"][registryName] arrayByAddingObject:@"ZIKRouteRegistryTestsRemovedRouter"];
+    missingRouterTable[@"order"] = orders;
+    XCTAssertFalse([ZIKRouteRegistry reregisterRoutersInImage:header withRouteTable:missingRouterTable]);
+    
+    // Stale table doesn't unregister anything
+    XCTAssertNotNil([ZIKServiceRouteRegistry routerToDestination:@protocol(AServiceInput)]);
+    XCTAssertTrue([ZIKRouteRegistry reregisterRoutersInImage:header withRouteTable:table]);
+}
+
+- (void)testExportRegistry {
+    NSData *data = [ZIKRouteRegistry exportedRegistryJSONData];
+    XCTAssertNotNil(data);
+    NSDictionary *exported = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+    XCTAssertEqualObjects(exported[@"version"], @1);
+    NSArray<NSDictionary *> *routes = exported[@"registries"][NSStringFromClass([ZIKServiceRouteRegistry class])][@"routes"];
+    NSUInteger index = [routes indexOfObjectPassingTest:^BOOL(NSDictionary * _Nonnull route, NSUInteger idx, BOOL * _Nonnull stop) {
+        return [route[@"name"] isEqualToString:NSStringFromClass([AServiceRouter class])];
+    }];
+    XCTAssertNotEqual(index, NSNotFound);
+    NSDictionary *route = routes[index];
+    XCTAssertEqualObjects(route[@"kind"], @"router");
+    XCTAssertTrue([route[@"destinationProtocols"] containsObject:NSStringFromProtocol(@protocol(AServiceInput))]);
+    XCTAssertNotNil(exported[@"images"][route[@"image"]]);
+    
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"ZIKRouteRegistryExportTests.json"];
+    NSError *error;
+    XCTAssertTrue([ZIKRouteRegistry exportRegistryToFile:path error:&error], @"%@", error);
+    XCTAssertEqualObjects([NSData dataWithContentsOfFile:path], data);
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+}
+
+@end
@@ -0,0 +1,143 @@
+//
+//  ZIKRouterAllocationTests.m
+//  ZIKRouterTests
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <pthread.h>
+#import "AServiceInput.h"
+#import "AServiceModuleInput.h"
+#import "AViewInput.h"
+#import "EasyServiceInput.h"
+#import "TestConfig.h"
+@import ZIKRouter;
+
+/// Hook of libmalloc for Instruments, called after each allocation and deallocation in malloc zones.
+typedef void (ZIKMallocLogger)(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t numHotFramesToSkip);
+extern ZIKMallocLogger *malloc_logger;
+/// MALLOC_LOG_TYPE_ALLOCATE in libmalloc. Reallocation is logged as allocation and deallocation.
+static const uint32_t ZIKMallocLogTypeAllocate = 2;
+
+static const NSUInteger kWarmUpCount = 10;
+static const NSUInteger kIterationCount = 100;
+
+static ZIKMallocLogger *_previousLogger;
+static pthread_t _countingThread;
+static uint64_t _allocationCount;
+
+static void _countAllocation(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t numHotFramesToSkip) {
+    if ((type & ZIKMallocLogTypeAllocate) && pthread_equal(pthread_self(), _countingThread)) {
+        _allocationCount++;
+    }
+    if (_previousLogger) {
+        _previousLogger(type, arg1, arg2, arg3, result, numHotFramesToSkip + 1);
+    }
+}
+
+/**
+ Upper bounds of heap allocations in one route, including configurations, router types, blocks, errors and the destination itself. Allocations on other threads are not counted.
+
+ When a test fails, find the new allocations with Allocations instrument. Lower the bound when allocations are removed.
+ */
+@interface ZIKRouterAllocationTests : XCTestCase
+
+@end
+
+@implementation ZIKRouterAllocationTests
+
+- (void)tearDown {
+    [super tearDown];
+    TestConfig.routeShouldFail = NO;
+}
+
+/// Average count of allocations on current thread in each call of block, don't assert in the block. Block is called several times first, so lazily created caches are not counted.
+- (NSUInteger)allocationsPerRoute:(void(NS_NOESCAPE ^)(void))block {
+    for (NSUInteger i = 0; i < kWarmUpCount; i++) {
+        @autoreleasepool {
+            block();
+        }
+    }
+    _countingThread = pthread_self();
+    _allocationCount = 0;
+    _previousLogger = malloc_logger;
+    malloc_logger = _countAllocation;
+    for (NSUInteger i = 0; i < kIterationCount; i++) {
+        @autoreleasepool {
+            block();
+        }
+    }
+    malloc_logger = _previousLogger;
+    _previousLogger = NULL;
+    return (NSUInteger)(_allocationCount / kIterationCount);
+}
+
+- (void)testServiceMakeDestinationAllocations {
+    XCTAssertNotNil([ZIKRouterToService(AServiceInput) makeDestination]);
+    NSUInteger count = [self allocationsPerRoute:^{
+        [ZIKRouterToService(AServiceInput) makeDestination];
+    }];
+    NSLog(@"Allocations of service makeDestination: %@", @(count));
+    XCTAssertLessThanOrEqual(count, 40);
+}
+
+- (void)testEasyServiceMakeDestinationAllocations {
+    XCTAssertNotNil([ZIKRouterToService(EasyServiceInput) makeDestination]);
+    NSUInteger count = [self allocationsPerRoute:^{
+        [ZIKRouterToService(EasyServiceInput) makeDestination];
+    }];
+    NSLog(@"Allocations of easy service makeDestination: %@", @(count));
+    // Factory is called without router, only the configuration and the destination
+    XCTAssertLessThanOrEqual(count, 10);
+}
+
+- (void)testServiceModuleMakeDestinationAllocations {
+    XCTAssertNotNil([ZIKRouterToServiceModule(AServiceModuleInput) makeDestination]);
+    NSUInteger count = [self allocationsPerRoute:^{
+        [ZIKRouterToServiceModule(AServiceModuleInput) makeDestinationWithPreparation:^(id<AServiceInput>  _Nonnull destination) {
+            destination.title = @"test title";
+        }];
+    }];
+    NSLog(@"Allocations of service module makeDestination: %@", @(count));
+    XCTAssertLessThanOrEqual(count, 50);
+}
+
+- (void)testViewMakeDestinationAllocations {
+    XCTAssertNotNil([ZIKRouterToView(AViewInput) makeDestination]);
+    NSUInteger count = [self allocationsPerRoute:^{
+        [ZIKRouterToView(AViewInput) makeDestination];
+    }];
+    NSLog(@"Allocations of view makeDestination: %@", @(count));
+    // Including the view controller and its UIKit states
+    XCTAssertLessThanOrEqual(count, 80);
+}
+
+- (void)testServicePerformAllocations {
+    XCTAssert([ZIKRouterToService(AServiceInput) performRoute].state == ZIKRouterStateRouted);
+    NSUInteger count = [self allocationsPerRoute:^{
+        [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.successHandler = ^(id  _Nonnull destination) {
+
+            };
+        }];
+    }];
+    NSLog(@"Allocations of service perform: %@", @(count));
+    XCTAssertLessThanOrEqual(count, 60);
+}
+
+- (void)testServicePerformFailureAllocations {
+    TestConfig.routeShouldFail = YES;
+    NSUInteger count = [self allocationsPerRoute:^{
+        [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.errorHandler = ^(ZIKRouteAction  _Nonnull routeAction, NSError * _Nonnull error) {
+
+            };
+        }];
+    }];
+    NSLog(@"Allocations of failed service perform: %@", @(count));
+    XCTAssertLessThanOrEqual(count, 70);
+}
+
+@end
@@ -0,0 +1,119 @@
+//
+//  ZIKRouterBenchmarkTests.m
+//  ZIKRouterTests
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "BenchmarkRegistry.h"
+#import "AServiceInput.h"
+#import "ZIKURLRouter.h"
+@import ZIKRouter;
+@import ZIKRouter.Private;
+
+static const NSUInteger kURLPatternCount = 10000;
+static const NSUInteger kLookupRepeatCount = 10;
+
+/// Benchmarks for hot paths. Baselines are recorded per device in Xcode, set them from a release build's run.
+@interface ZIKRouterBenchmarkTests : XCTestCase
+
+@end
+
+@implementation ZIKRouterBenchmarkTests
+
+- (void)measureHotPath:(void(NS_NOESCAPE ^)(void))block {
+    if (@available(iOS 13.0, macOS 10.15, tvOS 13.0, *)) {
+        [self measureWithMetrics:@[[XCTClockMetric new], [XCTCPUMetric new], [XCTMemoryMetric new]] block:block];
+    } else {
+        [self measureBlock:block];
+    }
+}
+
+- (void)testRegistrationOfSyntheticServices {
+    // Registration only happens once in a process, report the duration recorded in TestRouteRegistry's +load
+    XCTAssertEqual(BenchmarkRegistry.serviceCount, 5000);
+    XCTAssertNotNil([ZIKServiceRouteRegistry routerToDestination:[BenchmarkRegistry serviceProtocolAtIndex:BenchmarkRegistry.serviceCount - 1]]);
+    NSLog(@"Registered %@ synthetic services in %.3f ms", @(BenchmarkRegistry.serviceCount), BenchmarkRegistry.registrationDuration * 1000);
+}
+
+- (void)testRouterToDestinationHitPerformance {
+    NSUInteger count = BenchmarkRegistry.serviceCount;
+    [self measureHotPath:^{
+        for (NSUInteger repeat = 0; repeat < kLookupRepeatCount; repeat++) {
+            for (NSUInteger i = 0; i < count; i++) {
+                ZIKRouterType *routerType = [ZIKServiceRouteRegistry routerToDestination:[BenchmarkRegistry serviceProtocolAtIndex:i]];
+                XCTAssertNotNil(routerType);
+            }
+        }
+    }];
+}
+
+- (void)testRouterToDestinationMissPerformance {
+    NSUInteger count = BenchmarkRegistry.serviceCount;
+    [self measureHotPath:^{
+        for (NSUInteger repeat = 0; repeat < kLookupRepeatCount; repeat++) {
+            for (NSUInteger i = 0; i < count; i++) {
+                ZIKRouterType *routerType = [ZIKServiceRouteRegistry routerToDestination:[BenchmarkRegistry unregisteredProtocolAtIndex:i]];
+                XCTAssertNil(routerType);
+            }
+        }
+    }];
+}
+
+- (void)testRouterToDestinationAdapterChainPerformance {
+    Protocol *adapter = [BenchmarkRegistry adapterProtocol];
+    ZIKRouterType *adapteeRouterType = [ZIKServiceRouteRegistry routerToDestination:[BenchmarkRegistry serviceProtocolAtIndex:0]];
+    XCTAssertNotNil(adapteeRouterType);
+    [self measureHotPath:^{
+        for (NSUInteger i = 0; i < BenchmarkRegistry.serviceCount * kLookupRepeatCount; i++) {
+            ZIKRouterType *routerType = [ZIKServiceRouteRegistry routerToDestination:adapter];
+            XCTAssertEqualObjects(routerType.routeObject, adapteeRouterType.routeObject);
+        }
+    }];
+}
+
+- (void)testServiceMakeDestinationPerformance {
+    [self measureHotPath:^{
+        for (NSUInteger i = 0; i < 1000; i++) {
+            @autoreleasepool {
+                id<AServiceInput> destination = [ZIKRouterToService(AServiceInput) makeDestination];
+                XCTAssertNotNil(destination);
+            }
+        }
+    }];
+}
+
+- (void)testSyntheticServiceMakeDestinationPerformance {
+    NSUInteger count = BenchmarkRegistry.serviceCount;
+    [self measureHotPath:^{
+        for (NSUInteger i = 0; i < count; i++) {
+            @autoreleasepool {
+                Protocol *protocol = [BenchmarkRegistry serviceProtocolAtIndex:i];
+                id destination = [ZIKServiceRouter.toService((Protocol<ZIKServiceRoutable> *)protocol) makeDestination];
+                XCTAssertNotNil(destination);
+            }
+        }
+    }];
+}
+
+- (void)testURLMatchingPerformance {
+    ZIKURLRouter *router = [ZIKURLRouter new];
+    for (NSUInteger i = 0; i < kURLPatternCount; i++) {
+        [router registerURLPattern:[NSString stringWithFormat:@"app://module%@/page/:id", @(i)]];
+    }
+    NSMutableArray<NSString *> *urls = [NSMutableArray arrayWithCapacity:kURLPatternCount];
+    for (NSUInteger i = 0; i < kURLPatternCount; i++) {
+        // Spread requests across the table, so matching isn't only measured at the front
+        [urls addObject:[NSString stringWithFormat:@"app://module%@/page/%@?from=benchmark", @((i * 7919) % kURLPatternCount), @(i)]];
+    }
+    [self measureHotPath:^{
+        for (NSString *url in urls) {
+            ZIKURLRouteResult *result = [router resultForURL:url];
+            XCTAssertNotNil(result);
+        }
+    }];
+}
+
+@end
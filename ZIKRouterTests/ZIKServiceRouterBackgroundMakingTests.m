@@ -0,0 +1,158 @@
+//
+//  ZIKServiceRouterBackgroundMakingTests.m
+//  ZIKRouterTests
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import "ZIKRouterTestCase.h"
+@import ZIKRouter;
+#import "AService.h"
+
+static NSString *const kBackgroundServiceIdentifier = @"ZIKServiceRouterBackgroundMakingTests.service";
+
+@interface ZIKServiceRouterBackgroundMakingTests : ZIKRouterTestCase
+@property (nonatomic, strong) ZIKServiceRoute *route;
+@property (nonatomic, strong) dispatch_queue_t performQueue;
+/// Signaled when making destination starts.
+@property (nonatomic, strong) dispatch_semaphore_t makingStarted;
+/// Making destination waits for it.
+@property (nonatomic, strong) dispatch_semaphore_t makingAllowed;
+@property (nonatomic, weak) id madeDestination;
+@end
+
+@implementation ZIKServiceRouterBackgroundMakingTests
+
+- (void)setUp {
+    [super setUp];
+    // Drain autoreleased destinations after each making
+    self.performQueue = dispatch_queue_create("com.zuik.router.test.background_making", dispatch_queue_attr_make_with_autorelease_frequency(DISPATCH_QUEUE_SERIAL, DISPATCH_AUTORELEASE_FREQUENCY_WORK_ITEM));
+    self.makingStarted = dispatch_semaphore_create(0);
+    self.makingAllowed = dispatch_semaphore_create(0);
+    dispatch_semaphore_t makingStarted = self.makingStarted;
+    dispatch_semaphore_t makingAllowed = self.makingAllowed;
+    __weak typeof(self) weakSelf = self;
+    self.route = [ZIKServiceRoute makeRouteWithDestination:[AService class] makeDestination:^id _Nullable(ZIKPerformRouteConfig * _Nonnull config, ZIKRouter * _Nonnull router) {
+        NSCAssert(![NSThread isMainThread], @"Destination should be made on perform queue");
+        dispatch_semaphore_signal(makingStarted);
+        dispatch_semaphore_wait(makingAllowed, DISPATCH_TIME_FOREVER);
+        AService *destination = [[AService alloc] init];
+        weakSelf.madeDestination = destination;
+        return destination;
+    }];
+    self.route.registerIdentifier(kBackgroundServiceIdentifier);
+}
+
+- (void)tearDown {
+    [ZIKServiceRouteRegistry unregisterRoute:self.route];
+    self.route = nil;
+    [super tearDown];
+}
+
+/// Call block on main queue after making on perform queue is finished and its result is handled.
+- (void)afterMakingFinished:(void(^)(void))block {
+    dispatch_async(self.performQueue, ^{
+        dispatch_async(dispatch_get_main_queue(), block);
+    });
+}
+
+- (void)testCancellingTokenDropsLateDestination {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completionHandler"];
+    ZIKRouteCancellationToken *token = [[ZIKRouteCancellationToken alloc] init];
+    @autoreleasepool {
+        [self enterTest];
+        self.router = [[ZIKServiceRouteRegistry routerToIdentifier:kBackgroundServiceIdentifier] performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.performQueue = self.performQueue;
+            config.cancellationToken = token;
+            config.prepareDestination = ^(id  _Nonnull destination) {
+                XCTFail(@"Destination made after cancelling should be dropped");
+            };
+            config.completionHandler = ^(BOOL success, id  _Nullable destination, ZIKRouteAction  _Nonnull routeAction, NSError * _Nullable error) {
+                XCTAssertTrue([NSThread isMainThread]);
+                XCTAssertFalse(success);
+                XCTAssertNil(destination);
+                XCTAssertEqual(error.code, ZIKRouteErrorActionFailed);
+                [expectation fulfill];
+            };
+        }];
+    }
+    XCTAssertEqual(self.router.state, ZIKRouterStateRouting);
+    dispatch_semaphore_wait(self.makingStarted, DISPATCH_TIME_FOREVER);
+    // Cancelling on main thread fails performing immediately
+    [token cancel];
+    XCTAssertFalse([self.router cancelMakingDestination]);
+    dispatch_semaphore_signal(self.makingAllowed);
+    [self afterMakingFinished:^{
+        XCTAssertNil(self.router.destination);
+        XCTAssertNotEqual(self.router.state, ZIKRouterStateRouted);
+        [self leaveTest];
+    }];
+
+    [self waitForExpectationsWithTimeout:5 handler:^(NSError * _Nullable error) {
+        !error? : NSLog(@"%@", error);
+    }];
+    // Late destination is not retained by the router
+    XCTAssertNil(self.madeDestination);
+}
+
+- (void)testTimeoutDropsLateDestination {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completionHandler"];
+    @autoreleasepool {
+        [self enterTest];
+        self.router = [[ZIKServiceRouteRegistry routerToIdentifier:kBackgroundServiceIdentifier] performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.performQueue = self.performQueue;
+            config.destinationMakingTimeout = 0.1;
+            config.prepareDestination = ^(id  _Nonnull destination) {
+                XCTFail(@"Destination made after timeout should be dropped");
+            };
+            config.completionHandler = ^(BOOL success, id  _Nullable destination, ZIKRouteAction  _Nonnull routeAction, NSError * _Nullable error) {
+                XCTAssertFalse(success);
+                XCTAssertEqual(error.code, ZIKRouteErrorDestinationUnavailable);
+                [expectation fulfill];
+                // Finish making after timeout
+                dispatch_semaphore_signal(self.makingAllowed);
+                [self afterMakingFinished:^{
+                    XCTAssertNil(self.router.destination);
+                    [self leaveTest];
+                }];
+            };
+        }];
+    }
+
+    [self waitForExpectationsWithTimeout:5 handler:^(NSError * _Nullable error) {
+        !error? : NSLog(@"%@", error);
+    }];
+    XCTAssertNil(self.madeDestination);
+}
+
+- (void)testCancelMakingDestination {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completionHandler"];
+    @autoreleasepool {
+        [self enterTest];
+        self.router = [[ZIKServiceRouteRegistry routerToIdentifier:kBackgroundServiceIdentifier] performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.performQueue = self.performQueue;
+            config.completionHandler = ^(BOOL success, id  _Nullable destination, ZIKRouteAction  _Nonnull routeAction, NSError * _Nullable error) {
+                XCTAssertFalse(success);
+                XCTAssertEqual(error.code, ZIKRouteErrorActionFailed);
+                [expectation fulfill];
+            };
+        }];
+    }
+    dispatch_semaphore_wait(self.makingStarted, DISPATCH_TIME_FOREVER);
+    XCTAssertTrue([self.router cancelMakingDestination]);
+    // Only the first ending takes effect
+    XCTAssertFalse([self.router cancelMakingDestination]);
+    dispatch_semaphore_signal(self.makingAllowed);
+    [self afterMakingFinished:^{
+        XCTAssertNil(self.router.destination);
+        [self leaveTest];
+    }];
+
+    [self waitForExpectationsWithTimeout:5 handler:^(NSError * _Nullable error) {
+        !error? : NSLog(@"%@", error);
+    }];
+    XCTAssertNil(self.madeDestination);
+}
+
+@end
@@ -0,0 +1,160 @@
+//
+//  ZIKServiceRouterConcurrencyTests.m
+//  ZIKRouterTests
+//
+//  Created by agent on 2026/10/14.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <objc/runtime.h>
+#import "AService.h"
+#import "AServiceInput.h"
+#import "AServiceModuleInput.h"
+#import "BenchmarkRegistry.h"
+@import ZIKRouter;
+@import ZIKRouter.Internal;
+
+static const size_t kConcurrentRouteCount = 2000;
+static const NSUInteger kLateAdapterCount = 50;
+
+/// Stress tests of routing services from many threads. Run them with Thread Sanitizer enabled to find data races.
+@interface ZIKServiceRouterConcurrencyTests : XCTestCase
+
+@end
+
+@implementation ZIKServiceRouterConcurrencyTests
+
+- (void)testConcurrentPerformAndMakeService {
+    void(^originalErrorHandler)(ZIKServiceRouter *, ZIKRouteAction, NSError *) = ZIKServiceRouter.globalErrorHandler;
+    __block uint64_t failureCount = 0;
+
+    // Publish new snapshots while other threads are fetching routers, replaced snapshots must stay valid until lookups reading them return
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        for (NSUInteger i = 0; i < kLateAdapterCount; i++) {
+            Protocol *adapter = objc_allocateProtocol([NSString stringWithFormat:@"ConcurrencyServiceAdapter%@", @(i)].UTF8String);
+            protocol_addProtocol(adapter, @protocol(ZIKServiceRoutable));
+            objc_registerProtocol(adapter);
+            Protocol *adaptee = [BenchmarkRegistry serviceProtocolAtIndex:i + 1];
+            [BenchmarkRegistry registerDestinationAdapter:(Protocol<ZIKServiceRoutable> *)adapter forAdaptee:(Protocol<ZIKServiceRoutable> *)adaptee];
+            if ([ZIKServiceRouteRegistry routerToDestination:adapter] != [ZIKServiceRouteRegistry routerToDestination:adaptee]) {
+                __atomic_fetch_add(&failureCount, 1, __ATOMIC_RELAXED);
+            }
+            ZIKServiceRouter.globalErrorHandler = ^(ZIKServiceRouter *router, ZIKRouteAction action, NSError *error) {
+                // Replaced while other threads are reading it
+            };
+        }
+    });
+
+    dispatch_apply(kConcurrentRouteCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        @autoreleasepool {
+            BOOL succeeded = YES;
+            succeeded &= ZIKRouterToService(AServiceInput) != nil;
+            succeeded &= [ZIKServiceRouteRegistry routerToDestination:[BenchmarkRegistry serviceProtocolAtIndex:i % BenchmarkRegistry.serviceCount]] != nil;
+            succeeded &= [ZIKRouterToService(AServiceInput) makeDestination] != nil;
+
+            __block BOOL performed = NO;
+            ZIKAnyServiceRouter *router = [ZIKRouterToService(AServiceInput) performWithSuccessHandler:^(id<AServiceInput>  _Nonnull destination) {
+                performed = YES;
+            } errorHandler:nil];
+            succeeded &= performed && router.state == ZIKRouterStateRouted;
+            succeeded &= router.destination != nil && [ZIKServiceRouter routerForDestination:router.destination] == router;
+
+            (void)ZIKServiceRouter.globalErrorHandler;
+            if (!succeeded) {
+                __atomic_fetch_add(&failureCount, 1, __ATOMIC_RELAXED);
+            }
+        }
+    });
+
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    ZIKServiceRouter.globalErrorHandler = originalErrorHandler;
+    XCTAssertEqual(failureCount, 0);
+}
+
+- (void)testConcurrentModuleRoutingWithLateRegistration {
+    __block uint64_t failureCount = 0;
+
+    // Adapters registered after startup change routes generation, so cached route handles are resolved again on other threads
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        for (NSUInteger i = 0; i < kLateAdapterCount; i++) {
+            Protocol *adapter = objc_allocateProtocol([NSString stringWithFormat:@"ConcurrencyModuleAdapter%@", @(i)].UTF8String);
+            protocol_addProtocol(adapter, @protocol(ZIKServiceRoutable));
+            objc_registerProtocol(adapter);
+            Protocol *adaptee = [BenchmarkRegistry serviceProtocolAtIndex:kLateAdapterCount + i + 1];
+            [BenchmarkRegistry registerDestinationAdapter:(Protocol<ZIKServiceRoutable> *)adapter forAdaptee:(Protocol<ZIKServiceRoutable> *)adaptee];
+            if ([ZIKServiceRouteRegistry routerToDestination:adapter] == nil) {
+                __atomic_fetch_add(&failureCount, 1, __ATOMIC_RELAXED);
+            }
+        }
+    });
+
+    dispatch_apply(kConcurrentRouteCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        @autoreleasepool {
+            BOOL succeeded = YES;
+            NSString *title = [NSString stringWithFormat:@"title %@", @(i)];
+            succeeded &= ZIKRouterToServiceModule(AServiceModuleInput) != nil;
+            id<AServiceInput> destination = [ZIKRouterToServiceModule(AServiceModuleInput) makeDestinationWithConfiguring:^(ZIKPerformRouteConfiguration<AServiceModuleInput> * _Nonnull config) {
+                config.title = title;
+            }];
+            succeeded &= [destination.title isEqualToString:title];
+            succeeded &= [ZIKRouterToService(AServiceInput) makeDestination] != nil;
+            succeeded &= [ZIKServiceRouteRegistry routerToDestination:[BenchmarkRegistry serviceProtocolAtIndex:i % BenchmarkRegistry.serviceCount]] != nil;
+            if (!succeeded) {
+                __atomic_fetch_add(&failureCount, 1, __ATOMIC_RELAXED);
+            }
+        }
+    });
+
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    XCTAssertEqual(failureCount, 0);
+}
+
+- (void)testCrossDependentSingletonServices {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"made"];
+    NSString *dependentIdentifier = @"ZIKServiceRouterConcurrencyTests.dependent";
+    NSString *dependencyIdentifier = @"ZIKServiceRouterConcurrencyTests.dependency";
+    dispatch_semaphore_t makingDependency = dispatch_semaphore_create(0);
+    ZIKServiceRoute *dependencyRoute = [ZIKServiceRoute makeRouteWithDestination:[AService class] makeDestination:^id _Nullable(ZIKPerformRouteConfig * _Nonnull config, ZIKRouter * _Nonnull router) {
+        if (![NSThread isMainThread]) {
+            // Main thread requests the service while this making waits for main thread
+            dispatch_semaphore_signal(makingDependency);
+            dispatch_sync(dispatch_get_main_queue(), ^{});
+        }
+        return [[AService alloc] init];
+    }];
+    dependencyRoute.registerIdentifier(dependencyIdentifier).lifetime(ZIKServiceLifetimeSingleton);
+    __block id dependencyOfDependent;
+    ZIKServiceRoute *dependentRoute = [ZIKServiceRoute makeRouteWithDestination:[AService class] makeDestination:^id _Nullable(ZIKPerformRouteConfig * _Nonnull config, ZIKRouter * _Nonnull router) {
+        dependencyOfDependent = [[ZIKServiceRouteRegistry routerToIdentifier:dependencyIdentifier] makeDestination];
+        return [[AService alloc] init];
+    }];
+    dependentRoute.registerIdentifier(dependentIdentifier).lifetime(ZIKServiceLifetimeSingleton);
+
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        id dependent = [[ZIKServiceRouteRegistry routerToIdentifier:dependentIdentifier] makeDestination];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            XCTAssertNotNil(dependent);
+            [expectation fulfill];
+        });
+    });
+    dispatch_semaphore_wait(makingDependency, DISPATCH_TIME_FOREVER);
+    // Doesn't wait for the making blocked by main thread
+    id dependency = [[ZIKServiceRouteRegistry routerToIdentifier:dependencyIdentifier] makeDestination];
+    XCTAssertNotNil(dependency);
+
+    [self waitForExpectationsWithTimeout:5 handler:^(NSError * _Nullable error) {
+        !error? : NSLog(@"%@", error);
+    }];
+    // The first made service is kept, the later one is dropped
+    XCTAssertEqual(dependencyOfDependent, dependency);
+    XCTAssertEqual([[ZIKServiceRouteRegistry routerToIdentifier:dependencyIdentifier] makeDestination], dependency);
+
+    [ZIKServiceRouter discardSharedServices];
+    [ZIKServiceRouteRegistry unregisterRoute:dependentRoute];
+    [ZIKServiceRouteRegistry unregisterRoute:dependencyRoute];
+}
+
+@end
@@ -0,0 +1,180 @@
+//
+//  ZIKServiceRouterLifetimeTests.m
+//  ZIKRouterTests
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import "ZIKRouterTestCase.h"
+@import ZIKRouter;
+#import "AService.h"
+
+static NSString *const kSingletonServiceIdentifier = @"ZIKServiceRouterLifetimeTests.singleton";
+static NSString *const kWeakSharedServiceIdentifier = @"ZIKServiceRouterLifetimeTests.weakShared";
+static NSString *const kScopedServiceIdentifier = @"ZIKServiceRouterLifetimeTests.scoped";
+static NSString *const kCycleServiceAIdentifier = @"ZIKServiceRouterLifetimeTests.cycleA";
+static NSString *const kCycleServiceBIdentifier = @"ZIKServiceRouterLifetimeTests.cycleB";
+
+@interface ZIKServiceRouterLifetimeTests : ZIKRouterTestCase
+@property (nonatomic, strong) NSMutableArray<ZIKServiceRoute *> *routes;
+@end
+
+@implementation ZIKServiceRouterLifetimeTests
+
+- (void)setUp {
+    [super setUp];
+    self.routes = [NSMutableArray array];
+    NSDictionary<NSString *, NSNumber *> *lifetimes = @{kSingletonServiceIdentifier: @(ZIKServiceLifetimeSingleton),
+                                                       kWeakSharedServiceIdentifier: @(ZIKServiceLifetimeWeakShared),
+                                                       kScopedServiceIdentifier: @(ZIKServiceLifetimeScoped)};
+    [lifetimes enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull identifier, NSNumber * _Nonnull lifetime, BOOL * _Nonnull stop) {
+        ZIKServiceRoute *route = [ZIKServiceRoute makeRouteWithDestination:[AService class] makeDestination:^id _Nullable(ZIKPerformRouteConfig * _Nonnull config, ZIKRouter * _Nonnull router) {
+            return [[AService alloc] init];
+        }];
+        route.registerIdentifier(identifier).lifetime(lifetime.integerValue);
+        [self.routes addObject:route];
+    }];
+}
+
+- (void)tearDown {
+    [ZIKServiceRouter discardSharedServices];
+    for (ZIKServiceRoute *route in self.routes) {
+        [ZIKServiceRouteRegistry unregisterRoute:route];
+    }
+    self.routes = nil;
+    [super tearDown];
+}
+
+- (nullable id)makeServiceWithIdentifier:(NSString *)identifier scope:(nullable id)scope {
+    return [[ZIKServiceRouteRegistry routerToIdentifier:identifier] makeDestinationWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+        config.serviceScope = scope;
+    }];
+}
+
+- (void)testSingletonReturnsSameInstance {
+    __weak id weakService;
+    @autoreleasepool {
+        id service = [self makeServiceWithIdentifier:kSingletonServiceIdentifier scope:nil];
+        XCTAssertNotNil(service);
+        XCTAssertEqual([self makeServiceWithIdentifier:kSingletonServiceIdentifier scope:nil], service);
+        weakService = service;
+    }
+    // Kept without other references
+    XCTAssertNotNil(weakService);
+    XCTAssertEqual([self makeServiceWithIdentifier:kSingletonServiceIdentifier scope:nil], weakService);
+
+    [ZIKServiceRouter discardSharedServices];
+    @autoreleasepool {
+        id service = [self makeServiceWithIdentifier:kSingletonServiceIdentifier scope:nil];
+        XCTAssertNotNil(service);
+        XCTAssertNotEqual(service, weakService);
+    }
+}
+
+- (void)testSingletonPerformReturnsSameInstance {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completionHandler"];
+    id service = [self makeServiceWithIdentifier:kSingletonServiceIdentifier scope:nil];
+    @autoreleasepool {
+        [self enterTest];
+        self.router = [[ZIKServiceRouteRegistry routerToIdentifier:kSingletonServiceIdentifier] performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.completionHandler = ^(BOOL success, id  _Nullable destination, ZIKRouteAction  _Nonnull routeAction, NSError * _Nullable error) {
+                XCTAssertTrue(success);
+                XCTAssertEqual(destination, service);
+                [expectation fulfill];
+                [self handle:^{
+                    [self leaveTest];
+                }];
+            };
+        }];
+    }
+
+    [self waitForExpectationsWithTimeout:5 handler:^(NSError * _Nullable error) {
+        !error? : NSLog(@"%@", error);
+    }];
+}
+
+- (void)testWeakSharedServiceIsSharedWhileReferenced {
+    __weak id weakService;
+    @autoreleasepool {
+        id service = [self makeServiceWithIdentifier:kWeakSharedServiceIdentifier scope:nil];
+        XCTAssertNotNil(service);
+        XCTAssertEqual([self makeServiceWithIdentifier:kWeakSharedServiceIdentifier scope:nil], service);
+        weakService = service;
+    }
+    XCTAssertNil(weakService);
+    XCTAssertNotNil([self makeServiceWithIdentifier:kWeakSharedServiceIdentifier scope:nil]);
+}
+
+- (void)testScopedServiceIsReleasedWithScope {
+    __weak id weakService;
+    @autoreleasepool {
+        NSObject *scope = [[NSObject alloc] init];
+        NSObject *otherScope = [[NSObject alloc] init];
+        @autoreleasepool {
+            id service = [self makeServiceWithIdentifier:kScopedServiceIdentifier scope:scope];
+            XCTAssertNotNil(service);
+            XCTAssertEqual([self makeServiceWithIdentifier:kScopedServiceIdentifier scope:scope], service);
+            XCTAssertNotEqual([self makeServiceWithIdentifier:kScopedServiceIdentifier scope:otherScope], service);
+            // Not shared without scope
+            XCTAssertNotEqual([self makeServiceWithIdentifier:kScopedServiceIdentifier scope:nil], service);
+            weakService = service;
+        }
+        // Kept by the scope
+        XCTAssertNotNil(weakService);
+        XCTAssertEqual([self makeServiceWithIdentifier:kScopedServiceIdentifier scope:scope], weakService);
+    }
+    XCTAssertNil(weakService);
+}
+
+- (void)testEndServiceScopeReleasesServices {
+    NSObject *scope = [[NSObject alloc] init];
+    __weak id weakService;
+    @autoreleasepool {
+        weakService = [self makeServiceWithIdentifier:kScopedServiceIdentifier scope:scope];
+    }
+    XCTAssertNotNil(weakService);
+
+    @autoreleasepool {
+        [ZIKServiceRouter endServiceScope:scope];
+    }
+    XCTAssertNil(weakService);
+    @autoreleasepool {
+        id service = [self makeServiceWithIdentifier:kScopedServiceIdentifier scope:scope];
+        XCTAssertNotNil(service);
+        XCTAssertEqual([self makeServiceWithIdentifier:kScopedServiceIdentifier scope:scope], service);
+    }
+}
+
+- (void)testConcurrentMakingsGettingEachOtherDontDeadlock {
+    dispatch_semaphore_t aStarted = dispatch_semaphore_create(0);
+    dispatch_semaphore_t bStarted = dispatch_semaphore_create(0);
+    __weak typeof(self) weakSelf = self;
+    ZIKServiceRoute *routeA = [ZIKServiceRoute makeRouteWithDestination:[AService class] makeDestination:^id _Nullable(ZIKPerformRouteConfig * _Nonnull config, ZIKRouter * _Nonnull router) {
+        dispatch_semaphore_signal(aStarted);
+        dispatch_semaphore_wait(bStarted, DISPATCH_TIME_FOREVER);
+        NSCAssert([weakSelf makeServiceWithIdentifier:kCycleServiceBIdentifier scope:nil] != nil, @"B should be made");
+        return [[AService alloc] init];
+    }];
+    routeA.registerIdentifier(kCycleServiceAIdentifier).lifetime(ZIKServiceLifetimeWeakShared);
+    ZIKServiceRoute *routeB = [ZIKServiceRoute makeRouteWithDestination:[AService class] makeDestination:^id _Nullable(ZIKPerformRouteConfig * _Nonnull config, ZIKRouter * _Nonnull router) {
+        dispatch_semaphore_signal(bStarted);
+        dispatch_semaphore_wait(aStarted, DISPATCH_TIME_FOREVER);
+        NSCAssert([weakSelf makeServiceWithIdentifier:kCycleServiceAIdentifier scope:nil] != nil, @"A should be made");
+        return [[AService alloc] init];
+    }];
+    routeB.registerIdentifier(kCycleServiceBIdentifier).lifetime(ZIKServiceLifetimeWeakShared);
+    [self.routes addObjectsFromArray:@[routeA, routeB]];
+    
+    // A waits for B and B waits for A, one of them makes the other at once instead of waiting forever
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        [weakSelf makeServiceWithIdentifier:kCycleServiceAIdentifier scope:nil];
+    });
+    dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        [weakSelf makeServiceWithIdentifier:kCycleServiceBIdentifier scope:nil];
+    });
+    XCTAssertEqual(dispatch_group_wait(group, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)), 0);
+}
+
+@end
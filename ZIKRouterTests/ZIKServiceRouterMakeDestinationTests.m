@@ -9,6 +9,7 @@
 #import "ZIKRouterTestCase.h"
 #import "AServiceInput.h"
 #import "EasyServiceInput.h"
+#import "AService.h"
 
 @interface ZIKServiceRouterMakeDestinationTests : ZIKRouterTestCase
 
@@ -46,6 +47,48 @@
     }
 }
 
+- (void)testMakeDestinationFromFactoryWithPreparation {
+    __block NSInteger preparedCount = 0;
+    __block id preparedDestination;
+    id<EasyServiceInput> destination = [ZIKRouterToService(EasyServiceInput) makeDestinationWithPreparation:^(id<EasyServiceInput>  _Nonnull destination) {
+        preparedCount++;
+        preparedDestination = destination;
+    }];
+    XCTAssertNotNil(destination);
+    XCTAssertTrue([(id)destination isKindOfClass:[AService class]]);
+    XCTAssertEqual(preparedCount, 1);
+    XCTAssertEqual(preparedDestination, destination);
+    self.destination = destination;
+}
+
+- (void)testMakeDestinationFromFactoryTable {
+    BOOL canMakeDestination = [ZIKRouterToService(TableServiceInput) canMakeDestination];
+    XCTAssertTrue(canMakeDestination);
+    id<TableServiceInput> destination = [ZIKRouterToService(TableServiceInput) makeDestination];
+    XCTAssertNotNil(destination);
+    XCTAssertTrue([(id)destination isKindOfClass:[AService class]]);
+    self.destination = destination;
+}
+
+- (void)testMakeLazyDestination {
+    __block NSInteger preparedCount = 0;
+    id<AServiceInput> destination = [ZIKRouterToService(AServiceInput) makeLazyDestinationWithPreparation:^(id<AServiceInput>  _Nonnull destination) {
+        preparedCount++;
+        destination.title = @"test title";
+    }];
+    XCTAssertNotNil(destination);
+    ZIKLazyServiceProxy *proxy = (ZIKLazyServiceProxy *)destination;
+    XCTAssertTrue([proxy isProxy]);
+    XCTAssertFalse(proxy.isResolved);
+    XCTAssertEqual(preparedCount, 0);
+    
+    XCTAssert([destination.title isEqualToString:@"test title"]);
+    XCTAssertTrue(proxy.isResolved);
+    XCTAssertTrue([(id)destination conformsToProtocol:@protocol(AServiceInput)]);
+    XCTAssertEqual(preparedCount, 1);
+    self.destination = destination;
+}
+
 - (void)testMakeDestinationWithPreparation {
     @autoreleasepool {
         BOOL canMakeDestination = [ZIKRouterToService(AServiceInput) canMakeDestination];
@@ -72,6 +115,20 @@
     }
 }
 
+- (void)testConcurrentMakeDestinationWithCoalescingKey {
+    NSMutableArray *destinations = [NSMutableArray array];
+    dispatch_apply(8, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t idx) {
+        id<AServiceInput> destination = [ZIKRouterToService(AServiceInput) makeDestinationWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.coalescingKey = @"test";
+        }];
+        XCTAssertNotNil(destination);
+        @synchronized (destinations) {
+            [destinations addObject:destination];
+        }
+    });
+    XCTAssertEqual(destinations.count, 8);
+}
+
 - (void)testMakeDestinationWithPrepareDestination {
     @autoreleasepool {
         XCTestExpectation *successHandlerExpectation = [self expectationWithDescription:@"successHandler"];
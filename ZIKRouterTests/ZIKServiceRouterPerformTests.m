@@ -305,8 +305,360 @@
     }];
 }
 
+- (void)testRouterForDestination {
+    @autoreleasepool {
+        __block id performedDestination;
+        ZIKServiceRouter *router = [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.successHandler = ^(id  _Nonnull destination) {
+                performedDestination = destination;
+            };
+        }];
+        XCTAssertNotNil(performedDestination);
+        XCTAssertEqual([ZIKServiceRouter routerForDestination:performedDestination], router);
+        XCTAssertEqual([ZIKRouter routerForDestination:performedDestination], router);
+        XCTAssertNil([ZIKServiceRouter routerForDestination:[NSObject new]]);
+    }
+}
+
+- (void)testMadeDestinationIsNotBoundToRouter {
+    @autoreleasepool {
+        __block BOOL prepared = NO;
+        id destination = [ZIKRouterToService(AServiceInput) makeDestinationWithPreparation:^(id<AServiceInput>  _Nonnull destination) {
+            prepared = YES;
+        }];
+        XCTAssertNotNil(destination);
+        XCTAssertTrue(prepared);
+        XCTAssertNil([ZIKServiceRouter routerForDestination:destination]);
+    }
+}
+
+- (void)testPerformWithPerformQueueAndCallbackQueue {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"callbackQueue"];
+    static void *kCallbackQueueKey = &kCallbackQueueKey;
+    dispatch_queue_t performQueue = dispatch_queue_create("com.zuik.router.test.perform", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t callbackQueue = dispatch_queue_create("com.zuik.router.test.callback", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_set_specific(callbackQueue, kCallbackQueueKey, kCallbackQueueKey, NULL);
+    @autoreleasepool {
+        [self enterTest];
+        self.router = [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.performQueue = performQueue;
+            config.callbackQueue = callbackQueue;
+            config.successHandler = ^(id  _Nonnull destination) {
+                XCTAssertNotNil(destination);
+                XCTAssertTrue(dispatch_get_specific(kCallbackQueueKey) == kCallbackQueueKey);
+                [expectation fulfill];
+                [self handle:^{
+                    [self leaveTest];
+                }];
+            };
+        }];
+        // Destination is made on performQueue
+        XCTAssertNil(self.router.destination);
+    }
+
+    [self waitForExpectationsWithTimeout:5 handler:^(NSError * _Nullable error) {
+        !error? : NSLog(@"%@", error);
+    }];
+}
+
+- (void)testPerformWithCancelledToken {
+    ZIKRouteCancellationToken *token = [ZIKRouteCancellationToken new];
+    __block BOOL handlerCalled = NO;
+    [token addCancellationHandler:^{
+        handlerCalled = YES;
+    }];
+    [token cancel];
+    XCTAssertTrue(token.isCancelled);
+    XCTAssertTrue(handlerCalled);
+
+    __block NSError *performError;
+    ZIKServiceRouter *router = [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+        config.cancellationToken = token;
+        config.successHandler = ^(id  _Nonnull destination) {
+            XCTAssert(NO, @"successHandler should not be called");
+        };
+        config.errorHandler = ^(ZIKRouteAction  _Nonnull routeAction, NSError * _Nonnull error) {
+            performError = error;
+        };
+    }];
+    XCTAssertEqual(performError.code, ZIKRouteErrorActionFailed);
+    XCTAssertNil(router.destination);
+    XCTAssertEqual(router.state, ZIKRouterStateUnrouted);
+}
+
+- (void)testCancelMakingOnPerformQueue {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"cancelled"];
+    dispatch_queue_t performQueue = dispatch_queue_create("com.zuik.router.test.perform", DISPATCH_QUEUE_SERIAL);
+    // Block the queue, so making hasn't started when cancelling
+    dispatch_semaphore_t sema = dispatch_semaphore_create(0);
+    dispatch_async(performQueue, ^{
+        dispatch_semaphore_wait(sema, DISPATCH_TIME_FOREVER);
+    });
+    ZIKRouteCancellationToken *token = [ZIKRouteCancellationToken new];
+    @autoreleasepool {
+        [self enterTest];
+        self.router = [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.performQueue = performQueue;
+            config.cancellationToken = token;
+            config.successHandler = ^(id  _Nonnull destination) {
+                XCTAssert(NO, @"successHandler should not be called");
+            };
+            config.errorHandler = ^(ZIKRouteAction  _Nonnull routeAction, NSError * _Nonnull error) {
+                XCTAssertEqual(error.code, ZIKRouteErrorActionFailed);
+                [expectation fulfill];
+                [self handle:^{
+                    XCTAssertNil(self.router.destination);
+                    [self leaveTest];
+                }];
+            };
+        }];
+        [token cancel];
+        dispatch_semaphore_signal(sema);
+    }
+
+    [self waitForExpectationsWithTimeout:5 handler:^(NSError * _Nullable error) {
+        !error? : NSLog(@"%@", error);
+    }];
+}
+
+- (void)testRecursiveDepthOfRoutesEndingOnAnotherThread {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"performed"];
+    dispatch_queue_t performQueue = dispatch_queue_create("com.zuik.router.test.perform", DISPATCH_QUEUE_SERIAL);
+    // Routes start on this thread and end on main thread, more than the max recursive depth
+    NSThread *thread = [[NSThread alloc] initWithBlock:^{
+        for (NSInteger i = 0; i < 250; i++) {
+            dispatch_semaphore_t sema = dispatch_semaphore_create(0);
+            __block NSError *performError;
+            [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+                config.performQueue = performQueue;
+                config.completionHandler = ^(BOOL success, id  _Nullable destination, ZIKRouteAction  _Nonnull routeAction, NSError * _Nullable error) {
+                    performError = error;
+                    dispatch_semaphore_signal(sema);
+                };
+            }];
+            dispatch_semaphore_wait(sema, DISPATCH_TIME_FOREVER);
+            XCTAssertNil(performError);
+            if (performError) {
+                break;
+            }
+        }
+        // Synchronous routes on this thread still work
+        __block NSError *performError;
+        id destination = [ZIKRouterToService(AServiceInput) makeDestinationWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.errorHandler = ^(ZIKRouteAction  _Nonnull routeAction, NSError * _Nonnull error) {
+                performError = error;
+            };
+        }];
+        XCTAssertNotNil(destination);
+        XCTAssertNil(performError);
+        [expectation fulfill];
+    }];
+    [thread start];
+
+    [self waitForExpectationsWithTimeout:30 handler:^(NSError * _Nullable error) {
+        !error? : NSLog(@"%@", error);
+    }];
+}
+
+- (void)testRecentRouteEvents {
+    ZIKServiceRouter *router = [ZIKRouterToService(AServiceInput) performRoute];
+    XCTAssertEqual(router.state, ZIKRouterStateRouted);
+    NSString *routerName = NSStringFromClass([router class]);
+    NSString *lastEvent = ZIKRouter.recentRouteEvents.lastObject;
+    XCTAssertTrue([lastEvent containsString:[routerName stringByAppendingString:@" Routing -> Routed"]], @"%@", lastEvent);
+    
+    ZIKRouteCancellationToken *token = [ZIKRouteCancellationToken new];
+    [token cancel];
+    router = [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+        config.cancellationToken = token;
+    }];
+    lastEvent = ZIKRouter.recentRouteEvents.lastObject;
+    XCTAssertTrue([lastEvent containsString:[NSString stringWithFormat:@"%@ perform error %@", routerName, @(ZIKRouteErrorActionFailed)]], @"%@", lastEvent);
+    XCTAssertLessThanOrEqual(ZIKRouter.recentRouteEvents.count, 256);
+}
+
+- (void)testReleasesPerformHandlersWhenRouted {
+    __block BOOL successHandlerCalled = NO;
+    __weak NSObject *weakCaptured;
+    ZIKServiceRouter *router;
+    @autoreleasepool {
+        NSObject *captured = [NSObject new];
+        weakCaptured = captured;
+        router = [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.releasesPerformHandlersWhenRouted = YES;
+            config.prepareDestination = ^(id  _Nonnull destination) {
+                XCTAssertNotNil(captured);
+            };
+            config.successHandler = ^(id  _Nonnull destination) {
+                XCTAssertNotNil(captured);
+                successHandlerCalled = YES;
+            };
+        }];
+    }
+    XCTAssertEqual(router.state, ZIKRouterStateRouted);
+    XCTAssertTrue(successHandlerCalled);
+    XCTAssertNil(weakCaptured, @"Objects captured by perform handlers should be released when routed");
+}
+
+- (void)testStageTimestamps {
+    ZIKRouter.recordsStageTimestamps = YES;
+    ZIKServiceRouter *router = [ZIKRouterToService(AServiceInput) performRoute];
+    ZIKRouter.recordsStageTimestamps = NO;
+    XCTAssertEqual(router.state, ZIKRouterStateRouted);
+    uint64_t initTime = [router timestampForStage:ZIKRouterStageInit];
+    XCTAssertGreaterThan(initTime, 0);
+    XCTAssertGreaterThanOrEqual([router timestampForStage:ZIKRouterStagePerformStarted], initTime);
+    XCTAssertGreaterThanOrEqual([router timestampForStage:ZIKRouterStageDestinationCreated], [router timestampForStage:ZIKRouterStagePerformStarted]);
+    XCTAssertGreaterThanOrEqual([router timestampForStage:ZIKRouterStageDestinationPrepared], [router timestampForStage:ZIKRouterStageDestinationCreated]);
+    XCTAssertGreaterThanOrEqual([router timestampForStage:ZIKRouterStagePerformSucceeded], [router timestampForStage:ZIKRouterStageDestinationPrepared]);
+    XCTAssertEqual([router timestampForStage:ZIKRouterStagePerformFailed], 0);
+    XCTAssertGreaterThanOrEqual([router durationFromStage:ZIKRouterStageInit toStage:ZIKRouterStagePerformSucceeded], 0);
+    
+    router = [ZIKRouterToService(AServiceInput) performRoute];
+    XCTAssertEqual([router timestampForStage:ZIKRouterStageInit], 0);
+}
+
+- (void)testSlowCallbackWatchdog {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"slowCallbackHandler"];
+    ZIKRouter.slowCallbackThreshold = 0.05;
+    ZIKRouter.slowCallbackHandler = ^(ZIKSlowRouteCallback * _Nonnull callback) {
+        if (callback.stage != ZIKRouteCallbackStagePrepareDestinationBlock) {
+            return;
+        }
+        XCTAssertGreaterThanOrEqual(callback.duration, 0.05);
+        XCTAssertTrue(callback.isMainThread);
+        [expectation fulfill];
+    };
+    ZIKServiceRouter *router = [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+        config.prepareDestination = ^(id  _Nonnull destination) {
+            [NSThread sleepForTimeInterval:0.1];
+        };
+    }];
+    ZIKRouter.slowCallbackThreshold = 0;
+    XCTAssertEqual(router.state, ZIKRouterStateRouted);
+    [self waitForExpectationsWithTimeout:5 handler:^(NSError * _Nullable error) {
+        !error? : NSLog(@"%@", error);
+    }];
+    ZIKRouter.slowCallbackHandler = nil;
+}
+
 #pragma mark Strict
 
+- (void)testQueuedPerformDuringRouting {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"queued perform"];
+    @autoreleasepool {
+        [self enterTest];
+        __block BOOL queued = NO;
+        __weak typeof(self) weakSelf = self;
+        ZIKServiceRouter *router = [[ZIKRouterToService(AServiceInput).routerClass alloc] initWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.prepareDestination = ^(id _Nonnull destination) {
+                if (queued) {
+                    return;
+                }
+                queued = YES;
+                // Still routing, the request runs after current performing
+                [weakSelf.router performRouteWithSuccessHandler:^(id  _Nonnull destination) {
+                    XCTAssertNotNil(destination);
+                    [expectation fulfill];
+                    [weakSelf handle:^{
+                        [weakSelf leaveTest];
+                    }];
+                } errorHandler:^(ZIKRouteAction  _Nonnull routeAction, NSError * _Nonnull error) {
+                    XCTAssert(NO, @"Queued request should not fail: %@", error);
+                }];
+            };
+        } removing:nil];
+        router.queuesRequests = YES;
+        self.router = router;
+        [router performRoute];
+    }
+    
+    [self waitForExpectationsWithTimeout:5 handler:^(NSError * _Nullable error) {
+        !error? : NSLog(@"%@", error);
+    }];
+}
+
+- (void)testQueuedRemoveWithConfiguringDuringRouting {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"queued remove"];
+    @autoreleasepool {
+        [self enterTest];
+        __weak typeof(self) weakSelf = self;
+        ZIKServiceRouter *router = [[ZIKRouterToService(AServiceInput).routerClass alloc] initWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.prepareDestination = ^(id _Nonnull destination) {
+                // Still routing, removing runs after current performing
+                [weakSelf.router removeRouteWithConfiguring:^(ZIKRemoveRouteConfiguration * _Nonnull config) {
+                    config.successHandler = ^{
+                        XCTAssertEqual(weakSelf.router.state, ZIKRouterStateRemoved);
+                        [expectation fulfill];
+                        [weakSelf handle:^{
+                            [weakSelf leaveTest];
+                        }];
+                    };
+                    config.errorHandler = ^(ZIKRouteAction  _Nonnull routeAction, NSError * _Nonnull error) {
+                        XCTAssert(NO, @"Queued request should not fail: %@", error);
+                    };
+                }];
+                XCTAssertEqual(weakSelf.router.state, ZIKRouterStateRouting);
+            };
+        } removing:nil];
+        router.queuesRequests = YES;
+        self.router = router;
+        [router performRoute];
+    }
+    
+    [self waitForExpectationsWithTimeout:5 handler:^(NSError * _Nullable error) {
+        !error? : NSLog(@"%@", error);
+    }];
+}
+
+- (void)testPerformWithPriority {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"priority"];
+    @autoreleasepool {
+        [self enterTest];
+        NSMutableArray<NSNumber *> *order = [NSMutableArray array];
+        ZIKServiceRouter *backgroundRouter = [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.priority = ZIKRoutePriorityBackground;
+            config.successHandler = ^(id  _Nonnull destination) {
+                [order addObject:@(ZIKRoutePriorityBackground)];
+                XCTAssertEqualObjects(order, (@[@(ZIKRoutePriorityUserInitiated), @(ZIKRoutePriorityBackground)]));
+                [expectation fulfill];
+                [self handle:^{
+                    [self leaveTest];
+                }];
+            };
+        }];
+        // Scheduled routers stay unrouted until they are performed
+        XCTAssertEqual(backgroundRouter.state, ZIKRouterStateUnrouted);
+        self.router = [ZIKRouterToService(AServiceInput) performWithConfiguring:^(ZIKPerformRouteConfiguration * _Nonnull config) {
+            config.priority = ZIKRoutePriorityUserInitiated;
+            config.successHandler = ^(id  _Nonnull destination) {
+                [order addObject:@(ZIKRoutePriorityUserInitiated)];
+            };
+        }];
+    }
+    
+    [self waitForExpectationsWithTimeout:5 handler:^(NSError * _Nullable error) {
+        !error? : NSLog(@"%@", error);
+    }];
+}
+
+- (void)testWarmWhenIdle {
+    XCTestExpectation *mainExpectation = [self expectationWithDescription:@"warm on main thread"];
+    XCTestExpectation *backgroundExpectation = [self expectationWithDescription:@"warm in background"];
+    [ZIKRouter warmWhenIdle:^{
+        XCTAssertTrue([NSThread isMainThread]);
+        [mainExpectation fulfill];
+    } inBackground:NO];
+    [ZIKRouter warmWhenIdle:^{
+        XCTAssertFalse([NSThread isMainThread]);
+        [backgroundExpectation fulfill];
+    } inBackground:YES];
+    
+    [self waitForExpectationsWithTimeout:5 handler:^(NSError * _Nullable error) {
+        !error? : NSLog(@"%@", error);
+    }];
+}
+
 - (void)testStrictPerformWithPrepareDestination {
     XCTestExpectation *expectation = [self expectationWithDescription:@"prepareDestination"];
     @autoreleasepool {
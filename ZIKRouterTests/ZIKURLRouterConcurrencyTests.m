@@ -0,0 +1,151 @@
+//
+//  ZIKURLRouterConcurrencyTests.m
+//  ZIKRouterTests
+//
+//  Created by agent on 2026/10/15.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ZIKURLRouter.h"
+@import ZIKRouter;
+
+static const size_t kConcurrentResolveCount = 4000;
+static const NSUInteger kLatePatternCount = 200;
+
+/// Stress tests of resolving urls while patterns are registered from other threads. Run them with Thread Sanitizer enabled to find data races.
+@interface ZIKURLRouterConcurrencyTests : XCTestCase
+@property (nonatomic, strong) ZIKURLRouter *router;
+@end
+
+@implementation ZIKURLRouterConcurrencyTests
+
+- (void)setUp {
+    [super setUp];
+    self.router = [ZIKURLRouter new];
+    [self.router registerURLPattern:@"app://user/:id"];
+    [self.router registerURLPattern:@"app://user/:id/profile"];
+    [self.router registerURLPattern:@"app://settings"];
+}
+
+- (void)testConcurrentRegisterAndResolve {
+    [self _stressRouter:self.router];
+}
+
+- (void)testConcurrentRegisterAndResolveWithResultCache {
+    self.router.resultCacheLimit = 16;
+    [self _stressRouter:self.router];
+}
+
+- (void)testReplacePatternsWhileResolving {
+    self.router.resultCacheLimit = 16;
+    NSArray<NSString *> *oldPatterns = @[@"app://user/:id", @"app://settings"];
+    NSArray<NSString *> *newPatterns = @[@"app://user/:id", @"app://account/:id"];
+    __block uint64_t failureCount = 0;
+
+    // Each resolution sees either the old table or the new table, never a partial one
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        for (NSUInteger i = 0; i < kLatePatternCount; i++) {
+            [self.router replacePatterns:i % 2 == 0 ? newPatterns : oldPatterns passingTest:^BOOL(NSString *pattern) {
+                return YES;
+            }];
+        }
+        [self.router replacePatterns:newPatterns passingTest:^BOOL(NSString *pattern) {
+            return YES;
+        }];
+    });
+
+    dispatch_apply(kConcurrentResolveCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        @autoreleasepool {
+            NSString *userURL = [NSString stringWithFormat:@"app://user/%@", @(i % 32)];
+            if (![[self.router resultForURL:userURL].identifier isEqualToString:@"app://user/:id"]) {
+                __atomic_fetch_add(&failureCount, 1, __ATOMIC_RELAXED);
+            }
+            NSString *identifier = [self.router resultForURL:@"app://settings"].identifier;
+            if (identifier && ![identifier isEqualToString:@"app://settings"]) {
+                __atomic_fetch_add(&failureCount, 1, __ATOMIC_RELAXED);
+            }
+        }
+    });
+
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    XCTAssertEqual(failureCount, 0);
+    XCTAssertNil([self.router resultForURL:@"app://settings"]);
+    XCTAssertNil([self.router resultForURL:@"app://user/1/profile"]);
+    XCTAssertEqualObjects([self.router resultForURL:@"app://account/1"].parameters[@"id"], @"1");
+}
+
+- (void)testReplacePatternsKeepsOtherPatternsAndRegistrations {
+    BOOL(^isUserPattern)(NSString *) = ^BOOL(NSString *pattern) {
+        return [pattern hasPrefix:@"app://user/"];
+    };
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        for (NSUInteger i = 0; i < kLatePatternCount; i++) {
+            [self.router replacePatterns:@[@"app://user/:id", i % 2 == 0 ? @"app://user/:id/detail" : @"app://user/:id/profile"] passingTest:isUserPattern];
+        }
+    });
+    // Registrations during replacing are never discarded by the swap
+    for (NSUInteger i = 0; i < kLatePatternCount; i++) {
+        [self.router registerURLPattern:[NSString stringWithFormat:@"app://late%@/:id", @(i)]];
+    }
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    
+    for (NSUInteger i = 0; i < kLatePatternCount; i++) {
+        XCTAssertNotNil([self.router resultForURL:[NSString stringWithFormat:@"app://late%@/1", @(i)]]);
+    }
+    XCTAssertEqualObjects([self.router resultForURL:@"app://settings"].identifier, @"app://settings");
+    XCTAssertEqualObjects([self.router resultForURL:@"app://user/1/profile"].identifier, @"app://user/:id/profile");
+    XCTAssertNil([self.router resultForURL:@"app://user/1/detail"]);
+    // Patterns not passing the test are ignored
+    [self.router replacePatterns:@[@"app://account/:id"] passingTest:isUserPattern];
+    XCTAssertNil([self.router resultForURL:@"app://account/1"]);
+    XCTAssertNil([self.router resultForURL:@"app://user/1"]);
+    XCTAssertNotNil([self.router resultForURL:@"app://settings"]);
+}
+
+- (void)_stressRouter:(ZIKURLRouter *)router {
+    __block uint64_t failureCount = 0;
+
+    // Registering clears caches and publishes new snapshots while other threads are matching with the old ones
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        for (NSUInteger i = 0; i < kLatePatternCount; i++) {
+            NSString *pattern = [NSString stringWithFormat:@"app://late%@/:id", @(i)];
+            [router registerURLPattern:pattern];
+            if (![[router resultForURL:[NSString stringWithFormat:@"app://late%@/1", @(i)]].identifier isEqualToString:pattern]) {
+                __atomic_fetch_add(&failureCount, 1, __ATOMIC_RELAXED);
+            }
+        }
+    });
+
+    dispatch_apply(kConcurrentResolveCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        @autoreleasepool {
+            BOOL succeeded = YES;
+            NSString *userURL = [NSString stringWithFormat:@"app://user/%@?k=%@", @(i % 32), @(i)];
+            ZIKURLRouteResult *result = [router resultForURL:userURL];
+            succeeded &= [result.identifier isEqualToString:@"app://user/:id"];
+            succeeded &= [result.parameters[@"id"] isEqualToString:[NSString stringWithFormat:@"%@", @(i % 32)]];
+
+            NSString *profileURL = [NSString stringWithFormat:@"app://user/%@/profile", @(i % 8)];
+            NSDictionary<NSString *, ZIKURLRouteResult *> *results = [router resultsForURLs:@[profileURL, @"app://settings", @"app://unknown/path"]];
+            succeeded &= [results[profileURL].identifier isEqualToString:@"app://user/:id/profile"];
+            succeeded &= [results[@"app://settings"].identifier isEqualToString:@"app://settings"];
+            succeeded &= results[@"app://unknown/path"] == nil;
+
+            // Prewarmed results are taken by any thread, a result is never taken twice
+            [router storePrewarmedResult:result];
+            ZIKURLRouteResult *prewarmed = [router takePrewarmedResultForURL:userURL];
+            succeeded &= prewarmed == nil || prewarmed == result;
+            if (!succeeded) {
+                __atomic_fetch_add(&failureCount, 1, __ATOMIC_RELAXED);
+            }
+        }
+    });
+
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    XCTAssertEqual(failureCount, 0);
+}
+
+@end
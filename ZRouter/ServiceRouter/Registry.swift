@@ -23,12 +23,15 @@ extension Protocol {
     }
 }
 
-/// Key of registered protocol.
+/// Key of registered protocol. Keys are hashed and compared with identity of the type metadata, so lookup doesn't do any string work.
 internal struct _RouteKey: Hashable {
     #if DEBUG
     /// Routable type
     internal let type: Any.Type?
     #endif
+    /// Identity of the routable type, objc protocol or route object.
+    private let identity: ObjectIdentifier
+    /// Name of the routable type.
     internal let key: String
     internal private(set) var adapterProtocol: Protocol?
     internal init(type: Any.Type, name: String) {
@@ -36,6 +39,7 @@ internal struct _RouteKey: Hashable {
         #if DEBUG
         self.type = type
         #endif
+        identity = ObjectIdentifier(type)
         key = name
         assert(key.contains(".") == false, "Key shouldn't contain module prefix.")
     }
@@ -43,6 +47,7 @@ internal struct _RouteKey: Hashable {
         #if DEBUG
         self.type = nil
         #endif
+        identity = ObjectIdentifier(p)
         key = p.name
         adapterProtocol = p
         assert(key.contains(".") == false, "Remove module prefix for swift type.")
@@ -51,6 +56,7 @@ internal struct _RouteKey: Hashable {
         #if DEBUG
         self.type = nil
         #endif
+        identity = ObjectIdentifier(p)
         key = p.name
         adapterProtocol = p
     }
@@ -58,6 +64,7 @@ internal struct _RouteKey: Hashable {
         #if DEBUG
         self.type = type
         #endif
+        identity = ObjectIdentifier(type)
         key = name
         adapterProtocol = p
         assert(key == String(describing: type), "name should be equal to String(describing:) of \(type)")
@@ -72,19 +79,15 @@ internal struct _RouteKey: Hashable {
     #if DEBUG
     internal init(type: AnyClass) {
         self.type = type
+        identity = ObjectIdentifier(type)
         key = String(describing:type)
         assert(key.contains(".") == false, "Key shouldn't contain module prefix.")
     }
     internal init(route: Any) {
         self.type = nil
+        identity = ObjectIdentifier(route as AnyObject)
         key = String(describing:route)
     }
-    /// Used for checking declared protocol names.
-    internal init(key: String) {
-        type = nil
-        self.key = key
-        assert(key.contains(".") == false, "Remove module prefix for swift type.")
-    }
     fileprivate init?(routerType: ZIKAnyServiceRouterType) {
         assert(routerType.routerClass != nil || routerType.route != nil)
         if let routerClass = routerType.routerClass {
@@ -97,39 +100,121 @@ internal struct _RouteKey: Hashable {
     }
     #endif
     var hashValue: Int {
-        return key.hashValue
+        return identity.hashValue
     }
     func hash(into hasher: inout Hasher) {
-        hasher.combine(key.hashValue)
+        hasher.combine(identity)
     }
     static func ==(lhs: _RouteKey, rhs: _RouteKey) -> Bool {
-        return lhs.key == rhs.key
+        return lhs.identity == rhs.identity
+    }
+}
+
+/// Container shared by registering code and routing code on any thread. Reads are concurrent, writes are exclusive.
+internal final class _RouteContainer<Key: Hashable, Value>: Sequence {
+    private var storage = [Key: Value]()
+    private let lock: UnsafeMutablePointer<pthread_rwlock_t>
+    
+    internal init() {
+        // Lock needs a stable address, don't store pthread_rwlock_t in property directly
+        lock = UnsafeMutablePointer<pthread_rwlock_t>.allocate(capacity: 1)
+        lock.initialize(to: pthread_rwlock_t())
+        pthread_rwlock_init(lock, nil)
+    }
+    
+    deinit {
+        pthread_rwlock_destroy(lock)
+        lock.deinitialize(count: 1)
+        lock.deallocate()
+    }
+    
+    internal subscript(key: Key) -> Value? {
+        get {
+            pthread_rwlock_rdlock(lock)
+            defer { pthread_rwlock_unlock(lock) }
+            return storage[key]
+        }
+        set {
+            pthread_rwlock_wrlock(lock)
+            storage[key] = newValue
+            pthread_rwlock_unlock(lock)
+        }
+    }
+    
+    /// Copy of current entries, for enumerating without holding the lock.
+    internal var entries: [Key: Value] {
+        pthread_rwlock_rdlock(lock)
+        defer { pthread_rwlock_unlock(lock) }
+        return storage
+    }
+    
+    /// Remove entries matching the predicate.
+    internal func removeAll(where shouldBeRemoved: (Key, Value) -> Bool) {
+        pthread_rwlock_wrlock(lock)
+        storage = storage.filter { !shouldBeRemoved($0.key, $0.value) }
+        pthread_rwlock_unlock(lock)
+    }
+    
+    internal var keys: Dictionary<Key, Value>.Keys {
+        return entries.keys
+    }
+    
+    internal func makeIterator() -> Dictionary<Key, Value>.Iterator {
+        return entries.makeIterator()
     }
 }
 
 /// Registry for registering pure Swift protocol and discovering ZIKRouter subclass.
 internal class Registry {
     /// value: subclass of ZIKViewRouter or ZIKViewRoute
-    internal static var viewProtocolContainer = [_RouteKey: Any]()
+    internal static let viewProtocolContainer = _RouteContainer<_RouteKey, Any>()
     /// value: subclass of ZIKViewRouter or ZIKViewRoute
-    internal static var viewModuleProtocolContainer = [_RouteKey: Any]()
+    internal static let viewModuleProtocolContainer = _RouteContainer<_RouteKey, Any>()
     /// key: adapter view protocol  value: adaptee view protocol
-    internal static var viewAdapterContainer = [_RouteKey: _RouteKey]()
+    internal static let viewAdapterContainer = _RouteContainer<_RouteKey, _RouteKey>()
     /// key: adapter view module protocol  value: adaptee view module protocol
-    internal static var viewModuleAdapterContainer = [_RouteKey: _RouteKey]()
+    internal static let viewModuleAdapterContainer = _RouteContainer<_RouteKey, _RouteKey>()
+    /// key: objc adapter view protocol  value: key of the adapter in viewAdapterContainer
+    internal static let viewAdapterProtocolContainer = _RouteContainer<ObjectIdentifier, _RouteKey>()
+    /// key: objc adapter view module protocol  value: key of the adapter in viewModuleAdapterContainer
+    internal static let viewModuleAdapterProtocolContainer = _RouteContainer<ObjectIdentifier, _RouteKey>()
+    /// key: subclass of ZIKViewRouter or ZIKViewRoute in viewProtocolContainer and viewModuleProtocolContainer  value: router type built at registration
+    internal static let viewRouterTypeContainer = _RouteContainer<ObjectIdentifier, ZIKAnyViewRouterType>()
+    /// key: view protocol registered for making destination  value: identifier registered in ZIKViewRouteRegistry
+    internal static let viewMakingDestinationIdentifierContainer = _RouteContainer<_RouteKey, String>()
+    /// key: view module protocol registered for making destination  value: identifier registered in ZIKViewRouteRegistry
+    internal static let viewMakingModuleIdentifierContainer = _RouteContainer<_RouteKey, String>()
     /// value: subclass of ZIKServiceRouter or ZIKServiceRoute
-    fileprivate static var serviceProtocolContainer = [_RouteKey: Any]()
+    fileprivate static let serviceProtocolContainer = _RouteContainer<_RouteKey, Any>()
     /// value: subclass of ZIKServiceRouter or ZIKServiceRoute
-    fileprivate static var serviceModuleProtocolContainer = [_RouteKey: Any]()
+    fileprivate static let serviceModuleProtocolContainer = _RouteContainer<_RouteKey, Any>()
     /// key: adapter service protocol  value: adaptee service protocol
-    fileprivate static var serviceAdapterContainer = [_RouteKey: _RouteKey]()
+    fileprivate static let serviceAdapterContainer = _RouteContainer<_RouteKey, _RouteKey>()
     /// key: adapter service module protocol  value: adaptee service module protocol
-    fileprivate static var serviceModuleAdapterContainer = [_RouteKey: _RouteKey]()
+    fileprivate static let serviceModuleAdapterContainer = _RouteContainer<_RouteKey, _RouteKey>()
+    /// key: objc adapter service protocol  value: key of the adapter in serviceAdapterContainer
+    fileprivate static let serviceAdapterProtocolContainer = _RouteContainer<ObjectIdentifier, _RouteKey>()
+    /// key: objc adapter service module protocol  value: key of the adapter in serviceModuleAdapterContainer
+    fileprivate static let serviceModuleAdapterProtocolContainer = _RouteContainer<ObjectIdentifier, _RouteKey>()
+    /// key: subclass of ZIKServiceRouter or ZIKServiceRoute in serviceProtocolContainer and serviceModuleProtocolContainer  value: router type built at registration
+    fileprivate static let serviceRouterTypeContainer = _RouteContainer<ObjectIdentifier, ZIKAnyServiceRouterType>()
+    /// key: service protocol registered for making destination  value: identifier registered in ZIKServiceRouteRegistry
+    fileprivate static let serviceMakingDestinationIdentifierContainer = _RouteContainer<_RouteKey, String>()
+    /// key: service module protocol registered for making destination  value: identifier registered in ZIKServiceRouteRegistry
+    fileprivate static let serviceMakingModuleIdentifierContainer = _RouteContainer<_RouteKey, String>()
+    /// key: routable view type  value: objc routable view protocol bridged from the type, nil for pure Swift type
+    internal static let routableViewProtocolCache = _RouteContainer<ObjectIdentifier, Protocol?>()
+    /// key: routable view module type  value: objc routable view module protocol bridged from the type, nil for pure Swift type
+    internal static let routableViewModuleProtocolCache = _RouteContainer<ObjectIdentifier, Protocol?>()
+    /// key: routable service type  value: objc routable service protocol bridged from the type, nil for pure Swift type
+    fileprivate static let routableServiceProtocolCache = _RouteContainer<ObjectIdentifier, Protocol?>()
+    /// key: routable service module type  value: objc routable service module protocol bridged from the type, nil for pure Swift type
+    fileprivate static let routableServiceModuleProtocolCache = _RouteContainer<ObjectIdentifier, Protocol?>()
     #if DEBUG
     /// key: subclass of ZIKViewRouter or ZIKViewRoute  value: set of routable view protocols
-    internal static var _check_viewProtocolContainer = [_RouteKey: Set<_RouteKey>]()
+    internal static let _check_viewProtocolContainer = _RouteContainer<_RouteKey, Set<_RouteKey>>()
     /// key: subclass of ZIKServiceRouter or ZIKServiceRoute  value: set of routable service protocols
-    fileprivate static var _check_serviceProtocolContainer = [_RouteKey: Set<_RouteKey>]()
+    fileprivate static let _check_serviceProtocolContainer = _RouteContainer<_RouteKey, Set<_RouteKey>>()
     #endif
     
     /// Register pure Swift protocol or objc protocol for your service with a ZIKServiceRouter subclass. Router will check whether the registered service protocol is conformed by the registered service.
@@ -154,6 +239,7 @@ internal class Registry {
         _addToValidateList(for: routableService, router: router)
         #endif
         serviceProtocolContainer[_RouteKey(routable: routableService)] = router
+        _prebuildServiceRouterType(forRoute: router)
     }
     
     /// Register pure Swift protocol or objc protocol for your custom configuration with a ZIKServiceRouter subclass.  Router will check whether the registered config protocol is conformed by the defaultRouteConfiguration of the router.
@@ -176,6 +262,7 @@ internal class Registry {
         assert(router.defaultRouteConfiguration() is Protocol, "The module config protocol (\(configProtocol)) should be conformed by the router (\(router))'s defaultRouteConfiguration (\(Swift.type(of: router.defaultRouteConfiguration()))).")
         assert(serviceModuleProtocolContainer[_RouteKey(routable: routableServiceModule)] == nil, "service config protocol (\(configProtocol)) was already registered with router (\(serviceModuleProtocolContainer[_RouteKey(routable: routableServiceModule)]!)).")
         serviceModuleProtocolContainer[_RouteKey(routable: routableServiceModule)] = router
+        _prebuildServiceRouterType(forRoute: router)
     }
     
     /// Register pure Swift protocol or objc protocol for your service with a ZIKServiceRoute. Router will check whether the registered service protocol is conformed by the registered service.
@@ -199,6 +286,7 @@ internal class Registry {
         _addTovalidateList(for: routableService, route: route)
         #endif
         serviceProtocolContainer[_RouteKey(routable: routableService)] = route
+        _prebuildServiceRouterType(forRoute: route)
     }
     
     /// Register pure Swift protocol or objc protocol for your custom configuration with a ZIKServiceRoute. Router will check whether the registered config protocol is conformed by the defaultRouteConfiguration of the router.
@@ -219,6 +307,7 @@ internal class Registry {
         }
         assert(serviceModuleProtocolContainer[_RouteKey(routable: routableServiceModule)] == nil, "service config protocol (\(configProtocol)) was already registered with router (\(serviceModuleProtocolContainer[_RouteKey(routable: routableServiceModule)]!)).")
         serviceModuleProtocolContainer[_RouteKey(routable: routableServiceModule)] = route
+        _prebuildServiceRouterType(forRoute: route)
     }
     
     internal static func register<Adapter, Adaptee>(adapter: RoutableService<Adapter>, forAdaptee adaptee: RoutableService<Adaptee>) {
@@ -238,6 +327,8 @@ internal class Registry {
         
         if let objcAdapter = objcAdapter {
             adapterKey = _RouteKey(type: Adapter.self, name: adapter.typeName, adapterProtocol: objcAdapter)
+            // Objc registry looks up the adapter with objc protocol
+            serviceAdapterProtocolContainer[ObjectIdentifier(objcAdapter)] = adapterKey
         }
         let adapteeKey: _RouteKey
         if let objcAdaptee = objcAdaptee {
@@ -247,6 +338,9 @@ internal class Registry {
         }
         
         serviceAdapterContainer[adapterKey] = adapteeKey
+        if ZIKAnyServiceRouter.isRegistrationFinished() {
+            ZIKServiceRouteRegistry.invalidateResolvedRoutes()
+        }
     }
     
     internal static func register<Adapter, Adaptee>(adapter: RoutableServiceModule<Adapter>, forAdaptee adaptee: RoutableServiceModule<Adaptee>) {
@@ -266,6 +360,8 @@ internal class Registry {
         
         if let objcAdapter = objcAdapter {
             adapterKey = _RouteKey(type: Adapter.self, name: adapter.typeName, adapterProtocol: objcAdapter)
+            // Objc registry looks up the adapter with objc protocol
+            serviceModuleAdapterProtocolContainer[ObjectIdentifier(objcAdapter)] = adapterKey
         }
         let adapteeKey: _RouteKey
         if let objcAdaptee = objcAdaptee {
@@ -275,6 +371,9 @@ internal class Registry {
         }
         
         serviceModuleAdapterContainer[adapterKey] = adapteeKey
+        if ZIKAnyServiceRouter.isRegistrationFinished() {
+            ZIKServiceRouteRegistry.invalidateResolvedRoutes()
+        }
     }
     
     internal static let makingDestinationIdentifierPrefix = "~SwiftMakingDestination~"
@@ -291,8 +390,10 @@ internal class Registry {
             ZIKAnyServiceRouter.registerServiceProtocol(routableProtocol, forMakingService: destinationClass)
             return
         }
-        assert(_ZIKServiceRouterToIdentifier(makingDestinationIdentifierPrefix + routableService.typeName) == nil, "Protocol (\(routableService.typeName)) already registered with router (\(_ZIKServiceRouterToIdentifier(makingDestinationIdentifierPrefix + routableService.typeName)!.routeObject)), can't register for making destination (\(destinationClass))");
-        ZIKAnyServiceRouter.registerIdentifier(makingDestinationIdentifierPrefix + routableService.typeName, forMakingService: destinationClass)
+        let identifier = makingDestinationIdentifierPrefix + routableService.typeName
+        assert(_ZIKServiceRouterToIdentifier(identifier) == nil, "Protocol (\(routableService.typeName)) already registered with router (\(_ZIKServiceRouterToIdentifier(identifier)!.routeObject)), can't register for making destination (\(destinationClass))");
+        serviceMakingDestinationIdentifierContainer[_RouteKey(routable: routableService)] = identifier
+        ZIKAnyServiceRouter.registerIdentifier(identifier, forMakingService: destinationClass)
     }
     
     static func register<Protocol>(_ routableService: RoutableService<Protocol>, forMakingService destinationClass: AnyClass, making factory: @escaping (PerformRouteConfig) -> Protocol?) {
@@ -306,8 +407,10 @@ internal class Registry {
             _registerServiceProtocolWithSwiftFactory(routableProtocol, destinationClass, factory)
             return
         }
-        assert(_ZIKServiceRouterToIdentifier(makingDestinationIdentifierPrefix + routableService.typeName) == nil, "Protocol (\(routableService.typeName)) already registered with router (\(_ZIKServiceRouterToIdentifier(makingDestinationIdentifierPrefix + routableService.typeName)!.routeObject)), can't register for making destination (\(destinationClass)) with factory (\(String(describing: factory)))");
-        _registerServiceIdentifierWithSwiftFactory(makingDestinationIdentifierPrefix + routableService.typeName, destinationClass, factory)
+        let identifier = makingDestinationIdentifierPrefix + routableService.typeName
+        assert(_ZIKServiceRouterToIdentifier(identifier) == nil, "Protocol (\(routableService.typeName)) already registered with router (\(_ZIKServiceRouterToIdentifier(identifier)!.routeObject)), can't register for making destination (\(destinationClass)) with factory (\(String(describing: factory)))");
+        serviceMakingDestinationIdentifierContainer[_RouteKey(routable: routableService)] = identifier
+        _registerServiceIdentifierWithSwiftFactory(identifier, destinationClass, factory)
     }
     
     static func register<Protocol>(_ routableServiceModule: RoutableServiceModule<Protocol>, forMakingService destinationClass: AnyClass, making factory: @escaping () -> Protocol) {
@@ -318,8 +421,10 @@ internal class Registry {
             _registerServiceModuleProtocolWithSwiftFactory(routableProtocol, destinationClass, factory)
             return
         }
-        assert(_ZIKServiceRouterToIdentifier(makingModuleIdentifierPrefix + routableServiceModule.typeName) == nil, "Protocol (\(routableServiceModule.typeName)) already registered with router (\(_ZIKServiceRouterToIdentifier(makingModuleIdentifierPrefix + routableServiceModule.typeName)!.routeObject)), can't register for making destination (\(destinationClass)) with factory (\(String(describing: factory)))");
-        _registerServiceModuleIdentifierWithSwiftFactory(makingModuleIdentifierPrefix + routableServiceModule.typeName, destinationClass, factory)
+        let identifier = makingModuleIdentifierPrefix + routableServiceModule.typeName
+        assert(_ZIKServiceRouterToIdentifier(identifier) == nil, "Protocol (\(routableServiceModule.typeName)) already registered with router (\(_ZIKServiceRouterToIdentifier(identifier)!.routeObject)), can't register for making destination (\(destinationClass)) with factory (\(String(describing: factory)))");
+        serviceMakingModuleIdentifierContainer[_RouteKey(routable: routableServiceModule)] = identifier
+        _registerServiceModuleIdentifierWithSwiftFactory(identifier, destinationClass, factory)
     }
     
     // MARK: Validate
@@ -355,20 +460,35 @@ internal class Registry {
 
 extension ZIKServiceRouteRegistry {
     @objc class func _swiftRouteForDestinationAdapter(_ adapter: Protocol) -> Any? {
-        if let adaptee = Registry.serviceAdapterContainer[_RouteKey(protocol: adapter)] {
+        if let adapterKey = Registry.serviceAdapterProtocolContainer[ObjectIdentifier(adapter)], let adaptee = Registry.serviceAdapterContainer[adapterKey] {
             return Registry._swiftRouter(toServiceKey: adaptee)?.routeObject
         }
         return nil
     }
     
     @objc class func _swiftRouteForModuleAdapter(_ adapter: Protocol) -> Any? {
-        if let adaptee = Registry.serviceModuleAdapterContainer[_RouteKey(protocol: adapter)] {
+        if let adapterKey = Registry.serviceModuleAdapterProtocolContainer[ObjectIdentifier(adapter)], let adaptee = Registry.serviceModuleAdapterContainer[adapterKey] {
             return Registry._swiftRouter(toServiceModuleKey: adaptee)?.routeObject
         }
         return nil
     }
 }
 
+// MARK: Unregister
+
+extension ZIKServiceRouteRegistry {
+    /// Remove the router class or route registered with pure Swift protocols, called when unregistering in ZIKServiceRouteRegistry.
+    @objc class func _swiftUnregisterRoute(_ route: Any) {
+        let routeObject = route as AnyObject
+        Registry.serviceProtocolContainer.removeAll { ($1 as AnyObject) === routeObject }
+        Registry.serviceModuleProtocolContainer.removeAll { ($1 as AnyObject) === routeObject }
+        Registry.serviceRouterTypeContainer[ObjectIdentifier(routeObject)] = nil
+        #if DEBUG
+        Registry._check_serviceProtocolContainer[_RouteKey(route: route)] = nil
+        #endif
+    }
+}
+
 // MARK: Routable Discover
 internal extension Registry {
     
@@ -428,36 +548,70 @@ internal extension Registry {
 
 // MARK: Type Discover
 
+internal extension Registry {
+    
+    /// Objc routable protocol bridged from the type. Bridging is resolved once for each type, pure Swift types are cached as nil.
+    ///
+    /// - Parameters:
+    ///   - type: The routable type.
+    ///   - cache: Cache for the kind of routable protocol.
+    ///   - bridge: Function checking whether the object is a routable objc protocol.
+    /// - Returns: The objc protocol, or nil when the type is not an objc routable protocol.
+    static func _routableProtocol(of type: Any.Type, cache: _RouteContainer<ObjectIdentifier, Protocol?>, bridge: (Any) -> Protocol?) -> Protocol? {
+        let identifier = ObjectIdentifier(type)
+        if let cached = cache[identifier] {
+            return cached
+        }
+        let routableProtocol = bridge(type)
+        cache[identifier] = .some(routableProtocol)
+        return routableProtocol
+    }
+}
+
 fileprivate extension Registry {
     
+    /// Build the router type for a registered router class or route once, so lookups don't allocate a router type for each hit.
+    static func _prebuildServiceRouterType(forRoute route: Any) {
+        let identifier = ObjectIdentifier(route as AnyObject)
+        if serviceRouterTypeContainer[identifier] == nil, let routerType = ZIKAnyServiceRouterType.tryMakeType(forRoute: route) {
+            serviceRouterTypeContainer[identifier] = routerType
+        }
+    }
+    
+    static func _serviceRouterType(forRoute route: Any) -> ZIKAnyServiceRouterType? {
+        if let routerType = serviceRouterTypeContainer[ObjectIdentifier(route as AnyObject)] {
+            return routerType
+        }
+        return ZIKAnyServiceRouterType.tryMakeType(forRoute: route)
+    }
+    
     /// Get service router class for registered service protocol.
     ///
     /// - Parameter serviceProtocol: Service protocol conformed by the service registered with a service router. Support objc protocol and pure Swift protocol.
     /// - Parameter name: The name of the protocol.
     /// - Returns: The service router class for the service protocol.
     static func _router(toService serviceProtocol: Any.Type, name: String) -> ZIKAnyServiceRouterType? {
+        ZIKRouteRegistry.waitForBackgroundRegistration()
         if let routerType = _swiftRouter(toServiceKey: _RouteKey(type: serviceProtocol, name: name)) {
             return routerType
         }
-        if let routableProtocol = _routableServiceProtocolFromObject(serviceProtocol), let routerType = _ZIKServiceRouterToService(routableProtocol) {
-            return routerType
-        }
-        if _routableServiceProtocolFromObject(serviceProtocol) == nil {
-            ZIKAnyServiceRouter
-                .notifyGlobalError(
-                    with: nil,
-                    action: .toService,
-                    error: ZIKAnyServiceRouter.routeError(withCode:.invalidProtocol, localizedDescription:"Swift service protocol (\(serviceProtocol)) was not registered with any service router."))
-            assertionFailure("Swift service protocol (\(serviceProtocol)) was not registered with any service router.")
+        if let routableProtocol = _routableProtocol(of: serviceProtocol, cache: routableServiceProtocolCache, bridge: _routableServiceProtocolFromObject) {
+            return _ZIKServiceRouterToService(routableProtocol)
         }
+        ZIKAnyServiceRouter
+            .notifyGlobalError(
+                with: nil,
+                action: .toService,
+                error: ZIKAnyServiceRouter.routeError(withCode:.invalidProtocol, localizedDescription:"Swift service protocol (\(serviceProtocol)) was not registered with any service router."))
+        assertionFailure("Swift service protocol (\(serviceProtocol)) was not registered with any service router.")
         return nil
     }
     
     static func _swiftRouter(toServiceKey serviceRouteKey: _RouteKey) -> ZIKAnyServiceRouterType? {
-        if let route = serviceProtocolContainer[serviceRouteKey], let routerType = ZIKAnyServiceRouterType.tryMakeType(forRoute: route) {
+        if let route = serviceProtocolContainer[serviceRouteKey], let routerType = _serviceRouterType(forRoute: route) {
             return routerType
         }
-        if let routerType = _ZIKServiceRouterToIdentifier(makingDestinationIdentifierPrefix + serviceRouteKey.key) {
+        if let identifier = serviceMakingDestinationIdentifierContainer[serviceRouteKey], let routerType = _ZIKServiceRouterToIdentifier(identifier) {
             return routerType
         }
         #if DEBUG
@@ -468,7 +622,7 @@ fileprivate extension Registry {
         repeat {
             adaptee = serviceAdapterContainer[adapter]
             if let adaptee = adaptee {
-                if let route = serviceProtocolContainer[adaptee], let routerType = ZIKAnyServiceRouterType.tryMakeType(forRoute: route) {
+                if let route = serviceProtocolContainer[adaptee], let routerType = _serviceRouterType(forRoute: route) {
                     return routerType
                 }
                 if let adapteeProtocol = adaptee.adapterProtocol,
@@ -476,7 +630,7 @@ fileprivate extension Registry {
                     let routerType = _ZIKServiceRouterToService(routableProtocol) {
                     return routerType
                 }
-                if let routerType = _ZIKServiceRouterToIdentifier(makingDestinationIdentifierPrefix + adaptee.key) {
+                if let identifier = serviceMakingDestinationIdentifierContainer[adaptee], let routerType = _ZIKServiceRouterToIdentifier(identifier) {
                     return routerType
                 }
                 #if DEBUG
@@ -501,29 +655,27 @@ fileprivate extension Registry {
     /// - Parameter name: The name of the protocol.
     /// - Returns: The service router class for the config protocol.
     static func _router(toServiceModule configProtocol: Any.Type, name: String) -> ZIKAnyServiceRouterType? {
+        ZIKRouteRegistry.waitForBackgroundRegistration()
         if let routerType = _swiftRouter(toServiceModuleKey: _RouteKey(type: configProtocol, name: name)) {
             return routerType
         }
-        
-        if let routableProtocol = _routableServiceModuleProtocolFromObject(configProtocol), let routerType = _ZIKServiceRouterToModule(routableProtocol) {
-            return routerType
-        }
-        if _routableServiceModuleProtocolFromObject(configProtocol) == nil {
-            ZIKAnyServiceRouter
-                .notifyGlobalError(
-                    with: nil,
-                    action: .toServiceModule,
-                    error: ZIKAnyServiceRouter.routeError(withCode:.invalidProtocol, localizedDescription:"Swift module config protocol (\(configProtocol)) was not registered with any service router."))
-            assertionFailure("Swift module config protocol (\(configProtocol)) was not registered with any service router.")
+        if let routableProtocol = _routableProtocol(of: configProtocol, cache: routableServiceModuleProtocolCache, bridge: _routableServiceModuleProtocolFromObject) {
+            return _ZIKServiceRouterToModule(routableProtocol)
         }
+        ZIKAnyServiceRouter
+            .notifyGlobalError(
+                with: nil,
+                action: .toServiceModule,
+                error: ZIKAnyServiceRouter.routeError(withCode:.invalidProtocol, localizedDescription:"Swift module config protocol (\(configProtocol)) was not registered with any service router."))
+        assertionFailure("Swift module config protocol (\(configProtocol)) was not registered with any service router.")
         return nil
     }
     
     static func _swiftRouter(toServiceModuleKey moduleRouteKey: _RouteKey) -> ZIKAnyServiceRouterType? {
-        if let route = serviceModuleProtocolContainer[moduleRouteKey], let routerType = ZIKAnyServiceRouterType.tryMakeType(forRoute: route) {
+        if let route = serviceModuleProtocolContainer[moduleRouteKey], let routerType = _serviceRouterType(forRoute: route) {
             return routerType
         }
-        if let routerType = _ZIKServiceRouterToIdentifier(makingModuleIdentifierPrefix + moduleRouteKey.key) {
+        if let identifier = serviceMakingModuleIdentifierContainer[moduleRouteKey], let routerType = _ZIKServiceRouterToIdentifier(identifier) {
             return routerType
         }
         #if DEBUG
@@ -534,7 +686,7 @@ fileprivate extension Registry {
         repeat {
             adaptee = serviceModuleAdapterContainer[adapter]
             if let adaptee = adaptee {
-                if let route = serviceModuleProtocolContainer[adaptee], let routerType = ZIKAnyServiceRouterType.tryMakeType(forRoute: route) {
+                if let route = serviceModuleProtocolContainer[adaptee], let routerType = _serviceRouterType(forRoute: route) {
                     return routerType
                 }
                 if let adapteeProtocol = adaptee.adapterProtocol,
@@ -542,7 +694,7 @@ fileprivate extension Registry {
                     let routerType = _ZIKServiceRouterToModule(routableProtocol) {
                     return routerType
                 }
-                if let routerType = _ZIKServiceRouterToIdentifier(makingModuleIdentifierPrefix + adaptee.key) {
+                if let identifier = serviceMakingModuleIdentifierContainer[adaptee], let routerType = _ZIKServiceRouterToIdentifier(identifier) {
                     return routerType
                 }
                 #if DEBUG
@@ -598,13 +750,6 @@ extension String {
     }
 }
 
-internal func imagePathOfAddress(_ address: UnsafePointer<Int8>) -> String {
-    var info: Dl_info = Dl_info()
-    dladdr(address, &info)
-    let imagePath = String(cString: info.dli_fname)
-    return imagePath
-}
-
 internal extension String {
     var undotted: String {
         var undotted = self
@@ -642,80 +787,71 @@ private class _ServiceRouterValidater: ZIKServiceRouteAdapter {
         
         let serviceRoutingTypeRegex = try! NSRegularExpression(pattern: "(?<=RoutableService<).*(?=>$)", options: [.anchorsMatchLines])
         let serviceModuleRoutingTypeRegex = try! NSRegularExpression(pattern: "(?<=RoutableServiceModule<).*(?=>$)", options: [.anchorsMatchLines])
-        zix_enumerateSymbolName { (name, demangledAsSwift) -> Bool in
-            if (strstr(name, "RoutableService") != nil) {
-                let symbolName = demangledAsSwift(name, false)
-                if symbolName.hasPrefix("(extension in"), symbolName.contains(">.init") {
-                    if symbolName.contains("(extension in ZRouter)") == false {
-                        let simplifiedName = demangledAsSwift(name, true)
-                        declaredRoutableTypes.append(simplifiedName)
-                    } else if symbolName.contains(".NSObject"), symbolName.contains(".ZIKServiceRoutable") {
-                        let imagePath = imagePathOfAddress(name)
-                        assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
-                            Don't use a Class type as generic parameter of RoutableService:
-                            ```
-                            @objc protocol SomeServiceProtocol: ZIKServiceRoutable {
+        zix_enumerateSymbolNameContainingKeyword("RoutableService") { (symbolName, simplifiedName, imagePath) -> Bool in
+            if symbolName.hasPrefix("(extension in"), symbolName.contains(">.init") {
+                if symbolName.contains("(extension in ZRouter)") == false {
+                    declaredRoutableTypes.append(simplifiedName)
+                } else if symbolName.contains(".NSObject"), symbolName.contains(".ZIKServiceRoutable") {
+                    assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
+                        Don't use a Class type as generic parameter of RoutableService:
+                        ```
+                        @objc protocol SomeServiceProtocol: ZIKServiceRoutable {
 
-                            }
-                            class SomeClassType: NSObject, SomeServiceProtocol {
+                        }
+                        class SomeClassType: NSObject, SomeServiceProtocol {
 
-                            }
-                            ```
-                            ```
-                            // Invalid usage
-                            RoutableService<SomeClassType>()
-                            ```
-                            You should use the protocol to get its router.
-                            How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableService<SomeClassType>()` to `RoutableService<SomeServiceProtocol>()`
-                            If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
-                            (extension in ZRouter):ZRouter.RoutableService<A where A: __ObjC.NSObject, A: __ObjC.ZIKServiceRoutable>.init() -> ZRouter.RoutableService<A>
-                            """)
-                    } else if symbolName.contains(".ZIKPerformRouteConfiguration"), symbolName.contains(".ZIKServiceModuleRoutable") {
-                        let imagePath = imagePathOfAddress(name)
-                        assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
-                            Don't use a ZIKPerformRouteConfiguration as generic parameter of RoutableServiceModule:
-                            ```
-                            @objc protocol SomeServiceModuleProtocol: ZIKServiceModuleRoutable {
+                        }
+                        ```
+                        ```
+                        // Invalid usage
+                        RoutableService<SomeClassType>()
+                        ```
+                        You should use the protocol to get its router.
+                        How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableService<SomeClassType>()` to `RoutableService<SomeServiceProtocol>()`
+                        If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
+                        (extension in ZRouter):ZRouter.RoutableService<A where A: __ObjC.NSObject, A: __ObjC.ZIKServiceRoutable>.init() -> ZRouter.RoutableService<A>
+                        """)
+                } else if symbolName.contains(".ZIKPerformRouteConfiguration"), symbolName.contains(".ZIKServiceModuleRoutable") {
+                    assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
+                        Don't use a ZIKPerformRouteConfiguration as generic parameter of RoutableServiceModule:
+                        ```
+                        @objc protocol SomeServiceModuleProtocol: ZIKServiceModuleRoutable {
 
-                            }
-                            class SomeServiceRouteConfiguration: ZIKPerformRouteConfiguration, SomeServiceModuleProtocol {
+                        }
+                        class SomeServiceRouteConfiguration: ZIKPerformRouteConfiguration, SomeServiceModuleProtocol {
 
-                            }
-                            ```
-                            ```
-                            // Invalid usage
-                            RoutableServiceModule<SomeServiceRouteConfiguration>()
-                            ```
-                            You should use the protocol to get its router.
-                            How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableServiceModule<SomeServiceRouteConfiguration>()` to `RoutableServiceModule<SomeServiceModuleProtocol>()`
-                            If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
-                            (extension in ZRouter):ZRouter.RoutableServiceModule<A where A: __ObjC.ZIKPerformRouteConfiguration, A: __ObjC.ZIKServiceModuleRoutable>.init() -> ZRouter.RoutableServiceModule<A>
-                            """)
-                    } else if symbolName.contains("where"), symbolName.contains("=="), (symbolName.contains(".ZIKServiceRoutable>") || symbolName.contains(".ZIKServiceModuleRoutable>")) {
-                        let imagePath = imagePathOfAddress(name)
-                        assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
-                            Don't use ZIKServiceRoutable or ZIKServiceModuleRoutable as generic parameter:
-                            ```
-                            // Invalid usage
-                            RoutableService<ZIKServiceRoutable>()
-                            RoutableServiceModule<ZIKServiceModuleRoutable>()
-                            ```
-                            You should use the explicit protocol to get its router.
-                            How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableService<ZIKServiceRoutable>()` to `RoutableService<SomeServiceProtocol>()` or `RoutableServiceModule<ZIKServiceModuleRoutable>()` to `RoutableServiceModule<SomeServiceModuleProtocol>()`
-                            """)
-                    }
-                } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableService<") {
-                    let simplifiedName = demangledAsSwift(name, true)
-                    if let routingType = symbolName.subString(forRegex: serviceRoutingTypeRegex),
-                        let simplifiedRoutingType = simplifiedName.subString(forRegex: serviceRoutingTypeRegex) {
-                        serviceRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
-                    }
-                } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableServiceModule<") {
-                    let simplifiedName = demangledAsSwift(name, true)
-                    if let routingType = symbolName.subString(forRegex: serviceModuleRoutingTypeRegex),
-                        let simplifiedRoutingType = simplifiedName.subString(forRegex: serviceModuleRoutingTypeRegex) {
-                        serviceModuleRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
-                    }
+                        }
+                        ```
+                        ```
+                        // Invalid usage
+                        RoutableServiceModule<SomeServiceRouteConfiguration>()
+                        ```
+                        You should use the protocol to get its router.
+                        How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableServiceModule<SomeServiceRouteConfiguration>()` to `RoutableServiceModule<SomeServiceModuleProtocol>()`
+                        If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
+                        (extension in ZRouter):ZRouter.RoutableServiceModule<A where A: __ObjC.ZIKPerformRouteConfiguration, A: __ObjC.ZIKServiceModuleRoutable>.init() -> ZRouter.RoutableServiceModule<A>
+                        """)
+                } else if symbolName.contains("where"), symbolName.contains("=="), (symbolName.contains(".ZIKServiceRoutable>") || symbolName.contains(".ZIKServiceModuleRoutable>")) {
+                    assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
+                        Don't use ZIKServiceRoutable or ZIKServiceModuleRoutable as generic parameter:
+                        ```
+                        // Invalid usage
+                        RoutableService<ZIKServiceRoutable>()
+                        RoutableServiceModule<ZIKServiceModuleRoutable>()
+                        ```
+                        You should use the explicit protocol to get its router.
+                        How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableService<ZIKServiceRoutable>()` to `RoutableService<SomeServiceProtocol>()` or `RoutableServiceModule<ZIKServiceModuleRoutable>()` to `RoutableServiceModule<SomeServiceModuleProtocol>()`
+                        """)
+                }
+            } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableService<") {
+                if let routingType = symbolName.subString(forRegex: serviceRoutingTypeRegex),
+                    let simplifiedRoutingType = simplifiedName.subString(forRegex: serviceRoutingTypeRegex) {
+                    serviceRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
+                }
+            } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableServiceModule<") {
+                if let routingType = symbolName.subString(forRegex: serviceModuleRoutingTypeRegex),
+                    let simplifiedRoutingType = simplifiedName.subString(forRegex: serviceModuleRoutingTypeRegex) {
+                    serviceModuleRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
                 }
             }
             return true
@@ -734,15 +870,15 @@ private class _ServiceRouterValidater: ZIKServiceRouteAdapter {
         }
         
         for declaredProtocol in declaredDestinationProtocols {
-            if !(Registry.serviceProtocolContainer.keys.contains(_RouteKey(key: declaredProtocol)) ||
-                Registry.serviceAdapterContainer.keys.contains(_RouteKey(key: declaredProtocol)) ||
+            if !(Registry.serviceProtocolContainer.keys.contains { $0.key == declaredProtocol } ||
+                Registry.serviceAdapterContainer.keys.contains { $0.key == declaredProtocol } ||
                 _ZIKServiceRouterToIdentifier(Registry.makingDestinationIdentifierPrefix + declaredProtocol) != nil) {
                 errorDescription.append("\n\n❌Declared service protocol (\(declaredProtocol)) is not registered with any router.")
             }
         }
         for declaredProtocol in declaredModuleProtocols {
-            if !(Registry.serviceModuleProtocolContainer.keys.contains(_RouteKey(key: declaredProtocol)) ||
-                Registry.serviceModuleAdapterContainer.keys.contains(_RouteKey(key: declaredProtocol)) ||
+            if !(Registry.serviceModuleProtocolContainer.keys.contains { $0.key == declaredProtocol } ||
+                Registry.serviceModuleAdapterContainer.keys.contains { $0.key == declaredProtocol } ||
                 _ZIKServiceRouterToIdentifier(Registry.makingModuleIdentifierPrefix + declaredProtocol) != nil) {
                 errorDescription.append("\n\n❌Declared service module config protocol (\(declaredProtocol)) is not registered with any router.")
             }
@@ -776,14 +912,19 @@ private class _ServiceRouterValidater: ZIKServiceRouteAdapter {
         }
         
         // Destination should conforms to registered destination protocols
-        for (routeKey, route) in Registry.serviceProtocolContainer {
+        let serviceProtocolRoutes = Array(Registry.serviceProtocolContainer)
+        if let error = ZIKServiceRouteRegistry.validateConcurrently(withCount: serviceProtocolRoutes.count, handler: { (index) -> String? in
+            let (routeKey, route) = serviceProtocolRoutes[index]
             let serviceProtocol = routeKey.type!
             let badDestinationClass: AnyClass? = ZIKServiceRouteRegistry.validateDestinations(forRoute: route, handler: { (destinationClass) -> Bool in
                 return _swift_typeIsTargetType(destinationClass, serviceProtocol)
             })
             if badDestinationClass != nil {
-                errorDescription.append("\n\n❌Registered service class (\(badDestinationClass!)) for router (\(route)) should conform to registered service protocol (\(serviceProtocol)).")
+                return "\n\n❌Registered service class (\(badDestinationClass!)) for router (\(route)) should conform to registered service protocol (\(serviceProtocol))."
             }
+            return nil
+        }) {
+            errorDescription.append(error)
         }
         
         // Destination should conforms to registered adapter destination protocols
@@ -811,16 +952,21 @@ private class _ServiceRouterValidater: ZIKServiceRouteAdapter {
         }
         
         // Router's defaultRouteConfiguration should conforms to registered module config protocols
-        for (routeKey, route) in Registry.serviceModuleProtocolContainer {
+        let serviceModuleProtocolRoutes = Array(Registry.serviceModuleProtocolContainer)
+        if let error = ZIKServiceRouteRegistry.validateConcurrently(withCount: serviceModuleProtocolRoutes.count, handler: { (index) -> String? in
+            let (routeKey, route) = serviceModuleProtocolRoutes[index]
             guard let routerType = ZIKAnyServiceRouterType.tryMakeType(forRoute: route) else {
                 assertionFailure("Invalid route (\(route))")
-                continue
+                return nil
             }
             let configProtocol = routeKey.type!
             let configType = type(of: routerType.defaultRouteConfiguration())
             if _swift_typeIsTargetType(configType, configProtocol) == false {
-                errorDescription.append("\n\n❌The router (\(route))'s default configuration (\(configType)) must conform to the registered config protocol (\(configProtocol)).")
+                return "\n\n❌The router (\(route))'s default configuration (\(configType)) must conform to the registered config protocol (\(configProtocol))."
             }
+            return nil
+        }) {
+            errorDescription.append(error)
         }
         
         // Router's defaultRouteConfiguration should conforms to registered adapter module config protocols
@@ -47,6 +47,8 @@ public struct RoutableService<Protocol> {
     
     /// Only use this in initializers in extension, never use it in other place. This function provides much higher performance. When registering more than 500 routable modules, it will cost more than 100 ms, because `String(describing:)` has poor performance. This initializer can avoid using `String(describing:)`, and gives use a factor of 10 improvement in performance.
     ///
+    /// Run `Templates/generate_routable_type_names.sh` to replace `init(declaredProtocol:)` in declarations with this initializer, so the name is generated before compiling instead of typed by hand.
+    ///
     /// - Parameter declaredTypeName: The name of declared protocol in extension. Must be equal to the name from `String(describing: Protocol.self)`, or there will be assert failure.
     public init(declaredTypeName: String) {
         assert(declaredTypeName == String(describing: Protocol.self), "declaredTypeName should equal to String(describing:) of \(Protocol.self)")
@@ -82,6 +84,8 @@ public struct RoutableServiceModule<Protocol> {
     
     /// Only use this in initializers in extension, never use it in other place. This function provides much higher performance. When registering more than 500 routable modules, it will cost more than 100 ms, because `String(describing:)` has poor performance. This initializer can avoid using `String(describing:)`, and gives use a factor of 10 improvement in performance.
     ///
+    /// Run `Templates/generate_routable_type_names.sh` to replace `init(declaredProtocol:)` in declarations with this initializer, so the name is generated before compiling instead of typed by hand.
+    ///
     /// - Parameter declaredTypeName: The name of declared protocol in extension. Must be equal to the name from `String(describing: Protocol.self)`, or there will be assert failure.
     public init(declaredTypeName: String) {
         assert(declaredTypeName == String(describing: Protocol.self), "declaredTypeName should equal to String(describing:) of \(Protocol.self)")
@@ -51,6 +51,22 @@ public class Router {
         return Registry.router(to: switchableServiceModule)
     }
     
+    /// Get service router type for resolved switchable service. It doesn't search in registry again until routes are changed.
+    ///
+    /// - Parameter resolvedService: A switchable service bound to its router type.
+    /// - Returns: The service router type for the service protocol.
+    public static func to(_ resolvedService: ResolvedSwitchableService) -> ServiceRouterType<Any, PerformRouteConfig>? {
+        return resolvedService.routerType
+    }
+    
+    /// Get service router type for resolved switchable service module. It doesn't search in registry again until routes are changed.
+    ///
+    /// - Parameter resolvedServiceModule: A switchable service module bound to its router type.
+    /// - Returns: The service router type for the service module config protocol.
+    public static func to(_ resolvedServiceModule: ResolvedSwitchableServiceModule) -> ServiceRouterType<Any, PerformRouteConfig>? {
+        return resolvedServiceModule.routerType
+    }
+    
     // MARK: Identifier Discover
     
     /// Find service router registered with the unique identifier.
@@ -258,3 +274,33 @@ public extension Router {
     }
     
 }
+
+#if swift(>=5.5)
+
+// MARK: State Events
+
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, *)
+public extension Router {
+    
+    /// Batches of state changes of all routers, see `+[ZIKRouter addGlobalStateObserver:queue:]`. Batches are delivered from a background queue and buffered by the stream. Cancel the iterating task to stop observing.
+    static func stateEvents() -> AsyncStream<[ZIKRouterStateEvent]> {
+        return stateEvents(of: ZIKRouter<AnyObject, PerformRouteConfig, RemoveRouteConfig>.self)
+    }
+    
+    /// Batches of state changes of routers of the class and its subclasses, such as `ZIKAnyViewRouter.self`.
+    ///
+    /// - Parameter routerClass: Router class to observe.
+    /// - Returns: Stream of event batches in changing order.
+    static func stateEvents<Destination, Config, RemoveConfig>(of routerClass: ZIKRouter<Destination, Config, RemoveConfig>.Type) -> AsyncStream<[ZIKRouterStateEvent]> {
+        return AsyncStream { continuation in
+            let token = routerClass.addGlobalStateObserver({ events in
+                continuation.yield(events)
+            }, queue: nil)
+            continuation.onTermination = { _ in
+                routerClass.removeGlobalStateObserver(token)
+            }
+        }
+    }
+}
+
+#endif
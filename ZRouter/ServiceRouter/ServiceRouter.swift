@@ -11,23 +11,23 @@
 
 import ZIKRouter.Internal
 
-/// Swift Wrapper of ZIKServiceRouter class for supporting pure Swift generic type.
-public class ServiceRouterType<Destination, ModuleConfig> {
+/// Swift Wrapper of ZIKServiceRouter class for supporting pure Swift generic type. It's a value only holding the router type, so getting it from `Router.to` doesn't allocate, and the forwarding members are inlined into generic call sites.
+public struct ServiceRouterType<Destination, ModuleConfig> {
     
     /// The router type to wrap.
     public let routerType: ZIKAnyServiceRouterType
     
-    internal init(routerType: ZIKAnyServiceRouterType) {
+    @usableFromInline internal init(routerType: ZIKAnyServiceRouterType) {
         self.routerType = routerType
     }
     
     /// Default configuration to perform route.
-    public var defaultRouteConfiguration: ModuleConfig {
+    @inlinable public var defaultRouteConfiguration: ModuleConfig {
         return routerType.defaultRouteConfiguration() as! ModuleConfig
     }
     
     /// Default configuration to remove route.
-    public var defaultRemoveConfiguration: RemoveRouteConfig {
+    @inlinable public var defaultRemoveConfiguration: RemoveRouteConfig {
         return routerType.defaultRemoveConfiguration()
     }
     
@@ -56,14 +56,13 @@ public class ServiceRouterType<Destination, ModuleConfig> {
         }
         let routerType = self.routerType
         let router = routerType.perform(strictConfiguring: { (strictConfig, config) in
-            let prepareModule = { (prepare: (ModuleConfig) -> Void) in
+            configBuilder(PerformRouteStrictConfig(configuration: strictConfig), { prepare in
                 guard let moduleConfig = config as? ModuleConfig else {
                     assertionFailure("Bad implementation in router, configuration (\(config)) should be type (\(ModuleConfig.self))")
                     return
                 }
                 prepare(moduleConfig)
-            }
-            configBuilder(PerformRouteStrictConfig(configuration: strictConfig), prepareModule)
+            })
             #if DEBUG
             let successHandler = config.successHandler
             config.successHandler = { d in
@@ -122,12 +121,12 @@ public class ServiceRouterType<Destination, ModuleConfig> {
     // MARK: Make Destination
     
     /// Whether the destination is instantiated synchronously.
-    public var canMakeDestinationSynchronously: Bool {
+    @inlinable public var canMakeDestinationSynchronously: Bool {
         return routerType.canMakeDestinationSynchronously()
     }
     
     /// The router may can't make destination synchronously, or it's not for providing a destination but only for performing some actions.
-    public var canMakeDestination: Bool {
+    @inlinable public var canMakeDestination: Bool {
         return routerType.canMakeDestination()
     }
     
@@ -166,14 +165,13 @@ public class ServiceRouterType<Destination, ModuleConfig> {
     public func makeDestination(configuring configBuilder: (PerformRouteStrictConfig<Destination>, ModulePreparation) -> Void) -> Destination? {
         let routerType = self.routerType
         let destination = routerType.makeDestination(strictConfiguring: { (strictConfig, config) in
-            let prepareModule = { (prepare: (ModuleConfig) -> Void) in
+            configBuilder(PerformRouteStrictConfig(configuration: strictConfig), { prepare in
                 guard let moduleConfig = config as? ModuleConfig else {
                     assertionFailure("Bad implementation in router, configuration (\(config)) should be type (\(ModuleConfig.self))")
                     return
                 }
                 prepare(moduleConfig)
-            }
-            configBuilder(PerformRouteStrictConfig(configuration: strictConfig), prepareModule)
+            })
         })
         assert(destination == nil || ServiceRouterType._castedDestination(destination!, routerType: routerType) != nil, "Router (\(routerType)) returns wrong destination type (\(String(describing: destination))), destination should be \(Destination.self)")
         if let destination = destination {
@@ -201,16 +199,16 @@ public class ServiceRouterType<Destination, ModuleConfig> {
 }
 
 /// Swift Wrapper of ZIKServiceRouter for supporting pure Swift generic type.
-public class ServiceRouter<Destination, ModuleConfig> {
+public final class ServiceRouter<Destination, ModuleConfig> {
     /// The routed ZIKServiceRouter.
     public let router: ZIKAnyServiceRouter
     
-    internal init(router: ZIKAnyServiceRouter) {
+    @usableFromInline internal init(router: ZIKAnyServiceRouter) {
         self.router = router
     }
     
     /// State of route.
-    public var state: ZIKRouterState {
+    @inlinable public var state: ZIKRouterState {
         return router.state
     }
     
@@ -220,7 +218,7 @@ public class ServiceRouter<Destination, ModuleConfig> {
     }
     
     /// Configuration for module protocol.
-    public var config: ModuleConfig {
+    @inlinable public var config: ModuleConfig {
         return router.configuration as! ModuleConfig
     }
     
@@ -230,14 +228,14 @@ public class ServiceRouter<Destination, ModuleConfig> {
     }
     
     /// Latest error when route action failed.
-    public var error: Error? {
+    @inlinable public var error: Error? {
         return router.error
     }
     
     // MARK: Perform
     
     /// Whether the router can perform route now.
-    public var canPerform: Bool {
+    @inlinable public var canPerform: Bool {
         return router.canPerform()
     }
     
@@ -262,12 +260,12 @@ public class ServiceRouter<Destination, ModuleConfig> {
     // MARK: Remove
     
     /// Whether the router should be removed before another performing, when the router is performed already and the destination still exists.
-    public var shouldRemoveBeforePerform: Bool {
+    @inlinable public var shouldRemoveBeforePerform: Bool {
         return router.shouldRemoveBeforePerform()
     }
     
     /// Whether the router can remove route now. Default is false.
-    public var canRemove: Bool {
+    @inlinable public var canRemove: Bool {
         return router.canRemove()
     }
     
@@ -297,6 +295,213 @@ public class ServiceRouter<Destination, ModuleConfig> {
     }
 }
 
+#if swift(>=5.5)
+
+// MARK: Concurrency
+
+/// One async route action. The continuation is resumed once, directly from performer success or error handler of the router, so no completion closure is wrapped around it.
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, *)
+internal final class RouteTask<Result>: @unchecked Sendable {
+    private let lock = NSLock()
+    private var continuation: CheckedContinuation<Result, Error>?
+    private var cancelMaking: (() -> Void)?
+    private var isCancelled = false
+    private var isFinished = false
+    
+    /// Run the action and wait until it's resumed. `start` returns false when no router performed, then the task fails with `unavailableError`.
+    func run(unavailableError: @autoclosure () -> Error, _ start: (RouteTask<Result>) -> Bool) async throws -> Result {
+        return try await withTaskCancellationHandler(operation: {
+            try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Result, Error>) in
+                self.lock.lock()
+                self.continuation = continuation
+                let cancelled = self.isCancelled
+                self.lock.unlock()
+                if cancelled {
+                    self.resume(throwing: CancellationError())
+                    return
+                }
+                if start(self) == false {
+                    self.resume(throwing: unavailableError())
+                }
+            }
+        }, onCancel: {
+            self.cancel()
+        })
+    }
+    
+    func resume(returning result: Result) {
+        take()?.resume(returning: result)
+    }
+    
+    func resume(throwing error: Error) {
+        take()?.resume(throwing: error)
+    }
+    
+    /// Cancel making destination of the performed router when the task is cancelled. Cancel immediately if the task is already cancelled.
+    func onCancel(_ cancelMaking: @escaping () -> Void) {
+        lock.lock()
+        if isFinished {
+            lock.unlock()
+            return
+        }
+        if isCancelled {
+            lock.unlock()
+            cancelMaking()
+            return
+        }
+        self.cancelMaking = cancelMaking
+        lock.unlock()
+    }
+    
+    private func cancel() {
+        lock.lock()
+        isCancelled = true
+        let cancelMaking = self.cancelMaking
+        lock.unlock()
+        cancelMaking?()
+    }
+    
+    private func take() -> CheckedContinuation<Result, Error>? {
+        lock.lock()
+        defer { lock.unlock() }
+        if isFinished {
+            return nil
+        }
+        isFinished = true
+        let continuation = self.continuation
+        self.continuation = nil
+        cancelMaking = nil
+        return continuation
+    }
+}
+
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, *)
+public extension ServiceRouterType {
+    
+    /// Perform route and return the destination when route succeeds. It's not isolated to main actor, so services making destination in background don't block the main thread.
+    ///
+    /// Cancelling the task cancels making destination when the router's `makesDestinationInBackground` is true, then route fails with `ZIKRouteError.actionFailed`. Routers making destination synchronously complete before the cancellation is checked.
+    ///
+    /// - Parameters:
+    ///   - configBuilder: Build the configuration for performing route.
+    ///     - config: Config for performing route.
+    ///     - prepareModule: Prepare custom module config.
+    /// - Returns: The destination.
+    /// - Throws: Error from performer error handler of the router.
+    func performAsync(configuring configBuilder: (PerformRouteStrictConfig<Destination>, ModulePreparation) -> Void = { _, _ in }) async throws -> Destination {
+        let task = RouteTask<Destination>()
+        return try await task.run(unavailableError: ZIKAnyServiceRouter.routeError(withCode: .destinationUnavailable, localizedDescription: "Router (\(routerType)) can't perform route.")) { task in
+            let router = perform(configuring: { (config, prepareModule) in
+                configBuilder(config, prepareModule)
+                let successHandler = config.performerSuccessHandler
+                config.performerSuccessHandler = { destination in
+                    successHandler?(destination)
+                    task.resume(returning: destination)
+                }
+                let errorHandler = config.performerErrorHandler
+                config.performerErrorHandler = { (action, error) in
+                    errorHandler?(action, error)
+                    task.resume(throwing: error)
+                }
+            })
+            guard let performed = router else {
+                return false
+            }
+            task.onCancel { [weak router = performed.router] in
+                _ = router?.cancelMakingDestination()
+            }
+            return true
+        }
+    }
+    
+    /// Make destination without blocking the caller. When the router can make destination synchronously, destination is returned directly without suspending. Otherwise it performs route and waits, see `performAsync(configuring:)`.
+    ///
+    /// - Parameter configBuilder: Build the configuration for making destination.
+    /// - Returns: The destination.
+    /// - Throws: Error when the router fails to make destination.
+    func makeDestinationAsync(configuring configBuilder: (PerformRouteStrictConfig<Destination>, ModulePreparation) -> Void = { _, _ in }) async throws -> Destination {
+        if canMakeDestinationSynchronously {
+            try Task.checkCancellation()
+            var routeError: Error?
+            let destination = makeDestination(configuring: { (config, prepareModule) in
+                configBuilder(config, prepareModule)
+                let errorHandler = config.errorHandler
+                config.errorHandler = { (action, error) in
+                    errorHandler?(action, error)
+                    routeError = error
+                }
+            })
+            if let destination = destination {
+                return destination
+            }
+            throw routeError ?? ZIKAnyServiceRouter.routeError(withCode: .destinationUnavailable, localizedDescription: "Router (\(routerType)) returns nil for destination.")
+        }
+        return try await performAsync(configuring: configBuilder)
+    }
+}
+
+/// A state change of a router.
+public struct RouteStateChange {
+    public let oldState: ZIKRouterState
+    public let newState: ZIKRouterState
+}
+
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, *)
+internal extension AsyncStream where Element == RouteStateChange {
+    /// Stream of state changes from `-addStateObserver:`. Changes are buffered by the stream, so the router only yields an element on its thread.
+    init<Config, RemoveConfig>(stateChangesOf router: ZIKRouter<AnyObject, Config, RemoveConfig>) {
+        self.init { continuation in
+            let token = router.addStateObserver { (oldState, newState) in
+                continuation.yield(RouteStateChange(oldState: oldState, newState: newState))
+            }
+            continuation.onTermination = { [weak router] _ in
+                router?.removeStateObserver(token)
+            }
+        }
+    }
+}
+
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, *)
+public extension ServiceRouter {
+    
+    /// State changes of the router since the stream is created. Iterating it doesn't add latency to transitions. Cancel the iterating task to stop observing.
+    var stateChanges: AsyncStream<RouteStateChange> {
+        return AsyncStream(stateChangesOf: router)
+    }
+    
+    /// Perform route again and return the destination. See `ServiceRouterType.performAsync(configuring:)`.
+    func performRouteAsync() async throws -> Destination {
+        let task = RouteTask<Destination>()
+        let router = self.router
+        return try await task.run(unavailableError: ZIKAnyServiceRouter.routeError(withCode: .actionFailed, localizedDescription: "Router (\(router)) can't perform route.")) { task in
+            task.onCancel { [weak router] in
+                _ = router?.cancelMakingDestination()
+            }
+            performRoute(successHandler: { destination in
+                task.resume(returning: destination)
+            }, errorHandler: { (_, error) in
+                task.resume(throwing: error)
+            })
+            return true
+        }
+    }
+    
+    /// Remove route and wait until it's removed.
+    func removeRouteAsync() async throws {
+        let task = RouteTask<Void>()
+        return try await task.run(unavailableError: ZIKAnyServiceRouter.routeError(withCode: .actionFailed, localizedDescription: "Router (\(router)) can't remove route.")) { task in
+            removeRoute(successHandler: {
+                task.resume(returning: ())
+            }, errorHandler: { (_, error) in
+                task.resume(throwing: error)
+            })
+            return true
+        }
+    }
+}
+
+#endif
+
 // MARK: Makeable Config
 
 /// Convenient configuration as factory for destination for using custom configuration without configuration subclass.
@@ -380,6 +585,14 @@ open class ServiceMakeableConfiguration<Destination, Constructor>: ZIKSwiftServi
      */
     public var makeDestinationWith: Constructor
     
+    /// Make destination with a non-escaping factory and set it as makedDestination. Call it in makeDestinationWith to pass typed parameters to the destination's initializer directly, instead of capturing them in makeDestination, which is copied and wrapped to return `Any`. makeDestination is not set, so the configuration doesn't make destination again after makedDestination is used.
+    @discardableResult
+    public func makeDestination(using factory: () -> Destination?) -> Destination? {
+        let destination = factory()
+        makedDestination = destination
+        return destination
+    }
+    
     /**
      Asynchronous factory method passing required parameters for initializing destination module, and get destination in `didMakeDestination`. You should set makeDestination to capture parameters directly, so you don't need configuration subclass to hold parameters.
      Genetic Constructor is a function type like: ServiceMakeableConfiguration<LoginServiceInput, (String) -> Void>
@@ -601,6 +814,14 @@ open class AnyServiceMakeableConfiguration<Destination, Maker, Constructor>: ZIK
     /// Factory method passing required parameters and make destination. You should set makedDestination in makeDestinationWith.
     public var makeDestinationWith: Maker
     
+    /// Make destination with a non-escaping factory and set it as makedDestination. Call it in makeDestinationWith to pass typed parameters to the destination's initializer directly, instead of capturing them in makeDestination, which is copied and wrapped to return `Any`. makeDestination is not set, so the configuration doesn't make destination again after makedDestination is used.
+    @discardableResult
+    public func makeDestination(using factory: () -> Destination?) -> Destination? {
+        let destination = factory()
+        makedDestination = destination
+        return destination
+    }
+    
     /// Asynchronous factory method passing required parameters for initializing destination module, and get destination in `didMakeDestination`. You should set makeDestination to capture parameters directly, so you don't need configuration subclass to hold parameters.
     public var constructDestination: Constructor
     
@@ -835,6 +1056,25 @@ public class PerformRouteStrictConfig<Destination>: RouteStrictConfig<ZIKPerform
     public func addUserInfo(_ userInfo: [String : Any]) {
         configuration.addUserInfo(userInfo)
     }
+    
+    /// Add typed user info. Class instances are stored directly and other values are boxed once, without bridging a dictionary.
+    public func addUserInfo<Value>(_ value: Value, forKey key: UserInfoKey<Value>) {
+        configuration.addUserInfo(forKey: key.rawValue, object: value as AnyObject)
+    }
+    
+    /// Get typed user info. It reads the entry directly instead of bridging the whole `userInfo` into a Swift dictionary.
+    public func userInfo<Value>(forKey key: UserInfoKey<Value>) -> Value? {
+        return configuration.userInfoObject(forKey: key.rawValue) as? Value
+    }
+}
+
+/// Typed key for user info in route configuration.
+public struct UserInfoKey<Value> {
+    public let rawValue: String
+    
+    public init(_ rawValue: String) {
+        self.rawValue = rawValue
+    }
 }
 
 /// Proxy of ZIKRemoveRouteConfiguration to handle configuration in a type safe way.
@@ -9,6 +9,8 @@
 //  LICENSE file in the root directory of this source tree.
 //
 
+import ZIKRouter.Internal
+
 public struct SwitchableService {
     public let routableProtocol: Any.Type
     public let typeName: String
@@ -26,3 +28,87 @@ public struct SwitchableServiceModule {
         typeName = routableEntry.typeName
     }
 }
+
+/// Router type resolved once and kept until routes are changed. Reading it from any thread is thread safe.
+internal final class _ResolvedRouterType<RouterType> {
+    private let resolve: () -> RouterType?
+    private var routerType: RouterType?
+    /// Generation of routes when routerType was resolved, 0 when it's unresolved.
+    private var generation: UInt64 = 0
+    private let lock: UnsafeMutablePointer<pthread_mutex_t>
+    
+    internal init(resolve: @escaping () -> RouterType?) {
+        self.resolve = resolve
+        lock = UnsafeMutablePointer<pthread_mutex_t>.allocate(capacity: 1)
+        lock.initialize(to: pthread_mutex_t())
+        pthread_mutex_init(lock, nil)
+    }
+    
+    deinit {
+        pthread_mutex_destroy(lock)
+        lock.deinitialize(count: 1)
+        lock.deallocate()
+    }
+    
+    internal var value: RouterType? {
+        // Read generation before resolving, so routes changed while resolving make it stale
+        let currentGeneration = ZIKRouteRegistry.routesGeneration
+        pthread_mutex_lock(lock)
+        if generation == currentGeneration {
+            let routerType = self.routerType
+            pthread_mutex_unlock(lock)
+            return routerType
+        }
+        pthread_mutex_unlock(lock)
+        let routerType = resolve()
+        pthread_mutex_lock(lock)
+        self.routerType = routerType
+        generation = currentGeneration
+        pthread_mutex_unlock(lock)
+        return routerType
+    }
+}
+
+/// Switchable service bound to its router type. The router type is resolved at the first use, and resolved again only when routes are changed after registration is finished. Create it once for each variant and reuse it, variants can be compared with `===`.
+public final class ResolvedSwitchableService {
+    public let switchableService: SwitchableService
+    private let resolvedRouterType: _ResolvedRouterType<ServiceRouterType<Any, PerformRouteConfig>>
+    
+    public init(_ switchableService: SwitchableService) {
+        self.switchableService = switchableService
+        resolvedRouterType = _ResolvedRouterType {
+            return Registry.router(to: switchableService)
+        }
+    }
+    
+    public convenience init<Protocol>(_ routableEntry: RoutableService<Protocol>) {
+        self.init(SwitchableService(routableEntry))
+    }
+    
+    /// The service router type for the service protocol.
+    public var routerType: ServiceRouterType<Any, PerformRouteConfig>? {
+        return resolvedRouterType.value
+    }
+}
+
+/// Switchable service module bound to its router type. The router type is resolved at the first use, and resolved again only when routes are changed after registration is finished. Create it once for each variant and reuse it, variants can be compared with `===`.
+public final class ResolvedSwitchableServiceModule {
+    public let switchableServiceModule: SwitchableServiceModule
+    private let resolvedRouterType: _ResolvedRouterType<ServiceRouterType<Any, PerformRouteConfig>>
+    
+    public init(_ switchableServiceModule: SwitchableServiceModule) {
+        self.switchableServiceModule = switchableServiceModule
+        resolvedRouterType = _ResolvedRouterType {
+            return Registry.router(to: switchableServiceModule)
+        }
+    }
+    
+    public convenience init<Protocol>(_ routableEntry: RoutableServiceModule<Protocol>) {
+        self.init(SwitchableServiceModule(routableEntry))
+    }
+    
+    /// The service router type for the service module config protocol.
+    public var routerType: ServiceRouterType<Any, PerformRouteConfig>? {
+        return resolvedRouterType.value
+    }
+}
@@ -63,6 +63,7 @@ extension Registry {
         _addToValidateList(for: routableView, router: router)
         #endif
         viewProtocolContainer[_RouteKey(routable: routableView)] = router
+        _prebuildViewRouterType(forRoute: router)
     }
     
     /// Register pure Swift protocol or objc protocol for your custom configuration with a ZIKViewRouter subclass. Router will check whether the registered config protocol is conformed by the defaultRouteConfiguration of the router.
@@ -85,6 +86,7 @@ extension Registry {
         assert(router.defaultRouteConfiguration() is Protocol, "The module config protocol (\(configProtocol)) should be conformed by the router (\(router))'s defaultRouteConfiguration (\(Swift.type(of: router.defaultRouteConfiguration()))).")
         assert(viewModuleProtocolContainer[_RouteKey(routable: routableViewModule)] == nil, "view config protocol (\(configProtocol)) was already registered with router (\(viewModuleProtocolContainer[_RouteKey(routable: routableViewModule)]!)).")
         viewModuleProtocolContainer[_RouteKey(routable: routableViewModule)] = router
+        _prebuildViewRouterType(forRoute: router)
     }
     
     /// Register pure Swift protocol or objc protocol for view with a ZIKViewRoute. Router will check whether the registered view protocol is conformed by the registered view.
@@ -108,6 +110,7 @@ extension Registry {
         _addTovalidateList(for: routableView, route: route)
         #endif
         viewProtocolContainer[_RouteKey(routable: routableView)] = route
+        _prebuildViewRouterType(forRoute: route)
     }
     
     /// Register pure Swift protocol or objc protocol for your custom configuration with a ZIKViewRoute. Router will check whether the registered config protocol is conformed by the defaultRouteConfiguration of the router.
@@ -128,6 +131,7 @@ extension Registry {
         }
         assert(viewModuleProtocolContainer[_RouteKey(routable: routableViewModule)] == nil, "view config protocol (\(configProtocol)) was already registered with router (\(viewModuleProtocolContainer[_RouteKey(routable: routableViewModule)]!)).")
         viewModuleProtocolContainer[_RouteKey(routable: routableViewModule)] = route
+        _prebuildViewRouterType(forRoute: route)
     }
     
     internal static func register<Adapter, Adaptee>(adapter: RoutableView<Adapter>, forAdaptee adaptee: RoutableView<Adaptee>) {
@@ -147,6 +151,8 @@ extension Registry {
         
         if let objcAdapter = objcAdapter {
             adapterKey = _RouteKey(type: Adapter.self, name: adapter.typeName, adapterProtocol: objcAdapter)
+            // Objc registry looks up the adapter with objc protocol
+            viewAdapterProtocolContainer[ObjectIdentifier(objcAdapter)] = adapterKey
         }
         let adapteeKey: _RouteKey
         if let objcAdaptee = objcAdaptee {
@@ -156,6 +162,9 @@ extension Registry {
         }
         
         viewAdapterContainer[adapterKey] = adapteeKey
+        if ZIKAnyViewRouter.isRegistrationFinished() {
+            ZIKViewRouteRegistry.invalidateResolvedRoutes()
+        }
     }
     
     internal static func register<Adapter, Adaptee>(adapter: RoutableViewModule<Adapter>, forAdaptee adaptee: RoutableViewModule<Adaptee>) {
@@ -175,6 +184,8 @@ extension Registry {
         
         if let objcAdapter = objcAdapter {
             adapterKey = _RouteKey(type: Adapter.self, name: adapter.typeName, adapterProtocol: objcAdapter)
+            // Objc registry looks up the adapter with objc protocol
+            viewModuleAdapterProtocolContainer[ObjectIdentifier(objcAdapter)] = adapterKey
         }
         let adapteeKey: _RouteKey
         if let objcAdaptee = objcAdaptee {
@@ -184,6 +195,9 @@ extension Registry {
         }
         
         viewModuleAdapterContainer[adapterKey] = adapteeKey
+        if ZIKAnyViewRouter.isRegistrationFinished() {
+            ZIKViewRouteRegistry.invalidateResolvedRoutes()
+        }
     }
     
     internal static func register<Protocol>(_ routableView: RoutableView<Protocol>, forMakingView destinationClass: AnyClass) {
@@ -197,8 +211,10 @@ extension Registry {
             ZIKAnyViewRouter.registerViewProtocol(routableProtocol, forMakingView: destinationClass)
             return
         }
-        assert(_ZIKViewRouterToIdentifier(makingDestinationIdentifierPrefix + routableView.typeName) == nil, "Protocol (\(routableView.typeName)) already registered with router (\(_ZIKViewRouterToIdentifier(makingDestinationIdentifierPrefix + routableView.typeName)!.routeObject)), can't register for making destination (\(destinationClass))");
-        ZIKAnyViewRouter.registerIdentifier(makingDestinationIdentifierPrefix + routableView.typeName, forMakingView: destinationClass)
+        let identifier = makingDestinationIdentifierPrefix + routableView.typeName
+        assert(_ZIKViewRouterToIdentifier(identifier) == nil, "Protocol (\(routableView.typeName)) already registered with router (\(_ZIKViewRouterToIdentifier(identifier)!.routeObject)), can't register for making destination (\(destinationClass))");
+        viewMakingDestinationIdentifierContainer[_RouteKey(routable: routableView)] = identifier
+        ZIKAnyViewRouter.registerIdentifier(identifier, forMakingView: destinationClass)
     }
     
     internal static func register<Protocol>(_ routableView: RoutableView<Protocol>, forMakingView destinationClass: AnyClass, making factory: @escaping (ViewRouteConfig) -> Protocol?) {
@@ -212,8 +228,10 @@ extension Registry {
             _registerViewProtocolWithSwiftFactory(routableProtocol, destinationClass, factory)
             return
         }
-        assert(_ZIKViewRouterToIdentifier(makingDestinationIdentifierPrefix + routableView.typeName) == nil, "Protocol (\(routableView.typeName)) already registered with router (\(_ZIKViewRouterToIdentifier(makingDestinationIdentifierPrefix + routableView.typeName)!.routeObject)), can't register for making destination (\(destinationClass)) with factory (\(String(describing: factory)))");
-        _registerViewIdentifierWithSwiftFactory(makingDestinationIdentifierPrefix + routableView.typeName, destinationClass, factory)
+        let identifier = makingDestinationIdentifierPrefix + routableView.typeName
+        assert(_ZIKViewRouterToIdentifier(identifier) == nil, "Protocol (\(routableView.typeName)) already registered with router (\(_ZIKViewRouterToIdentifier(identifier)!.routeObject)), can't register for making destination (\(destinationClass)) with factory (\(String(describing: factory)))");
+        viewMakingDestinationIdentifierContainer[_RouteKey(routable: routableView)] = identifier
+        _registerViewIdentifierWithSwiftFactory(identifier, destinationClass, factory)
     }
     
     static func register<Protocol>(_ routableViewModule: RoutableViewModule<Protocol>, forMakingView destinationClass: AnyClass, making factory: @escaping () -> Protocol) {
@@ -224,8 +242,10 @@ extension Registry {
             _registerViewModuleProtocolWithSwiftFactory(routableProtocol, destinationClass, factory)
             return
         }
-        assert(_ZIKViewRouterToIdentifier(makingModuleIdentifierPrefix + routableViewModule.typeName) == nil, "Protocol (\(routableViewModule.typeName)) already registered with router (\(_ZIKViewRouterToIdentifier(makingModuleIdentifierPrefix + routableViewModule.typeName)!.routeObject)), can't register for making destination (\(destinationClass)) with factory (\(String(describing: factory)))");
-        _registerViewModuleIdentifierWithSwiftFactory(makingModuleIdentifierPrefix + routableViewModule.typeName, destinationClass, factory)
+        let identifier = makingModuleIdentifierPrefix + routableViewModule.typeName
+        assert(_ZIKViewRouterToIdentifier(identifier) == nil, "Protocol (\(routableViewModule.typeName)) already registered with router (\(_ZIKViewRouterToIdentifier(identifier)!.routeObject)), can't register for making destination (\(destinationClass)) with factory (\(String(describing: factory)))");
+        viewMakingModuleIdentifierContainer[_RouteKey(routable: routableViewModule)] = identifier
+        _registerViewModuleIdentifierWithSwiftFactory(identifier, destinationClass, factory)
     }
     
     // MARK: Validate
@@ -261,20 +281,35 @@ extension Registry {
 
 extension ZIKViewRouteRegistry {
     @objc class func _swiftRouteForDestinationAdapter(_ adapter: Protocol) -> Any? {
-        guard let adaptee = Registry.viewAdapterContainer[_RouteKey(protocol: adapter)] else {
+        guard let adapterKey = Registry.viewAdapterProtocolContainer[ObjectIdentifier(adapter)], let adaptee = Registry.viewAdapterContainer[adapterKey] else {
             return nil
         }
         return Registry._swiftRouter(toViewKey: adaptee)?.routeObject
     }
     
     @objc class func _swiftRouteForModuleAdapter(_ adapter: Protocol) -> Any? {
-        guard let adaptee = Registry.viewModuleAdapterContainer[_RouteKey(protocol: adapter)] else {
+        guard let adapterKey = Registry.viewModuleAdapterProtocolContainer[ObjectIdentifier(adapter)], let adaptee = Registry.viewModuleAdapterContainer[adapterKey] else {
             return nil
         }
         return Registry._swiftRouter(toViewModuleKey: adaptee)?.routeObject
     }
 }
 
+// MARK: Unregister
+
+extension ZIKViewRouteRegistry {
+    /// Remove the router class or route registered with pure Swift protocols, called when unregistering in ZIKViewRouteRegistry.
+    @objc class func _swiftUnregisterRoute(_ route: Any) {
+        let routeObject = route as AnyObject
+        Registry.viewProtocolContainer.removeAll { ($1 as AnyObject) === routeObject }
+        Registry.viewModuleProtocolContainer.removeAll { ($1 as AnyObject) === routeObject }
+        Registry.viewRouterTypeContainer[ObjectIdentifier(routeObject)] = nil
+        #if DEBUG
+        Registry._check_viewProtocolContainer[_RouteKey(route: route)] = nil
+        #endif
+    }
+}
+
 // MARK: Routable Discover
 internal extension Registry {
     
@@ -337,34 +372,48 @@ internal extension Registry {
 
 fileprivate extension Registry {
     
+    /// Build the router type for a registered router class or route once, so lookups don't allocate a router type for each hit.
+    static func _prebuildViewRouterType(forRoute route: Any) {
+        let identifier = ObjectIdentifier(route as AnyObject)
+        if viewRouterTypeContainer[identifier] == nil, let routerType = ZIKAnyViewRouterType.tryMakeType(forRoute: route) {
+            viewRouterTypeContainer[identifier] = routerType
+        }
+    }
+    
+    static func _viewRouterType(forRoute route: Any) -> ZIKAnyViewRouterType? {
+        if let routerType = viewRouterTypeContainer[ObjectIdentifier(route as AnyObject)] {
+            return routerType
+        }
+        return ZIKAnyViewRouterType.tryMakeType(forRoute: route)
+    }
+    
     /// Get view router class for registered view protocol.
     ///
     /// - Parameter viewProtocol: View protocol conformed by the view registered with a view router. Support objc protocol and pure Swift protocol.
     /// - Parameter name: The name of the protocol.
     /// - Returns: The view router class for the view protocol.
     static func _router(toView viewProtocol: Any.Type, name: String) -> ZIKAnyViewRouterType? {
+        ZIKRouteRegistry.waitForBackgroundRegistration()
         if let routerType = _swiftRouter(toViewKey: _RouteKey(type: viewProtocol, name: name)) {
             return routerType
         }
-        if let routableProtocol = _routableViewProtocolFromObject(viewProtocol), let routerType = _ZIKViewRouterToView(routableProtocol) {
-            return routerType
-        }
-        if _routableViewProtocolFromObject(viewProtocol) == nil {
-            ZIKAnyViewRouter
-                .notifyGlobalError(
-                    with: nil,
-                    action: .toView,
-                    error: ZIKAnyViewRouter.routeError(withCode:.invalidProtocol, localizedDescription:"Swift view protocol (\(viewProtocol)) was not registered with any view router."))
-            assertionFailure("Swift view protocol (\(viewProtocol)) was not registered with any view router.")
+        if let routableProtocol = _routableProtocol(of: viewProtocol, cache: routableViewProtocolCache, bridge: _routableViewProtocolFromObject) {
+            return _ZIKViewRouterToView(routableProtocol)
         }
+        ZIKAnyViewRouter
+            .notifyGlobalError(
+                with: nil,
+                action: .toView,
+                error: ZIKAnyViewRouter.routeError(withCode:.invalidProtocol, localizedDescription:"Swift view protocol (\(viewProtocol)) was not registered with any view router."))
+        assertionFailure("Swift view protocol (\(viewProtocol)) was not registered with any view router.")
         return nil
     }
     
     static func _swiftRouter(toViewKey viewRouteKey: _RouteKey) -> ZIKAnyViewRouterType? {
-        if let route = viewProtocolContainer[viewRouteKey], let routerType = ZIKAnyViewRouterType.tryMakeType(forRoute: route) {
+        if let route = viewProtocolContainer[viewRouteKey], let routerType = _viewRouterType(forRoute: route) {
             return routerType
         }
-        if let routerType = _ZIKViewRouterToIdentifier(makingDestinationIdentifierPrefix + viewRouteKey.key) {
+        if let identifier = viewMakingDestinationIdentifierContainer[viewRouteKey], let routerType = _ZIKViewRouterToIdentifier(identifier) {
             return routerType
         }
         #if DEBUG
@@ -375,7 +424,7 @@ fileprivate extension Registry {
         repeat {
             adaptee = viewAdapterContainer[adapter]
             if let adaptee = adaptee {
-                if let route = viewProtocolContainer[adaptee], let routerType = ZIKAnyViewRouterType.tryMakeType(forRoute: route) {
+                if let route = viewProtocolContainer[adaptee], let routerType = _viewRouterType(forRoute: route) {
                     return routerType
                 }
                 if let adapteeProtocol = adaptee.adapterProtocol,
@@ -383,7 +432,7 @@ fileprivate extension Registry {
                     let routerType = _ZIKViewRouterToView(routableProtocol) {
                     return routerType
                 }
-                if let routerType = _ZIKViewRouterToIdentifier(makingDestinationIdentifierPrefix + adaptee.key) {
+                if let identifier = viewMakingDestinationIdentifierContainer[adaptee], let routerType = _ZIKViewRouterToIdentifier(identifier) {
                     return routerType
                 }
                 #if DEBUG
@@ -408,29 +457,27 @@ fileprivate extension Registry {
     /// - Parameter name: The name of the protocol.
     /// - Returns: The view router class for the config protocol.
     static func _router(toViewModule configProtocol: Any.Type, name: String) -> ZIKAnyViewRouterType? {
+        ZIKRouteRegistry.waitForBackgroundRegistration()
         if let routerType = _swiftRouter(toViewModuleKey: _RouteKey(type: configProtocol, name: name)) {
             return routerType
         }
-        if let routableProtocol = _routableViewModuleProtocolFromObject(configProtocol), let routerType = _ZIKViewRouterToModule(routableProtocol) {
-            return routerType
-        }
-        
-        if _routableViewModuleProtocolFromObject(configProtocol) == nil {
-            ZIKAnyViewRouter
-                .notifyGlobalError(
-                    with: nil,
-                    action: .toViewModule,
-                    error: ZIKAnyViewRouter.routeError(withCode:.invalidProtocol, localizedDescription:"Swift module config protocol (\(configProtocol)) was not registered with any view router."))
-            assertionFailure("Swift module config protocol (\(configProtocol)) was not registered with any view router.")
+        if let routableProtocol = _routableProtocol(of: configProtocol, cache: routableViewModuleProtocolCache, bridge: _routableViewModuleProtocolFromObject) {
+            return _ZIKViewRouterToModule(routableProtocol)
         }
+        ZIKAnyViewRouter
+            .notifyGlobalError(
+                with: nil,
+                action: .toViewModule,
+                error: ZIKAnyViewRouter.routeError(withCode:.invalidProtocol, localizedDescription:"Swift module config protocol (\(configProtocol)) was not registered with any view router."))
+        assertionFailure("Swift module config protocol (\(configProtocol)) was not registered with any view router.")
         return nil
     }
     
     static func _swiftRouter(toViewModuleKey moduleRouteKey: _RouteKey) -> ZIKAnyViewRouterType? {
-        if let route = viewModuleProtocolContainer[moduleRouteKey], let routerType = ZIKAnyViewRouterType.tryMakeType(forRoute: route) {
+        if let route = viewModuleProtocolContainer[moduleRouteKey], let routerType = _viewRouterType(forRoute: route) {
             return routerType
         }
-        if let routerType = _ZIKViewRouterToIdentifier(makingModuleIdentifierPrefix + moduleRouteKey.key) {
+        if let identifier = viewMakingModuleIdentifierContainer[moduleRouteKey], let routerType = _ZIKViewRouterToIdentifier(identifier) {
             return routerType
         }
         #if DEBUG
@@ -441,7 +488,7 @@ fileprivate extension Registry {
         repeat {
             adaptee = viewModuleAdapterContainer[adapter]
             if let adaptee = adaptee {
-                if let route = viewModuleProtocolContainer[adaptee], let routerType = ZIKAnyViewRouterType.tryMakeType(forRoute: route) {
+                if let route = viewModuleProtocolContainer[adaptee], let routerType = _viewRouterType(forRoute: route) {
                     return routerType
                 }
                 if let adapteeProtocol = adaptee.adapterProtocol,
@@ -449,7 +496,7 @@ fileprivate extension Registry {
                     let routerType = _ZIKViewRouterToModule(routableProtocol) {
                     return routerType
                 }
-                if let routerType = _ZIKViewRouterToIdentifier(makingModuleIdentifierPrefix + adaptee.key) {
+                if let identifier = viewMakingModuleIdentifierContainer[adaptee], let routerType = _ZIKViewRouterToIdentifier(identifier) {
                     return routerType
                 }
                 #if DEBUG
@@ -511,101 +558,91 @@ private class _ViewRouterValidater: ZIKViewRouteAdapter {
         var viewModuleRoutingTypes = [(String, String)]()
         let viewRoutingTypeRegex = try! NSRegularExpression(pattern: "(?<=RoutableView<).*(?=>$)", options: [.anchorsMatchLines])
         let viewModuleRoutingTypeRegex = try! NSRegularExpression(pattern: "(?<=RoutableViewModule<).*(?=>$)", options: [.anchorsMatchLines])
-        zix_enumerateSymbolName { (name, demangledAsSwift) -> Bool in            
-            if (strstr(name, "RoutableView") != nil) {
-                let symbolName = demangledAsSwift(name, false)
-                if symbolName.hasPrefix("(extension in"), symbolName.contains(">.init") {
-                    if symbolName.contains("(extension in ZRouter)") == false {
-                        let simplifiedName = demangledAsSwift(name, true)
-                        declaredRoutableTypes.append(simplifiedName)
-                    } else if symbolName.contains("." + String(describing: ViewController.self)), symbolName.contains(".ZIKViewRoutable") {
-                        let imagePath = imagePathOfAddress(name)
-                        assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
-                            Don't use an UIViewController as generic parameter of RoutableView:
-                            ```
-                            @objc protocol SomeViewProtocol: ZIKViewRoutable {
+        zix_enumerateSymbolNameContainingKeyword("RoutableView") { (symbolName, simplifiedName, imagePath) -> Bool in
+            if symbolName.hasPrefix("(extension in"), symbolName.contains(">.init") {
+                if symbolName.contains("(extension in ZRouter)") == false {
+                    declaredRoutableTypes.append(simplifiedName)
+                } else if symbolName.contains("." + String(describing: ViewController.self)), symbolName.contains(".ZIKViewRoutable") {
+                    assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
+                        Don't use an UIViewController as generic parameter of RoutableView:
+                        ```
+                        @objc protocol SomeViewProtocol: ZIKViewRoutable {
 
-                            }
-                            class SomeViewController: \(String(describing: ViewController.self)), SomeViewProtocol {
+                        }
+                        class SomeViewController: \(String(describing: ViewController.self)), SomeViewProtocol {
 
-                            }
-                            ```
-                            ```
-                            // Invalid usage
-                            RoutableView<SomeViewController>()
-                            ```
-                            You should use the protocol to get its router.
-                            How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableView<SomeViewController>()` to `RoutableView<SomeViewProtocol>()`
-                            If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
-                            (extension in ZRouter):ZRouter.RoutableView<A where A: __ObjC.\(String(describing: ViewController.self)), A: __ObjC.ZIKViewRoutable>.init() -> ZRouter.RoutableView<A>
-                            """)
-                    } else if symbolName.contains("." + String(describing: View.self)), symbolName.contains(".ZIKViewRoutable") {
-                        let imagePath = imagePathOfAddress(name)
-                        assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
-                            Don't use an UIViewController as generic parameter of RoutableView:
-                            ```
-                            @objc protocol SomeViewProtocol: ZIKViewRoutable {
-                            
-                            }
-                            class SomeView: \(String(describing: View.self)), SomeViewProtocol {
-                            
-                            }
-                            ```
-                            ```
-                            // Invalid usage
-                            RoutableView<SomeView>()
-                            ```
-                            You should use the protocol to get its router.
-                            How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableView<SomeView>()` to `RoutableView<SomeViewProtocol>()`
-                            If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
-                            (extension in ZRouter):ZRouter.RoutableView<A where A: __ObjC.\(String(describing: View.self)), A: __ObjC.ZIKViewRoutable>.init() -> ZRouter.RoutableView<A>
-                            """)
-                    } else if symbolName.contains(".ZIKViewRouteConfiguration"), symbolName.contains(".ZIKViewModuleRoutable") {
-                        let imagePath = imagePathOfAddress(name)
-                        assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
-                            Don't use a ZIKViewRouteConfiguration as generic parameter of RoutableViewModule:
-                            ```
-                            @objc protocol SomeViewModuleProtocol: ZIKViewModuleRoutable {
+                        }
+                        ```
+                        ```
+                        // Invalid usage
+                        RoutableView<SomeViewController>()
+                        ```
+                        You should use the protocol to get its router.
+                        How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableView<SomeViewController>()` to `RoutableView<SomeViewProtocol>()`
+                        If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
+                        (extension in ZRouter):ZRouter.RoutableView<A where A: __ObjC.\(String(describing: ViewController.self)), A: __ObjC.ZIKViewRoutable>.init() -> ZRouter.RoutableView<A>
+                        """)
+                } else if symbolName.contains("." + String(describing: View.self)), symbolName.contains(".ZIKViewRoutable") {
+                    assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
+                        Don't use an UIViewController as generic parameter of RoutableView:
+                        ```
+                        @objc protocol SomeViewProtocol: ZIKViewRoutable {
+                        
+                        }
+                        class SomeView: \(String(describing: View.self)), SomeViewProtocol {
+                        
+                        }
+                        ```
+                        ```
+                        // Invalid usage
+                        RoutableView<SomeView>()
+                        ```
+                        You should use the protocol to get its router.
+                        How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableView<SomeView>()` to `RoutableView<SomeViewProtocol>()`
+                        If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
+                        (extension in ZRouter):ZRouter.RoutableView<A where A: __ObjC.\(String(describing: View.self)), A: __ObjC.ZIKViewRoutable>.init() -> ZRouter.RoutableView<A>
+                        """)
+                } else if symbolName.contains(".ZIKViewRouteConfiguration"), symbolName.contains(".ZIKViewModuleRoutable") {
+                    assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
+                        Don't use a ZIKViewRouteConfiguration as generic parameter of RoutableViewModule:
+                        ```
+                        @objc protocol SomeViewModuleProtocol: ZIKViewModuleRoutable {
 
-                            }
-                            class SomeViewRouteConfiguration: ZIKViewRouteConfiguration, SomeViewModuleProtocol {
+                        }
+                        class SomeViewRouteConfiguration: ZIKViewRouteConfiguration, SomeViewModuleProtocol {
 
-                            }
-                            ```
-                            ```
-                            // Invalid usage
-                            RoutableViewModule<SomeViewRouteConfiguration>()
-                            ```
-                            You should use the protocol to get its router.
-                            How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableViewModule<SomeViewRouteConfiguration>()` to `RoutableViewModule<SomeViewModuleProtocol>()`
-                            If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
-                            (extension in ZRouter):ZRouter.RoutableViewModule<A where A: __ObjC.ZIKViewRouteConfiguration, A: __ObjC.ZIKViewModuleRoutable>.init() -> ZRouter.RoutableViewModule<A>
-                            """)
-                    } else if symbolName.contains("where"), symbolName.contains("=="), (symbolName.contains(".ZIKViewRoutable>") || symbolName.contains(".ZIKViewModuleRoutable>")) {
-                        let imagePath = imagePathOfAddress(name)
-                        assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
-                            Don't use ZIKViewRoutable or ZIKViewModuleRoutable as generic parameter:
-                            ```
-                            // Invalid usage
-                            RoutableView<ZIKViewRoutable>()
-                            RoutableViewModule<ZIKViewModuleRoutable>()
-                            ```
-                            You should use the explicit protocol to get its router.
-                            How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableView<ZIKViewRoutable>()` to `RoutableView<SomeViewProtocol>()` or `RoutableViewModule<ZIKViewModuleRoutable>()` to `RoutableViewModule<SomeViewModuleProtocol>()`
-                            """)
-                    }
-                } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableView<") {
-                    let simplifiedName = demangledAsSwift(name, true)
-                    if let routingType = symbolName.subString(forRegex: viewRoutingTypeRegex),
-                        let simplifiedRoutingType = simplifiedName.subString(forRegex: viewRoutingTypeRegex) {
-                        viewRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
-                    }
-                } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableViewModule<") {
-                    let simplifiedName = demangledAsSwift(name, true)
-                    if let routingType = symbolName.subString(forRegex: viewModuleRoutingTypeRegex),
-                        let simplifiedRoutingType = simplifiedName.subString(forRegex: viewModuleRoutingTypeRegex) {
-                        viewModuleRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
-                    }
+                        }
+                        ```
+                        ```
+                        // Invalid usage
+                        RoutableViewModule<SomeViewRouteConfiguration>()
+                        ```
+                        You should use the protocol to get its router.
+                        How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableViewModule<SomeViewRouteConfiguration>()` to `RoutableViewModule<SomeViewModuleProtocol>()`
+                        If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
+                        (extension in ZRouter):ZRouter.RoutableViewModule<A where A: __ObjC.ZIKViewRouteConfiguration, A: __ObjC.ZIKViewModuleRoutable>.init() -> ZRouter.RoutableViewModule<A>
+                        """)
+                } else if symbolName.contains("where"), symbolName.contains("=="), (symbolName.contains(".ZIKViewRoutable>") || symbolName.contains(".ZIKViewModuleRoutable>")) {
+                    assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
+                        Don't use ZIKViewRoutable or ZIKViewModuleRoutable as generic parameter:
+                        ```
+                        // Invalid usage
+                        RoutableView<ZIKViewRoutable>()
+                        RoutableViewModule<ZIKViewModuleRoutable>()
+                        ```
+                        You should use the explicit protocol to get its router.
+                        How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableView<ZIKViewRoutable>()` to `RoutableView<SomeViewProtocol>()` or `RoutableViewModule<ZIKViewModuleRoutable>()` to `RoutableViewModule<SomeViewModuleProtocol>()`
+                        """)
+                }
+            } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableView<") {
+                if let routingType = symbolName.subString(forRegex: viewRoutingTypeRegex),
+                    let simplifiedRoutingType = simplifiedName.subString(forRegex: viewRoutingTypeRegex) {
+                    viewRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
+                }
+            } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableViewModule<") {
+                if let routingType = symbolName.subString(forRegex: viewModuleRoutingTypeRegex),
+                    let simplifiedRoutingType = simplifiedName.subString(forRegex: viewModuleRoutingTypeRegex) {
+                    viewModuleRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
                 }
             }
             return true
@@ -624,15 +661,15 @@ private class _ViewRouterValidater: ZIKViewRouteAdapter {
         }
         
         for declaredProtocol in declaredDestinationProtocols {
-            if !(Registry.viewProtocolContainer.keys.contains(_RouteKey(key: declaredProtocol)) ||
-                Registry.viewAdapterContainer.keys.contains(_RouteKey(key: declaredProtocol)) ||
+            if !(Registry.viewProtocolContainer.keys.contains { $0.key == declaredProtocol } ||
+                Registry.viewAdapterContainer.keys.contains { $0.key == declaredProtocol } ||
                 _ZIKViewRouterToIdentifier(Registry.makingDestinationIdentifierPrefix + declaredProtocol) != nil) {
                 errorDescription.append("\n\n❌Declared view protocol (\(declaredProtocol)) is not registered with any router.")
             }
         }
         for declaredProtocol in declaredModuleProtocols {
-            if !(Registry.viewModuleProtocolContainer.keys.contains(_RouteKey(key: declaredProtocol)) ||
-                Registry.viewModuleAdapterContainer.keys.contains(_RouteKey(key: declaredProtocol)) ||
+            if !(Registry.viewModuleProtocolContainer.keys.contains { $0.key == declaredProtocol } ||
+                Registry.viewModuleAdapterContainer.keys.contains { $0.key == declaredProtocol } ||
                 _ZIKViewRouterToIdentifier(Registry.makingModuleIdentifierPrefix + declaredProtocol) != nil) {
                 errorDescription.append("\n\n❌Declared view module config protocol (\(declaredProtocol)) is not registered with any router.")
             }
@@ -666,14 +703,19 @@ private class _ViewRouterValidater: ZIKViewRouteAdapter {
         }
         
         // Destination should conform to registered destination protocols
-        for (routeKey, route) in Registry.viewProtocolContainer {
+        let viewProtocolRoutes = Array(Registry.viewProtocolContainer)
+        if let error = ZIKViewRouteRegistry.validateConcurrently(withCount: viewProtocolRoutes.count, handler: { (index) -> String? in
+            let (routeKey, route) = viewProtocolRoutes[index]
             let viewProtocol = routeKey.type!
             let badDestinationClass: AnyClass? = ZIKViewRouteRegistry.validateDestinations(forRoute: route, handler: { (destinationClass) -> Bool in
                 return _swift_typeIsTargetType(destinationClass, viewProtocol)
             })
             if badDestinationClass != nil {
-                errorDescription.append("\n\n❌Registered view class (\(badDestinationClass!)) for router (\(route)) should conform to registered view protocol (\(viewProtocol)).")
+                return "\n\n❌Registered view class (\(badDestinationClass!)) for router (\(route)) should conform to registered view protocol (\(viewProtocol))."
             }
+            return nil
+        }) {
+            errorDescription.append(error)
         }
         
         // Destination should conforms to registered adapter destination protocols
@@ -701,16 +743,21 @@ private class _ViewRouterValidater: ZIKViewRouteAdapter {
         }
         
         // Router's defaultRouteConfiguration should conforms to registered module config protocols
-        for (routeKey, route) in Registry.viewModuleProtocolContainer {
+        let viewModuleProtocolRoutes = Array(Registry.viewModuleProtocolContainer)
+        if let error = ZIKViewRouteRegistry.validateConcurrently(withCount: viewModuleProtocolRoutes.count, handler: { (index) -> String? in
+            let (routeKey, route) = viewModuleProtocolRoutes[index]
             guard let routerType = ZIKAnyViewRouterType.tryMakeType(forRoute: route) else {
                 assertionFailure("Invalid route (\(route))")
-                continue
+                return nil
             }
             let configProtocol = routeKey.type!
             let configType = type(of: routerType.defaultRouteConfiguration())
             if _swift_typeIsTargetType(configType, configProtocol) == false {
-                errorDescription.append("\n\n❌The router (\(route))'s default configuration (\(configType)) must conform to the registered config protocol (\(configProtocol)).")
+                return "\n\n❌The router (\(route))'s default configuration (\(configType)) must conform to the registered config protocol (\(configProtocol))."
             }
+            return nil
+        }) {
+            errorDescription.append(error)
         }
         
         // Router's defaultRouteConfiguration should conforms to registered adapter module config protocols
@@ -11,23 +11,23 @@
 
 import ZIKRouter.Internal
 
-/// Swift Wrapper of ZIKViewRouter class for supporting pure Swift generic type.
-public class ViewRouterType<Destination, ModuleConfig> {
+/// Swift Wrapper of ZIKViewRouter class for supporting pure Swift generic type. It's a value only holding the router type, so getting it from `Router.to` doesn't allocate, and the forwarding members are inlined into generic call sites.
+public struct ViewRouterType<Destination, ModuleConfig> {
     
     /// The router type to wrap.
     public let routerType: ZIKAnyViewRouterType
     
-    internal init(routerType: ZIKAnyViewRouterType) {
+    @usableFromInline internal init(routerType: ZIKAnyViewRouterType) {
         self.routerType = routerType
     }
     
     /// Default configuration to perform route.
-    public var defaultRouteConfiguration: ModuleConfig {
+    @inlinable public var defaultRouteConfiguration: ModuleConfig {
         return routerType.defaultRouteConfiguration() as! ModuleConfig
     }
     
     /// Default configuration to remove route.
-    public var defaultRemoveConfiguration: ViewRemoveConfig {
+    @inlinable public var defaultRemoveConfiguration: ViewRemoveConfig {
         return routerType.defaultRemoveConfiguration()
     }
     
@@ -58,14 +58,13 @@ public class ViewRouterType<Destination, ModuleConfig> {
         }
         let routerType = self.routerType
         let router = routerType.perform(path.path, strictConfiguring: { (strictConfig, config) in
-            let prepareModule = { (prepare: (ModuleConfig) -> Void) in
+            configBuilder(ViewRouteStrictConfig(configuration: strictConfig), { prepare in
                 guard let moduleConfig = config as? ModuleConfig else {
                     assertionFailure("Bad implementation in router, configuration (\(config)) should be type (\(ModuleConfig.self))")
                     return
                 }
                 prepare(moduleConfig)
-            }
-            configBuilder(ViewRouteStrictConfig(configuration: strictConfig), prepareModule)
+            })
             #if DEBUG
             let successHandler = config.successHandler
             config.successHandler = { d in
@@ -177,14 +176,13 @@ public class ViewRouterType<Destination, ModuleConfig> {
             return nil
         }
         let router = routerType.perform(onDestination: dest, path: path.path, strictConfiguring: { (strictConfig, config) in
-            let prepareModule = { (prepare: (ModuleConfig) -> Void) in
+            configBuilder(ViewRouteStrictConfig(configuration: strictConfig), { prepare in
                 guard let moduleConfig = config as? ModuleConfig else {
                     assertionFailure("Bad implementation in router, configuration (\(config)) should be type (\(ModuleConfig.self))")
                     return
                 }
                 prepare(moduleConfig)
-            }
-            configBuilder(ViewRouteStrictConfig(configuration: strictConfig), prepareModule)
+            })
         }, strictRemoving: removeBuilder)
         
         guard let routed = router else {
@@ -234,14 +232,13 @@ public class ViewRouterType<Destination, ModuleConfig> {
             return nil
         }
         let router = routerType.prepareDestination(dest, strictConfiguring: { (strictConfig, config) in
-            let prepareModule = { (prepare: (ModuleConfig) -> Void) in
+            configBuilder(ViewRouteStrictConfig(configuration: strictConfig), { prepare in
                 guard let moduleConfig = config as? ModuleConfig else {
                     assertionFailure("Bad implementation in router, configuration (\(config)) should be type (\(ModuleConfig.self))")
                     return
                 }
                 prepare(moduleConfig)
-            }
-            configBuilder(ViewRouteStrictConfig(configuration: strictConfig), prepareModule)
+            })
         }, strictRemoving: removeBuilder)
         
         guard let routed = router else {
@@ -254,12 +251,12 @@ public class ViewRouterType<Destination, ModuleConfig> {
     // MARK: Make Destination
     
     /// Whether the destination is instantiated synchronously.
-    public var canMakeDestinationSynchronously: Bool {
+    @inlinable public var canMakeDestinationSynchronously: Bool {
         return routerType.canMakeDestinationSynchronously()
     }
     
     /// The router may can't make destination synchronously, or it's not for providing a destination but only for performing some actions.
-    public var canMakeDestination: Bool {
+    @inlinable public var canMakeDestination: Bool {
         return routerType.canMakeDestination()
     }
     
@@ -299,14 +296,13 @@ public class ViewRouterType<Destination, ModuleConfig> {
     /// - Returns: Destination
     public func makeDestination(configuring configBuilder: (ViewRouteStrictConfig<Destination>, ModulePreparation) -> Void) -> Destination? {
         let destination = routerType.makeDestination(strictConfiguring: { (strictConfig, config) in
-            let prepareModule = { (prepare: (ModuleConfig) -> Void) in
+            configBuilder(ViewRouteStrictConfig(configuration: strictConfig), { prepare in
                 guard let moduleConfig = config as? ModuleConfig else {
                     assertionFailure("Bad implementation in router, configuration (\(config)) should be type (\(ModuleConfig.self))")
                     return
                 }
                 prepare(moduleConfig)
-            }
-            configBuilder(ViewRouteStrictConfig(configuration: strictConfig), prepareModule)
+            })
         })
         assert(destination == nil || destination is Destination, "Router (\(routerType)) returns wrong destination type (\(String(describing: destination))), destination should be \(Destination.self)")
         assert(destination == nil || Registry.validateConformance(destination: destination!, inViewRouterType: routerType))
@@ -318,17 +314,17 @@ public class ViewRouterType<Destination, ModuleConfig> {
 }
 
 /// Swift Wrapper of ZIKViewRouter for supporting pure Swift generic type.
-public class ViewRouter<Destination, ModuleConfig> {
+public final class ViewRouter<Destination, ModuleConfig> {
     
     /// The real routed ZIKViewRouter.
     public private(set) var router: ZIKAnyViewRouter
     
-    internal init(router: ZIKAnyViewRouter) {
+    @usableFromInline internal init(router: ZIKAnyViewRouter) {
         self.router = router
     }
     
     /// State of route. Will be auto changed when view state is changed.
-    public var state: ZIKRouterState {
+    @inlinable public var state: ZIKRouterState {
         return router.state
     }
     
@@ -338,7 +334,7 @@ public class ViewRouter<Destination, ModuleConfig> {
     }
     
     /// Configuration for module protocol.
-    public var config: ModuleConfig {
+    @inlinable public var config: ModuleConfig {
         return router.configuration as! ModuleConfig
     }
     
@@ -348,7 +344,7 @@ public class ViewRouter<Destination, ModuleConfig> {
     }
     
     /// Latest error when route action failed.
-    public var error: Error? {
+    @inlinable public var error: Error? {
         return router.error
     }
     
@@ -365,7 +361,7 @@ public class ViewRouter<Destination, ModuleConfig> {
     /// 3. Source can't perform the route type: source is not in any navigation stack for push type, or source has presented a view controller for present type
     ///
     /// - Returns: true if source can perform route now, otherwise false
-    public var canPerform: Bool {
+    @inlinable public var canPerform: Bool {
         return router.canPerform()
     }
     
@@ -392,7 +388,7 @@ public class ViewRouter<Destination, ModuleConfig> {
     // MARK: Remove
     
     /// Whether the router should be removed before another performing, when the router is performed already and the destination still exists.
-    public var shouldRemoveBeforePerform: Bool {
+    @inlinable public var shouldRemoveBeforePerform: Bool {
         return router.shouldRemoveBeforePerform()
     }
     
@@ -415,7 +411,7 @@ public class ViewRouter<Destination, ModuleConfig> {
     /// - Note: Router should be removed be the performer, but not inside the destination. Only the performer knows how the destination was displayed (situation 6).
     ///
     /// - Returns: return true if can do removeRoute.
-    public var canRemove: Bool {
+    @inlinable public var canRemove: Bool {
         return router.canRemove()
     }
     
@@ -643,6 +639,117 @@ public enum ViewRoutePath {
     }
 }
 
+#if swift(>=5.5)
+
+// MARK: Concurrency
+
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, *)
+public extension ViewRouterType {
+    
+    /// Perform route with path and return the destination when the transition is finished. View routes run on main actor.
+    ///
+    /// Cancelling the task cancels making destination when the router's `makesDestinationInBackground` is true, then route fails with `ZIKRouteError.actionFailed`. A transition already started can't be cancelled.
+    ///
+    /// - Parameters:
+    ///   - path: The path with source and route type.
+    ///   - configBuilder: Build the configuration for performing route.
+    ///     - config: Config for view route.
+    ///     - prepareModule: Prepare custom module config.
+    /// - Returns: The destination.
+    /// - Throws: Error from performer error handler of the router.
+    @MainActor func performAsync(path: ViewRoutePath, configuring configBuilder: (ViewRouteStrictConfig<Destination>, ModulePreparation) -> Void = { _, _ in }) async throws -> Destination {
+        let task = RouteTask<Destination>()
+        return try await task.run(unavailableError: ZIKAnyViewRouter.routeError(withCode: .destinationUnavailable, localizedDescription: "Router (\(routerType)) can't perform route with path (\(path)).")) { task in
+            let router = perform(path: path, configuring: { (config, prepareModule) in
+                configBuilder(config, prepareModule)
+                let successHandler = config.performerSuccessHandler
+                config.performerSuccessHandler = { destination in
+                    successHandler?(destination)
+                    task.resume(returning: destination)
+                }
+                let errorHandler = config.performerErrorHandler
+                config.performerErrorHandler = { (action, error) in
+                    errorHandler?(action, error)
+                    task.resume(throwing: error)
+                }
+            })
+            guard let performed = router else {
+                return false
+            }
+            task.onCancel { [weak router = performed.router] in
+                _ = router?.cancelMakingDestination()
+            }
+            return true
+        }
+    }
+    
+    /// Make destination without blocking main thread. When the router can make destination synchronously, destination is returned directly without suspending. Otherwise it performs with `ViewRoutePath.makeDestination` and waits.
+    ///
+    /// - Parameter configBuilder: Build the configuration for making destination.
+    /// - Returns: The destination.
+    /// - Throws: Error when the router fails to make destination.
+    @MainActor func makeDestinationAsync(configuring configBuilder: (ViewRouteStrictConfig<Destination>, ModulePreparation) -> Void = { _, _ in }) async throws -> Destination {
+        if canMakeDestinationSynchronously {
+            try Task.checkCancellation()
+            var routeError: Error?
+            let destination = makeDestination(configuring: { (config, prepareModule) in
+                configBuilder(config, prepareModule)
+                let errorHandler = config.errorHandler
+                config.errorHandler = { (action, error) in
+                    errorHandler?(action, error)
+                    routeError = error
+                }
+            })
+            if let destination = destination {
+                return destination
+            }
+            throw routeError ?? ZIKAnyViewRouter.routeError(withCode: .destinationUnavailable, localizedDescription: "Router (\(routerType)) returns nil for destination.")
+        }
+        return try await performAsync(path: .makeDestination, configuring: configBuilder)
+    }
+}
+
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, *)
+public extension ViewRouter {
+    
+    /// State changes of the router since the stream is created, including changes from displaying or removing the destination outside the router. Iterating it doesn't add latency to transitions. Cancel the iterating task to stop observing.
+    var stateChanges: AsyncStream<RouteStateChange> {
+        return AsyncStream(stateChangesOf: router)
+    }
+    
+    /// Perform route again and return the destination when the transition is finished. See `ViewRouterType.performAsync(path:configuring:)`.
+    @MainActor func performRouteAsync() async throws -> Destination {
+        let task = RouteTask<Destination>()
+        let router = self.router
+        return try await task.run(unavailableError: ZIKAnyViewRouter.routeError(withCode: .actionFailed, localizedDescription: "Router (\(router)) can't perform route.")) { task in
+            task.onCancel { [weak router] in
+                _ = router?.cancelMakingDestination()
+            }
+            performRoute(successHandler: { destination in
+                task.resume(returning: destination)
+            }, errorHandler: { (_, error) in
+                task.resume(throwing: error)
+            })
+            return true
+        }
+    }
+    
+    /// Remove route and wait until the destination is removed.
+    @MainActor func removeRouteAsync() async throws {
+        let task = RouteTask<Void>()
+        return try await task.run(unavailableError: ZIKAnyViewRouter.routeError(withCode: .actionFailed, localizedDescription: "Router (\(router)) can't remove route.")) { task in
+            removeRoute(successHandler: {
+                task.resume(returning: ())
+            }, errorHandler: { (_, error) in
+                task.resume(throwing: error)
+            })
+            return true
+        }
+    }
+}
+
+#endif
+
 // MARK: Deprecated
 
 public extension ViewRouterType {
@@ -660,14 +767,13 @@ public extension ViewRouterType {
         }
         let routerType = self.routerType
         let router = routerType.perform(from: source, strictConfiguring: { (strictConfig, config) in
-            let prepareModule = { (prepare: (ModuleConfig) -> Void) in
+            configBuilder(ViewRouteStrictConfig(configuration: strictConfig), { prepare in
                 guard let moduleConfig = config as? ModuleConfig else {
                     assertionFailure("Bad implementation in router, configuration (\(config)) should be type (\(ModuleConfig.self))")
                     return
                 }
                 prepare(moduleConfig)
-            }
-            configBuilder(ViewRouteStrictConfig(configuration: strictConfig), prepareModule)
+            })
             #if DEBUG
             let successHandler = config.successHandler
             config.successHandler = { d in
@@ -712,14 +818,13 @@ public extension ViewRouterType {
             return nil
         }
         let router = routerType.perform(onDestination: dest, from: source, strictConfiguring: { (strictConfig, config) in
-            let prepareModule = { (prepare: (ModuleConfig) -> Void) in
+            configBuilder(ViewRouteStrictConfig(configuration: strictConfig), { prepare in
                 guard let moduleConfig = config as? ModuleConfig else {
                     assertionFailure("Bad implementation in router, configuration (\(config)) should be type (\(ModuleConfig.self))")
                     return
                 }
                 prepare(moduleConfig)
-            }
-            configBuilder(ViewRouteStrictConfig(configuration: strictConfig), prepareModule)
+            })
         }, strictRemoving: removeBuilder)
         
         guard let routed = router else {
@@ -824,6 +929,14 @@ open class ViewMakeableConfiguration<Destination, Constructor>: ZIKSwiftViewMake
      */
     public var makeDestinationWith: Constructor
     
+    /// Make destination with a non-escaping factory and set it as makedDestination. Call it in makeDestinationWith to pass typed parameters to the destination's initializer directly, instead of capturing them in makeDestination, which is copied and wrapped to return `Any`. makeDestination is not set, so the configuration doesn't make destination again after makedDestination is used.
+    @discardableResult
+    public func makeDestination(using factory: () -> Destination?) -> Destination? {
+        let destination = factory()
+        makedDestination = destination
+        return destination
+    }
+    
     /**
      Asynchronous factory method passing required parameters for initializing destination module, and get destination in `didMakeDestination`. You should set makeDestination to capture parameters directly, so you don't need configuration subclass to hold parameters.
      Genetic Constructor is a function type: ViewMakeableConfiguration<LoginViewInput, (String) -> Void>
@@ -1046,6 +1159,14 @@ open class AnyViewMakeableConfiguration<Destination, Maker, Constructor>: ZIKSwi
     /// Factory method passing required parameters and make destination. You should set makedDestination in makeDestinationWith.
     public var makeDestinationWith: Maker
     
+    /// Make destination with a non-escaping factory and set it as makedDestination. Call it in makeDestinationWith to pass typed parameters to the destination's initializer directly, instead of capturing them in makeDestination, which is copied and wrapped to return `Any`. makeDestination is not set, so the configuration doesn't make destination again after makedDestination is used.
+    @discardableResult
+    public func makeDestination(using factory: () -> Destination?) -> Destination? {
+        let destination = factory()
+        makedDestination = destination
+        return destination
+    }
+    
     /// Asynchronous factory method passsing required parameters for initializing destination module, and get destination in `didMakeDestination`. You should set makeDestination to capture parameters directly, so you don't need configuration subclass to hold parameters.
     public var constructDestination: Constructor
     
@@ -50,6 +50,12 @@ class ServiceRouterMakeDestinationTests: XCTestCase {
         XCTAssertNotNil(destination)
     }
     
+    func testRouterTypeReusedForSwiftProtocol() {
+        let routerType = Router.to(RoutableService<AServiceInput>())?.routerType
+        XCTAssertNotNil(routerType)
+        XCTAssert(routerType === Router.to(RoutableService<AServiceInput>())?.routerType, "Router type should be built once at registration")
+    }
+    
     func testMakeDestinationWithPreparation() {
         XCTAssertTrue(Router.to(RoutableService<AServiceInput>())!.canMakeDestination)
         let destination = Router.makeDestination(to: RoutableService<AServiceInput>(), preparation: { (destination) in
@@ -297,3 +297,59 @@ class ServiceRouterPerformTests: XCTestCase {
         waitForExpectations(timeout: 2, handler: { if let error = $0 {print(error)}})
     }
 }
+
+#if swift(>=5.5)
+
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, *)
+extension ServiceRouterPerformTests {
+    
+    func testPerformAsync() async throws {
+        let destination = try await Router.to(RoutableService<AServiceInput>())!.performAsync(configuring: { (config, prepareModule) in
+            config.prepareDestination = { destination in
+                destination.title = "test title"
+            }
+        })
+        XCTAssert(destination.title == "test title")
+    }
+    
+    func testPerformAsyncWithError() async {
+        TestConfig.routeShouldFail = true
+        do {
+            _ = try await Router.to(RoutableService<AServiceInput>())!.performAsync()
+            XCTFail("performAsync should throw")
+        } catch {
+            XCTAssertNotNil(error)
+        }
+    }
+    
+    func testMakeDestinationAsync() async throws {
+        let destination = try await Router.to(RoutableService<AServiceInput>())!.makeDestinationAsync(configuring: { (config, prepareModule) in
+            config.prepareDestination = { destination in
+                destination.title = "test title"
+            }
+        })
+        XCTAssert(destination.title == "test title")
+    }
+    
+    func testPerformRouteAsync() async throws {
+        let router = Router.to(RoutableService<AServiceInput>())!.perform()
+        XCTAssertNotNil(router)
+        let destination = try await router!.performRouteAsync()
+        XCTAssert(destination is AService)
+        XCTAssert(router!.state == .routed)
+    }
+    
+    func testRemoveRouteAsyncWithError() async {
+        TestConfig.routeShouldFail = true
+        let router = Router.to(RoutableService<AServiceInput>())!.perform()
+        XCTAssertNotNil(router)
+        do {
+            try await router!.removeRouteAsync()
+            XCTFail("removeRouteAsync should throw when route is not performed")
+        } catch {
+            XCTAssertNotNil(error)
+        }
+    }
+}
+
+#endif
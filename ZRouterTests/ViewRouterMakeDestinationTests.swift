@@ -156,3 +156,30 @@ class ViewRouterMakeDestinationTests: XCTestCase {
     }
     
 }
+
+#if swift(>=5.5)
+
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, *)
+extension ViewRouterMakeDestinationTests {
+    
+    @MainActor func testMakeDestinationAsync() async throws {
+        let destination = try await Router.to(RoutableView<AViewInput>())!.makeDestinationAsync(configuring: { (config, prepareModule) in
+            config.prepareDestination = { destination in
+                destination.viewTitle = "test title"
+            }
+        })
+        XCTAssert(destination.viewTitle == "test title")
+    }
+    
+    @MainActor func testMakeDestinationAsyncWithError() async {
+        TestConfig.routeShouldFail = true
+        do {
+            _ = try await Router.to(RoutableView<AViewInput>())!.makeDestinationAsync()
+            XCTFail("makeDestinationAsync should throw")
+        } catch {
+            XCTAssertNotNil(error)
+        }
+    }
+}
+
+#endif